@@ -31,6 +31,12 @@
 /* ST7796S datasheet rates the write cycle at 66 MHz (Tcycw=15ns); 40 MHz stays
  * within spec for the hand-soldered perfboard wiring in a noisy kiln environment. */
 #define APP_LCD_SPI_FREQ_HZ (40 * 1000 * 1000)
+/* Largest transaction on the shared SPI bus (its max_transfer_sz). esp_lcd
+ * splits every flush into chunks of this size, and the MAX31855 can take the
+ * bus between any two: 8 lines of RGB565 is 7.5 KiB, ~1.5 ms at 40 MHz, which
+ * bounds how long a thermocouple read waits on a redraw. */
+#define APP_LCD_SPI_CHUNK_LINES 8
+#define APP_SPI_MAX_TRANSFER_SZ (APP_LCD_H_RES * APP_LCD_SPI_CHUNK_LINES * 2)
 
 /* --- PID Defaults --- */
 #define APP_PID_KP_DEFAULT 2.0f
@@ -66,10 +72,57 @@
 #define APP_TASK_HTTPD_PRIO     3
 #define APP_TASK_DISPLAY_PRIO   2
 
-#define APP_TASK_SAFETY_STACK    4096
-#define APP_TASK_TEMP_READ_STACK 4096
-#define APP_TASK_FIRING_STACK    8192
-#define APP_TASK_DISPLAY_STACK   16384
+#define APP_TASK_SAFETY_STACK       4096
+#define APP_TASK_TEMP_READ_STACK    4096
+#define APP_TASK_FIRING_STACK       8192
+#define APP_TASK_DISPLAY_STACK      16384
+#define APP_TASK_STATUS_LED_STACK   2048
+#define APP_TASK_NOTIFY_STACK       6144
+#define APP_TASK_WS_BROADCAST_STACK 4096
+#define APP_TASK_SIM_STACK          4096
+
+/* --- Static Memory Placement ---
+ * Every long-lived task stack, queue, mutex and event group is a static object
+ * (components/mem_budget), placed per this table and reported at boot.
+ *
+ * Internal SRAM for anything that runs or is touched while the flash cache is
+ * off (NVS and SPIFFS writes: firing, display, safety paths), that DMA reads
+ * (LVGL draw buffers), or that is on the 1 Hz control path. FreeRTOS control
+ * blocks (TCBs, queue and mutex structs) must be internal on ESP-IDF, so queue
+ * and mutex storage stays internal too — it's a few hundred bytes.
+ *
+ * PSRAM for the network-side workers that only format JSON and write sockets:
+ * their stacks are the largest movable blocks and never see a flash write. */
+#define APP_MEM_SAFETY_STACK       MEM_REGION_INTERNAL
+#define APP_MEM_TEMP_READ_STACK    MEM_REGION_INTERNAL
+#define APP_MEM_FIRING_STACK       MEM_REGION_INTERNAL
+#define APP_MEM_DISPLAY_STACK      MEM_REGION_INTERNAL
+#define APP_MEM_STATUS_LED_STACK   MEM_REGION_INTERNAL
+#define APP_MEM_NOTIFY_STACK       MEM_REGION_PSRAM
+#define APP_MEM_WS_BROADCAST_STACK MEM_REGION_PSRAM
+#define APP_MEM_SIM_STACK          MEM_REGION_PSRAM
+#define APP_MEM_KERNEL_OBJECTS     MEM_REGION_INTERNAL /* queues, mutexes, event groups */
+#define APP_MEM_LCD_DRAW_BUF       MEM_REGION_INTERNAL /* must also be DMA-capable */
+#define APP_MEM_HTTP_ARENA         MEM_REGION_PSRAM    /* cJSON only; never DMA'd or flashed from */
+#define APP_MEM_RT_STATS           MEM_REGION_INTERNAL /* written by firing_task every tick */
+
+/* --- HTTP Request Arenas ---
+ * Per-request cJSON memory (components/web_server/http_arena.h). The httpd
+ * task serves one request at a time; the second arena is headroom for an
+ * async handler, which would otherwise run on the heap. Sized above the
+ * largest route's high-water mark (GET /api/v1/diagnostics/http-arena);
+ * anything bigger spills to the heap and is counted there. */
+#define APP_HTTP_ARENA_COUNT 2
+#define APP_HTTP_ARENA_SIZE  (64 * 1024)
+
+/* --- Runtime Diagnostics ---
+ * Task CPU shares and core loads at GET /api/v1/diagnostics/runtime cover the
+ * last window of this length (components/rt_stats). */
+#define APP_RT_STATS_WINDOW_MS 10000
+
+/* With CONFIG_FIRING_TICK_PROFILE, a firing_tick slower than this logs its
+ * slowest phase. A tick blocked for seconds starves the SSR heartbeat. */
+#define APP_FIRING_TICK_SLOW_MS 100
 
 /* --- Input Buttons (5-way navigation switch: Up/Down/Left/Right/Center) --- */
 #define APP_PIN_BTN_UP     CONFIG_KILN_PIN_BTN_UP
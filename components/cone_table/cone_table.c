@@ -1,4 +1,5 @@
 #include "cone_table.h"
+#include "heat_work.h"
 #include "esp_log.h"
 #include <string.h>
 #include <stdio.h>
@@ -37,6 +38,9 @@ static const cone_entry_t s_cone_table[CONE_COUNT] = {
     [CONE_14] = {"14", {1388, 1395, 1410}},
 };
 
+/* heat_work.c carries one bending threshold per row, fitted to these columns. */
+_Static_assert(HEAT_WORK_CONES == CONE_COUNT, "heat_work thresholds out of step with the cone table");
+
 /* Ramp rates for each speed in °C/hr for the final high-temperature segment */
 static const float s_speed_ramp[3] = {
     [CONE_SPEED_SLOW] = 60.0f,
@@ -23,10 +23,12 @@ static const char *TAG = "dashboard";
 #define CHART_Y_REL                (52 - CONTENT_Y)
 #define CHART_W                    258
 #define CHART_H                    212
-#define CHART_POINTS               240
+#define CHART_POINTS               TEMP_TRACE_POINTS /* zoomed views copy the trace 1:1 */
 #define CHART_DEFAULT_DUR_S        3600u /* fallback when active profile has no estimate */
 #define CHART_Y_MAX_DEFAULT        1400
 #define CHART_PLANNED_START_TEMP_C 20.0f /* assumed cold-kiln start */
+#define CHART_ZOOM_PAD_C           5      /* headroom above/below the data on zoomed views */
+#define CHART_ZOOM_MIN_SPAN_C      20     /* so a flat hold doesn't fill the chart with noise */
 
 /* Visual state of the dashboard. Selected from firing_progress_t.status. */
 typedef enum {
@@ -65,9 +67,34 @@ static lv_obj_t *s_active_elapsed = NULL;
 static lv_obj_t *s_active_remaining = NULL;
 static lv_obj_t *s_active_remaining_hdr = NULL;
 static lv_obj_t *s_chart = NULL;
-static lv_chart_series_t *s_chart_actual = NULL;
+static lv_chart_series_t *s_chart_actual = NULL; /* hottest reading per point */
+static lv_chart_series_t *s_chart_low = NULL;    /* coolest reading per point */
 static lv_chart_series_t *s_chart_planned = NULL;
+static lv_obj_t *s_chart_zoom_label = NULL;
 static lv_obj_t *s_paused_overlay = NULL;
+/* What the actual/low series currently hold, so a refresh only writes (and
+ * invalidates) the points that changed. */
+static int32_t s_chart_hi[CHART_POINTS];
+static int32_t s_chart_lo[CHART_POINTS];
+static int32_t s_chart_y_max = CHART_Y_MAX_DEFAULT; /* profile-derived range for the whole-firing view */
+static int32_t s_chart_range_min = 0;               /* range currently set on the chart */
+static int32_t s_chart_range_max = 0;
+static uint32_t s_chart_elapsed_s = 0; /* firing time at the last refresh, for an immediate redraw on zoom */
+
+/* Chart zoom, changed with LEFT/RIGHT. Kept across view changes so a pause
+ * doesn't throw the user back to the whole-firing view. */
+static temp_trace_zoom_t s_chart_zoom = TEMP_TRACE_ZOOM_FIRING;
+/* refresh_chart's working set, about 3 KB: static to keep it off the display
+ * task's stack. */
+static temp_trace_view_t s_trace_view;
+static int32_t s_next_hi[CHART_POINTS];
+static int32_t s_next_lo[CHART_POINTS];
+
+static const char *const s_zoom_names[TEMP_TRACE_ZOOM_COUNT] = {
+    [TEMP_TRACE_ZOOM_FIRING] = "Firing",
+    [TEMP_TRACE_ZOOM_HOUR] = "1 h",
+    [TEMP_TRACE_ZOOM_TEN_MIN] = "10 min",
+};
 
 /* COMPLETE view widgets. */
 static lv_obj_t *s_complete_now_temp = NULL;
@@ -175,6 +202,32 @@ static void format_duration(uint32_t seconds, char *buf, size_t buf_size, const
     }
 }
 
+/* dashboard_update runs every 500 ms but most of what it shows changes far less
+ * often. Setting a label's text or a flag invalidates the widget even when
+ * nothing changes, and every invalidated pixel is re-rendered and pushed over
+ * the SPI bus shared with the thermocouple — so compare against what is
+ * already on screen first. */
+static void set_text_if_changed(lv_obj_t *label, const char *text)
+{
+    const char *shown = lv_label_get_text(label);
+    if (shown && strcmp(shown, text) == 0) {
+        return;
+    }
+    lv_label_set_text(label, text);
+}
+
+static void set_hidden(lv_obj_t *obj, bool hidden)
+{
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) == hidden) {
+        return;
+    }
+    if (hidden) {
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
 static void clear_view_widgets(void)
 {
     s_idle_temp = NULL;
@@ -185,7 +238,9 @@ static void clear_view_widgets(void)
     s_active_remaining_hdr = NULL;
     s_chart = NULL;
     s_chart_actual = NULL;
+    s_chart_low = NULL;
     s_chart_planned = NULL;
+    s_chart_zoom_label = NULL;
     s_paused_overlay = NULL;
     s_complete_now_temp = NULL;
     s_error_now_temp = NULL;
@@ -290,11 +345,11 @@ static void update_view_idle(const thermocouple_reading_t *tc)
         return;
     }
     if (tc->fault) {
-        lv_label_set_text(s_idle_temp, "-");
+        set_text_if_changed(s_idle_temp, "-");
     } else {
         char buf[16];
         snprintf(buf, sizeof(buf), "%.0f%s", (double)ui_temp_value(tc->temperature_c), ui_temp_suffix());
-        lv_label_set_text(s_idle_temp, buf);
+        set_text_if_changed(s_idle_temp, buf);
     }
 }
 
@@ -339,16 +394,24 @@ static void build_view_active(void)
             y_max = profile_max;
         }
     }
+    s_chart_y_max = y_max;
+    s_chart_range_min = 0;
+    s_chart_range_max = y_max;
     lv_chart_set_range(s_chart, LV_CHART_AXIS_PRIMARY_Y, 0, y_max);
     lv_chart_set_div_line_count(s_chart, 6, 0); /* horizontal grid every ~200°C */
     lv_obj_clear_flag(s_chart, LV_OBJ_FLAG_SCROLLABLE);
 
-    /* Planned series first so it draws underneath the actual line. */
+    /* Planned series first so it draws underneath the actual lines. */
     s_chart_planned = lv_chart_add_series(s_chart, UI_COLOR_TEXT_DIM, LV_CHART_AXIS_PRIMARY_Y);
+    s_chart_low = lv_chart_add_series(s_chart, lv_color_mix(UI_COLOR_HEATING, UI_COLOR_SURFACE_1, LV_OPA_50),
+                                      LV_CHART_AXIS_PRIMARY_Y);
     s_chart_actual = lv_chart_add_series(s_chart, UI_COLOR_HEATING, LV_CHART_AXIS_PRIMARY_Y);
     for (uint32_t i = 0; i < CHART_POINTS; i++) {
         lv_chart_set_value_by_id(s_chart, s_chart_planned, i, LV_CHART_POINT_NONE);
+        lv_chart_set_value_by_id(s_chart, s_chart_low, i, LV_CHART_POINT_NONE);
         lv_chart_set_value_by_id(s_chart, s_chart_actual, i, LV_CHART_POINT_NONE);
+        s_chart_hi[i] = LV_CHART_POINT_NONE;
+        s_chart_lo[i] = LV_CHART_POINT_NONE;
     }
 
     if (s_cached_profile_valid && s_cached_total_dur_s > 0) {
@@ -360,12 +423,164 @@ static void build_view_active(void)
         }
     }
 
+    s_chart_zoom_label = ui_make_label(s_content, UI_FONT_SMALL, UI_COLOR_TEXT_DIM, s_zoom_names[s_chart_zoom]);
+    lv_obj_align_to(s_chart_zoom_label, s_chart, LV_ALIGN_TOP_RIGHT, -6, 4);
+    lv_chart_hide_series(s_chart, s_chart_planned, s_chart_zoom != TEMP_TRACE_ZOOM_FIRING);
+
     /* PAUSED overlay — created here, hidden by default. dashboard_update toggles visibility. */
     s_paused_overlay = ui_make_label(s_content, UI_FONT_BIG, UI_COLOR_TEXT_DIM, "PAUSED");
     lv_obj_align_to(s_paused_overlay, s_chart, LV_ALIGN_CENTER, 0, 0);
     lv_obj_add_flag(s_paused_overlay, LV_OBJ_FLAG_HIDDEN);
 }
 
+static int32_t chart_value(int16_t v)
+{
+    return v == TEMP_TRACE_NONE ? LV_CHART_POINT_NONE : (int32_t)v;
+}
+
+static void merge_point(int32_t *hi, int32_t *lo, temp_trace_point_t p)
+{
+    if (p.lo == TEMP_TRACE_NONE) {
+        return;
+    }
+    if (*hi == LV_CHART_POINT_NONE) {
+        *hi = p.hi;
+        *lo = p.lo;
+        return;
+    }
+    *hi = p.hi > *hi ? p.hi : *hi;
+    *lo = p.lo < *lo ? p.lo : *lo;
+}
+
+/* Lay the whole-firing trace onto the planned-duration axis. Trace buckets
+ * start at 15 s and double as the firing grows, so one bucket may fold into a
+ * chart point or span several; points past "now" stay empty. A firing that
+ * overruns its estimate piles up on the last point, as before. */
+static void layout_firing_view(const temp_trace_view_t *v, int32_t *hi, int32_t *lo)
+{
+    uint64_t total_ms = (uint64_t)s_cached_total_dur_s * 1000u;
+    uint32_t now_idx = (uint32_t)((uint64_t)s_chart_elapsed_s * 1000u * CHART_POINTS / total_ms);
+    if (now_idx >= CHART_POINTS) {
+        now_idx = CHART_POINTS - 1;
+    }
+    bool narrow = (uint64_t)v->bucket_ms * CHART_POINTS <= total_ms; /* several buckets per point */
+    for (uint32_t b = 0; b < v->count; b++) {
+        uint64_t start_ms = (uint64_t)b * v->bucket_ms;
+        uint32_t first;
+        uint32_t last;
+        if (narrow) {
+            first = (uint32_t)((start_ms + v->bucket_ms / 2) * CHART_POINTS / total_ms);
+            last = first;
+        } else {
+            first = (uint32_t)(start_ms * CHART_POINTS / total_ms);
+            last = (uint32_t)((start_ms + v->bucket_ms - 1) * CHART_POINTS / total_ms);
+        }
+        if (first > now_idx) {
+            first = now_idx;
+        }
+        if (last > now_idx) {
+            last = now_idx;
+        }
+        for (uint32_t i = first; i <= last; i++) {
+            merge_point(&hi[i], &lo[i], v->pts[b]);
+        }
+    }
+}
+
+/* Y range for the zoomed views: fit the visible readings, in 10° steps. */
+static void zoomed_range(const int32_t *hi, const int32_t *lo, int32_t *y_min, int32_t *y_max)
+{
+    int32_t mn = INT32_MAX;
+    int32_t mx = INT32_MIN;
+    for (uint32_t i = 0; i < CHART_POINTS; i++) {
+        if (hi[i] == LV_CHART_POINT_NONE) {
+            continue;
+        }
+        mn = lo[i] < mn ? lo[i] : mn;
+        mx = hi[i] > mx ? hi[i] : mx;
+    }
+    if (mx == INT32_MIN) {
+        *y_min = s_chart_range_min; /* nothing to fit yet */
+        *y_max = s_chart_range_max;
+        return;
+    }
+    mn -= CHART_ZOOM_PAD_C;
+    mx += CHART_ZOOM_PAD_C;
+    if (mx - mn < CHART_ZOOM_MIN_SPAN_C) {
+        int32_t mid = (mn + mx) / 2;
+        mn = mid - CHART_ZOOM_MIN_SPAN_C / 2;
+        mx = mid + CHART_ZOOM_MIN_SPAN_C / 2;
+    }
+    *y_min = (mn >= 0 ? mn : mn - 9) / 10 * 10;
+    *y_max = (mx + 9) / 10 * 10;
+}
+
+/* Copy the current zoom level out of the engine's trace and write only the
+ * chart points that differ from what is on screen: most 500 ms refreshes
+ * touch one point, a zoom change rewrites at most all of them. */
+static void refresh_chart(void)
+{
+    if (!s_chart || !s_chart_actual || s_cached_total_dur_s == 0) {
+        return;
+    }
+    firing_engine_get_trace(s_chart_zoom, &s_trace_view);
+
+    int32_t *hi = s_next_hi;
+    int32_t *lo = s_next_lo;
+    int32_t y_min = 0;
+    int32_t y_max = s_chart_y_max;
+    if (s_chart_zoom == TEMP_TRACE_ZOOM_FIRING) {
+        for (uint32_t i = 0; i < CHART_POINTS; i++) {
+            hi[i] = LV_CHART_POINT_NONE;
+            lo[i] = LV_CHART_POINT_NONE;
+        }
+        layout_firing_view(&s_trace_view, hi, lo);
+    } else {
+        for (uint32_t i = 0; i < CHART_POINTS; i++) {
+            hi[i] = chart_value(s_trace_view.pts[i].hi);
+            lo[i] = chart_value(s_trace_view.pts[i].lo);
+        }
+        zoomed_range(hi, lo, &y_min, &y_max);
+    }
+
+    if (y_min != s_chart_range_min || y_max != s_chart_range_max) {
+        lv_chart_set_range(s_chart, LV_CHART_AXIS_PRIMARY_Y, y_min, y_max);
+        s_chart_range_min = y_min;
+        s_chart_range_max = y_max;
+    }
+    for (uint32_t i = 0; i < CHART_POINTS; i++) {
+        if (hi[i] != s_chart_hi[i]) {
+            lv_chart_set_value_by_id(s_chart, s_chart_actual, i, hi[i]);
+            s_chart_hi[i] = hi[i];
+        }
+        if (lo[i] != s_chart_lo[i]) {
+            lv_chart_set_value_by_id(s_chart, s_chart_low, i, lo[i]);
+            s_chart_lo[i] = lo[i];
+        }
+    }
+}
+
+bool dashboard_chart_zoom(int step)
+{
+    if (!s_chart) {
+        return false;
+    }
+    int z = (int)s_chart_zoom + step;
+    if (z < 0) {
+        z = 0;
+    } else if (z >= TEMP_TRACE_ZOOM_COUNT) {
+        z = TEMP_TRACE_ZOOM_COUNT - 1;
+    }
+    if ((temp_trace_zoom_t)z == s_chart_zoom) {
+        return true;
+    }
+    s_chart_zoom = (temp_trace_zoom_t)z;
+    set_text_if_changed(s_chart_zoom_label, s_zoom_names[s_chart_zoom]);
+    lv_chart_hide_series(s_chart, s_chart_planned, s_chart_zoom != TEMP_TRACE_ZOOM_FIRING);
+    refresh_chart();
+    return true;
+}
+
 static void update_view_active(const thermocouple_reading_t *tc, const firing_progress_t *prog)
 {
     if (!s_active_temp) {
@@ -375,40 +590,30 @@ static void update_view_active(const thermocouple_reading_t *tc, const firing_pr
     char buf[32];
 
     if (tc->fault) {
-        lv_label_set_text(s_active_temp, "-");
+        set_text_if_changed(s_active_temp, "-");
     } else {
         snprintf(buf, sizeof(buf), "%.0f%s", (double)ui_temp_value(tc->temperature_c), ui_temp_suffix());
-        lv_label_set_text(s_active_temp, buf);
+        set_text_if_changed(s_active_temp, buf);
     }
 
     snprintf(buf, sizeof(buf), LV_SYMBOL_RIGHT " %.0f%s", (double)ui_temp_value(prog->target_temp), ui_temp_suffix());
-    lv_label_set_text(s_active_target, buf);
+    set_text_if_changed(s_active_target, buf);
 
     format_duration(prog->elapsed_time, buf, sizeof(buf), "");
-    lv_label_set_text(s_active_elapsed, buf);
+    set_text_if_changed(s_active_elapsed, buf);
 
-    if (prog->estimated_remaining > 0) {
+    bool show_remaining = prog->estimated_remaining > 0;
+    if (show_remaining) {
         format_duration(prog->estimated_remaining, buf, sizeof(buf), "~");
-        lv_label_set_text(s_active_remaining, buf);
-        lv_obj_clear_flag(s_active_remaining, LV_OBJ_FLAG_HIDDEN);
-        if (s_active_remaining_hdr) {
-            lv_obj_clear_flag(s_active_remaining_hdr, LV_OBJ_FLAG_HIDDEN);
-        }
-    } else {
-        lv_obj_add_flag(s_active_remaining, LV_OBJ_FLAG_HIDDEN);
-        if (s_active_remaining_hdr) {
-            lv_obj_add_flag(s_active_remaining_hdr, LV_OBJ_FLAG_HIDDEN);
-        }
+        set_text_if_changed(s_active_remaining, buf);
     }
-
-    if (s_chart && s_chart_actual && s_cached_total_dur_s > 0 && !tc->fault) {
-        uint64_t scaled = (uint64_t)prog->elapsed_time * CHART_POINTS;
-        uint32_t idx = (uint32_t)(scaled / s_cached_total_dur_s);
-        if (idx >= CHART_POINTS) {
-            idx = CHART_POINTS - 1;
-        }
-        lv_chart_set_value_by_id(s_chart, s_chart_actual, idx, (int32_t)tc->temperature_c);
+    set_hidden(s_active_remaining, !show_remaining);
+    if (s_active_remaining_hdr) {
+        set_hidden(s_active_remaining_hdr, !show_remaining);
     }
+
+    s_chart_elapsed_s = prog->elapsed_time;
+    refresh_chart();
 }
 
 /* ── COMPLETE view ─────────────────────────────────────── */
@@ -447,11 +652,11 @@ static void update_view_complete(const thermocouple_reading_t *tc)
         return;
     }
     if (tc->fault) {
-        lv_label_set_text(s_complete_now_temp, "");
+        set_text_if_changed(s_complete_now_temp, "");
     } else {
         char buf[32];
         snprintf(buf, sizeof(buf), "Now %.0f%s, cooling", (double)ui_temp_value(tc->temperature_c), ui_temp_suffix());
-        lv_label_set_text(s_complete_now_temp, buf);
+        set_text_if_changed(s_complete_now_temp, buf);
     }
 }
 
@@ -498,11 +703,11 @@ static void update_view_error(const thermocouple_reading_t *tc)
         return;
     }
     if (tc->fault) {
-        lv_label_set_text(s_error_now_temp, "Last reading -");
+        set_text_if_changed(s_error_now_temp, "Last reading -");
     } else {
         char buf[32];
         snprintf(buf, sizeof(buf), "Last reading %.0f%s", (double)ui_temp_value(tc->temperature_c), ui_temp_suffix());
-        lv_label_set_text(s_error_now_temp, buf);
+        set_text_if_changed(s_error_now_temp, buf);
     }
 }
 
@@ -533,7 +738,7 @@ static void on_select_trap_clicked(lv_event_t *e)
             ESP_LOGE(TAG, "no command queue; cannot acknowledge error");
             break;
         }
-        firing_cmd_t cmd = {.type = FIRING_CMD_STOP};
+        firing_cmd_t cmd = {.type = FIRING_CMD_STOP, .source = FIRING_SRC_LCD};
         if (xQueueSend(q, &cmd, pdMS_TO_TICKS(100)) != pdTRUE) {
             ESP_LOGE(TAG, "STOP not queued (queue full); staying on error screen, press SELECT again");
             break;
@@ -668,19 +873,17 @@ void dashboard_update(const thermocouple_reading_t *tc, const firing_progress_t
     }
 
     if (view_is_active_family(s_current_view)) {
-        lv_label_set_text_fmt(s_seg_label, "SEGMENT %u/%u", (unsigned)(prog->current_segment + 1),
-                              (unsigned)prog->total_segments);
+        char seg[32];
+        snprintf(seg, sizeof(seg), "SEGMENT %u/%u", (unsigned)(prog->current_segment + 1),
+                 (unsigned)prog->total_segments);
+        set_text_if_changed(s_seg_label, seg);
     } else {
-        lv_label_set_text(s_seg_label, "");
+        set_text_if_changed(s_seg_label, "");
     }
 
     /* PAUSED overlay visibility. */
     if (s_paused_overlay) {
-        if (s_current_view == VIEW_PAUSED) {
-            lv_obj_clear_flag(s_paused_overlay, LV_OBJ_FLAG_HIDDEN);
-        } else {
-            lv_obj_add_flag(s_paused_overlay, LV_OBJ_FLAG_HIDDEN);
-        }
+        set_hidden(s_paused_overlay, s_current_view != VIEW_PAUSED);
     }
 
     /* View-specific data refresh. */
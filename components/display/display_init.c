@@ -1,14 +1,16 @@
 #include "display.h"
 #include "ui_common.h"
 #include "ui_theme.h"
+#include "render_stats.h"
 #include "app_config.h"
+#include "mem_budget.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lcd_st7796.h"
 #include "driver/gpio.h"
-#include "esp_heap_caps.h"
+#include "esp_attr.h"
 #include "lvgl.h"
 #include <string.h>
 
@@ -25,9 +27,14 @@ static lv_display_t *s_disp = NULL;
 static int s_bl_pin = -1;
 
 /* Double-buffered DMA draw buffers: 30 rows each (~1/10.7 of the screen, above
- * LVGL's 1/10 floor). Allocated from DMA-capable internal SRAM in display_init();
- * PSRAM is too slow for the flush DMA hot path. */
+ * LVGL's 1/10 floor). Static in DMA-capable internal SRAM (DMA_ATTR); PSRAM is
+ * too slow for the flush DMA hot path. */
 #define DRAW_BUF_LINES 30
+#define DRAW_BUF_SIZE  (UI_LCD_W * DRAW_BUF_LINES * sizeof(uint16_t))
+#define FLUSH_CHUNKS   ((DRAW_BUF_LINES + APP_LCD_SPI_CHUNK_LINES - 1) / APP_LCD_SPI_CHUNK_LINES)
+
+_Static_assert(APP_MEM_LCD_DRAW_BUF == MEM_REGION_INTERNAL, "LCD draw buffers must be DMA-capable internal RAM");
+static DMA_ATTR uint8_t s_draw_buf[2][DRAW_BUF_SIZE];
 
 /* Button debounce state — 5-way nav switch */
 enum { BTN_UP = 0, BTN_DOWN, BTN_SELECT, BTN_LEFT, BTN_RIGHT, BTN_COUNT };
@@ -180,8 +187,9 @@ esp_err_t display_init(spi_host_device_t host, int cs_pin, int dc_pin, int rst_p
         .lcd_cmd_bits = 8,
         .lcd_param_bits = 8,
         .spi_mode = 0,
-        /* Partial + double-buffer keeps at most 2 transfers in flight; 4 is headroom. */
-        .trans_queue_depth = 4,
+        /* Partial + double-buffer keeps at most 2 flushes in flight, each split
+         * into APP_SPI_MAX_TRANSFER_SZ transactions; 2 more is headroom. */
+        .trans_queue_depth = 2 * FLUSH_CHUNKS + 2,
         .on_color_trans_done = NULL, /* registered after display is created */
         .user_ctx = NULL,
     };
@@ -219,14 +227,8 @@ esp_err_t display_init(spi_host_device_t host, int cs_pin, int dc_pin, int rst_p
     s_disp = lv_display_create(UI_LCD_W, UI_LCD_H);
     lv_display_set_flush_cb(s_disp, flush_cb);
 
-    size_t buf_sz = UI_LCD_W * DRAW_BUF_LINES * sizeof(uint16_t);
-    uint8_t *buf1 = heap_caps_aligned_alloc(4, buf_sz, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
-    uint8_t *buf2 = heap_caps_aligned_alloc(4, buf_sz, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
-    if (!buf1 || !buf2) {
-        ESP_LOGE(TAG, "draw-buffer alloc failed (%zu bytes each)", buf_sz);
-        return ESP_ERR_NO_MEM;
-    }
-    lv_display_set_buffers(s_disp, buf1, buf2, buf_sz, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_buffers(s_disp, s_draw_buf[0], s_draw_buf[1], DRAW_BUF_SIZE, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    mem_budget_add("display", "draw buffers", APP_MEM_LCD_DRAW_BUF, sizeof(s_draw_buf));
     lv_display_set_color_format(s_disp, LV_COLOR_FORMAT_RGB565_SWAPPED);
 
     /* Install the UI theme before any widget is created so every widget picks up
@@ -234,6 +236,7 @@ esp_err_t display_init(spi_host_device_t host, int cs_pin, int dc_pin, int rst_p
      * predates this and won't be themed, but splash and dashboard build their own
      * full-screen roots that do get themed. */
     ui_theme_init(s_disp);
+    render_stats_attach(s_disp);
 
     /* Now set the user_ctx on the IO handle so the ISR can call flush_ready */
     esp_lcd_panel_io_register_event_callbacks(
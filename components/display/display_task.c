@@ -4,6 +4,7 @@
 #include "modal.h"
 #include "splash.h"
 #include "boot_status.h"
+#include "render_stats.h"
 #include "thermocouple.h"
 #include "firing_engine.h"
 #include "esp_log.h"
@@ -18,9 +19,10 @@ static const char *TAG = "display_task";
 
 extern lv_group_t *g_input_group;
 
-/* LEFT/RIGHT alias UP/DOWN: both axes move focus through the active group.
- * Cancel is always a visible button on dismissible modals — there is no
- * "back via LEFT" gesture. */
+/* LEFT/RIGHT zoom the firing chart out/in while it is on screen; otherwise
+ * they alias UP/DOWN and move focus through the active group. Cancel is always
+ * a visible button on dismissible modals — there is no "back via LEFT"
+ * gesture. */
 static void route_lr_focus(void)
 {
     bool left = display_consume_left_press();
@@ -38,10 +40,10 @@ static void route_lr_focus(void)
             dashboard_modal_nav_right();
         }
     } else {
-        if (left) {
+        if (left && !dashboard_chart_zoom(-1)) {
             lv_group_focus_prev(g_input_group);
         }
-        if (right) {
+        if (right && !dashboard_chart_zoom(+1)) {
             lv_group_focus_next(g_input_group);
         }
     }
@@ -75,6 +77,19 @@ static void dashboard_tick_cb(lv_timer_t *t)
     }
 }
 
+/* Close the one-second render window. At debug level this logs what the panel
+ * was sent: on a steady dashboard it should be a frame or two per second, not
+ * a repaint of every label. */
+static void render_stats_tick_cb(lv_timer_t *t)
+{
+    (void)t;
+    render_stats_roll();
+    render_stats_t rs;
+    render_stats_last_second(&rs);
+    ESP_LOGD(TAG, "render: %" PRIu32 " invalidations, %" PRIu32 " frames, %" PRIu32 " flushes, %" PRIu64 " px",
+             rs.invalidations, rs.frames, rs.flushes, rs.pixels);
+}
+
 /* Render the splash, then loop pumping LVGL until boot is complete and the
  * splash has been visible for at least SPLASH_MIN_VISIBLE_US. Status text is
  * pushed onto the splash whenever main has published a new pointer. */
@@ -130,6 +145,7 @@ void display_task(void *param)
     splash_destroy();
     dashboard_create();
     lv_timer_create(dashboard_tick_cb, 500, NULL);
+    lv_timer_create(render_stats_tick_cb, 1000, NULL);
     lv_unlock();
 
     for (;;) {
@@ -21,6 +21,14 @@ void dashboard_create(void);
  */
 void dashboard_update(const thermocouple_reading_t *tc, const firing_progress_t *prog);
 
+/**
+ * Step the active view's chart between whole firing, last hour and last ten
+ * minutes (negative zooms out, positive zooms in). Returns false when no chart
+ * is on screen, so the caller can use the key for something else.
+ * Must be called with LVGL locked via lv_lock().
+ */
+bool dashboard_chart_zoom(int step);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "lvgl.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Counts what LVGL actually redraws and pushes to the panel. Every flushed
+ * pixel is two bytes on the SPI bus the MAX31855 shares, so these are the
+ * numbers to watch when a UI change looks like it might repaint too much.
+ * Works off display events, so the simulator's SDL display reports the same
+ * counts as the ST7796S one. */
+
+typedef struct {
+    uint32_t invalidations;      /* areas marked dirty (lv_obj_invalidate and friends) */
+    uint64_t invalidated_pixels; /* their summed size, before LVGL merges overlaps */
+    uint32_t frames;             /* refresh passes that rendered something */
+    uint32_t flushes;            /* flush_cb calls (one per draw-buffer chunk) */
+    uint64_t pixels;             /* pixels handed to flush_cb */
+} render_stats_t;
+
+/* Start counting on `disp`. Call once, with LVGL locked. */
+void render_stats_attach(lv_display_t *disp);
+
+/* Totals since render_stats_attach(). */
+void render_stats_get(render_stats_t *out);
+
+/* Close the current one-second window. display_task calls this from a
+ * 1000 ms LVGL timer; render_stats_last_second() then reports that window. */
+void render_stats_roll(void);
+void render_stats_last_second(render_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -23,8 +23,7 @@ static void send_cmd(firing_cmd_type_t type, const char *desc)
         ESP_LOGE(TAG, "firing engine command queue not available");
         return;
     }
-    firing_cmd_t cmd = {0};
-    cmd.type = type;
+    firing_cmd_t cmd = {.type = type, .source = FIRING_SRC_LCD};
     if (xQueueSend(q, &cmd, pdMS_TO_TICKS(100)) != pdTRUE) {
         ESP_LOGE(TAG, "failed to queue %s", desc);
     } else {
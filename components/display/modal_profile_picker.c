@@ -54,8 +54,7 @@ static void on_start_clicked(lv_event_t *e)
 
     QueueHandle_t q = firing_engine_get_cmd_queue();
     if (q) {
-        firing_cmd_t cmd = {0};
-        cmd.type = FIRING_CMD_START;
+        firing_cmd_t cmd = {.type = FIRING_CMD_START, .source = FIRING_SRC_LCD};
         cmd.start.profile = s_selected_profile;
         cmd.start.delay_minutes = 0;
         if (xQueueSend(q, &cmd, pdMS_TO_TICKS(100)) != pdTRUE) {
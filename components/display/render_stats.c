@@ -0,0 +1,66 @@
+#include "render_stats.h"
+
+#include <string.h>
+
+/* Only touched from LVGL's context (event callbacks and the roll timer both
+ * run under the LVGL lock), so no further locking. */
+static render_stats_t s_total;
+static render_stats_t s_window_start;
+static render_stats_t s_last_second;
+
+static void on_display_event(lv_event_t *e)
+{
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_INVALIDATE_AREA: {
+        const lv_area_t *area = lv_event_get_param(e);
+        s_total.invalidations++;
+        if (area) {
+            s_total.invalidated_pixels += (uint64_t)lv_area_get_size(area);
+        }
+        break;
+    }
+    case LV_EVENT_RENDER_START:
+        s_total.frames++;
+        break;
+    case LV_EVENT_FLUSH_START: {
+        const lv_area_t *area = lv_event_get_param(e);
+        s_total.flushes++;
+        if (area) {
+            s_total.pixels += (uint64_t)lv_area_get_size(area);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void render_stats_attach(lv_display_t *disp)
+{
+    memset(&s_total, 0, sizeof(s_total));
+    memset(&s_window_start, 0, sizeof(s_window_start));
+    memset(&s_last_second, 0, sizeof(s_last_second));
+    lv_display_add_event_cb(disp, on_display_event, LV_EVENT_INVALIDATE_AREA, NULL);
+    lv_display_add_event_cb(disp, on_display_event, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(disp, on_display_event, LV_EVENT_FLUSH_START, NULL);
+}
+
+void render_stats_get(render_stats_t *out)
+{
+    *out = s_total;
+}
+
+void render_stats_roll(void)
+{
+    s_last_second.invalidations = s_total.invalidations - s_window_start.invalidations;
+    s_last_second.invalidated_pixels = s_total.invalidated_pixels - s_window_start.invalidated_pixels;
+    s_last_second.frames = s_total.frames - s_window_start.frames;
+    s_last_second.flushes = s_total.flushes - s_window_start.flushes;
+    s_last_second.pixels = s_total.pixels - s_window_start.pixels;
+    s_window_start = s_total;
+}
+
+void render_stats_last_second(render_stats_t *out)
+{
+    *out = s_last_second;
+}
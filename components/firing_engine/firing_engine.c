@@ -1,17 +1,27 @@
 #include "firing_engine.h"
 #include "firing_engine_internal.h"
+#include "firing_record.h"
+#include "temp_trace.h"
+#include "heat_work.h"
+#include "kiln_capability.h"
 #include "app_config.h"
+#include "mem_budget.h"
 #include "thermocouple.h"
 #include "pid_control.h"
 #include "safety.h"
 #include "firing_history.h"
 #include "ota_manager.h"
+#include "rt_stats.h"
+#ifdef CONFIG_FIRING_TICK_PROFILE
+#include "esp_cpu.h"
+#endif
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "nvs.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
@@ -23,10 +33,16 @@ static const char *TAG = "firing_engine";
 #define NVS_NS_SETTINGS  "kiln_set"
 #define NVS_KEY_INDEX    "idx"
 #define NVS_KEY_ELEM_HRS "elem_hrs"
+#define NVS_KEY_CAP      "kiln_cap"
+
+#define CMD_QUEUE_LEN   4
+#define EVENT_QUEUE_LEN 4
 
 /* Shared state */
 static firing_progress_t s_progress;
 static SemaphoreHandle_t s_progress_mutex;
+/* Min/max trace behind the LCD chart's zoom levels; guarded by s_progress_mutex. */
+static temp_trace_t s_trace;
 
 static kiln_settings_t s_settings;
 static SemaphoreHandle_t s_settings_mutex;
@@ -34,6 +50,14 @@ static SemaphoreHandle_t s_settings_mutex;
 static QueueHandle_t s_cmd_queue;
 static QueueHandle_t s_event_queue;
 
+/* Backing store for the objects above: static, per app_config.h's placement table. */
+static MEM_PLACE(APP_MEM_KERNEL_OBJECTS) StaticSemaphore_t s_progress_mutex_buf;
+static MEM_PLACE(APP_MEM_KERNEL_OBJECTS) StaticSemaphore_t s_settings_mutex_buf;
+static MEM_PLACE(APP_MEM_KERNEL_OBJECTS) StaticQueue_t s_cmd_queue_buf;
+static MEM_PLACE(APP_MEM_KERNEL_OBJECTS) uint8_t s_cmd_queue_storage[CMD_QUEUE_LEN * sizeof(firing_cmd_t)];
+static MEM_PLACE(APP_MEM_KERNEL_OBJECTS) StaticQueue_t s_event_queue_buf;
+static MEM_PLACE(APP_MEM_KERNEL_OBJECTS) uint8_t s_event_queue_storage[EVENT_QUEUE_LEN * sizeof(firing_event_t)];
+
 /* PID controller */
 static pid_controller_t s_pid;
 
@@ -50,6 +74,11 @@ static firing_error_code_t s_last_error_code = FIRING_ERR_NONE;
 static uint32_t s_element_on_s = 0;
 static uint64_t s_element_on_accum_us = 0;
 
+/* Learned full-power rise curve, persisted to NVS next to the element hours.
+ * Only firing_task writes it (at completion, under s_progress_mutex, so
+ * readers on other tasks get a consistent copy). */
+static kiln_cap_t s_cap;
+
 /* ── Internal helpers ──────────────────────────────── */
 
 /* Map a safety trip cause onto the firing error code shown in the UI. */
@@ -82,6 +111,18 @@ static void settings_unlock(void)
     xSemaphoreGive(s_settings_mutex);
 }
 
+/* Append an event to the firing's journal, stamped with the published elapsed
+   time and temperature so it lines up with the recorded trace. */
+static void journal(history_event_kind_t kind, firing_cmd_source_t source, uint8_t arg)
+{
+    history_event_t evt = {.kind = kind, .source = (uint8_t)source, .arg = arg};
+    progress_lock();
+    evt.t_s = s_progress.elapsed_time;
+    evt.temp_c = s_progress.current_temp;
+    progress_unlock();
+    history_log_event(&evt);
+}
+
 /* ── Default Profiles ──────────────────────────────── */
 
 static const firing_profile_t s_default_profiles[] = {
@@ -169,21 +210,154 @@ static void load_default_profiles(void)
     }
 }
 
+/* ── Tick profile (CONFIG_FIRING_TICK_PROFILE) ──────
+ * PHASE(p) closes the phase running so far, charging it the cycles since the
+ * previous mark, and opens p; the end of the tick closes the last one, so a
+ * phase cut short by an early return is still charged. Costs add up per tick
+ * and go into the histograms under one critical section at the end. */
+
+static const char *const s_phase_names[FIRING_PHASE_COUNT] = {
+    [FIRING_PHASE_RECORD] = "record",
+    [FIRING_PHASE_RELAY_TEST] = "relay_test",
+    [FIRING_PHASE_DELAY] = "delay",
+    [FIRING_PHASE_TC_READ] = "tc_read",
+    [FIRING_PHASE_VENT] = "vent",
+    [FIRING_PHASE_EMERGENCY] = "emergency",
+    [FIRING_PHASE_AUTOTUNE] = "autotune",
+    [FIRING_PHASE_WATCHDOGS] = "watchdogs",
+    [FIRING_PHASE_PID] = "pid",
+    [FIRING_PHASE_ELEMENT_HOURS] = "element_hours",
+    [FIRING_PHASE_HISTORY] = "history",
+    [FIRING_PHASE_SEGMENT] = "segment",
+    [FIRING_PHASE_ETA] = "eta",
+};
+
+/* What each phase can end up waiting on, found by reading the tick path. */
+static const char *const s_phase_io[FIRING_PHASE_COUNT] = {
+    [FIRING_PHASE_RECORD] = "spiffs",      /* record writes, fflush once a minute */
+    [FIRING_PHASE_DELAY] = "spiffs",       /* history files created at the start */
+    [FIRING_PHASE_EMERGENCY] = "spiffs",   /* journal and history close on a trip or TC fault */
+    [FIRING_PHASE_AUTOTUNE] = "nvs",       /* tuned gains and element hours at the end */
+    [FIRING_PHASE_ELEMENT_HOURS] = "nvs",  /* nvs_commit every ELEM_SAVE_INTERVAL_US */
+    [FIRING_PHASE_HISTORY] = "spiffs",     /* trace line, fflush every sample */
+    [FIRING_PHASE_SEGMENT] = "spiffs+nvs", /* journal; history close and element hours at the end */
+};
+
+const char *firing_tick_phase_name(firing_tick_phase_t phase)
+{
+    return (unsigned)phase < FIRING_PHASE_COUNT ? s_phase_names[phase] : "?";
+}
+
+const char *firing_tick_phase_io(firing_tick_phase_t phase)
+{
+    return (unsigned)phase < FIRING_PHASE_COUNT ? s_phase_io[phase] : NULL;
+}
+
+#ifdef CONFIG_FIRING_TICK_PROFILE
+
+static MEM_PLACE(APP_MEM_RT_STATS) firing_tick_profile_t s_tick_profile;
+static portMUX_TYPE s_tick_profile_mux = portMUX_INITIALIZER_UNLOCKED;
+
+/* The tick in progress; firing_task only. */
+static uint32_t s_phase_cycles[FIRING_PHASE_COUNT];
+static uint32_t s_phase_ran; /* bit per phase */
+static int s_phase = FIRING_PHASE_COUNT; /* none open */
+static uint32_t s_phase_mark;
+
+static void phase_switch(int next)
+{
+    uint32_t now = esp_cpu_get_cycle_count();
+    if (s_phase < FIRING_PHASE_COUNT) {
+        s_phase_cycles[s_phase] += now - s_phase_mark;
+        s_phase_ran |= 1u << s_phase;
+    }
+    s_phase = next;
+    s_phase_mark = now;
+}
+
+#define PHASE(p) phase_switch(p)
+
+static void tick_profile_begin(void)
+{
+    memset(s_phase_cycles, 0, sizeof(s_phase_cycles));
+    s_phase_ran = 0;
+    s_phase = FIRING_PHASE_COUNT;
+}
+
+static void tick_profile_end(void)
+{
+    phase_switch(FIRING_PHASE_COUNT);
+    int slowest = -1;
+    uint32_t total = 0;
+    portENTER_CRITICAL(&s_tick_profile_mux);
+    for (int p = 0; p < FIRING_PHASE_COUNT; p++) {
+        if (s_phase_ran & (1u << p)) {
+            rt_hist_add(&s_tick_profile.cycles[p], s_phase_cycles[p]);
+            total += s_phase_cycles[p];
+            if (slowest < 0 || s_phase_cycles[p] > s_phase_cycles[slowest]) {
+                slowest = p;
+            }
+        }
+    }
+    portEXIT_CRITICAL(&s_tick_profile_mux);
+    uint32_t total_us = total / CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+    if (slowest >= 0 && total_us > APP_FIRING_TICK_SLOW_MS * 1000u) {
+        ESP_LOGW(TAG, "Slow tick: %" PRIu32 " ms, %" PRIu32 " ms of it in %s", total_us / 1000,
+                 s_phase_cycles[slowest] / CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ / 1000, s_phase_names[slowest]);
+    }
+}
+
+#else
+#define PHASE(p) ((void)0)
+#endif /* CONFIG_FIRING_TICK_PROFILE */
+
+bool firing_engine_get_tick_profile(firing_tick_profile_t *out)
+{
+#ifdef CONFIG_FIRING_TICK_PROFILE
+    portENTER_CRITICAL(&s_tick_profile_mux);
+    *out = s_tick_profile;
+    portEXIT_CRITICAL(&s_tick_profile_mux);
+    return true;
+#else
+    (void)out;
+    return false;
+#endif
+}
+
 /* ── Init ──────────────────────────────────────────── */
 
 esp_err_t firing_engine_init(void)
 {
-    s_progress_mutex = xSemaphoreCreateMutex();
-    s_settings_mutex = xSemaphoreCreateMutex();
-    s_cmd_queue = xQueueCreate(4, sizeof(firing_cmd_t));
-    s_event_queue = xQueueCreate(4, sizeof(firing_event_t));
+    s_progress_mutex = xSemaphoreCreateMutexStatic(&s_progress_mutex_buf);
+    s_settings_mutex = xSemaphoreCreateMutexStatic(&s_settings_mutex_buf);
+    s_cmd_queue = xQueueCreateStatic(CMD_QUEUE_LEN, sizeof(firing_cmd_t), s_cmd_queue_storage, &s_cmd_queue_buf);
+    s_event_queue =
+        xQueueCreateStatic(EVENT_QUEUE_LEN, sizeof(firing_event_t), s_event_queue_storage, &s_event_queue_buf);
 
     if (!s_progress_mutex || !s_settings_mutex || !s_cmd_queue || !s_event_queue) {
         return ESP_ERR_NO_MEM;
     }
+    mem_budget_add("firing_engine", "mutexes", APP_MEM_KERNEL_OBJECTS,
+                   sizeof(s_progress_mutex_buf) + sizeof(s_settings_mutex_buf));
+    mem_budget_add("firing_engine", "queues", APP_MEM_KERNEL_OBJECTS,
+                   sizeof(s_cmd_queue_buf) + sizeof(s_cmd_queue_storage) + sizeof(s_event_queue_buf) +
+                       sizeof(s_event_queue_storage));
+    mem_budget_add("firing_engine", "temp_trace", MEM_REGION_INTERNAL, sizeof(s_trace));
+    mem_budget_add("firing_engine", "capability", MEM_REGION_INTERNAL, sizeof(s_cap) + sizeof(kiln_cap_obs_t));
+#ifdef CONFIG_FIRING_TICK_PROFILE
+    mem_budget_add("firing_engine", "tick profile", APP_MEM_RT_STATS, sizeof(s_tick_profile));
+#endif
+    /* Names for kernel-aware debuggers and the host task simulation; compiles
+       away unless CONFIG_FREERTOS_QUEUE_REGISTRY_SIZE is set. */
+    vQueueAddToRegistry(s_progress_mutex, "progress");
+    vQueueAddToRegistry(s_settings_mutex, "settings");
+    vQueueAddToRegistry(s_cmd_queue, "firing_cmd");
+    vQueueAddToRegistry(s_event_queue, "firing_event");
 
     memset(&s_progress, 0, sizeof(s_progress));
     s_progress.status = FIRING_STATUS_IDLE;
+    s_progress.equiv_cone = HEAT_WORK_NO_CONE;
+    s_progress.kiln_load = 1.0f;
 
     /* Load settings from NVS */
     s_settings.temp_unit = 'F';
@@ -231,16 +405,26 @@ esp_err_t firing_engine_init(void)
         if (nvs_get_i32(handle, "elec_c", &i32) == ESP_OK) {
             s_settings.electricity_cost_kwh = (float)i32 / 1000.0f;
         }
+        /* Tariff bands stored as a blob of tariff_band_t; the count is its size */
+        size_t tariff_sz = sizeof(s_settings.tariff);
+        if (nvs_get_blob(handle, "tariff", s_settings.tariff, &tariff_sz) == ESP_OK &&
+            tariff_sz % sizeof(s_settings.tariff[0]) == 0) {
+            s_settings.tariff_count = (uint8_t)(tariff_sz / sizeof(s_settings.tariff[0]));
+        }
         nvs_close(handle);
     }
 
-    /* Load accumulated element hours */
+    /* Load accumulated element hours and the learned capability curve */
     nvs_handle_t nvs_diag;
     if (nvs_open("kiln_diag", NVS_READONLY, &nvs_diag) == ESP_OK) {
         uint32_t u32;
         if (nvs_get_u32(nvs_diag, NVS_KEY_ELEM_HRS, &u32) == ESP_OK) {
             s_element_on_s = u32;
         }
+        size_t cap_size = sizeof(s_cap);
+        if (nvs_get_blob(nvs_diag, NVS_KEY_CAP, &s_cap, &cap_size) != ESP_OK || cap_size != sizeof(s_cap)) {
+            memset(&s_cap, 0, sizeof(s_cap));
+        }
         nvs_close(nvs_diag);
     }
     s_element_on_accum_us = (uint64_t)s_element_on_s * 1000000ULL;
@@ -278,6 +462,13 @@ void firing_engine_get_progress(firing_progress_t *out)
     progress_unlock();
 }
 
+void firing_engine_get_trace(temp_trace_zoom_t zoom, temp_trace_view_t *out)
+{
+    progress_lock();
+    temp_trace_copy(&s_trace, zoom, out);
+    progress_unlock();
+}
+
 void firing_engine_get_settings(kiln_settings_t *out)
 {
     settings_lock();
@@ -313,6 +504,33 @@ static void save_element_hours(void)
     }
 }
 
+void firing_engine_get_capability(kiln_cap_t *out)
+{
+    progress_lock();
+    *out = s_cap;
+    progress_unlock();
+}
+
+/* HISTORY_SETTING_* bits for what differs between two settings blocks. */
+static uint8_t settings_changed_bits(const kiln_settings_t *a, const kiln_settings_t *b)
+{
+    uint8_t bits = 0;
+    if (a->max_safe_temp != b->max_safe_temp) {
+        bits |= HISTORY_SETTING_MAX_TEMP;
+    }
+    if (a->tc_offset_c != b->tc_offset_c) {
+        bits |= HISTORY_SETTING_TC_OFFSET;
+    }
+    if (a->temp_unit != b->temp_unit || a->alarm_enabled != b->alarm_enabled || a->auto_shutdown != b->auto_shutdown ||
+        a->notifications_enabled != b->notifications_enabled || strcmp(a->webhook_url, b->webhook_url) ||
+        strcmp(a->api_token, b->api_token) || a->element_watts != b->element_watts ||
+        a->electricity_cost_kwh != b->electricity_cost_kwh || a->tariff_count != b->tariff_count ||
+        memcmp(a->tariff, b->tariff, a->tariff_count * sizeof(a->tariff[0]))) {
+        bits |= HISTORY_SETTING_OTHER;
+    }
+    return bits;
+}
+
 esp_err_t firing_engine_set_settings(const kiln_settings_t *settings)
 {
     /* Clamp max_safe_temp to hardware limit */
@@ -325,8 +543,12 @@ esp_err_t firing_engine_set_settings(const kiln_settings_t *settings)
     }
 
     settings_lock();
+    uint8_t changed = settings_changed_bits(&s_settings, &safe);
     s_settings = safe;
     settings_unlock();
+    if (changed) {
+        journal(HISTORY_EVT_SETTINGS, FIRING_SRC_API, changed);
+    }
 
     /* Update safety module */
     safety_set_max_temp(safe.max_safe_temp);
@@ -349,6 +571,11 @@ esp_err_t firing_engine_set_settings(const kiln_settings_t *settings)
     nvs_set_str(handle, "api_tok", safe.api_token);
     nvs_set_i32(handle, "elem_w", (int32_t)safe.element_watts);
     nvs_set_i32(handle, "elec_c", (int32_t)(safe.electricity_cost_kwh * 1000.0f));
+    if (safe.tariff_count) {
+        nvs_set_blob(handle, "tariff", safe.tariff, safe.tariff_count * sizeof(safe.tariff[0]));
+    } else {
+        nvs_erase_key(handle, "tariff");
+    }
     err = nvs_commit(handle);
     nvs_close(handle);
     return err;
@@ -555,6 +782,7 @@ float firing_planned_temp_at(const firing_profile_t *profile, uint32_t t_seconds
 #define RUNAWAY_RATE_MULTIPLIER    2.0f                  /* alert if rate > 2× programmed */
 #define HISTORY_SAMPLE_INTERVAL_US (60LL * 1000000)
 #define ELEM_SAVE_INTERVAL_US      (5LL * 60 * 1000000) /* save every 5 min */
+#define RUNAWAY_ARM_US             (300LL * 1000000)    /* runaway check starts 5 min into a segment */
 
 /* Mutable state for an active firing. Grouped into one struct so a host test
  * harness can snapshot or reset everything in one place. The microsecond
@@ -603,10 +831,31 @@ typedef struct {
 
     /* Element-hours flush cadence. */
     int64_t last_elem_save_us;
+
+    /* Thermocouple was faulting at the last tick (journals fault / recovery edges). */
+    bool tc_faulted;
+
+    /* Heat work since the firing began, and the cone it had reached at the
+       last tick (journals each new cone once). */
+    heat_work_t heat_work;
+    int8_t equiv_cone;
+
+    /* Evidence for the capability curve: per-bin rise at and below full
+       power, the last good reading it is measured from (NAN after a fault or
+       before the first tick), how long the elements have been pinned, and
+       the load figure the ETA scales the curve by. */
+    kiln_cap_obs_t cap_obs;
+    float cap_prev_temp;
+    float cap_full_s;
+    float cap_load;
 } firing_state_t;
 
 static firing_state_t s_state;
 
+/* Wall clock at the previous tick. Owned by firing_tick; firing_task seeds it
+ * from esp_timer_get_time() before entering the loop. */
+static int64_t s_last_compute_us = 0;
+
 /* Relay diagnostic pulse deadline (esp_timer µs); 0 = no test. Guarded by
    s_progress_mutex (progress_lock) rather than living in s_state, because it is
    armed synchronously from the httpd task and read/cleared from firing_task.
@@ -666,7 +915,7 @@ static void emit_event(firing_event_kind_t kind, float peak_temp, uint32_t durat
     }
 }
 
-static void start_segment(int segment_idx, float current_temp, int64_t now_us)
+static void start_segment(int segment_idx, float current_temp, int64_t now_us, firing_cmd_source_t source)
 {
     s_state.segment_start_time_us = now_us;
     s_state.segment_start_temp = current_temp;
@@ -686,20 +935,56 @@ static void start_segment(int segment_idx, float current_temp, int64_t now_us)
     firing_segment_t *seg = &s_state.active_profile.segments[segment_idx];
     ESP_LOGI(TAG, "Starting segment %d: '%s' — ramp %.0f°C/hr to %.0f°C, hold %d min", segment_idx, seg->name,
              seg->ramp_rate, seg->target_temp, seg->hold_time);
+    journal(HISTORY_EVT_SEGMENT, source, (uint8_t)segment_idx);
 }
 
-static void begin_firing(float cur_temp, int64_t now_us)
+static void begin_firing(float cur_temp, int64_t now_us, firing_cmd_source_t source)
 {
-    start_segment(0, cur_temp, now_us);
+    /* History first, so segment 0's start lands in the journal. */
+    history_firing_start(s_state.active_profile.id, s_state.active_profile.name);
+    progress_lock();
+    s_progress.current_temp = cur_temp;
+    progress_unlock();
+    s_state.tc_faulted = false;
+    start_segment(0, cur_temp, now_us, source);
     pid_reset(&s_pid);
     s_state.last_history_sample_us = now_us;
     s_state.peak_temp_c = cur_temp;
-    history_firing_start(s_state.active_profile.id, s_state.active_profile.name);
+    heat_work_reset(&s_state.heat_work);
+    s_state.equiv_cone = HEAT_WORK_NO_CONE;
+    kiln_cap_obs_reset(&s_state.cap_obs);
+    s_state.cap_prev_temp = NAN;
+    s_state.cap_full_s = 0.0f;
+    s_state.cap_load = 1.0f;
     progress_lock();
+    temp_trace_reset(&s_trace);
     s_progress.status = FIRING_STATUS_HEATING;
+    s_progress.equiv_cone = HEAT_WORK_NO_CONE;
+    s_progress.kiln_load = 1.0f;
     progress_unlock();
 }
 
+/* Fold the finished firing's full-power evidence into the curve. Only a
+   completed firing teaches it: one stopped or tripped part-way may have had
+   the lid open or an element out. */
+static void learn_capability(void)
+{
+    progress_lock();
+    bool changed = kiln_cap_learn(&s_cap, &s_state.cap_obs);
+    kiln_cap_t cap = s_cap;
+    progress_unlock();
+    if (!changed) {
+        return;
+    }
+    nvs_handle_t handle;
+    if (nvs_open("kiln_diag", NVS_READWRITE, &handle) == ESP_OK) {
+        nvs_set_blob(handle, NVS_KEY_CAP, &cap, sizeof(cap));
+        nvs_commit(handle);
+        nvs_close(handle);
+    }
+    ESP_LOGI(TAG, "Capability curve updated (load this firing %.2f)", kiln_cap_load(&s_state.cap_obs));
+}
+
 static void complete_firing(float peak, uint32_t dur, bool save_elem_hrs)
 {
     safety_set_ssr(0.0f);
@@ -711,6 +996,7 @@ static void complete_firing(float peak, uint32_t dur, bool save_elem_hrs)
     if (save_elem_hrs) {
         save_element_hours();
     }
+    learn_capability();
     xEventGroupSetBits(safety_get_event_group(), SAFETY_BIT_FIRING_COMPLETE);
     emit_event(FIRING_EVENT_COMPLETE, peak, dur);
 }
@@ -733,8 +1019,156 @@ static void do_stop(void)
     ESP_LOGI(TAG, "Firing stopped");
 }
 
+/* ── Firing record (CONFIG_FIRING_RECORD) ───────────
+ * Logs the inputs the engine consumes during a firing so the host harness can
+ * replay it (see firing_record.h). One file per firing, overwritten by the
+ * next: opened by the START / AUTOTUNE_START command, closed by the first tick
+ * or command that finds the engine inactive again. Inputs are sampled on
+ * entry to firing_tick() and handle_cmd(), so a reading or trip that lands
+ * mid-tick replays at the next one. Settings changed mid-firing are not
+ * recorded. */
+#ifdef CONFIG_FIRING_RECORD
+
+#ifndef FIRING_RECORD_PATH
+#define FIRING_RECORD_PATH "/www/firing.rec"
+#endif
+#define RECORD_FLUSH_INTERVAL_US (60LL * 1000000)
+
+static const char *s_record_path = FIRING_RECORD_PATH;
+static FILE *s_record_file;
+static firing_record_writer_t s_record;
+static int64_t s_record_flush_us;
+
+static bool engine_is_active(void)
+{
+    progress_lock();
+    bool active = s_progress.is_active;
+    progress_unlock();
+    return active;
+}
+
+static void record_open(int64_t now_us)
+{
+    FILE *f = fopen(s_record_path, "wb");
+    if (!f) {
+        ESP_LOGW(TAG, "Cannot create %s; firing not recorded", s_record_path);
+        return;
+    }
+    kiln_settings_t st;
+    firing_engine_get_settings(&st);
+    firing_record_header_t hdr = {
+        .last_tick_us = s_last_compute_us,
+        .tc_offset_c = st.tc_offset_c,
+        .max_safe_temp_c = safety_get_max_temp(),
+        .kp = s_pid.kp,
+        .ki = s_pid.ki,
+        .kd = s_pid.kd,
+    };
+    s_record_file = f;
+    s_record_flush_us = now_us;
+    firing_record_write_header(&s_record, f, &hdr);
+}
+
+static void record_close(void)
+{
+    firing_record_write_end(&s_record);
+    fclose(s_record_file);
+    s_record_file = NULL;
+    ESP_LOGI(TAG, "Firing record closed (%" PRIu32 " bytes)", s_record.bytes);
+}
+
+/* True if a session is open and may take another record. A failed write or
+   the size cap ends it without an END record, which the reader reports as a
+   truncated recording. */
+static bool record_writable(void)
+{
+    if (!s_record_file) {
+        return false;
+    }
+    if (s_record.error || s_record.bytes >= (uint32_t)CONFIG_FIRING_RECORD_MAX_KB * 1024) {
+        ESP_LOGW(TAG, "Firing record stopped at %" PRIu32 " bytes%s", s_record.bytes,
+                 s_record.error ? " (write failed)" : " (size limit)");
+        fclose(s_record_file);
+        s_record_file = NULL;
+        return false;
+    }
+    return true;
+}
+
+static void record_reading(void)
+{
+    thermocouple_reading_t r;
+    thermocouple_get_latest(&r);
+    firing_record_write_reading(&s_record, r.temperature_c, r.fault);
+}
+
+/* The firing ended since the session's last record: finish the file. */
+static void record_close_if_idle(void)
+{
+    if (s_record_file && !engine_is_active()) {
+        record_close();
+    }
+}
+
+static void record_cmd(const firing_cmd_t *cmd, int64_t now_us)
+{
+    record_close_if_idle();
+    bool starts = (cmd->type == FIRING_CMD_START || cmd->type == FIRING_CMD_AUTOTUNE_START);
+    if (!s_record_file && starts && !engine_is_active()) {
+        record_open(now_us);
+    }
+    if (record_writable()) {
+        record_reading();
+        firing_record_write_cmd(&s_record, now_us, cmd);
+    }
+}
+
+static void record_tick(int64_t now_us)
+{
+    record_close_if_idle();
+    if (!record_writable()) {
+        return;
+    }
+    record_reading();
+    safety_trip_cause_t cause = SAFETY_TRIP_NONE;
+    if (safety_is_emergency()) {
+        cause = safety_get_trip_cause();
+        if (cause == SAFETY_TRIP_NONE) {
+            cause = SAFETY_TRIP_OTHER;
+        }
+    }
+    firing_record_write_tick(&s_record, now_us, (uint8_t)cause);
+    if (now_us - s_record_flush_us >= RECORD_FLUSH_INTERVAL_US) {
+        fflush(s_record_file);
+        s_record_flush_us = now_us;
+    }
+}
+
+void firing_engine_set_record_path_for_test(const char *path)
+{
+    s_record_path = path;
+}
+
+#endif /* CONFIG_FIRING_RECORD */
+
+FILE *firing_engine_open_record(void)
+{
+#ifdef CONFIG_FIRING_RECORD
+    return fopen(s_record_path, "rb");
+#else
+    return NULL;
+#endif
+}
+
 static void handle_cmd(const firing_cmd_t *cmd)
 {
+    /* One timestamp for the whole command, so the firing record replays it at
+       exactly the time the engine used. */
+    int64_t now_us = esp_timer_get_time();
+#ifdef CONFIG_FIRING_RECORD
+    record_cmd(cmd, now_us);
+#endif
+
     switch (cmd->type) {
     case FIRING_CMD_START: {
         /* Defense in depth: refuse to overwrite an active firing.
@@ -775,7 +1209,8 @@ static void handle_cmd(const firing_cmd_t *cmd)
         for (uint8_t i = 0; i < np->segment_count; i++) {
             float t = np->segments[i].target_temp;
             float r_rate = np->segments[i].ramp_rate;
-            if (!isfinite(t) || t <= 0.0f || t > max_safe || !isfinite(r_rate) || r_rate == 0.0f) {
+            if (!isfinite(t) || t <= 0.0f || t > max_safe || !isfinite(r_rate) || r_rate == 0.0f ||
+                np->segments[i].end_cone > HEAT_WORK_CONES) {
                 ESP_LOGW(TAG, "START rejected: segment %u invalid (target=%.1f rate=%.1f)", i, t, r_rate);
                 seg_ok = false;
                 break;
@@ -821,7 +1256,6 @@ static void handle_cmd(const firing_cmd_t *cmd)
             }
         }
 
-        int64_t now_us = esp_timer_get_time();
         s_state.delay_active = false;
         if (cmd->start.delay_minutes > 0) {
             s_state.delay_start_end_us = now_us + (int64_t)cmd->start.delay_minutes * 60 * 1000000LL;
@@ -829,6 +1263,8 @@ static void handle_cmd(const firing_cmd_t *cmd)
             progress_lock();
             s_progress.is_active = true;
             s_progress.status = FIRING_STATUS_IDLE; /* show as idle during delay */
+            s_progress.equiv_cone = HEAT_WORK_NO_CONE;
+            s_progress.kiln_load = 1.0f;
             snprintf(s_progress.profile_id, FIRING_ID_LEN, "%s", s_state.active_profile.id);
             s_progress.current_segment = 0;
             s_progress.total_segments = s_state.active_profile.segment_count;
@@ -845,7 +1281,7 @@ static void handle_cmd(const firing_cmd_t *cmd)
             s_progress.elapsed_time = 0;
             progress_unlock();
             s_state.elapsed_accum_us = 0;
-            begin_firing(cur_temp, now_us);
+            begin_firing(cur_temp, now_us, cmd->source);
             ESP_LOGI(TAG, "Firing started: %s", s_state.active_profile.name);
         }
         s_last_error_code = FIRING_ERR_NONE;
@@ -860,6 +1296,7 @@ static void handle_cmd(const firing_cmd_t *cmd)
         progress_unlock();
         float peak = s_state.peak_temp_c;
         if (was_active) {
+            journal(HISTORY_EVT_STOP, cmd->source, 0);
             history_firing_end(HISTORY_OUTCOME_ABORTED, peak, dur, 0);
         }
         s_state.delay_active = false;
@@ -883,7 +1320,8 @@ static void handle_cmd(const firing_cmd_t *cmd)
         progress_unlock();
         if (did_pause) {
             safety_set_ssr(0.0f);
-            s_state.pause_start_us = esp_timer_get_time();
+            s_state.pause_start_us = now_us;
+            journal(HISTORY_EVT_PAUSE, cmd->source, 0);
             ESP_LOGI(TAG, "Firing paused");
         }
         break;
@@ -906,7 +1344,7 @@ static void handle_cmd(const firing_cmd_t *cmd)
                the firing anchors below get. Otherwise a paused run trips its
                timeout the instant it resumes, or folds the pause into an
                oscillation period and saves gains derived from it. */
-            int64_t paused_us = esp_timer_get_time() - s_state.pause_start_us;
+            int64_t paused_us = now_us - s_state.pause_start_us;
             pid_autotune_shift_time(&s_autotune, paused_us);
             ESP_LOGI(TAG, "Auto-tune resumed");
             break;
@@ -917,7 +1355,7 @@ static void handle_cmd(const firing_cmd_t *cmd)
              * and hold timer all resume where they left off. Without this, a long
              * pause makes the engine think the kiln stalled (NOT_RISING) or that
              * the setpoint should jump far ahead. */
-            int64_t paused_us = esp_timer_get_time() - s_state.pause_start_us;
+            int64_t paused_us = now_us - s_state.pause_start_us;
             if (paused_us > 0) {
                 s_state.segment_start_time_us += paused_us;
                 s_state.check_start_time_us += paused_us;
@@ -925,6 +1363,7 @@ static void handle_cmd(const firing_cmd_t *cmd)
                     s_state.segment_hold_start_time_s += (float)paused_us / 1000000.0f;
                 }
             }
+            journal(HISTORY_EVT_RESUME, cmd->source, 0);
             ESP_LOGI(TAG, "Firing resumed");
         }
         break;
@@ -968,7 +1407,7 @@ static void handle_cmd(const firing_cmd_t *cmd)
                 ESP_LOGW(TAG, "SKIP ignored: segment %d ramp direction contradicts the current %.0f°C", next, cur);
                 break;
             }
-            start_segment(next, cur, esp_timer_get_time());
+            start_segment(next, cur, now_us, cmd->source);
             progress_lock();
             s_progress.current_segment = next;
             s_progress.status =
@@ -1023,7 +1462,7 @@ static void handle_cmd(const firing_cmd_t *cmd)
         }
         /* Only flip to AUTOTUNE if the controller actually armed — otherwise a
            rejected start would leave is_active latched on a "ghost" autotune. */
-        if (pid_autotune_start(&s_autotune, at_setpoint, at_hysteresis) != ESP_OK) {
+        if (pid_autotune_start(&s_autotune, at_setpoint, at_hysteresis, now_us) != ESP_OK) {
             ESP_LOGW(TAG, "AUTOTUNE rejected: pid_autotune_start failed");
             break;
         }
@@ -1031,6 +1470,7 @@ static void handle_cmd(const firing_cmd_t *cmd)
         s_progress.is_active = true;
         s_progress.status = FIRING_STATUS_AUTOTUNE;
         s_progress.elapsed_time = 0;
+        temp_trace_reset(&s_trace);
         progress_unlock();
         s_state.elapsed_accum_us = 0;
         ESP_LOGI(TAG, "Auto-tune mode started");
@@ -1042,6 +1482,11 @@ static void handle_cmd(const firing_cmd_t *cmd)
         do_stop();
         break;
     }
+
+#ifdef CONFIG_FIRING_RECORD
+    /* A STOP, or a START that was rejected, ends the session now. */
+    record_close_if_idle();
+#endif
 }
 
 /* compute_dynamic_setpoint and at_target_predicate live in firing_helpers.c
@@ -1051,19 +1496,22 @@ static void handle_cmd(const firing_cmd_t *cmd)
 /* ── Firing tick ────────────────────────────────────
  * Single iteration of the firing loop. firing_task drives this once per
  * second; a host harness can drive it with a virtual clock to fast-forward
- * an entire firing in <1 s for tests. */
+ * an entire firing in <1 s for tests. PHASE() marks where each stretch of the
+ * tick profile begins (CONFIG_FIRING_TICK_PROFILE; no-ops otherwise). */
 
-/* Wall clock at the previous tick. Owned by firing_tick; firing_task seeds it
- * from esp_timer_get_time() before entering the loop. */
-static int64_t s_last_compute_us = 0;
-
-void firing_tick(int64_t now_us)
+static void run_tick(int64_t now_us)
 {
+#ifdef CONFIG_FIRING_RECORD
+    PHASE(FIRING_PHASE_RECORD);
+    record_tick(now_us);
+#endif
+
     /* Relay diagnostic pulse. Re-assert the duty every tick so the safety
        task's 3-second SSR heartbeat stays fed for the whole test — a single
        set-and-sleep would latch an emergency stop on any test longer than 3 s.
        The deadline is armed synchronously by firing_engine_relay_test_arm();
        this tick is the sole SSR writer for it. */
+    PHASE(FIRING_PHASE_RELAY_TEST);
     progress_lock();
     int64_t relay_end = s_relay_test_end_us;
     progress_unlock();
@@ -1081,6 +1529,7 @@ void firing_tick(int64_t now_us)
     }
 
     /* Handle delay-start countdown */
+    PHASE(FIRING_PHASE_DELAY);
     if (s_state.delay_active) {
         /* A latched emergency cancels the armed firing before it starts, so it
            never energizes the kiln a tick later and then errors out. No history
@@ -1121,7 +1570,7 @@ void firing_tick(int64_t now_us)
                 emit_event(FIRING_EVENT_ERROR, s_state.peak_temp_c, 0);
                 return;
             }
-            begin_firing(cur_temp, now_us);
+            begin_firing(cur_temp, now_us, FIRING_SRC_ENGINE);
             /* Reset dt baseline so the PID tick that runs in the rest of this
              * iteration sees dt≈0 (matches pre-refactor behavior). */
             s_last_compute_us = now_us;
@@ -1136,6 +1585,7 @@ void firing_tick(int64_t now_us)
     }
 
     /* Get current temperature (with TC offset applied) */
+    PHASE(FIRING_PHASE_TC_READ);
     thermocouple_reading_t reading;
     thermocouple_get_latest(&reading);
     settings_lock();
@@ -1144,6 +1594,7 @@ void firing_tick(int64_t now_us)
     float current_temp = reading.temperature_c + tc_offset;
 
     /* Drive vent relay once per tick (cheap GPIO write). */
+    PHASE(FIRING_PHASE_VENT);
     progress_lock();
     bool vent_active = s_progress.is_active;
     progress_unlock();
@@ -1155,6 +1606,7 @@ void firing_tick(int64_t now_us)
     s_last_compute_us = now_us;
 
     /* Check for emergency stop */
+    PHASE(FIRING_PHASE_EMERGENCY);
     if (safety_is_emergency()) {
         progress_lock();
         if (s_progress.is_active) {
@@ -1169,6 +1621,7 @@ void firing_tick(int64_t now_us)
             if (s_last_error_code == FIRING_ERR_NONE) {
                 s_last_error_code = firing_err_from_trip(safety_get_trip_cause());
             }
+            journal(HISTORY_EVT_TRIP, FIRING_SRC_ENGINE, (uint8_t)s_last_error_code);
             history_firing_end(HISTORY_OUTCOME_ERROR, peak, dur, (int)s_last_error_code);
             emit_event(FIRING_EVENT_ERROR, peak, dur);
         } else {
@@ -1190,6 +1643,26 @@ void firing_tick(int64_t now_us)
         s_state.peak_temp_c = current_temp;
     }
 
+    /* Capability evidence is measured tick to tick, never across a fault. */
+    float cap_prev_temp = s_state.cap_prev_temp;
+    s_state.cap_prev_temp = reading.fault == 0 ? current_temp : NAN;
+
+    /* Heat work keeps accruing through a pause — the ware doesn't know the
+       program stopped — but not on a faulted reading (0 °C) or in autotune. */
+    if (active && reading.fault == 0 &&
+        (status == FIRING_STATUS_HEATING || status == FIRING_STATUS_HOLDING || status == FIRING_STATUS_COOLING ||
+         status == FIRING_STATUS_PAUSED)) {
+        heat_work_add(&s_state.heat_work, current_temp, dt_s);
+        if (heat_work_reached(&s_state.heat_work, s_state.equiv_cone + 1)) {
+            int cone = heat_work_cone(&s_state.heat_work);
+            s_state.equiv_cone = (int8_t)cone;
+            progress_lock();
+            s_progress.equiv_cone = (int8_t)cone;
+            progress_unlock();
+            journal(HISTORY_EVT_CONE, FIRING_SRC_ENGINE, (uint8_t)cone);
+        }
+    }
+
     if (!active || status == FIRING_STATUS_PAUSED || status == FIRING_STATUS_IDLE || status == FIRING_STATUS_COMPLETE ||
         status == FIRING_STATUS_ERROR) {
         if (status != FIRING_STATUS_PAUSED) {
@@ -1203,6 +1676,10 @@ void firing_tick(int64_t now_us)
      * would command full power, so hold the element off until the reading
      * recovers. safety_task escalates to an emergency stop if the fault
      * persists past APP_TEMP_FAULT_TIMEOUT_MS. */
+    if ((reading.fault != 0) != s_state.tc_faulted) {
+        s_state.tc_faulted = (reading.fault != 0);
+        journal(s_state.tc_faulted ? HISTORY_EVT_TC_FAULT : HISTORY_EVT_TC_OK, FIRING_SRC_ENGINE, reading.fault);
+    }
     if (reading.fault != 0) {
         safety_set_ssr(0.0f);
         return;
@@ -1210,14 +1687,16 @@ void firing_tick(int64_t now_us)
 
     /* Auto-tune mode */
     if (status == FIRING_STATUS_AUTOTUNE) {
+        PHASE(FIRING_PHASE_AUTOTUNE);
         float output;
-        bool done = pid_autotune_update(&s_autotune, current_temp, &output);
+        bool done = pid_autotune_update(&s_autotune, current_temp, now_us, &output);
         safety_set_ssr(output);
 
         s_state.elapsed_accum_us += dt_us;
         progress_lock();
         s_progress.elapsed_time = (uint32_t)(s_state.elapsed_accum_us / 1000000);
         s_progress.target_temp = s_autotune.setpoint;
+        temp_trace_add(&s_trace, (uint32_t)(s_state.elapsed_accum_us / 1000), current_temp);
         progress_unlock();
 
         if (done) {
@@ -1236,6 +1715,7 @@ void firing_tick(int64_t now_us)
     firing_segment_t *seg = &s_state.active_profile.segments[seg_idx];
 
     /* ── Safety: kiln-not-rising check ──────────────────────────────── */
+    PHASE(FIRING_PHASE_WATCHDOGS);
     if (status == FIRING_STATUS_HEATING && !s_state.holding) {
         if ((now_us - s_state.check_start_time_us) >= RISING_CHECK_INTERVAL_US) {
             float temp_rise = current_temp - s_state.check_start_temp;
@@ -1253,7 +1733,7 @@ void firing_tick(int64_t now_us)
     /* ── Safety: rate-of-rise runaway check ──────────────────────────── */
     if (status == FIRING_STATUS_HEATING && !s_state.holding && fabsf(seg->ramp_rate) > 0.1f) {
         float elapsed_seg_s = (float)(now_us - s_state.segment_start_time_us) / 1000000.0f;
-        if (elapsed_seg_s > 300.0f) { /* Only check after 5 minutes in segment */
+        if (elapsed_seg_s > (float)RUNAWAY_ARM_US / 1000000.0f) { /* Only check after 5 minutes in segment */
             float actual_rate_c_hr = ((current_temp - s_state.segment_start_temp) / elapsed_seg_s) * 3600.0f;
             if (actual_rate_c_hr > seg->ramp_rate * RUNAWAY_RATE_MULTIPLIER &&
                 actual_rate_c_hr > 50.0f) { /* Ignore when rate < 50°C/hr (noise) */
@@ -1265,6 +1745,7 @@ void firing_tick(int64_t now_us)
         }
     }
 
+    PHASE(FIRING_PHASE_PID);
     float setpoint = compute_dynamic_setpoint(seg, s_state.segment_start_temp, s_state.segment_start_time_us, now_us,
                                               s_state.holding);
 
@@ -1272,7 +1753,20 @@ void firing_tick(int64_t now_us)
     float output = pid_compute(&s_pid, setpoint, current_temp, dt_s);
     safety_set_ssr(output);
 
+    /* Only heating ramps show how fast the kiln can climb. Pinned at full
+       power the rise is the capability itself (once the thermocouple has
+       caught up with the elements); below it the kiln was keeping up. */
+    if (status == FIRING_STATUS_HEATING && !s_state.holding && !isnan(cap_prev_temp)) {
+        bool full = output >= KILN_CAP_FULL_DUTY;
+        s_state.cap_full_s = full ? s_state.cap_full_s + dt_s : 0.0f;
+        if (!full || s_state.cap_full_s >= KILN_CAP_SETTLE_S) {
+            kiln_cap_observe(&s_state.cap_obs, &s_cap, current_temp, current_temp - cap_prev_temp, dt_s, full);
+            s_state.cap_load = kiln_cap_load(&s_state.cap_obs);
+        }
+    }
+
     /* Accumulate element-on time (sum raw µs so sub-second ticks aren't lost) */
+    PHASE(FIRING_PHASE_ELEMENT_HOURS);
     if (output > 0.0f) {
         s_element_on_accum_us += (uint64_t)dt_us;
         s_element_on_s = (uint32_t)(s_element_on_accum_us / 1000000ULL);
@@ -1283,15 +1777,20 @@ void firing_tick(int64_t now_us)
     }
 
     /* History: record temperature once per minute */
+    PHASE(FIRING_PHASE_HISTORY);
     if ((now_us - s_state.last_history_sample_us) >= HISTORY_SAMPLE_INTERVAL_US) {
-        history_record_temp(current_temp);
+        history_record_temp((uint32_t)(s_state.elapsed_accum_us / 1000000), current_temp);
         s_state.last_history_sample_us = now_us;
     }
 
     /* Check segment transitions */
+    PHASE(FIRING_PHASE_SEGMENT);
     bool reached = at_target_predicate(current_temp, setpoint, seg->target_temp);
+    /* An end cone finishes the segment as soon as the ware is mature, still
+       ramping or part-way through the hold. */
+    bool cone_done = seg->end_cone != 0 && heat_work_reached(&s_state.heat_work, seg->end_cone - 1);
 
-    if (!s_state.holding && reached) {
+    if (!s_state.holding && reached && !cone_done) {
         /* Reached target. hold_time == 0 → pass through (advance next iteration via
            hold_done below). FIRING_HOLD_INDEFINITE → wait for SKIP_SEGMENT. */
         s_state.holding = true;
@@ -1299,6 +1798,7 @@ void firing_tick(int64_t now_us)
         progress_lock();
         s_progress.status = FIRING_STATUS_HOLDING;
         progress_unlock();
+        journal(HISTORY_EVT_HOLD, FIRING_SRC_ENGINE, (uint8_t)seg_idx);
         if (seg->hold_time == FIRING_HOLD_INDEFINITE) {
             ESP_LOGI(TAG, "Segment %d: holding at %.0f°C indefinitely (tap skip to advance)", seg_idx,
                      seg->target_temp);
@@ -1309,59 +1809,172 @@ void firing_tick(int64_t now_us)
         }
     }
 
+    bool hold_done = false;
     if (s_state.holding) {
         float hold_elapsed_s = (float)(now_us) / 1000000.0f - s_state.segment_hold_start_time_s;
         bool infinite_hold = (seg->hold_time == FIRING_HOLD_INDEFINITE);
         float hold_needed_s = infinite_hold ? 0.0f : (float)seg->hold_time * 60.0f;
 
         /* FIRING_HOLD_INDEFINITE waits for SKIP_SEGMENT; any finite duration (incl. 0) advances when elapsed. */
-        bool hold_done = !infinite_hold && (hold_elapsed_s >= hold_needed_s);
+        hold_done = !infinite_hold && (hold_elapsed_s >= hold_needed_s);
+    }
 
-        if (hold_done) {
-            /* Hold complete — advance to next segment */
-            int next_seg = seg_idx + 1;
-            if (next_seg >= s_state.active_profile.segment_count) {
-                /* Firing complete */
-                safety_set_ssr(0.0f);
-                progress_lock();
-                uint32_t dur = s_progress.elapsed_time;
-                s_progress.is_active = false;
-                s_progress.status = FIRING_STATUS_COMPLETE;
-                progress_unlock();
-                float peak = s_state.peak_temp_c;
-                history_firing_end(HISTORY_OUTCOME_COMPLETE, peak, dur, 0);
-                save_element_hours();
-                xEventGroupSetBits(safety_get_event_group(), SAFETY_BIT_FIRING_COMPLETE);
-                emit_event(FIRING_EVENT_COMPLETE, peak, dur);
-                ESP_LOGI(TAG, "Firing complete!");
+    if (hold_done || cone_done) {
+        if (cone_done) {
+            ESP_LOGI(TAG, "Segment %d: end cone (#%d) reached at %.0f°C, advancing", seg_idx, seg->end_cone - 1,
+                     current_temp);
+        }
+        /* Segment complete — advance to next segment */
+        int next_seg = seg_idx + 1;
+        if (next_seg >= s_state.active_profile.segment_count) {
+            /* Firing complete */
+            safety_set_ssr(0.0f);
+            progress_lock();
+            uint32_t dur = s_progress.elapsed_time;
+            s_progress.is_active = false;
+            s_progress.status = FIRING_STATUS_COMPLETE;
+            progress_unlock();
+            float peak = s_state.peak_temp_c;
+            history_firing_end(HISTORY_OUTCOME_COMPLETE, peak, dur, 0);
+            save_element_hours();
+            learn_capability();
+            xEventGroupSetBits(safety_get_event_group(), SAFETY_BIT_FIRING_COMPLETE);
+            emit_event(FIRING_EVENT_COMPLETE, peak, dur);
+            ESP_LOGI(TAG, "Firing complete!");
+        } else {
+            start_segment(next_seg, current_temp, now_us, FIRING_SRC_ENGINE);
+            progress_lock();
+            s_progress.current_segment = next_seg;
+            /* Determine if next segment is heating or cooling */
+            if (s_state.active_profile.segments[next_seg].ramp_rate >= 0) {
+                s_progress.status = FIRING_STATUS_HEATING;
             } else {
-                start_segment(next_seg, current_temp, now_us);
-                progress_lock();
-                s_progress.current_segment = next_seg;
-                /* Determine if next segment is heating or cooling */
-                if (s_state.active_profile.segments[next_seg].ramp_rate >= 0) {
-                    s_progress.status = FIRING_STATUS_HEATING;
-                } else {
-                    s_progress.status = FIRING_STATUS_COOLING;
-                }
-                progress_unlock();
+                s_progress.status = FIRING_STATUS_COOLING;
             }
+            progress_unlock();
         }
     }
 
     /* Update progress timing */
+    PHASE(FIRING_PHASE_ETA);
     s_state.elapsed_accum_us += dt_us;
     progress_lock();
     s_progress.elapsed_time = (uint32_t)(s_state.elapsed_accum_us / 1000000);
     s_progress.target_temp = setpoint;
+    temp_trace_add(&s_trace, (uint32_t)(s_state.elapsed_accum_us / 1000), current_temp);
     /* Live ETA from the current segment/temperature so it stays useful even
        after the kiln runs past the profile's up-front estimate. */
     float hold_elapsed_s = s_state.holding ? ((float)now_us / 1000000.0f - s_state.segment_hold_start_time_s) : 0.0f;
-    s_progress.estimated_remaining = firing_remaining_s(&s_state.active_profile, s_progress.current_segment,
-                                                        current_temp, s_state.holding, hold_elapsed_s);
+    s_progress.kiln_load = s_state.cap_load;
+    s_progress.estimated_remaining =
+        firing_remaining_s(&s_state.active_profile, s_progress.current_segment, current_temp, s_state.holding,
+                           hold_elapsed_s, &s_cap, s_state.cap_load);
     progress_unlock();
 }
 
+void firing_tick(int64_t now_us)
+{
+#ifdef CONFIG_FIRING_TICK_PROFILE
+    tick_profile_begin();
+    run_tick(now_us);
+    tick_profile_end();
+#else
+    run_tick(now_us);
+#endif
+}
+
+/* Float seconds → µs, backed off a few ulps so a float-seconds comparison in
+ * firing_tick cannot come true before the returned time. */
+static int64_t float_s_to_us_early(float s)
+{
+    float ulp = nextafterf(s, INFINITY) - s;
+    return (int64_t)(((double)s - 4.0 * (double)ulp) * 1000000.0);
+}
+
+static int64_t earliest(int64_t a, int64_t b)
+{
+    return a < b ? a : b;
+}
+
+/* At a steady temperature the heat work grows linearly, so the next cone (a
+   journal event, and possibly the segment's end) bends at a known time. A
+   little early, so float dt on one long tick can't carry it past. */
+static int64_t next_cone_us(int64_t now_us, float temp_c)
+{
+    double s = heat_work_seconds_to(&s_state.heat_work, s_state.equiv_cone + 1, temp_c);
+    if (!(s < 1e9)) {
+        return INT64_MAX;
+    }
+    return now_us + (int64_t)(s * 0.999 * 1000000.0);
+}
+
+int64_t firing_next_event_us(int64_t now_us)
+{
+    progress_lock();
+    int64_t relay_end = s_relay_test_end_us;
+    firing_status_t status = s_progress.status;
+    bool active = s_progress.is_active;
+    int seg_idx = s_progress.current_segment;
+    float current_temp = s_progress.current_temp;
+    progress_unlock();
+
+    if (relay_end != 0) {
+        return relay_end;
+    }
+    if (s_state.delay_active) {
+        return s_state.delay_start_end_us;
+    }
+    if (!active || status == FIRING_STATUS_IDLE || status == FIRING_STATUS_COMPLETE || status == FIRING_STATUS_ERROR) {
+        return INT64_MAX;
+    }
+    if (status == FIRING_STATUS_AUTOTUNE) {
+        return now_us;
+    }
+    thermocouple_reading_t reading;
+    thermocouple_get_latest(&reading);
+    if (status == FIRING_STATUS_PAUSED) {
+        return reading.fault != 0 ? INT64_MAX : next_cone_us(now_us, current_temp);
+    }
+    if (reading.fault != 0) {
+        return now_us;
+    }
+
+    /* From here on every tick runs the PID, so it has to be settled on a
+       setpoint that can no longer move: a hold, or a ramp already clamped at
+       its target. A segment entered this tick has not been checked against
+       its own target yet, so one already there starts its hold next tick. */
+    const firing_segment_t *seg = &s_state.active_profile.segments[seg_idx];
+    float setpoint = compute_dynamic_setpoint(seg, s_state.segment_start_temp, s_state.segment_start_time_us, now_us,
+                                              s_state.holding);
+    if (!s_state.holding &&
+        (setpoint != seg->target_temp || at_target_predicate(current_temp, setpoint, seg->target_temp))) {
+        return now_us;
+    }
+    if (!pid_is_settled(&s_pid, setpoint, current_temp)) {
+        return now_us;
+    }
+
+    int64_t next = s_state.last_history_sample_us + HISTORY_SAMPLE_INTERVAL_US;
+    next = earliest(next, next_cone_us(now_us, current_temp));
+    /* Settled means any dt gives the same output, so a throwaway compute shows
+       whether the element-hours flush is still armed. */
+    pid_controller_t probe = s_pid;
+    if (pid_compute(&probe, setpoint, current_temp, 1.0f) > 0.0f) {
+        next = earliest(next, s_state.last_elem_save_us + ELEM_SAVE_INTERVAL_US);
+    }
+    if (s_state.holding && seg->hold_time != FIRING_HOLD_INDEFINITE) {
+        float hold_end_s = s_state.segment_hold_start_time_s + (float)seg->hold_time * 60.0f;
+        next = earliest(next, float_s_to_us_early(hold_end_s));
+    }
+    if (status == FIRING_STATUS_HEATING && !s_state.holding) {
+        next = earliest(next, s_state.check_start_time_us + RISING_CHECK_INTERVAL_US);
+        if (now_us - s_state.segment_start_time_us <= RUNAWAY_ARM_US) {
+            next = earliest(next, s_state.segment_start_time_us + RUNAWAY_ARM_US + 1);
+        }
+    }
+    return next;
+}
+
 /* Block on the command queue until the next 1 Hz deadline, dispatching any
  * commands that arrive in the meantime. Keeps PID cadence anchored to
  * *last_wake while giving commands ms-level latency instead of up to 1 s. */
@@ -1392,7 +2005,9 @@ void firing_task(void *param)
     ESP_LOGI(TAG, "firing_task started");
 
     for (;;) {
+        rt_stats_tick_begin();
         firing_tick(esp_timer_get_time());
+        rt_stats_tick_end();
         wait_until_next_tick(&last_wake);
     }
 }
@@ -1414,6 +2029,9 @@ void firing_engine_reset_for_test(void)
     memset(&s_state, 0, sizeof(s_state));
     memset(&s_progress, 0, sizeof(s_progress));
     s_progress.status = FIRING_STATUS_IDLE;
+    s_progress.equiv_cone = HEAT_WORK_NO_CONE;
+    s_progress.kiln_load = 1.0f;
+    memset(&s_cap, 0, sizeof(s_cap));
     s_last_error_code = FIRING_ERR_NONE;
     s_element_on_s = 0;
     s_element_on_accum_us = 0;
@@ -1433,4 +2051,19 @@ void firing_engine_reset_for_test(void)
         while (xQueueReceive(s_event_queue, &evt, 0) == pdTRUE) {
         }
     }
+
+#ifdef CONFIG_FIRING_RECORD
+    if (s_record_file) {
+        fclose(s_record_file);
+        s_record_file = NULL;
+    }
+#endif
+#ifdef CONFIG_FIRING_TICK_PROFILE
+    memset(&s_tick_profile, 0, sizeof(s_tick_profile));
+#endif
+}
+
+void firing_engine_set_pid_gains_for_test(float kp, float ki, float kd)
+{
+    pid_init(&s_pid, kp, ki, kd, 0.0f, 1.0f);
 }
@@ -61,12 +61,12 @@ int firing_first_bad_ramp_sign(const firing_profile_t *profile, float start_temp
 }
 
 /* Full planned ramp+hold duration of a segment that begins at `start_temp`. */
-static float segment_planned_s(const firing_segment_t *seg, float start_temp)
+static float segment_planned_s(const firing_segment_t *seg, float start_temp, const kiln_cap_t *cap, float load)
 {
     float total = 0.0f;
     float ramp_per_sec = seg->ramp_rate / 3600.0f;
     if (fabsf(ramp_per_sec) > 0.0001f) {
-        total += fabsf((seg->target_temp - start_temp) / ramp_per_sec);
+        total += kiln_cap_ramp_s(cap, load, start_temp, seg->target_temp, seg->ramp_rate);
     }
     if (seg->hold_time != FIRING_HOLD_INDEFINITE) {
         total += (float)seg->hold_time * 60.0f;
@@ -75,7 +75,7 @@ static float segment_planned_s(const firing_segment_t *seg, float start_temp)
 }
 
 uint32_t firing_remaining_s(const firing_profile_t *profile, int current_segment, float current_temp, bool holding,
-                            float hold_elapsed_s)
+                            float hold_elapsed_s, const kiln_cap_t *cap, float load)
 {
     if (!profile || current_segment < 0 || current_segment >= profile->segment_count) {
         return 0;
@@ -100,7 +100,7 @@ uint32_t firing_remaining_s(const firing_profile_t *profile, int current_segment
            overshoot shouldn't add negative time. */
         if (fabsf(ramp_per_sec) > 0.0001f &&
             ((ramp_per_sec > 0.0f && delta > 0.0f) || (ramp_per_sec < 0.0f && delta < 0.0f))) {
-            remaining += fabsf(delta / ramp_per_sec);
+            remaining += kiln_cap_ramp_s(cap, load, current_temp, cur->target_temp, cur->ramp_rate);
         }
         remaining += cur_hold_s;
     }
@@ -108,9 +108,29 @@ uint32_t firing_remaining_s(const firing_profile_t *profile, int current_segment
     /* Later segments: full planned duration, each from the previous target. */
     float seg_start = cur->target_temp;
     for (int i = current_segment + 1; i < profile->segment_count; i++) {
-        remaining += segment_planned_s(&profile->segments[i], seg_start);
+        remaining += segment_planned_s(&profile->segments[i], seg_start, cap, load);
         seg_start = profile->segments[i].target_temp;
     }
 
     return (uint32_t)remaining;
 }
+
+float firing_planned_on_s(const firing_profile_t *profile, float start_temp, const kiln_cap_t *cap)
+{
+    if (!profile) {
+        return 0.0f;
+    }
+    float on_s = 0.0f;
+    float seg_start = start_temp;
+    for (int i = 0; i < profile->segment_count; i++) {
+        const firing_segment_t *seg = &profile->segments[i];
+        if (fabsf(seg->ramp_rate / 3600.0f) > 0.0001f) {
+            on_s += kiln_cap_ramp_on_s(cap, seg_start, seg->target_temp, seg->ramp_rate);
+        }
+        if (seg->hold_time != FIRING_HOLD_INDEFINITE) {
+            on_s += kiln_cap_hold_on_s(cap, seg->target_temp, (float)seg->hold_time * 60.0f);
+        }
+        seg_start = seg->target_temp;
+    }
+    return on_s;
+}
@@ -0,0 +1,303 @@
+#include "firing_record.h"
+
+#include <math.h>
+#include <string.h>
+
+/* Header: magic, version, then the firing_record_header_t fields. */
+static const char MAGIC[4] = {'B', 'Q', 'F', 'R'};
+
+#define TICK_US 1000000LL
+
+/* Tag byte: kind in the high nibble, flags in the low nibble. */
+#define TAG_TICK          0x10 /* low bits: trip cause */
+#define TAG_READING_Q     0x20 /* low bits: fault; payload: zigzag Δ in 0.25 °C steps */
+#define TAG_READING_FLOAT 0x30 /* low bits: fault; payload: raw float (off-grid value) */
+#define TAG_CMD           0x40 /* low bits: firing_cmd_type_t */
+#define TAG_END           0xF0
+
+/* ── Writer ──────────────────────────────────────── */
+
+static void put_bytes(firing_record_writer_t *w, const void *buf, size_t len)
+{
+    if (w->error) {
+        return;
+    }
+    if (fwrite(buf, 1, len, w->f) != len) {
+        w->error = true;
+        return;
+    }
+    w->bytes += (uint32_t)len;
+}
+
+static void put_u8(firing_record_writer_t *w, uint8_t v)
+{
+    put_bytes(w, &v, 1);
+}
+
+static void put_le(firing_record_writer_t *w, uint64_t v, int len)
+{
+    uint8_t buf[8];
+    for (int i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(v >> (8 * i));
+    }
+    put_bytes(w, buf, (size_t)len);
+}
+
+static void put_float(firing_record_writer_t *w, float f)
+{
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    put_le(w, bits, 4);
+}
+
+static void put_varint(firing_record_writer_t *w, uint64_t v)
+{
+    uint8_t buf[10];
+    size_t n = 0;
+    do {
+        uint8_t b = v & 0x7F;
+        v >>= 7;
+        buf[n++] = b | (v ? 0x80 : 0);
+    } while (v);
+    put_bytes(w, buf, n);
+}
+
+static void put_zigzag(firing_record_writer_t *w, int64_t v)
+{
+    put_varint(w, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+}
+
+static void put_time(firing_record_writer_t *w, int64_t t_us)
+{
+    put_zigzag(w, t_us - w->last_us - TICK_US);
+    w->last_us = t_us;
+}
+
+bool firing_record_write_header(firing_record_writer_t *w, FILE *f, const firing_record_header_t *hdr)
+{
+    memset(w, 0, sizeof(*w));
+    w->f = f;
+    w->last_us = hdr->last_tick_us;
+    put_bytes(w, MAGIC, sizeof(MAGIC));
+    put_u8(w, FIRING_RECORD_VERSION);
+    put_le(w, (uint64_t)hdr->last_tick_us, 8);
+    put_float(w, hdr->tc_offset_c);
+    put_float(w, hdr->max_safe_temp_c);
+    put_float(w, hdr->kp);
+    put_float(w, hdr->ki);
+    put_float(w, hdr->kd);
+    return !w->error;
+}
+
+void firing_record_write_reading(firing_record_writer_t *w, float temperature_c, uint8_t fault)
+{
+    if (w->has_reading && fault == w->last_fault &&
+        memcmp(&temperature_c, &w->last_temp_c, sizeof(temperature_c)) == 0) {
+        return;
+    }
+    w->has_reading = true;
+    w->last_temp_c = temperature_c;
+    w->last_fault = fault;
+
+    /* The MAX31855 resolves 0.25 °C, so real readings land on the grid and
+       code as a small delta; anything else (a calibrated stub, NaN, -0) is
+       kept bit-exact as a raw float. */
+    float q = temperature_c * 4.0f;
+    if (fabsf(q) < 1e6f && q == floorf(q) && !(q == 0.0f && signbit(q))) {
+        int32_t quarters = (int32_t)q;
+        put_u8(w, TAG_READING_Q | (fault & 0x0F));
+        put_zigzag(w, (int64_t)quarters - w->last_quarters);
+        w->last_quarters = quarters;
+    } else {
+        put_u8(w, TAG_READING_FLOAT | (fault & 0x0F));
+        put_float(w, temperature_c);
+    }
+}
+
+void firing_record_write_tick(firing_record_writer_t *w, int64_t now_us, uint8_t trip_cause)
+{
+    put_u8(w, TAG_TICK | (trip_cause & 0x0F));
+    put_time(w, now_us);
+}
+
+void firing_record_write_cmd(firing_record_writer_t *w, int64_t now_us, const firing_cmd_t *cmd)
+{
+    put_u8(w, TAG_CMD | ((uint8_t)cmd->type & 0x0F));
+    put_time(w, now_us);
+    if (cmd->type == FIRING_CMD_START) {
+        /* Same raw-struct encoding the profile NVS blobs use; the size guards
+           against a reader built with different FIRING_MAX_* limits. */
+        put_varint(w, cmd->start.delay_minutes);
+        put_le(w, sizeof(cmd->start.profile), 2);
+        put_bytes(w, &cmd->start.profile, sizeof(cmd->start.profile));
+    } else if (cmd->type == FIRING_CMD_AUTOTUNE_START) {
+        put_float(w, cmd->autotune.setpoint);
+        put_float(w, cmd->autotune.hysteresis);
+    }
+}
+
+void firing_record_write_end(firing_record_writer_t *w)
+{
+    put_u8(w, TAG_END);
+}
+
+/* ── Reader ──────────────────────────────────────── */
+
+static bool get_bytes(firing_record_reader_t *r, void *buf, size_t len)
+{
+    return fread(buf, 1, len, r->f) == len;
+}
+
+static bool get_le(firing_record_reader_t *r, uint64_t *out, int len)
+{
+    uint8_t buf[8];
+    if (!get_bytes(r, buf, (size_t)len)) {
+        return false;
+    }
+    uint64_t v = 0;
+    for (int i = 0; i < len; i++) {
+        v |= (uint64_t)buf[i] << (8 * i);
+    }
+    *out = v;
+    return true;
+}
+
+static bool get_float(firing_record_reader_t *r, float *out)
+{
+    uint64_t v;
+    if (!get_le(r, &v, 4)) {
+        return false;
+    }
+    uint32_t bits = (uint32_t)v;
+    memcpy(out, &bits, sizeof(*out));
+    return true;
+}
+
+static bool get_varint(firing_record_reader_t *r, uint64_t *out)
+{
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = fgetc(r->f);
+        if (c == EOF) {
+            return false;
+        }
+        v |= (uint64_t)(c & 0x7F) << shift;
+        if (!(c & 0x80)) {
+            *out = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool get_zigzag(firing_record_reader_t *r, int64_t *out)
+{
+    uint64_t v;
+    if (!get_varint(r, &v)) {
+        return false;
+    }
+    *out = (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+    return true;
+}
+
+static bool get_time(firing_record_reader_t *r, int64_t *out)
+{
+    int64_t delta;
+    if (!get_zigzag(r, &delta)) {
+        return false;
+    }
+    r->last_us += delta + TICK_US;
+    *out = r->last_us;
+    return true;
+}
+
+bool firing_record_read_header(firing_record_reader_t *r, FILE *f, firing_record_header_t *hdr)
+{
+    memset(r, 0, sizeof(*r));
+    r->f = f;
+    char magic[sizeof(MAGIC)];
+    uint8_t version;
+    uint64_t last_tick;
+    if (!get_bytes(r, magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !get_bytes(r, &version, 1) || version != FIRING_RECORD_VERSION || !get_le(r, &last_tick, 8) ||
+        !get_float(r, &hdr->tc_offset_c) || !get_float(r, &hdr->max_safe_temp_c) || !get_float(r, &hdr->kp) ||
+        !get_float(r, &hdr->ki) || !get_float(r, &hdr->kd)) {
+        return false;
+    }
+    hdr->last_tick_us = (int64_t)last_tick;
+    r->last_us = hdr->last_tick_us;
+    return true;
+}
+
+static bool read_cmd(firing_record_reader_t *r, uint8_t type, firing_record_entry_t *out)
+{
+    memset(&out->cmd, 0, sizeof(out->cmd));
+    out->cmd.type = (firing_cmd_type_t)type;
+    if (!get_time(r, &out->time_us)) {
+        return false;
+    }
+    if (type == FIRING_CMD_START) {
+        uint64_t delay, size;
+        if (!get_varint(r, &delay) || !get_le(r, &size, 2) || size != sizeof(out->cmd.start.profile)) {
+            return false;
+        }
+        out->cmd.start.delay_minutes = (uint32_t)delay;
+        return get_bytes(r, &out->cmd.start.profile, sizeof(out->cmd.start.profile));
+    }
+    if (type == FIRING_CMD_AUTOTUNE_START) {
+        return get_float(r, &out->cmd.autotune.setpoint) && get_float(r, &out->cmd.autotune.hysteresis);
+    }
+    return true;
+}
+
+bool firing_record_read_next(firing_record_reader_t *r, firing_record_entry_t *out)
+{
+    if (r->ended || r->truncated) {
+        return false;
+    }
+    int tag = fgetc(r->f);
+    if (tag == EOF) {
+        r->truncated = true;
+        return false;
+    }
+    uint8_t low = (uint8_t)(tag & 0x0F);
+    bool ok;
+    switch (tag & 0xF0) {
+    case TAG_TICK:
+        out->kind = FIRING_RECORD_TICK;
+        out->trip_cause = low;
+        ok = get_time(r, &out->time_us);
+        break;
+    case TAG_READING_Q: {
+        int64_t delta;
+        out->kind = FIRING_RECORD_READING;
+        out->fault = low;
+        ok = get_zigzag(r, &delta);
+        if (ok) {
+            r->last_quarters += (int32_t)delta;
+            out->temperature_c = (float)r->last_quarters / 4.0f;
+        }
+        break;
+    }
+    case TAG_READING_FLOAT:
+        out->kind = FIRING_RECORD_READING;
+        out->fault = low;
+        ok = get_float(r, &out->temperature_c);
+        break;
+    case TAG_CMD:
+        out->kind = FIRING_RECORD_CMD;
+        ok = read_cmd(r, low, out);
+        break;
+    case TAG_END:
+        out->kind = FIRING_RECORD_END;
+        r->ended = true;
+        return true;
+    default:
+        ok = false;
+        break;
+    }
+    if (!ok) {
+        r->truncated = true;
+    }
+    return ok;
+}
@@ -0,0 +1,167 @@
+#include "firing_sim.h"
+#include "firing_engine_internal.h"
+#include "heat_work.h"
+#include "pid_control.h"
+
+#include <math.h>
+#include <string.h>
+
+#define TICK_S 1u
+
+/* Generic full-power curve for bins with nothing learned: 400 °C/h cold,
+   losing a quarter of a degree an hour for every degree hotter — about what a
+   mid-sized electric kiln manages, 75 °C/h at cone 6. */
+#define GENERIC_COLD_CH  400.0f
+#define GENERIC_SLOPE_CH 0.25f
+
+/* Pinned at full power and gaining less than this over the window: stalled. */
+#define STALL_RISE_C   1.0f
+#define STALL_WINDOW_S 1800u
+
+#define FIRST_POINT_EVERY_S 60u
+
+static float generic_rate(int b)
+{
+    return GENERIC_COLD_CH - GENERIC_SLOPE_CH * ((float)b + 0.5f) * KILN_CAP_BIN_C;
+}
+
+/* `cap` with every bin filled: learned bins as they are, the rest the generic
+   curve scaled to match the nearest learned bin (the cooler one on a tie). */
+static void fill_model(const kiln_cap_t *cap, kiln_cap_t *model)
+{
+    memset(model, 0, sizeof(*model));
+    for (int b = 0; b < KILN_CAP_BINS; b++) {
+        int near = -1;
+        for (int d = 0; d < KILN_CAP_BINS && near < 0 && cap; d++) {
+            if (b - d >= 0 && cap->rate_ch[b - d]) {
+                near = b - d;
+            } else if (b + d < KILN_CAP_BINS && cap->rate_ch[b + d]) {
+                near = b + d;
+            }
+        }
+        float rate = generic_rate(b);
+        if (near == b) {
+            rate = cap->rate_ch[b];
+        } else if (near >= 0) {
+            rate *= cap->rate_ch[near] / generic_rate(near);
+        }
+        model->rate_ch[b] = (uint16_t)fmaxf(1.0f, roundf(rate));
+    }
+}
+
+/* A point at `t_s`, carrying the element time so far. */
+static void add_point(firing_sim_result_t *out, uint32_t t_s, float temp_c)
+{
+    if (out->point_count == FIRING_SIM_MAX_POINTS) {
+        for (int i = 1; i < (FIRING_SIM_MAX_POINTS + 1) / 2; i++) {
+            out->points[i] = out->points[2 * i];
+        }
+        out->point_count = (FIRING_SIM_MAX_POINTS + 1) / 2;
+        out->point_every_s *= 2;
+    }
+    out->points[out->point_count++] = (firing_sim_point_t){.t_s = t_s, .temp_c = temp_c, .on_s = out->on_s};
+}
+
+void firing_sim_run(const firing_profile_t *profile, const kiln_cap_t *cap, const firing_sim_config_t *cfg,
+                    firing_sim_result_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->point_every_s = FIRST_POINT_EVERY_S;
+    out->equiv_cone = HEAT_WORK_NO_CONE;
+    float temp = cfg->start_temp_c;
+    out->peak_temp_c = temp;
+    if (!profile || profile->segment_count == 0) {
+        add_point(out, 0, temp);
+        return;
+    }
+
+    kiln_cap_t model;
+    fill_model(cap, &model);
+    float lossless = 0.0f;
+    for (int b = 0; b < KILN_CAP_BINS; b++) {
+        lossless = fmaxf(lossless, model.rate_ch[b]);
+    }
+
+    pid_controller_t pid;
+    pid_init(&pid, cfg->kp, cfg->ki, cfg->kd, 0.0f, 1.0f);
+    heat_work_t hw;
+    heat_work_reset(&hw);
+
+    int seg_idx = 0;
+    float seg_start_temp = temp;
+    uint32_t seg_start_s = 0;
+    bool holding = false;
+    uint32_t hold_start_s = 0;
+    uint32_t stall_since_s = 0;
+    float stall_temp = temp;
+
+    uint32_t t = 0;
+    for (;; t += TICK_S) {
+        if (t % out->point_every_s == 0) {
+            add_point(out, t, temp);
+        }
+        if (t >= FIRING_SIM_MAX_S) {
+            out->outcome = FIRING_SIM_TIMEOUT;
+            break;
+        }
+        if (t && t % FIRING_SIM_YIELD_S == 0 && cfg->yield && !cfg->yield(cfg->ctx)) {
+            out->outcome = FIRING_SIM_CANCELLED;
+            break;
+        }
+
+        const firing_segment_t *seg = &profile->segments[seg_idx];
+        heat_work_add(&hw, temp, TICK_S);
+        float setpoint = compute_dynamic_setpoint(seg, seg_start_temp, (int64_t)seg_start_s * 1000000,
+                                                  (int64_t)t * 1000000, holding);
+        float duty = pid_compute(&pid, setpoint, temp, TICK_S);
+        out->on_s += duty * TICK_S;
+        if (seg->ramp_rate >= 0.0f && setpoint - temp > out->max_lag_c) {
+            out->max_lag_c = setpoint - temp;
+        }
+
+        /* Flat out and going nowhere: the kiln will never get there. */
+        if (duty < KILN_CAP_FULL_DUTY || temp - stall_temp >= STALL_RISE_C) {
+            stall_since_s = t;
+            stall_temp = temp;
+        } else if (t - stall_since_s >= STALL_WINDOW_S) {
+            out->outcome = FIRING_SIM_STALLED;
+            break;
+        }
+
+        /* Segment transitions, as firing_tick makes them. */
+        bool reached = at_target_predicate(temp, setpoint, seg->target_temp);
+        bool cone_done = seg->end_cone != 0 && heat_work_reached(&hw, seg->end_cone - 1);
+        if (!holding && reached && !cone_done) {
+            holding = true;
+            hold_start_s = t;
+            /* Holding until a cone runs on; only a bare indefinite hold waits for a skip. */
+            if (seg->hold_time == FIRING_HOLD_INDEFINITE && seg->end_cone == 0) {
+                out->outcome = FIRING_SIM_WAITS;
+                break;
+            }
+        }
+        bool hold_done = holding && seg->hold_time != FIRING_HOLD_INDEFINITE &&
+                         t - hold_start_s >= (uint32_t)seg->hold_time * 60u;
+        if (hold_done || cone_done) {
+            if (seg_idx + 1 >= profile->segment_count) {
+                out->outcome = FIRING_SIM_COMPLETE;
+                break;
+            }
+            seg_idx++;
+            seg_start_temp = temp;
+            seg_start_s = t;
+            holding = false;
+        }
+
+        float rise_ch = duty * lossless - (lossless - kiln_cap_rate(&model, temp));
+        temp += rise_ch * TICK_S / 3600.0f;
+        out->peak_temp_c = fmaxf(out->peak_temp_c, temp);
+    }
+
+    if (out->points[out->point_count - 1].t_s != t) {
+        add_point(out, t, temp);
+    }
+    out->segment = (uint8_t)seg_idx;
+    out->duration_s = t;
+    out->equiv_cone = (int8_t)heat_work_cone(&hw);
+}
@@ -0,0 +1,99 @@
+#include "heat_work.h"
+
+#include <math.h>
+
+/* Activation temperature E/R, kelvin: the single value that best fits all
+   three speed columns of the Orton table (5 °C RMS over 111 entries). */
+#define HEAT_WORK_B_K 94000.0f
+
+/* Work is counted in equivalent hours at 1000 K, which keeps every rate the
+   tick computes inside single precision (the ESP32-S3 FPU has no double). */
+#define HEAT_WORK_REF_K 1000.0f
+
+/* Below this the rate is under 1e-19: a thousand hours there add less than a
+   millionth of cone 022's threshold, so most of a firing skips the expf(). */
+#define NEGLIGIBLE_BELOW_C 400.0f
+
+/* ln(W) at which each cone bends. Generated from the Orton table with the
+   asymptotic ramp integral ∫exp(-B/T)dT ≈ (T²/B)·exp(-B/T)·(1 - 2x + 6x² -
+   24x³), x = T/B, averaged over the three ramp rates; strictly increasing.
+   Regenerate if the table or B changes. */
+static const float s_ln_threshold[HEAT_WORK_CONES] = {
+    -17.328, -15.652, -12.565, -8.564,  /* 022 .. 019 */
+    -5.288,  -3.434,  -0.158,  1.153,   /* 018 .. 015 */
+    1.807,   5.555,   8.118,   9.169,   /* 014 .. 011 */
+    11.315,  13.153,  15.645,  17.341,  /* 010 .. 07 */
+    18.301,  19.485,  20.781,  21.693,  /* 06 .. 04 */
+    23.607,  24.565,  25.370,  26.082,  /* 03 .. 1 */
+    26.476,  26.852,  27.453,  28.060,  /* 2 .. 5 */
+    29.281,  29.940,  30.684,  31.550,  /* 6 .. 9 */
+    32.611,  32.999,  33.657,  34.426,  /* 10 .. 13 */
+    36.159,                             /* 14 */
+};
+
+/* exp() of the table, filled on first use. */
+static double s_threshold[HEAT_WORK_CONES];
+static bool s_threshold_ready;
+
+static const double *thresholds(void)
+{
+    if (!s_threshold_ready) {
+        for (int i = 0; i < HEAT_WORK_CONES; i++) {
+            s_threshold[i] = exp((double)s_ln_threshold[i]);
+        }
+        s_threshold_ready = true;
+    }
+    return s_threshold;
+}
+
+/* exp(B/Tref - B/T): how many times faster than at 1000 K the ware matures. */
+static float rate_of(float temp_c)
+{
+    if (temp_c < NEGLIGIBLE_BELOW_C) {
+        return 0.0f;
+    }
+    return expf(HEAT_WORK_B_K / HEAT_WORK_REF_K - HEAT_WORK_B_K / (temp_c + 273.15f));
+}
+
+void heat_work_reset(heat_work_t *hw)
+{
+    hw->work_h = 0.0;
+}
+
+void heat_work_add(heat_work_t *hw, float temp_c, float dt_s)
+{
+    if (dt_s > 0.0f) {
+        hw->work_h += (double)(rate_of(temp_c) * (dt_s / 3600.0f));
+    }
+}
+
+int heat_work_cone(const heat_work_t *hw)
+{
+    const double *w = thresholds();
+    int cone = HEAT_WORK_NO_CONE;
+    while (cone + 1 < HEAT_WORK_CONES && hw->work_h >= w[cone + 1]) {
+        cone++;
+    }
+    return cone;
+}
+
+bool heat_work_reached(const heat_work_t *hw, int cone)
+{
+    if (cone < 0 || cone >= HEAT_WORK_CONES) {
+        return false;
+    }
+    return hw->work_h >= thresholds()[cone];
+}
+
+double heat_work_seconds_to(const heat_work_t *hw, int cone, float temp_c)
+{
+    if (cone < 0 || cone >= HEAT_WORK_CONES) {
+        return INFINITY;
+    }
+    double need_h = thresholds()[cone] - hw->work_h;
+    if (need_h <= 0.0) {
+        return 0.0;
+    }
+    float rate = rate_of(temp_c);
+    return rate > 0.0f ? need_h / rate * 3600.0 : INFINITY;
+}
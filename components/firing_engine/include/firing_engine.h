@@ -1,9 +1,13 @@
 #pragma once
 
 #include "firing_types.h"
+#include "temp_trace.h"
+#include "kiln_capability.h"
+#include "rt_hist.h"
 #include "esp_err.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include <stdio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -80,6 +84,13 @@ QueueHandle_t firing_engine_get_event_queue(void);
  */
 void firing_engine_get_progress(firing_progress_t *out);
 
+/**
+ * Copy one zoom level of the current firing's temperature trace (thread-safe).
+ * Fed every tick and emptied when a firing or auto-tune starts; the dashboard
+ * chart draws from this, so switching zoom costs one copy.
+ */
+void firing_engine_get_trace(temp_trace_zoom_t zoom, temp_trace_view_t *out);
+
 /**
  * Get current kiln settings (thread-safe copy).
  */
@@ -130,6 +141,61 @@ firing_error_code_t firing_engine_get_error_code(void);
  */
 uint32_t firing_engine_get_element_hours_s(void);
 
+/**
+ * Copy the learned full-power rise curve (thread-safe). Updated and saved to
+ * NVS when a firing completes; all zero until the first one does.
+ */
+void firing_engine_get_capability(kiln_cap_t *out);
+
+/**
+ * Open the latest firing record for reading ("rb"), or NULL if there is none
+ * or the build has CONFIG_FIRING_RECORD off. The caller closes it. The file
+ * may still be growing during a firing; the decoder treats the unflushed
+ * tail as truncated.
+ */
+FILE *firing_engine_open_record(void);
+
+/* ── Tick profile (CONFIG_FIRING_TICK_PROFILE) ───── */
+
+/* The stretches of firing_tick() timed separately, in the order they run. A
+ * tick that returns early skips the phases after it. */
+typedef enum {
+    FIRING_PHASE_RECORD,        /* firing record input log */
+    FIRING_PHASE_RELAY_TEST,    /* relay diagnostic pulse */
+    FIRING_PHASE_DELAY,         /* delayed-start countdown, firing start */
+    FIRING_PHASE_TC_READ,       /* latest reading + TC offset */
+    FIRING_PHASE_VENT,          /* vent relay */
+    FIRING_PHASE_EMERGENCY,     /* emergency stop, run state, TC fault hold */
+    FIRING_PHASE_AUTOTUNE,      /* auto-tune step */
+    FIRING_PHASE_WATCHDOGS,     /* not-rising and runaway checks */
+    FIRING_PHASE_PID,           /* setpoint, PID, SSR duty */
+    FIRING_PHASE_ELEMENT_HOURS, /* element-on time and its periodic save */
+    FIRING_PHASE_HISTORY,       /* once-a-minute history sample */
+    FIRING_PHASE_SEGMENT,       /* hold / segment / completion transitions */
+    FIRING_PHASE_ETA,           /* elapsed time, LCD trace, remaining time */
+    FIRING_PHASE_COUNT
+} firing_tick_phase_t;
+
+/* CPU cycles each phase took, one sample per tick that ran it, since boot. */
+typedef struct {
+    rt_hist_t cycles[FIRING_PHASE_COUNT];
+} firing_tick_profile_t;
+
+/**
+ * Copy the per-phase tick profile. Returns false (and leaves `out` alone)
+ * when the build has CONFIG_FIRING_TICK_PROFILE off. `out` is ~7 KB.
+ */
+bool firing_engine_get_tick_profile(firing_tick_profile_t *out);
+
+/** Short name of a phase ("pid", "element_hours", ...). */
+const char *firing_tick_phase_name(firing_tick_phase_t phase);
+
+/**
+ * Storage a phase may block on from inside the tick: "spiffs", "nvs",
+ * "spiffs+nvs", or NULL for a phase that only touches RAM and GPIO.
+ */
+const char *firing_tick_phase_io(firing_tick_phase_t phase);
+
 /**
  * Compute the planned setpoint at a given elapsed time within a profile.
  *
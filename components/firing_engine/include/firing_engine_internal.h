@@ -10,6 +10,7 @@
  */
 
 #include "firing_types.h"
+#include "kiln_capability.h"
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -51,10 +52,25 @@ bool at_target_predicate(float current_temp, float setpoint, float target_temp);
  * (unknown duration). Returns 0 for a NULL/empty profile or an out-of-range
  * segment.
  *
+ * Heating ramps run no faster than the learned capability `cap` scaled by
+ * `load` (see kiln_capability.h); pass NULL to take every programmed rate at
+ * face value.
+ *
  * Pure: no globals, no I/O.
  */
 uint32_t firing_remaining_s(const firing_profile_t *profile, int current_segment, float current_temp, bool holding,
-                            float hold_elapsed_s);
+                            float hold_elapsed_s, const kiln_cap_t *cap, float load);
+
+/**
+ * Element-on time, in seconds at full power, to fire the whole of `profile`
+ * from `start_temp`: the same segment walk as firing_remaining_s() from
+ * segment 0, with each ramp and finite hold costed by kiln_cap_ramp_on_s() /
+ * kiln_cap_hold_on_s(). Indefinite holds contribute 0. Multiply by the element
+ * power for energy.
+ *
+ * Pure: no globals, no I/O.
+ */
+float firing_planned_on_s(const firing_profile_t *profile, float start_temp, const kiln_cap_t *cap);
 
 /**
  * Find the first segment whose ramp-rate sign is inconsistent with the
@@ -98,6 +114,31 @@ bool firing_engine_relay_test_arm(uint32_t duration_s);
  */
 void firing_tick(int64_t now_us);
 
+/**
+ * Earliest time at which firing_tick() could do anything other than repeat
+ * the tick it just ran at `now_us`, assuming its inputs — thermocouple
+ * reading, safety state, settings — stay as they were and no command arrives.
+ *
+ * Before then a tick only re-asserts the same SSR duty and vent state and
+ * advances the elapsed-time and element-on accumulators, which sum to the same
+ * µs however the ticks are spaced. A host simulator whose plant is a fixed
+ * point under the engine's current outputs may therefore skip every tick
+ * before the returned time except the last one, and run that one with the
+ * whole gap as its dt: the event tick that follows sees the same dt and the
+ * same published progress as under tick-by-tick execution, and the engine
+ * ends up exactly where that would have left it. Scheduled events are the
+ * delay expiry, the relay-test deadline, the end of a finite hold, the next
+ * history sample, the element-hours flush, the not-rising / runaway windows
+ * and the next cone the heat work reaches. The caller must still run a real tick before dispatching a command
+ * or changing an input.
+ *
+ * Returns `now_us` when the next tick cannot be skipped (PID still settling,
+ * setpoint still ramping, auto-tune, TC fault) and INT64_MAX when nothing is
+ * scheduled (idle, finished, paused with no cone due). Host-only: firing_task never calls it
+ * and always ticks at 1 Hz.
+ */
+int64_t firing_next_event_us(int64_t now_us);
+
 /**
  * Dispatch a command synchronously (the firmware does this via the cmd queue
  * drained inside firing_task). Test-only entry point — production callers
@@ -107,11 +148,24 @@ void firing_engine_dispatch_cmd_for_test(const firing_cmd_t *cmd);
 
 /**
  * Reset all firing-engine state (active profile, timing, errors, element
- * hours, PID, autotune, progress). Use between tests to keep cases
+ * hours, capability curve, PID, autotune, progress). Use between tests to keep cases
  * independent. Does NOT touch NVS — call nvs_reset_for_test() separately.
+ * Closes any open firing record and empties the tick profile.
  */
 void firing_engine_reset_for_test(void);
 
+/**
+ * Replace the live PID gains without touching NVS (the gains are otherwise
+ * only loaded at init and by a completed auto-tune).
+ */
+void firing_engine_set_pid_gains_for_test(float kp, float ki, float kd);
+
+/**
+ * Redirect the firing record (CONFIG_FIRING_RECORD builds only) to `path`,
+ * e.g. so a replay can record itself next to the file it is reading.
+ */
+void firing_engine_set_record_path_for_test(const char *path);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,109 @@
+#pragma once
+
+/**
+ * Compact binary recording of everything the firing engine consumes during a
+ * firing — each tick's timestamp and safety state, every thermocouple reading
+ * it saw, and every command it handled — so a field firing can be replayed
+ * through the real firing_engine.c on the host (tests/host/firing_replay.c)
+ * and land on the same SSR duty, setpoint and status, tick for tick.
+ *
+ * Plain stdio + fixed little-endian encoding: the same code writes the file
+ * on the device (SPIFFS) and reads it back on the host. No ESP-IDF
+ * dependencies.
+ *
+ * Layout: a fixed header, then a stream of records, each one tag byte
+ * (kind in the high nibble, per-kind flags in the low nibble) plus a payload.
+ * Timestamps are stored as zigzag varints of (t − previous t − 1 s), so the
+ * 1 Hz tick costs two bytes and a reading that moved by a quarter degree
+ * another two.
+ */
+
+#include "firing_types.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FIRING_RECORD_VERSION 1
+
+/* Engine configuration the recording depends on, captured when it begins. */
+typedef struct {
+    int64_t last_tick_us; /* firing_tick() time preceding the first record (the dt baseline) */
+    float tc_offset_c;
+    float max_safe_temp_c; /* safety_get_max_temp() */
+    float kp, ki, kd;      /* PID gains in effect */
+} firing_record_header_t;
+
+typedef enum {
+    FIRING_RECORD_TICK,    /* firing_tick(time_us) ran with trip_cause latched */
+    FIRING_RECORD_READING, /* thermocouple_get_latest() now returns temperature_c / fault */
+    FIRING_RECORD_CMD,     /* handle_cmd(cmd) ran at time_us */
+    FIRING_RECORD_END,     /* recording closed cleanly */
+} firing_record_kind_t;
+
+typedef struct {
+    firing_record_kind_t kind;
+    int64_t time_us;     /* TICK, CMD */
+    uint8_t trip_cause;  /* TICK: safety_trip_cause_t, SAFETY_TRIP_NONE if not tripped */
+    float temperature_c; /* READING */
+    uint8_t fault;       /* READING: TC_FAULT_* bits */
+    firing_cmd_t cmd;    /* CMD */
+} firing_record_entry_t;
+
+typedef struct {
+    FILE *f;
+    int64_t last_us;
+    int32_t last_quarters; /* previous reading in 0.25 °C steps, for delta coding */
+    bool has_reading;
+    float last_temp_c;
+    uint8_t last_fault;
+    uint32_t bytes; /* bytes written so far, header included */
+    bool error;     /* a write failed; later writes are dropped */
+} firing_record_writer_t;
+
+typedef struct {
+    FILE *f;
+    int64_t last_us;
+    int32_t last_quarters;
+    bool ended;     /* END record seen */
+    bool truncated; /* stream stopped mid-record or without an END record */
+} firing_record_reader_t;
+
+/**
+ * Start a recording on `f` (opened "wb") and write the header. Returns false
+ * if the write fails.
+ */
+bool firing_record_write_header(firing_record_writer_t *w, FILE *f, const firing_record_header_t *hdr);
+
+/**
+ * Append a reading, but only if it differs from the last one written —
+ * recording every tick's reading would double the file for a kiln at steady
+ * state.
+ */
+void firing_record_write_reading(firing_record_writer_t *w, float temperature_c, uint8_t fault);
+
+void firing_record_write_tick(firing_record_writer_t *w, int64_t now_us, uint8_t trip_cause);
+void firing_record_write_cmd(firing_record_writer_t *w, int64_t now_us, const firing_cmd_t *cmd);
+void firing_record_write_end(firing_record_writer_t *w);
+
+/**
+ * Open a recording for reading (`f` opened "rb"). Returns false if the header
+ * is missing, has the wrong magic, or a version this build does not read.
+ */
+bool firing_record_read_header(firing_record_reader_t *r, FILE *f, firing_record_header_t *hdr);
+
+/**
+ * Decode the next record into `out`. Returns false at the end of the stream —
+ * after an END record, at EOF, or at a record cut short by a power loss
+ * (r->truncated tells those apart). Everything before a truncated tail still
+ * decodes, so a recording from a firing that died mid-write stays useful.
+ */
+bool firing_record_read_next(firing_record_reader_t *r, firing_record_entry_t *out);
+
+#ifdef __cplusplus
+}
+#endif
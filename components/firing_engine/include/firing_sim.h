@@ -0,0 +1,83 @@
+#pragma once
+
+/**
+ * Firing simulator: fires a profile against a model of this kiln, much faster
+ * than real time, to predict the temperature curve, when the firing ends, how
+ * much element time it needs and whether the kiln keeps up — without the live
+ * engine, the SSR or any state the engine owns.
+ *
+ * The segment rules are firing_tick's own, one 1 s tick at a time: the same
+ * setpoint (compute_dynamic_setpoint), PID, at-target test, holds, end cones
+ * (heat_work.h) and advance. The engine's watchdogs are not modelled.
+ *
+ * The plant is the learned full-power curve (kiln_capability.h) read as a heat
+ * balance: at temperature T the elements at full power add c0 °C/h — the
+ * fastest rise the curve shows anywhere — and losses take away c0 − c(T), so
+ * full power climbs at exactly c(T) and the element off cools at c0 − c(T).
+ * Bins nothing has been learned for follow a generic curve scaled to the
+ * nearest learned bin, or as it stands on a kiln that has learned nothing yet.
+ * There is no thermal lag and no thermocouple: a prediction, not a replay (the
+ * host tests' kiln_model.c is the detailed plant).
+ *
+ * Pure: no ESP-IDF dependencies, host-testable.
+ */
+
+#include "firing_types.h"
+#include "kiln_capability.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FIRING_SIM_MAX_POINTS 200
+#define FIRING_SIM_MAX_S      (72u * 3600u) /* a run still going after this gives up */
+#define FIRING_SIM_YIELD_S    1800u         /* simulated seconds between yield calls */
+
+typedef enum {
+    FIRING_SIM_COMPLETE,  /* every segment done */
+    FIRING_SIM_WAITS,     /* reached an indefinite hold with no end cone: the firing waits for a skip */
+    FIRING_SIM_STALLED,   /* at full power and no longer getting anywhere */
+    FIRING_SIM_TIMEOUT,   /* still firing after FIRING_SIM_MAX_S */
+    FIRING_SIM_CANCELLED, /* the yield hook asked to stop */
+} firing_sim_outcome_t;
+
+typedef struct {
+    float start_temp_c;
+    float kp, ki, kd; /* the engine's PID gains */
+    /* Called every FIRING_SIM_YIELD_S simulated seconds (may be NULL); return
+       false to stop the run. */
+    bool (*yield)(void *ctx);
+    void *ctx;
+} firing_sim_config_t;
+
+typedef struct {
+    uint32_t t_s;
+    float temp_c;
+    float on_s; /* element-on time from the start to t_s: the power curve */
+} firing_sim_point_t;
+
+typedef struct {
+    firing_sim_outcome_t outcome;
+    uint8_t segment;     /* where the run ended */
+    uint32_t duration_s; /* to the end of the run */
+    float on_s;          /* element-on time at full power; × element watts for energy */
+    float peak_temp_c;
+    float max_lag_c;    /* furthest the kiln fell behind a heating setpoint */
+    int8_t equiv_cone;  /* heat work at the end (HEAT_WORK_NO_CONE below cone 022) */
+    uint32_t point_every_s;
+    uint16_t point_count;
+    firing_sim_point_t points[FIRING_SIM_MAX_POINTS]; /* every point_every_s from 0, then the end */
+} firing_sim_result_t;
+
+/* Fire `profile` against the kiln `cap` describes (may be NULL) and write the
+ * prediction to `out`. The curve keeps at most FIRING_SIM_MAX_POINTS: each time
+ * it fills, every other point goes and the spacing doubles. */
+void firing_sim_run(const firing_profile_t *profile, const kiln_cap_t *cap, const firing_sim_config_t *cfg,
+                    firing_sim_result_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -14,7 +14,10 @@ extern "C" {
 #define FIRING_ID_LEN       40
 
 /* Sentinel for hold_time meaning "hold until skip" (operator advances manually).
-   0 means no hold (advance immediately on reaching target). */
+   0 means no hold (advance immediately on reaching target). A segment with
+   end_cone set also advances — mid-ramp or mid-hold — once the firing's heat
+   work reaches that cone, so "hold until cone 6" is FIRING_HOLD_INDEFINITE plus
+   end_cone, and a finite hold_time caps the soak. */
 #define FIRING_HOLD_INDEFINITE 0xFFFF
 
 /* Matches web_ui/src/app/types/kiln.ts FiringSegment */
@@ -24,6 +27,7 @@ typedef struct {
     float ramp_rate;    /* °C per hour (positive = heating, negative = cooling) */
     float target_temp;  /* °C */
     uint16_t hold_time; /* minutes */
+    uint8_t end_cone;   /* 0 = none, else cone_id_t + 1: also advance once the heat work reaches that cone */
 } firing_segment_t;
 
 /* Matches FiringProfile */
@@ -60,8 +64,20 @@ typedef struct {
     uint32_t elapsed_time;        /* seconds */
     uint32_t estimated_remaining; /* seconds */
     firing_status_t status;
+    int8_t equiv_cone; /* cone_id_t the heat work so far has reached, -1 below cone 022 */
+    float kiln_load;   /* full-power rise vs the learned curve this firing (1 = typical) */
 } firing_progress_t;
 
+/* Time-of-use tariff: a daily cycle in local time. Each band's price holds
+   from its start until the next band's; the last runs past midnight to the
+   first. */
+#define FIRING_TARIFF_MAX_BANDS 8
+
+typedef struct {
+    uint16_t start_min; /* minutes past local midnight, 0..1439 */
+    float cost_kwh;
+} tariff_band_t;
+
 /* Matches KilnSettings */
 typedef struct {
     char temp_unit;      /* 'C' or 'F' */
@@ -74,6 +90,10 @@ typedef struct {
     char api_token[64];         /* API bearer token (empty = auth disabled) */
     float element_watts;        /* Kiln element power for cost estimation */
     float electricity_cost_kwh; /* Electricity cost per kWh */
+    /* Time-of-use bands, ascending start_min; none = electricity_cost_kwh
+       around the clock */
+    uint8_t tariff_count;
+    tariff_band_t tariff[FIRING_TARIFF_MAX_BANDS];
 } kiln_settings_t;
 
 /* Commands sent from web API to firing_task */
@@ -87,8 +107,16 @@ typedef enum {
     FIRING_CMD_AUTOTUNE_STOP,
 } firing_cmd_type_t;
 
+/* Who asked for a command; recorded in the firing's event journal. */
+typedef enum {
+    FIRING_SRC_ENGINE = 0, /* the engine itself (delay expiry, segment advance) */
+    FIRING_SRC_API,        /* REST API */
+    FIRING_SRC_LCD,        /* touchscreen */
+} firing_cmd_source_t;
+
 typedef struct {
     firing_cmd_type_t type;
+    firing_cmd_source_t source;
     union {
         struct {
             firing_profile_t profile; /* For START */
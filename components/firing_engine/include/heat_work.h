@@ -0,0 +1,56 @@
+#pragma once
+
+/**
+ * Heat work: how far a firing has matured the ware, as the cone a pyrometric
+ * cone in the kiln would have bent to by now. Orton cones measure the whole
+ * time-temperature history, not a peak temperature, which is why the cone
+ * table lists a different temperature for each final ramp speed.
+ *
+ * The model is a single Arrhenius rate k(T) = exp(-B/T) (T in kelvin),
+ * integrated over the firing: W = ∫ k(T) dt, kept as equivalent hours at
+ * 1000 K. A cone bends once W passes its
+ * threshold. B and the per-cone thresholds were fitted to the 60/150/300 °C/h
+ * columns of the Orton table in cone_table.c: each threshold is the mean W a
+ * constant ramp at those three rates accumulates by the listed temperature,
+ * and a constant ramp through the model reaches the listed temperature within
+ * ~10 °C for most cones (23 °C worst, at cone 014). Holds at peak, slow
+ * finishing ramps and down-firing all count, as they do for a real cone.
+ *
+ * Plain data structure with no locking and no ESP-IDF dependencies; the
+ * firing engine owns the live instance and publishes the cone reached in
+ * firing_progress_t.
+ */
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HEAT_WORK_CONES   37 /* thresholds, indexed like cone_id_t (CONE_022 .. CONE_14) */
+#define HEAT_WORK_NO_CONE (-1)
+
+typedef struct {
+    double work_h; /* ∫ exp(B/1000 K - B/T) dt, hours */
+} heat_work_t;
+
+/* Zero the accumulator. Call when a firing starts. */
+void heat_work_reset(heat_work_t *hw);
+
+/* Fold in `dt_s` seconds spent at `temp_c`. */
+void heat_work_add(heat_work_t *hw, float temp_c, float dt_s);
+
+/* Highest cone whose threshold the accumulated work has passed, or
+ * HEAT_WORK_NO_CONE below the first (cone 022). */
+int heat_work_cone(const heat_work_t *hw);
+
+/* True once the accumulated work has passed `cone`'s threshold. */
+bool heat_work_reached(const heat_work_t *hw, int cone);
+
+/* Seconds at a steady `temp_c` until `cone` bends: 0 if it already has,
+ * INFINITY for a cone outside the table or a kiln too cold to get there. */
+double heat_work_seconds_to(const heat_work_t *hw, int cone, float temp_c);
+
+#ifdef __cplusplus
+}
+#endif
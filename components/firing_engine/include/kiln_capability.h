@@ -0,0 +1,105 @@
+#pragma once
+
+/**
+ * Kiln capability: the fastest rise this kiln manages at full power, as a
+ * function of temperature, learned from its own completed firings. Element
+ * power is roughly fixed while losses grow steeply with temperature, so a
+ * kiln that does 400 °C/h through the low range may manage well under
+ * 100 °C/h near cone 6 — and a programmed 150 °C/h there just pins the
+ * elements on while the setpoint runs away from the kiln.
+ *
+ * The curve is a table of KILN_CAP_BIN_C-wide temperature bins. During a
+ * firing the engine feeds each heating tick into a kiln_cap_obs_t: ticks
+ * with the elements pinned at full power measure the capability directly,
+ * ticks where the kiln kept up at part power only show it is at least that
+ * fast. When the firing completes, kiln_cap_learn() folds the observation
+ * into the stored curve (a running average over the first few firings, then
+ * an exponential one, so element ageing shows through).
+ *
+ * Load is the other half: a packed kiln heats slower than an empty one. The
+ * observation also carries how this firing's full-power rise compares with
+ * the curve so far (kiln_cap_load()), and the ETA scales the curve by it.
+ *
+ * Plain data structure with no locking and no ESP-IDF dependencies; the
+ * firing engine owns the live instances and persists the curve to NVS.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KILN_CAP_BIN_C 50
+#define KILN_CAP_BINS  28 /* 0 .. 1400 °C; hotter readings land in the last bin */
+
+/* Full-power or keeping-up time a firing needs in a bin before it counts. */
+#define KILN_CAP_MIN_OBS_S 300.0f
+
+/* Duty the engine treats as full power, and how long it must have been there
+   before a tick counts — the thermocouple lags the elements by minutes. */
+#define KILN_CAP_FULL_DUTY 0.98f
+#define KILN_CAP_SETTLE_S  120.0f
+
+/* Stored curve, persisted verbatim as an NVS blob. */
+typedef struct {
+    uint16_t rate_ch[KILN_CAP_BINS]; /* full-power rise, °C/h; 0 = not learned yet */
+    uint8_t firings[KILN_CAP_BINS];  /* completed firings folded into the bin, saturating */
+} kiln_cap_t;
+
+/* One firing's evidence, per bin. */
+typedef struct {
+    float full_rise_c[KILN_CAP_BINS]; /* rise while at full power */
+    float full_s[KILN_CAP_BINS];
+    float kept_rise_c[KILN_CAP_BINS]; /* rise while keeping up at part power */
+    float kept_s[KILN_CAP_BINS];
+    float load_rise_c;   /* full-power rise in bins the curve already knows ... */
+    float load_expect_c; /* ... and what the curve predicted for the same time */
+} kiln_cap_obs_t;
+
+void kiln_cap_obs_reset(kiln_cap_obs_t *obs);
+
+/* Fold in a heating tick: `rise_c` over `dt_s` ending at `temp_c`, with the
+ * elements at full power or not. `cap` (may be NULL) is the curve used to
+ * measure this firing's load. */
+void kiln_cap_observe(kiln_cap_obs_t *obs, const kiln_cap_t *cap, float temp_c, float rise_c, float dt_s,
+                      bool full_power);
+
+/* This firing's full-power rise relative to the learned curve — below 1 for a
+ * heavier-than-usual load. 1 until there is enough to judge; clamped to
+ * [0.5, 1.5]. */
+float kiln_cap_load(const kiln_cap_obs_t *obs);
+
+/* Fold a completed firing into the curve. Returns true if any bin changed. */
+bool kiln_cap_learn(kiln_cap_t *cap, const kiln_cap_obs_t *obs);
+
+/* Learned full-power rise at `temp_c` in °C/h, or 0 when that bin is not
+ * learned yet. */
+float kiln_cap_rate(const kiln_cap_t *cap, float temp_c);
+
+/* Seconds to ramp from `from_c` up to `to_c` at `rate_ch`, slowed wherever the
+ * learned curve scaled by `load` is slower. A NULL `cap` or unlearned bins
+ * take the programmed rate at face value. */
+float kiln_cap_ramp_s(const kiln_cap_t *cap, float load, float from_c, float to_c, float rate_ch);
+
+/* Element energy for the same ramp, as seconds at full power. Losses at a
+ * temperature are read off the curve: the fastest learned bin is taken as the
+ * kiln's rise with next to no losses, and what a hotter bin falls short of it
+ * is the rise its losses eat (equivalently, how fast the kiln cools unpowered
+ * there). A `rate_ch` climb then needs duty (loss + rate) / fastest, paced as
+ * in kiln_cap_ramp_s() at a typical load; a cool faster than the kiln loses
+ * heat costs nothing. A NULL `cap` and unlearned bins assume 50% duty. */
+float kiln_cap_ramp_on_s(const kiln_cap_t *cap, float from_c, float to_c, float rate_ch);
+
+/* Element energy, as seconds at full power, to soak `hold_s` at `temp_c`. */
+float kiln_cap_hold_on_s(const kiln_cap_t *cap, float temp_c, float hold_s);
+
+/* Lowest temperature in [from_c, to_c) at which a `rate_ch` ramp asks more
+ * than 10% over the learned curve, or NAN if it never does. `*slowest_ch`
+ * (may be NULL) gets the slowest learned rise from there to `to_c`. */
+float kiln_cap_shortfall(const kiln_cap_t *cap, float from_c, float to_c, float rate_ch, float *slowest_ch);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,82 @@
+#pragma once
+
+/**
+ * Profile optimizer: rewrites a firing profile as the fastest schedule that
+ * stays inside a set of limits — ramp ceilings over temperature zones (water
+ * smoke, quartz inversion), minimum soaks at given temperatures, an overall
+ * heating ceiling and the kiln's learned full-power curve (kiln_capability.h)
+ * — and predicts how long it takes and how much element time it needs.
+ *
+ * Each ramp is cut wherever a zone edge or a capability bin starts or ends,
+ * and each piece runs at the most its limits allow: the slowest zone covering
+ * it, and for heating also the learned curve and the overall ceiling. A cool
+ * slower than its zone stays at the programmed rate. A piece nothing limits
+ * keeps the programmed rate. Neighbouring pieces at the same
+ * rate are joined; if the result still has more than FIRING_MAX_SEGMENTS the
+ * two neighbours whose merge (at the slower rate) costs least are joined until
+ * it fits. Targets, end cones and indefinite holds are kept; a ramp that ends
+ * on a cone is not cut, only held to its slowest piece. A soak at a listed
+ * temperature is set to the listed minimum, others are kept.
+ *
+ * Predictions come from firing_remaining_s() and firing_planned_on_s() — the
+ * planning the engine's own ETA uses — at a typical load.
+ *
+ * Pure: no ESP-IDF dependencies, host-testable.
+ */
+
+#include "firing_types.h"
+#include "kiln_capability.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PROFILE_OPT_MAX_ZONES 8
+#define PROFILE_OPT_MAX_HOLDS 8
+
+typedef struct {
+    float from_c;
+    float to_c;
+    float max_rate_ch; /* |ramp| ceiling anywhere in [from_c, to_c], heating or cooling */
+} profile_opt_zone_t;
+
+typedef struct {
+    float temp_c;     /* applies to soaks whose target is within 1 °C */
+    uint16_t minutes; /* soak length there */
+} profile_opt_hold_t;
+
+typedef struct {
+    float start_temp_c; /* where the first ramp starts */
+    float max_rate_ch;  /* heating ceiling everywhere; 0 = none */
+    int zone_count;
+    profile_opt_zone_t zones[PROFILE_OPT_MAX_ZONES];
+    int hold_count;
+    profile_opt_hold_t holds[PROFILE_OPT_MAX_HOLDS];
+} profile_opt_limits_t;
+
+typedef struct {
+    uint32_t duration_s; /* indefinite holds count as 0 */
+    float on_s;          /* element-on time at full power; × element watts for energy */
+} profile_plan_t;
+
+/* Cold start, no overall ceiling, water smoke at most 80 °C/h up to 200 °C and
+ * quartz inversion at most 100 °C/h from 540 to 600 °C. */
+void profile_opt_default_limits(profile_opt_limits_t *out);
+
+/* Predict firing `profile` from `start_temp_c` against the curve `cap` (may be
+ * NULL). */
+void profile_plan(const firing_profile_t *profile, float start_temp_c, const kiln_cap_t *cap, profile_plan_t *out);
+
+/* Write the fastest schedule for `in` within `limits` to `out` (which must not
+ * alias `in`). Segments split from one original keep its name and id, the
+ * earlier pieces with a "-1", "-2" … suffix. out->estimated_duration is the
+ * new plan in minutes. Returns false for an empty profile. */
+bool profile_optimize(const firing_profile_t *in, const profile_opt_limits_t *limits, const kiln_cap_t *cap,
+                      firing_profile_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+
+/**
+ * Time-of-use scheduling: what a predicted firing (firing_sim.h) costs when it
+ * starts at a given time under the settings' tariff, and which start inside a
+ * window costs the least.
+ *
+ * The power curve is the simulation's: between two curve points the element
+ * time they differ by, × element watts, spread evenly over the interval and
+ * priced band by band where a tariff edge falls inside it. Times are Unix
+ * seconds; the tariff is in local time, `utc_offset_s` ahead of UTC.
+ *
+ * Pure: no ESP-IDF dependencies, host-testable.
+ */
+
+#include "firing_types.h"
+#include "firing_sim.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TARIFF_STEP_S    900u          /* starts tried: every local quarter hour */
+#define TARIFF_HORIZON_S (24u * 3600u) /* window without a finish-by: one full tariff day */
+
+typedef struct {
+    int64_t start_s;      /* cheapest start */
+    double cost;          /* of the firing started then */
+    double earliest_cost; /* of the firing started at the window's opening */
+} tariff_plan_t;
+
+/* Price per kWh `minute` minutes past local midnight. */
+float tariff_price_at(const kiln_settings_t *s, uint32_t minute);
+
+/* Cost of the firing `sim` predicts, started at `start_s`. */
+double tariff_run_cost(const kiln_settings_t *s, const firing_sim_result_t *sim, int64_t start_s,
+                       int32_t utc_offset_s);
+
+/* Cheapest start in [earliest_s, latest_s] (earliest_s not before now_s):
+ * the opening itself, then every local quarter hour after it, each moved to
+ * the next whole minute after `now_s` (a delayed start counts in minutes) and
+ * the last one kept inside the window. The start returned is the one priced.
+ * On a tie the sooner start wins, so a flat tariff starts at the opening.
+ * False, and `out` untouched, when no whole minute falls inside the window. */
+bool tariff_cheapest_start(const kiln_settings_t *s, const firing_sim_result_t *sim, int64_t now_s, int64_t earliest_s,
+                           int64_t latest_s, int32_t utc_offset_s, tariff_plan_t *out);
+
+#ifdef __cplusplus
+}
+#endif
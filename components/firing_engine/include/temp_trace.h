@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * Multi-resolution min/max trace of the kiln temperature during a firing, kept
+ * so the LCD chart can switch between the whole firing, the last hour and the
+ * last ten minutes without recomputing anything or reading history back from
+ * flash. Each zoom level is its own fixed array of TEMP_TRACE_POINTS buckets
+ * fed from every engine tick, so a zoom change is one copy of that array.
+ *
+ * - TEN_MIN and HOUR are rings of 2.5 s and 15 s buckets ending at the newest
+ *   sample.
+ * - FIRING starts at 15 s buckets from the firing's start and, when it runs
+ *   out of buckets, merges neighbours pairwise and doubles the bucket length,
+ *   so any firing length fits with the newest half never coarser than needed.
+ *
+ * Plain data structure with no locking and no ESP-IDF dependencies; the
+ * firing engine owns the live instance (firing_engine_get_trace()).
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TEMP_TRACE_POINTS 240
+#define TEMP_TRACE_NONE   INT16_MIN /* bucket with no samples */
+
+typedef enum {
+    TEMP_TRACE_ZOOM_FIRING = 0, /* whole firing */
+    TEMP_TRACE_ZOOM_HOUR,       /* last 60 minutes */
+    TEMP_TRACE_ZOOM_TEN_MIN,    /* last 10 minutes */
+    TEMP_TRACE_ZOOM_COUNT,
+} temp_trace_zoom_t;
+
+/* Coolest and hottest sample in a bucket, whole °C. */
+typedef struct {
+    int16_t lo;
+    int16_t hi;
+} temp_trace_point_t;
+
+typedef struct {
+    temp_trace_point_t pts[TEMP_TRACE_POINTS];
+    uint32_t bucket_ms;
+    int64_t newest; /* bucket index (t / bucket_ms) of the newest sample, -1 when empty */
+} temp_trace_level_t;
+
+typedef struct {
+    temp_trace_level_t level[TEMP_TRACE_ZOOM_COUNT];
+} temp_trace_t;
+
+/* One zoom level laid out for drawing, oldest bucket first. For FIRING,
+ * pts[0] starts at the beginning of the firing and `count` buckets are in use;
+ * for the rings all TEMP_TRACE_POINTS are returned and the last one holds the
+ * newest sample. */
+typedef struct {
+    temp_trace_point_t pts[TEMP_TRACE_POINTS];
+    uint32_t count;
+    uint32_t bucket_ms;
+} temp_trace_view_t;
+
+/* Empty every level. Call when a firing starts. */
+void temp_trace_reset(temp_trace_t *trace);
+
+/* Fold in one reading taken `t_ms` into the firing. Samples must arrive in
+ * non-decreasing time order; a gap longer than a bucket leaves empty buckets. */
+void temp_trace_add(temp_trace_t *trace, uint32_t t_ms, float temp_c);
+
+/* Copy one zoom level out for drawing. O(TEMP_TRACE_POINTS). */
+void temp_trace_copy(const temp_trace_t *trace, temp_trace_zoom_t zoom, temp_trace_view_t *out);
+
+#ifdef __cplusplus
+}
+#endif
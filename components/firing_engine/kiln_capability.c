@@ -0,0 +1,207 @@
+#include "kiln_capability.h"
+
+#include <math.h>
+#include <string.h>
+
+/* Firings averaged evenly before the curve switches to an exponential
+   average with weight 1/LEARN_SPAN, so old firings fade out over about as
+   many new ones. */
+#define LEARN_SPAN 4
+
+/* Curve-predicted rise a firing needs before its load figure means anything. */
+#define LOAD_MIN_EXPECT_C 30.0f
+#define LOAD_MIN          0.5f
+#define LOAD_MAX          1.5f
+
+/* A ramp asking less than this much over the curve is within its noise. */
+#define SHORTFALL_MARGIN 1.1f
+
+static int bin_of(float temp_c)
+{
+    if (!(temp_c > 0.0f)) {
+        return 0;
+    }
+    int b = (int)(temp_c / KILN_CAP_BIN_C);
+    return b < KILN_CAP_BINS ? b : KILN_CAP_BINS - 1;
+}
+
+/* Upper edge of `b`; the last bin runs on forever. */
+static float bin_top(int b)
+{
+    return b == KILN_CAP_BINS - 1 ? INFINITY : (float)((b + 1) * KILN_CAP_BIN_C);
+}
+
+void kiln_cap_obs_reset(kiln_cap_obs_t *obs)
+{
+    memset(obs, 0, sizeof(*obs));
+}
+
+void kiln_cap_observe(kiln_cap_obs_t *obs, const kiln_cap_t *cap, float temp_c, float rise_c, float dt_s,
+                      bool full_power)
+{
+    if (!(dt_s > 0.0f)) {
+        return;
+    }
+    int b = bin_of(temp_c);
+    if (!full_power) {
+        obs->kept_rise_c[b] += rise_c;
+        obs->kept_s[b] += dt_s;
+        return;
+    }
+    obs->full_rise_c[b] += rise_c;
+    obs->full_s[b] += dt_s;
+    if (cap && cap->rate_ch[b]) {
+        obs->load_rise_c += rise_c;
+        obs->load_expect_c += (float)cap->rate_ch[b] * dt_s / 3600.0f;
+    }
+}
+
+float kiln_cap_load(const kiln_cap_obs_t *obs)
+{
+    if (obs->load_expect_c < LOAD_MIN_EXPECT_C) {
+        return 1.0f;
+    }
+    float load = obs->load_rise_c / obs->load_expect_c;
+    return load < LOAD_MIN ? LOAD_MIN : load > LOAD_MAX ? LOAD_MAX : load;
+}
+
+static uint16_t to_rate(float rate_ch)
+{
+    return rate_ch < 1.0f ? 1 : rate_ch > UINT16_MAX ? UINT16_MAX : (uint16_t)lroundf(rate_ch);
+}
+
+bool kiln_cap_learn(kiln_cap_t *cap, const kiln_cap_obs_t *obs)
+{
+    bool changed = false;
+    for (int b = 0; b < KILN_CAP_BINS; b++) {
+        /* No rise at full power is a lid left open or a dead element, not
+           the kiln's capability — don't teach it. */
+        if (obs->full_s[b] >= KILN_CAP_MIN_OBS_S && obs->full_rise_c[b] > 0.0f) {
+            float seen = obs->full_rise_c[b] / obs->full_s[b] * 3600.0f;
+            float rate = cap->rate_ch[b];
+            int n = cap->firings[b];
+            cap->rate_ch[b] = to_rate(n == 0 ? seen : rate + (seen - rate) / (n < LEARN_SPAN ? n + 1 : LEARN_SPAN));
+            if (n < UINT8_MAX) {
+                cap->firings[b]++;
+            }
+            changed = true;
+        }
+        /* Keeping up at part power only bounds the capability from below, so
+           it can raise a learned bin (new elements) but not create one. */
+        if (cap->rate_ch[b] && obs->kept_s[b] >= KILN_CAP_MIN_OBS_S) {
+            float kept = obs->kept_rise_c[b] / obs->kept_s[b] * 3600.0f;
+            if (kept > cap->rate_ch[b]) {
+                cap->rate_ch[b] = to_rate(kept);
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+float kiln_cap_rate(const kiln_cap_t *cap, float temp_c)
+{
+    return cap->rate_ch[bin_of(temp_c)];
+}
+
+float kiln_cap_ramp_s(const kiln_cap_t *cap, float load, float from_c, float to_c, float rate_ch)
+{
+    if (!cap || !(rate_ch > 0.0f) || !(to_c > from_c)) {
+        return fabsf((to_c - from_c) / rate_ch) * 3600.0f;
+    }
+    /* Degrees the program sets the pace for, summed and divided once; only
+       the bins the kiln is slower in cost a division each. */
+    float paced_c = 0.0f;
+    float slow_s = 0.0f;
+    float lo = from_c;
+    for (int b = bin_of(from_c);; b++) {
+        float hi = fminf(bin_top(b), to_c);
+        float most = (float)cap->rate_ch[b] * load;
+        if (cap->rate_ch[b] && most < rate_ch) {
+            slow_s += (hi - lo) / most * 3600.0f;
+        } else {
+            paced_c += hi - lo;
+        }
+        if (hi >= to_c) {
+            break;
+        }
+        lo = hi;
+    }
+    return slow_s + paced_c / rate_ch * 3600.0f;
+}
+
+float kiln_cap_shortfall(const kiln_cap_t *cap, float from_c, float to_c, float rate_ch, float *slowest_ch)
+{
+    float first = NAN;
+    float slowest = INFINITY;
+    for (float lo = from_c; lo < to_c;) {
+        int b = bin_of(lo);
+        float learned = cap->rate_ch[b];
+        if (learned && rate_ch > learned * SHORTFALL_MARGIN && isnan(first)) {
+            first = lo;
+        }
+        if (learned && !isnan(first) && learned < slowest) {
+            slowest = learned;
+        }
+        lo = fminf(bin_top(b), to_c);
+    }
+    if (slowest_ch && !isnan(first)) {
+        *slowest_ch = slowest;
+    }
+    return first;
+}
+
+/* Duty assumed where the curve has nothing to say — the same guess the cost
+   estimate in the settings page makes. */
+#define UNKNOWN_DUTY 0.5f
+
+/* Fastest learned bin, or 0 with nothing learned. */
+static float lossless_rate(const kiln_cap_t *cap)
+{
+    float fastest = 0.0f;
+    for (int b = 0; b < KILN_CAP_BINS; b++) {
+        fastest = fmaxf(fastest, cap->rate_ch[b]);
+    }
+    return fastest;
+}
+
+/* Duty holding `rate_ch` (negative cooling) in bin `b`. */
+static float duty_in(const kiln_cap_t *cap, float fastest, int b, float rate_ch)
+{
+    if (!cap || !cap->rate_ch[b]) {
+        return UNKNOWN_DUTY;
+    }
+    float duty = (fastest - cap->rate_ch[b] + rate_ch) / fastest;
+    return duty < 0.0f ? 0.0f : duty > 1.0f ? 1.0f : duty;
+}
+
+float kiln_cap_ramp_on_s(const kiln_cap_t *cap, float from_c, float to_c, float rate_ch)
+{
+    if (!(fabsf(rate_ch) > 0.0f) || from_c == to_c) {
+        return 0.0f;
+    }
+    bool heating = to_c > from_c;
+    float fastest = cap ? lossless_rate(cap) : 0.0f;
+    float on_s = 0.0f;
+    float lo = fminf(from_c, to_c);
+    float top = fmaxf(from_c, to_c);
+    for (int b = bin_of(lo);; b++) {
+        float hi = fminf(bin_top(b), top);
+        float pace = fabsf(rate_ch);
+        if (heating && cap && cap->rate_ch[b] && cap->rate_ch[b] < pace) {
+            pace = cap->rate_ch[b];
+        }
+        on_s += (hi - lo) / pace * 3600.0f * duty_in(cap, fastest, b, heating ? pace : -pace);
+        if (hi >= top) {
+            break;
+        }
+        lo = hi;
+    }
+    return on_s;
+}
+
+float kiln_cap_hold_on_s(const kiln_cap_t *cap, float temp_c, float hold_s)
+{
+    float fastest = cap ? lossless_rate(cap) : 0.0f;
+    return hold_s * duty_in(cap, fastest, bin_of(temp_c), 0.0f);
+}
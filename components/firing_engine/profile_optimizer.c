@@ -0,0 +1,220 @@
+#include "profile_optimizer.h"
+#include "firing_engine_internal.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* A move this small is no ramp at all (compute_dynamic_setpoint's tolerance). */
+#define FLAT_EPS_C 0.5f
+
+/* How close a soak's temperature must be to a listed minimum for it to apply. */
+#define HOLD_MATCH_C 1.0f
+
+/* Pieces in flight while cutting ramps; a full table merges before it grows. */
+#define MAX_PIECES 48
+
+/* One stretch of a ramp at a single rate. */
+typedef struct {
+    float from_c;
+    float to_c;
+    float rate_ch; /* magnitude; the sign comes from the original segment */
+    uint8_t src;   /* original segment index */
+} piece_t;
+
+void profile_opt_default_limits(profile_opt_limits_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->start_temp_c = 20.0f;
+    out->zones[out->zone_count++] = (profile_opt_zone_t){.from_c = 0.0f, .to_c = 200.0f, .max_rate_ch = 80.0f};
+    out->zones[out->zone_count++] = (profile_opt_zone_t){.from_c = 540.0f, .to_c = 600.0f, .max_rate_ch = 100.0f};
+}
+
+void profile_plan(const firing_profile_t *profile, float start_temp_c, const kiln_cap_t *cap, profile_plan_t *out)
+{
+    out->duration_s = firing_remaining_s(profile, 0, start_temp_c, false, 0.0f, cap, 1.0f);
+    out->on_s = firing_planned_on_s(profile, start_temp_c, cap);
+}
+
+/* Nearest point beyond `t` in direction `dir` (±1) where a piece must end: a
+   zone edge, or with `bins` (heating only) a capability bin edge. ±INFINITY
+   if none. */
+static float next_cut(const profile_opt_limits_t *lim, bool bins, float t, float dir)
+{
+    float best = dir * INFINITY;
+    for (int z = 0; z < lim->zone_count; z++) {
+        const float edges[2] = {lim->zones[z].from_c, lim->zones[z].to_c};
+        for (int e = 0; e < 2; e++) {
+            if ((edges[e] - t) * dir > 0.0f && (edges[e] - best) * dir < 0.0f) {
+                best = edges[e];
+            }
+        }
+    }
+    if (bins) {
+        float edge = (floorf(t / KILN_CAP_BIN_C) + 1.0f) * KILN_CAP_BIN_C;
+        best = fminf(best, edge);
+    }
+    return best;
+}
+
+/* Fastest rate allowed over [lo, hi], which lies inside a single zone/bin
+   cell; `programmed` when nothing limits it. A cool is only ever slowed: the
+   learned curve says nothing about how fast the kiln may cool. */
+static float piece_rate(const profile_opt_limits_t *lim, const kiln_cap_t *cap, float lo, float hi, bool heating,
+                        float programmed)
+{
+    float rate = INFINITY;
+    for (int z = 0; z < lim->zone_count; z++) {
+        if (lim->zones[z].from_c < hi && lim->zones[z].to_c > lo) {
+            rate = fminf(rate, lim->zones[z].max_rate_ch);
+        }
+    }
+    if (heating) {
+        float learned = cap ? kiln_cap_rate(cap, 0.5f * (lo + hi)) : 0.0f;
+        if (learned > 0.0f) {
+            rate = fminf(rate, learned);
+        }
+        if (lim->max_rate_ch > 0.0f) {
+            rate = fminf(rate, lim->max_rate_ch);
+        }
+    }
+    if (isinf(rate)) {
+        return programmed;
+    }
+    rate = fmaxf(floorf(rate), 1.0f);
+    return heating ? rate : fminf(rate, programmed);
+}
+
+/* Hours joining pieces k and k+1 at the slower of their rates adds; INFINITY
+   across a segment boundary, where the soak and target must stay. */
+static float merge_cost(const piece_t *p, int k)
+{
+    if (p[k].src != p[k + 1].src) {
+        return INFINITY;
+    }
+    float a = fabsf(p[k].to_c - p[k].from_c);
+    float b = fabsf(p[k + 1].to_c - p[k + 1].from_c);
+    float m = fminf(p[k].rate_ch, p[k + 1].rate_ch);
+    return (a + b) / m - a / p[k].rate_ch - b / p[k + 1].rate_ch;
+}
+
+static bool merge_cheapest(piece_t *p, int *count)
+{
+    int best = -1;
+    float best_cost = INFINITY;
+    for (int k = 0; k + 1 < *count; k++) {
+        float cost = merge_cost(p, k);
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = k;
+        }
+    }
+    if (best < 0) {
+        return false;
+    }
+    p[best].to_c = p[best + 1].to_c;
+    p[best].rate_ch = fminf(p[best].rate_ch, p[best + 1].rate_ch);
+    memmove(&p[best + 1], &p[best + 2], (size_t)(*count - best - 2) * sizeof(*p));
+    (*count)--;
+    return true;
+}
+
+static void add_piece(piece_t *p, int *count, piece_t next)
+{
+    piece_t *last = *count ? &p[*count - 1] : NULL;
+    if (last && last->src == next.src && last->rate_ch == next.rate_ch) {
+        last->to_c = next.to_c;
+        return;
+    }
+    /* Never stuck: the table holds more pieces than there are segments, so
+       two of them always share one. */
+    if (*count == MAX_PIECES) {
+        merge_cheapest(p, count);
+    }
+    p[(*count)++] = next;
+}
+
+static uint16_t soak_minutes(const profile_opt_limits_t *lim, const firing_segment_t *seg)
+{
+    if (seg->hold_time == FIRING_HOLD_INDEFINITE) {
+        return seg->hold_time;
+    }
+    for (int h = 0; h < lim->hold_count; h++) {
+        if (fabsf(lim->holds[h].temp_c - seg->target_temp) <= HOLD_MATCH_C) {
+            return lim->holds[h].minutes;
+        }
+    }
+    return seg->hold_time;
+}
+
+bool profile_optimize(const firing_profile_t *in, const profile_opt_limits_t *limits, const kiln_cap_t *cap,
+                      firing_profile_t *out)
+{
+    if (!in || in->segment_count == 0 || in->segment_count > FIRING_MAX_SEGMENTS) {
+        return false;
+    }
+    piece_t pieces[MAX_PIECES];
+    int count = 0;
+    float start = limits->start_temp_c;
+    for (int i = 0; i < in->segment_count; i++) {
+        const firing_segment_t *seg = &in->segments[i];
+        float target = seg->target_temp;
+        piece_t whole = {.from_c = start, .to_c = target, .rate_ch = fabsf(seg->ramp_rate), .src = (uint8_t)i};
+        if (fabsf(target - start) <= FLAT_EPS_C) {
+            add_piece(pieces, &count, whole);
+            start = target;
+            continue;
+        }
+        float dir = target > start ? 1.0f : -1.0f;
+        bool heating = dir > 0.0f;
+        /* A ramp that ends on a cone can stop anywhere along it, so it stays
+           one segment and runs at its slowest piece. */
+        bool keep_whole = seg->end_cone != 0;
+        float slowest = INFINITY;
+        for (float a = start; (target - a) * dir > 0.0f;) {
+            float b = next_cut(limits, heating && cap, a, dir);
+            if ((b - target) * dir > 0.0f) {
+                b = target;
+            }
+            float rate = piece_rate(limits, cap, fminf(a, b), fmaxf(a, b), heating, whole.rate_ch);
+            if (keep_whole) {
+                slowest = fminf(slowest, rate);
+            } else {
+                add_piece(pieces, &count, (piece_t){.from_c = a, .to_c = b, .rate_ch = rate, .src = (uint8_t)i});
+            }
+            a = b;
+        }
+        if (keep_whole) {
+            whole.rate_ch = slowest;
+            add_piece(pieces, &count, whole);
+        }
+        start = target;
+    }
+    while (count > FIRING_MAX_SEGMENTS && merge_cheapest(pieces, &count)) {
+    }
+
+    *out = *in;
+    memset(out->segments, 0, sizeof(out->segments));
+    out->segment_count = (uint8_t)count;
+    uint8_t part = 0; /* pieces so far of the current original segment */
+    for (int k = 0; k < count; k++) {
+        const piece_t *p = &pieces[k];
+        const firing_segment_t *orig = &in->segments[p->src];
+        firing_segment_t *seg = &out->segments[k];
+        *seg = *orig;
+        seg->target_temp = p->to_c;
+        seg->ramp_rate = copysignf(p->rate_ch, orig->ramp_rate);
+        if (k + 1 < count && pieces[k + 1].src == p->src) {
+            seg->hold_time = 0;
+            snprintf(seg->id, sizeof(seg->id), "%.*s-%u", FIRING_ID_LEN - 5, orig->id, ++part);
+        } else {
+            seg->hold_time = soak_minutes(limits, orig);
+            part = 0;
+        }
+    }
+
+    profile_plan_t plan;
+    profile_plan(out, limits->start_temp_c, cap, &plan);
+    out->estimated_duration = (plan.duration_s + 30) / 60;
+    return true;
+}
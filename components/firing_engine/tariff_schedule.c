@@ -0,0 +1,123 @@
+#include "tariff_schedule.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define DAY_S 86400
+
+/* Two starts closer in cost than this are a tie: splitting intervals at band
+   edges in a different place must not buy a later start a rounding error. */
+#define COST_EPS 1e-6
+
+/* Seconds into the local day, whatever the sign of `local_s`. */
+static int32_t sec_of_day(int64_t local_s)
+{
+    int64_t r = local_s % DAY_S;
+    return (int32_t)(r < 0 ? r + DAY_S : r);
+}
+
+float tariff_price_at(const kiln_settings_t *s, uint32_t minute)
+{
+    if (s->tariff_count == 0) {
+        return s->electricity_cost_kwh;
+    }
+    /* The latest band to have started by `minute`; before the day's first,
+       the last one, still running from the evening before. */
+    const tariff_band_t *band = NULL;
+    const tariff_band_t *last = &s->tariff[0];
+    for (int i = 0; i < s->tariff_count; i++) {
+        const tariff_band_t *b = &s->tariff[i];
+        if (b->start_min <= minute && (!band || b->start_min > band->start_min)) {
+            band = b;
+        }
+        if (b->start_min > last->start_min) {
+            last = b;
+        }
+    }
+    return band ? band->cost_kwh : last->cost_kwh;
+}
+
+/* Seconds from `sod` to the next band edge after it; a day with no bands. */
+static int32_t to_next_edge(const kiln_settings_t *s, int32_t sod)
+{
+    int32_t best = DAY_S;
+    for (int i = 0; i < s->tariff_count; i++) {
+        int32_t d = (int32_t)s->tariff[i].start_min * 60 - sod;
+        if (d <= 0) {
+            d += DAY_S;
+        }
+        if (d < best) {
+            best = d;
+        }
+    }
+    return best;
+}
+
+double tariff_run_cost(const kiln_settings_t *s, const firing_sim_result_t *sim, int64_t start_s,
+                       int32_t utc_offset_s)
+{
+    double cost = 0.0;
+    for (int i = 0; i + 1 < sim->point_count; i++) {
+        const firing_sim_point_t *a = &sim->points[i];
+        const firing_sim_point_t *b = &sim->points[i + 1];
+        uint32_t span = b->t_s - a->t_s;
+        if (span == 0) {
+            continue;
+        }
+        double kwh_per_s = (double)(b->on_s - a->on_s) * s->element_watts / 3600000.0 / span;
+        int64_t t = start_s + utc_offset_s + a->t_s;
+        int64_t end = t + span;
+        while (t < end) {
+            int32_t sod = sec_of_day(t);
+            int64_t next = t + to_next_edge(s, sod);
+            if (next > end) {
+                next = end;
+            }
+            cost += kwh_per_s * (double)(next - t) * tariff_price_at(s, (uint32_t)sod / 60u);
+            t = next;
+        }
+    }
+    return cost;
+}
+
+/* The first start at or after `t` on the whole-minute grid from `now_s`. */
+static int64_t on_minute_grid(int64_t now_s, int64_t t)
+{
+    return now_s + (t - now_s + 59) / 60 * 60;
+}
+
+bool tariff_cheapest_start(const kiln_settings_t *s, const firing_sim_result_t *sim, int64_t now_s, int64_t earliest_s,
+                           int64_t latest_s, int32_t utc_offset_s, tariff_plan_t *out)
+{
+    int64_t first = on_minute_grid(now_s, earliest_s);
+    if (latest_s < first) {
+        return false;
+    }
+    out->start_s = first;
+    out->cost = tariff_run_cost(s, sim, first, utc_offset_s);
+    out->earliest_cost = out->cost;
+
+    /* The first local quarter hour after the opening, then every one after,
+       each taken at the next whole minute so a band edge is not missed. One
+       that lands past the window is pulled back to its last whole minute. */
+    int64_t into = (earliest_s + utc_offset_s) % TARIFF_STEP_S;
+    if (into < 0) {
+        into += TARIFF_STEP_S;
+    }
+    int64_t last = latest_s - (latest_s - now_s) % 60;
+    for (int64_t q = earliest_s + TARIFF_STEP_S - into; q - TARIFF_STEP_S < last; q += TARIFF_STEP_S) {
+        int64_t t = on_minute_grid(now_s, q);
+        if (t > last) {
+            t = last;
+        }
+        if (t <= first) {
+            continue;
+        }
+        double cost = tariff_run_cost(s, sim, t, utc_offset_s);
+        if (cost < out->cost - COST_EPS) {
+            out->start_s = t;
+            out->cost = cost;
+        }
+    }
+    return true;
+}
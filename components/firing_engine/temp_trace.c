@@ -0,0 +1,132 @@
+#include "temp_trace.h"
+
+#include <string.h>
+
+#define N TEMP_TRACE_POINTS
+
+static const uint32_t s_base_bucket_ms[TEMP_TRACE_ZOOM_COUNT] = {
+    [TEMP_TRACE_ZOOM_FIRING] = 15000,  /* first hour at the HOUR resolution, then coarsens */
+    [TEMP_TRACE_ZOOM_HOUR] = 15000,    /* 240 × 15 s = 60 min */
+    [TEMP_TRACE_ZOOM_TEN_MIN] = 2500,  /* 240 × 2.5 s = 10 min */
+};
+
+static int16_t to_deg(float temp_c)
+{
+    float r = temp_c + (temp_c >= 0.0f ? 0.5f : -0.5f);
+    if (r > (float)INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (r < (float)(INT16_MIN + 1)) {
+        return INT16_MIN + 1;
+    }
+    return (int16_t)r;
+}
+
+static temp_trace_point_t merge(temp_trace_point_t a, temp_trace_point_t b)
+{
+    if (a.lo == TEMP_TRACE_NONE) {
+        return b;
+    }
+    if (b.lo == TEMP_TRACE_NONE) {
+        return a;
+    }
+    temp_trace_point_t m = {
+        .lo = a.lo < b.lo ? a.lo : b.lo,
+        .hi = a.hi > b.hi ? a.hi : b.hi,
+    };
+    return m;
+}
+
+static void clear_points(temp_trace_point_t *pts, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        pts[i].lo = TEMP_TRACE_NONE;
+        pts[i].hi = TEMP_TRACE_NONE;
+    }
+}
+
+void temp_trace_reset(temp_trace_t *trace)
+{
+    for (int z = 0; z < TEMP_TRACE_ZOOM_COUNT; z++) {
+        temp_trace_level_t *lv = &trace->level[z];
+        clear_points(lv->pts, N);
+        lv->bucket_ms = s_base_bucket_ms[z];
+        lv->newest = -1;
+    }
+}
+
+/* Halve the resolution: bucket i becomes buckets 2i and 2i+1 merged. */
+static void coarsen(temp_trace_level_t *lv)
+{
+    for (uint32_t i = 0; i < N / 2; i++) {
+        lv->pts[i] = merge(lv->pts[2 * i], lv->pts[2 * i + 1]);
+    }
+    clear_points(&lv->pts[N / 2], N - N / 2);
+    lv->bucket_ms *= 2;
+    lv->newest /= 2;
+}
+
+static void add_firing(temp_trace_level_t *lv, uint32_t t_ms, temp_trace_point_t p)
+{
+    int64_t b = t_ms / lv->bucket_ms;
+    while (b >= N) {
+        coarsen(lv);
+        b = t_ms / lv->bucket_ms;
+    }
+    if (b < lv->newest) {
+        b = lv->newest; /* out of order: fold into the newest bucket */
+    }
+    /* Buckets past `newest` are still empty, so skipped ones stay NONE. */
+    lv->pts[b] = merge(lv->pts[b], p);
+    lv->newest = b;
+}
+
+static void add_ring(temp_trace_level_t *lv, uint32_t t_ms, temp_trace_point_t p)
+{
+    int64_t b = t_ms / lv->bucket_ms;
+    if (lv->newest >= 0 && b <= lv->newest) {
+        temp_trace_point_t *slot = &lv->pts[lv->newest % N];
+        *slot = merge(*slot, p);
+        return;
+    }
+    if (lv->newest >= 0) {
+        /* Buckets the ring is about to reuse hold data from a full lap ago. */
+        if (b - lv->newest > N) {
+            clear_points(lv->pts, N);
+        } else {
+            for (int64_t k = lv->newest + 1; k < b; k++) {
+                clear_points(&lv->pts[k % N], 1);
+            }
+        }
+    }
+    lv->pts[b % N] = p;
+    lv->newest = b;
+}
+
+void temp_trace_add(temp_trace_t *trace, uint32_t t_ms, float temp_c)
+{
+    int16_t v = to_deg(temp_c);
+    temp_trace_point_t p = {.lo = v, .hi = v};
+    add_firing(&trace->level[TEMP_TRACE_ZOOM_FIRING], t_ms, p);
+    add_ring(&trace->level[TEMP_TRACE_ZOOM_HOUR], t_ms, p);
+    add_ring(&trace->level[TEMP_TRACE_ZOOM_TEN_MIN], t_ms, p);
+}
+
+void temp_trace_copy(const temp_trace_t *trace, temp_trace_zoom_t zoom, temp_trace_view_t *out)
+{
+    const temp_trace_level_t *lv = &trace->level[zoom];
+    out->bucket_ms = lv->bucket_ms;
+
+    if (zoom == TEMP_TRACE_ZOOM_FIRING) {
+        out->count = (uint32_t)(lv->newest + 1);
+        memcpy(out->pts, lv->pts, sizeof(out->pts));
+        return;
+    }
+
+    /* Rotate the ring so the newest bucket lands in the last slot. Before the
+     * first lap the leading slots were never written and read as NONE. */
+    out->count = N;
+    uint32_t head = lv->newest < 0 ? 0 : (uint32_t)((lv->newest + 1) % N);
+    memcpy(out->pts, &lv->pts[head], (N - head) * sizeof(out->pts[0]));
+    memcpy(&out->pts[N - head], lv->pts, head * sizeof(out->pts[0]));
+}
@@ -1,4 +1,6 @@
 #include "firing_history.h"
+#include "app_config.h"
+#include "mem_budget.h"
 #include "esp_log.h"
 #include "esp_spiffs.h"
 #include "cJSON.h"
@@ -15,13 +17,18 @@ static const char *TAG = "history";
 #define HISTORY_JSON_PATH "/www/history.json"
 #define TRACE_PATH_FMT    "/www/trc_%" PRIu32 ".csv"
 #define TRACE_PATH_LEN    32
+#define EVENTS_PATH_FMT   "/www/evt_%" PRIu32 ".bin"
+#define EVENTS_MAGIC      "BEV1"
+#define EVENTS_MAGIC_LEN  4
 
 /* Active firing session */
 static bool s_recording = false;
 static history_record_t s_current;
 static FILE *s_trace_file = NULL;
-static uint32_t s_trace_sample_count = 0;
+static FILE *s_events_file = NULL;
+static uint32_t s_event_count = 0;
 static SemaphoreHandle_t s_mutex = NULL;
+static MEM_PLACE(APP_MEM_KERNEL_OBJECTS) StaticSemaphore_t s_mutex_buf;
 
 /* Monotonic ID counter, loaded from history on init */
 static uint32_t s_next_id = 1;
@@ -46,6 +53,20 @@ static void make_trace_path(uint32_t id, char *buf, size_t size)
     snprintf(buf, size, TRACE_PATH_FMT, id);
 }
 
+static void make_events_path(uint32_t id, char *buf, size_t size)
+{
+    snprintf(buf, size, EVENTS_PATH_FMT, id);
+}
+
+static void remove_record_files(uint32_t id)
+{
+    char path[TRACE_PATH_LEN];
+    make_trace_path(id, path, sizeof(path));
+    remove(path);
+    make_events_path(id, path, sizeof(path));
+    remove(path);
+}
+
 static esp_err_t load_records_from_json(history_record_t *records, int max_count, int *out_count)
 {
     *out_count = 0;
@@ -156,12 +177,12 @@ static esp_err_t save_records_to_json(const history_record_t *records, int count
 
     FILE *f = fopen(HISTORY_JSON_PATH, "w");
     if (!f) {
-        free(json);
+        cJSON_free(json);
         return ESP_FAIL;
     }
     fputs(json, f);
     fclose(f);
-    free(json);
+    cJSON_free(json);
     return ESP_OK;
 }
 
@@ -183,10 +204,11 @@ const char *history_outcome_to_string(history_outcome_t outcome)
 
 esp_err_t history_init(void)
 {
-    s_mutex = xSemaphoreCreateMutex();
+    s_mutex = xSemaphoreCreateMutexStatic(&s_mutex_buf);
     if (!s_mutex) {
         return ESP_ERR_NO_MEM;
     }
+    mem_budget_add("history", "mutex", APP_MEM_KERNEL_OBJECTS, sizeof(s_mutex_buf));
 
     /* Load existing records to determine next ID */
     history_record_t tmp[HISTORY_MAX_RECORDS];
@@ -220,21 +242,26 @@ void history_firing_start(const char *profile_id, const char *profile_name)
     if (s_trace_file) {
         fputs("time_s,temp_c\n", s_trace_file);
     }
-    s_trace_sample_count = 0;
+
+    /* Open event journal */
+    make_events_path(s_current.id, trace_path, sizeof(trace_path));
+    s_events_file = fopen(trace_path, "wb");
+    if (s_events_file) {
+        fwrite(EVENTS_MAGIC, 1, EVENTS_MAGIC_LEN, s_events_file);
+        fflush(s_events_file);
+    }
+    s_event_count = 0;
     s_recording = true;
     unlock();
     ESP_LOGI(TAG, "Firing started: id=%u, profile=%s", s_current.id, profile_name ? profile_name : "?");
 }
 
-void history_record_temp(float temp_c)
+void history_record_temp(uint32_t t_s, float temp_c)
 {
     lock();
     if (s_recording && s_trace_file) {
-        fprintf(s_trace_file, "%" PRIu32 ",%.1f\n",
-                s_trace_sample_count * 60, /* time in seconds (1 sample per minute) */
-                temp_c);
+        fprintf(s_trace_file, "%" PRIu32 ",%.1f\n", t_s, temp_c);
         fflush(s_trace_file);
-        s_trace_sample_count++;
 
         if (temp_c > s_current.peak_temp_c) {
             s_current.peak_temp_c = temp_c;
@@ -243,6 +270,44 @@ void history_record_temp(float temp_c)
     unlock();
 }
 
+void history_event_encode(const history_event_t *evt, uint8_t *buf)
+{
+    float t = evt->temp_c + (evt->temp_c < 0 ? -0.5f : 0.5f);
+    int16_t temp = t > INT16_MAX ? INT16_MAX : t < INT16_MIN ? INT16_MIN : (int16_t)t;
+    buf[0] = (uint8_t)evt->t_s;
+    buf[1] = (uint8_t)(evt->t_s >> 8);
+    buf[2] = (uint8_t)(evt->t_s >> 16);
+    buf[3] = (uint8_t)(evt->t_s >> 24);
+    buf[4] = (uint8_t)((evt->kind & 0x1F) | (evt->source << 5));
+    buf[5] = evt->arg;
+    buf[6] = (uint8_t)(uint16_t)temp;
+    buf[7] = (uint8_t)((uint16_t)temp >> 8);
+}
+
+void history_event_decode(const uint8_t *buf, history_event_t *out)
+{
+    out->t_s = (uint32_t)buf[0] | (uint32_t)buf[1] << 8 | (uint32_t)buf[2] << 16 | (uint32_t)buf[3] << 24;
+    out->kind = (history_event_kind_t)(buf[4] & 0x1F);
+    out->source = buf[4] >> 5;
+    out->arg = buf[5];
+    out->temp_c = (float)(int16_t)(uint16_t)(buf[6] | buf[7] << 8);
+}
+
+void history_log_event(const history_event_t *evt)
+{
+    lock();
+    if (s_recording && s_events_file && s_event_count < HISTORY_MAX_EVENTS) {
+        uint8_t buf[HISTORY_EVENT_SIZE];
+        history_event_encode(evt, buf);
+        fwrite(buf, 1, sizeof(buf), s_events_file);
+        fflush(s_events_file);
+        if (++s_event_count == HISTORY_MAX_EVENTS) {
+            ESP_LOGW(TAG, "Event journal full (%d events); dropping the rest", HISTORY_MAX_EVENTS);
+        }
+    }
+    unlock();
+}
+
 void history_firing_end(history_outcome_t outcome, float peak_temp, uint32_t duration_s, int error_code)
 {
     lock();
@@ -260,19 +325,21 @@ void history_firing_end(history_outcome_t outcome, float peak_temp, uint32_t dur
         fclose(s_trace_file);
         s_trace_file = NULL;
     }
+    if (s_events_file) {
+        fclose(s_events_file);
+        s_events_file = NULL;
+    }
     s_recording = false;
 
     /* Load all existing records, then prepend the new one. If already at the
        cap, the oldest record (last in the list) is evicted by the prepend —
-       delete its trace file first so it doesn't orphan in SPIFFS. */
+       delete its trace and journal first so they don't orphan in SPIFFS. */
     history_record_t records[HISTORY_MAX_RECORDS];
     int count = 0;
     load_records_from_json(records, HISTORY_MAX_RECORDS, &count);
 
     if (count == HISTORY_MAX_RECORDS) {
-        char old_trace[TRACE_PATH_LEN];
-        make_trace_path(records[count - 1].id, old_trace, sizeof(old_trace));
-        remove(old_trace);
+        remove_record_files(records[count - 1].id);
         count--; /* drop the slot the prepend will reclaim */
     }
 
@@ -304,6 +371,29 @@ FILE *history_open_trace(uint32_t record_id)
     return fopen(trace_path, "r");
 }
 
+FILE *history_open_events(uint32_t record_id)
+{
+    char path[TRACE_PATH_LEN];
+    make_events_path(record_id, path, sizeof(path));
+    FILE *f = fopen(path, "rb");
+    char magic[EVENTS_MAGIC_LEN];
+    if (f && (fread(magic, 1, sizeof(magic), f) != sizeof(magic) || memcmp(magic, EVENTS_MAGIC, sizeof(magic)))) {
+        fclose(f);
+        f = NULL;
+    }
+    return f;
+}
+
+bool history_read_event(FILE *f, history_event_t *out)
+{
+    uint8_t buf[HISTORY_EVENT_SIZE];
+    if (fread(buf, 1, sizeof(buf), f) != sizeof(buf)) {
+        return false;
+    }
+    history_event_decode(buf, out);
+    return true;
+}
+
 void history_clear(void)
 {
     lock();
@@ -311,9 +401,7 @@ void history_clear(void)
     int count = 0;
     load_records_from_json(records, HISTORY_MAX_RECORDS, &count);
     for (int i = 0; i < count; i++) {
-        char trace_path[TRACE_PATH_LEN];
-        make_trace_path(records[i].id, trace_path, sizeof(trace_path));
-        remove(trace_path);
+        remove_record_files(records[i].id);
     }
     remove(HISTORY_JSON_PATH);
     unlock();
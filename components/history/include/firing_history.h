@@ -11,6 +11,8 @@ extern "C" {
 
 #define HISTORY_MAX_RECORDS      20
 #define HISTORY_PROFILE_NAME_LEN 48
+#define HISTORY_MAX_EVENTS       512 /* per firing; later events are dropped */
+#define HISTORY_EVENT_SIZE       8   /* bytes per journal record */
 
 typedef enum {
     HISTORY_OUTCOME_COMPLETE = 0,
@@ -29,6 +31,38 @@ typedef struct {
     int error_code; /* Error code if outcome == ERROR */
 } history_record_t;
 
+/* What a journal event records. */
+typedef enum {
+    HISTORY_EVT_SEGMENT = 0, /* segment `arg` began its ramp (a skip if `source` isn't the engine) */
+    HISTORY_EVT_HOLD,        /* segment `arg` reached its target and began its hold */
+    HISTORY_EVT_PAUSE,
+    HISTORY_EVT_RESUME,
+    HISTORY_EVT_TC_FAULT, /* the thermocouple started faulting; `arg` is the TC_FAULT_* bits */
+    HISTORY_EVT_TC_OK,    /* ... and read cleanly again */
+    HISTORY_EVT_TRIP,     /* the firing was stopped by a safety trip; `arg` is the firing_error_code_t */
+    HISTORY_EVT_SETTINGS, /* settings were changed mid-firing; `arg` is HISTORY_SETTING_* bits */
+    HISTORY_EVT_STOP,     /* the firing was stopped by a command */
+    HISTORY_EVT_CONE,     /* the firing's heat work reached cone `arg` (cone_id_t) */
+    HISTORY_EVT_COUNT,
+} history_event_kind_t;
+
+/* HISTORY_EVT_SETTINGS `arg` bits. */
+#define HISTORY_SETTING_MAX_TEMP  0x01
+#define HISTORY_SETTING_TC_OFFSET 0x02
+#define HISTORY_SETTING_OTHER     0x04
+
+/**
+ * One entry of a firing's event journal. Stored as HISTORY_EVENT_SIZE bytes,
+ * little-endian: u32 time, u8 kind | source << 5, u8 arg, i16 whole °C.
+ */
+typedef struct {
+    uint32_t t_s; /* firing time, on the same axis as the trace's time_s */
+    history_event_kind_t kind;
+    uint8_t source; /* firing_cmd_source_t */
+    uint8_t arg;
+    float temp_c; /* kiln temperature at the event (stored to the whole degree) */
+} history_event_t;
+
 /**
  * Initialize history subsystem. Creates storage directory on SPIFFS if needed.
  * Must be called after SPIFFS is mounted.
@@ -44,9 +78,17 @@ void history_firing_start(const char *profile_id, const char *profile_name);
 
 /**
  * Record a temperature sample for the current firing (call every minute from firing_task).
+ * @param t_s    Firing time in seconds (pauses excluded), written as the trace's time_s.
  * @param temp_c Current temperature in °C.
  */
-void history_record_temp(float temp_c);
+void history_record_temp(uint32_t t_s, float temp_c);
+
+/**
+ * Append an event to the current firing's journal. No-op outside a firing.
+ * Flushed as it is written, so the journal of a firing cut short by a reset
+ * is kept up to its last event.
+ */
+void history_log_event(const history_event_t *evt);
 
 /**
  * Called when a firing completes (or errors/aborts). Saves the record.
@@ -74,7 +116,24 @@ int history_get_records(history_record_t *out_records, int max_count);
 FILE *history_open_trace(uint32_t record_id);
 
 /**
- * Delete all history records and traces.
+ * Open the event journal of a record (the current firing's included) for
+ * reading with history_read_event(). Caller must fclose() the returned handle.
+ * @return FILE* on success, NULL if there is no journal for the record.
+ */
+FILE *history_open_events(uint32_t record_id);
+
+/**
+ * Read the next event from a journal opened with history_open_events().
+ * @return false at the end of the journal.
+ */
+bool history_read_event(FILE *f, history_event_t *out);
+
+/** Pack / unpack one journal record (HISTORY_EVENT_SIZE bytes). */
+void history_event_encode(const history_event_t *evt, uint8_t *buf);
+void history_event_decode(const uint8_t *buf, history_event_t *out);
+
+/**
+ * Delete all history records, traces and journals.
  */
 void history_clear(void);
 
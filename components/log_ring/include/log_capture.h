@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * The firmware's log ring: every ESP_LOGx line, from boot, kept in noinit
+ * PSRAM as a binary record (log_ring.h) and formatted only when read — by
+ * GET /api/v1/logs or the WebSocket "logs" topic. Only lines at or above
+ * CONFIG_LOG_RING_ECHO_LEVEL are still formatted for the UART as they happen.
+ *
+ * The ring survives a software restart, panic or watchdog reset into the same
+ * image, so the lines leading up to one can be read after it.
+ */
+
+#include "log_ring.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Attach the ring (keeping the previous boot's lines if they're this image's)
+ * and install the esp_log hook. Call first thing in app_main so the ring sees
+ * the whole boot. */
+void log_capture_init(void);
+
+/* Cursors bounding what the ring holds, and how many boots it spans. */
+void log_capture_range(uint64_t *oldest, uint64_t *next, uint32_t *boots);
+
+/* Format the first line at or after `*cursor` into `out` and advance
+ * `*cursor` past it. A cursor that fell behind the oldest line moves up to it.
+ * Returns false, with `*cursor` at the next line to be written, when there is
+ * nothing newer. */
+bool log_capture_read(uint64_t *cursor, log_ring_entry_t *out);
+
+#ifdef __cplusplus
+}
+#endif
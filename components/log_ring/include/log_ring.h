@@ -0,0 +1,107 @@
+#pragma once
+
+/**
+ * Binary log ring: ESP_LOGx lines kept as compact records and formatted only
+ * when somebody reads them back.
+ *
+ * A record is a 16-byte header — length, level, CRC-8, the line's timestamp,
+ * and the tag and format string as 32-bit ids — followed by the printf
+ * arguments' raw bytes (strings copied, up to LOG_RING_STR_MAX). The ids are
+ * offsets of the string literals from an anchor in the same image's .rodata,
+ * so they need no intern table and stay valid for as long as that image
+ * runs, including across a soft reboot into it; the ring's header carries a
+ * build id, and contents written by another image are discarded on attach.
+ * A tag or format outside the image's .rodata (one built at run time) has no
+ * such id and reads back as "?". So does an id that does not land on a whole
+ * string inside it, which is what a damaged record that passed its CRC-8
+ * would hold: decoding never follows an offset out of .rodata.
+ *
+ * Writing walks the format once to pull the arguments off the va_list — no
+ * vsnprintf, no UART. Records never straddle the end of the ring; the oldest
+ * are dropped to make room. Readers address records by absolute byte offset
+ * (a cursor), which only grows, so a reader that fell behind a lap finds out
+ * and skips to the oldest record left.
+ *
+ * Plain data structure with no locking and no ESP-IDF dependencies;
+ * log_capture.c owns the live instance in noinit PSRAM and serializes access.
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LOG_RING_HDR_SIZE 16  /* record header */
+#define LOG_RING_REC_MAX  160 /* whole record; arguments past this are dropped */
+#define LOG_RING_STR_MAX  48  /* bytes kept of each %s argument */
+#define LOG_RING_MSG_MAX  192 /* formatted message, NUL included */
+
+/* Lives at the start of the ring's memory, so it survives with the data. */
+typedef struct {
+    uint32_t magic;
+    uint32_t build_id;
+    uint32_t size;   /* data bytes after this header */
+    uint32_t boots;  /* attaches that kept the previous contents */
+    uint64_t oldest; /* cursor of the oldest record */
+    uint64_t next;   /* cursor the next record is written at */
+} log_ring_hdr_t;
+
+/* Where the image's string literals are: ids are offsets from `anchor`, and
+   only strings wholly inside [lo, hi) get one or are read back. */
+typedef struct {
+    const char *anchor;
+    const char *lo;
+    const char *hi;
+} log_ring_strings_t;
+
+typedef struct {
+    log_ring_hdr_t *hdr;
+    uint8_t *data;
+    const log_ring_strings_t *strings;
+} log_ring_t;
+
+/* One record, formatted. */
+typedef struct {
+    uint64_t cursor; /* where the record starts */
+    uint32_t t_ms;   /* the line's own timestamp: ms since its boot */
+    char level;      /* 'E', 'W', 'I', 'D' or 'V' */
+    bool truncated;  /* arguments were dropped to fit LOG_RING_REC_MAX */
+    const char *tag; /* "" if the line had none */
+    char msg[LOG_RING_MSG_MAX];
+} log_ring_entry_t;
+
+/* Take over `size` bytes at `mem` (8-byte aligned, at least 4 KiB). If they
+ * already hold a ring written by `build_id`, keep it, cut off any record a
+ * crash left half-written, and return true; otherwise start empty. `strings`
+ * must be the same on every attach, with `anchor` a string literal of the
+ * image. */
+bool log_ring_attach(log_ring_t *r, void *mem, size_t size, const log_ring_strings_t *strings, uint32_t build_id);
+
+/* Encode one line as handed to an esp_log vprintf hook: an IDF log line's
+ * "L (%lu) %s: " prefix (colour codes included) becomes the level, timestamp
+ * and tag; anything else is stored whole at level 'I' stamped `now_ms`.
+ * Writes at most LOG_RING_REC_MAX bytes to `rec` and returns the length. */
+size_t log_ring_encode(uint8_t *rec, const log_ring_strings_t *strings, uint32_t now_ms, const char *fmt, va_list ap);
+
+/* Level letter of an encoded record. */
+char log_ring_rec_level(const uint8_t *rec);
+
+/* Append a record from log_ring_encode(), dropping the oldest as needed. */
+void log_ring_append(log_ring_t *r, const uint8_t *rec);
+
+/* Copy out the first record at or after `*cursor` (moved up to the oldest if
+ * it fell behind) into `rec`, and advance `*cursor` past it. Returns the
+ * record's length, or 0 when there is nothing newer. `at` gets the record's
+ * own cursor. */
+size_t log_ring_fetch(const log_ring_t *r, uint64_t *cursor, uint8_t *rec, uint64_t *at);
+
+/* Format a record from log_ring_fetch(). `strings` as for log_ring_attach. */
+void log_ring_decode(const uint8_t *rec, const log_ring_strings_t *strings, uint64_t at, log_ring_entry_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,122 @@
+#include "log_capture.h"
+#include "mem_budget.h"
+
+#include "esp_app_desc.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
+
+#include <inttypes.h>
+
+static const char *TAG = "log_ring";
+
+/* Tag and format ids are offsets from this literal, and only name strings
+   between the linker script's bounds of the image's flash .rodata. */
+static const char s_anchor[] = "bisque log ring";
+extern const char _rodata_start[], _rodata_end[];
+static const log_ring_strings_t s_strings = {.anchor = s_anchor, .lo = _rodata_start, .hi = _rodata_end};
+
+/* noinit: neither zeroed nor loaded at boot, so a restart finds last boot's
+   records where it left them. log_ring_attach() decides whether to trust them. */
+static EXT_RAM_NOINIT_ATTR uint64_t s_mem[CONFIG_LOG_RING_SIZE_KB * 1024 / sizeof(uint64_t)];
+static log_ring_t s_ring;
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+static vprintf_like_t s_prev_vprintf;
+static bool s_initialized;
+
+/* Same image, same id: FNV-1a over what esp_app_desc_t has that identifies
+   the build. */
+static uint32_t build_id(void)
+{
+    const esp_app_desc_t *d = esp_app_get_description();
+    uint32_t h = 2166136261u;
+    const void *parts[] = {d->version, d->date, d->time, d->app_elf_sha256};
+    const size_t sizes[] = {sizeof(d->version), sizeof(d->date), sizeof(d->time), sizeof(d->app_elf_sha256)};
+    for (size_t i = 0; i < sizeof(parts) / sizeof(parts[0]); i++) {
+        const uint8_t *p = parts[i];
+        for (size_t j = 0; j < sizes[i]; j++) {
+            h = (h ^ p[j]) * 16777619u;
+        }
+    }
+    return h;
+}
+
+/* esp_log_level_t of a level letter. */
+static int level_num(char letter)
+{
+    switch (letter) {
+    case 'E':
+        return ESP_LOG_ERROR;
+    case 'W':
+        return ESP_LOG_WARN;
+    case 'D':
+        return ESP_LOG_DEBUG;
+    case 'V':
+        return ESP_LOG_VERBOSE;
+    default:
+        return ESP_LOG_INFO;
+    }
+}
+
+/* The esp_log hook: runs on the logging task, in place of formatting. */
+static int ring_vprintf(const char *fmt, va_list ap)
+{
+    uint8_t rec[LOG_RING_REC_MAX];
+    size_t len = log_ring_encode(rec, &s_strings, esp_log_timestamp(), fmt, ap);
+    portENTER_CRITICAL(&s_mux);
+    log_ring_append(&s_ring, rec);
+    portEXIT_CRITICAL(&s_mux);
+
+    if (s_prev_vprintf && level_num(log_ring_rec_level(rec)) <= CONFIG_LOG_RING_ECHO_LEVEL) {
+        return s_prev_vprintf(fmt, ap);
+    }
+    return (int)len;
+}
+
+void log_capture_init(void)
+{
+    if (s_initialized) {
+        return;
+    }
+    bool kept = log_ring_attach(&s_ring, s_mem, sizeof(s_mem), &s_strings, build_id());
+    s_prev_vprintf = esp_log_set_vprintf(ring_vprintf);
+    s_initialized = true;
+    mem_budget_add("log_ring", "log ring", MEM_REGION_PSRAM, sizeof(s_mem));
+
+    uint64_t oldest, next;
+    uint32_t boots;
+    log_capture_range(&oldest, &next, &boots);
+    if (kept) {
+        ESP_LOGI(TAG, "%u KiB ring: kept %llu bytes from %" PRIu32 " earlier boot(s)",
+                 (unsigned)(sizeof(s_mem) / 1024), (unsigned long long)(next - oldest), boots);
+    } else {
+        ESP_LOGI(TAG, "%u KiB ring: started empty", (unsigned)(sizeof(s_mem) / 1024));
+    }
+}
+
+void log_capture_range(uint64_t *oldest, uint64_t *next, uint32_t *boots)
+{
+    portENTER_CRITICAL(&s_mux);
+    *oldest = s_initialized ? s_ring.hdr->oldest : 0;
+    *next = s_initialized ? s_ring.hdr->next : 0;
+    *boots = s_initialized ? s_ring.hdr->boots : 0;
+    portEXIT_CRITICAL(&s_mux);
+}
+
+bool log_capture_read(uint64_t *cursor, log_ring_entry_t *out)
+{
+    if (!s_initialized) {
+        return false;
+    }
+    uint8_t rec[LOG_RING_REC_MAX];
+    uint64_t at;
+    portENTER_CRITICAL(&s_mux);
+    size_t len = log_ring_fetch(&s_ring, cursor, rec, &at);
+    portEXIT_CRITICAL(&s_mux);
+    if (!len) {
+        return false;
+    }
+    log_ring_decode(rec, &s_strings, at, out); /* outside the lock: this is the slow part */
+    return true;
+}
@@ -0,0 +1,609 @@
+#include "log_ring.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define RING_MAGIC  0x4C4F4752u /* "LOGR" */
+#define NO_TAG      INT32_MIN
+#define NO_STR      (INT32_MIN + 1) /* not a literal of the image */
+#define TRUNC_FLAG  0x80u
+#define RING_MIN    4096u
+
+/* Record header, packed by hand so the layout is the same on every port. */
+#define OFF_LEN   0 /* u16 */
+#define OFF_LEVEL 2 /* u8: level letter | TRUNC_FLAG */
+#define OFF_CRC   3 /* u8 over the whole record with this byte zero */
+#define OFF_TIME  4 /* u32 */
+#define OFF_TAG   8 /* i32 */
+#define OFF_FMT   12 /* i32 */
+
+_Static_assert(OFF_FMT + 4 == LOG_RING_HDR_SIZE, "record header layout");
+_Static_assert(LOG_RING_REC_MAX < RING_MIN / 2, "a record must fit in half the ring");
+
+/* ── Conversion specs ─────────────────────────────── */
+
+typedef enum { LEN_NONE, LEN_HH, LEN_H, LEN_L, LEN_LL, LEN_Z, LEN_J, LEN_T, LEN_BIG_L } arg_len_t;
+
+typedef struct {
+    const char *end; /* one past the conversion character */
+    bool width_star;
+    bool prec_star;
+    arg_len_t len;
+    char conv; /* 0 for "%%" or a spec this doesn't understand */
+} spec_t;
+
+/* Parse the spec whose '%' is at p[-1]. */
+static void parse_spec(const char *p, spec_t *s)
+{
+    *s = (spec_t){0};
+    if (*p == '%') {
+        s->end = p + 1;
+        return;
+    }
+    while (*p && strchr("-+ #0'", *p)) {
+        p++;
+    }
+    if (*p == '*') {
+        s->width_star = true;
+        p++;
+    }
+    while (*p >= '0' && *p <= '9') {
+        p++;
+    }
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            s->prec_star = true;
+            p++;
+        }
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+    }
+    switch (*p) {
+    case 'h':
+        s->len = p[1] == 'h' ? LEN_HH : LEN_H;
+        p += s->len == LEN_HH ? 2 : 1;
+        break;
+    case 'l':
+        s->len = p[1] == 'l' ? LEN_LL : LEN_L;
+        p += s->len == LEN_LL ? 2 : 1;
+        break;
+    case 'z':
+        s->len = LEN_Z;
+        p++;
+        break;
+    case 'j':
+        s->len = LEN_J;
+        p++;
+        break;
+    case 't':
+        s->len = LEN_T;
+        p++;
+        break;
+    case 'L':
+        s->len = LEN_BIG_L;
+        p++;
+        break;
+    default:
+        break;
+    }
+    if (*p && strchr("diouxXcspfFeEgGaA", *p)) {
+        s->conv = *p;
+        s->end = p + 1;
+    } else {
+        s->end = p; /* malformed: stop here, print the rest literally */
+    }
+}
+
+static bool is_int_conv(char c)
+{
+    return c && strchr("diouxXc", c);
+}
+
+static bool is_float_conv(char c)
+{
+    return c && strchr("fFeEgGaA", c);
+}
+
+static size_t int_size(arg_len_t len)
+{
+    switch (len) {
+    case LEN_L:
+        return sizeof(long);
+    case LEN_LL:
+        return sizeof(long long);
+    case LEN_Z:
+        return sizeof(size_t);
+    case LEN_J:
+        return sizeof(intmax_t);
+    case LEN_T:
+        return sizeof(ptrdiff_t);
+    default:
+        return sizeof(int); /* hh and h arrive promoted */
+    }
+}
+
+/* ── Encoding ─────────────────────────────────────── */
+
+typedef struct {
+    uint8_t *rec;
+    size_t len;
+    bool truncated;
+} writer_t;
+
+static bool put(writer_t *w, const void *src, size_t n)
+{
+    if (w->truncated || w->len + n > LOG_RING_REC_MAX) {
+        w->truncated = true;
+        return false;
+    }
+    memcpy(w->rec + w->len, src, n);
+    w->len += n;
+    return true;
+}
+
+static void put_int_arg(writer_t *w, va_list *ap, arg_len_t len)
+{
+    switch (len) {
+    case LEN_L: {
+        long v = va_arg(*ap, long);
+        put(w, &v, sizeof(v));
+        break;
+    }
+    case LEN_LL: {
+        long long v = va_arg(*ap, long long);
+        put(w, &v, sizeof(v));
+        break;
+    }
+    case LEN_Z: {
+        size_t v = va_arg(*ap, size_t);
+        put(w, &v, sizeof(v));
+        break;
+    }
+    case LEN_J: {
+        intmax_t v = va_arg(*ap, intmax_t);
+        put(w, &v, sizeof(v));
+        break;
+    }
+    case LEN_T: {
+        ptrdiff_t v = va_arg(*ap, ptrdiff_t);
+        put(w, &v, sizeof(v));
+        break;
+    }
+    default: {
+        int v = va_arg(*ap, int);
+        put(w, &v, sizeof(v));
+        break;
+    }
+    }
+}
+
+/* Pull every argument `fmt` names off `ap` into the record. Once one doesn't
+   fit, the rest are still consumed (the caller's va_list must stay in step)
+   but dropped. */
+static void put_args(writer_t *w, const char *fmt, va_list *ap)
+{
+    for (const char *p = fmt; *p; p++) {
+        if (*p != '%') {
+            continue;
+        }
+        spec_t s;
+        parse_spec(p + 1, &s);
+        p = s.end - 1;
+        if (!s.conv) {
+            continue;
+        }
+        int star;
+        if (s.width_star) {
+            star = va_arg(*ap, int);
+            put(w, &star, sizeof(star));
+        }
+        if (s.prec_star) {
+            star = va_arg(*ap, int);
+            put(w, &star, sizeof(star));
+        }
+        if (is_int_conv(s.conv)) {
+            put_int_arg(w, ap, s.len);
+        } else if (is_float_conv(s.conv)) {
+            double v = s.len == LEN_BIG_L ? (double)va_arg(*ap, long double) : va_arg(*ap, double);
+            put(w, &v, sizeof(v));
+        } else if (s.conv == 'p') {
+            void *v = va_arg(*ap, void *);
+            put(w, &v, sizeof(v));
+        } else { /* 's' */
+            const char *str = va_arg(*ap, const char *);
+            if (!str) {
+                str = "(null)";
+            }
+            uint8_t n = 0;
+            while (n < LOG_RING_STR_MAX && str[n]) {
+                n++;
+            }
+            if (put(w, &n, 1) && !put(w, str, n)) {
+                w->len--; /* no half strings: drop the length byte too */
+            }
+        }
+    }
+}
+
+/* Addresses compared as integers: the strings need not be one object. */
+static int32_t id_of(const char *s, const log_ring_strings_t *st)
+{
+    if (!s) {
+        return NO_TAG;
+    }
+    if ((uintptr_t)s < (uintptr_t)st->lo || (uintptr_t)s >= (uintptr_t)st->hi) {
+        return NO_STR;
+    }
+    return (int32_t)((intptr_t)s - (intptr_t)st->anchor);
+}
+
+/* The string `id` names, or NULL unless it starts and ends inside [lo, hi). */
+static const char *str_of(int32_t id, const log_ring_strings_t *st)
+{
+    uintptr_t p = (uintptr_t)st->anchor + (uintptr_t)(intptr_t)id;
+    if (id == NO_STR || p < (uintptr_t)st->lo || p >= (uintptr_t)st->hi) {
+        return NULL;
+    }
+    const char *s = (const char *)p;
+    return memchr(s, '\0', (uintptr_t)st->hi - p) ? s : NULL;
+}
+
+static uint8_t crc8(const uint8_t *p, size_t n)
+{
+    uint8_t crc = 0;
+    for (size_t i = 0; i < n; i++) {
+        crc ^= p[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (uint8_t)((crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t rec_len(const uint8_t *rec)
+{
+    uint16_t n;
+    memcpy(&n, rec + OFF_LEN, sizeof(n));
+    return n;
+}
+
+/* An IDF log line's format starts with an optional colour code, then
+   "L (%lu) %s: ". Returns the user part, or NULL if this isn't one. */
+static const char *match_prefix(const char *fmt, char *level, spec_t *ts)
+{
+    const char *p = fmt;
+    if (*p == '\033') {
+        p = strchr(p, 'm');
+        if (!p) {
+            return NULL;
+        }
+        p++;
+    }
+    if (!*p || !strchr("EWIDV", *p) || strncmp(p + 1, " (%", 3) != 0) {
+        return NULL;
+    }
+    *level = *p;
+    parse_spec(p + 4, ts);
+    if (!is_int_conv(ts->conv) || strncmp(ts->end, ") %s: ", 6) != 0) {
+        return NULL;
+    }
+    return ts->end + 6;
+}
+
+size_t log_ring_encode(uint8_t *rec, const log_ring_strings_t *strings, uint32_t now_ms, const char *fmt, va_list ap)
+{
+    va_list args;
+    va_copy(args, ap);
+
+    char level = 'I';
+    uint32_t t_ms = now_ms;
+    const char *tag = NULL;
+    spec_t ts;
+    const char *user = match_prefix(fmt, &level, &ts);
+    if (user) {
+        t_ms = ts.len == LEN_LL ? (uint32_t)va_arg(args, unsigned long long)
+               : ts.len == LEN_L ? (uint32_t)va_arg(args, unsigned long)
+                                 : va_arg(args, unsigned int);
+        tag = va_arg(args, const char *);
+    } else {
+        user = fmt;
+    }
+
+    writer_t w = {.rec = rec, .len = LOG_RING_HDR_SIZE};
+    int32_t tag_id = id_of(tag, strings);
+    int32_t fmt_id = id_of(user, strings);
+    memcpy(rec + OFF_TIME, &t_ms, sizeof(t_ms));
+    memcpy(rec + OFF_TAG, &tag_id, sizeof(tag_id));
+    memcpy(rec + OFF_FMT, &fmt_id, sizeof(fmt_id));
+    if (fmt_id != NO_STR) { /* arguments with no format to read them back by are not kept */
+        put_args(&w, user, &args);
+    }
+    va_end(args);
+
+    uint16_t len = (uint16_t)w.len;
+    memcpy(rec + OFF_LEN, &len, sizeof(len));
+    rec[OFF_LEVEL] = (uint8_t)level | (w.truncated ? TRUNC_FLAG : 0);
+    rec[OFF_CRC] = 0;
+    rec[OFF_CRC] = crc8(rec, len);
+    return len;
+}
+
+char log_ring_rec_level(const uint8_t *rec)
+{
+    return (char)(rec[OFF_LEVEL] & ~TRUNC_FLAG);
+}
+
+/* ── Ring ─────────────────────────────────────────── */
+
+/* Where the record at `cursor` really starts: a cursor too close to the end
+   for a header, or on the zero-length wrap marker, means "at the top". */
+static uint64_t skip_wrap(const log_ring_t *r, uint64_t cursor)
+{
+    uint32_t size = r->hdr->size;
+    uint32_t pos = (uint32_t)(cursor % size);
+    if (size - pos < LOG_RING_HDR_SIZE || rec_len(r->data + pos) == 0) {
+        return cursor + (size - pos);
+    }
+    return cursor;
+}
+
+static bool rec_valid(const log_ring_t *r, uint64_t cursor, uint64_t limit)
+{
+    const uint8_t *rec = r->data + cursor % r->hdr->size;
+    uint16_t len = rec_len(rec);
+    if (len < LOG_RING_HDR_SIZE || len > LOG_RING_REC_MAX || cursor + len > limit) {
+        return false;
+    }
+    uint8_t tmp[LOG_RING_REC_MAX];
+    memcpy(tmp, rec, len);
+    tmp[OFF_CRC] = 0;
+    return crc8(tmp, len) == rec[OFF_CRC];
+}
+
+bool log_ring_attach(log_ring_t *r, void *mem, size_t size, const log_ring_strings_t *strings, uint32_t build_id)
+{
+    r->hdr = mem;
+    r->data = (uint8_t *)mem + sizeof(log_ring_hdr_t);
+    r->strings = strings;
+    uint32_t data_size = (uint32_t)(size - sizeof(log_ring_hdr_t));
+
+    log_ring_hdr_t *h = r->hdr;
+    if (size < RING_MIN || h->magic != RING_MAGIC || h->build_id != build_id || h->size != data_size ||
+        h->oldest > h->next || h->next - h->oldest > data_size) {
+        *h = (log_ring_hdr_t){.magic = RING_MAGIC, .build_id = build_id, .size = data_size};
+        return false;
+    }
+    /* Walk the survivors. next only moves once a record is complete, so this
+       is about memory that rotted while the chip was down: everything from
+       the first bad record on goes. */
+    uint64_t c = h->oldest;
+    while (c < h->next) {
+        uint64_t at = skip_wrap(r, c);
+        if (at > h->next || (at < h->next && !rec_valid(r, at, h->next))) {
+            h->next = c;
+            break;
+        }
+        c = at == h->next ? at : at + rec_len(r->data + at % data_size);
+    }
+    h->boots++;
+    return true;
+}
+
+void log_ring_append(log_ring_t *r, const uint8_t *rec)
+{
+    log_ring_hdr_t *h = r->hdr;
+    uint16_t len = rec_len(rec);
+    uint32_t pos = (uint32_t)(h->next % h->size);
+    uint32_t skip = h->size - pos < len ? h->size - pos : 0;
+    uint64_t end = h->next + skip + len;
+
+    /* skip + len is under half the ring, so this stops by oldest == next. */
+    while (end - h->oldest > h->size) {
+        uint64_t at = skip_wrap(r, h->oldest);
+        h->oldest = at != h->oldest ? at : at + rec_len(r->data + at % h->size);
+    }
+    if (skip >= sizeof(uint16_t)) {
+        memset(r->data + pos, 0, sizeof(uint16_t)); /* wrap marker */
+    }
+    memcpy(r->data + (pos + skip) % h->size, rec, len);
+    h->next = end;
+}
+
+size_t log_ring_fetch(const log_ring_t *r, uint64_t *cursor, uint8_t *rec, uint64_t *at)
+{
+    const log_ring_hdr_t *h = r->hdr;
+    if (*cursor < h->oldest || *cursor > h->next) {
+        *cursor = h->oldest; /* lapped, or a cursor from before a reset */
+    }
+    uint64_t c = *cursor < h->next ? skip_wrap(r, *cursor) : h->next;
+    if (c >= h->next || !rec_valid(r, c, h->next)) {
+        *cursor = h->next; /* nothing newer, or a cursor that isn't on a record */
+        return 0;
+    }
+    uint16_t len = rec_len(r->data + c % h->size);
+    memcpy(rec, r->data + c % h->size, len);
+    *at = c;
+    *cursor = c + len;
+    return len;
+}
+
+/* ── Decoding ─────────────────────────────────────── */
+
+typedef struct {
+    char *buf;
+    size_t cap;
+    size_t len;
+} out_t;
+
+static void emit(out_t *o, const char *s, size_t n)
+{
+    size_t room = o->cap - 1 - o->len;
+    n = n < room ? n : room;
+    memcpy(o->buf + o->len, s, n);
+    o->len += n;
+    o->buf[o->len] = '\0';
+}
+
+/* snprintf one conversion into the output; `spec` is the conversion with its
+   '*'s already replaced by the stored values. */
+#define EMIT_FMT(o, spec, value)                                                                        \
+    do {                                                                                                \
+        char tmp_[LOG_RING_MSG_MAX];                                                                    \
+        int n_ = snprintf(tmp_, sizeof(tmp_), spec, value);                                             \
+        if (n_ > 0) {                                                                                   \
+            emit(o, tmp_, (size_t)n_ < sizeof(tmp_) ? (size_t)n_ : sizeof(tmp_) - 1);                   \
+        }                                                                                               \
+    } while (0)
+
+#define EMIT_INT(o, spec, sgn, value, utype)                                                            \
+    do {                                                                                                \
+        if (sgn) {                                                                                      \
+            EMIT_FMT(o, spec, value);                                                                   \
+        } else {                                                                                        \
+            EMIT_FMT(o, spec, (utype)(value));                                                          \
+        }                                                                                               \
+    } while (0)
+
+typedef struct {
+    const uint8_t *p;
+    const uint8_t *end;
+} reader_t;
+
+static bool take(reader_t *rd, void *dst, size_t n)
+{
+    if ((size_t)(rd->end - rd->p) < n) {
+        return false;
+    }
+    memcpy(dst, rd->p, n);
+    rd->p += n;
+    return true;
+}
+
+/* Format one stored argument; false when the record ran out of them. */
+static bool emit_arg(out_t *o, reader_t *rd, const char *start, const spec_t *s)
+{
+    char spec[32];
+    size_t sl = 0;
+    for (const char *q = start; q < s->end && sl < sizeof(spec) - 12; q++) {
+        if (*q == '*') {
+            int v;
+            if (!take(rd, &v, sizeof(v))) {
+                return false;
+            }
+            sl += (size_t)snprintf(spec + sl, sizeof(spec) - sl, "%d", v);
+        } else {
+            spec[sl++] = *q;
+        }
+    }
+    spec[sl] = '\0';
+
+    if (is_int_conv(s->conv)) {
+        bool sgn = s->conv == 'd' || s->conv == 'i';
+        union {
+            int i;
+            long l;
+            long long ll;
+            size_t z;
+            intmax_t j;
+            ptrdiff_t t;
+        } v;
+        if (!take(rd, &v, int_size(s->len))) {
+            return false;
+        }
+        switch (s->len) {
+        case LEN_L:
+            EMIT_INT(o, spec, sgn, v.l, unsigned long);
+            break;
+        case LEN_LL:
+            EMIT_INT(o, spec, sgn, v.ll, unsigned long long);
+            break;
+        case LEN_Z:
+            EMIT_INT(o, spec, sgn, (ptrdiff_t)v.z, size_t);
+            break;
+        case LEN_J:
+            EMIT_INT(o, spec, sgn, v.j, uintmax_t);
+            break;
+        case LEN_T:
+            EMIT_INT(o, spec, sgn, v.t, size_t);
+            break;
+        default:
+            EMIT_INT(o, spec, sgn, v.i, unsigned int);
+            break;
+        }
+    } else if (is_float_conv(s->conv)) {
+        double v;
+        if (!take(rd, &v, sizeof(v))) {
+            return false;
+        }
+        if (s->len == LEN_BIG_L) {
+            EMIT_FMT(o, spec, (long double)v);
+        } else {
+            EMIT_FMT(o, spec, v);
+        }
+    } else if (s->conv == 'p') {
+        void *v;
+        if (!take(rd, &v, sizeof(v))) {
+            return false;
+        }
+        EMIT_FMT(o, spec, v);
+    } else {
+        uint8_t n;
+        char str[LOG_RING_STR_MAX + 1];
+        if (!take(rd, &n, 1) || n > LOG_RING_STR_MAX || !take(rd, str, n)) {
+            return false;
+        }
+        str[n] = '\0';
+        EMIT_FMT(o, spec, str);
+    }
+    return true;
+}
+
+void log_ring_decode(const uint8_t *rec, const log_ring_strings_t *strings, uint64_t at, log_ring_entry_t *out)
+{
+    int32_t tag_id, fmt_id;
+    memcpy(&out->t_ms, rec + OFF_TIME, sizeof(out->t_ms));
+    memcpy(&tag_id, rec + OFF_TAG, sizeof(tag_id));
+    memcpy(&fmt_id, rec + OFF_FMT, sizeof(fmt_id));
+    out->cursor = at;
+    out->level = log_ring_rec_level(rec);
+    out->truncated = (rec[OFF_LEVEL] & TRUNC_FLAG) != 0;
+    const char *tag = tag_id == NO_TAG ? "" : str_of(tag_id, strings);
+    out->tag = tag ? tag : "?";
+
+    out_t o = {.buf = out->msg, .cap = sizeof(out->msg)};
+    out->msg[0] = '\0';
+    reader_t rd = {.p = rec + LOG_RING_HDR_SIZE, .end = rec + rec_len(rec)};
+    const char *fmt = str_of(fmt_id, strings);
+    if (!fmt) {
+        fmt = "?";
+    }
+    for (const char *p = fmt; *p;) {
+        if (*p == '\033') { /* colour codes are for terminals */
+            const char *m = strchr(p, 'm');
+            p = m ? m + 1 : p + 1;
+            continue;
+        }
+        if (*p != '%') {
+            size_t n = strcspn(p, "%\033");
+            emit(&o, p, n);
+            p += n;
+            continue;
+        }
+        spec_t s;
+        parse_spec(p + 1, &s);
+        if (!s.conv) {
+            emit(&o, p, p[1] == '%' ? 1 : (size_t)(s.end - p)); /* "%%", or a spec left as written */
+        } else if (!emit_arg(&o, &rd, p, &s)) {
+            break;
+        }
+        p = s.end;
+    }
+    while (o.len > 0 && (out->msg[o.len - 1] == '\n' || out->msg[o.len - 1] == '\r')) {
+        out->msg[--o.len] = '\0';
+    }
+    if (out->truncated) {
+        emit(&o, " [truncated]", strlen(" [truncated]"));
+    }
+}
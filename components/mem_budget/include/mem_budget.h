@@ -0,0 +1,60 @@
+#pragma once
+
+/**
+ * Static placement and boot-time budget for the firmware's long-lived memory.
+ *
+ * Every long-lived task stack, queue, mutex and event group (and the LVGL draw
+ * buffers) is a static object in the file that owns it, not a heap
+ * allocation, so nothing a long firing does to the heap can make a reconnect
+ * or a restarted worker fail for want of a contiguous block. Which RAM each
+ * one lives in is set by the placement table in app_config.h; the owner
+ * declares it with MEM_PLACE() and registers it here, and app_main prints the
+ * lot once boot is done: bytes per component per region, what is left in each
+ * heap, and every registered task's stack high-water mark.
+ */
+
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    MEM_REGION_INTERNAL = 0, /* on-chip SRAM: DMA-capable, usable with the flash cache disabled */
+    MEM_REGION_PSRAM,        /* octal PSRAM: plentiful, slower, off-limits while flash is written */
+    MEM_REGION_COUNT,
+} mem_region_t;
+
+/* Section attribute for a static object placed in `region`, where `region` is
+ * one of the placement-table macros (APP_MEM_*), e.g.
+ *     static MEM_PLACE(APP_MEM_NOTIFY_STACK) StackType_t s_stack[APP_TASK_NOTIFY_STACK];
+ * Internal RAM is where .bss goes anyway; PSRAM needs
+ * CONFIG_SPIRAM_ALLOW_BSS_SEG_EXTERNAL_MEMORY (and, for a task stack,
+ * CONFIG_SPIRAM_ALLOW_STACK_EXTERNAL_MEMORY). */
+#define MEM_PLACE(region)  MEM_PLACE_(region)
+#define MEM_PLACE_(region) MEM_PLACE_##region
+#define MEM_PLACE_MEM_REGION_INTERNAL
+#define MEM_PLACE_MEM_REGION_PSRAM EXT_RAM_BSS_ATTR
+
+/* Account `bytes` of static memory in `region` to `component`. `what` names
+ * the object for the report. Call from the owner's init; not thread-safe, as
+ * everything registers from app_main's task before the report. */
+void mem_budget_add(const char *component, const char *what, mem_region_t region, size_t bytes);
+
+/* As mem_budget_add() for a task's stack and TCB; the report also shows the
+ * least free stack the task has had. */
+void mem_budget_add_task(const char *component, TaskHandle_t task, mem_region_t region, size_t stack_bytes);
+
+/* Stack bytes registered for `task` with mem_budget_add_task(), 0 if none. */
+size_t mem_budget_task_stack(TaskHandle_t task);
+
+/* Log the budget (ESP_LOGI). Call once boot is complete. */
+void mem_budget_report(void);
+
+#ifdef __cplusplus
+}
+#endif
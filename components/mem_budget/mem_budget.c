@@ -0,0 +1,121 @@
+#include "mem_budget.h"
+
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+static const char *TAG = "mem_budget";
+
+#define MEM_BUDGET_MAX_ENTRIES 40
+
+typedef struct {
+    const char *component;
+    const char *what;
+    mem_region_t region;
+    size_t bytes;
+    TaskHandle_t task; /* non-NULL for a task stack */
+} mem_entry_t;
+
+static mem_entry_t s_entries[MEM_BUDGET_MAX_ENTRIES];
+static int s_count;
+
+static const char *const s_region_names[MEM_REGION_COUNT] = {"internal", "psram"};
+
+static void add_entry(const char *component, const char *what, mem_region_t region, size_t bytes, TaskHandle_t task)
+{
+    if (s_count >= MEM_BUDGET_MAX_ENTRIES) {
+        ESP_LOGW(TAG, "budget table full; %s/%s (%u B) not counted", component, what, (unsigned)bytes);
+        return;
+    }
+    s_entries[s_count++] = (mem_entry_t){
+        .component = component,
+        .what = what,
+        .region = region,
+        .bytes = bytes,
+        .task = task,
+    };
+}
+
+void mem_budget_add(const char *component, const char *what, mem_region_t region, size_t bytes)
+{
+    add_entry(component, what, region, bytes, NULL);
+}
+
+void mem_budget_add_task(const char *component, TaskHandle_t task, mem_region_t region, size_t stack_bytes)
+{
+    if (!task) {
+        return;
+    }
+    const char *name = pcTaskGetName(task);
+    add_entry(component, name, region, stack_bytes, task);
+    /* The TCB always lives in internal RAM, whatever the stack's placement. */
+    add_entry(component, name, MEM_REGION_INTERNAL, sizeof(StaticTask_t), NULL);
+}
+
+size_t mem_budget_task_stack(TaskHandle_t task)
+{
+    for (int i = 0; i < s_count && task; i++) {
+        if (s_entries[i].task == task) {
+            return s_entries[i].bytes;
+        }
+    }
+    return 0;
+}
+
+static void report_heap(const char *label, uint32_t caps)
+{
+    size_t total = heap_caps_get_total_size(caps);
+    if (total == 0) {
+        return;
+    }
+    ESP_LOGI(TAG, "  heap %-8s free %7u of %7u B, largest block %7u B, low-water %7u B", label,
+             (unsigned)heap_caps_get_free_size(caps), (unsigned)total,
+             (unsigned)heap_caps_get_largest_free_block(caps), (unsigned)heap_caps_get_minimum_free_size(caps));
+}
+
+void mem_budget_report(void)
+{
+    size_t totals[MEM_REGION_COUNT] = {0};
+
+    ESP_LOGI(TAG, "Static memory by component (bytes):");
+    ESP_LOGI(TAG, "  %-14s %9s %9s", "component", s_region_names[MEM_REGION_INTERNAL],
+             s_region_names[MEM_REGION_PSRAM]);
+    for (int i = 0; i < s_count; i++) {
+        /* First entry of each component prints the component's line. */
+        bool seen = false;
+        for (int j = 0; j < i && !seen; j++) {
+            seen = strcmp(s_entries[j].component, s_entries[i].component) == 0;
+        }
+        if (seen) {
+            continue;
+        }
+        size_t by_region[MEM_REGION_COUNT] = {0};
+        for (int j = i; j < s_count; j++) {
+            if (strcmp(s_entries[j].component, s_entries[i].component) == 0) {
+                by_region[s_entries[j].region] += s_entries[j].bytes;
+            }
+        }
+        ESP_LOGI(TAG, "  %-14s %9u %9u", s_entries[i].component, (unsigned)by_region[MEM_REGION_INTERNAL],
+                 (unsigned)by_region[MEM_REGION_PSRAM]);
+        for (int r = 0; r < MEM_REGION_COUNT; r++) {
+            totals[r] += by_region[r];
+        }
+    }
+    ESP_LOGI(TAG, "  %-14s %9u %9u", "total", (unsigned)totals[MEM_REGION_INTERNAL],
+             (unsigned)totals[MEM_REGION_PSRAM]);
+
+    ESP_LOGI(TAG, "Headroom:");
+    report_heap("internal", MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    report_heap("dma", MALLOC_CAP_DMA);
+    report_heap("psram", MALLOC_CAP_SPIRAM);
+    for (int i = 0; i < s_count; i++) {
+        if (!s_entries[i].task) {
+            continue;
+        }
+        ESP_LOGI(TAG, "  task %-13s stack %6u B (%s), least free %6u B", s_entries[i].what,
+                 (unsigned)s_entries[i].bytes, s_region_names[s_entries[i].region],
+                 (unsigned)uxTaskGetStackHighWaterMark(s_entries[i].task));
+    }
+}
@@ -45,6 +45,15 @@ void pid_reset(pid_controller_t *pid);
  */
 float pid_compute(pid_controller_t *pid, float setpoint, float measured, float dt_s);
 
+/**
+ * True when another pid_compute() with this setpoint and measurement would
+ * return the same output whatever its dt: zero error, an unchanged
+ * measurement, and a derivative filter decayed into the subnormal range,
+ * where it can no longer move the output. Lets a simulator skip ticks on a
+ * steady plant without changing the result (see firing_next_event_us).
+ */
+bool pid_is_settled(const pid_controller_t *pid, float setpoint, float measured);
+
 /* --- PID Auto-Tune (Ziegler-Nichols relay method) --- */
 
 typedef enum {
@@ -70,7 +79,7 @@ typedef struct {
     float peak_low;           /* Min temp during current half-cycle */
     float amplitude_sum;      /* Sum of amplitudes for averaging */
     float period_sum_s;       /* Sum of periods for averaging */
-    int64_t last_crossing_us; /* Timestamp of last setpoint crossing */
+    int64_t last_crossing_us; /* Timestamp of last setpoint crossing (0 = none yet) */
     int64_t start_time_us;    /* When auto-tune started */
     int64_t timeout_us;       /* Max duration before failing */
     bool above_setpoint;      /* Was above setpoint on last sample */
@@ -79,18 +88,24 @@ typedef struct {
 
 /**
  * Start auto-tune. Sets state to AUTOTUNE_HEATING_TO_SETPOINT.
+ *
+ * Auto-tune never reads the clock itself: `now_us` here and in
+ * pid_autotune_update() is the caller's monotonic time (firing_tick's
+ * `now_us` on the device), so a host simulation can run a whole tune in
+ * virtual time.
  */
-esp_err_t pid_autotune_start(pid_autotune_t *at, float setpoint, float hysteresis);
+esp_err_t pid_autotune_start(pid_autotune_t *at, float setpoint, float hysteresis, int64_t now_us);
 
 /**
  * Call once per control loop iteration (1 Hz).
  *
  * @param at           Auto-tune state
  * @param current_temp Current thermocouple reading
+ * @param now_us       Monotonic time of this reading, same clock as start
  * @param output       Receives relay output: 0.0 (off) or 1.0 (on)
  * @return true when tuning is complete or failed
  */
-bool pid_autotune_update(pid_autotune_t *at, float current_temp, float *output);
+bool pid_autotune_update(pid_autotune_t *at, float current_temp, int64_t now_us, float *output);
 
 /**
  * Check if auto-tune completed successfully.
@@ -107,7 +122,7 @@ void pid_autotune_cancel(pid_autotune_t *at);
  * `delta_us`, so that time the run spent suspended is not charged against it.
  *
  * Auto-tune measures its overall timeout and each relay half-cycle period
- * against `esp_timer_get_time()`. Without this, a paused run either trips the
+ * against the `now_us` it is fed. Without this, a paused run either trips the
  * timeout the moment it resumes or folds the pause into an oscillation period
  * and derives PID gains from it. Call on resume with the paused duration.
  */
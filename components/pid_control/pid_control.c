@@ -1,9 +1,9 @@
 #include "pid_control.h"
 #include "app_config.h"
 #include "esp_log.h"
-#include "esp_timer.h"
 #include "nvs_flash.h"
 #include "nvs.h"
+#include <float.h>
 #include <math.h>
 #include <string.h>
 
@@ -101,9 +101,22 @@ float pid_compute(pid_controller_t *pid, float setpoint, float measured, float d
     return output;
 }
 
+bool pid_is_settled(const pid_controller_t *pid, float setpoint, float measured)
+{
+    if (pid->first_run || setpoint != measured || pid->prev_measured != measured || fabsf(pid->d_filtered) >= FLT_MIN) {
+        return false;
+    }
+    /* A subnormal D term can still show when the I term is exactly zero. It
+       only shrinks from here, so once it is lost in the clamped output it stays
+       lost. */
+    float without_d = fminf(fmaxf(pid->ki * pid->integral, pid->output_min), pid->output_max);
+    float with_d = fminf(fmaxf(pid->ki * pid->integral - pid->kd * pid->d_filtered, pid->output_min), pid->output_max);
+    return with_d == without_d;
+}
+
 /* ── Auto-Tune ─────────────────────────────────────────────── */
 
-esp_err_t pid_autotune_start(pid_autotune_t *at, float setpoint, float hysteresis)
+esp_err_t pid_autotune_start(pid_autotune_t *at, float setpoint, float hysteresis, int64_t now_us)
 {
     if (!isfinite(setpoint) || !isfinite(hysteresis) || setpoint <= 0.0f || hysteresis <= 0.0f) {
         return ESP_ERR_INVALID_ARG;
@@ -121,7 +134,7 @@ esp_err_t pid_autotune_start(pid_autotune_t *at, float setpoint, float hysteresi
     at->amplitude_sum = 0.0f;
     at->period_sum_s = 0.0f;
     at->last_crossing_us = 0;
-    at->start_time_us = esp_timer_get_time();
+    at->start_time_us = now_us;
     at->timeout_us = AUTOTUNE_TIMEOUT_US;
     at->above_setpoint = false;
     at->half_cycles = 0;
@@ -130,17 +143,15 @@ esp_err_t pid_autotune_start(pid_autotune_t *at, float setpoint, float hysteresi
     return ESP_OK;
 }
 
-bool pid_autotune_update(pid_autotune_t *at, float current_temp, float *output)
+bool pid_autotune_update(pid_autotune_t *at, float current_temp, int64_t now_us, float *output)
 {
     if (at->state == AUTOTUNE_COMPLETE || at->state == AUTOTUNE_FAILED || at->state == AUTOTUNE_IDLE) {
         *output = 0.0f;
         return true;
     }
 
-    int64_t now = esp_timer_get_time();
-
     /* Timeout check */
-    if ((now - at->start_time_us) > at->timeout_us) {
+    if ((now_us - at->start_time_us) > at->timeout_us) {
         ESP_LOGW(TAG, "Auto-tune timed out");
         at->state = AUTOTUNE_FAILED;
         *output = 0.0f;
@@ -154,14 +165,18 @@ bool pid_autotune_update(pid_autotune_t *at, float current_temp, float *output)
         if (current_temp >= at->setpoint - at->hysteresis) {
             at->state = AUTOTUNE_RELAY_CYCLING;
             at->relay_on = false; /* Start by turning off at setpoint */
-            at->above_setpoint = true;
-            at->last_crossing_us = now;
+            /* Entry is at setpoint - hysteresis, i.e. below the setpoint. The
+               first real crossing only establishes the baseline (see below);
+               timing a cycle from here would average a short, shallow partial
+               cycle into the result and inflate every gain. */
+            at->above_setpoint = current_temp > at->setpoint;
+            at->last_crossing_us = 0;
             at->peak_high = current_temp;
             at->peak_low = current_temp;
             /* Restart the timeout budget for the cycling phase. Otherwise a long
                heat-up to a high setpoint eats into the same 60-minute window and
                the 5 relay cycles almost never finish in time. */
-            at->start_time_us = now;
+            at->start_time_us = now_us;
             ESP_LOGI(TAG, "Reached setpoint, starting relay cycling");
         }
         return false;
@@ -179,12 +194,17 @@ bool pid_autotune_update(pid_autotune_t *at, float current_temp, float *output)
 
         /* Detect setpoint crossing */
         if (now_above != at->above_setpoint) {
-            at->half_cycles++;
             at->above_setpoint = now_above;
 
-            /* Every two half-cycles = one full cycle */
-            if (at->half_cycles >= 2) {
-                int64_t period_us = now - at->last_crossing_us;
+            if (at->last_crossing_us == 0) {
+                /* First crossing: start timing full cycles from here. */
+                at->last_crossing_us = now_us;
+                at->half_cycles = 0;
+                at->peak_high = current_temp;
+                at->peak_low = current_temp;
+            } else if (++at->half_cycles >= 2) {
+                /* Every two half-cycles = one full cycle */
+                int64_t period_us = now_us - at->last_crossing_us;
                 float period_s = (float)period_us / 1000000.0f;
                 float amplitude = (at->peak_high - at->peak_low) / 2.0f;
 
@@ -192,7 +212,7 @@ bool pid_autotune_update(pid_autotune_t *at, float current_temp, float *output)
                 at->amplitude_sum += amplitude;
                 at->cycles_done++;
                 at->half_cycles = 0;
-                at->last_crossing_us = now;
+                at->last_crossing_us = now_us;
 
                 /* Reset peaks for next cycle */
                 at->peak_high = current_temp;
@@ -0,0 +1,39 @@
+#pragma once
+
+/**
+ * Fixed-size latency histogram: four buckets per power of two, so any value
+ * lands in a bucket at most 25% wide and the whole uint32_t range fits in
+ * RT_HIST_BUCKETS counters. Adding is a clz and an increment, cheap enough
+ * for a 1 Hz control loop to keep on permanently; percentiles come back as
+ * the upper edge of the bucket they fall in (clamped to the largest value
+ * seen), i.e. never under-reported.
+ *
+ * Plain data structure with no locking and no ESP-IDF dependencies.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RT_HIST_BUCKETS 124 /* values 0-3 exactly, then 4 per octave up to 2^32 */
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t buckets[RT_HIST_BUCKETS];
+} rt_hist_t;
+
+void rt_hist_reset(rt_hist_t *h);
+void rt_hist_add(rt_hist_t *h, uint32_t value);
+
+/* Smallest bucket edge at or above `pct` percent (0-100) of the values;
+ * 0 for an empty histogram. */
+uint32_t rt_hist_percentile(const rt_hist_t *h, uint32_t pct);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+
+/**
+ * Runtime diagnostics: where the CPU time goes, how close each task has come
+ * to the end of its stack, and how long firing_tick takes and how late it
+ * runs — served at GET /api/v1/diagnostics/runtime.
+ *
+ * A periodic esp_timer samples FreeRTOS run-time stats every
+ * APP_RT_STATS_WINDOW_MS and keeps each task's share of the last window (and
+ * each core's load, from its idle task), so a reader gets a settled figure
+ * rather than a since-boot average or whatever elapsed since the previous
+ * reader. Stack figures are FreeRTOS's own high-water marks. firing_task
+ * brackets every tick with rt_stats_tick_begin/end, which feed two
+ * histograms: the tick's execution time off the CPU cycle counter, and how
+ * far each wake was from the 1 s period.
+ *
+ * Everything is fixed-size and allocated statically; the only ongoing cost
+ * is the run-time counter FreeRTOS reads on each context switch
+ * (CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS) and one system-state walk per
+ * window.
+ */
+
+#include "rt_hist.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RT_STATS_MAX_TASKS 32
+#define RT_STATS_NAME_LEN  16
+#define RT_STATS_MAX_CORES 2
+
+typedef struct {
+    char name[RT_STATS_NAME_LEN];
+    int8_t core;         /* pinned core, -1 when the task may run on either */
+    uint8_t priority;    /* current priority */
+    float cpu_pct;       /* share of one core over the last window */
+    uint32_t stack_free; /* least free stack the task has had, bytes */
+    uint32_t stack_size; /* bytes, 0 when not a statically allocated task (see mem_budget) */
+} rt_task_stat_t;
+
+typedef struct {
+    uint32_t window_ms; /* length of the sampled window; 0 until the first one completes */
+    uint32_t uptime_s;
+    int core_count;
+    float core_load_pct[RT_STATS_MAX_CORES];
+    int task_count;
+    rt_task_stat_t tasks[RT_STATS_MAX_TASKS];
+
+    rt_hist_t tick_us;            /* firing_tick execution time */
+    rt_hist_t jitter_us;          /* |wake-to-wake period - 1 s| */
+    uint32_t period_max_us;       /* longest wake-to-wake period seen */
+    uint32_t ticks_over_deadline; /* periods longer than 1.5 s */
+} rt_stats_snapshot_t;
+
+/* Start the window sampler. Call once the long-lived tasks exist; idempotent. */
+void rt_stats_init(void);
+
+/* Bracket one firing_tick() from firing_task. Not reentrant: one caller. */
+void rt_stats_tick_begin(void);
+void rt_stats_tick_end(void);
+
+/* Copy out the latest window and the tick histograms. Fills `out` (a couple
+ * of KB — keep it off small stacks). */
+void rt_stats_snapshot(rt_stats_snapshot_t *out);
+
+#ifdef __cplusplus
+}
+#endif
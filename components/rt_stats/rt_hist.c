@@ -0,0 +1,66 @@
+#include "rt_hist.h"
+
+#include <string.h>
+
+static int bucket_of(uint32_t v)
+{
+    if (v < 4) {
+        return (int)v;
+    }
+    int msb = 31 - __builtin_clz(v);
+    return (msb - 1) * 4 + (int)((v >> (msb - 2)) & 3);
+}
+
+/* Largest value that lands in bucket `b`. */
+static uint32_t bucket_top(int b)
+{
+    if (b < 4) {
+        return (uint32_t)b;
+    }
+    int msb = b / 4 + 1;
+    uint64_t bottom = (uint64_t)(4 + b % 4) << (msb - 2);
+    uint64_t width = (uint64_t)1 << (msb - 2);
+    return (uint32_t)(bottom + width - 1);
+}
+
+void rt_hist_reset(rt_hist_t *h)
+{
+    memset(h, 0, sizeof(*h));
+}
+
+void rt_hist_add(rt_hist_t *h, uint32_t value)
+{
+    if (h->count == 0 || value < h->min) {
+        h->min = value;
+    }
+    if (value > h->max) {
+        h->max = value;
+    }
+    h->count++;
+    h->sum += value;
+    h->buckets[bucket_of(value)]++;
+}
+
+uint32_t rt_hist_percentile(const rt_hist_t *h, uint32_t pct)
+{
+    if (h->count == 0) {
+        return 0;
+    }
+    if (pct > 100) {
+        pct = 100;
+    }
+    /* Rank of the value wanted, 1-based, rounded up. */
+    uint64_t rank = ((uint64_t)h->count * pct + 99) / 100;
+    if (rank == 0) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (int b = 0; b < RT_HIST_BUCKETS; b++) {
+        seen += h->buckets[b];
+        if (seen >= rank) {
+            uint32_t top = bucket_top(b);
+            return top < h->max ? top : h->max;
+        }
+    }
+    return h->max;
+}
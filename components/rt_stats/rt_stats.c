@@ -0,0 +1,199 @@
+#include "rt_stats.h"
+#include "app_config.h"
+#include "mem_budget.h"
+
+#include "esp_cpu.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sdkconfig.h"
+
+#include <string.h>
+
+static const char *TAG = "rt_stats";
+
+#define TICK_PERIOD_US 1000000
+#define LATE_PERIOD_US 1500000 /* half a period late: the next tick's budget is already gone */
+
+/* Sampler state: only the esp_timer task touches it. */
+typedef struct {
+    TaskHandle_t handle;
+    configRUN_TIME_COUNTER_TYPE run;
+} prev_run_t;
+
+static MEM_PLACE(APP_MEM_RT_STATS) TaskStatus_t s_status[RT_STATS_MAX_TASKS];
+static MEM_PLACE(APP_MEM_RT_STATS) prev_run_t s_prev[RT_STATS_MAX_TASKS];
+static MEM_PLACE(APP_MEM_RT_STATS) rt_task_stat_t s_next[RT_STATS_MAX_TASKS];
+static int s_prev_count;
+static configRUN_TIME_COUNTER_TYPE s_prev_total;
+static int64_t s_prev_sample_us;
+static bool s_have_prev;
+static bool s_warned_full;
+
+/* Published window and tick histograms, under s_mux. */
+static MEM_PLACE(APP_MEM_RT_STATS) rt_task_stat_t s_tasks[RT_STATS_MAX_TASKS];
+static int s_task_count;
+static int s_core_count;
+static float s_core_load[RT_STATS_MAX_CORES];
+static uint32_t s_window_ms;
+static MEM_PLACE(APP_MEM_RT_STATS) rt_hist_t s_tick_us;
+static MEM_PLACE(APP_MEM_RT_STATS) rt_hist_t s_jitter_us;
+static uint32_t s_period_max_us;
+static uint32_t s_late_ticks;
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+
+/* firing_task's own bookkeeping between begin and end. */
+static uint32_t s_tick_start_cycles;
+static int64_t s_last_wake_us;
+
+static esp_timer_handle_t s_timer;
+static bool s_initialized;
+
+static configRUN_TIME_COUNTER_TYPE prev_run_of(TaskHandle_t handle, bool *found)
+{
+    for (int i = 0; i < s_prev_count; i++) {
+        if (s_prev[i].handle == handle) {
+            *found = true;
+            return s_prev[i].run;
+        }
+    }
+    *found = false;
+    return 0;
+}
+
+static float pct_of(configRUN_TIME_COUNTER_TYPE part, configRUN_TIME_COUNTER_TYPE whole)
+{
+    float pct = whole ? 100.0f * (float)part / (float)whole : 0.0f;
+    return pct > 100.0f ? 100.0f : pct;
+}
+
+static void sample_window(void *arg)
+{
+    (void)arg;
+    configRUN_TIME_COUNTER_TYPE total = 0;
+    UBaseType_t n = uxTaskGetSystemState(s_status, RT_STATS_MAX_TASKS, &total);
+    if (n == 0) {
+        if (!s_warned_full) {
+            ESP_LOGW(TAG, "more than %d tasks; raise RT_STATS_MAX_TASKS", RT_STATS_MAX_TASKS);
+            s_warned_full = true;
+        }
+        return;
+    }
+    int64_t now_us = esp_timer_get_time();
+    configRUN_TIME_COUNTER_TYPE elapsed = total - s_prev_total;
+
+    for (UBaseType_t i = 0; i < n; i++) {
+        const TaskStatus_t *st = &s_status[i];
+        rt_task_stat_t *t = &s_next[i];
+        strncpy(t->name, st->pcTaskName, RT_STATS_NAME_LEN - 1);
+        t->name[RT_STATS_NAME_LEN - 1] = '\0';
+        t->core = st->xCoreID == tskNO_AFFINITY ? -1 : (int8_t)st->xCoreID;
+        t->priority = (uint8_t)st->uxCurrentPriority;
+        t->stack_free = st->usStackHighWaterMark; /* bytes: StackType_t is a byte on ESP-IDF */
+        t->stack_size = (uint32_t)mem_budget_task_stack(st->xHandle);
+        bool found;
+        configRUN_TIME_COUNTER_TYPE prev = prev_run_of(st->xHandle, &found);
+        t->cpu_pct = s_have_prev && found ? pct_of(st->ulRunTimeCounter - prev, elapsed) : 0.0f;
+    }
+
+    float load[RT_STATS_MAX_CORES] = {0};
+    int cores = 0;
+    for (int c = 0; c < portNUM_PROCESSORS && c < RT_STATS_MAX_CORES; c++) {
+        TaskHandle_t idle = xTaskGetIdleTaskHandleForCore(c);
+        if (!idle) {
+            break;
+        }
+        for (UBaseType_t i = 0; i < n; i++) {
+            if (s_status[i].xHandle == idle) {
+                load[c] = 100.0f - s_next[i].cpu_pct;
+            }
+        }
+        cores++;
+    }
+
+    portENTER_CRITICAL(&s_mux);
+    if (s_have_prev) {
+        memcpy(s_tasks, s_next, n * sizeof(s_next[0]));
+        s_task_count = (int)n;
+        memcpy(s_core_load, load, sizeof(load));
+        s_core_count = cores;
+        s_window_ms = (uint32_t)((now_us - s_prev_sample_us) / 1000);
+    }
+    portEXIT_CRITICAL(&s_mux);
+
+    for (UBaseType_t i = 0; i < n; i++) {
+        s_prev[i] = (prev_run_t){.handle = s_status[i].xHandle, .run = s_status[i].ulRunTimeCounter};
+    }
+    s_prev_count = (int)n;
+    s_prev_total = total;
+    s_prev_sample_us = now_us;
+    s_have_prev = true;
+}
+
+void rt_stats_init(void)
+{
+    if (s_initialized) {
+        return;
+    }
+    sample_window(NULL); /* baseline, so the first timer firing publishes a full window */
+    const esp_timer_create_args_t args = {
+        .callback = sample_window,
+        .name = "rt_stats",
+    };
+    if (esp_timer_create(&args, &s_timer) != ESP_OK ||
+        esp_timer_start_periodic(s_timer, (uint64_t)APP_RT_STATS_WINDOW_MS * 1000) != ESP_OK) {
+        ESP_LOGE(TAG, "window timer not started; task load will read 0");
+    }
+    s_initialized = true;
+    mem_budget_add("rt_stats", "task samples", APP_MEM_RT_STATS,
+                   sizeof(s_status) + sizeof(s_prev) + sizeof(s_next) + sizeof(s_tasks));
+    mem_budget_add("rt_stats", "tick histograms", APP_MEM_RT_STATS, sizeof(s_tick_us) + sizeof(s_jitter_us));
+}
+
+void rt_stats_tick_begin(void)
+{
+    int64_t now_us = esp_timer_get_time();
+    if (s_last_wake_us != 0) {
+        int64_t period = now_us - s_last_wake_us;
+        int64_t off = period > TICK_PERIOD_US ? period - TICK_PERIOD_US : TICK_PERIOD_US - period;
+        uint32_t period_us = period > UINT32_MAX ? UINT32_MAX : (uint32_t)period;
+        portENTER_CRITICAL(&s_mux);
+        rt_hist_add(&s_jitter_us, off > UINT32_MAX ? UINT32_MAX : (uint32_t)off);
+        if (period_us > s_period_max_us) {
+            s_period_max_us = period_us;
+        }
+        if (period_us > LATE_PERIOD_US) {
+            s_late_ticks++;
+        }
+        portEXIT_CRITICAL(&s_mux);
+    }
+    s_last_wake_us = now_us;
+    s_tick_start_cycles = esp_cpu_get_cycle_count();
+}
+
+void rt_stats_tick_end(void)
+{
+    /* firing_task is pinned, so both reads come from the same core's counter;
+       unsigned subtraction absorbs one wrap (~17 s at 240 MHz). */
+    uint32_t cycles = esp_cpu_get_cycle_count() - s_tick_start_cycles;
+    portENTER_CRITICAL(&s_mux);
+    rt_hist_add(&s_tick_us, cycles / CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+    portEXIT_CRITICAL(&s_mux);
+}
+
+void rt_stats_snapshot(rt_stats_snapshot_t *out)
+{
+    out->uptime_s = (uint32_t)(esp_timer_get_time() / 1000000);
+    portENTER_CRITICAL(&s_mux);
+    out->window_ms = s_window_ms;
+    out->core_count = s_core_count;
+    memcpy(out->core_load_pct, s_core_load, sizeof(s_core_load));
+    out->task_count = s_task_count;
+    memcpy(out->tasks, s_tasks, s_task_count * sizeof(s_tasks[0]));
+    out->tick_us = s_tick_us;
+    out->jitter_us = s_jitter_us;
+    out->period_max_us = s_period_max_us;
+    out->ticks_over_deadline = s_late_ticks;
+    portEXIT_CRITICAL(&s_mux);
+}
@@ -1,6 +1,7 @@
 #include "safety.h"
 #include "thermocouple.h"
 #include "app_config.h"
+#include "mem_budget.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "driver/gpio.h"
@@ -35,6 +36,7 @@ static float s_max_safe_temp = 1300.0f;
 static float s_tc_offset_c = 0.0f;
 static safety_trip_cause_t s_trip_cause = SAFETY_TRIP_NONE;
 static EventGroupHandle_t s_event_group;
+static MEM_PLACE(APP_MEM_KERNEL_OBJECTS) StaticEventGroup_t s_event_group_buf;
 static portMUX_TYPE s_safety_mux = portMUX_INITIALIZER_UNLOCKED;
 
 /* Time-proportional SSR state */
@@ -175,10 +177,11 @@ esp_err_t safety_init(int ssr_pin, float max_safe_temp)
 
     gpio_set_level(ssr_pin, 0);
 
-    s_event_group = xEventGroupCreate();
+    s_event_group = xEventGroupCreateStatic(&s_event_group_buf);
     if (!s_event_group) {
         return ESP_ERR_NO_MEM;
     }
+    mem_budget_add("safety", "event group", APP_MEM_KERNEL_OBJECTS, sizeof(s_event_group_buf));
 
     /* Periodic timer that re-applies the time-proportional SSR window. */
     const esp_timer_create_args_t ssr_timer_args = {
@@ -32,7 +32,8 @@ esp_err_t thermocouple_init(spi_host_device_t host, int cs_pin);
 
 /**
  * Perform a single SPI read of the MAX31855 and populate `out`.
- * Thread-safe: acquires internal spinlock.
+ * Takes the shared SPI bus for the read, so it waits at most for the LCD
+ * transaction in flight, not for a whole queued redraw.
  */
 esp_err_t thermocouple_read(thermocouple_reading_t *out);
 
@@ -42,6 +43,22 @@ esp_err_t thermocouple_read(thermocouple_reading_t *out);
  */
 void thermocouple_get_latest(thermocouple_reading_t *out);
 
+/* How the MAX31855 reads fared on the SPI bus they share with the LCD. Waits
+ * for the bus are time the display's DMA held it; jitter is how far apart
+ * consecutive samples landed from the 250 ms period. Counters run from
+ * thermocouple_init(). */
+typedef struct {
+    uint32_t reads;           /* successful SPI reads */
+    uint32_t bus_waits;       /* reads that found the bus busy */
+    int64_t max_bus_wait_us;  /* longest wait to acquire the bus */
+    int64_t max_read_us;      /* longest request-to-data time, bus wait included */
+    uint32_t intervals;       /* sample-to-sample intervals measured */
+    int64_t max_jitter_us;    /* largest |interval - 250 ms| */
+    int64_t total_jitter_us;  /* sum of |interval - 250 ms|, for the mean */
+} thermocouple_timing_t;
+
+void thermocouple_get_timing(thermocouple_timing_t *out);
+
 /**
  * FreeRTOS task that reads the thermocouple at ~250ms intervals.
  * Pass NULL as parameter.
@@ -10,6 +10,9 @@ static const char *TAG = "thermocouple";
 static spi_device_handle_t s_spi_dev;
 static portMUX_TYPE s_reading_mux = portMUX_INITIALIZER_UNLOCKED;
 static thermocouple_reading_t s_latest_reading;
+static thermocouple_timing_t s_timing; /* guarded by s_reading_mux */
+
+#define TC_READ_PERIOD_MS 250
 
 esp_err_t thermocouple_init(spi_host_device_t host, int cs_pin)
 {
@@ -31,6 +34,7 @@ esp_err_t thermocouple_init(spi_host_device_t host, int cs_pin)
     /* Initialize cached reading */
     memset(&s_latest_reading, 0, sizeof(s_latest_reading));
     s_latest_reading.temperature_c = 0.0f;
+    memset(&s_timing, 0, sizeof(s_timing));
 
     ESP_LOGI(TAG, "MAX31855 initialized on CS pin %d", cs_pin);
     return ESP_OK;
@@ -44,7 +48,21 @@ esp_err_t thermocouple_read(thermocouple_reading_t *out)
         .rx_buffer = rx_buf,
     };
 
-    esp_err_t ret = spi_device_transmit(s_spi_dev, &txn);
+    /* The LCD shares this bus and streams each flush as a run of DMA
+     * transactions (APP_SPI_MAX_TRANSFER_SZ each). Acquiring the bus puts the
+     * display's queue on hold at the next transaction boundary, so the wait is
+     * bounded by one chunk however much of the screen is being redrawn; the
+     * 32-bit read then goes out by polling, without a trip through the SPI
+     * ISR. */
+    int64_t requested_us = esp_timer_get_time();
+    esp_err_t ret = spi_device_acquire_bus(s_spi_dev, portMAX_DELAY);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "SPI bus acquire failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    int64_t acquired_us = esp_timer_get_time();
+    ret = spi_device_polling_transmit(s_spi_dev, &txn);
+    spi_device_release_bus(s_spi_dev);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "SPI read failed: %s", esp_err_to_name(ret));
         return ret;
@@ -56,6 +74,21 @@ esp_err_t thermocouple_read(thermocouple_reading_t *out)
     out->timestamp_us = esp_timer_get_time();
     out->fault = 0;
 
+    int64_t bus_wait_us = acquired_us - requested_us;
+    int64_t read_us = out->timestamp_us - requested_us;
+    portENTER_CRITICAL(&s_reading_mux);
+    s_timing.reads++;
+    if (bus_wait_us > 0) {
+        s_timing.bus_waits++;
+    }
+    if (bus_wait_us > s_timing.max_bus_wait_us) {
+        s_timing.max_bus_wait_us = bus_wait_us;
+    }
+    if (read_us > s_timing.max_read_us) {
+        s_timing.max_read_us = read_us;
+    }
+    portEXIT_CRITICAL(&s_reading_mux);
+
     /* Check fault bit (D16) */
     if (raw & (1 << 16)) {
         if (raw & (1 << 0)) {
@@ -97,10 +130,36 @@ void thermocouple_get_latest(thermocouple_reading_t *out)
     portEXIT_CRITICAL(&s_reading_mux);
 }
 
+void thermocouple_get_timing(thermocouple_timing_t *out)
+{
+    portENTER_CRITICAL(&s_reading_mux);
+    *out = s_timing;
+    portEXIT_CRITICAL(&s_reading_mux);
+}
+
+/* Spacing of consecutive samples against the nominal period. Only back-to-back
+ * successful reads count, so a failed read is left out of `intervals` rather than
+ * counted as one 500 ms interval. */
+static void record_interval(int64_t prev_us, int64_t now_us)
+{
+    int64_t jitter_us = (now_us - prev_us) - (int64_t)TC_READ_PERIOD_MS * 1000;
+    if (jitter_us < 0) {
+        jitter_us = -jitter_us;
+    }
+    portENTER_CRITICAL(&s_reading_mux);
+    s_timing.intervals++;
+    s_timing.total_jitter_us += jitter_us;
+    if (jitter_us > s_timing.max_jitter_us) {
+        s_timing.max_jitter_us = jitter_us;
+    }
+    portEXIT_CRITICAL(&s_reading_mux);
+}
+
 void temp_read_task(void *param)
 {
     (void)param;
     thermocouple_reading_t reading;
+    int64_t prev_sample_us = -1;
     TickType_t last_wake = xTaskGetTickCount();
 
     ESP_LOGI(TAG, "temp_read_task started");
@@ -110,11 +169,17 @@ void temp_read_task(void *param)
             portENTER_CRITICAL(&s_reading_mux);
             s_latest_reading = reading;
             portEXIT_CRITICAL(&s_reading_mux);
+            if (prev_sample_us >= 0) {
+                record_interval(prev_sample_us, reading.timestamp_us);
+            }
+            prev_sample_us = reading.timestamp_us;
 
             if (reading.fault == 0) {
                 ESP_LOGD(TAG, "Temp: %.1f°C (internal: %.1f°C)", reading.temperature_c, reading.internal_temp_c);
             }
+        } else {
+            prev_sample_us = -1;
         }
-        xTaskDelayUntil(&last_wake, pdMS_TO_TICKS(250));
+        xTaskDelayUntil(&last_wake, pdMS_TO_TICKS(TC_READ_PERIOD_MS));
     }
 }
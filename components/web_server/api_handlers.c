@@ -1,6 +1,8 @@
 #include "web_server.h"
 #include "api_json.h"
+#include "http_arena.h"
 #include "firing_engine.h"
+#include "profile_optimizer.h"
 #include "firing_types.h"
 #include "thermocouple.h"
 #include "pid_control.h"
@@ -8,6 +10,8 @@
 #include "cone_table.h"
 #include "firing_history.h"
 #include "wifi_manager.h"
+#include "log_capture.h"
+#include "rt_stats.h"
 #include "app_config.h"
 #include "esp_log.h"
 #include "esp_timer.h"
@@ -19,6 +23,7 @@
 #include "esp_system.h"
 #include "driver/temperature_sensor.h"
 #include <inttypes.h>
+#include <time.h>
 #include "cJSON.h"
 #include <string.h>
 #include <stdlib.h>
@@ -29,6 +34,23 @@ static const char *TAG = "api";
 /* ── Internal temperature sensor ──────────────────── */
 static temperature_sensor_handle_t s_board_temp_handle = NULL;
 
+/* ── Route table ───────────────────────────────────── */
+
+/* One entry per registered endpoint. httpd calls handle_route() for all of
+   them with the entry as user_ctx, so each request runs on an arena and its
+   usage lands in the route's stats. Written only from the httpd task. */
+#define API_MAX_ROUTES 48
+
+typedef struct {
+    const char *uri;
+    httpd_method_t method;
+    esp_err_t (*fn)(httpd_req_t *req);
+    http_arena_stats_t arena;
+} api_route_t;
+
+static api_route_t s_routes[API_MAX_ROUTES];
+static int s_route_count;
+
 /* ── Auth helpers ──────────────────────────────────── */
 
 /**
@@ -119,7 +141,7 @@ void send_webhook_event(const char *event, const char *profile_name, float peak_
         }
         esp_http_client_cleanup(client);
     }
-    free(json);
+    cJSON_free(json);
 }
 
 /* Helper: read POST body into buffer. Returns length or -1 on error. */
@@ -165,7 +187,7 @@ static cJSON *parse_body_json(httpd_req_t *req, char *buf, size_t buf_size)
 /* Helper: send JSON response */
 static esp_err_t send_json(httpd_req_t *req, cJSON *root)
 {
-    char *json = cJSON_PrintUnformatted(root);
+    char *json = http_arena_print(root);
     cJSON_Delete(root);
     if (!json) {
         httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "JSON error");
@@ -173,73 +195,10 @@ static esp_err_t send_json(httpd_req_t *req, cJSON *root)
     }
     httpd_resp_set_type(req, "application/json");
     httpd_resp_sendstr(req, json);
-    free(json);
+    cJSON_free(json);
     return ESP_OK;
 }
 
-/* ── Profile parsing helper (inverse of build_profile_json) ──────────── */
-
-static bool profile_from_json(cJSON *root, firing_profile_t *out)
-{
-    memset(out, 0, sizeof(*out));
-
-    cJSON *j;
-    j = cJSON_GetObjectItem(root, "id");
-    if (j && j->valuestring) {
-        strncpy(out->id, j->valuestring, FIRING_ID_LEN - 1);
-    }
-    j = cJSON_GetObjectItem(root, "name");
-    if (j && j->valuestring) {
-        strncpy(out->name, j->valuestring, FIRING_NAME_LEN - 1);
-    }
-    j = cJSON_GetObjectItem(root, "description");
-    if (j && j->valuestring) {
-        strncpy(out->description, j->valuestring, FIRING_DESC_LEN - 1);
-    }
-    j = cJSON_GetObjectItem(root, "maxTemp");
-    if (j) {
-        out->max_temp = (float)j->valuedouble;
-    }
-    j = cJSON_GetObjectItem(root, "estimatedDuration");
-    if (j) {
-        out->estimated_duration = (uint32_t)j->valuedouble;
-    }
-
-    cJSON *segs = cJSON_GetObjectItem(root, "segments");
-    if (segs && cJSON_IsArray(segs)) {
-        int count = cJSON_GetArraySize(segs);
-        if (count > FIRING_MAX_SEGMENTS) {
-            count = FIRING_MAX_SEGMENTS;
-        }
-        out->segment_count = count;
-        for (int i = 0; i < count; i++) {
-            cJSON *seg = cJSON_GetArrayItem(segs, i);
-            j = cJSON_GetObjectItem(seg, "id");
-            if (j && j->valuestring) {
-                strncpy(out->segments[i].id, j->valuestring, FIRING_ID_LEN - 1);
-            }
-            j = cJSON_GetObjectItem(seg, "name");
-            if (j && j->valuestring) {
-                strncpy(out->segments[i].name, j->valuestring, FIRING_NAME_LEN - 1);
-            }
-            j = cJSON_GetObjectItem(seg, "rampRate");
-            if (j) {
-                out->segments[i].ramp_rate = (float)j->valuedouble;
-            }
-            j = cJSON_GetObjectItem(seg, "targetTemp");
-            if (j) {
-                out->segments[i].target_temp = (float)j->valuedouble;
-            }
-            j = cJSON_GetObjectItem(seg, "holdTime");
-            if (j) {
-                out->segments[i].hold_time = (uint16_t)j->valuedouble;
-            }
-        }
-    }
-
-    return out->id[0] != '\0';
-}
-
 /* Validate a profile is safe to fire: bounded segments, finite/in-range
    targets and ramp rates. Writes a human-readable reason into err on
    failure. Returns true if the profile is acceptable. */
@@ -268,6 +227,10 @@ static bool validate_profile(const firing_profile_t *p, char *err, size_t errlen
             snprintf(err, errlen, "Segment %u: invalid ramp_rate", i);
             return false;
         }
+        if (s->end_cone > CONE_COUNT) {
+            snprintf(err, errlen, "Segment %u: unknown endConeId", i);
+            return false;
+        }
     }
     /* Ramp direction must match each segment's target relative to where it
        begins. Segment 0's start is the (unknown-at-save-time) kiln temperature,
@@ -378,6 +341,19 @@ static esp_err_t handle_get_profile(httpd_req_t *req)
 
 /* ── POST /api/v1/profiles ─────────────────────────── */
 
+/* Save response: the id, plus any ramps the kiln has shown it can't keep up
+   with. Saving still succeeds — the profile fires, just slower than written. */
+static esp_err_t send_profile_saved(httpd_req_t *req, const firing_profile_t *profile)
+{
+    kiln_cap_t cap;
+    firing_engine_get_capability(&cap);
+    cJSON *resp = cJSON_CreateObject();
+    cJSON_AddBoolToObject(resp, "ok", true);
+    cJSON_AddStringToObject(resp, "id", profile->id);
+    cJSON_AddItemToObject(resp, "rampWarnings", build_ramp_warnings_json(profile, &cap));
+    return send_json(req, resp);
+}
+
 static esp_err_t handle_post_profile(httpd_req_t *req)
 {
     if (!require_auth(req)) {
@@ -427,10 +403,7 @@ static esp_err_t handle_post_profile(httpd_req_t *req)
         return ESP_FAIL;
     }
 
-    cJSON *resp = cJSON_CreateObject();
-    cJSON_AddBoolToObject(resp, "ok", true);
-    cJSON_AddStringToObject(resp, "id", profile.id);
-    return send_json(req, resp);
+    return send_profile_saved(req, &profile);
 }
 
 /* ── DELETE /api/v1/profiles/:id ───────────────────── */
@@ -476,49 +449,17 @@ static bool firing_blocked_by_ota(httpd_req_t *req)
 
 /* ── POST /api/v1/firing/start ─────────────────────── */
 
-static esp_err_t handle_firing_start(httpd_req_t *req)
-{
-    if (!require_auth(req)) {
-        return ESP_FAIL;
-    }
-    if (firing_blocked_by_ota(req)) {
-        return ESP_FAIL;
-    }
-    char buf[128];
-    cJSON *root = parse_body_json(req, buf, sizeof(buf));
-    if (!root) {
-        return ESP_FAIL;
-    }
-
-    /* Parse delay_minutes (optional) */
-    uint32_t delay_minutes = 0;
-    const cJSON *delay_item = cJSON_GetObjectItem(root, "delayMinutes");
-    if (delay_item) {
-        double dm = delay_item->valuedouble;
-        const uint32_t max_delay = 7u * 24u * 60u; /* 7 days */
-        if (!isfinite(dm) || dm < 0.0 || dm > (double)max_delay) {
-            cJSON_Delete(root);
-            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "delayMinutes out of range");
-            return ESP_FAIL;
-        }
-        delay_minutes = (uint32_t)dm;
-    }
-
-    cJSON *pid_item = cJSON_GetObjectItem(root, "profileId");
-    if (!pid_item || !pid_item->valuestring) {
-        cJSON_Delete(root);
-        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Missing profileId");
-        return ESP_FAIL;
-    }
-
-    firing_profile_t profile;
-    if (firing_engine_load_profile(pid_item->valuestring, &profile) != ESP_OK) {
-        cJSON_Delete(root);
-        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "Profile not found");
-        return ESP_FAIL;
-    }
-    cJSON_Delete(root);
+/* Longest a START may be delayed: a week. */
+#define START_MAX_DELAY_MIN (7u * 24u * 60u)
 
+/*
+ * Queue a START of `profile` after the checks every start gets: nothing
+ * active or armed, no relay test, a valid profile and, when it starts now, a
+ * first ramp that heads the right way from the live reading. Sends the error
+ * response and returns false if refused.
+ */
+static bool queue_start(httpd_req_t *req, const firing_profile_t *profile, uint32_t delay_minutes)
+{
     /* Reject if a firing (or armed delay) is already active. */
     firing_progress_t prog;
     firing_engine_get_progress(&prog);
@@ -527,7 +468,7 @@ static esp_err_t handle_firing_start(httpd_req_t *req)
         httpd_resp_set_type(req, "text/plain");
         const char *msg = "Firing already active";
         httpd_resp_send(req, msg, HTTPD_RESP_USE_STRLEN);
-        return ESP_FAIL;
+        return false;
     }
     /* A relay diagnostic holds the SSR but reports is_active == false; the
        engine would drop a queued START, so reject here for a real 409 instead
@@ -536,13 +477,13 @@ static esp_err_t handle_firing_start(httpd_req_t *req)
         httpd_resp_set_status(req, "409 Conflict");
         httpd_resp_set_type(req, "text/plain");
         httpd_resp_send(req, "Relay test in progress", HTTPD_RESP_USE_STRLEN);
-        return ESP_FAIL;
+        return false;
     }
 
     char err[96];
-    if (!validate_profile(&profile, err, sizeof(err))) {
+    if (!validate_profile(profile, err, sizeof(err))) {
         httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, err);
-        return ESP_FAIL;
+        return false;
     }
 
     /* validate_profile() cannot judge segment 0's ramp direction — it has no
@@ -557,21 +498,69 @@ static esp_err_t handle_firing_start(httpd_req_t *req)
         thermocouple_get_latest(&start_tc);
         kiln_settings_t start_settings;
         firing_engine_get_settings(&start_settings);
-        int bad_seg = firing_first_bad_ramp_sign(&profile, start_tc.temperature_c + start_settings.tc_offset_c);
+        int bad_seg = firing_first_bad_ramp_sign(profile, start_tc.temperature_c + start_settings.tc_offset_c);
         if (bad_seg >= 0) {
             snprintf(err, sizeof(err), "Segment %d: ramp direction contradicts its target at the current temperature",
                      bad_seg);
             httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, err);
-            return ESP_FAIL;
+            return false;
         }
     }
 
-    firing_cmd_t cmd = {.type = FIRING_CMD_START};
-    cmd.start.profile = profile;
+    firing_cmd_t cmd = {.type = FIRING_CMD_START, .source = FIRING_SRC_API};
+    cmd.start.profile = *profile;
     cmd.start.delay_minutes = delay_minutes;
     QueueHandle_t q = firing_engine_get_cmd_queue();
     if (xQueueSend(q, &cmd, pdMS_TO_TICKS(100)) != pdTRUE) {
         httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Queue full");
+        return false;
+    }
+    return true;
+}
+
+static esp_err_t handle_firing_start(httpd_req_t *req)
+{
+    if (!require_auth(req)) {
+        return ESP_FAIL;
+    }
+    if (firing_blocked_by_ota(req)) {
+        return ESP_FAIL;
+    }
+    char buf[128];
+    cJSON *root = parse_body_json(req, buf, sizeof(buf));
+    if (!root) {
+        return ESP_FAIL;
+    }
+
+    /* Parse delay_minutes (optional) */
+    uint32_t delay_minutes = 0;
+    const cJSON *delay_item = cJSON_GetObjectItem(root, "delayMinutes");
+    if (delay_item) {
+        double dm = delay_item->valuedouble;
+        if (!isfinite(dm) || dm < 0.0 || dm > (double)START_MAX_DELAY_MIN) {
+            cJSON_Delete(root);
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "delayMinutes out of range");
+            return ESP_FAIL;
+        }
+        delay_minutes = (uint32_t)dm;
+    }
+
+    cJSON *pid_item = cJSON_GetObjectItem(root, "profileId");
+    if (!pid_item || !pid_item->valuestring) {
+        cJSON_Delete(root);
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Missing profileId");
+        return ESP_FAIL;
+    }
+
+    firing_profile_t profile;
+    if (firing_engine_load_profile(pid_item->valuestring, &profile) != ESP_OK) {
+        cJSON_Delete(root);
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "Profile not found");
+        return ESP_FAIL;
+    }
+    cJSON_Delete(root);
+
+    if (!queue_start(req, &profile, delay_minutes)) {
         return ESP_FAIL;
     }
 
@@ -587,7 +576,7 @@ static esp_err_t handle_firing_stop(httpd_req_t *req)
     if (!require_auth(req)) {
         return ESP_FAIL;
     }
-    firing_cmd_t cmd = {.type = FIRING_CMD_STOP};
+    firing_cmd_t cmd = {.type = FIRING_CMD_STOP, .source = FIRING_SRC_API};
     xQueueSend(firing_engine_get_cmd_queue(), &cmd, pdMS_TO_TICKS(100));
 
     cJSON *resp = cJSON_CreateObject();
@@ -605,7 +594,7 @@ static esp_err_t handle_firing_pause(httpd_req_t *req)
     firing_progress_t prog;
     firing_engine_get_progress(&prog);
 
-    firing_cmd_t cmd;
+    firing_cmd_t cmd = {.source = FIRING_SRC_API};
     cmd.type = (prog.status == FIRING_STATUS_PAUSED) ? FIRING_CMD_RESUME : FIRING_CMD_PAUSE;
     xQueueSend(firing_engine_get_cmd_queue(), &cmd, pdMS_TO_TICKS(100));
 
@@ -634,7 +623,7 @@ static esp_err_t handle_post_settings(httpd_req_t *req)
     if (!require_auth(req)) {
         return ESP_FAIL;
     }
-    char buf[768];
+    char buf[1024];
     cJSON *root = parse_body_json(req, buf, sizeof(buf));
     if (!root) {
         return ESP_FAIL;
@@ -698,6 +687,12 @@ static esp_err_t handle_post_settings(httpd_req_t *req)
     if (j) {
         settings.electricity_cost_kwh = (float)j->valuedouble;
     }
+    j = cJSON_GetObjectItem(root, "tariff");
+    if (j && !tariff_from_json(j, &settings)) {
+        cJSON_Delete(root);
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Bad tariff: up to 8 bands, each a distinct startMin 0-1439");
+        return ESP_FAIL;
+    }
 
     cJSON_Delete(root);
 
@@ -747,7 +742,7 @@ static esp_err_t handle_firing_skip_segment(httpd_req_t *req)
     if (!require_auth(req)) {
         return ESP_FAIL;
     }
-    firing_cmd_t cmd = {.type = FIRING_CMD_SKIP_SEGMENT};
+    firing_cmd_t cmd = {.type = FIRING_CMD_SKIP_SEGMENT, .source = FIRING_SRC_API};
     xQueueSend(firing_engine_get_cmd_queue(), &cmd, pdMS_TO_TICKS(100));
 
     cJSON *resp = cJSON_CreateObject();
@@ -806,10 +801,7 @@ static esp_err_t handle_profile_import(httpd_req_t *req)
         return ESP_FAIL;
     }
 
-    cJSON *resp = cJSON_CreateObject();
-    cJSON_AddBoolToObject(resp, "ok", true);
-    cJSON_AddStringToObject(resp, "id", profile.id);
-    return send_json(req, resp);
+    return send_profile_saved(req, &profile);
 }
 
 /* ── POST /api/v1/profiles/cone-fire ──────────────── */
@@ -880,6 +872,277 @@ static esp_err_t handle_cone_fire(httpd_req_t *req)
     return send_json(req, build_profile_json(&profile));
 }
 
+/* ── POST /api/v1/profiles/optimize ───────────────── */
+
+/* Body: a saved "profileId" or an inline "profile", plus optional limits (see
+   profile_opt_limits_from_json). Replies with the fastest schedule and the
+   plan for both; nothing is saved — the client saves the result if it wants
+   it. */
+static esp_err_t handle_profile_optimize(httpd_req_t *req)
+{
+    if (!require_auth(req)) {
+        return ESP_FAIL;
+    }
+    char buf[2560];
+    cJSON *root = parse_body_json(req, buf, sizeof(buf));
+    if (!root) {
+        return ESP_FAIL;
+    }
+
+    firing_profile_t profile;
+    const cJSON *id = cJSON_GetObjectItem(root, "profileId");
+    cJSON *inline_profile = cJSON_GetObjectItem(root, "profile");
+    bool found = false;
+    if (cJSON_IsString(id)) {
+        found = firing_engine_load_profile(id->valuestring, &profile) == ESP_OK;
+    } else if (cJSON_IsObject(inline_profile)) {
+        found = profile_from_json(inline_profile, &profile);
+    }
+    profile_opt_limits_t limits;
+    profile_opt_default_limits(&limits);
+    bool limits_ok = profile_opt_limits_from_json(root, &limits);
+    cJSON_Delete(root);
+
+    if (!found) {
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "Profile not found");
+        return ESP_FAIL;
+    }
+    if (!limits_ok) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid limits");
+        return ESP_FAIL;
+    }
+    char verr[96];
+    if (!validate_profile(&profile, verr, sizeof(verr))) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, verr);
+        return ESP_FAIL;
+    }
+
+    kiln_cap_t cap;
+    firing_engine_get_capability(&cap);
+    kiln_settings_t settings;
+    firing_engine_get_settings(&settings);
+
+    firing_profile_t fast;
+    profile_optimize(&profile, &limits, &cap, &fast);
+    profile_plan_t before;
+    profile_plan_t after;
+    profile_plan(&profile, limits.start_temp_c, &cap, &before);
+    profile_plan(&fast, limits.start_temp_c, &cap, &after);
+
+    cJSON *resp = cJSON_CreateObject();
+    cJSON_AddItemToObject(resp, "profile", build_profile_json(&fast));
+    cJSON_AddItemToObject(resp, "original", build_plan_json(&before, settings.element_watts));
+    cJSON_AddItemToObject(resp, "optimized", build_plan_json(&after, settings.element_watts));
+    cJSON_AddNumberToObject(resp, "savedS", (double)before.duration_s - (double)after.duration_s);
+    return send_json(req, resp);
+}
+
+/* ── POST /api/v1/profiles/:id/simulate ───────────── */
+
+/* Longest a dry run may keep the request waiting; a day-long firing takes a
+   fraction of this on the simulation worker. */
+#define SIM_TIMEOUT_MS 10000
+
+/* Optional body {"startTemp"}; without it the run starts from the kiln as it
+   is now. Fires the saved profile against the kiln model on the simulation
+   worker and replies with the prediction (build_sim_json). */
+static esp_err_t handle_profile_simulate(httpd_req_t *req)
+{
+    if (!require_auth(req)) {
+        return ESP_FAIL;
+    }
+    const char *id_start = req->uri + strlen("/api/v1/profiles/");
+    const char *suffix = strstr(id_start, "/simulate");
+    size_t id_len = suffix ? (size_t)(suffix - id_start) : 0;
+    if (id_len == 0 || id_len >= FIRING_ID_LEN || (suffix[9] != '\0' && suffix[9] != '?')) {
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "Not found");
+        return ESP_FAIL;
+    }
+    char id[FIRING_ID_LEN];
+    memcpy(id, id_start, id_len);
+    id[id_len] = '\0';
+
+    float start_temp = NAN;
+    if (req->content_len > 0) {
+        char buf[128];
+        cJSON *root = parse_body_json(req, buf, sizeof(buf));
+        if (!root) {
+            return ESP_FAIL;
+        }
+        const cJSON *j = cJSON_GetObjectItem(root, "startTemp");
+        if (cJSON_IsNumber(j)) {
+            start_temp = (float)j->valuedouble;
+        }
+        cJSON_Delete(root);
+    }
+
+    firing_profile_t profile;
+    if (firing_engine_load_profile(id, &profile) != ESP_OK) {
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "Profile not found");
+        return ESP_FAIL;
+    }
+    kiln_settings_t settings;
+    firing_engine_get_settings(&settings);
+    if (isnan(start_temp)) {
+        thermocouple_reading_t tc;
+        thermocouple_get_latest(&tc);
+        if (tc.fault != 0) {
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "No temperature reading; give a startTemp");
+            return ESP_FAIL;
+        }
+        start_temp = tc.temperature_c + settings.tc_offset_c;
+    }
+
+    kiln_cap_t cap;
+    firing_engine_get_capability(&cap);
+    firing_sim_config_t cfg = {.start_temp_c = start_temp};
+    pid_load_gains(&cfg.kp, &cfg.ki, &cfg.kd);
+    firing_sim_result_t sim;
+    if (sim_task_run(&profile, &cap, &cfg, &sim, SIM_TIMEOUT_MS) != ESP_OK) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_set_type(req, "text/plain");
+        httpd_resp_sendstr(req, "Simulation did not finish in time; try again");
+        return ESP_FAIL;
+    }
+    return send_json(req, build_sim_json(&sim, settings.element_watts, settings.electricity_cost_kwh));
+}
+
+/* ── POST /api/v1/firing/schedule ──────────────────── */
+
+/* Before this the clock is still the epoch's: SNTP has not set it yet. */
+#define CLOCK_SET_S 1700000000
+
+/* Furthest a tariff's local time may be from UTC, in minutes. */
+#define MAX_UTC_OFFSET_MIN (14 * 60)
+
+/*
+ * Body {profileId, startAfter?, finishBy?, utcOffsetMin?, arm?}: times in Unix
+ * seconds, utcOffsetMin how far the tariff's local time is ahead of UTC (the
+ * browser sends its own). Dry-runs the profile from the kiln as it is now,
+ * takes the start between startAfter (or now) and the latest that still
+ * finishes by finishBy (or TARIFF_HORIZON_S on) that costs least under the
+ * tariff and, unless arm is false, queues it as a delayed START. Replies with
+ * the plan (build_schedule_json).
+ */
+static esp_err_t handle_firing_schedule(httpd_req_t *req)
+{
+    if (!require_auth(req)) {
+        return ESP_FAIL;
+    }
+    if (firing_blocked_by_ota(req)) {
+        return ESP_FAIL;
+    }
+    char buf[192];
+    cJSON *root = parse_body_json(req, buf, sizeof(buf));
+    if (!root) {
+        return ESP_FAIL;
+    }
+    int64_t now = (int64_t)time(NULL);
+    int64_t earliest = now;
+    int64_t finish_by = 0;
+    int32_t offset_min = 0;
+    const cJSON *j = cJSON_GetObjectItem(root, "startAfter");
+    if (cJSON_IsNumber(j) && isfinite(j->valuedouble) && j->valuedouble > (double)now) {
+        earliest = (int64_t)ceil(j->valuedouble);
+    }
+    j = cJSON_GetObjectItem(root, "finishBy");
+    if (cJSON_IsNumber(j) && isfinite(j->valuedouble)) {
+        finish_by = (int64_t)j->valuedouble;
+    }
+    j = cJSON_GetObjectItem(root, "utcOffsetMin");
+    if (cJSON_IsNumber(j)) {
+        if (!(fabs(j->valuedouble) <= MAX_UTC_OFFSET_MIN)) {
+            cJSON_Delete(root);
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "utcOffsetMin out of range");
+            return ESP_FAIL;
+        }
+        offset_min = (int32_t)j->valuedouble;
+    }
+    bool arm = !cJSON_IsFalse(cJSON_GetObjectItem(root, "arm"));
+    char id[FIRING_ID_LEN] = "";
+    j = cJSON_GetObjectItem(root, "profileId");
+    if (cJSON_IsString(j)) {
+        strncpy(id, j->valuestring, sizeof(id) - 1);
+    }
+    cJSON_Delete(root);
+    if (!id[0]) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Missing profileId");
+        return ESP_FAIL;
+    }
+    firing_profile_t profile;
+    if (firing_engine_load_profile(id, &profile) != ESP_OK) {
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "Profile not found");
+        return ESP_FAIL;
+    }
+    char err[96];
+    if (!validate_profile(&profile, err, sizeof(err))) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, err);
+        return ESP_FAIL;
+    }
+
+    kiln_settings_t settings;
+    firing_engine_get_settings(&settings);
+    if (settings.element_watts <= 0.0f) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Set the element power to schedule by cost");
+        return ESP_FAIL;
+    }
+    if (now < CLOCK_SET_S) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_set_type(req, "text/plain");
+        httpd_resp_sendstr(req, "Clock not set yet; try again once the controller is online");
+        return ESP_FAIL;
+    }
+    int64_t last_allowed = now + (int64_t)START_MAX_DELAY_MIN * 60;
+    if (earliest > last_allowed) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "startAfter is past the delayed-start limit");
+        return ESP_FAIL;
+    }
+    thermocouple_reading_t tc;
+    thermocouple_get_latest(&tc);
+    if (tc.fault != 0) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "No temperature reading");
+        return ESP_FAIL;
+    }
+
+    /* From the kiln as it is now: a start hours off finds it cooler and runs
+       a little longer, which the plan does not chase. */
+    kiln_cap_t cap;
+    firing_engine_get_capability(&cap);
+    firing_sim_config_t cfg = {.start_temp_c = tc.temperature_c + settings.tc_offset_c};
+    pid_load_gains(&cfg.kp, &cfg.ki, &cfg.kd);
+    firing_sim_result_t sim;
+    if (sim_task_run(&profile, &cap, &cfg, &sim, SIM_TIMEOUT_MS) != ESP_OK) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_set_type(req, "text/plain");
+        httpd_resp_sendstr(req, "Simulation did not finish in time; try again");
+        return ESP_FAIL;
+    }
+    if (sim.outcome != FIRING_SIM_COMPLETE) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Profile has no predicted end on this kiln; dry-run it");
+        return ESP_FAIL;
+    }
+
+    int64_t latest = finish_by ? finish_by - (int64_t)sim.duration_s : earliest + TARIFF_HORIZON_S;
+    if (latest > last_allowed) {
+        latest = last_allowed;
+    }
+    tariff_plan_t plan;
+    if (!tariff_cheapest_start(&settings, &sim, now, earliest, latest, offset_min * 60, &plan)) {
+        snprintf(err, sizeof(err), "Cannot finish by then: the firing takes about %" PRIu32 " h %02" PRIu32 " min",
+                 sim.duration_s / 3600, sim.duration_s / 60 % 60);
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, err);
+        return ESP_FAIL;
+    }
+    uint32_t delay_minutes = (uint32_t)((plan.start_s - now) / 60);
+
+    if (arm && !queue_start(req, &profile, delay_minutes)) {
+        return ESP_FAIL;
+    }
+    ESP_LOGI(TAG, "Schedule for %s: start in %" PRIu32 " min, cost %.2f vs %.2f%s", profile.id, delay_minutes,
+             plan.cost, plan.earliest_cost, arm ? ", armed" : "");
+    return send_json(req, build_schedule_json(&plan, &sim, settings.element_watts, delay_minutes, arm));
+}
+
 /* ── GET /api/v1/history ───────────────────────────── */
 
 static esp_err_t handle_get_history(httpd_req_t *req)
@@ -897,9 +1160,48 @@ static esp_err_t handle_get_history(httpd_req_t *req)
     return send_json(req, arr);
 }
 
+/*
+ * A firing's event journal as a JSON array. Streamed one event per chunk
+ * rather than built as one tree: a journal can hold HISTORY_MAX_EVENTS
+ * entries, far more nodes than a request arena holds.
+ */
+static esp_err_t send_history_events(httpd_req_t *req, uint32_t record_id)
+{
+    FILE *f = history_open_events(record_id);
+    if (!f) {
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "Events not found");
+        return ESP_FAIL;
+    }
+    httpd_resp_set_type(req, "application/json");
+
+    char buf[160];
+    history_event_t evt;
+    bool first = true;
+    while (history_read_event(f, &evt)) {
+        cJSON *item = build_history_event_json(&evt);
+        buf[0] = first ? '[' : ',';
+        bool ok = cJSON_PrintPreallocated(item, buf + 1, sizeof(buf) - 1, false);
+        cJSON_Delete(item);
+        if (!ok) {
+            continue;
+        }
+        if (httpd_resp_send_chunk(req, buf, HTTPD_RESP_USE_STRLEN) != ESP_OK) {
+            fclose(f);
+            httpd_resp_send_chunk(req, NULL, 0);
+            return ESP_FAIL;
+        }
+        first = false;
+    }
+    fclose(f);
+    httpd_resp_send_chunk(req, first ? "[]" : "]", HTTPD_RESP_USE_STRLEN);
+    httpd_resp_send_chunk(req, NULL, 0);
+    return ESP_OK;
+}
+
 /* ── GET /api/v1/history/:id/trace ────────────────── */
+/* ── GET /api/v1/history/:id/events ───────────────── */
 
-static esp_err_t handle_get_history_trace(httpd_req_t *req)
+static esp_err_t handle_get_history_item(httpd_req_t *req)
 {
     if (!require_auth(req)) {
         return ESP_FAIL;
@@ -910,6 +1212,12 @@ static esp_err_t handle_get_history_trace(httpd_req_t *req)
     const char *id_start = req->uri + strlen(prefix);
     uint32_t record_id = (uint32_t)atoi(id_start);
 
+    /* One wildcard route serves both sub-resources; anything but /events is the trace. */
+    const char *sub = strchr(id_start, '/');
+    if (sub && strncmp(sub, "/events", 7) == 0 && (sub[7] == '\0' || sub[7] == '?')) {
+        return send_history_events(req, record_id);
+    }
+
     FILE *f = history_open_trace(record_id);
     if (!f) {
         httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "Trace not found");
@@ -1202,8 +1510,273 @@ static esp_err_t handle_diag_thermocouple(httpd_req_t *req)
 
     kiln_settings_t settings;
     firing_engine_get_settings(&settings);
+    thermocouple_timing_t timing;
+    thermocouple_get_timing(&timing);
+
+    return send_json(req, build_thermocouple_diag_json(&tc, age_ms, settings.tc_offset_c, &timing));
+}
+
+/* ── GET /api/v1/diagnostics/capability ───────────── */
+
+static esp_err_t handle_diag_capability(httpd_req_t *req)
+{
+    if (!require_auth(req)) {
+        return ESP_FAIL;
+    }
+    kiln_cap_t cap;
+    firing_engine_get_capability(&cap);
+    return send_json(req, build_capability_json(&cap));
+}
+
+/* ── GET /api/v1/diagnostics/firing-record ────────── */
+
+/* Latest firing's input recording (CONFIG_FIRING_RECORD), for replay with
+   tests/host/bisque_replay. 404 when recording is off or nothing was fired. */
+static esp_err_t handle_diag_firing_record(httpd_req_t *req)
+{
+    if (!require_auth(req)) {
+        return ESP_FAIL;
+    }
+
+    FILE *f = firing_engine_open_record();
+    if (!f) {
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "No firing record");
+        return ESP_FAIL;
+    }
 
-    return send_json(req, build_thermocouple_diag_json(&tc, age_ms, settings.tc_offset_c));
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"firing.rec\"");
+    httpd_resp_set_type(req, "application/octet-stream");
+
+    char buf[1024];
+    size_t read_bytes;
+    while ((read_bytes = fread(buf, 1, sizeof(buf), f)) > 0) {
+        if (httpd_resp_send_chunk(req, buf, read_bytes) != ESP_OK) {
+            fclose(f);
+            httpd_resp_send_chunk(req, NULL, 0);
+            return ESP_FAIL;
+        }
+    }
+    fclose(f);
+    httpd_resp_send_chunk(req, NULL, 0);
+    return ESP_OK;
+}
+
+/* ── GET /api/v1/diagnostics/http-arena ───────────── */
+
+static const char *method_name(httpd_method_t method)
+{
+    switch (method) {
+    case HTTP_GET:
+        return "GET";
+    case HTTP_POST:
+        return "POST";
+    case HTTP_DELETE:
+        return "DELETE";
+    default:
+        return "?";
+    }
+}
+
+/* Per-route request-arena high-water marks, for sizing APP_HTTP_ARENA_SIZE:
+   a route whose highWater nears arenaSize, or with any heapFallbacks, is
+   spilling cJSON onto the heap. */
+static esp_err_t handle_diag_http_arena(httpd_req_t *req)
+{
+    if (!require_auth(req)) {
+        return ESP_FAIL;
+    }
+
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "arenaSize", APP_HTTP_ARENA_SIZE);
+    cJSON_AddNumberToObject(root, "arenaCount", APP_HTTP_ARENA_COUNT);
+    cJSON *routes = cJSON_AddArrayToObject(root, "routes");
+    for (int i = 0; i < s_route_count; i++) {
+        const api_route_t *r = &s_routes[i];
+        cJSON *item = cJSON_CreateObject();
+        cJSON_AddStringToObject(item, "uri", r->uri);
+        cJSON_AddStringToObject(item, "method", method_name(r->method));
+        cJSON_AddNumberToObject(item, "requests", r->arena.requests);
+        cJSON_AddNumberToObject(item, "highWater", r->arena.high_water);
+        cJSON_AddNumberToObject(item, "heapFallbacks", r->arena.fallbacks);
+        cJSON_AddNumberToObject(item, "noArena", r->arena.no_arena);
+        cJSON_AddItemToArray(routes, item);
+    }
+    return send_json(req, root);
+}
+
+/* ── GET /api/v1/diagnostics/runtime ─────────────── */
+
+static double tenths(float v)
+{
+    return round(v * 10.0) / 10.0;
+}
+
+/* count plus min/mean/p50/p90/p99/max, keyed with `unit` ("minUs", ...). */
+static cJSON *hist_json(const rt_hist_t *h, const char *unit)
+{
+    const struct {
+        const char *stat;
+        double value;
+    } fields[] = {
+        {"min", h->min},
+        {"mean", h->count ? (double)(h->sum / h->count) : 0},
+        {"p50", rt_hist_percentile(h, 50)},
+        {"p90", rt_hist_percentile(h, 90)},
+        {"p99", rt_hist_percentile(h, 99)},
+        {"max", h->max},
+    };
+    cJSON *o = cJSON_CreateObject();
+    cJSON_AddNumberToObject(o, "count", h->count);
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "%s%s", fields[i].stat, unit);
+        cJSON_AddNumberToObject(o, key, fields[i].value);
+    }
+    return o;
+}
+
+/* Per-phase firing_tick cost in CPU cycles, or nothing when the build has
+   CONFIG_FIRING_TICK_PROFILE off. */
+static void add_tick_phases(cJSON *root)
+{
+    firing_tick_profile_t *prof = http_arena_malloc(sizeof(*prof));
+    if (!prof) {
+        return;
+    }
+    if (firing_engine_get_tick_profile(prof)) {
+        cJSON *tp = cJSON_AddObjectToObject(root, "tickPhases");
+        cJSON_AddNumberToObject(tp, "cpuMhz", CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+        cJSON *phases = cJSON_AddArrayToObject(tp, "phases");
+        for (int p = 0; p < FIRING_PHASE_COUNT; p++) {
+            cJSON *item = hist_json(&prof->cycles[p], "Cycles");
+            cJSON_AddStringToObject(item, "name", firing_tick_phase_name((firing_tick_phase_t)p));
+            const char *io = firing_tick_phase_io((firing_tick_phase_t)p);
+            if (io) {
+                cJSON_AddStringToObject(item, "io", io);
+            }
+            cJSON_AddItemToArray(phases, item);
+        }
+    }
+    http_arena_free(prof);
+}
+
+/* Per-task CPU share and stack headroom over the last sampling window, plus
+   firing_tick execution time and wake jitter since boot (components/rt_stats)
+   and, with CONFIG_FIRING_TICK_PROFILE, the tick broken down by phase, each
+   tagged with the storage it can block on. stackSize is present only for the
+   statically allocated tasks mem_budget knows about. */
+static esp_err_t handle_diag_runtime(httpd_req_t *req)
+{
+    if (!require_auth(req)) {
+        return ESP_FAIL;
+    }
+
+    rt_stats_snapshot_t *snap = http_arena_malloc(sizeof(*snap));
+    if (!snap) {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Out of memory");
+        return ESP_FAIL;
+    }
+    rt_stats_snapshot(snap);
+
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "windowMs", snap->window_ms);
+    cJSON_AddNumberToObject(root, "uptimeS", snap->uptime_s);
+    cJSON *cores = cJSON_AddArrayToObject(root, "cores");
+    for (int c = 0; c < snap->core_count; c++) {
+        cJSON *item = cJSON_CreateObject();
+        cJSON_AddNumberToObject(item, "core", c);
+        cJSON_AddNumberToObject(item, "loadPct", tenths(snap->core_load_pct[c]));
+        cJSON_AddItemToArray(cores, item);
+    }
+    cJSON *tasks = cJSON_AddArrayToObject(root, "tasks");
+    for (int i = 0; i < snap->task_count; i++) {
+        const rt_task_stat_t *t = &snap->tasks[i];
+        cJSON *item = cJSON_CreateObject();
+        cJSON_AddStringToObject(item, "name", t->name);
+        cJSON_AddNumberToObject(item, "core", t->core);
+        cJSON_AddNumberToObject(item, "priority", t->priority);
+        cJSON_AddNumberToObject(item, "cpuPct", tenths(t->cpu_pct));
+        cJSON_AddNumberToObject(item, "stackFree", t->stack_free);
+        if (t->stack_size) {
+            cJSON_AddNumberToObject(item, "stackSize", t->stack_size);
+        }
+        cJSON_AddItemToArray(tasks, item);
+    }
+    cJSON_AddItemToObject(root, "firingTick", hist_json(&snap->tick_us, "Us"));
+    cJSON *jitter = hist_json(&snap->jitter_us, "Us");
+    cJSON_AddNumberToObject(jitter, "periodMaxUs", snap->period_max_us);
+    cJSON_AddNumberToObject(jitter, "lateTicks", snap->ticks_over_deadline);
+    cJSON_AddItemToObject(root, "wakeJitter", jitter);
+    http_arena_free(snap);
+    add_tick_phases(root);
+    return send_json(req, root);
+}
+
+/* ── GET /api/v1/logs ──────────────────────────────── */
+
+#define LOGS_DEFAULT_LIMIT 50
+#define LOGS_MAX_LIMIT     100
+
+cJSON *build_log_page_json(uint64_t *cursor, int limit)
+{
+    uint64_t oldest, next;
+    uint32_t boots;
+    log_capture_range(&oldest, &next, &boots);
+
+    cJSON *root = cJSON_CreateObject();
+    if (*cursor < oldest) {
+        cJSON_AddNumberToObject(root, "dropped", (double)(oldest - *cursor));
+    }
+    cJSON *entries = cJSON_AddArrayToObject(root, "entries");
+    log_ring_entry_t e;
+    char level[2] = {0};
+    for (int i = 0; i < limit && log_capture_read(cursor, &e); i++) {
+        cJSON *item = cJSON_CreateObject();
+        level[0] = e.level;
+        cJSON_AddNumberToObject(item, "cursor", (double)e.cursor);
+        cJSON_AddNumberToObject(item, "t", e.t_ms);
+        cJSON_AddStringToObject(item, "level", level);
+        cJSON_AddStringToObject(item, "tag", e.tag);
+        cJSON_AddStringToObject(item, "msg", e.msg);
+        cJSON_AddItemToArray(entries, item);
+    }
+    cJSON_AddNumberToObject(root, "next", (double)*cursor);
+    return root;
+}
+
+/* Lines from the log ring, oldest first, formatted on the way out. Without
+   ?since= the page starts at the oldest line still held; page on with the
+   returned "next". Lines from before a soft reboot are included. */
+static esp_err_t handle_get_logs(httpd_req_t *req)
+{
+    if (!require_auth(req)) {
+        return ESP_FAIL;
+    }
+
+    uint64_t cursor = 0;
+    int limit = LOGS_DEFAULT_LIMIT;
+    char query[96];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        char val[24];
+        if (httpd_query_key_value(query, "since", val, sizeof(val)) == ESP_OK) {
+            cursor = strtoull(val, NULL, 10);
+        }
+        if (httpd_query_key_value(query, "limit", val, sizeof(val)) == ESP_OK) {
+            limit = atoi(val);
+            limit = limit < 1 ? 1 : limit > LOGS_MAX_LIMIT ? LOGS_MAX_LIMIT : limit;
+        }
+    }
+    uint64_t oldest, next;
+    uint32_t boots;
+    log_capture_range(&oldest, &next, &boots);
+    if (cursor == 0) {
+        cursor = oldest; /* not a gap: the reader asked for everything */
+    }
+
+    cJSON *root = build_log_page_json(&cursor, limit);
+    cJSON_AddNumberToObject(root, "oldest", (double)oldest);
+    cJSON_AddNumberToObject(root, "boots", boots);
+    return send_json(req, root);
 }
 
 /* ── GET /api/v1/cone-table ────────────────────────── */
@@ -1276,7 +1849,7 @@ static esp_err_t handle_autotune_start(httpd_req_t *req)
         return ESP_FAIL;
     }
 
-    firing_cmd_t cmd = {.type = FIRING_CMD_AUTOTUNE_START};
+    firing_cmd_t cmd = {.type = FIRING_CMD_AUTOTUNE_START, .source = FIRING_SRC_API};
     cmd.autotune.setpoint = setpoint;
     cmd.autotune.hysteresis = hysteresis;
     xQueueSend(firing_engine_get_cmd_queue(), &cmd, pdMS_TO_TICKS(100));
@@ -1293,7 +1866,7 @@ static esp_err_t handle_autotune_stop(httpd_req_t *req)
     if (!require_auth(req)) {
         return ESP_FAIL;
     }
-    firing_cmd_t cmd = {.type = FIRING_CMD_AUTOTUNE_STOP};
+    firing_cmd_t cmd = {.type = FIRING_CMD_AUTOTUNE_STOP, .source = FIRING_SRC_API};
     xQueueSend(firing_engine_get_cmd_queue(), &cmd, pdMS_TO_TICKS(100));
 
     cJSON *resp = cJSON_CreateObject();
@@ -1553,17 +2126,42 @@ static esp_err_t handle_reboot(httpd_req_t *req)
 
 /* ── Register All Handlers ─────────────────────────── */
 
-/* Counts successful registrations so the summary log can't drift from the
-   actual endpoint count. `registered` is declared in api_handlers_register(). */
-#define REGISTER_API(path, http_method, fn)                                                    \
-    do {                                                                                       \
-        /* NOLINTNEXTLINE(bugprone-macro-parentheses) -- struct init, parens not needed */     \
-        httpd_uri_t u = {.uri = path, .method = http_method, .handler = fn, .user_ctx = NULL}; \
-        esp_err_t e = httpd_register_uri_handler(server, &u);                                  \
-        if (e != ESP_OK)                                                                       \
-            ESP_LOGW(TAG, "Failed to register %s: %s", path, esp_err_to_name(e));              \
-        else                                                                                   \
-            registered++;                                                                      \
+/* Every API request runs here: the route's handler gets a request arena
+   (http_arena.h) for its cJSON, emptied the moment it returns. */
+static esp_err_t handle_route(httpd_req_t *req)
+{
+    api_route_t *route = req->user_ctx;
+    uint32_t fallbacks_before = route->arena.fallbacks + route->arena.no_arena;
+
+    http_arena_t *arena = http_arena_begin();
+    esp_err_t ret = route->fn(req);
+    http_arena_end(arena, &route->arena);
+
+    /* Warn on a route's first spill only; the counts are in the diagnostics. */
+    if (fallbacks_before == 0 && route->arena.fallbacks + route->arena.no_arena > 0) {
+        ESP_LOGW(TAG, "%s %s outgrew its request arena (%d B); spilling to the heap", method_name(route->method),
+                 route->uri, APP_HTTP_ARENA_SIZE);
+    }
+    return ret;
+}
+
+/* Counts successful registrations in s_route_count so the summary log can't
+   drift from the actual endpoint count. */
+#define REGISTER_API(path, http_method, handler_fn)                                                   \
+    do {                                                                                              \
+        if (s_route_count == API_MAX_ROUTES) {                                                        \
+            ESP_LOGW(TAG, "Route table full; %s not registered", path);                               \
+            break;                                                                                    \
+        }                                                                                             \
+        api_route_t *r = &s_routes[s_route_count];                                                    \
+        *r = (api_route_t){.uri = path, .method = http_method, .fn = handler_fn};                     \
+        /* NOLINTNEXTLINE(bugprone-macro-parentheses) -- struct init, parens not needed */            \
+        httpd_uri_t u = {.uri = path, .method = http_method, .handler = handle_route, .user_ctx = r}; \
+        esp_err_t e = httpd_register_uri_handler(server, &u);                                         \
+        if (e != ESP_OK)                                                                              \
+            ESP_LOGW(TAG, "Failed to register %s: %s", path, esp_err_to_name(e));                     \
+        else                                                                                          \
+            s_route_count++;                                                                          \
     } while (0)
 
 esp_err_t api_handlers_register(httpd_handle_t server)
@@ -1578,7 +2176,8 @@ esp_err_t api_handlers_register(httpd_handle_t server)
         s_board_temp_handle = NULL;
     }
 
-    int registered = 0;
+    http_arena_init();
+    s_route_count = 0;
 
     /* Core endpoints */
     REGISTER_API("/api/v1/status", HTTP_GET, handle_get_status);
@@ -1586,11 +2185,14 @@ esp_err_t api_handlers_register(httpd_handle_t server)
     REGISTER_API("/api/v1/profiles", HTTP_POST, handle_post_profile);
     REGISTER_API("/api/v1/profiles/import", HTTP_POST, handle_profile_import);
     REGISTER_API("/api/v1/profiles/cone-fire", HTTP_POST, handle_cone_fire);
+    REGISTER_API("/api/v1/profiles/optimize", HTTP_POST, handle_profile_optimize);
     REGISTER_API("/api/v1/profiles/*", HTTP_GET, handle_get_profile);
+    REGISTER_API("/api/v1/profiles/*", HTTP_POST, handle_profile_simulate);
     REGISTER_API("/api/v1/profiles/*", HTTP_DELETE, handle_delete_profile);
 
     /* Firing control */
     REGISTER_API("/api/v1/firing/start", HTTP_POST, handle_firing_start);
+    REGISTER_API("/api/v1/firing/schedule", HTTP_POST, handle_firing_schedule);
     REGISTER_API("/api/v1/firing/stop", HTTP_POST, handle_firing_stop);
     REGISTER_API("/api/v1/firing/pause", HTTP_POST, handle_firing_pause);
     REGISTER_API("/api/v1/firing/skip-segment", HTTP_POST, handle_firing_skip_segment);
@@ -1610,7 +2212,7 @@ esp_err_t api_handlers_register(httpd_handle_t server)
 
     /* Firing history */
     REGISTER_API("/api/v1/history", HTTP_GET, handle_get_history);
-    REGISTER_API("/api/v1/history/*", HTTP_GET, handle_get_history_trace);
+    REGISTER_API("/api/v1/history/*", HTTP_GET, handle_get_history_item);
 
     /* OTA */
     REGISTER_API("/api/v1/ota", HTTP_POST, handle_ota_upload);
@@ -1623,6 +2225,11 @@ esp_err_t api_handlers_register(httpd_handle_t server)
     /* Diagnostics */
     REGISTER_API("/api/v1/diagnostics/relay", HTTP_POST, handle_diag_relay);
     REGISTER_API("/api/v1/diagnostics/thermocouple", HTTP_GET, handle_diag_thermocouple);
+    REGISTER_API("/api/v1/diagnostics/capability", HTTP_GET, handle_diag_capability);
+    REGISTER_API("/api/v1/diagnostics/firing-record", HTTP_GET, handle_diag_firing_record);
+    REGISTER_API("/api/v1/diagnostics/http-arena", HTTP_GET, handle_diag_http_arena);
+    REGISTER_API("/api/v1/diagnostics/runtime", HTTP_GET, handle_diag_runtime);
+    REGISTER_API("/api/v1/logs", HTTP_GET, handle_get_logs);
 
     /* Wi-Fi configuration */
     REGISTER_API("/api/v1/wifi", HTTP_GET, handle_get_wifi);
@@ -1630,6 +2237,6 @@ esp_err_t api_handlers_register(httpd_handle_t server)
     REGISTER_API("/api/v1/wifi", HTTP_DELETE, handle_delete_wifi);
     REGISTER_API("/api/v1/reboot", HTTP_POST, handle_reboot);
 
-    ESP_LOGI(TAG, "API handlers registered (%d endpoints)", registered);
+    ESP_LOGI(TAG, "API handlers registered (%d endpoints)", s_route_count);
     return ESP_OK;
 }
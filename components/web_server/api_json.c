@@ -8,7 +8,9 @@
 #include "api_json.h"
 #include "thermocouple.h"
 #include "cone_table.h"
+#include <math.h>
 #include <stdbool.h>
+#include <string.h>
 
 const char *firing_status_to_string(firing_status_t s)
 {
@@ -49,6 +51,13 @@ void json_add_progress_fields(cJSON *target, const firing_progress_t *prog, floa
     cJSON_AddNumberToObject(target, "elapsedTime", prog->elapsed_time);
     cJSON_AddNumberToObject(target, "estimatedTimeRemaining", prog->estimated_remaining);
     cJSON_AddStringToObject(target, "status", firing_status_to_string(prog->status));
+    if (prog->is_active && prog->equiv_cone >= 0) {
+        cJSON_AddNumberToObject(target, "equivConeId", prog->equiv_cone);
+        cJSON_AddStringToObject(target, "equivCone", cone_name((cone_id_t)prog->equiv_cone));
+    }
+    if (prog->is_active) {
+        cJSON_AddNumberToObject(target, "kilnLoad", round(prog->kiln_load * 100.0) / 100.0);
+    }
 }
 
 cJSON *build_status_json(const firing_progress_t *prog, const thermocouple_reading_t *tc, float tc_offset_c)
@@ -86,11 +95,254 @@ cJSON *build_profile_json(const firing_profile_t *profile)
         cJSON_AddNumberToObject(s, "rampRate", profile->segments[i].ramp_rate);
         cJSON_AddNumberToObject(s, "targetTemp", profile->segments[i].target_temp);
         cJSON_AddNumberToObject(s, "holdTime", profile->segments[i].hold_time);
+        if (profile->segments[i].end_cone) {
+            cJSON_AddNumberToObject(s, "endConeId", profile->segments[i].end_cone - 1);
+        }
         cJSON_AddItemToArray(segs, s);
     }
     return p;
 }
 
+bool profile_from_json(cJSON *root, firing_profile_t *out)
+{
+    memset(out, 0, sizeof(*out));
+
+    cJSON *j;
+    j = cJSON_GetObjectItem(root, "id");
+    if (j && j->valuestring) {
+        strncpy(out->id, j->valuestring, FIRING_ID_LEN - 1);
+    }
+    j = cJSON_GetObjectItem(root, "name");
+    if (j && j->valuestring) {
+        strncpy(out->name, j->valuestring, FIRING_NAME_LEN - 1);
+    }
+    j = cJSON_GetObjectItem(root, "description");
+    if (j && j->valuestring) {
+        strncpy(out->description, j->valuestring, FIRING_DESC_LEN - 1);
+    }
+    j = cJSON_GetObjectItem(root, "maxTemp");
+    if (j) {
+        out->max_temp = (float)j->valuedouble;
+    }
+    j = cJSON_GetObjectItem(root, "estimatedDuration");
+    if (j) {
+        out->estimated_duration = (uint32_t)j->valuedouble;
+    }
+
+    cJSON *segs = cJSON_GetObjectItem(root, "segments");
+    if (segs && cJSON_IsArray(segs)) {
+        int count = cJSON_GetArraySize(segs);
+        if (count > FIRING_MAX_SEGMENTS) {
+            count = FIRING_MAX_SEGMENTS;
+        }
+        out->segment_count = count;
+        for (int i = 0; i < count; i++) {
+            cJSON *seg = cJSON_GetArrayItem(segs, i);
+            j = cJSON_GetObjectItem(seg, "id");
+            if (j && j->valuestring) {
+                strncpy(out->segments[i].id, j->valuestring, FIRING_ID_LEN - 1);
+            }
+            j = cJSON_GetObjectItem(seg, "name");
+            if (j && j->valuestring) {
+                strncpy(out->segments[i].name, j->valuestring, FIRING_NAME_LEN - 1);
+            }
+            j = cJSON_GetObjectItem(seg, "rampRate");
+            if (j) {
+                out->segments[i].ramp_rate = (float)j->valuedouble;
+            }
+            j = cJSON_GetObjectItem(seg, "targetTemp");
+            if (j) {
+                out->segments[i].target_temp = (float)j->valuedouble;
+            }
+            j = cJSON_GetObjectItem(seg, "holdTime");
+            if (j) {
+                out->segments[i].hold_time = (uint16_t)j->valuedouble;
+            }
+            /* Stored off by one so a zeroed segment means "no cone"; anything
+               outside the cone table lands past CONE_COUNT for the validator. */
+            j = cJSON_GetObjectItem(seg, "endConeId");
+            if (j && cJSON_IsNumber(j)) {
+                double id = j->valuedouble;
+                out->segments[i].end_cone = (id >= 0.0 && id < CONE_COUNT) ? (uint8_t)id + 1 : UINT8_MAX;
+            }
+        }
+    }
+
+    return out->id[0] != '\0';
+}
+
+/* Where a profile's first ramp is assumed to start when it is saved: a cold
+   kiln. */
+#define RAMP_CHECK_START_C 20.0f
+
+cJSON *build_ramp_warnings_json(const firing_profile_t *profile, const kiln_cap_t *cap)
+{
+    cJSON *arr = cJSON_CreateArray();
+    float from = RAMP_CHECK_START_C;
+    for (int i = 0; i < profile->segment_count; i++) {
+        const firing_segment_t *seg = &profile->segments[i];
+        float slowest;
+        float at = seg->ramp_rate > 0.0f ? kiln_cap_shortfall(cap, from, seg->target_temp, seg->ramp_rate, &slowest)
+                                         : NAN;
+        if (!isnan(at)) {
+            cJSON *w = cJSON_CreateObject();
+            cJSON_AddNumberToObject(w, "segment", i);
+            cJSON_AddNumberToObject(w, "aboveTemp", roundf(at));
+            cJSON_AddNumberToObject(w, "rampRate", seg->ramp_rate);
+            cJSON_AddNumberToObject(w, "maxRate", slowest);
+            cJSON_AddItemToArray(arr, w);
+        }
+        from = seg->target_temp;
+    }
+    return arr;
+}
+
+static bool zone_from_json(const cJSON *item, profile_opt_zone_t *out)
+{
+    const cJSON *from = cJSON_GetObjectItem(item, "from");
+    const cJSON *to = cJSON_GetObjectItem(item, "to");
+    const cJSON *rate = cJSON_GetObjectItem(item, "maxRate");
+    if (!cJSON_IsNumber(from) || !cJSON_IsNumber(to) || !cJSON_IsNumber(rate)) {
+        return false;
+    }
+    *out = (profile_opt_zone_t){
+        .from_c = (float)from->valuedouble, .to_c = (float)to->valuedouble, .max_rate_ch = (float)rate->valuedouble};
+    return isfinite(out->from_c) && isfinite(out->to_c) && out->to_c > out->from_c && out->max_rate_ch > 0.0f &&
+           isfinite(out->max_rate_ch);
+}
+
+static bool hold_from_json(const cJSON *item, profile_opt_hold_t *out)
+{
+    const cJSON *temp = cJSON_GetObjectItem(item, "temp");
+    const cJSON *minutes = cJSON_GetObjectItem(item, "minutes");
+    if (!cJSON_IsNumber(temp) || !cJSON_IsNumber(minutes) || !isfinite(temp->valuedouble) ||
+        !(minutes->valuedouble >= 0.0 && minutes->valuedouble < FIRING_HOLD_INDEFINITE)) {
+        return false;
+    }
+    *out = (profile_opt_hold_t){.temp_c = (float)temp->valuedouble, .minutes = (uint16_t)minutes->valuedouble};
+    return true;
+}
+
+bool profile_opt_limits_from_json(cJSON *root, profile_opt_limits_t *out)
+{
+    const cJSON *j = cJSON_GetObjectItem(root, "startTemp");
+    if (cJSON_IsNumber(j)) {
+        if (!isfinite(j->valuedouble)) {
+            return false;
+        }
+        out->start_temp_c = (float)j->valuedouble;
+    }
+    j = cJSON_GetObjectItem(root, "maxRate");
+    if (cJSON_IsNumber(j)) {
+        if (!(j->valuedouble >= 0.0 && isfinite(j->valuedouble))) {
+            return false;
+        }
+        out->max_rate_ch = (float)j->valuedouble;
+    }
+    const cJSON *zones = cJSON_GetObjectItem(root, "zones");
+    if (cJSON_IsArray(zones)) {
+        int count = cJSON_GetArraySize(zones);
+        if (count > PROFILE_OPT_MAX_ZONES) {
+            return false;
+        }
+        for (int i = 0; i < count; i++) {
+            if (!zone_from_json(cJSON_GetArrayItem(zones, i), &out->zones[i])) {
+                return false;
+            }
+        }
+        out->zone_count = count;
+    }
+    const cJSON *holds = cJSON_GetObjectItem(root, "minHolds");
+    if (cJSON_IsArray(holds)) {
+        int count = cJSON_GetArraySize(holds);
+        if (count > PROFILE_OPT_MAX_HOLDS) {
+            return false;
+        }
+        for (int i = 0; i < count; i++) {
+            if (!hold_from_json(cJSON_GetArrayItem(holds, i), &out->holds[i])) {
+                return false;
+            }
+        }
+        out->hold_count = count;
+    }
+    return true;
+}
+
+cJSON *build_plan_json(const profile_plan_t *plan, float element_watts)
+{
+    cJSON *p = cJSON_CreateObject();
+    cJSON_AddNumberToObject(p, "durationS", plan->duration_s);
+    if (element_watts > 0.0f) {
+        cJSON_AddNumberToObject(p, "energyKwh", round((double)plan->on_s * element_watts / 36000.0) / 100.0);
+    }
+    return p;
+}
+
+static const char *sim_outcome_to_string(firing_sim_outcome_t outcome)
+{
+    switch (outcome) {
+    case FIRING_SIM_COMPLETE:
+        return "complete";
+    case FIRING_SIM_WAITS:
+        return "waits";
+    case FIRING_SIM_STALLED:
+        return "stalled";
+    case FIRING_SIM_TIMEOUT:
+        return "timeout";
+    case FIRING_SIM_CANCELLED:
+        return "cancelled";
+    }
+    return "unknown";
+}
+
+cJSON *build_sim_json(const firing_sim_result_t *sim, float element_watts, float cost_kwh)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddStringToObject(root, "outcome", sim_outcome_to_string(sim->outcome));
+    cJSON_AddNumberToObject(root, "segment", sim->segment);
+    cJSON_AddNumberToObject(root, "durationS", sim->duration_s);
+    cJSON_AddNumberToObject(root, "peakTemp", round(sim->peak_temp_c * 10.0) / 10.0);
+    cJSON_AddNumberToObject(root, "maxLag", round(sim->max_lag_c * 10.0) / 10.0);
+    if (sim->equiv_cone >= 0) {
+        cJSON_AddNumberToObject(root, "equivConeId", sim->equiv_cone);
+        cJSON_AddStringToObject(root, "equivCone", cone_name((cone_id_t)sim->equiv_cone));
+    }
+    if (element_watts > 0.0f) {
+        double kwh = (double)sim->on_s * element_watts / 3600000.0;
+        cJSON_AddNumberToObject(root, "energyKwh", round(kwh * 100.0) / 100.0);
+        if (cost_kwh > 0.0f) {
+            cJSON_AddNumberToObject(root, "cost", round(kwh * cost_kwh * 100.0) / 100.0);
+        }
+    }
+    cJSON_AddNumberToObject(root, "pointEveryS", sim->point_every_s);
+    /* Pairs, not objects: no key copies per point, so a full curve fits the
+       request arena several times over. */
+    cJSON *curve = cJSON_AddArrayToObject(root, "curve");
+    for (int i = 0; i < sim->point_count; i++) {
+        cJSON *pt = cJSON_CreateArray();
+        cJSON_AddItemToArray(pt, cJSON_CreateNumber(sim->points[i].t_s));
+        cJSON_AddItemToArray(pt, cJSON_CreateNumber(round(sim->points[i].temp_c * 10.0) / 10.0));
+        cJSON_AddItemToArray(curve, pt);
+    }
+    return root;
+}
+
+cJSON *build_capability_json(const kiln_cap_t *cap)
+{
+    cJSON *arr = cJSON_CreateArray();
+    for (int b = 0; b < KILN_CAP_BINS; b++) {
+        if (!cap->rate_ch[b]) {
+            continue;
+        }
+        cJSON *bin = cJSON_CreateObject();
+        cJSON_AddNumberToObject(bin, "fromTemp", b * KILN_CAP_BIN_C);
+        cJSON_AddNumberToObject(bin, "maxRate", cap->rate_ch[b]);
+        cJSON_AddNumberToObject(bin, "firings", cap->firings[b]);
+        cJSON_AddItemToArray(arr, bin);
+    }
+    return arr;
+}
+
 cJSON *build_settings_json(const kiln_settings_t *settings)
 {
     cJSON *root = cJSON_CreateObject();
@@ -106,6 +358,78 @@ cJSON *build_settings_json(const kiln_settings_t *settings)
     cJSON_AddBoolToObject(root, "apiTokenSet", settings->api_token[0] != '\0');
     cJSON_AddNumberToObject(root, "elementWatts", settings->element_watts);
     cJSON_AddNumberToObject(root, "electricityCostKwh", settings->electricity_cost_kwh);
+    cJSON *tariff = cJSON_AddArrayToObject(root, "tariff");
+    for (int i = 0; i < settings->tariff_count; i++) {
+        cJSON *band = cJSON_CreateObject();
+        cJSON_AddNumberToObject(band, "startMin", settings->tariff[i].start_min);
+        cJSON_AddNumberToObject(band, "costKwh", round(settings->tariff[i].cost_kwh * 10000.0) / 10000.0);
+        cJSON_AddItemToArray(tariff, band);
+    }
+    return root;
+}
+
+static bool band_from_json(const cJSON *item, tariff_band_t *out)
+{
+    const cJSON *start = cJSON_GetObjectItem(item, "startMin");
+    const cJSON *cost = cJSON_GetObjectItem(item, "costKwh");
+    if (!cJSON_IsNumber(start) || !cJSON_IsNumber(cost)) {
+        return false;
+    }
+    double minute = start->valuedouble;
+    if (!(minute >= 0.0 && minute < 1440.0) || minute != floor(minute) ||
+        !(cost->valuedouble >= 0.0 && isfinite(cost->valuedouble))) {
+        return false;
+    }
+    *out = (tariff_band_t){.start_min = (uint16_t)minute, .cost_kwh = (float)cost->valuedouble};
+    return true;
+}
+
+bool tariff_from_json(const cJSON *arr, kiln_settings_t *out)
+{
+    if (!cJSON_IsArray(arr)) {
+        return false;
+    }
+    int count = cJSON_GetArraySize(arr);
+    if (count > FIRING_TARIFF_MAX_BANDS) {
+        return false;
+    }
+    tariff_band_t bands[FIRING_TARIFF_MAX_BANDS];
+    for (int i = 0; i < count; i++) {
+        tariff_band_t band;
+        if (!band_from_json(cJSON_GetArrayItem(arr, i), &band)) {
+            return false;
+        }
+        /* Insertion by start, so the stored table reads in order. */
+        int j = i;
+        for (; j > 0 && bands[j - 1].start_min > band.start_min; j--) {
+            bands[j] = bands[j - 1];
+        }
+        if (j > 0 && bands[j - 1].start_min == band.start_min) {
+            return false;
+        }
+        bands[j] = band;
+    }
+    memcpy(out->tariff, bands, (size_t)count * sizeof(bands[0]));
+    out->tariff_count = (uint8_t)count;
+    return true;
+}
+
+cJSON *build_schedule_json(const tariff_plan_t *plan, const firing_sim_result_t *sim, float element_watts,
+                           uint32_t delay_minutes, bool armed)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "startAt", (double)plan->start_s);
+    cJSON_AddNumberToObject(root, "delayMinutes", delay_minutes);
+    cJSON_AddNumberToObject(root, "finishAt", (double)(plan->start_s + sim->duration_s));
+    cJSON_AddNumberToObject(root, "durationS", sim->duration_s);
+    cJSON_AddNumberToObject(root, "energyKwh", round((double)sim->on_s * element_watts / 36000.0) / 100.0);
+    /* Savings from the rounded costs, so the three figures add up as shown. */
+    double cost = round(plan->cost * 100.0) / 100.0;
+    double earliest = round(plan->earliest_cost * 100.0) / 100.0;
+    cJSON_AddNumberToObject(root, "cost", cost);
+    cJSON_AddNumberToObject(root, "earliestCost", earliest);
+    cJSON_AddNumberToObject(root, "savings", round((earliest - cost) * 100.0) / 100.0);
+    cJSON_AddBoolToObject(root, "armed", armed);
     return root;
 }
 
@@ -123,6 +447,73 @@ cJSON *build_history_record_json(const history_record_t *rec)
     return item;
 }
 
+static const char *const s_event_types[HISTORY_EVT_COUNT] = {
+    [HISTORY_EVT_SEGMENT] = "segment",
+    [HISTORY_EVT_HOLD] = "hold",
+    [HISTORY_EVT_PAUSE] = "pause",
+    [HISTORY_EVT_RESUME] = "resume",
+    [HISTORY_EVT_TC_FAULT] = "tcFault",
+    [HISTORY_EVT_TC_OK] = "tcOk",
+    [HISTORY_EVT_TRIP] = "trip",
+    [HISTORY_EVT_SETTINGS] = "settings",
+    [HISTORY_EVT_STOP] = "stop",
+    [HISTORY_EVT_CONE] = "cone",
+};
+
+static const char *event_source_string(uint8_t source)
+{
+    switch (source) {
+    case FIRING_SRC_API:
+        return "api";
+    case FIRING_SRC_LCD:
+        return "lcd";
+    default:
+        return "engine";
+    }
+}
+
+cJSON *build_history_event_json(const history_event_t *evt)
+{
+    cJSON *item = cJSON_CreateObject();
+    cJSON_AddNumberToObject(item, "t", evt->t_s);
+    const char *type = (unsigned)evt->kind < HISTORY_EVT_COUNT ? s_event_types[evt->kind] : NULL;
+    cJSON_AddStringToObject(item, "type", type ? type : "unknown");
+    cJSON_AddStringToObject(item, "source", event_source_string(evt->source));
+    cJSON_AddNumberToObject(item, "temp", evt->temp_c);
+    switch (evt->kind) {
+    case HISTORY_EVT_SEGMENT:
+    case HISTORY_EVT_HOLD:
+        cJSON_AddNumberToObject(item, "segment", evt->arg);
+        break;
+    case HISTORY_EVT_TC_FAULT:
+        cJSON_AddNumberToObject(item, "fault", evt->arg);
+        break;
+    case HISTORY_EVT_TRIP:
+        cJSON_AddNumberToObject(item, "errorCode", evt->arg);
+        break;
+    case HISTORY_EVT_CONE:
+        cJSON_AddNumberToObject(item, "coneId", evt->arg);
+        cJSON_AddStringToObject(item, "cone", cone_name((cone_id_t)evt->arg));
+        break;
+    case HISTORY_EVT_SETTINGS: {
+        cJSON *changed = cJSON_AddArrayToObject(item, "changed");
+        if (evt->arg & HISTORY_SETTING_MAX_TEMP) {
+            cJSON_AddItemToArray(changed, cJSON_CreateString("maxTemp"));
+        }
+        if (evt->arg & HISTORY_SETTING_TC_OFFSET) {
+            cJSON_AddItemToArray(changed, cJSON_CreateString("tcOffset"));
+        }
+        if (evt->arg & HISTORY_SETTING_OTHER) {
+            cJSON_AddItemToArray(changed, cJSON_CreateString("other"));
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return item;
+}
+
 cJSON *build_cone_table_json(void)
 {
     cJSON *arr = cJSON_CreateArray();
@@ -156,7 +547,8 @@ cJSON *build_autotune_status_json(const firing_progress_t *prog, float kp, float
     return root;
 }
 
-cJSON *build_thermocouple_diag_json(const thermocouple_reading_t *tc, int64_t age_ms, float tc_offset_c)
+cJSON *build_thermocouple_diag_json(const thermocouple_reading_t *tc, int64_t age_ms, float tc_offset_c,
+                                    const thermocouple_timing_t *timing)
 {
     cJSON *root = cJSON_CreateObject();
     cJSON_AddNumberToObject(root, "temperatureC", tc->temperature_c);
@@ -168,5 +560,15 @@ cJSON *build_thermocouple_diag_json(const thermocouple_reading_t *tc, int64_t ag
     cJSON_AddNumberToObject(root, "readingAgeMs", (double)age_ms);
     cJSON_AddNumberToObject(root, "temperatureAdjustedC", tc->temperature_c + tc_offset_c);
     cJSON_AddNumberToObject(root, "tcOffsetC", tc_offset_c);
+
+    cJSON *t = cJSON_AddObjectToObject(root, "timing");
+    cJSON_AddNumberToObject(t, "reads", timing->reads);
+    cJSON_AddNumberToObject(t, "busWaits", timing->bus_waits);
+    cJSON_AddNumberToObject(t, "maxBusWaitUs", (double)timing->max_bus_wait_us);
+    cJSON_AddNumberToObject(t, "maxReadUs", (double)timing->max_read_us);
+    cJSON_AddNumberToObject(t, "intervals", timing->intervals);
+    cJSON_AddNumberToObject(t, "maxJitterUs", (double)timing->max_jitter_us);
+    cJSON_AddNumberToObject(t, "meanJitterUs",
+                            timing->intervals ? round((double)timing->total_jitter_us / timing->intervals) : 0.0);
     return root;
 }
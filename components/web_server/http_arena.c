@@ -0,0 +1,153 @@
+#include "http_arena.h"
+#include "app_config.h"
+#include "mem_budget.h"
+#include "cJSON.h"
+#include "freertos/task.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_ALIGN sizeof(uint64_t)
+#define NO_BLOCK    SIZE_MAX
+
+_Static_assert(APP_HTTP_ARENA_SIZE % ARENA_ALIGN == 0, "arena size must keep blocks aligned");
+
+struct http_arena {
+    uint8_t *base;
+    size_t top;         /* first free byte */
+    size_t last;        /* offset of the newest block, NO_BLOCK once it's been freed */
+    size_t peak;        /* highest `top` this request */
+    uint32_t fallbacks; /* this request's heap allocations */
+    TaskHandle_t owner; /* NULL while in the pool */
+};
+
+static MEM_PLACE(APP_MEM_HTTP_ARENA) uint64_t s_mem[APP_HTTP_ARENA_COUNT][APP_HTTP_ARENA_SIZE / ARENA_ALIGN];
+static http_arena_t s_arenas[APP_HTTP_ARENA_COUNT];
+static portMUX_TYPE s_pool_mux = portMUX_INITIALIZER_UNLOCKED;
+static bool s_initialized;
+
+/* Only the owning task ever sees its own handle in `owner`, and it wrote it
+   itself in http_arena_begin(), so this needs no lock: another task can at
+   worst read a stale owner that isn't itself. */
+static http_arena_t *current_arena(void)
+{
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (int i = 0; i < APP_HTTP_ARENA_COUNT && self; i++) {
+        if (s_arenas[i].owner == self) {
+            return &s_arenas[i];
+        }
+    }
+    return NULL;
+}
+
+void *http_arena_malloc(size_t size)
+{
+    http_arena_t *a = current_arena();
+    if (!a) {
+        return malloc(size);
+    }
+    size_t start = (a->top + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+    if (size > APP_HTTP_ARENA_SIZE - start) {
+        a->fallbacks++;
+        return malloc(size);
+    }
+    a->last = start;
+    a->top = start + size;
+    if (a->top > a->peak) {
+        a->peak = a->top;
+    }
+    return a->base + start;
+}
+
+void http_arena_free(void *ptr)
+{
+    uint8_t *p = ptr;
+    uint8_t *pool = (uint8_t *)s_mem;
+    if (p < pool || p >= pool + sizeof(s_mem)) {
+        free(ptr); /* NULL lands here too */
+        return;
+    }
+    /* Only the newest block can be handed back; the rest waits for the
+       reset. A pointer freed after its request ended is simply dropped. */
+    http_arena_t *a = &s_arenas[(size_t)(p - pool) / APP_HTTP_ARENA_SIZE];
+    if (a->owner == xTaskGetCurrentTaskHandle() && a->last != NO_BLOCK && p == a->base + a->last) {
+        a->top = a->last;
+        a->last = NO_BLOCK;
+    }
+}
+
+char *http_arena_print(const cJSON *item)
+{
+    http_arena_t *a = current_arena();
+    if (a) {
+        /* Print straight into the rest of the arena, then keep only what was
+           used: one pass, none of cJSON's grow-by-copy buffers left behind. */
+        size_t start = (a->top + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+        char *buf = (char *)a->base + start;
+        if (start < APP_HTTP_ARENA_SIZE &&
+            cJSON_PrintPreallocated((cJSON *)item, buf, (int)(APP_HTTP_ARENA_SIZE - start), false)) {
+            a->last = start;
+            a->top = start + strlen(buf) + 1;
+            if (a->top > a->peak) {
+                a->peak = a->top;
+            }
+            return buf;
+        }
+    }
+    return cJSON_PrintUnformatted(item);
+}
+
+void http_arena_init(void)
+{
+    if (s_initialized) {
+        return;
+    }
+    for (int i = 0; i < APP_HTTP_ARENA_COUNT; i++) {
+        s_arenas[i] = (http_arena_t){.base = (uint8_t *)s_mem[i], .last = NO_BLOCK};
+    }
+    cJSON_Hooks hooks = {.malloc_fn = http_arena_malloc, .free_fn = http_arena_free};
+    cJSON_InitHooks(&hooks);
+    mem_budget_add("web_server", "http arenas", APP_MEM_HTTP_ARENA, sizeof(s_mem));
+    s_initialized = true;
+}
+
+http_arena_t *http_arena_begin(void)
+{
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    http_arena_t *got = NULL;
+    portENTER_CRITICAL(&s_pool_mux);
+    for (int i = 0; i < APP_HTTP_ARENA_COUNT && s_initialized; i++) {
+        if (!s_arenas[i].owner) {
+            got = &s_arenas[i];
+            got->owner = self;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_pool_mux);
+    return got;
+}
+
+void http_arena_end(http_arena_t *arena, http_arena_stats_t *stats)
+{
+    if (stats) {
+        stats->requests++;
+        if (!arena) {
+            stats->no_arena++;
+        } else {
+            stats->fallbacks += arena->fallbacks;
+            if (arena->peak > stats->high_water) {
+                stats->high_water = (uint32_t)arena->peak;
+            }
+        }
+    }
+    if (!arena) {
+        return;
+    }
+    arena->top = 0;
+    arena->last = NO_BLOCK;
+    arena->peak = 0;
+    arena->fallbacks = 0;
+    portENTER_CRITICAL(&s_pool_mux);
+    arena->owner = NULL;
+    portEXIT_CRITICAL(&s_pool_mux);
+}
@@ -20,6 +20,10 @@
 #include "firing_types.h"
 #include "thermocouple.h"
 #include "firing_history.h"
+#include "kiln_capability.h"
+#include "profile_optimizer.h"
+#include "firing_sim.h"
+#include "tariff_schedule.h"
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -34,12 +38,67 @@ cJSON *build_status_json(const firing_progress_t *prog, const thermocouple_readi
 /** GET /api/v1/profiles/:id, POST /api/v1/profiles/cone-fire — one firing profile. */
 cJSON *build_profile_json(const firing_profile_t *profile);
 
-/** GET /api/v1/settings — kiln settings; api_token replaced by apiTokenSet bool. */
+/** POST /api/v1/profiles body → firing_profile_t; the inverse of
+ *  build_profile_json. Unknown keys are ignored, missing ones stay zeroed and
+ *  segments beyond FIRING_MAX_SEGMENTS are dropped. Returns false when the
+ *  profile has no id. Shape only — callers still validate before firing. */
+bool profile_from_json(cJSON *root, firing_profile_t *out);
+
+/** POST /api/v1/profiles (and import) response "rampWarnings": one
+ *  {segment, aboveTemp, rampRate, maxRate} per heating segment that asks for a
+ *  faster climb than the learned capability curve delivers from `aboveTemp`
+ *  up (maxRate is the slowest learned rise over that stretch). The first
+ *  segment is checked from a cold kiln. Empty while nothing is learned. */
+cJSON *build_ramp_warnings_json(const firing_profile_t *profile, const kiln_cap_t *cap);
+
+/** GET /api/v1/diagnostics/capability: {fromTemp, maxRate, firings} for each
+ *  learned KILN_CAP_BIN_C-wide bin, coolest first. */
+cJSON *build_capability_json(const kiln_cap_t *cap);
+
+/** POST /api/v1/profiles/optimize body → limits, over whatever `out` already
+ *  holds (the defaults): "startTemp", "maxRate", "zones" [{from, to, maxRate}]
+ *  and "minHolds" [{temp, minutes}]; a zones or minHolds array replaces the
+ *  defaults outright. Returns false on a malformed entry (empty or inverted
+ *  zone, non-positive rate, soak past FIRING_HOLD_INDEFINITE, too many). */
+bool profile_opt_limits_from_json(cJSON *root, profile_opt_limits_t *out);
+
+/** POST /api/v1/profiles/optimize "original" / "optimized": {durationS} plus
+ *  energyKwh when the element power is configured. */
+cJSON *build_plan_json(const profile_plan_t *plan, float element_watts);
+
+/** POST /api/v1/profiles/:id/simulate: {outcome, segment, durationS,
+ *  peakTemp, maxLag, pointEveryS, curve} with the curve as [t, temp] pairs,
+ *  equivConeId/equivCone once a cone has bent, energyKwh when the element
+ *  power is configured and cost when the tariff is too. */
+cJSON *build_sim_json(const firing_sim_result_t *sim, float element_watts, float cost_kwh);
+
+/** GET /api/v1/settings — kiln settings; api_token replaced by apiTokenSet bool
+ *  and the time-of-use bands as "tariff" [{startMin, costKwh}]. */
 cJSON *build_settings_json(const kiln_settings_t *settings);
 
+/** POST /api/v1/settings "tariff" → the settings' time-of-use bands, replacing
+ *  them and sorted by start. Returns false, leaving `out` alone, on a malformed
+ *  band (startMin outside 0..1439 or not whole, negative cost), two bands
+ *  starting together or more than FIRING_TARIFF_MAX_BANDS. An empty array
+ *  clears the table. */
+bool tariff_from_json(const cJSON *arr, kiln_settings_t *out);
+
+/** POST /api/v1/firing/schedule: {startAt, delayMinutes, finishAt, durationS,
+ *  energyKwh, cost, earliestCost, savings, armed} for `plan`, whose start_s is
+ *  when the delayed START fires. Costs are to the cent. finishAt and durationS
+ *  are the dry run's: where a segment ends on a cone they are when the modelled
+ *  heat work reaches it, a prediction the kiln can beat or overrun. */
+cJSON *build_schedule_json(const tariff_plan_t *plan, const firing_sim_result_t *sim, float element_watts,
+                           uint32_t delay_minutes, bool armed);
+
 /** GET /api/v1/history element. */
 cJSON *build_history_record_json(const history_record_t *rec);
 
+/** GET /api/v1/history/:id/events element: {t, type, source, temp} plus
+ *  "segment" (segment / hold), "fault" (tcFault), "errorCode" (trip) or
+ *  "changed" (settings) for the kinds that carry an argument. */
+cJSON *build_history_event_json(const history_event_t *evt);
+
 /** GET /api/v1/cone-table — entire cone reference table (no inputs). */
 cJSON *build_cone_table_json(void);
 
@@ -52,8 +111,12 @@ cJSON *build_autotune_status_json(const firing_progress_t *prog, float kp, float
  * @param tc            Latest thermocouple reading.
  * @param age_ms        Age of the reading in milliseconds (-1 if never read).
  * @param tc_offset_c   Calibration offset, added to temperatureAdjustedC.
+ * @param timing        SPI read timing since boot, as "timing": {reads,
+ *                      busWaits, maxBusWaitUs, maxReadUs, intervals,
+ *                      maxJitterUs, meanJitterUs}.
  */
-cJSON *build_thermocouple_diag_json(const thermocouple_reading_t *tc, int64_t age_ms, float tc_offset_c);
+cJSON *build_thermocouple_diag_json(const thermocouple_reading_t *tc, int64_t age_ms, float tc_offset_c,
+                                    const thermocouple_timing_t *timing);
 
 /** Convert firing_status_t to its lowercase string for JSON. Lives here so
  * host tests don't need to link web_server.c (which pulls in esp_http_server). */
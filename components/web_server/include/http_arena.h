@@ -0,0 +1,67 @@
+#pragma once
+
+/**
+ * Per-request bump arenas for the REST API's cJSON work.
+ *
+ * A handler builds a tree of dozens of small cJSON nodes, prints it into a
+ * string that grows by doubling, and frees the lot a few hundred microseconds
+ * later — or parses a POST body into the same kind of tree. On the heap that
+ * is the one allocation pattern in the firmware that runs all day and at the
+ * rate clients choose. Instead, api_handlers.c wraps every route so it runs
+ * with an arena from a fixed, statically placed pool bound to the httpd task:
+ * cJSON's hooks bump-allocate from it, frees are no-ops (bar the newest
+ * block), and the whole arena is emptied when the handler returns.
+ *
+ * The hooks are global, so they look up the calling task: any other task's
+ * cJSON (WebSocket broadcast, history, OTA manifest) and a request whose arena
+ * is full both fall back to malloc(), and cJSON_free() tells the two apart by
+ * address. Strings from cJSON_Print*() must therefore be released with
+ * cJSON_free(), never free().
+ */
+
+#include "cJSON.h"
+#include "freertos/FreeRTOS.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct http_arena http_arena_t;
+
+/* Arena use of one route, accumulated over its requests. */
+typedef struct {
+    uint32_t requests;
+    uint32_t high_water; /* most bytes any one request held at once */
+    uint32_t fallbacks;  /* allocations that didn't fit and went to the heap */
+    uint32_t no_arena;   /* requests that found the pool empty and ran on the heap */
+} http_arena_stats_t;
+
+/* Carve up the pool, point cJSON's hooks at it and account it to
+ * mem_budget. Call once before the first request; idempotent. */
+void http_arena_init(void);
+
+/* Bind a free arena to the calling task until http_arena_end(). Returns NULL
+ * when every arena is in use; the request then allocates from the heap. */
+http_arena_t *http_arena_begin(void);
+
+/* Fold the request's usage into `stats` (may be NULL), empty the arena and
+ * return it to the pool. Everything allocated from it is gone: nothing from a
+ * request may outlive it. `arena` may be NULL (see http_arena_begin). */
+void http_arena_end(http_arena_t *arena, http_arena_stats_t *stats);
+
+/* cJSON_PrintUnformatted(), but printed in place into whatever the calling
+ * task's arena has left, so the response costs its own length and no more.
+ * Falls back to cJSON_PrintUnformatted() without an arena or room. Release
+ * with cJSON_free(). */
+char *http_arena_print(const cJSON *item);
+
+/* The cJSON hooks, for other buffers a handler needs for the request only. */
+void *http_arena_malloc(size_t size);
+void http_arena_free(void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
@@ -3,6 +3,7 @@
 #include "esp_err.h"
 #include "esp_http_server.h"
 #include "firing_types.h"
+#include "firing_sim.h"
 #include "cJSON.h"
 #include "ota_manager.h"
 
@@ -64,6 +65,22 @@ void ws_send_ota_event(ota_phase_t phase, int percent, const char *err);
  */
 esp_err_t notification_task_start(void);
 
+/**
+ * Start the profile-simulation worker behind POST /api/v1/profiles/:id/simulate.
+ * Priority 1, so a dry run only uses time nothing else wants.
+ */
+esp_err_t sim_task_start(void);
+
+/**
+ * Run firing_sim_run() on the simulation worker and wait up to `timeout_ms`
+ * for the result in `out`. `cfg`'s yield hook is replaced by the worker's own.
+ * Runs are serialised; ESP_ERR_TIMEOUT if this one (or the wait for the one
+ * before it) takes too long — the run is then cancelled and `out` is partial.
+ * ESP_ERR_INVALID_STATE before sim_task_start(). Blocking.
+ */
+esp_err_t sim_task_run(const firing_profile_t *profile, const kiln_cap_t *cap, const firing_sim_config_t *cfg,
+                       firing_sim_result_t *out, uint32_t timeout_ms);
+
 /**
  * POST a JSON event to the configured webhook URL (5 s timeout). Blocking;
  * call from a worker task only.
@@ -88,6 +105,15 @@ const char *firing_status_to_string(firing_status_t s);
  */
 void json_add_progress_fields(cJSON *target, const firing_progress_t *prog, float current_temp);
 
+/**
+ * One page of the log ring (log_capture.h) for GET /api/v1/logs and the
+ * WebSocket "logs" topic: {"next", "entries":[{cursor, t, level, tag, msg}]},
+ * plus "dropped" (bytes of lines overwritten before they were read) when
+ * `*cursor` had fallen behind the oldest line. Reads up to `limit` lines from
+ * `*cursor` and advances it to the value returned as "next".
+ */
+cJSON *build_log_page_json(uint64_t *cursor, int limit);
+
 /* Internal: register API handlers (called by web_server_start) */
 esp_err_t api_handlers_register(httpd_handle_t server);
 esp_err_t ws_handler_register(httpd_handle_t server);
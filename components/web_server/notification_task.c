@@ -1,6 +1,8 @@
 #include "web_server.h"
 #include "firing_engine.h"
 #include "safety.h"
+#include "app_config.h"
+#include "mem_budget.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -8,6 +10,9 @@
 
 static const char *TAG = "notify";
 
+static MEM_PLACE(APP_MEM_NOTIFY_STACK) StackType_t s_task_stack[APP_TASK_NOTIFY_STACK];
+static StaticTask_t s_task_tcb;
+
 static void notification_task(void *arg)
 {
     (void)arg;
@@ -43,6 +48,11 @@ static void notification_task(void *arg)
 
 esp_err_t notification_task_start(void)
 {
-    BaseType_t ok = xTaskCreatePinnedToCore(notification_task, "notify", 6144, NULL, 1, NULL, 0);
-    return (ok == pdPASS) ? ESP_OK : ESP_ERR_NO_MEM;
+    TaskHandle_t task = xTaskCreateStaticPinnedToCore(notification_task, "notify", sizeof(s_task_stack), NULL, 1,
+                                                      s_task_stack, &s_task_tcb, 0);
+    if (!task) {
+        return ESP_ERR_NO_MEM;
+    }
+    mem_budget_add_task("web_server", task, APP_MEM_NOTIFY_STACK, sizeof(s_task_stack));
+    return ESP_OK;
 }
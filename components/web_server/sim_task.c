@@ -0,0 +1,109 @@
+#include "web_server.h"
+#include "app_config.h"
+#include "mem_budget.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+
+static const char *TAG = "sim";
+
+#define SIM_BIT_DONE BIT0
+
+static MEM_PLACE(APP_MEM_SIM_STACK) StackType_t s_task_stack[APP_TASK_SIM_STACK];
+static StaticTask_t s_task_tcb;
+static TaskHandle_t s_task;
+
+static SemaphoreHandle_t s_lock; /* one run at a time */
+static MEM_PLACE(APP_MEM_KERNEL_OBJECTS) StaticSemaphore_t s_lock_buf;
+static EventGroupHandle_t s_events;
+static MEM_PLACE(APP_MEM_KERNEL_OBJECTS) StaticEventGroup_t s_events_buf;
+
+/* The run in hand. Filled by sim_task_run() before it wakes the worker; the
+   caller stays blocked until SIM_BIT_DONE, so the pointers outlive the run. */
+static struct {
+    const firing_profile_t *profile;
+    const kiln_cap_t *cap;
+    firing_sim_config_t cfg;
+    firing_sim_result_t *out;
+} s_job;
+static volatile bool s_cancel;
+
+/* Between stretches of simulated time: let the idle task in, so a long run
+   at this priority never starves the task watchdog, and stop if asked. */
+static bool sim_yield(void *ctx)
+{
+    (void)ctx;
+    vTaskDelay(1);
+    return !s_cancel;
+}
+
+static void sim_task(void *arg)
+{
+    (void)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        int64_t t0 = esp_timer_get_time();
+        firing_sim_run(s_job.profile, s_job.cap, &s_job.cfg, s_job.out);
+        ESP_LOGI(TAG, "simulated %s: %us in %lldms, outcome %d", s_job.profile->id, (unsigned)s_job.out->duration_s,
+                 (long long)((esp_timer_get_time() - t0) / 1000), (int)s_job.out->outcome);
+        xEventGroupSetBits(s_events, SIM_BIT_DONE);
+    }
+}
+
+esp_err_t sim_task_run(const firing_profile_t *profile, const kiln_cap_t *cap, const firing_sim_config_t *cfg,
+                       firing_sim_result_t *out, uint32_t timeout_ms)
+{
+    if (!s_task) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    TickType_t wait = pdMS_TO_TICKS(timeout_ms);
+    if (xSemaphoreTake(s_lock, wait) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    s_job.profile = profile;
+    s_job.cap = cap;
+    s_job.cfg = *cfg;
+    s_job.cfg.yield = sim_yield;
+    s_job.cfg.ctx = NULL;
+    s_job.out = out;
+    s_cancel = false;
+    xEventGroupClearBits(s_events, SIM_BIT_DONE);
+    xTaskNotifyGive(s_task);
+
+    esp_err_t err = ESP_OK;
+    if (!(xEventGroupWaitBits(s_events, SIM_BIT_DONE, pdTRUE, pdTRUE, wait) & SIM_BIT_DONE)) {
+        /* Out of time: the run stops at its next yield, and the caller's
+           buffers must not go away before it has. */
+        s_cancel = true;
+        xEventGroupWaitBits(s_events, SIM_BIT_DONE, pdTRUE, pdTRUE, portMAX_DELAY);
+        err = ESP_ERR_TIMEOUT;
+    }
+    xSemaphoreGive(s_lock);
+    return err;
+}
+
+esp_err_t sim_task_start(void)
+{
+    if (s_task) {
+        return ESP_OK;
+    }
+    s_lock = xSemaphoreCreateMutexStatic(&s_lock_buf);
+    s_events = xEventGroupCreateStatic(&s_events_buf);
+    if (!s_lock || !s_events) {
+        return ESP_ERR_NO_MEM;
+    }
+    mem_budget_add("web_server", "sim mutex", APP_MEM_KERNEL_OBJECTS, sizeof(s_lock_buf));
+    mem_budget_add("web_server", "sim events", APP_MEM_KERNEL_OBJECTS, sizeof(s_events_buf));
+
+    /* Priority 1: a dry run only ever gets time nothing else wants. */
+    s_task = xTaskCreateStaticPinnedToCore(sim_task, "sim", sizeof(s_task_stack), NULL, 1, s_task_stack, &s_task_tcb,
+                                           0);
+    if (!s_task) {
+        return ESP_ERR_NO_MEM;
+    }
+    mem_budget_add_task("web_server", s_task, APP_MEM_SIM_STACK, sizeof(s_task_stack));
+    return ESP_OK;
+}
@@ -178,7 +178,7 @@ esp_err_t web_server_start(void)
 
     httpd_config_t config = HTTPD_DEFAULT_CONFIG();
     config.uri_match_fn = httpd_uri_match_wildcard;
-    config.max_uri_handlers = 40; /* bumped for OTA + Wi-Fi endpoints */
+    config.max_uri_handlers = 48; /* bumped for OTA + Wi-Fi + profile planning endpoints */
     config.stack_size = 12288;
     config.lru_purge_enable = true;
     config.max_open_sockets = 7;
@@ -1,6 +1,9 @@
 #include "web_server.h"
 #include "firing_engine.h"
 #include "thermocouple.h"
+#include "app_config.h"
+#include "mem_budget.h"
+#include "log_capture.h"
 #include "esp_log.h"
 #include "cJSON.h"
 #include "freertos/FreeRTOS.h"
@@ -11,25 +14,71 @@
 
 static const char *TAG = "ws";
 
-/* Track connected WebSocket file descriptors. Mutated from the httpd task (on
- * connect) and the broadcast worker task (pruning dead fds on send failure), so
- * every access is guarded by s_ws_mutex. */
+/* Track connected WebSocket clients. Mutated from the httpd task (on connect
+ * and on a subscribe message) and the broadcast worker task (pruning dead fds
+ * on send failure, advancing log cursors), so every access is guarded by
+ * s_ws_mutex. */
 #define MAX_WS_CLIENTS 4
-static int s_ws_fds[MAX_WS_CLIENTS];
+
+typedef struct {
+    int fd;
+    bool logs;           /* subscribed to the "logs" topic */
+    uint64_t log_cursor; /* next log ring line to send it */
+} ws_client_t;
+
+static ws_client_t s_ws_clients[MAX_WS_CLIENTS];
 static int s_ws_count = 0;
 static SemaphoreHandle_t s_ws_mutex;
+static MEM_PLACE(APP_MEM_KERNEL_OBJECTS) StaticSemaphore_t s_ws_mutex_buf;
 
 /* Broadcast worker task */
 static TaskHandle_t s_ws_task = NULL;
+static MEM_PLACE(APP_MEM_WS_BROADCAST_STACK) StackType_t s_ws_task_stack[APP_TASK_WS_BROADCAST_STACK];
+static StaticTask_t s_ws_task_tcb;
 
-/* The client sends no application data (this is a one-way telemetry channel), so
- * any inbound frame is tiny. Cap it so a malfunctioning or hostile client can't
- * make the device malloc() an arbitrary, header-advertised length and exhaust
- * the heap out from under the firing/safety tasks. */
+/* Clients send nothing but small topic subscriptions, so any inbound frame is
+ * tiny. Cap it so a malfunctioning or hostile client can't make the device
+ * malloc() an arbitrary, header-advertised length and exhaust the heap out
+ * from under the firing/safety tasks. */
 #define MAX_WS_FRAME_LEN 1024
 
+/* Lines pushed to a "logs" subscriber per broadcast tick; a backlog drains
+ * over the following ticks. */
+#define WS_LOG_BATCH 32
+
 /* ── WebSocket handler ─────────────────────────────── */
 
+/* {"type":"subscribe"|"unsubscribe","topic":"logs","since":N}. Without
+   "since" a subscriber gets lines logged from now on; with it (e.g. the
+   "next" of a GET /api/v1/logs page) it picks up from there. */
+static void ws_handle_message(int fd, const char *text)
+{
+    cJSON *msg = cJSON_Parse(text);
+    const char *type = cJSON_GetStringValue(cJSON_GetObjectItem(msg, "type"));
+    const char *topic = cJSON_GetStringValue(cJSON_GetObjectItem(msg, "topic"));
+    if (!type || !topic || strcmp(topic, "logs") != 0) {
+        cJSON_Delete(msg);
+        return;
+    }
+    bool subscribe = strcmp(type, "subscribe") == 0;
+    uint64_t oldest, next;
+    uint32_t boots;
+    log_capture_range(&oldest, &next, &boots);
+    const cJSON *since = cJSON_GetObjectItem(msg, "since");
+    uint64_t cursor = cJSON_IsNumber(since) && since->valuedouble >= 0 ? (uint64_t)since->valuedouble : next;
+    cJSON_Delete(msg);
+
+    xSemaphoreTake(s_ws_mutex, portMAX_DELAY);
+    for (int i = 0; i < s_ws_count; i++) {
+        if (s_ws_clients[i].fd == fd) {
+            s_ws_clients[i].logs = subscribe;
+            s_ws_clients[i].log_cursor = cursor;
+        }
+    }
+    xSemaphoreGive(s_ws_mutex);
+    ESP_LOGD(TAG, "WS fd=%d %s logs", fd, subscribe ? "subscribed to" : "unsubscribed from");
+}
+
 static esp_err_t ws_handler(httpd_req_t *req)
 {
     if (req->method == HTTP_GET) {
@@ -40,15 +89,16 @@ static esp_err_t ws_handler(httpd_req_t *req)
         }
         bool already = false;
         for (int i = 0; i < s_ws_count; i++) {
-            if (s_ws_fds[i] == fd) {
+            if (s_ws_clients[i].fd == fd) {
                 already = true; /* fd reused for a fresh handshake; keep one entry */
+                s_ws_clients[i].logs = false;
                 break;
             }
         }
         if (already) {
             ESP_LOGD(TAG, "WebSocket fd=%d already tracked", fd);
         } else if (s_ws_count < MAX_WS_CLIENTS) {
-            s_ws_fds[s_ws_count++] = fd;
+            s_ws_clients[s_ws_count++] = (ws_client_t){.fd = fd};
             ESP_LOGI(TAG, "WebSocket client connected (fd=%d, total=%d)", fd, s_ws_count);
         } else {
             /* Not silent: the client completes the handshake but will never get
@@ -87,7 +137,7 @@ static esp_err_t ws_handler(httpd_req_t *req)
         if (ret == ESP_OK) {
             buf[ws_pkt.len] = '\0';
             ESP_LOGD(TAG, "WS received: %s", (char *)buf);
-            /* Could handle client commands here in the future */
+            ws_handle_message(httpd_req_to_sockfd(req), (char *)buf);
         }
         free(buf);
     }
@@ -121,7 +171,9 @@ void ws_broadcast(const char *json, size_t len)
         xSemaphoreTake(s_ws_mutex, portMAX_DELAY);
     }
     n = s_ws_count;
-    memcpy(fds, s_ws_fds, (size_t)n * sizeof(fds[0]));
+    for (int i = 0; i < n; i++) {
+        fds[i] = s_ws_clients[i].fd;
+    }
     if (s_ws_mutex) {
         xSemaphoreGive(s_ws_mutex);
     }
@@ -151,7 +203,7 @@ void ws_broadcast(const char *json, size_t len)
         }
         int valid = 0;
         for (int i = 0; i < s_ws_count; i++) {
-            int fd = s_ws_fds[i];
+            int fd = s_ws_clients[i].fd;
             bool was_dead = false;
             for (int j = 0; j < n_dead; j++) {
                 if (fd == dead[j]) {
@@ -162,7 +214,7 @@ void ws_broadcast(const char *json, size_t len)
             if (was_dead && httpd_ws_get_fd_info(server, fd) != HTTPD_WS_CLIENT_WEBSOCKET) {
                 continue; /* still gone → drop */
             }
-            s_ws_fds[valid++] = fd;
+            s_ws_clients[valid++] = s_ws_clients[i];
         }
         s_ws_count = valid;
         if (s_ws_mutex) {
@@ -195,7 +247,64 @@ void ws_broadcast_status(void)
 
     if (json) {
         ws_broadcast(json, strlen(json));
-        free(json);
+        cJSON_free(json);
+    }
+}
+
+/* ── Log topic ──────────────────────────────────────── */
+
+/* Push each "logs" subscriber the lines logged since its cursor, as
+   {"type":"log","data":{next, entries}} to that client alone. Runs on the
+   broadcast worker task. */
+static void ws_push_logs(void)
+{
+    httpd_handle_t server = web_server_get_handle();
+    if (!server || !s_ws_mutex) {
+        return;
+    }
+    ws_client_t subs[MAX_WS_CLIENTS];
+    int n = 0;
+    xSemaphoreTake(s_ws_mutex, portMAX_DELAY);
+    for (int i = 0; i < s_ws_count; i++) {
+        if (s_ws_clients[i].logs) {
+            subs[n++] = s_ws_clients[i];
+        }
+    }
+    xSemaphoreGive(s_ws_mutex);
+
+    for (int i = 0; i < n; i++) {
+        uint64_t cursor = subs[i].log_cursor;
+        cJSON *data = build_log_page_json(&cursor, WS_LOG_BATCH);
+        if (cJSON_GetArraySize(cJSON_GetObjectItem(data, "entries")) > 0) {
+            cJSON *root = cJSON_CreateObject();
+            cJSON_AddStringToObject(root, "type", "log");
+            cJSON_AddItemToObject(root, "data", data);
+            char *json = cJSON_PrintUnformatted(root);
+            cJSON_Delete(root);
+            httpd_ws_frame_t ws_pkt = {
+                .final = true,
+                .type = HTTPD_WS_TYPE_TEXT,
+                .payload = (uint8_t *)json,
+                .len = json ? strlen(json) : 0,
+            };
+            /* A failed send is left to ws_broadcast()'s pruning. */
+            if (json && httpd_ws_get_fd_info(server, subs[i].fd) == HTTPD_WS_CLIENT_WEBSOCKET) {
+                httpd_ws_send_frame_async(server, subs[i].fd, &ws_pkt);
+            }
+            cJSON_free(json);
+        } else {
+            cJSON_Delete(data);
+        }
+
+        /* Only advance a subscription that is still the same one. */
+        xSemaphoreTake(s_ws_mutex, portMAX_DELAY);
+        for (int j = 0; j < s_ws_count; j++) {
+            ws_client_t *c = &s_ws_clients[j];
+            if (c->fd == subs[i].fd && c->logs && c->log_cursor == subs[i].log_cursor) {
+                c->log_cursor = cursor;
+            }
+        }
+        xSemaphoreGive(s_ws_mutex);
     }
 }
 
@@ -230,7 +339,7 @@ void ws_send_ota_event(ota_phase_t phase, int percent, const char *err)
     cJSON_Delete(root);
     if (json) {
         ws_broadcast(json, strlen(json));
-        free(json);
+        cJSON_free(json);
     }
 }
 
@@ -249,6 +358,7 @@ static void ws_broadcast_task(void *arg)
     for (;;) {
         ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
         ws_broadcast_status();
+        ws_push_logs();
     }
 }
 
@@ -257,8 +367,13 @@ esp_err_t ws_handler_start(void)
     if (s_ws_task) {
         return ESP_OK;
     }
-    BaseType_t ok = xTaskCreatePinnedToCore(ws_broadcast_task, "ws_broadcast", 4096, NULL, 2, &s_ws_task, 0);
-    return (ok == pdPASS) ? ESP_OK : ESP_ERR_NO_MEM;
+    s_ws_task = xTaskCreateStaticPinnedToCore(ws_broadcast_task, "ws_broadcast", sizeof(s_ws_task_stack), NULL, 2,
+                                              s_ws_task_stack, &s_ws_task_tcb, 0);
+    if (!s_ws_task) {
+        return ESP_ERR_NO_MEM;
+    }
+    mem_budget_add_task("web_server", s_ws_task, APP_MEM_WS_BROADCAST_STACK, sizeof(s_ws_task_stack));
+    return ESP_OK;
 }
 
 /* ── Register ──────────────────────────────────────── */
@@ -269,11 +384,12 @@ esp_err_t ws_handler_register(httpd_handle_t server)
        server bring-up on a single task). Guards the fd table for the lifetime
        of the server. */
     if (!s_ws_mutex) {
-        s_ws_mutex = xSemaphoreCreateMutex();
+        s_ws_mutex = xSemaphoreCreateMutexStatic(&s_ws_mutex_buf);
         if (!s_ws_mutex) {
             ESP_LOGE(TAG, "Failed to create WebSocket client mutex");
             return ESP_ERR_NO_MEM;
         }
+        mem_budget_add("web_server", "ws mutex", APP_MEM_KERNEL_OBJECTS, sizeof(s_ws_mutex_buf));
     }
 
     httpd_uri_t ws_uri = {
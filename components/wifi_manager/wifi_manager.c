@@ -5,6 +5,8 @@
 #include "esp_log.h"
 #include "nvs_flash.h"
 #include "nvs.h"
+#include "app_config.h"
+#include "mem_budget.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
 #include <string.h>
@@ -15,6 +17,7 @@ static const char *TAG = "wifi_mgr";
 #define WIFI_FAIL_BIT      BIT1
 
 static EventGroupHandle_t s_wifi_event_group;
+static MEM_PLACE(APP_MEM_KERNEL_OBJECTS) StaticEventGroup_t s_wifi_event_group_buf;
 static int s_retry_count = 0;
 static int s_max_retries = 5;
 static bool s_is_ap_mode = false;
@@ -96,7 +99,8 @@ esp_err_t wifi_manager_init(const char *sta_ssid, const char *sta_pass, const ch
 {
     s_ap_ssid = ap_ssid;
     s_ap_pass = ap_pass;
-    s_wifi_event_group = xEventGroupCreate();
+    s_wifi_event_group = xEventGroupCreateStatic(&s_wifi_event_group_buf);
+    mem_budget_add("wifi_manager", "event group", APP_MEM_KERNEL_OBJECTS, sizeof(s_wifi_event_group_buf));
 
     ESP_ERROR_CHECK(esp_netif_init());
     ESP_ERROR_CHECK(esp_event_loop_create_default());
@@ -6,6 +6,7 @@ struct FiringSegment: Codable, Identifiable, Hashable {
     var rampRate: Double    // degrees per hour
     var targetTemp: Double  // degrees C
     var holdTime: Double    // minutes (0 = hold indefinitely)
+    var endConeId: Int?     // cone-table id; firmware also ends the segment once the heat work reaches it
 
     var formattedDescription: String {
         "\(rampRate > 0 ? "+" : "")\(Int(rampRate))°C/hr → \(Int(targetTemp))°C\(holdTime > 0 ? ", hold \(Int(holdTime))m" : "")"
@@ -12,6 +12,8 @@
 #include "esp_sntp.h"
 
 #include "app_config.h"
+#include "mem_budget.h"
+#include "log_capture.h"
 #include "thermocouple.h"
 #include "firing_engine.h"
 #include "safety.h"
@@ -21,9 +23,23 @@
 #include "boot_status.h"
 #include "firing_history.h"
 #include "status_led.h"
+#include "rt_stats.h"
 
 static const char *TAG = "main";
 
+/* Long-lived task stacks and TCBs, placed per app_config.h. Static so no heap
+ * state at boot — or later — decides whether a task can start. */
+static MEM_PLACE(APP_MEM_SAFETY_STACK) StackType_t s_safety_stack[APP_TASK_SAFETY_STACK];
+static MEM_PLACE(APP_MEM_TEMP_READ_STACK) StackType_t s_temp_read_stack[APP_TASK_TEMP_READ_STACK];
+static MEM_PLACE(APP_MEM_FIRING_STACK) StackType_t s_firing_stack[APP_TASK_FIRING_STACK];
+static MEM_PLACE(APP_MEM_DISPLAY_STACK) StackType_t s_display_stack[APP_TASK_DISPLAY_STACK];
+static MEM_PLACE(APP_MEM_STATUS_LED_STACK) StackType_t s_status_led_stack[APP_TASK_STATUS_LED_STACK];
+static StaticTask_t s_safety_tcb;
+static StaticTask_t s_temp_read_tcb;
+static StaticTask_t s_firing_tcb;
+static StaticTask_t s_display_tcb;
+static StaticTask_t s_status_led_tcb;
+
 static void ws_broadcast_timer_cb(void *arg)
 {
     (void)arg;
@@ -34,6 +50,9 @@ static void ws_broadcast_timer_cb(void *arg)
 
 void app_main(void)
 {
+    /* Before anything logs, so the ring has the whole boot. */
+    log_capture_init();
+
     /* version already carries a leading 'v' (git describe of v* tags). */
     ESP_LOGI(TAG, "=== Bisque %s ===", esp_app_get_description()->version);
 
@@ -52,7 +71,7 @@ void app_main(void)
         .sclk_io_num = APP_PIN_SPI_SCLK,
         .quadwp_io_num = -1,
         .quadhd_io_num = -1,
-        .max_transfer_sz = APP_LCD_H_RES * 40 * 2,
+        .max_transfer_sz = APP_SPI_MAX_TRANSFER_SZ,
     };
     ESP_ERROR_CHECK(spi_bus_initialize(APP_SPI_HOST, &spi_bus_cfg, SPI_DMA_CH_AUTO));
     ESP_LOGI(TAG, "SPI bus initialized");
@@ -81,17 +100,18 @@ void app_main(void)
     }
 
     /* Bring up the display task immediately so the splash is on-screen during
-     * the slow init steps below (Wi-Fi can take up to 30 s). The task gets a
-     * hard error check because if internal SRAM is too tight to satisfy the
-     * 16 KiB stack, FreeRTOS silently returns errCOULD_NOT_ALLOCATE and the UI
-     * just never starts (with no diagnostic) — easier to crash loudly. */
+     * the slow init steps below (Wi-Fi can take up to 30 s). Its 16 KiB stack
+     * is static, so this can't fail for want of internal RAM the way a heap
+     * stack could; the check stays for a bad argument. */
     if (display_initialized) {
-        BaseType_t disp_rc = xTaskCreatePinnedToCore(display_task, "display", APP_TASK_DISPLAY_STACK, NULL,
-                                                     APP_TASK_DISPLAY_PRIO, NULL, 0);
-        if (disp_rc != pdPASS) {
-            ESP_LOGE(TAG, "Failed to create display_task (rc=%d) — out of internal RAM?", (int)disp_rc);
+        TaskHandle_t disp_task =
+            xTaskCreateStaticPinnedToCore(display_task, "display", sizeof(s_display_stack), NULL,
+                                          APP_TASK_DISPLAY_PRIO, s_display_stack, &s_display_tcb, 0);
+        if (!disp_task) {
+            ESP_LOGE(TAG, "Failed to create display_task");
             abort();
         }
+        mem_budget_add_task("display", disp_task, APP_MEM_DISPLAY_STACK, sizeof(s_display_stack));
     } else {
         ESP_LOGW(TAG, "Display task skipped; controller will run headless");
     }
@@ -174,18 +194,25 @@ void app_main(void)
     /* ── Create FreeRTOS Tasks ─────────────────────── */
 
     /* Core 1: Real-time control tasks */
-    xTaskCreatePinnedToCore(safety_task, "safety", APP_TASK_SAFETY_STACK, NULL, APP_TASK_SAFETY_PRIO, NULL, 1);
+    TaskHandle_t task = xTaskCreateStaticPinnedToCore(safety_task, "safety", sizeof(s_safety_stack), NULL,
+                                                      APP_TASK_SAFETY_PRIO, s_safety_stack, &s_safety_tcb, 1);
+    mem_budget_add_task("safety", task, APP_MEM_SAFETY_STACK, sizeof(s_safety_stack));
 
-    xTaskCreatePinnedToCore(temp_read_task, "temp_read", APP_TASK_TEMP_READ_STACK, NULL, APP_TASK_TEMP_READ_PRIO, NULL,
-                            1);
+    task = xTaskCreateStaticPinnedToCore(temp_read_task, "temp_read", sizeof(s_temp_read_stack), NULL,
+                                         APP_TASK_TEMP_READ_PRIO, s_temp_read_stack, &s_temp_read_tcb, 1);
+    mem_budget_add_task("thermocouple", task, APP_MEM_TEMP_READ_STACK, sizeof(s_temp_read_stack));
 
-    xTaskCreatePinnedToCore(firing_task, "firing", APP_TASK_FIRING_STACK, NULL, APP_TASK_FIRING_PRIO, NULL, 1);
+    task = xTaskCreateStaticPinnedToCore(firing_task, "firing", sizeof(s_firing_stack), NULL, APP_TASK_FIRING_PRIO,
+                                         s_firing_stack, &s_firing_tcb, 1);
+    mem_budget_add_task("firing_engine", task, APP_MEM_FIRING_STACK, sizeof(s_firing_stack));
 
     /* Core 0: UI + network tasks. (display_task was created earlier, right after
      * display_init, so the splash could render during the Wi-Fi wait above.) */
 
     if (status_led_initialized) {
-        xTaskCreatePinnedToCore(status_led_task, "status_led", 2048, NULL, 1, NULL, 0);
+        task = xTaskCreateStaticPinnedToCore(status_led_task, "status_led", sizeof(s_status_led_stack), NULL, 1,
+                                             s_status_led_stack, &s_status_led_tcb, 0);
+        mem_budget_add_task("status_led", task, APP_MEM_STATUS_LED_STACK, sizeof(s_status_led_stack));
     } else {
         ESP_LOGW(TAG, "Status LED task skipped");
     }
@@ -193,6 +220,7 @@ void app_main(void)
     /* ── Workers driven off firing engine + WS broadcast timer ── */
     ESP_ERROR_CHECK(ws_handler_start());
     ESP_ERROR_CHECK(notification_task_start());
+    ESP_ERROR_CHECK(sim_task_start());
 
     const esp_timer_create_args_t ws_timer_args = {
         .callback = ws_broadcast_timer_cb,
@@ -209,9 +237,13 @@ void app_main(void)
        reverts to the previous firmware. */
     ota_confirm_task_start();
 
+    /* Every long-lived task exists now; start the per-window CPU sampler. */
+    rt_stats_init();
+
     boot_status_set("Ready");
     boot_status_mark_ready();
 
     ESP_LOGI(TAG, "=== Bisque started successfully ===");
     ESP_LOGI(TAG, "Free heap: %lu bytes", (unsigned long)esp_get_free_heap_size());
+    mem_budget_report();
 }
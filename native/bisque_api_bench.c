@@ -0,0 +1,679 @@
+/**
+ * bisque_api_bench — throughput and cost of the REST API and WebSocket
+ * push, measured on the firmware's own handlers (api_handlers.c,
+ * ws_handler.c, web_server.c) with no network in the way.
+ *
+ *   bisque_api_bench --duration 2000 --out api_bench.json
+ *   bisque_api_bench --filter ws_ --mix status=6,ws_fanout_4=1,trace=1
+ *   bisque_api_bench --soak 600000
+ *
+ * The handlers run on port/httpd_mem.c, which replaces the socket server
+ * with direct calls, against a state directory seeded with a full profile
+ * list and a full history of ten-hour firings. Each workload — one route, one
+ * WebSocket broadcast to N clients, or a weighted mix of them — runs
+ * back-to-back on this thread for --duration, and reports:
+ *
+ *   - requests per second: the ceiling for one httpd task with a host core
+ *     to itself, so compare routes and commits, not absolute numbers with
+ *     the ESP32;
+ *   - CPU time per request (this thread's, so timers and other threads
+ *     don't count), p50/p99/mean;
+ *   - heap allocations and bytes per request, and the peak heap above the
+ *     request's starting point — counted by wrapping malloc() and friends
+ *     for this thread, so libc's own (stdio buffers on fopen) are included;
+ *   - response bytes as they would go on the wire;
+ *
+ * and, once the runs are done, each route's request-arena high-water mark and
+ * heap spills, read back from GET /api/v1/diagnostics/http-arena.
+ *
+ * --soak MS runs only the mix, for MS, in quarter-second slices, and checks
+ * that after the first slice the live heap never grows: handlers allocate
+ * from request arenas that are emptied after every request, so growth is a
+ * leak (or a route spilling to the heap and keeping it).
+ *
+ * The engine is idle and no firing_task runs: these are the handlers' costs
+ * alone, which on the device come out of the same cores firing_task needs.
+ *
+ * Exit status: 0 ok, 1 a workload's request failed, 2 usage/IO.
+ */
+#include "app_config.h"
+#include "cJSON.h"
+#include "cone_table.h"
+#include "esp_log.h"
+#include "firing_engine.h"
+#include "firing_history.h"
+#include "httpd_mem.h"
+#include "native_port.h"
+#include "nvs_flash.h"
+#include "safety.h"
+#include "thermocouple.h"
+#include "web_server.h"
+
+#include <ftw.h>
+#include <inttypes.h>
+#include <getopt.h>
+#include <malloc.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_SAMPLES      (1u << 20)
+#define MAX_MIX          8
+#define WARMUP_REQUESTS  32
+#define TRACE_SAMPLES    600 /* ten hours at history's one sample per minute */
+#define SOAK_SLICE_MS    250
+
+/* ── Heap accounting ──────────────────────────────── */
+
+/* glibc's entry points, under the names it keeps for exactly this. Defining
+   malloc() here takes every caller in the process, libc included; only this
+   thread's counters move, so the firmware's timer and event threads stay out
+   of the numbers. */
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t nmemb, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void __libc_free(void *ptr);
+
+typedef struct {
+    uint64_t allocs;
+    uint64_t bytes;
+    int64_t live;
+    int64_t peak;
+} heap_stats_t;
+
+static __thread heap_stats_t t_heap;
+
+static void note_alloc(void *p)
+{
+    if (p) {
+        size_t n = malloc_usable_size(p);
+        t_heap.allocs++;
+        t_heap.bytes += n;
+        t_heap.live += (int64_t)n;
+        if (t_heap.live > t_heap.peak) {
+            t_heap.peak = t_heap.live;
+        }
+    }
+}
+
+void *malloc(size_t size)
+{
+    void *p = __libc_malloc(size);
+    note_alloc(p);
+    return p;
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+    void *p = __libc_calloc(nmemb, size);
+    note_alloc(p);
+    return p;
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    size_t old = ptr ? malloc_usable_size(ptr) : 0;
+    void *p = __libc_realloc(ptr, size);
+    if (p || size == 0) {
+        t_heap.live -= (int64_t)old;
+    }
+    note_alloc(p);
+    return p;
+}
+
+void free(void *ptr)
+{
+    if (ptr) {
+        t_heap.live -= (int64_t)malloc_usable_size(ptr);
+    }
+    __libc_free(ptr);
+}
+
+/* ── Fixture ──────────────────────────────────────── */
+
+static httpd_handle_t s_server;
+static char s_profile_uri[64];
+static char s_trace_uri[64];
+static int s_ws_fds[8];
+static int s_ws_open;
+
+static void seed_profiles(void)
+{
+    static const cone_id_t cones[] = {CONE_06, CONE_04, CONE_6, CONE_10};
+    for (int i = 0; i < FIRING_MAX_PROFILES; i++) {
+        firing_profile_t p;
+        cone_fire_generate(cones[i % 4], (cone_speed_t)(i % 3), i & 1, i & 2, &p);
+        snprintf(p.id, sizeof(p.id), "bench-%02d", i);
+        snprintf(p.name, sizeof(p.name), "Bench %s #%d", cone_name(cones[i % 4]), i);
+        firing_engine_save_profile(&p);
+    }
+    snprintf(s_profile_uri, sizeof(s_profile_uri), "/api/v1/profiles/bench-%02d", FIRING_MAX_PROFILES / 2);
+}
+
+static void seed_history(void)
+{
+    for (int i = 0; i < HISTORY_MAX_RECORDS; i++) {
+        history_firing_start("bench-00", "Bench cone 6");
+        for (int k = 0; k < TRACE_SAMPLES; k++) {
+            /* Up over 8 h, down over 2: a plausible curve for the CSV's width. */
+            float t = k < 480 ? 20.0f + 1202.0f * (float)k / 480.0f : 1222.0f - 5.0f * (float)(k - 480);
+            history_record_temp((uint32_t)k * 60, t);
+        }
+        history_firing_end(HISTORY_OUTCOME_COMPLETE, 1222.0f, TRACE_SAMPLES * 60, 0);
+    }
+    history_record_t newest;
+    if (history_get_records(&newest, 1) == 1) {
+        snprintf(s_trace_uri, sizeof(s_trace_uri), "/api/v1/history/%" PRIu32 "/trace", newest.id);
+    }
+}
+
+/* The parts of app_main the API reads from, without starting its tasks. */
+static bool bench_setup(void)
+{
+    native_clock_start();
+    native_board_init();
+    if (nvs_flash_init() != ESP_OK) {
+        return false;
+    }
+    spi_bus_config_t bus = {.mosi_io_num = -1, .miso_io_num = -1, .sclk_io_num = -1};
+    spi_bus_initialize(APP_SPI_HOST, &bus, SPI_DMA_CH_AUTO);
+    if (thermocouple_init(APP_SPI_HOST, APP_PIN_TC_CS) != ESP_OK ||
+        safety_init(APP_PIN_SSR, APP_DEFAULT_MAX_SAFE_TEMP) != ESP_OK || firing_engine_init() != ESP_OK ||
+        web_server_start() != ESP_OK || history_init() != ESP_OK) {
+        return false;
+    }
+    s_server = web_server_get_handle();
+    seed_profiles();
+    seed_history();
+    return s_trace_uri[0] != '\0';
+}
+
+/* Keep exactly `n` WebSocket clients connected. */
+static void ws_clients(int n)
+{
+    while (s_ws_open > n) {
+        httpd_mem_ws_close(s_server, s_ws_fds[--s_ws_open]);
+    }
+    while (s_ws_open < n) {
+        s_ws_fds[s_ws_open++] = httpd_mem_ws_open(s_server, "/api/v1/ws");
+    }
+}
+
+/* ── Workloads ────────────────────────────────────── */
+
+typedef struct {
+    size_t wire_len;
+    bool ok;
+} op_result_t;
+
+static httpd_mem_resp_t s_resp;
+
+static op_result_t get(const char *uri)
+{
+    httpd_mem_request(s_server, HTTP_GET, uri, NULL, NULL, 0, &s_resp);
+    return (op_result_t){.wire_len = s_resp.wire_len, .ok = s_resp.status == 200 && s_resp.handler_ret == ESP_OK};
+}
+
+static op_result_t op_status(void)
+{
+    return get("/api/v1/status");
+}
+
+static op_result_t op_profiles(void)
+{
+    return get("/api/v1/profiles");
+}
+
+static op_result_t op_profile(void)
+{
+    return get(s_profile_uri);
+}
+
+static op_result_t op_settings(void)
+{
+    return get("/api/v1/settings");
+}
+
+static op_result_t op_system(void)
+{
+    return get("/api/v1/system");
+}
+
+static op_result_t op_history(void)
+{
+    return get("/api/v1/history");
+}
+
+static op_result_t op_trace(void)
+{
+    return get(s_trace_uri);
+}
+
+/* One temp_update push, as the 1 s timer triggers it, to whoever is
+   connected. The wire bytes are every client's. */
+static op_result_t op_ws_broadcast(void)
+{
+    size_t before = 0, after = 0;
+    httpd_mem_ws_stats_t st;
+    for (int i = 0; i < s_ws_open; i++) {
+        before += httpd_mem_ws_stats(s_server, s_ws_fds[i], &st) ? st.wire_len : 0;
+    }
+    ws_broadcast_status();
+    for (int i = 0; i < s_ws_open; i++) {
+        after += httpd_mem_ws_stats(s_server, s_ws_fds[i], &st) ? st.wire_len : 0;
+    }
+    return (op_result_t){.wire_len = after - before, .ok = s_ws_open == 0 || after > before};
+}
+
+typedef struct {
+    const char *name;
+    op_result_t (*op)(void);
+    int ws_clients;
+} workload_t;
+
+static const workload_t WORKLOADS[] = {
+    {"status", op_status, 0},
+    {"profiles", op_profiles, 0},
+    {"profile", op_profile, 0},
+    {"settings", op_settings, 0},
+    {"system", op_system, 0},
+    {"history", op_history, 0},
+    {"trace", op_trace, 0},
+    {"ws_fanout_1", op_ws_broadcast, 1},
+    {"ws_fanout_2", op_ws_broadcast, 2},
+    {"ws_fanout_4", op_ws_broadcast, 4},
+};
+#define WORKLOAD_COUNT (sizeof(WORKLOADS) / sizeof(WORKLOADS[0]))
+
+/* The default mix: a browser and the app polling status, with the others
+   pulling a profile list, a trace or history now and then, and four
+   dashboards on the WebSocket. */
+#define DEFAULT_MIX "status=8,ws_fanout_4=2,profiles=1,profile=1,history=1,trace=1"
+
+typedef struct {
+    const workload_t *w;
+    int weight;
+    int credit; /* smooth weighted round-robin */
+} mix_entry_t;
+
+static const workload_t *find_workload(const char *name, size_t len)
+{
+    for (size_t i = 0; i < WORKLOAD_COUNT; i++) {
+        if (strlen(WORKLOADS[i].name) == len && strncmp(WORKLOADS[i].name, name, len) == 0) {
+            return &WORKLOADS[i];
+        }
+    }
+    return NULL;
+}
+
+/* "name=weight,..." with at most one ws_fanout_N, since the clients stay
+   connected for the whole mix. Returns the entry count, or -1. */
+static int parse_mix(const char *spec, mix_entry_t *out)
+{
+    int n = 0, ws = 0;
+    for (const char *p = spec; *p;) {
+        size_t len = strcspn(p, ",");
+        const char *eq = memchr(p, '=', len);
+        const workload_t *w = find_workload(p, eq ? (size_t)(eq - p) : len);
+        int weight = eq ? atoi(eq + 1) : 1;
+        if (!w || weight <= 0 || n == MAX_MIX || (w->ws_clients && ws)) {
+            return -1;
+        }
+        ws |= w->ws_clients;
+        out[n++] = (mix_entry_t){.w = w, .weight = weight};
+        p += len + (p[len] == ',');
+    }
+    return n > 0 ? n : -1;
+}
+
+/* ── Measurement ──────────────────────────────────── */
+
+typedef struct {
+    uint32_t requests;
+    uint32_t failures;
+    double wall_s;
+    double cpu_p50_us;
+    double cpu_p99_us;
+    double cpu_mean_us;
+    double allocs_per_req;
+    double alloc_bytes_per_req;
+    int64_t peak_heap_bytes; /* highest any one request went above its start */
+    int64_t retained_bytes;  /* live heap growth over the whole run */
+    double wire_bytes_per_req;
+} run_result_t;
+
+static double clock_ns(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of a sorted array. */
+static double percentile(const double *sorted, uint32_t n, double p)
+{
+    uint32_t rank = (uint32_t)ceil(p / 100.0 * n);
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+/* Next workload of a mix: smooth weighted round-robin, so the interleaving
+   is even rather than in weight-sized bursts. */
+static const workload_t *mix_next(mix_entry_t *mix, int n)
+{
+    int total = 0, best = 0;
+    for (int i = 0; i < n; i++) {
+        mix[i].credit += mix[i].weight;
+        total += mix[i].weight;
+        if (mix[i].credit > mix[best].credit) {
+            best = i;
+        }
+    }
+    mix[best].credit -= total;
+    return mix[best].w;
+}
+
+static void run_workload(mix_entry_t *mix, int n, double duration_ns, double *samples, run_result_t *out)
+{
+    int clients = 0;
+    for (int i = 0; i < n; i++) {
+        clients = mix[i].w->ws_clients > clients ? mix[i].w->ws_clients : clients;
+    }
+    ws_clients(clients);
+    for (int i = 0; i < WARMUP_REQUESTS; i++) {
+        mix_next(mix, n)->op();
+    }
+
+    *out = (run_result_t){0};
+    uint64_t wire = 0;
+    heap_stats_t start = t_heap;
+    double wall0 = clock_ns(CLOCK_MONOTONIC);
+    double wall = wall0;
+    while (wall - wall0 < duration_ns && out->requests < MAX_SAMPLES) {
+        const workload_t *w = mix_next(mix, n);
+        int64_t live0 = t_heap.live;
+        t_heap.peak = live0;
+        double cpu0 = clock_ns(CLOCK_THREAD_CPUTIME_ID);
+        op_result_t r = w->op();
+        samples[out->requests++] = clock_ns(CLOCK_THREAD_CPUTIME_ID) - cpu0;
+        if (t_heap.peak - live0 > out->peak_heap_bytes) {
+            out->peak_heap_bytes = t_heap.peak - live0;
+        }
+        out->failures += !r.ok;
+        wire += r.wire_len;
+        wall = clock_ns(CLOCK_MONOTONIC);
+    }
+
+    uint32_t count = out->requests;
+    double cpu_total = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        cpu_total += samples[i];
+    }
+    qsort(samples, count, sizeof(samples[0]), cmp_double);
+    out->wall_s = (wall - wall0) / 1e9;
+    out->cpu_p50_us = percentile(samples, count, 50) / 1e3;
+    out->cpu_p99_us = percentile(samples, count, 99) / 1e3;
+    out->cpu_mean_us = cpu_total / count / 1e3;
+    out->allocs_per_req = (double)(t_heap.allocs - start.allocs) / count;
+    out->alloc_bytes_per_req = (double)(t_heap.bytes - start.bytes) / count;
+    out->retained_bytes = t_heap.live - start.live;
+    out->wire_bytes_per_req = (double)wire / count;
+}
+
+static cJSON *result_json(const char *name, const run_result_t *r)
+{
+    cJSON *o = cJSON_CreateObject();
+    cJSON_AddStringToObject(o, "name", name);
+    cJSON_AddNumberToObject(o, "requests", r->requests);
+    cJSON_AddNumberToObject(o, "failures", r->failures);
+    cJSON_AddNumberToObject(o, "rps", r->requests / r->wall_s);
+    cJSON_AddNumberToObject(o, "cpu_p50_us", r->cpu_p50_us);
+    cJSON_AddNumberToObject(o, "cpu_p99_us", r->cpu_p99_us);
+    cJSON_AddNumberToObject(o, "cpu_mean_us", r->cpu_mean_us);
+    cJSON_AddNumberToObject(o, "allocs_per_req", r->allocs_per_req);
+    cJSON_AddNumberToObject(o, "alloc_bytes_per_req", r->alloc_bytes_per_req);
+    cJSON_AddNumberToObject(o, "peak_heap_bytes", (double)r->peak_heap_bytes);
+    cJSON_AddNumberToObject(o, "retained_bytes", (double)r->retained_bytes);
+    cJSON_AddNumberToObject(o, "wire_bytes_per_req", r->wire_bytes_per_req);
+    return o;
+}
+
+static void print_result(const char *name, const run_result_t *r)
+{
+    fprintf(stderr, "%-12s %9.0f req/s  cpu p50 %8.1f us  p99 %8.1f us  %6.1f allocs %8.0f B  peak %7lld B  %s\n",
+            name, r->requests / r->wall_s, r->cpu_p50_us, r->cpu_p99_us, r->allocs_per_req,
+            r->alloc_bytes_per_req, (long long)r->peak_heap_bytes, r->failures ? "FAILED" : "");
+}
+
+/* Every single workload (or those matching `filter`), then the mix. Returns
+   1 if any request failed. */
+static int run_all(mix_entry_t *mix, int mix_count, const char *mix_spec, const char *filter, double duration_ms,
+                   double *samples, cJSON *report)
+{
+    int status = 0;
+    cJSON_AddNumberToObject(report, "duration_ms", duration_ms);
+    cJSON *arr = cJSON_AddArrayToObject(report, "workloads");
+    for (size_t i = 0; i < WORKLOAD_COUNT; i++) {
+        const workload_t *w = &WORKLOADS[i];
+        if (filter && !strstr(w->name, filter)) {
+            continue;
+        }
+        mix_entry_t single = {.w = w, .weight = 1};
+        run_result_t r;
+        run_workload(&single, 1, duration_ms * 1e6, samples, &r);
+        print_result(w->name, &r);
+        cJSON_AddItemToArray(arr, result_json(w->name, &r));
+        status |= r.failures > 0;
+    }
+
+    run_result_t r;
+    run_workload(mix, mix_count, duration_ms * 1e6, samples, &r);
+    print_result("mix", &r);
+    cJSON *m = result_json("mix", &r);
+    cJSON_AddStringToObject(m, "spec", mix_spec);
+    cJSON_AddItemToObject(report, "mix", m);
+    status |= r.failures > 0;
+    return status;
+}
+
+/* ── Request arenas ───────────────────────────────── */
+
+/* The firmware's own per-route arena figures, accumulated over every request
+   the runs made. Printed for the routes that were hit; the report gets the
+   endpoint's JSON as is. */
+static cJSON *arena_report(void)
+{
+    httpd_mem_request(s_server, HTTP_GET, "/api/v1/diagnostics/http-arena", NULL, NULL, 0, &s_resp);
+    cJSON *root = s_resp.status == 200 ? cJSON_Parse(s_resp.body) : NULL;
+    cJSON *routes = cJSON_GetObjectItem(root, "routes");
+    if (!routes) {
+        fprintf(stderr, "bisque_api_bench: no arena diagnostics (%d)\n", s_resp.status);
+        return root;
+    }
+    int size = (int)cJSON_GetNumberValue(cJSON_GetObjectItem(root, "arenaSize"));
+    for (cJSON *r = routes->child; r; r = r->next) {
+        if (cJSON_GetNumberValue(cJSON_GetObjectItem(r, "requests")) == 0) {
+            continue;
+        }
+        int spills = (int)(cJSON_GetNumberValue(cJSON_GetObjectItem(r, "heapFallbacks")) +
+                           cJSON_GetNumberValue(cJSON_GetObjectItem(r, "noArena")));
+        fprintf(stderr, "arena  %-6s %-28s high-water %6.0f of %d B  %s\n",
+                cJSON_GetStringValue(cJSON_GetObjectItem(r, "method")),
+                cJSON_GetStringValue(cJSON_GetObjectItem(r, "uri")),
+                cJSON_GetNumberValue(cJSON_GetObjectItem(r, "highWater")), size, spills ? "SPILLED" : "");
+    }
+    return root;
+}
+
+/* ── Soak ─────────────────────────────────────────── */
+
+/* The mix in SOAK_SLICE_MS slices. The first slice may still grow the heap
+   (stdio buffers, lazily created sessions); after it, any slice that ends
+   with more live heap than it started with fails the soak. */
+static bool run_soak(mix_entry_t *mix, int n, double duration_ms, double *samples, cJSON *report)
+{
+    int slices = (int)ceil(duration_ms / SOAK_SLICE_MS);
+    uint64_t requests = 0;
+    uint32_t failures = 0;
+    int64_t growth = 0;
+    int grew = 0;
+    for (int i = 0; i < slices; i++) {
+        run_result_t r;
+        run_workload(mix, n, SOAK_SLICE_MS * 1e6, samples, &r);
+        requests += r.requests;
+        failures += r.failures;
+        if (i > 0 && r.retained_bytes > 0) {
+            growth += r.retained_bytes;
+            grew++;
+            fprintf(stderr, "soak slice %d: live heap grew %lld B\n", i, (long long)r.retained_bytes);
+        }
+    }
+    fprintf(stderr, "soak   %d x %d ms  %" PRIu64 " requests  %u failures  heap growth %lld B in %d slices  %s\n",
+            slices, SOAK_SLICE_MS, requests, failures, (long long)growth, grew,
+            failures || grew ? "FAILED" : "ok");
+
+    cJSON *o = cJSON_AddObjectToObject(report, "soak");
+    cJSON_AddNumberToObject(o, "duration_ms", slices * SOAK_SLICE_MS);
+    cJSON_AddNumberToObject(o, "requests", (double)requests);
+    cJSON_AddNumberToObject(o, "failures", failures);
+    cJSON_AddNumberToObject(o, "heap_growth_bytes", (double)growth);
+    cJSON_AddNumberToObject(o, "slices_grown", grew);
+    return failures == 0 && grew == 0;
+}
+
+/* ── Main ─────────────────────────────────────────── */
+
+static int remove_entry(const char *path, const struct stat *sb, int type, struct FTW *ftw)
+{
+    return remove(path);
+}
+
+static void usage(FILE *out)
+{
+    fprintf(out, "usage: bisque_api_bench [options]\n"
+                 "\n"
+                 "  -d, --duration MS   time per workload (default 1000)\n"
+                 "  -m, --mix SPEC      weighted mix run after the single workloads, as\n"
+                 "                      name=weight,... (default " DEFAULT_MIX ")\n"
+                 "  -f, --filter STR    only run single workloads whose name contains STR\n"
+                 "  -o, --out FILE      write the report JSON here (default stdout)\n"
+                 "  -q, --quick         20 ms per workload (smoke run; numbers are noisy)\n"
+                 "  -s, --soak MS       run only the mix, for MS, and fail if the heap grows\n"
+                 "  -h, --help\n"
+                 "\n"
+                 "workloads: status profiles profile settings system history trace\n"
+                 "           ws_fanout_1 ws_fanout_2 ws_fanout_4\n");
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option opts[] = {
+        {"duration", required_argument, NULL, 'd'},
+        {"mix", required_argument, NULL, 'm'},
+        {"filter", required_argument, NULL, 'f'},
+        {"out", required_argument, NULL, 'o'},
+        {"quick", no_argument, NULL, 'q'},
+        {"soak", required_argument, NULL, 's'},
+        {"help", no_argument, NULL, 'h'},
+        {0},
+    };
+
+    double duration_ms = 1000;
+    const char *mix_spec = DEFAULT_MIX;
+    const char *filter = NULL;
+    const char *out_path = NULL;
+    double soak_ms = 0;
+
+    int c;
+    while ((c = getopt_long(argc, argv, "d:m:f:o:qs:h", opts, NULL)) != -1) {
+        switch (c) {
+        case 'd':
+            duration_ms = strtod(optarg, NULL);
+            break;
+        case 'm':
+            mix_spec = optarg;
+            break;
+        case 'f':
+            filter = optarg;
+            break;
+        case 'o':
+            out_path = optarg;
+            break;
+        case 'q':
+            duration_ms = 20;
+            break;
+        case 's':
+            soak_ms = strtod(optarg, NULL);
+            if (!(soak_ms > 0)) {
+                usage(stderr);
+                return 2;
+            }
+            break;
+        case 'h':
+            usage(stdout);
+            return 0;
+        default:
+            usage(stderr);
+            return 2;
+        }
+    }
+    mix_entry_t mix[MAX_MIX];
+    int mix_count = parse_mix(mix_spec, mix);
+    if (optind != argc || !(duration_ms > 0) || mix_count < 0) {
+        usage(stderr);
+        return 2;
+    }
+
+    char state_dir[] = "/tmp/bisque_api_bench.XXXXXX";
+    if (!mkdtemp(state_dir)) {
+        perror("bisque_api_bench: mkdtemp");
+        return 2;
+    }
+    native_cfg.state_dir = state_dir;
+    native_cfg.www_dir = NULL;
+    native_cfg.kiln = &KILN_MODEL_SMALL_TEST;
+    native_cfg.log_level = ESP_LOG_ERROR;
+
+    int status = 0;
+    double *samples = __libc_malloc(MAX_SAMPLES * sizeof(double));
+    if (!samples || !bench_setup()) {
+        fprintf(stderr, "bisque_api_bench: setup failed\n");
+        status = 2;
+        goto out;
+    }
+
+    cJSON *report = cJSON_CreateObject();
+    if (soak_ms > 0) {
+        status |= !run_soak(mix, mix_count, soak_ms, samples, report);
+        cJSON_AddStringToObject(cJSON_GetObjectItem(report, "soak"), "spec", mix_spec);
+    } else {
+        status |= run_all(mix, mix_count, mix_spec, filter, duration_ms, samples, report);
+    }
+    cJSON_AddItemToObject(report, "arena", arena_report());
+
+    char *json = cJSON_Print(report);
+    cJSON_Delete(report);
+    FILE *f = json ? (out_path ? fopen(out_path, "w") : stdout) : NULL;
+    bool io_ok = f && fprintf(f, "%s\n", json) > 0;
+    if (f && f != stdout) {
+        io_ok = (fclose(f) == 0) && io_ok;
+    }
+    cJSON_free(json);
+    if (!io_ok) {
+        fprintf(stderr, "bisque_api_bench: write failed\n");
+        status = 2;
+    }
+
+out:
+    __libc_free(samples);
+    nftw(state_dir, remove_entry, 8, FTW_DEPTH | FTW_PHYS);
+    return status;
+}
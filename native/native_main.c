@@ -0,0 +1,139 @@
+/**
+ * bisque_twin — the whole firmware, built for Linux against native/port, with
+ * the host kiln model wired behind the SSR and thermocouple.
+ *
+ *   bisque_twin --port 8080 --kiln large --speed 60 --www spiffs_data/www
+ *
+ * The REST API, WebSocket and web UI are the device's own handlers, so the
+ * web UI, the iOS app and load or latency scripts can point at
+ * http://localhost:PORT with no hardware. NVS, SPIFFS contents and the OTA
+ * slots persist under --state-dir, so settings and history survive a restart
+ * (including POST /api/v1/system/restart, which re-executes the process).
+ */
+#include "esp_log.h"
+#include "native_port.h"
+
+#include <errno.h>
+#include <getopt.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+void app_main(void);
+
+static void usage(FILE *out)
+{
+    fprintf(out, "usage: bisque_twin [options]\n"
+                 "\n"
+                 "  -p, --port N           HTTP port (default 8080)\n"
+                 "  -d, --state-dir DIR    NVS, SPIFFS and OTA slots (default ./twin-state)\n"
+                 "  -w, --www DIR          web UI image served when DIR/<file> is not in the\n"
+                 "                         state dir (e.g. spiffs_data/www)\n"
+                 "  -k, --kiln NAME        kiln model: small | large (default small)\n"
+                 "  -s, --start-temp C     starting kiln temperature (default 20)\n"
+                 "  -x, --speed X          twin seconds per wall-clock second (default 1)\n"
+                 "  -l, --log-level LEVEL  error | warn | info | debug | verbose (default info)\n"
+                 "  -h, --help\n");
+}
+
+static int parse_log_level(const char *s)
+{
+    static const char *const names[] = {"none", "error", "warn", "info", "debug", "verbose"};
+    for (int i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++) {
+        if (strcasecmp(s, names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option opts[] = {
+        {"port", required_argument, NULL, 'p'},
+        {"state-dir", required_argument, NULL, 'd'},
+        {"www", required_argument, NULL, 'w'},
+        {"kiln", required_argument, NULL, 'k'},
+        {"start-temp", required_argument, NULL, 's'},
+        {"speed", required_argument, NULL, 'x'},
+        {"log-level", required_argument, NULL, 'l'},
+        {"help", no_argument, NULL, 'h'},
+        {0},
+    };
+
+    native_cfg.argv = argv;
+    native_cfg.kiln = &KILN_MODEL_SMALL_TEST;
+
+    int c;
+    while ((c = getopt_long(argc, argv, "p:d:w:k:s:x:l:h", opts, NULL)) != -1) {
+        switch (c) {
+        case 'p': {
+            long port = strtol(optarg, NULL, 10);
+            if (port <= 0 || port > 65535) {
+                fprintf(stderr, "bisque_twin: bad port '%s'\n", optarg);
+                return 2;
+            }
+            native_cfg.http_port = (uint16_t)port;
+            break;
+        }
+        case 'd':
+            native_cfg.state_dir = optarg;
+            break;
+        case 'w':
+            native_cfg.www_dir = optarg;
+            break;
+        case 'k':
+            native_cfg.kiln = kiln_model_preset(optarg);
+            if (!native_cfg.kiln) {
+                fprintf(stderr, "bisque_twin: unknown kiln '%s' (small | large)\n", optarg);
+                return 2;
+            }
+            break;
+        case 's':
+            native_cfg.start_temp_c = strtof(optarg, NULL);
+            break;
+        case 'x':
+            native_cfg.speed = strtod(optarg, NULL);
+            if (!(native_cfg.speed > 0)) {
+                fprintf(stderr, "bisque_twin: --speed must be positive\n");
+                return 2;
+            }
+            break;
+        case 'l':
+            native_cfg.log_level = parse_log_level(optarg);
+            if (native_cfg.log_level < 0) {
+                fprintf(stderr, "bisque_twin: unknown log level '%s'\n", optarg);
+                return 2;
+            }
+            break;
+        case 'h':
+            usage(stdout);
+            return 0;
+        default:
+            usage(stderr);
+            return 2;
+        }
+    }
+
+    if (mkdir(native_cfg.state_dir, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "bisque_twin: cannot create %s: %s\n", native_cfg.state_dir, strerror(errno));
+        return 2;
+    }
+    /* A client vanishing mid-response is an error return from send(), as on
+       lwIP, not a process kill. */
+    signal(SIGPIPE, SIG_IGN);
+
+    native_clock_start();
+    native_board_init();
+    app_main();
+
+    /* Like the device, the firmware lives on in its tasks after app_main
+       returns. */
+    for (;;) {
+        pause();
+    }
+}
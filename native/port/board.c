@@ -0,0 +1,219 @@
+#include "native_port.h"
+
+#include "driver/gpio.h"
+#include "driver/ledc.h"
+#include "driver/spi_master.h"
+#include "esp_log.h"
+#include "led_strip.h"
+#include "sdkconfig.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+/* The board around the firmware: the kiln model (tests/host/kiln_model.c)
+   sits behind the SSR pin and answers the thermocouple's SPI reads as a
+   MAX31855 would. The model is advanced lazily, on the SSR level it has held
+   since the last call, whenever anything reads or changes that level — so it
+   integrates exactly what safety's time-proportioning produced, at any
+   --speed, without a thread of its own. */
+
+static const char *TAG = "board";
+
+#define KILN_MAX_STEP_US (1000LL * 1000LL)
+#define COLD_JUNCTION_C  25
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static kiln_model_t s_kiln;
+static int64_t s_kiln_us;
+static bool s_ssr_on;
+
+static void kiln_catch_up(void)
+{
+    int64_t now = native_clock_us();
+    while (s_kiln_us < now) {
+        int64_t step = now - s_kiln_us;
+        if (step > KILN_MAX_STEP_US) {
+            step = KILN_MAX_STEP_US;
+        }
+        kiln_model_step(&s_kiln, s_ssr_on ? 1.0f : 0.0f, (float)step / 1e6f);
+        s_kiln_us += step;
+    }
+}
+
+void native_board_init(void)
+{
+    pthread_mutex_lock(&s_lock);
+    kiln_model_init(&s_kiln, native_cfg.kiln, native_cfg.start_temp_c);
+    s_kiln_us = native_clock_us();
+    pthread_mutex_unlock(&s_lock);
+    ESP_LOGI(TAG, "Kiln: %s at %.0f °C", native_cfg.kiln->name, native_cfg.start_temp_c);
+}
+
+void native_board_kiln(kiln_model_t *out, bool *ssr_on)
+{
+    pthread_mutex_lock(&s_lock);
+    kiln_catch_up();
+    *out = s_kiln;
+    *ssr_on = s_ssr_on;
+    pthread_mutex_unlock(&s_lock);
+}
+
+/* ── GPIO ─────────────────────────────────────────── */
+
+esp_err_t gpio_config(const gpio_config_t *cfg)
+{
+    return cfg ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    if (gpio_num == CONFIG_KILN_PIN_SSR) {
+        pthread_mutex_lock(&s_lock);
+        kiln_catch_up();
+        s_ssr_on = level != 0;
+        pthread_mutex_unlock(&s_lock);
+    }
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    pthread_mutex_lock(&s_lock);
+    int level = (gpio_num == CONFIG_KILN_PIN_SSR && s_ssr_on) ? 1 : 0;
+    pthread_mutex_unlock(&s_lock);
+    return level;
+}
+
+/* ── Alarm buzzer (LEDC) ──────────────────────────── */
+
+esp_err_t ledc_timer_config(const ledc_timer_config_t *cfg)
+{
+    return cfg ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t ledc_channel_config(const ledc_channel_config_t *cfg)
+{
+    return cfg ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t ledc_set_duty(ledc_mode_t mode, ledc_channel_t channel, uint32_t duty)
+{
+    return ESP_OK;
+}
+
+esp_err_t ledc_update_duty(ledc_mode_t mode, ledc_channel_t channel)
+{
+    return ESP_OK;
+}
+
+/* ── SPI: MAX31855 on the thermocouple chip select ── */
+
+static struct spi_device_t {
+    int cs;
+} s_devices[4];
+static int s_device_count;
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *bus_config, spi_common_dma_t dma_chan)
+{
+    return bus_config ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *cfg,
+                             spi_device_handle_t *out_handle)
+{
+    if (!cfg || !out_handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_device_count == (int)(sizeof(s_devices) / sizeof(s_devices[0]))) {
+        return ESP_ERR_NOT_FOUND; /* no free CS slot, as on the device */
+    }
+    s_devices[s_device_count].cs = cfg->spics_io_num;
+    *out_handle = &s_devices[s_device_count++];
+    return ESP_OK;
+}
+
+/* D31:18 thermocouple °C × 4, D15:4 cold junction °C × 16. */
+static uint32_t max31855_frame(float tc_c)
+{
+    uint32_t cj = (uint32_t)(COLD_JUNCTION_C * 16) & 0x0FFF;
+    int32_t q = (int32_t)lroundf(tc_c * 4.0f);
+    return (((uint32_t)q & 0x3FFF) << 18) | (cj << 4);
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans)
+{
+    if (!handle || !trans) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->cs != CONFIG_KILN_PIN_TC_CS) {
+        return ESP_OK; /* nothing else on the bus answers */
+    }
+    if (trans->length != 32 || !trans->rx_buffer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&s_lock);
+    kiln_catch_up();
+    uint32_t raw = max31855_frame(kiln_model_tc_reading(&s_kiln));
+    pthread_mutex_unlock(&s_lock);
+    uint8_t *rx = trans->rx_buffer;
+    rx[0] = (uint8_t)(raw >> 24);
+    rx[1] = (uint8_t)(raw >> 16);
+    rx[2] = (uint8_t)(raw >> 8);
+    rx[3] = (uint8_t)raw;
+    return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans)
+{
+    return spi_device_transmit(handle, trans);
+}
+
+/* No LCD on the twin's bus, so there is never anyone to wait for. */
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, TickType_t wait)
+{
+    (void)wait;
+    return device ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+void spi_device_release_bus(spi_device_handle_t dev)
+{
+    (void)dev;
+}
+
+/* ── Status LED ───────────────────────────────────── */
+
+struct led_strip_t {
+    uint8_t rgb[3];
+};
+
+esp_err_t led_strip_new_rmt_device(const led_strip_config_t *led_config, const led_strip_rmt_config_t *rmt_config,
+                                   led_strip_handle_t *ret_strip)
+{
+    if (!led_config || !rmt_config || !ret_strip) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *ret_strip = calloc(1, sizeof(struct led_strip_t));
+    return *ret_strip ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+esp_err_t led_strip_set_pixel(led_strip_handle_t strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue)
+{
+    if (index != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    strip->rgb[0] = (uint8_t)red;
+    strip->rgb[1] = (uint8_t)green;
+    strip->rgb[2] = (uint8_t)blue;
+    return ESP_OK;
+}
+
+esp_err_t led_strip_refresh(led_strip_handle_t strip)
+{
+    return ESP_OK;
+}
+
+esp_err_t led_strip_clear(led_strip_handle_t strip)
+{
+    strip->rgb[0] = strip->rgb[1] = strip->rgb[2] = 0;
+    return ESP_OK;
+}
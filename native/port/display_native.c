@@ -0,0 +1,59 @@
+#include "boot_status.h"
+#include "display.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <stdatomic.h>
+
+/* The twin has no panel: display_init() fails, and app_main carries on
+   headless exactly as it does on a board whose LCD didn't come up. The web
+   UI is the twin's screen. boot_status lives in splash.c on the device,
+   which isn't built here. */
+
+static const char *_Atomic s_status = "Booting...";
+static atomic_bool s_ready;
+
+esp_err_t display_init(spi_host_device_t host, int cs_pin, int dc_pin, int rst_pin, int bl_pin)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void display_task(void *param)
+{
+    vTaskDelete(NULL);
+}
+
+bool display_consume_left_press(void)
+{
+    return false;
+}
+
+bool display_consume_right_press(void)
+{
+    return false;
+}
+
+void display_backlight_on(void)
+{
+}
+
+void boot_status_set(const char *msg)
+{
+    atomic_store(&s_status, msg);
+}
+
+const char *boot_status_get(void)
+{
+    return atomic_load(&s_status);
+}
+
+void boot_status_mark_ready(void)
+{
+    atomic_store(&s_ready, true);
+}
+
+bool boot_status_is_ready(void)
+{
+    return atomic_load(&s_ready);
+}
@@ -0,0 +1,323 @@
+#include "esp_ota_ops.h"
+
+#include "esp_log.h"
+#include "esp_system.h"
+#include "native_port.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+/* The two app slots of partitions.csv as ota_0.bin / ota_1.bin in the state
+   directory, and otadata as otadata.txt ("boot state0 state1"). At process
+   start the bootloader's rollback rules (CONFIG_BOOTLOADER_APP_ROLLBACK_ENABLE)
+   are applied to it: a NEW boot slot becomes PENDING_VERIFY, and one still
+   PENDING_VERIFY — the last run never confirmed it — is ABORTED and the other
+   slot boots instead. Every slot runs this same binary; an image file only
+   supplies the version a slot reports. */
+
+static const char *TAG = "ota_native";
+
+#define IMAGE_MAGIC 0xE9 /* esp_image_header_t.magic */
+
+static const esp_partition_t s_slots[2] = {
+    {.subtype = 0x10, .address = 0x20000, .size = 0x400000, .label = "ota_0"},
+    {.subtype = 0x11, .address = 0x420000, .size = 0x400000, .label = "ota_1"},
+};
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t s_boot_once = PTHREAD_ONCE_INIT;
+static int s_boot = 0;
+static int s_running = 0;
+static esp_ota_img_states_t s_state[2] = {ESP_OTA_IMG_UNDEFINED, ESP_OTA_IMG_UNDEFINED};
+
+static FILE *s_write_file;
+static int s_write_slot = -1;
+static esp_ota_handle_t s_write_handle;
+static bool s_write_ok;
+
+static int slot_of(const esp_partition_t *p)
+{
+    if (p == &s_slots[0] || (p && strcmp(p->label, "ota_0") == 0)) {
+        return 0;
+    }
+    if (p == &s_slots[1] || (p && strcmp(p->label, "ota_1") == 0)) {
+        return 1;
+    }
+    return -1;
+}
+
+static void slot_path(char *out, size_t size, int slot)
+{
+    char name[24];
+    snprintf(name, sizeof(name), "ota_%d.bin", slot);
+    native_state_path(out, size, name);
+}
+
+static void save_otadata(void)
+{
+    char path[512];
+    native_state_path(path, sizeof(path), "otadata.txt");
+    FILE *f = fopen(path, "w");
+    if (f) {
+        fprintf(f, "%d %u %u\n", s_boot, (unsigned)s_state[0], (unsigned)s_state[1]);
+        fclose(f);
+    }
+}
+
+static void bootloader(void)
+{
+    char path[512];
+    native_state_path(path, sizeof(path), "otadata.txt");
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        /* Fresh state dir: this build was "flashed" to ota_0. */
+        s_state[0] = ESP_OTA_IMG_VALID;
+    } else {
+        unsigned st0, st1;
+        if (fscanf(f, "%d %u %u", &s_boot, &st0, &st1) == 3 && (s_boot == 0 || s_boot == 1)) {
+            s_state[0] = (esp_ota_img_states_t)st0;
+            s_state[1] = (esp_ota_img_states_t)st1;
+        } else {
+            s_boot = 0;
+        }
+        fclose(f);
+    }
+
+    if (s_state[s_boot] == ESP_OTA_IMG_PENDING_VERIFY) {
+        ESP_LOGW(TAG, "%s was never confirmed; rolling back", s_slots[s_boot].label);
+        s_state[s_boot] = ESP_OTA_IMG_ABORTED;
+        s_boot = 1 - s_boot;
+    } else if (s_state[s_boot] == ESP_OTA_IMG_NEW) {
+        s_state[s_boot] = ESP_OTA_IMG_PENDING_VERIFY;
+    }
+    s_running = s_boot;
+    save_otadata();
+    ESP_LOGI(TAG, "Booting %s", s_slots[s_running].label);
+}
+
+static void boot_once(void)
+{
+    pthread_once(&s_boot_once, bootloader);
+}
+
+const esp_partition_t *esp_ota_get_running_partition(void)
+{
+    boot_once();
+    return &s_slots[s_running];
+}
+
+const esp_partition_t *esp_ota_get_boot_partition(void)
+{
+    boot_once();
+    pthread_mutex_lock(&s_lock);
+    const esp_partition_t *p = &s_slots[s_boot];
+    pthread_mutex_unlock(&s_lock);
+    return p;
+}
+
+const esp_partition_t *esp_ota_get_next_update_partition(const esp_partition_t *start_from)
+{
+    boot_once();
+    int from = start_from ? slot_of(start_from) : s_running;
+    return from < 0 ? NULL : &s_slots[1 - from];
+}
+
+esp_err_t esp_ota_begin(const esp_partition_t *partition, size_t image_size, esp_ota_handle_t *out_handle)
+{
+    boot_once();
+    int slot = slot_of(partition);
+    if (slot < 0 || !out_handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (slot == s_running) {
+        return ESP_ERR_INVALID_STATE; /* ESP_ERR_OTA_PARTITION_CONFLICT on the device */
+    }
+    pthread_mutex_lock(&s_lock);
+    if (s_write_file) {
+        pthread_mutex_unlock(&s_lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+    char path[512];
+    slot_path(path, sizeof(path), slot);
+    s_write_file = fopen(path, "wb");
+    if (!s_write_file) {
+        pthread_mutex_unlock(&s_lock);
+        return ESP_FAIL;
+    }
+    /* Erasing the slot invalidates whatever image it held. */
+    s_state[slot] = ESP_OTA_IMG_UNDEFINED;
+    save_otadata();
+    s_write_slot = slot;
+    s_write_ok = true;
+    *out_handle = ++s_write_handle;
+    pthread_mutex_unlock(&s_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t size)
+{
+    pthread_mutex_lock(&s_lock);
+    esp_err_t err = ESP_ERR_INVALID_ARG;
+    if (s_write_file && handle == s_write_handle) {
+        err = fwrite(data, 1, size, s_write_file) == size ? ESP_OK : ESP_FAIL;
+        s_write_ok = s_write_ok && err == ESP_OK;
+    }
+    pthread_mutex_unlock(&s_lock);
+    return err;
+}
+
+static void finish_write(void)
+{
+    if (s_write_file) {
+        fclose(s_write_file);
+    }
+    s_write_file = NULL;
+    s_write_slot = -1;
+}
+
+/* Like the device, refuse an image that doesn't start with the ESP image
+   magic byte; nothing deeper is checked. */
+esp_err_t esp_ota_end(esp_ota_handle_t handle)
+{
+    pthread_mutex_lock(&s_lock);
+    if (!s_write_file || handle != s_write_handle) {
+        pthread_mutex_unlock(&s_lock);
+        return ESP_ERR_NOT_FOUND;
+    }
+    char path[512];
+    slot_path(path, sizeof(path), s_write_slot);
+    bool ok = s_write_ok;
+    finish_write();
+    pthread_mutex_unlock(&s_lock);
+
+    FILE *f = fopen(path, "rb");
+    int magic = f ? fgetc(f) : EOF;
+    if (f) {
+        fclose(f);
+    }
+    if (!ok) {
+        return ESP_FAIL;
+    }
+    return magic == IMAGE_MAGIC ? ESP_OK : ESP_ERR_OTA_VALIDATE_FAILED;
+}
+
+esp_err_t esp_ota_abort(esp_ota_handle_t handle)
+{
+    pthread_mutex_lock(&s_lock);
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    if (s_write_file && handle == s_write_handle) {
+        finish_write();
+        err = ESP_OK;
+    }
+    pthread_mutex_unlock(&s_lock);
+    return err;
+}
+
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t *partition)
+{
+    boot_once();
+    int slot = slot_of(partition);
+    if (slot < 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&s_lock);
+    s_boot = slot;
+    if (slot != s_running) {
+        s_state[slot] = ESP_OTA_IMG_NEW;
+    }
+    save_otadata();
+    pthread_mutex_unlock(&s_lock);
+    ESP_LOGI(TAG, "Next boot: %s", partition->label);
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_get_state_partition(const esp_partition_t *partition, esp_ota_img_states_t *out_state)
+{
+    boot_once();
+    int slot = slot_of(partition);
+    if (slot < 0 || !out_state) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&s_lock);
+    esp_ota_img_states_t state = s_state[slot];
+    pthread_mutex_unlock(&s_lock);
+    if (state == ESP_OTA_IMG_UNDEFINED) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    *out_state = state;
+    return ESP_OK;
+}
+
+/* The running slot describes this build. Another slot is described by the
+   esp_app_desc_t inside its image (after the 24-byte image header and the
+   8-byte first segment header), so an uploaded release .bin reports its own
+   version. */
+esp_err_t esp_ota_get_partition_description(const esp_partition_t *partition, esp_app_desc_t *out_desc)
+{
+    boot_once();
+    int slot = slot_of(partition);
+    if (slot < 0 || !out_desc) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (slot == s_running) {
+        *out_desc = *esp_app_get_description();
+        return ESP_OK;
+    }
+    char path[512];
+    slot_path(path, sizeof(path), slot);
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    uint8_t raw[32 + 16 + 128];
+    size_t n = fread(raw, 1, sizeof(raw), f);
+    fclose(f);
+    uint32_t magic = n == sizeof(raw) ? (uint32_t)raw[32] | (uint32_t)raw[33] << 8 | (uint32_t)raw[34] << 16 |
+                                            (uint32_t)raw[35] << 24
+                                      : 0;
+    if (magic != 0xABCD5432) { /* ESP_APP_DESC_MAGIC_WORD */
+        return ESP_ERR_NOT_FOUND;
+    }
+    memset(out_desc, 0, sizeof(*out_desc));
+    const uint8_t *d = raw + 48; /* version follows magic, secure_version and two reserved words */
+    memcpy(out_desc->version, d, sizeof(out_desc->version) - 1);
+    memcpy(out_desc->project_name, d + 32, sizeof(out_desc->project_name) - 1);
+    memcpy(out_desc->time, d + 64, sizeof(out_desc->time) - 1);
+    memcpy(out_desc->date, d + 80, sizeof(out_desc->date) - 1);
+    memcpy(out_desc->idf_ver, d + 96, sizeof(out_desc->idf_ver) - 1);
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_mark_app_valid_cancel_rollback(void)
+{
+    boot_once();
+    pthread_mutex_lock(&s_lock);
+    s_state[s_running] = ESP_OTA_IMG_VALID;
+    save_otadata();
+    pthread_mutex_unlock(&s_lock);
+    return ESP_OK;
+}
+
+bool esp_ota_check_rollback_is_possible(void)
+{
+    boot_once();
+    int other = 1 - s_running;
+    pthread_mutex_lock(&s_lock);
+    esp_ota_img_states_t st = s_state[other];
+    pthread_mutex_unlock(&s_lock);
+    return st != ESP_OTA_IMG_INVALID && st != ESP_OTA_IMG_ABORTED && st != ESP_OTA_IMG_UNDEFINED;
+}
+
+esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot(void)
+{
+    if (!esp_ota_check_rollback_is_possible()) {
+        return ESP_FAIL;
+    }
+    pthread_mutex_lock(&s_lock);
+    s_state[s_running] = ESP_OTA_IMG_INVALID;
+    s_boot = 1 - s_running;
+    save_otadata();
+    pthread_mutex_unlock(&s_lock);
+    esp_restart();
+}
@@ -0,0 +1,151 @@
+#include "esp_timer.h"
+
+#include "native_port.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/* Armed timers are kept in a plain list — the firmware has a handful — and a
+   single dispatcher thread runs whichever is due next, like ESP-IDF's
+   esp_timer task: a callback that blocks delays every other timer. */
+
+struct esp_timer {
+    esp_timer_cb_t callback;
+    void *arg;
+    const char *name;
+    bool armed;
+    int64_t due_us;
+    uint64_t period_us; /* 0 = one-shot */
+    struct esp_timer *next;
+};
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_changed;
+static struct esp_timer *s_timers;
+static pthread_once_t s_once = PTHREAD_ONCE_INIT;
+
+static struct esp_timer *earliest_armed(void)
+{
+    struct esp_timer *best = NULL;
+    for (struct esp_timer *t = s_timers; t; t = t->next) {
+        if (t->armed && (!best || t->due_us < best->due_us)) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+static void *dispatch_thread(void *arg)
+{
+    (void)arg;
+    pthread_setname_np(pthread_self(), "esp_timer");
+    pthread_mutex_lock(&s_lock);
+    for (;;) {
+        struct esp_timer *t = earliest_armed();
+        if (!t) {
+            native_cond_wait_until(&s_changed, &s_lock, INT64_MAX);
+            continue;
+        }
+        int64_t now = native_clock_us();
+        if (t->due_us > now) {
+            native_cond_wait_until(&s_changed, &s_lock, t->due_us);
+            continue;
+        }
+        if (t->period_us) {
+            t->due_us += (int64_t)t->period_us;
+            if (t->due_us <= now) {
+                t->due_us = now + (int64_t)t->period_us; /* fell behind: skip, don't burst */
+            }
+        } else {
+            t->armed = false;
+        }
+        esp_timer_cb_t cb = t->callback;
+        void *cb_arg = t->arg;
+        pthread_mutex_unlock(&s_lock);
+        cb(cb_arg);
+        pthread_mutex_lock(&s_lock);
+    }
+    return NULL;
+}
+
+static void start_dispatcher(void)
+{
+    native_cond_init(&s_changed);
+    pthread_t thread;
+    pthread_create(&thread, NULL, dispatch_thread, NULL);
+    pthread_detach(thread);
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out_handle)
+{
+    if (!args || !args->callback || !out_handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_once(&s_once, start_dispatcher);
+    struct esp_timer *t = calloc(1, sizeof(*t));
+    if (!t) {
+        return ESP_ERR_NO_MEM;
+    }
+    t->callback = args->callback;
+    t->arg = args->arg;
+    t->name = args->name;
+    pthread_mutex_lock(&s_lock);
+    t->next = s_timers;
+    s_timers = t;
+    pthread_mutex_unlock(&s_lock);
+    *out_handle = t;
+    return ESP_OK;
+}
+
+static esp_err_t arm(esp_timer_handle_t timer, uint64_t delay_us, uint64_t period_us)
+{
+    pthread_mutex_lock(&s_lock);
+    if (timer->armed) {
+        pthread_mutex_unlock(&s_lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->armed = true;
+    timer->due_us = native_clock_us() + (int64_t)delay_us;
+    timer->period_us = period_us;
+    pthread_cond_signal(&s_changed);
+    pthread_mutex_unlock(&s_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us)
+{
+    return period_us ? arm(timer, period_us, period_us) : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us)
+{
+    return arm(timer, timeout_us, 0);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    pthread_mutex_lock(&s_lock);
+    esp_err_t err = timer->armed ? ESP_OK : ESP_ERR_INVALID_STATE;
+    timer->armed = false;
+    pthread_mutex_unlock(&s_lock);
+    return err;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer)
+{
+    pthread_mutex_lock(&s_lock);
+    if (timer->armed) {
+        pthread_mutex_unlock(&s_lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+    for (struct esp_timer **p = &s_timers; *p; p = &(*p)->next) {
+        if (*p == timer) {
+            *p = timer->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&s_lock);
+    free(timer);
+    return ESP_OK;
+}
@@ -0,0 +1,459 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "esp_log.h"
+#include "native_port.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const char *TAG = "freertos";
+
+/* Tick → twin-clock deadline; portMAX_DELAY waits forever. */
+static int64_t deadline_after(TickType_t ticks)
+{
+    if (ticks == portMAX_DELAY) {
+        return INT64_MAX;
+    }
+    return native_clock_us() + (int64_t)ticks * (1000000 / CONFIG_FREERTOS_HZ);
+}
+
+/* ── Critical sections ────────────────────────────── */
+
+static pthread_mutex_t s_critical;
+static pthread_once_t s_critical_once = PTHREAD_ONCE_INIT;
+
+static void critical_init(void)
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&s_critical, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+void native_enter_critical(void)
+{
+    pthread_once(&s_critical_once, critical_init);
+    pthread_mutex_lock(&s_critical);
+}
+
+void native_exit_critical(void)
+{
+    pthread_mutex_unlock(&s_critical);
+}
+
+/* ── Tasks ────────────────────────────────────────── */
+
+struct native_task {
+    pthread_t thread;
+    char name[16];
+    uint32_t stack_depth; /* what the firmware asked for, in bytes */
+    TaskFunction_t fn;
+    void *param;
+    UBaseType_t priority;
+    int core;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t notify;
+    bool exited;              /* deleted itself; its thread is gone */
+    struct native_task *next; /* s_tasks, for uxTaskGetSystemState */
+};
+
+static __thread struct native_task *s_self;
+
+/* Every task with a running thread, newest first. Records are never freed. */
+static struct native_task *s_tasks;
+static pthread_mutex_t s_tasks_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void task_register(struct native_task *t)
+{
+    pthread_mutex_lock(&s_tasks_lock);
+    t->next = s_tasks;
+    s_tasks = t;
+    pthread_mutex_unlock(&s_tasks_lock);
+}
+
+static struct native_task *task_alloc(const char *name, UBaseType_t priority, int core)
+{
+    struct native_task *t = calloc(1, sizeof(*t));
+    if (!t) {
+        return NULL;
+    }
+    strlcpy(t->name, name ? name : "", sizeof(t->name));
+    t->priority = priority;
+    t->core = core;
+    pthread_mutex_init(&t->lock, NULL);
+    native_cond_init(&t->cond);
+    return t;
+}
+
+/* Threads that FreeRTOS never created (main, httpd, esp_timer) still take
+   notifications; give them a record the first time they ask. */
+static struct native_task *current_task(void)
+{
+    if (!s_self) {
+        char name[16] = "";
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+        s_self = task_alloc(name, 0, tskNO_AFFINITY);
+        if (!s_self) {
+            abort();
+        }
+        s_self->thread = pthread_self();
+        task_register(s_self);
+    }
+    return s_self;
+}
+
+static void *task_entry(void *arg)
+{
+    struct native_task *t = arg;
+    s_self = t;
+    pthread_setname_np(pthread_self(), t->name);
+    t->fn(t->param);
+    /* A FreeRTOS task function must never return. */
+    ESP_LOGE(TAG, "task %s returned from its function", t->name);
+    abort();
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *param,
+                                   UBaseType_t priority, TaskHandle_t *out_handle, BaseType_t core_id)
+{
+    struct native_task *t = task_alloc(name, priority, core_id);
+    if (!t) {
+        return pdFAIL;
+    }
+    t->fn = fn;
+    t->param = param;
+    t->stack_depth = stack_depth;
+    if (out_handle) {
+        *out_handle = t;
+    }
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    /* Host code paths (libc printf, getaddrinfo) need more than the device's
+       stack_depth; give every task the default 8 MiB rather than guess. */
+    int rc = pthread_create(&t->thread, &attr, task_entry, t);
+    pthread_attr_destroy(&attr);
+    if (rc != 0) {
+        if (out_handle) {
+            *out_handle = NULL;
+        }
+        free(t);
+        return pdFAIL;
+    }
+    task_register(t);
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *param,
+                       UBaseType_t priority, TaskHandle_t *out_handle)
+{
+    return xTaskCreatePinnedToCore(fn, name, stack_depth, param, priority, out_handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    if (task && task != s_self) {
+        ESP_LOGE(TAG, "vTaskDelete of another task (%s) is not supported", task->name);
+        abort();
+    }
+    /* The record stays allocated: other tasks may still hold the handle. */
+    if (s_self) {
+        pthread_mutex_lock(&s_tasks_lock);
+        s_self->exited = true;
+        pthread_mutex_unlock(&s_tasks_lock);
+    }
+    pthread_exit(NULL);
+}
+
+const char *pcTaskGetName(TaskHandle_t task)
+{
+    return (task ? task : current_task())->name;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+    /* Each thread runs on a default 8 MiB pthread stack, so the firmware's own
+       budget is never touched: report all of it as free. */
+    return (task ? task : current_task())->stack_depth;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return current_task();
+}
+
+static uint32_t clock_us(clockid_t clock)
+{
+    struct timespec ts;
+    if (clock_gettime(clock, &ts) != 0) {
+        return 0;
+    }
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000);
+}
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status, UBaseType_t size, configRUN_TIME_COUNTER_TYPE *total_run_time)
+{
+    UBaseType_t n = 0;
+    pthread_mutex_lock(&s_tasks_lock);
+    for (struct native_task *t = s_tasks; t; t = t->next) {
+        if (t->exited) {
+            continue;
+        }
+        if (n == size) {
+            n = 0; /* as FreeRTOS: nothing unless everything fits */
+            break;
+        }
+        clockid_t cpu;
+        status[n++] = (TaskStatus_t){
+            .xHandle = t,
+            .pcTaskName = t->name,
+            .uxCurrentPriority = t->priority,
+            .ulRunTimeCounter = pthread_getcpuclockid(t->thread, &cpu) == 0 ? clock_us(cpu) : 0,
+            .usStackHighWaterMark = t->stack_depth,
+            .xCoreID = t->core,
+        };
+    }
+    pthread_mutex_unlock(&s_tasks_lock);
+    if (total_run_time) {
+        *total_run_time = clock_us(CLOCK_MONOTONIC);
+    }
+    return n;
+}
+
+TaskHandle_t xTaskGetIdleTaskHandleForCore(BaseType_t core_id)
+{
+    (void)core_id;
+    return NULL;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(native_clock_us() / (1000000 / CONFIG_FREERTOS_HZ));
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    native_sleep_until(deadline_after(ticks));
+}
+
+BaseType_t xTaskDelayUntil(TickType_t *last_wake, TickType_t increment)
+{
+    TickType_t target = *last_wake + increment;
+    TickType_t now = xTaskGetTickCount();
+    *last_wake = target;
+    /* Signed distance so the comparison survives tick wrap-around. */
+    if ((int32_t)(target - now) <= 0) {
+        return pdFALSE;
+    }
+    vTaskDelay(target - now);
+    return pdTRUE;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    pthread_mutex_lock(&task->lock);
+    task->notify++;
+    pthread_cond_signal(&task->cond);
+    pthread_mutex_unlock(&task->lock);
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t timeout)
+{
+    struct native_task *t = current_task();
+    int64_t deadline = deadline_after(timeout);
+    pthread_mutex_lock(&t->lock);
+    while (t->notify == 0 && native_cond_wait_until(&t->cond, &t->lock, deadline)) {
+    }
+    uint32_t value = t->notify;
+    if (value) {
+        t->notify = clear_on_exit ? 0 : value - 1;
+    }
+    pthread_mutex_unlock(&t->lock);
+    return value;
+}
+
+/* ── Queues ───────────────────────────────────────── */
+
+struct native_queue {
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t count;
+    UBaseType_t head;
+    uint8_t *items;
+    const char *name;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    struct native_queue *q = calloc(1, sizeof(*q));
+    if (!q || length == 0) {
+        free(q);
+        return NULL;
+    }
+    q->items = item_size ? calloc(length, item_size) : NULL;
+    if (item_size && !q->items) {
+        free(q);
+        return NULL;
+    }
+    q->length = length;
+    q->item_size = item_size;
+    pthread_mutex_init(&q->lock, NULL);
+    native_cond_init(&q->not_empty);
+    native_cond_init(&q->not_full);
+    return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t timeout)
+{
+    int64_t deadline = deadline_after(timeout);
+    pthread_mutex_lock(&q->lock);
+    while (q->count == q->length) {
+        if (timeout == 0 || !native_cond_wait_until(&q->not_full, &q->lock, deadline)) {
+            if (q->count == q->length) {
+                pthread_mutex_unlock(&q->lock);
+                return pdFALSE;
+            }
+        }
+    }
+    if (q->item_size && item) {
+        UBaseType_t tail = (q->head + q->count) % q->length;
+        memcpy(q->items + (size_t)tail * q->item_size, item, q->item_size);
+    }
+    q->count++;
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->lock);
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *out, TickType_t timeout)
+{
+    int64_t deadline = deadline_after(timeout);
+    pthread_mutex_lock(&q->lock);
+    while (q->count == 0) {
+        if (timeout == 0 || !native_cond_wait_until(&q->not_empty, &q->lock, deadline)) {
+            if (q->count == 0) {
+                pthread_mutex_unlock(&q->lock);
+                return pdFALSE;
+            }
+        }
+    }
+    if (q->item_size) {
+        memcpy(out, q->items + (size_t)q->head * q->item_size, q->item_size);
+    }
+    q->head = (q->head + 1) % q->length;
+    q->count--;
+    pthread_cond_signal(&q->not_full);
+    pthread_mutex_unlock(&q->lock);
+    return pdTRUE;
+}
+
+void vQueueAddToRegistry(QueueHandle_t q, const char *name)
+{
+    if (q) {
+        q->name = name;
+    }
+}
+
+/* ── Mutexes ──────────────────────────────────────── */
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    QueueHandle_t q = xQueueCreate(1, 0);
+    if (q) {
+        xQueueSend(q, NULL, 0);
+    }
+    return q;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t timeout)
+{
+    return xQueueReceive(sem, NULL, timeout);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    return xQueueSend(sem, NULL, 0);
+}
+
+/* ── Event groups ─────────────────────────────────── */
+
+struct native_event_group {
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    EventBits_t bits;
+};
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    struct native_event_group *g = calloc(1, sizeof(*g));
+    if (g) {
+        pthread_mutex_init(&g->lock, NULL);
+        native_cond_init(&g->changed);
+    }
+    return g;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t g, EventBits_t bits)
+{
+    pthread_mutex_lock(&g->lock);
+    g->bits |= bits;
+    EventBits_t now = g->bits;
+    pthread_cond_broadcast(&g->changed);
+    pthread_mutex_unlock(&g->lock);
+    return now;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t g, EventBits_t bits)
+{
+    pthread_mutex_lock(&g->lock);
+    EventBits_t before = g->bits;
+    g->bits &= ~bits;
+    pthread_mutex_unlock(&g->lock);
+    return before;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t g)
+{
+    pthread_mutex_lock(&g->lock);
+    EventBits_t bits = g->bits;
+    pthread_mutex_unlock(&g->lock);
+    return bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t g, EventBits_t bits, BaseType_t clear_on_exit, BaseType_t wait_all,
+                                TickType_t timeout)
+{
+    int64_t deadline = deadline_after(timeout);
+    pthread_mutex_lock(&g->lock);
+    for (;;) {
+        EventBits_t set = g->bits & bits;
+        bool met = wait_all ? set == bits : set != 0;
+        if (met) {
+            EventBits_t value = g->bits;
+            if (clear_on_exit) {
+                g->bits &= ~bits;
+            }
+            pthread_mutex_unlock(&g->lock);
+            return value;
+        }
+        if (timeout == 0 || !native_cond_wait_until(&g->changed, &g->lock, deadline)) {
+            break;
+        }
+    }
+    EventBits_t value = g->bits;
+    pthread_mutex_unlock(&g->lock);
+    return value;
+}
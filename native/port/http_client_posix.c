@@ -0,0 +1,385 @@
+#include "esp_http_client.h"
+
+#include "esp_log.h"
+#include "native_port.h"
+
+#include <netdb.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+/* A blocking HTTP/1.1 client: one request per perform(), Connection: close,
+   Content-Length / chunked / read-to-close bodies, up to five redirects. Body
+   bytes are handed to the event handler as HTTP_EVENT_ON_DATA in
+   buffer_size pieces, as the IDF client does. */
+
+static const char *TAG = "http_client";
+
+#define MAX_REDIRECTS  5
+#define MAX_HEADERS    8
+#define DEFAULT_BUFFER 512
+
+struct esp_http_client {
+    esp_http_client_config_t cfg;
+    char *url;
+    char *headers[MAX_HEADERS];
+    int header_count;
+    const char *post_data;
+    int post_len;
+    int status;
+    int fd;
+    /* Receive buffer: bytes [pos, len) are unread. */
+    char rx[4096];
+    size_t rx_pos;
+    size_t rx_len;
+};
+
+esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *config)
+{
+    if (!config || !config->url) {
+        return NULL;
+    }
+    struct esp_http_client *c = calloc(1, sizeof(*c));
+    if (!c) {
+        return NULL;
+    }
+    c->cfg = *config;
+    c->url = strdup(config->url);
+    c->fd = -1;
+    if (!c->url) {
+        free(c);
+        return NULL;
+    }
+    return c;
+}
+
+esp_err_t esp_http_client_set_header(esp_http_client_handle_t client, const char *key, const char *value)
+{
+    if (client->header_count == MAX_HEADERS) {
+        return ESP_ERR_NO_MEM;
+    }
+    size_t len = strlen(key) + strlen(value) + 5;
+    char *line = malloc(len);
+    if (!line) {
+        return ESP_ERR_NO_MEM;
+    }
+    snprintf(line, len, "%s: %s\r\n", key, value);
+    client->headers[client->header_count++] = line;
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_set_post_field(esp_http_client_handle_t client, const char *data, int len)
+{
+    client->post_data = data;
+    client->post_len = len;
+    return ESP_OK;
+}
+
+int esp_http_client_get_status_code(esp_http_client_handle_t client)
+{
+    return client->status;
+}
+
+esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client)
+{
+    if (!client) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (client->fd >= 0) {
+        close(client->fd);
+    }
+    for (int i = 0; i < client->header_count; i++) {
+        free(client->headers[i]);
+    }
+    free(client->url);
+    free(client);
+    return ESP_OK;
+}
+
+/* "http://host[:port]/path" → parts. */
+static bool split_url(const char *url, char *host, size_t host_size, char *port, size_t port_size,
+                      const char **path)
+{
+    if (strncmp(url, "http://", 7) != 0) {
+        return false;
+    }
+    const char *h = url + 7;
+    const char *slash = strchr(h, '/');
+    *path = slash ? slash : "/";
+    size_t hlen = slash ? (size_t)(slash - h) : strlen(h);
+    const char *colon = memchr(h, ':', hlen);
+    size_t name_len = colon ? (size_t)(colon - h) : hlen;
+    if (name_len == 0 || name_len >= host_size) {
+        return false;
+    }
+    memcpy(host, h, name_len);
+    host[name_len] = '\0';
+    if (colon) {
+        size_t plen = hlen - name_len - 1;
+        if (plen == 0 || plen >= port_size) {
+            return false;
+        }
+        memcpy(port, colon + 1, plen);
+        port[plen] = '\0';
+    } else {
+        strlcpy(port, "80", port_size);
+    }
+    return true;
+}
+
+static int connect_to(const char *host, const char *port, int timeout_ms)
+{
+    struct addrinfo hints = {.ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM};
+    struct addrinfo *res;
+    if (getaddrinfo(host, port, &hints, &res) != 0) {
+        return -1;
+    }
+    int fd = -1;
+    for (struct addrinfo *ai = res; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        struct timeval tv = {.tv_sec = timeout_ms / 1000, .tv_usec = (timeout_ms % 1000) * 1000};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            break;
+        }
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    return fd;
+}
+
+static bool send_all(int fd, const char *buf, size_t len)
+{
+    while (len > 0) {
+        ssize_t n = send(fd, buf, len, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/* Up to `max` buffered-or-received bytes; 0 at EOF, -1 on error. */
+static ssize_t read_some(struct esp_http_client *c, char *out, size_t max)
+{
+    if (c->rx_pos == c->rx_len) {
+        ssize_t n = recv(c->fd, c->rx, sizeof(c->rx), 0);
+        if (n <= 0) {
+            return n;
+        }
+        c->rx_pos = 0;
+        c->rx_len = (size_t)n;
+    }
+    size_t n = c->rx_len - c->rx_pos < max ? c->rx_len - c->rx_pos : max;
+    memcpy(out, c->rx + c->rx_pos, n);
+    c->rx_pos += n;
+    return (ssize_t)n;
+}
+
+/* One CRLF-terminated line, without the terminator. */
+static bool read_line(struct esp_http_client *c, char *line, size_t size)
+{
+    size_t n = 0;
+    for (;;) {
+        char ch;
+        if (read_some(c, &ch, 1) != 1) {
+            return false;
+        }
+        if (ch == '\n') {
+            break;
+        }
+        if (ch != '\r' && n + 1 < size) {
+            line[n++] = ch;
+        }
+    }
+    line[n] = '\0';
+    return true;
+}
+
+static void deliver(struct esp_http_client *c, char *data, int len)
+{
+    if (!c->cfg.event_handler || len == 0) {
+        return;
+    }
+    esp_http_client_event_t evt = {
+        .event_id = HTTP_EVENT_ON_DATA,
+        .client = c,
+        .data = data,
+        .data_len = len,
+        .user_data = c->cfg.user_data,
+    };
+    c->cfg.event_handler(&evt); /* the IDF client ignores the result too */
+}
+
+/* Stream `remaining` bytes (SIZE_MAX = until EOF) to the handler. */
+static esp_err_t read_body(struct esp_http_client *c, char *buf, size_t buf_size, size_t remaining)
+{
+    while (remaining > 0) {
+        size_t want = remaining < buf_size ? remaining : buf_size;
+        ssize_t n = read_some(c, buf, want);
+        if (n == 0 && remaining == SIZE_MAX) {
+            return ESP_OK;
+        }
+        if (n <= 0) {
+            return ESP_FAIL;
+        }
+        if (remaining != SIZE_MAX) {
+            remaining -= (size_t)n;
+        }
+        deliver(c, buf, (int)n);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t read_chunked(struct esp_http_client *c, char *buf, size_t buf_size)
+{
+    char line[64];
+    for (;;) {
+        if (!read_line(c, line, sizeof(line))) {
+            return ESP_FAIL;
+        }
+        size_t size = strtoul(line, NULL, 16);
+        if (size == 0) {
+            while (read_line(c, line, sizeof(line)) && line[0]) {
+                /* trailers */
+            }
+            return ESP_OK;
+        }
+        esp_err_t err = read_body(c, buf, buf_size, size);
+        if (err != ESP_OK || !read_line(c, line, sizeof(line))) {
+            return ESP_FAIL;
+        }
+    }
+}
+
+/* One request/response. Sets *location for a redirect. */
+static esp_err_t perform_once(struct esp_http_client *c, char *location, size_t location_size)
+{
+    char host[128], port[8];
+    const char *path;
+    if (!split_url(c->url, host, sizeof(host), port, sizeof(port), &path)) {
+        ESP_LOGE(TAG, "Unsupported URL %s (no TLS in the native build)", c->url);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    int timeout_ms = c->cfg.timeout_ms > 0 ? c->cfg.timeout_ms : 5000;
+    c->fd = connect_to(host, port, timeout_ms);
+    if (c->fd < 0) {
+        ESP_LOGE(TAG, "Connect to %s:%s failed", host, port);
+        return ESP_FAIL;
+    }
+    c->rx_pos = c->rx_len = 0;
+
+    bool post = c->cfg.method == HTTP_METHOD_POST;
+    char req[1024];
+    int n = snprintf(req, sizeof(req), "%s %s HTTP/1.1\r\nHost: %s\r\nUser-Agent: ESP32 HTTP Client/1.0\r\n"
+                                       "Connection: close\r\n",
+                     post ? "POST" : "GET", path, host);
+    for (int i = 0; i < c->header_count && n < (int)sizeof(req); i++) {
+        n += snprintf(req + n, sizeof(req) - (size_t)n, "%s", c->headers[i]);
+    }
+    if (post && n < (int)sizeof(req)) {
+        n += snprintf(req + n, sizeof(req) - (size_t)n, "Content-Length: %d\r\n", c->post_len);
+    }
+    if (n >= (int)sizeof(req) - 2) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    n += snprintf(req + n, sizeof(req) - (size_t)n, "\r\n");
+    if (!send_all(c->fd, req, (size_t)n) ||
+        (post && c->post_len > 0 && !send_all(c->fd, c->post_data, (size_t)c->post_len))) {
+        return ESP_FAIL;
+    }
+
+    char line[512];
+    if (!read_line(c, line, sizeof(line)) || sscanf(line, "HTTP/%*d.%*d %d", &c->status) != 1) {
+        return ESP_FAIL;
+    }
+    size_t content_length = SIZE_MAX;
+    bool chunked = false;
+    location[0] = '\0';
+    for (;;) {
+        if (!read_line(c, line, sizeof(line))) {
+            return ESP_FAIL;
+        }
+        if (!line[0]) {
+            break;
+        }
+        char *colon = strchr(line, ':');
+        if (!colon) {
+            continue;
+        }
+        *colon = '\0';
+        char *value = colon + 1;
+        value += strspn(value, " \t");
+        if (strcasecmp(line, "Content-Length") == 0) {
+            content_length = strtoul(value, NULL, 10);
+        } else if (strcasecmp(line, "Transfer-Encoding") == 0 && strcasestr(value, "chunked")) {
+            chunked = true;
+        } else if (strcasecmp(line, "Location") == 0) {
+            strlcpy(location, value, location_size);
+        }
+    }
+
+    bool redirect = (c->status == 301 || c->status == 302 || c->status == 303 || c->status == 307 ||
+                     c->status == 308) && location[0];
+    if (redirect) {
+        return ESP_OK; /* body of a redirect is not the caller's */
+    }
+    location[0] = '\0';
+
+    size_t buf_size = c->cfg.buffer_size > 0 ? (size_t)c->cfg.buffer_size : DEFAULT_BUFFER;
+    char *buf = malloc(buf_size);
+    if (!buf) {
+        return ESP_ERR_NO_MEM;
+    }
+    esp_err_t err = chunked ? read_chunked(c, buf, buf_size) : read_body(c, buf, buf_size, content_length);
+    free(buf);
+    return err;
+}
+
+esp_err_t esp_http_client_perform(esp_http_client_handle_t client)
+{
+    for (int hop = 0; hop <= MAX_REDIRECTS; hop++) {
+        char location[512];
+        client->status = 0;
+        esp_err_t err = perform_once(client, location, sizeof(location));
+        if (client->fd >= 0) {
+            close(client->fd);
+            client->fd = -1;
+        }
+        if (err != ESP_OK || !location[0]) {
+            return err;
+        }
+        char *next;
+        if (location[0] == '/') {
+            /* Relative redirect: keep scheme and authority. */
+            const char *path = strchr(client->url + 7, '/');
+            size_t authority = path ? (size_t)(path - client->url) : strlen(client->url);
+            size_t len = authority + strlen(location) + 1;
+            next = malloc(len);
+            if (next) {
+                snprintf(next, len, "%.*s%s", (int)authority, client->url, location);
+            }
+        } else {
+            next = strdup(location);
+        }
+        if (!next) {
+            return ESP_ERR_NO_MEM;
+        }
+        free(client->url);
+        client->url = next;
+    }
+    ESP_LOGE(TAG, "Too many redirects");
+    return ESP_FAIL;
+}
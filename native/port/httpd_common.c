@@ -0,0 +1,235 @@
+#include "httpd_common.h"
+
+#include "esp_log.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+static const char *TAG = "httpd";
+
+/* ── Handler table ────────────────────────────────── */
+
+esp_err_t httpd_routes_init(httpd_routes_t *routes, const httpd_config_t *config)
+{
+    *routes = (httpd_routes_t){.max = config->max_uri_handlers, .match_fn = config->uri_match_fn};
+    routes->handlers = calloc(config->max_uri_handlers, sizeof(httpd_uri_t));
+    return routes->handlers ? ESP_OK : ESP_ERR_HTTPD_ALLOC_MEM;
+}
+
+void httpd_routes_free(httpd_routes_t *routes)
+{
+    for (size_t i = 0; i < routes->count; i++) {
+        free((char *)routes->handlers[i].uri);
+    }
+    free(routes->handlers);
+    *routes = (httpd_routes_t){0};
+}
+
+esp_err_t httpd_routes_add(httpd_routes_t *routes, const httpd_uri_t *uri_handler)
+{
+    if (!uri_handler || !uri_handler->uri || !uri_handler->handler) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < routes->count; i++) {
+        if (routes->handlers[i].method == uri_handler->method &&
+            strcmp(routes->handlers[i].uri, uri_handler->uri) == 0) {
+            return ESP_ERR_HTTPD_HANDLER_EXISTS;
+        }
+    }
+    if (routes->count == routes->max) {
+        ESP_LOGW(TAG, "No slot left for registering handler %s", uri_handler->uri);
+        return ESP_ERR_HTTPD_HANDLERS_FULL;
+    }
+    httpd_uri_t *h = &routes->handlers[routes->count];
+    *h = *uri_handler;
+    h->uri = strdup(uri_handler->uri);
+    if (!h->uri) {
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+    routes->count++;
+    return ESP_OK;
+}
+
+const httpd_uri_t *httpd_routes_find(const httpd_routes_t *routes, const char *uri, int method,
+                                     httpd_err_code_t *err)
+{
+    size_t len = strcspn(uri, "?");
+    *err = HTTPD_404_NOT_FOUND;
+    for (size_t i = 0; i < routes->count; i++) {
+        const httpd_uri_t *h = &routes->handlers[i];
+        bool match = routes->match_fn ? routes->match_fn(h->uri, uri, len)
+                                      : strlen(h->uri) == len && strncmp(h->uri, uri, len) == 0;
+        if (!match) {
+            continue;
+        }
+        if ((int)h->method == method) {
+            return h;
+        }
+        *err = HTTPD_405_METHOD_NOT_ALLOWED;
+    }
+    return NULL;
+}
+
+const httpd_uri_t *httpd_routes_ws(const httpd_routes_t *routes)
+{
+    for (size_t i = 0; i < routes->count; i++) {
+        if (routes->handlers[i].is_websocket) {
+            return &routes->handlers[i];
+        }
+    }
+    return NULL;
+}
+
+/* ESP-IDF's matcher: a trailing '*' accepts any suffix, a trailing '?'
+   makes the character before it optional, and "?*" / "*?" combine both. */
+bool httpd_uri_match_wildcard(const char *uri_template, const char *uri_to_match, size_t match_upto)
+{
+    size_t tpl_len = strlen(uri_template);
+    size_t exact = tpl_len;
+    char last = tpl_len > 0 ? uri_template[tpl_len - 1] : 0;
+    char prevlast = tpl_len > 1 ? uri_template[tpl_len - 2] : 0;
+    bool asterisk = last == '*' || (prevlast == '*' && last == '?');
+    bool quest = last == '?' || (prevlast == '?' && last == '*');
+
+    if (exact < (size_t)(asterisk + quest * 2)) {
+        return false;
+    }
+    exact -= (size_t)(asterisk + quest * 2);
+    if (match_upto < exact) {
+        return false;
+    }
+    if (!quest) {
+        if (!asterisk && match_upto != exact) {
+            return false;
+        }
+        return strncmp(uri_template, uri_to_match, exact) == 0;
+    }
+    if (match_upto > exact && uri_template[exact] != uri_to_match[exact]) {
+        return false;
+    }
+    if (strncmp(uri_template, uri_to_match, exact) != 0) {
+        return false;
+    }
+    return asterisk || match_upto <= exact + 1;
+}
+
+/* ── Request parsing ──────────────────────────────── */
+
+static esp_err_t copy_value(const char *value, size_t value_len, char *out, size_t out_size)
+{
+    if (out_size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    size_t n = value_len < out_size - 1 ? value_len : out_size - 1;
+    memcpy(out, value, n);
+    out[n] = '\0';
+    return n < value_len ? ESP_ERR_HTTPD_RESULT_TRUNC : ESP_OK;
+}
+
+esp_err_t httpd_header_value(const char *headers, const char *field, char *val, size_t val_size)
+{
+    size_t field_len = strlen(field);
+    for (const char *line = headers; line && *line;) {
+        const char *end = strstr(line, "\r\n");
+        if (!end) {
+            break;
+        }
+        if ((size_t)(end - line) > field_len && line[field_len] == ':' && strncasecmp(line, field, field_len) == 0) {
+            const char *v = line + field_len + 1;
+            v += strspn(v, " \t");
+            const char *v_end = end;
+            while (v_end > v && (v_end[-1] == ' ' || v_end[-1] == '\t')) {
+                v_end--;
+            }
+            return copy_value(v, (size_t)(v_end - v), val, val_size);
+        }
+        line = end + 2;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t httpd_req_get_url_query_str(httpd_req_t *r, char *buf, size_t buf_len)
+{
+    const char *q = strchr(r->uri, '?');
+    if (!q) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    q++;
+    size_t len = strcspn(q, "#");
+    return copy_value(q, len, buf, buf_len);
+}
+
+esp_err_t httpd_query_key_value(const char *qry, const char *key, char *val, size_t val_size)
+{
+    size_t key_len = strlen(key);
+    for (const char *p = qry; p && *p;) {
+        size_t pair_len = strcspn(p, "&");
+        if (pair_len > key_len && p[key_len] == '=' && strncmp(p, key, key_len) == 0) {
+            return copy_value(p + key_len + 1, pair_len - key_len - 1, val, val_size);
+        }
+        if (pair_len == key_len && strncmp(p, key, key_len) == 0) {
+            return copy_value("", 0, val, val_size);
+        }
+        p += pair_len;
+        if (*p == '&') {
+            p++;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+/* ── Responses ────────────────────────────────────── */
+
+esp_err_t httpd_resp_sendstr(httpd_req_t *r, const char *str)
+{
+    return httpd_resp_send(r, str, HTTPD_RESP_USE_STRLEN);
+}
+
+esp_err_t httpd_resp_send_err(httpd_req_t *req, httpd_err_code_t error, const char *msg)
+{
+    static const struct {
+        const char *status;
+        const char *msg;
+    } errors[] = {
+        [HTTPD_400_BAD_REQUEST] = {"400 Bad Request", "Bad request syntax"},
+        [HTTPD_401_UNAUTHORIZED] = {"401 Unauthorized", "Authentication required"},
+        [HTTPD_403_FORBIDDEN] = {"403 Forbidden", "Forbidden"},
+        [HTTPD_404_NOT_FOUND] = {"404 Not Found", "This URI does not exist"},
+        [HTTPD_405_METHOD_NOT_ALLOWED] = {"405 Method Not Allowed", "Request method for this URI is not handled"},
+        [HTTPD_408_REQ_TIMEOUT] = {"408 Request Timeout", "Server closed this connection"},
+        [HTTPD_411_LENGTH_REQUIRED] = {"411 Length Required", "Chunked encoding not supported"},
+        [HTTPD_414_URI_TOO_LONG] = {"414 URI Too Long", "URI is too long"},
+        [HTTPD_431_REQ_HDR_FIELDS_TOO_LARGE] = {"431 Request Header Fields Too Large", "Header fields are too long"},
+        [HTTPD_500_INTERNAL_SERVER_ERROR] = {"500 Internal Server Error", "Internal Server Error"},
+        [HTTPD_501_METHOD_NOT_IMPLEMENTED] = {"501 Method Not Implemented", "Request method is not supported"},
+        [HTTPD_505_VERSION_NOT_SUPPORTED] = {"505 Version Not Supported", "HTTP version not supported"},
+    };
+    if ((unsigned)error >= sizeof(errors) / sizeof(errors[0])) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    httpd_resp_set_status(req, errors[error].status);
+    httpd_resp_set_type(req, "text/plain");
+    return httpd_resp_send(req, msg ? msg : errors[error].msg, HTTPD_RESP_USE_STRLEN);
+}
+
+/* ── WebSocket ────────────────────────────────────── */
+
+size_t httpd_ws_frame_header(uint8_t head[10], httpd_ws_type_t type, bool final, size_t len)
+{
+    size_t n = 0;
+    head[n++] = (uint8_t)((final ? 0x80 : 0) | type);
+    if (len < 126) {
+        head[n++] = (uint8_t)len;
+    } else if (len <= 0xFFFF) {
+        head[n++] = 126;
+        head[n++] = (uint8_t)(len >> 8);
+        head[n++] = (uint8_t)len;
+    } else {
+        head[n++] = 127;
+        for (int i = 7; i >= 0; i--) {
+            head[n++] = (uint8_t)((uint64_t)len >> (8 * i));
+        }
+    }
+    return n;
+}
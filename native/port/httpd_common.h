@@ -0,0 +1,35 @@
+#pragma once
+
+#include "esp_http_server.h"
+
+/* The transport-independent half of esp_http_server, shared by the socket
+   server (httpd_posix.c) and the in-memory one the API benchmark drives
+   (httpd_mem.c): the URI handler table, header and query parsing,
+   httpd_resp_send_err() and WebSocket frame headers. */
+
+typedef struct {
+    httpd_uri_t *handlers;
+    size_t count;
+    size_t max;
+    httpd_uri_match_func_t match_fn; /* NULL = exact match */
+} httpd_routes_t;
+
+esp_err_t httpd_routes_init(httpd_routes_t *routes, const httpd_config_t *config);
+void httpd_routes_free(httpd_routes_t *routes);
+esp_err_t httpd_routes_add(httpd_routes_t *routes, const httpd_uri_t *uri_handler);
+
+/* First handler whose URI and method match `uri` (query string ignored);
+   when there is none, *err tells a 404 from a 405. */
+const httpd_uri_t *httpd_routes_find(const httpd_routes_t *routes, const char *uri, int method,
+                                     httpd_err_code_t *err);
+
+/* The WebSocket route, for frames on an upgraded session. */
+const httpd_uri_t *httpd_routes_ws(const httpd_routes_t *routes);
+
+/* httpd_req_get_hdr_value_str() over a raw header block of CRLF-terminated
+   "Field: value" lines. */
+esp_err_t httpd_header_value(const char *headers, const char *field, char *val, size_t val_size);
+
+/* Header of an unmasked server frame carrying `len` payload bytes. Returns
+   its length (2, 4 or 10). */
+size_t httpd_ws_frame_header(uint8_t head[10], httpd_ws_type_t type, bool final, size_t len);
@@ -0,0 +1,411 @@
+#include "httpd_mem.h"
+
+#include "httpd_common.h"
+#include "native_port.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Sessions are slots in a table, as in httpd_posix.c, but their fds are
+   made up: the HTTP request in flight has HTTP_FD, WebSocket sessions get
+   fresh numbers from FIRST_FD up. Nothing is buffered — a response's bytes are
+   counted into the caller's httpd_mem_resp_t and a frame's into its
+   session — so the allocations a benchmark sees are the handlers' own. */
+
+#define HTTP_FD  3
+#define FIRST_FD 16
+
+typedef struct {
+    int fd; /* -1 = free slot */
+    httpd_mem_ws_stats_t stats;
+} session_t;
+
+struct httpd_server {
+    httpd_config_t cfg;
+    httpd_routes_t routes;
+    session_t *sessions;
+    int next_fd;
+    bool in_request; /* HTTP_FD is live */
+    pthread_mutex_t lock;
+};
+
+typedef struct {
+    struct httpd_server *srv;
+    int fd;
+    const char *headers;
+    const char *body;
+    size_t body_left;
+    httpd_mem_resp_t *resp; /* NULL for WebSocket frames */
+    const char *status;
+    size_t head_len; /* response header lines set so far */
+    size_t hdr_count;
+    bool sent;
+    bool chunked;
+    /* Current WebSocket frame. */
+    httpd_ws_type_t ws_type;
+    const uint8_t *ws_payload;
+    size_t ws_len;
+    size_t ws_left;
+} req_aux_t;
+
+static req_aux_t *aux_of(httpd_req_t *r)
+{
+    return (req_aux_t *)r->aux;
+}
+
+/* ── Responses ────────────────────────────────────── */
+
+static esp_err_t count_head(req_aux_t *a, size_t length_hdr_len)
+{
+    if (!a->resp) {
+        return ESP_ERR_HTTPD_INVALID_REQ; /* not on a WebSocket session */
+    }
+    if (a->sent) {
+        return ESP_ERR_HTTPD_RESP_SEND; /* one response per request */
+    }
+    a->resp->status = atoi(a->status);
+    /* "HTTP/1.1 <status>\r\nContent-Type: <type>\r\n", the length line, the
+       headers set, "\r\n" */
+    a->resp->wire_len +=
+        9 + strlen(a->status) + 2 + 14 + strlen(a->resp->type) + 2 + length_hdr_len + a->head_len + 2;
+    a->sent = true;
+    return ESP_OK;
+}
+
+static void count_body(req_aux_t *a, const char *buf, size_t len)
+{
+    httpd_mem_resp_t *resp = a->resp;
+    if (resp->body_len < HTTPD_MEM_BODY_KEEP) {
+        size_t keep = HTTPD_MEM_BODY_KEEP - resp->body_len;
+        memcpy(resp->body + resp->body_len, buf, len < keep ? len : keep);
+        resp->body[resp->body_len + (len < keep ? len : keep)] = '\0';
+    }
+    resp->body_len += len;
+    resp->wire_len += len;
+}
+
+esp_err_t httpd_resp_set_status(httpd_req_t *r, const char *status)
+{
+    aux_of(r)->status = status;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_type(httpd_req_t *r, const char *type)
+{
+    req_aux_t *a = aux_of(r);
+    if (a->resp) {
+        a->resp->type = type;
+    }
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_hdr(httpd_req_t *r, const char *field, const char *value)
+{
+    req_aux_t *a = aux_of(r);
+    if (a->hdr_count >= a->srv->cfg.max_resp_headers || a->hdr_count >= 16) {
+        return ESP_ERR_HTTPD_RESP_HDR;
+    }
+    a->head_len += strlen(field) + 2 + strlen(value) + 2;
+    a->hdr_count++;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len)
+{
+    req_aux_t *a = aux_of(r);
+    if (buf_len == HTTPD_RESP_USE_STRLEN) {
+        buf_len = buf ? (ssize_t)strlen(buf) : 0;
+    }
+    char length_hdr[48];
+    int n = snprintf(length_hdr, sizeof(length_hdr), "Content-Length: %zd\r\n", buf_len);
+    esp_err_t err = count_head(a, (size_t)n);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (buf_len > 0) {
+        count_body(a, buf, (size_t)buf_len);
+    }
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_chunk(httpd_req_t *r, const char *buf, ssize_t buf_len)
+{
+    req_aux_t *a = aux_of(r);
+    if (buf_len == HTTPD_RESP_USE_STRLEN) {
+        buf_len = buf ? (ssize_t)strlen(buf) : 0;
+    }
+    if (!a->sent) {
+        esp_err_t err = count_head(a, strlen("Transfer-Encoding: chunked\r\n"));
+        if (err != ESP_OK) {
+            return err;
+        }
+        a->chunked = true;
+    } else if (!a->chunked) {
+        return ESP_ERR_HTTPD_RESP_SEND;
+    }
+    char size_line[24];
+    a->resp->wire_len += (size_t)snprintf(size_line, sizeof(size_line), "%zx\r\n", buf_len) + 2;
+    if (buf_len > 0) {
+        count_body(a, buf, (size_t)buf_len);
+    }
+    return ESP_OK;
+}
+
+/* ── Request accessors ────────────────────────────── */
+
+int httpd_req_to_sockfd(httpd_req_t *r)
+{
+    return aux_of(r)->fd;
+}
+
+int httpd_req_recv(httpd_req_t *r, char *buf, size_t buf_len)
+{
+    req_aux_t *a = aux_of(r);
+    size_t n = buf_len < a->body_left ? buf_len : a->body_left;
+    memcpy(buf, a->body, n);
+    a->body += n;
+    a->body_left -= n;
+    return (int)n;
+}
+
+esp_err_t httpd_req_get_hdr_value_str(httpd_req_t *r, const char *field, char *val, size_t val_size)
+{
+    return httpd_header_value(aux_of(r)->headers, field, val, val_size);
+}
+
+/* ── Handler table ────────────────────────────────── */
+
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t *uri_handler)
+{
+    struct httpd_server *srv = handle;
+    return srv ? httpd_routes_add(&srv->routes, uri_handler) : ESP_ERR_INVALID_ARG;
+}
+
+/* ── Requests ─────────────────────────────────────── */
+
+void httpd_mem_request(httpd_handle_t hd, httpd_method_t method, const char *uri, const char *headers,
+                       const char *body, size_t body_len, httpd_mem_resp_t *resp)
+{
+    struct httpd_server *srv = hd;
+    resp->status = 0;
+    resp->type = "text/html";
+    resp->body_len = 0;
+    resp->wire_len = 0;
+    resp->handler_ret = ESP_OK;
+    resp->body[0] = '\0';
+
+    httpd_req_t req;
+    memset(&req, 0, sizeof(req));
+    req_aux_t aux = {.srv = srv, .fd = HTTP_FD, .headers = headers, .body = body, .body_left = body_len,
+                     .resp = resp, .status = "200 OK"};
+    req.handle = srv;
+    req.aux = &aux;
+    req.method = method;
+    req.content_len = body_len;
+    strlcpy((char *)req.uri, uri, sizeof(req.uri));
+
+    httpd_err_code_t err;
+    const httpd_uri_t *h = httpd_routes_find(&srv->routes, req.uri, method, &err);
+    if (!h) {
+        httpd_resp_send_err(&req, err, NULL);
+        resp->handler_ret = ESP_FAIL;
+        return;
+    }
+    req.user_ctx = h->user_ctx;
+    srv->in_request = true;
+    resp->handler_ret = h->handler(&req);
+    srv->in_request = false;
+}
+
+/* ── WebSocket ────────────────────────────────────── */
+
+static session_t *session_by_fd(struct httpd_server *srv, int fd)
+{
+    for (int i = 0; i < srv->cfg.max_open_sockets; i++) {
+        if (srv->sessions[i].fd == fd && fd >= 0) {
+            return &srv->sessions[i];
+        }
+    }
+    return NULL;
+}
+
+int httpd_mem_ws_open(httpd_handle_t hd, const char *uri)
+{
+    struct httpd_server *srv = hd;
+    httpd_err_code_t err;
+    const httpd_uri_t *h = httpd_routes_find(&srv->routes, uri, HTTP_GET, &err);
+    if (!h || !h->is_websocket) {
+        return -1;
+    }
+    pthread_mutex_lock(&srv->lock);
+    session_t *s = NULL;
+    for (int i = 0; !s && i < srv->cfg.max_open_sockets; i++) {
+        if (srv->sessions[i].fd < 0) {
+            s = &srv->sessions[i];
+        }
+    }
+    if (s) {
+        *s = (session_t){.fd = srv->next_fd++};
+    }
+    pthread_mutex_unlock(&srv->lock);
+    if (!s) {
+        return -1;
+    }
+
+    httpd_req_t req;
+    memset(&req, 0, sizeof(req));
+    req_aux_t aux = {.srv = srv, .fd = s->fd, .status = "101 Switching Protocols"};
+    req.handle = srv;
+    req.aux = &aux;
+    req.method = HTTP_GET;
+    req.user_ctx = h->user_ctx;
+    strlcpy((char *)req.uri, uri, sizeof(req.uri));
+    if (h->handler(&req) != ESP_OK) {
+        httpd_mem_ws_close(hd, s->fd);
+        return -1;
+    }
+    return s->fd;
+}
+
+esp_err_t httpd_mem_ws_recv(httpd_handle_t hd, int fd, httpd_ws_type_t type, const void *payload, size_t len)
+{
+    struct httpd_server *srv = hd;
+    const httpd_uri_t *route = httpd_routes_ws(&srv->routes);
+    if (!route || httpd_ws_get_fd_info(hd, fd) != HTTPD_WS_CLIENT_WEBSOCKET) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    httpd_req_t req;
+    memset(&req, 0, sizeof(req));
+    req_aux_t aux = {.srv = srv, .fd = fd, .status = "200 OK", .ws_type = type, .ws_payload = payload,
+                     .ws_len = len, .ws_left = len};
+    req.handle = srv;
+    req.aux = &aux;
+    req.method = 0;
+    req.user_ctx = route->user_ctx;
+    strlcpy((char *)req.uri, route->uri, sizeof(req.uri));
+    esp_err_t ret = route->handler(&req);
+    if (ret != ESP_OK) {
+        httpd_mem_ws_close(hd, fd); /* the server drops the session */
+    }
+    return ret;
+}
+
+void httpd_mem_ws_close(httpd_handle_t hd, int fd)
+{
+    struct httpd_server *srv = hd;
+    pthread_mutex_lock(&srv->lock);
+    session_t *s = session_by_fd(srv, fd);
+    if (s) {
+        s->fd = -1;
+    }
+    pthread_mutex_unlock(&srv->lock);
+}
+
+bool httpd_mem_ws_stats(httpd_handle_t hd, int fd, httpd_mem_ws_stats_t *out)
+{
+    struct httpd_server *srv = hd;
+    pthread_mutex_lock(&srv->lock);
+    session_t *s = session_by_fd(srv, fd);
+    if (s) {
+        *out = s->stats;
+    }
+    pthread_mutex_unlock(&srv->lock);
+    return s != NULL;
+}
+
+esp_err_t httpd_ws_recv_frame(httpd_req_t *req, httpd_ws_frame_t *pkt, size_t max_len)
+{
+    req_aux_t *a = aux_of(req);
+    if (a->resp || !pkt) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    pkt->type = a->ws_type;
+    pkt->final = true;
+    pkt->fragmented = false;
+    if (max_len == 0) {
+        pkt->len = a->ws_len;
+        return ESP_OK;
+    }
+    if (!pkt->payload) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    size_t n = a->ws_left < max_len ? a->ws_left : max_len;
+    memcpy(pkt->payload, a->ws_payload + (a->ws_len - a->ws_left), n);
+    a->ws_left -= n;
+    pkt->len = n;
+    return ESP_OK;
+}
+
+esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t *frame)
+{
+    struct httpd_server *srv = hd;
+    if (!srv || !frame) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint8_t head[10];
+    size_t head_len = httpd_ws_frame_header(head, frame->type, frame->final || !frame->fragmented, frame->len);
+    pthread_mutex_lock(&srv->lock);
+    session_t *s = session_by_fd(srv, fd);
+    if (s) {
+        s->stats.frames++;
+        s->stats.wire_len += head_len + frame->len;
+    }
+    pthread_mutex_unlock(&srv->lock);
+    return s ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+httpd_ws_client_info_t httpd_ws_get_fd_info(httpd_handle_t hd, int fd)
+{
+    struct httpd_server *srv = hd;
+    if (!srv) {
+        return HTTPD_WS_CLIENT_INVALID;
+    }
+    if (fd == HTTP_FD) {
+        return srv->in_request ? HTTPD_WS_CLIENT_HTTP : HTTPD_WS_CLIENT_INVALID;
+    }
+    pthread_mutex_lock(&srv->lock);
+    session_t *s = session_by_fd(srv, fd);
+    pthread_mutex_unlock(&srv->lock);
+    return s ? HTTPD_WS_CLIENT_WEBSOCKET : HTTPD_WS_CLIENT_INVALID;
+}
+
+/* ── Start/stop ───────────────────────────────────── */
+
+esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config)
+{
+    if (!handle || !config || config->max_open_sockets == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    struct httpd_server *srv = calloc(1, sizeof(*srv));
+    if (!srv) {
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+    srv->cfg = *config;
+    srv->next_fd = FIRST_FD;
+    pthread_mutex_init(&srv->lock, NULL);
+    srv->sessions = calloc(config->max_open_sockets, sizeof(session_t));
+    if (httpd_routes_init(&srv->routes, config) != ESP_OK || !srv->sessions) {
+        httpd_stop(srv);
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+    for (int i = 0; i < config->max_open_sockets; i++) {
+        srv->sessions[i].fd = -1;
+    }
+    *handle = srv;
+    return ESP_OK;
+}
+
+esp_err_t httpd_stop(httpd_handle_t handle)
+{
+    struct httpd_server *srv = handle;
+    if (!srv) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    httpd_routes_free(&srv->routes);
+    pthread_mutex_destroy(&srv->lock);
+    free(srv->sessions);
+    free(srv);
+    return ESP_OK;
+}
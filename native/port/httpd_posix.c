@@ -0,0 +1,875 @@
+#include "esp_http_server.h"
+#include "httpd_common.h"
+
+#include "esp_log.h"
+#include "native_port.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+/* The server thread select()s over the listening socket and the sessions and
+   serves one request (or WebSocket frame) at a time on whichever is readable,
+   running the handler inline — the same serialisation as the httpd task, so a
+   slow handler stalls every client here exactly as it does on the device.
+   Only httpd_ws_send_frame_async() writes from other threads; each session's
+   send lock keeps its frames from interleaving with the server's own writes. */
+
+static const char *TAG = "httpd";
+
+/* Request line plus headers. ESP-IDF keeps the URI and the header block in
+   separate buffers of CONFIG_HTTPD_MAX_URI_LEN and CONFIG_HTTPD_MAX_REQ_HDR_LEN. */
+#define RX_BUF_SIZE (CONFIG_HTTPD_MAX_URI_LEN + CONFIG_HTTPD_MAX_REQ_HDR_LEN + 32)
+#define WS_CONTROL_MAX 125
+
+typedef struct {
+    int fd; /* -1 = free slot */
+    bool websocket;
+    uint64_t last_used; /* LRU stamp */
+    pthread_mutex_t send_lock;
+    char rx[RX_BUF_SIZE];
+    size_t rx_pos;
+    size_t rx_len;
+} session_t;
+
+struct httpd_server {
+    httpd_config_t cfg;
+    int listen_fd;
+    int wake[2];
+    httpd_routes_t routes;
+    session_t *sessions;
+    uint64_t lru_clock;
+    pthread_mutex_t lock; /* session table, against async senders */
+    pthread_t thread;
+    volatile bool stop;
+};
+
+typedef struct {
+    struct httpd_server *srv;
+    session_t *sess;
+    const char *headers; /* raw header block, NUL-terminated lines with CRLF */
+    size_t body_left;
+    const char *status;
+    const char *type;
+    const char *hdr_field[16];
+    const char *hdr_value[16];
+    size_t hdr_count;
+    bool chunked;
+    /* Current WebSocket frame, parsed before the handler runs. */
+    httpd_ws_type_t ws_type;
+    bool ws_final;
+    size_t ws_len;
+    size_t ws_left;
+    uint8_t ws_mask[4];
+} req_aux_t;
+
+/* ── Socket I/O ───────────────────────────────────── */
+
+static bool send_all(int fd, const void *buf, size_t len)
+{
+    const char *p = buf;
+    while (len > 0) {
+        ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static bool sess_send(session_t *s, const void *buf, size_t len)
+{
+    pthread_mutex_lock(&s->send_lock);
+    bool ok = s->fd >= 0 && send_all(s->fd, buf, len);
+    pthread_mutex_unlock(&s->send_lock);
+    return ok;
+}
+
+/* Up to `len` bytes, buffered ones first. Returns HTTPD_SOCK_ERR_* or the
+   count (0 = peer closed). */
+static int sess_recv(session_t *s, void *buf, size_t len)
+{
+    if (s->rx_pos < s->rx_len) {
+        size_t n = s->rx_len - s->rx_pos < len ? s->rx_len - s->rx_pos : len;
+        memcpy(buf, s->rx + s->rx_pos, n);
+        s->rx_pos += n;
+        return (int)n;
+    }
+    ssize_t n = recv(s->fd, buf, len, 0);
+    if (n < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? HTTPD_SOCK_ERR_TIMEOUT : HTTPD_SOCK_ERR_FAIL;
+    }
+    return (int)n;
+}
+
+static bool sess_recv_exact(session_t *s, void *buf, size_t len)
+{
+    char *p = buf;
+    while (len > 0) {
+        int n = sess_recv(s, p, len);
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static void close_session(struct httpd_server *srv, session_t *s)
+{
+    pthread_mutex_lock(&srv->lock);
+    pthread_mutex_lock(&s->send_lock);
+    if (s->fd >= 0) {
+        ESP_LOGD(TAG, "closing fd=%d", s->fd);
+        close(s->fd);
+    }
+    s->fd = -1;
+    s->websocket = false;
+    s->rx_pos = s->rx_len = 0;
+    pthread_mutex_unlock(&s->send_lock);
+    pthread_mutex_unlock(&srv->lock);
+}
+
+/* ── Responses ────────────────────────────────────── */
+
+static req_aux_t *aux_of(httpd_req_t *r)
+{
+    return (req_aux_t *)r->aux;
+}
+
+static bool send_head(httpd_req_t *r, const char *length_hdr)
+{
+    req_aux_t *a = aux_of(r);
+    char head[1024];
+    int n = snprintf(head, sizeof(head), "HTTP/1.1 %s\r\nContent-Type: %s\r\n%s", a->status, a->type, length_hdr);
+    for (size_t i = 0; i < a->hdr_count && n < (int)sizeof(head); i++) {
+        n += snprintf(head + n, sizeof(head) - (size_t)n, "%s: %s\r\n", a->hdr_field[i], a->hdr_value[i]);
+    }
+    if (n >= (int)sizeof(head) - 2) {
+        return false;
+    }
+    n += snprintf(head + n, sizeof(head) - (size_t)n, "\r\n");
+    return sess_send(a->sess, head, (size_t)n);
+}
+
+esp_err_t httpd_resp_set_status(httpd_req_t *r, const char *status)
+{
+    aux_of(r)->status = status;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_type(httpd_req_t *r, const char *type)
+{
+    aux_of(r)->type = type;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_hdr(httpd_req_t *r, const char *field, const char *value)
+{
+    req_aux_t *a = aux_of(r);
+    if (a->hdr_count >= a->srv->cfg.max_resp_headers || a->hdr_count >= 16) {
+        return ESP_ERR_HTTPD_RESP_HDR;
+    }
+    a->hdr_field[a->hdr_count] = field;
+    a->hdr_value[a->hdr_count] = value;
+    a->hdr_count++;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len)
+{
+    if (buf_len == HTTPD_RESP_USE_STRLEN) {
+        buf_len = buf ? (ssize_t)strlen(buf) : 0;
+    }
+    char length_hdr[48];
+    snprintf(length_hdr, sizeof(length_hdr), "Content-Length: %zd\r\n", buf_len);
+    if (!send_head(r, length_hdr)) {
+        return ESP_ERR_HTTPD_RESP_HDR;
+    }
+    if (buf_len > 0 && !sess_send(aux_of(r)->sess, buf, (size_t)buf_len)) {
+        return ESP_ERR_HTTPD_RESP_SEND;
+    }
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_chunk(httpd_req_t *r, const char *buf, ssize_t buf_len)
+{
+    req_aux_t *a = aux_of(r);
+    if (buf_len == HTTPD_RESP_USE_STRLEN) {
+        buf_len = buf ? (ssize_t)strlen(buf) : 0;
+    }
+    if (!a->chunked) {
+        if (!send_head(r, "Transfer-Encoding: chunked\r\n")) {
+            return ESP_ERR_HTTPD_RESP_HDR;
+        }
+        a->chunked = true;
+    }
+    char size_line[24];
+    int n = snprintf(size_line, sizeof(size_line), "%zx\r\n", buf_len);
+    if (!sess_send(a->sess, size_line, (size_t)n) || (buf_len > 0 && !sess_send(a->sess, buf, (size_t)buf_len)) ||
+        !sess_send(a->sess, "\r\n", 2)) {
+        return ESP_ERR_HTTPD_RESP_SEND;
+    }
+    return ESP_OK;
+}
+
+/* ── Request accessors ────────────────────────────── */
+
+int httpd_req_to_sockfd(httpd_req_t *r)
+{
+    return aux_of(r)->sess->fd;
+}
+
+int httpd_req_recv(httpd_req_t *r, char *buf, size_t buf_len)
+{
+    req_aux_t *a = aux_of(r);
+    if (a->body_left == 0) {
+        return 0;
+    }
+    int n = sess_recv(a->sess, buf, buf_len < a->body_left ? buf_len : a->body_left);
+    if (n == 0) {
+        return HTTPD_SOCK_ERR_FAIL; /* closed mid-body */
+    }
+    if (n > 0) {
+        a->body_left -= (size_t)n;
+    }
+    return n;
+}
+
+esp_err_t httpd_req_get_hdr_value_str(httpd_req_t *r, const char *field, char *val, size_t val_size)
+{
+    return httpd_header_value(aux_of(r)->headers, field, val, val_size);
+}
+
+/* ── Handler table ────────────────────────────────── */
+
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t *uri_handler)
+{
+    struct httpd_server *srv = handle;
+    return srv ? httpd_routes_add(&srv->routes, uri_handler) : ESP_ERR_INVALID_ARG;
+}
+
+/* ── WebSocket ────────────────────────────────────── */
+
+static uint32_t rol(uint32_t x, int n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+/* SHA-1 of a short message (the handshake key), for Sec-WebSocket-Accept. */
+static void sha1(const uint8_t *msg, size_t len, uint8_t out[20])
+{
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    size_t total = ((len + 8) / 64 + 1) * 64;
+    uint8_t block[64];
+    for (size_t off = 0; off < total; off += 64) {
+        for (size_t i = 0; i < 64; i++) {
+            size_t k = off + i;
+            block[i] = k < len ? msg[k] : k == len ? 0x80 : 0;
+        }
+        if (off + 64 == total) {
+            uint64_t bits = (uint64_t)len * 8;
+            for (int i = 0; i < 8; i++) {
+                block[56 + i] = (uint8_t)(bits >> (56 - 8 * i));
+            }
+        }
+        uint32_t w[80];
+        for (int i = 0; i < 16; i++) {
+            w[i] = (uint32_t)block[4 * i] << 24 | (uint32_t)block[4 * i + 1] << 16 | (uint32_t)block[4 * i + 2] << 8 |
+                   block[4 * i + 3];
+        }
+        for (int i = 16; i < 80; i++) {
+            w[i] = rol(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; i++) {
+            uint32_t f, k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            uint32_t t = rol(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rol(b, 30);
+            b = a;
+            a = t;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+    for (int i = 0; i < 5; i++) {
+        out[4 * i] = (uint8_t)(h[i] >> 24);
+        out[4 * i + 1] = (uint8_t)(h[i] >> 16);
+        out[4 * i + 2] = (uint8_t)(h[i] >> 8);
+        out[4 * i + 3] = (uint8_t)h[i];
+    }
+}
+
+static void base64(const uint8_t *in, size_t len, char *out)
+{
+    static const char tbl[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t o = 0;
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t v = (uint32_t)in[i] << 16 | (i + 1 < len ? (uint32_t)in[i + 1] << 8 : 0) |
+                     (i + 2 < len ? in[i + 2] : 0);
+        out[o++] = tbl[(v >> 18) & 63];
+        out[o++] = tbl[(v >> 12) & 63];
+        out[o++] = i + 1 < len ? tbl[(v >> 6) & 63] : '=';
+        out[o++] = i + 2 < len ? tbl[v & 63] : '=';
+    }
+    out[o] = '\0';
+}
+
+static bool ws_handshake(httpd_req_t *r)
+{
+    char key[64];
+    if (httpd_req_get_hdr_value_str(r, "Sec-WebSocket-Key", key, sizeof(key)) != ESP_OK) {
+        return false;
+    }
+    char src[128];
+    int n = snprintf(src, sizeof(src), "%s258EAFA5-E914-47DA-95CA-C5AB0DC85B11", key);
+    uint8_t digest[20];
+    sha1((const uint8_t *)src, (size_t)n, digest);
+    char accept[32];
+    base64(digest, sizeof(digest), accept);
+    char resp[256];
+    n = snprintf(resp, sizeof(resp),
+                 "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                 "Sec-WebSocket-Accept: %s\r\n\r\n",
+                 accept);
+    return sess_send(aux_of(r)->sess, resp, (size_t)n);
+}
+
+static bool ws_write(session_t *s, httpd_ws_type_t type, bool final, const uint8_t *payload, size_t len)
+{
+    uint8_t head[10];
+    size_t n = httpd_ws_frame_header(head, type, final, len);
+    pthread_mutex_lock(&s->send_lock);
+    bool ok = s->fd >= 0 && send_all(s->fd, head, n) && (len == 0 || send_all(s->fd, payload, len));
+    pthread_mutex_unlock(&s->send_lock);
+    return ok;
+}
+
+static bool ws_read_header(req_aux_t *a)
+{
+    uint8_t h[2];
+    if (!sess_recv_exact(a->sess, h, 2)) {
+        return false;
+    }
+    a->ws_final = h[0] & 0x80;
+    a->ws_type = (httpd_ws_type_t)(h[0] & 0x0F);
+    if (!(h[1] & 0x80)) {
+        return false; /* RFC 6455: client frames must be masked */
+    }
+    uint64_t len = h[1] & 0x7F;
+    if (len == 126 || len == 127) {
+        uint8_t ext[8];
+        size_t ext_len = len == 126 ? 2 : 8;
+        if (!sess_recv_exact(a->sess, ext, ext_len)) {
+            return false;
+        }
+        len = 0;
+        for (size_t i = 0; i < ext_len; i++) {
+            len = len << 8 | ext[i];
+        }
+    }
+    if (!sess_recv_exact(a->sess, a->ws_mask, 4)) {
+        return false;
+    }
+    a->ws_len = a->ws_left = (size_t)len;
+    return true;
+}
+
+static bool ws_read_payload(req_aux_t *a, uint8_t *buf, size_t len)
+{
+    size_t done = a->ws_len - a->ws_left;
+    if (!sess_recv_exact(a->sess, buf, len)) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        buf[i] ^= a->ws_mask[(done + i) % 4];
+    }
+    a->ws_left -= len;
+    return true;
+}
+
+esp_err_t httpd_ws_recv_frame(httpd_req_t *req, httpd_ws_frame_t *pkt, size_t max_len)
+{
+    req_aux_t *a = aux_of(req);
+    if (!a->sess->websocket || !pkt) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    pkt->type = a->ws_type;
+    pkt->final = a->ws_final;
+    pkt->fragmented = !a->ws_final;
+    if (max_len == 0) {
+        pkt->len = a->ws_len; /* header only: tell the caller what to allocate */
+        return ESP_OK;
+    }
+    if (!pkt->payload) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    size_t n = a->ws_left < max_len ? a->ws_left : max_len;
+    if (!ws_read_payload(a, pkt->payload, n)) {
+        return ESP_FAIL;
+    }
+    pkt->len = n;
+    return ESP_OK;
+}
+
+static session_t *session_by_fd(struct httpd_server *srv, int fd)
+{
+    for (int i = 0; i < srv->cfg.max_open_sockets; i++) {
+        if (srv->sessions[i].fd == fd && fd >= 0) {
+            return &srv->sessions[i];
+        }
+    }
+    return NULL;
+}
+
+esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t *frame)
+{
+    struct httpd_server *srv = hd;
+    if (!srv || !frame) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&srv->lock);
+    session_t *s = session_by_fd(srv, fd);
+    if (!s || !s->websocket) {
+        pthread_mutex_unlock(&srv->lock);
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Holding the table lock keeps the session from being closed and its fd
+       reused under us; the socket's send timeout bounds how long that is. */
+    bool ok = ws_write(s, frame->type, frame->final || !frame->fragmented, frame->payload, frame->len);
+    pthread_mutex_unlock(&srv->lock);
+    return ok ? ESP_OK : ESP_FAIL;
+}
+
+httpd_ws_client_info_t httpd_ws_get_fd_info(httpd_handle_t hd, int fd)
+{
+    struct httpd_server *srv = hd;
+    if (!srv) {
+        return HTTPD_WS_CLIENT_INVALID;
+    }
+    pthread_mutex_lock(&srv->lock);
+    session_t *s = session_by_fd(srv, fd);
+    httpd_ws_client_info_t info = !s ? HTTPD_WS_CLIENT_INVALID
+                                  : s->websocket ? HTTPD_WS_CLIENT_WEBSOCKET
+                                                 : HTTPD_WS_CLIENT_HTTP;
+    pthread_mutex_unlock(&srv->lock);
+    return info;
+}
+
+/* ── Serving ──────────────────────────────────────── */
+
+/* One frame on an upgraded session. Control frames are answered here unless
+   the route asked for them. Returns false to close the session. */
+static bool serve_frame(struct httpd_server *srv, session_t *s, const httpd_uri_t *route)
+{
+    httpd_req_t req;
+    memset(&req, 0, sizeof(req));
+    req_aux_t aux = {.srv = srv, .sess = s, .status = "200 OK", .type = "text/html"};
+    req.handle = srv;
+    req.aux = &aux;
+    req.method = 0;
+    if (!ws_read_header(&aux)) {
+        return false;
+    }
+    bool control = aux.ws_type & 0x8;
+    if (control && !(route && route->handle_ws_control_frames)) {
+        uint8_t payload[WS_CONTROL_MAX];
+        if (aux.ws_len > WS_CONTROL_MAX || !ws_read_payload(&aux, payload, aux.ws_len)) {
+            return false;
+        }
+        if (aux.ws_type == HTTPD_WS_TYPE_PING) {
+            return ws_write(s, HTTPD_WS_TYPE_PONG, true, payload, aux.ws_len);
+        }
+        if (aux.ws_type == HTTPD_WS_TYPE_CLOSE) {
+            ws_write(s, HTTPD_WS_TYPE_CLOSE, true, payload, aux.ws_len < 2 ? aux.ws_len : 2);
+            return false;
+        }
+        return true; /* unsolicited pong */
+    }
+    if (!route) {
+        return false;
+    }
+    strlcpy((char *)req.uri, route->uri, sizeof(req.uri));
+    req.user_ctx = route->user_ctx;
+    if (route->handler(&req) != ESP_OK) {
+        return false;
+    }
+    /* Discard whatever payload the handler left unread. */
+    uint8_t scratch[256];
+    while (aux.ws_left > 0) {
+        size_t n = aux.ws_left < sizeof(scratch) ? aux.ws_left : sizeof(scratch);
+        if (!ws_read_payload(&aux, scratch, n)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int parse_method(const char *m, size_t len)
+{
+    static const struct {
+        const char *name;
+        int method;
+    } methods[] = {
+        {"GET", HTTP_GET},   {"POST", HTTP_POST},       {"PUT", HTTP_PUT},     {"DELETE", HTTP_DELETE},
+        {"HEAD", HTTP_HEAD}, {"OPTIONS", HTTP_OPTIONS}, {"PATCH", HTTP_PATCH},
+    };
+    for (size_t i = 0; i < sizeof(methods) / sizeof(methods[0]); i++) {
+        if (strlen(methods[i].name) == len && strncmp(methods[i].name, m, len) == 0) {
+            return methods[i].method;
+        }
+    }
+    return -1;
+}
+
+/* Reject a request the way ESP-IDF does: error response, then close. */
+static bool reject(struct httpd_server *srv, session_t *s, httpd_err_code_t code)
+{
+    httpd_req_t req;
+    memset(&req, 0, sizeof(req));
+    req_aux_t aux = {.srv = srv, .sess = s, .status = "200 OK", .type = "text/html"};
+    req.handle = srv;
+    req.aux = &aux;
+    httpd_resp_send_err(&req, code, NULL);
+    return false;
+}
+
+/* Read until the blank line ending the headers. Returns the offset just past
+   it, 0 if the peer went away, or -(httpd_err_code_t + 1) for a bad request. */
+static int read_head(session_t *s)
+{
+    if (s->rx_pos > 0) {
+        memmove(s->rx, s->rx + s->rx_pos, s->rx_len - s->rx_pos);
+        s->rx_len -= s->rx_pos;
+        s->rx_pos = 0;
+    }
+    for (;;) {
+        s->rx[s->rx_len] = '\0';
+        char *end = strstr(s->rx, "\r\n\r\n");
+        if (end) {
+            return (int)(end - s->rx) + 4;
+        }
+        char *eol = strstr(s->rx, "\r\n");
+        if (!eol && s->rx_len > CONFIG_HTTPD_MAX_URI_LEN + 24) {
+            return -(HTTPD_414_URI_TOO_LONG + 1);
+        }
+        if (s->rx_len == sizeof(s->rx) - 1) {
+            return -(HTTPD_431_REQ_HDR_FIELDS_TOO_LARGE + 1);
+        }
+        ssize_t n = recv(s->fd, s->rx + s->rx_len, sizeof(s->rx) - 1 - s->rx_len, 0);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && s->rx_len > 0) {
+            return -(HTTPD_408_REQ_TIMEOUT + 1);
+        }
+        if (n <= 0) {
+            return 0;
+        }
+        s->rx_len += (size_t)n;
+    }
+}
+
+/* One HTTP request. Returns false to close the session. */
+static bool serve_request(struct httpd_server *srv, session_t *s)
+{
+    int head_len = read_head(s);
+    if (head_len == 0) {
+        return false;
+    }
+    if (head_len < 0) {
+        return reject(srv, s, (httpd_err_code_t)(-head_len - 1));
+    }
+    s->rx_pos = (size_t)head_len;
+    s->rx[head_len - 2] = '\0'; /* keep the last header's CRLF */
+
+    /* Request line: METHOD SP URI SP HTTP/1.x */
+    char *line_end = strstr(s->rx, "\r\n");
+    char *sp1 = memchr(s->rx, ' ', (size_t)(line_end - s->rx));
+    char *sp2 = sp1 ? memchr(sp1 + 1, ' ', (size_t)(line_end - sp1 - 1)) : NULL;
+    if (!sp2) {
+        return reject(srv, s, HTTPD_400_BAD_REQUEST);
+    }
+    int method = parse_method(s->rx, (size_t)(sp1 - s->rx));
+    if (method < 0) {
+        return reject(srv, s, HTTPD_501_METHOD_NOT_IMPLEMENTED);
+    }
+    size_t uri_len = (size_t)(sp2 - sp1 - 1);
+    if (uri_len > CONFIG_HTTPD_MAX_URI_LEN) {
+        return reject(srv, s, HTTPD_414_URI_TOO_LONG);
+    }
+    if (strncmp(sp2 + 1, "HTTP/1.", 7) != 0) {
+        return reject(srv, s, HTTPD_505_VERSION_NOT_SUPPORTED);
+    }
+    bool http10 = sp2[8] == '0';
+    const char *headers = line_end + 2;
+    if (strlen(headers) > CONFIG_HTTPD_MAX_REQ_HDR_LEN) {
+        return reject(srv, s, HTTPD_431_REQ_HDR_FIELDS_TOO_LARGE);
+    }
+
+    httpd_req_t req;
+    memset(&req, 0, sizeof(req));
+    req_aux_t aux = {.srv = srv, .sess = s, .headers = headers, .status = "200 OK", .type = "text/html"};
+    req.handle = srv;
+    req.aux = &aux;
+    req.method = method;
+    memcpy((char *)req.uri, sp1 + 1, uri_len);
+
+    char value[64];
+    if (httpd_req_get_hdr_value_str(&req, "Transfer-Encoding", value, sizeof(value)) != ESP_ERR_NOT_FOUND) {
+        return reject(srv, s, HTTPD_411_LENGTH_REQUIRED);
+    }
+    if (httpd_req_get_hdr_value_str(&req, "Content-Length", value, sizeof(value)) == ESP_OK) {
+        req.content_len = strtoul(value, NULL, 10);
+    }
+    aux.body_left = req.content_len;
+    bool keep_alive = !http10;
+    if (httpd_req_get_hdr_value_str(&req, "Connection", value, sizeof(value)) == ESP_OK) {
+        keep_alive = strcasecmp(value, "close") != 0 && (!http10 || strcasecmp(value, "keep-alive") == 0);
+    }
+
+    httpd_err_code_t err;
+    const httpd_uri_t *h = httpd_routes_find(&srv->routes, req.uri, method, &err);
+    if (!h) {
+        ESP_LOGW(TAG, "%s %s: %s", method == HTTP_GET ? "GET" : "request", req.uri,
+                 err == HTTPD_404_NOT_FOUND ? "not found" : "method not allowed");
+        return reject(srv, s, err);
+    }
+    req.user_ctx = h->user_ctx;
+
+    if (h->is_websocket && method == HTTP_GET &&
+        httpd_req_get_hdr_value_str(&req, "Upgrade", value, sizeof(value)) == ESP_OK &&
+        strcasecmp(value, "websocket") == 0) {
+        if (!ws_handshake(&req)) {
+            return false;
+        }
+        pthread_mutex_lock(&srv->lock);
+        s->websocket = true;
+        pthread_mutex_unlock(&srv->lock);
+    }
+
+    if (h->handler(&req) != ESP_OK) {
+        ESP_LOGD(TAG, "handler for %s failed; closing fd=%d", req.uri, s->fd);
+        return false;
+    }
+    /* Discard any body the handler didn't read, so the next request parses. */
+    char scratch[512];
+    while (aux.body_left > 0) {
+        if (httpd_req_recv(&req, scratch, sizeof(scratch)) <= 0) {
+            return false;
+        }
+    }
+    return keep_alive || s->websocket;
+}
+
+static void serve(struct httpd_server *srv, session_t *s)
+{
+    s->last_used = ++srv->lru_clock;
+    /* Requests pipelined behind this one are already in the buffer, where
+       select() can't see them. */
+    do {
+        bool keep = s->websocket ? serve_frame(srv, s, httpd_routes_ws(&srv->routes)) : serve_request(srv, s);
+        if (!keep) {
+            close_session(srv, s);
+            return;
+        }
+    } while (s->rx_pos < s->rx_len);
+}
+
+static void accept_session(struct httpd_server *srv)
+{
+    int fd = accept4(srv->listen_fd, NULL, NULL, SOCK_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    session_t *slot = NULL;
+    session_t *lru = NULL;
+    for (int i = 0; i < srv->cfg.max_open_sockets; i++) {
+        session_t *s = &srv->sessions[i];
+        if (s->fd < 0) {
+            slot = s;
+            break;
+        }
+        if (!lru || s->last_used < lru->last_used) {
+            lru = s;
+        }
+    }
+    if (!slot) {
+        /* Only reached with lru_purge_enable; otherwise the listener is
+           dropped from the select set while the table is full. */
+        ESP_LOGD(TAG, "purging LRU fd=%d", lru->fd);
+        close_session(srv, lru);
+        slot = lru;
+    }
+    struct timeval rcv = {.tv_sec = srv->cfg.recv_wait_timeout};
+    struct timeval snd = {.tv_sec = srv->cfg.send_wait_timeout};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &rcv, sizeof(rcv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &snd, sizeof(snd));
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    pthread_mutex_lock(&srv->lock);
+    slot->fd = fd;
+    slot->websocket = false;
+    slot->rx_pos = slot->rx_len = 0;
+    slot->last_used = ++srv->lru_clock;
+    pthread_mutex_unlock(&srv->lock);
+}
+
+static void *server_thread(void *arg)
+{
+    struct httpd_server *srv = arg;
+    pthread_setname_np(pthread_self(), "httpd");
+    while (!srv->stop) {
+        fd_set rd;
+        FD_ZERO(&rd);
+        FD_SET(srv->wake[0], &rd);
+        int max_fd = srv->wake[0];
+        int open = 0;
+        for (int i = 0; i < srv->cfg.max_open_sockets; i++) {
+            int fd = srv->sessions[i].fd;
+            if (fd >= 0) {
+                FD_SET(fd, &rd);
+                max_fd = fd > max_fd ? fd : max_fd;
+                open++;
+            }
+        }
+        if (open < srv->cfg.max_open_sockets || srv->cfg.lru_purge_enable) {
+            FD_SET(srv->listen_fd, &rd);
+            max_fd = srv->listen_fd > max_fd ? srv->listen_fd : max_fd;
+        }
+        if (select(max_fd + 1, &rd, NULL, NULL, NULL) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ESP_LOGE(TAG, "select: %s", strerror(errno));
+            break;
+        }
+        if (srv->stop) {
+            break;
+        }
+        for (int i = 0; i < srv->cfg.max_open_sockets; i++) {
+            session_t *s = &srv->sessions[i];
+            if (s->fd >= 0 && FD_ISSET(s->fd, &rd)) {
+                serve(srv, s);
+            }
+        }
+        if (FD_ISSET(srv->listen_fd, &rd)) {
+            accept_session(srv);
+        }
+    }
+    return NULL;
+}
+
+/* ── Start/stop ───────────────────────────────────── */
+
+static void free_server(struct httpd_server *srv)
+{
+    if (srv->sessions) {
+        for (int i = 0; i < srv->cfg.max_open_sockets; i++) {
+            close_session(srv, &srv->sessions[i]);
+            pthread_mutex_destroy(&srv->sessions[i].send_lock);
+        }
+    }
+    if (srv->listen_fd >= 0) {
+        close(srv->listen_fd);
+    }
+    if (srv->wake[0] >= 0) {
+        close(srv->wake[0]);
+        close(srv->wake[1]);
+    }
+    pthread_mutex_destroy(&srv->lock);
+    httpd_routes_free(&srv->routes);
+    free(srv->sessions);
+    free(srv);
+}
+
+esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config)
+{
+    if (!handle || !config || config->max_open_sockets == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    struct httpd_server *srv = calloc(1, sizeof(*srv));
+    if (!srv) {
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+    srv->cfg = *config;
+    srv->cfg.server_port = native_cfg.http_port;
+    srv->listen_fd = -1;
+    srv->wake[0] = srv->wake[1] = -1;
+    pthread_mutex_init(&srv->lock, NULL);
+    srv->sessions = calloc(config->max_open_sockets, sizeof(session_t));
+    if (httpd_routes_init(&srv->routes, config) != ESP_OK || !srv->sessions) {
+        free_server(srv);
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+    for (int i = 0; i < config->max_open_sockets; i++) {
+        srv->sessions[i].fd = -1;
+        pthread_mutex_init(&srv->sessions[i].send_lock, NULL);
+    }
+
+    srv->listen_fd = socket(AF_INET6, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    int off = 0, on = 1;
+    struct sockaddr_in6 addr = {.sin6_family = AF_INET6, .sin6_port = htons(srv->cfg.server_port),
+                                .sin6_addr = in6addr_any};
+    if (srv->listen_fd < 0 || setsockopt(srv->listen_fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off)) != 0 ||
+        setsockopt(srv->listen_fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) != 0 ||
+        bind(srv->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(srv->listen_fd, config->backlog_conn) != 0 || pipe2(srv->wake, O_CLOEXEC) != 0) {
+        ESP_LOGE(TAG, "Cannot listen on port %u: %s", srv->cfg.server_port, strerror(errno));
+        free_server(srv);
+        return ESP_ERR_HTTPD_TASK;
+    }
+    if (pthread_create(&srv->thread, NULL, server_thread, srv) != 0) {
+        free_server(srv);
+        return ESP_ERR_HTTPD_TASK;
+    }
+    ESP_LOGI(TAG, "Started on port %u", srv->cfg.server_port);
+    *handle = srv;
+    return ESP_OK;
+}
+
+esp_err_t httpd_stop(httpd_handle_t handle)
+{
+    struct httpd_server *srv = handle;
+    if (!srv) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    srv->stop = true;
+    if (write(srv->wake[1], "x", 1) < 0) {
+        ESP_LOGW(TAG, "wake: %s", strerror(errno));
+    }
+    if (pthread_equal(pthread_self(), srv->thread)) {
+        return ESP_ERR_INVALID_STATE; /* from a handler: can't join ourselves */
+    }
+    pthread_join(srv->thread, NULL);
+    free_server(srv);
+    return ESP_OK;
+}
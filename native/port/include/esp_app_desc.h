@@ -0,0 +1,17 @@
+#pragma once
+
+/* Application description. The version is the git describe of the tree the
+ * twin was built from (native/CMakeLists.txt), like the firmware's. */
+
+#include <stdint.h>
+
+typedef struct {
+    char version[32];
+    char project_name[32];
+    char time[16];
+    char date[16];
+    char idf_ver[32];
+    uint8_t app_elf_sha256[32]; /* all zero: the twin has no image hash */
+} esp_app_desc_t;
+
+const esp_app_desc_t *esp_app_get_description(void);
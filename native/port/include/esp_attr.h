@@ -0,0 +1,11 @@
+#pragma once
+
+/* Linker-section attributes. The twin has one flat memory, so placement is
+ * recorded in the source (components/mem_budget) but changes nothing here. */
+
+#define EXT_RAM_BSS_ATTR
+#define EXT_RAM_NOINIT_ATTR
+#define DRAM_ATTR
+#define IRAM_ATTR
+#define WORD_ALIGNED_ATTR __attribute__((aligned(4)))
+#define DMA_ATTR          WORD_ALIGNED_ATTR
@@ -0,0 +1,21 @@
+#pragma once
+
+/* The CPU cycle counter, for the native build: the host's monotonic clock
+ * scaled to CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ, so a cycle count divided by the
+ * frequency comes out as real microseconds, as on the device. Wraps like the
+ * 32-bit CCOUNT register. */
+
+#include "sdkconfig.h"
+
+#include <stdint.h>
+#include <time.h>
+
+typedef uint32_t esp_cpu_cycle_count_t;
+
+static inline esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t ns = (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+    return (esp_cpu_cycle_count_t)(ns * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ / 1000);
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "esp_err.h"
+
+/* No certificate bundle without TLS; accepted so configs compile unchanged. */
+esp_err_t esp_crt_bundle_attach(void *conf);
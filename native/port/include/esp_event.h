@@ -0,0 +1,24 @@
+#pragma once
+
+#include "esp_err.h"
+
+#include <stdint.h>
+
+/* The default event loop: handlers run one event at a time on a "sys_evt"
+ * thread, as on the device. Only the Wi-Fi and IP events the native esp_wifi
+ * posts (native/port/wifi_posix.c) ever arrive. */
+
+typedef const char *esp_event_base_t;
+typedef void (*esp_event_handler_t)(void *event_handler_arg, esp_event_base_t event_base, int32_t event_id,
+                                    void *event_data);
+typedef void *esp_event_handler_instance_t;
+
+#define ESP_EVENT_ANY_ID -1
+
+extern const esp_event_base_t WIFI_EVENT;
+extern const esp_event_base_t IP_EVENT;
+
+esp_err_t esp_event_loop_create_default(void);
+esp_err_t esp_event_handler_instance_register(esp_event_base_t event_base, int32_t event_id,
+                                              esp_event_handler_t event_handler, void *event_handler_arg,
+                                              esp_event_handler_instance_t *instance);
@@ -0,0 +1,39 @@
+#pragma once
+
+/* ESP-IDF logging for the native build: the device's "I (ms) tag: msg" lines
+ * on stderr, timestamped with the twin's clock. The level is set with
+ * --log-level (default info). As on the device, the macros pass the whole
+ * "L (%lu) %s: " format and its arguments to the vprintf hook, so
+ * esp_log_set_vprintf() consumers see exactly what they would on hardware. */
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdint.h>
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE,
+} esp_log_level_t;
+
+void esp_log_level_set(const char *tag, esp_log_level_t level);
+void esp_log_write(esp_log_level_t level, const char *tag, const char *fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+uint32_t esp_log_timestamp(void);
+
+typedef int (*vprintf_like_t)(const char *, va_list);
+vprintf_like_t esp_log_set_vprintf(vprintf_like_t func);
+
+#define LOG_FORMAT(letter, fmt) #letter " (%" PRIu32 ") %s: " fmt "\n"
+
+#define ESP_LOG_LEVEL_(level, letter, tag, fmt, ...) \
+    esp_log_write(level, tag, LOG_FORMAT(letter, fmt), esp_log_timestamp(), tag, ##__VA_ARGS__)
+
+#define ESP_LOGE(tag, fmt, ...) ESP_LOG_LEVEL_(ESP_LOG_ERROR, E, tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) ESP_LOG_LEVEL_(ESP_LOG_WARN, W, tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) ESP_LOG_LEVEL_(ESP_LOG_INFO, I, tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) ESP_LOG_LEVEL_(ESP_LOG_DEBUG, D, tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGV(tag, fmt, ...) ESP_LOG_LEVEL_(ESP_LOG_VERBOSE, V, tag, fmt, ##__VA_ARGS__)
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stdint.h>
+
+/* The app partitions of partitions.csv. On the twin each OTA slot is a file
+ * in the state directory (native/port/esp_ota_file.c). */
+
+typedef struct {
+    int subtype;
+    uint32_t address;
+    uint32_t size;
+    char label[17];
+} esp_partition_t;
@@ -0,0 +1,12 @@
+#pragma once
+
+/* The host clock is already synchronised; SNTP is a no-op on the twin. */
+
+typedef enum {
+    SNTP_OPMODE_POLL = 0,
+    SNTP_OPMODE_LISTENONLY,
+} esp_sntp_operatingmode_t;
+
+void esp_sntp_setoperatingmode(esp_sntp_operatingmode_t mode);
+void esp_sntp_setservername(unsigned char idx, const char *server);
+void esp_sntp_init(void);
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "esp_err.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* SPIFFS on a directory (native/port/vfs_dir.c). Registering base_path makes
+ * fopen()/remove() of paths under it, in the firmware sources, resolve to the
+ * twin's state directory, falling back to the web UI image for reads. */
+
+typedef struct {
+    const char *base_path;
+    const char *partition_label;
+    size_t max_files;
+    bool format_if_mount_failed;
+} esp_vfs_spiffs_conf_t;
+
+esp_err_t esp_vfs_spiffs_register(const esp_vfs_spiffs_conf_t *conf);
+esp_err_t esp_spiffs_info(const char *partition_label, size_t *total_bytes, size_t *used_bytes);
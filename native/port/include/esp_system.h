@@ -0,0 +1,13 @@
+#pragma once
+
+#include "esp_err.h"
+
+#include <stdint.h>
+
+/* Re-executes the twin with the arguments it was started with, so NVS, SPIFFS
+ * and the OTA slots carry over as they do across a device reboot. */
+void esp_restart(void) __attribute__((noreturn));
+
+/* The device heap the firmware reports is not modelled; this is a fixed
+ * figure of the same order so clients and dashboards see a plausible value. */
+uint32_t esp_get_free_heap_size(void);
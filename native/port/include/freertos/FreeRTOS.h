@@ -0,0 +1,56 @@
+#pragma once
+
+/* FreeRTOS on POSIX threads for the native build (native/port/freertos_posix.c).
+ * Every task is a pthread; queues, mutexes, event groups and notifications
+ * block on condition variables against the twin's clock, so a timeout of
+ * pdMS_TO_TICKS(100) lasts 100 ms of kiln time whatever --speed is.
+ *
+ * Priorities and core affinity are recorded but not enforced: Linux schedules
+ * the threads. Scheduling questions belong to the discrete-event model in
+ * tests/host/rtos_sim.h; the twin answers functional, load and latency ones. */
+
+#include "esp_err.h"
+#include "esp_system.h"
+#include "sdkconfig.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int32_t BaseType_t;
+typedef uint32_t UBaseType_t;
+
+/* Buffers for the xxxCreateStatic() calls. The port keeps its own objects and
+ * ignores these, so they only need to exist; the firmware sizes stacks in
+ * bytes, as on ESP-IDF. */
+typedef uint8_t StackType_t;
+typedef struct {
+    void *unused[4];
+} StaticTask_t, StaticQueue_t, StaticSemaphore_t, StaticEventGroup_t;
+
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  1
+#define pdFAIL  0
+
+#define portNUM_PROCESSORS 2
+#define portMAX_DELAY      ((TickType_t)0xFFFFFFFFU)
+#define portTICK_PERIOD_MS (1000 / CONFIG_FREERTOS_HZ)
+#define pdMS_TO_TICKS(ms)  ((TickType_t)(((uint64_t)(ms) * CONFIG_FREERTOS_HZ) / 1000))
+
+/* One process-wide recursive lock stands in for the spinlock: critical
+ * sections are short and never block, as on the device. */
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+void native_enter_critical(void);
+void native_exit_critical(void);
+#define portENTER_CRITICAL(mux) ((void)(mux), native_enter_critical())
+#define portEXIT_CRITICAL(mux)  ((void)(mux), native_exit_critical())
+
+#ifndef BIT0
+#define BIT0 (1U << 0)
+#define BIT1 (1U << 1)
+#define BIT2 (1U << 2)
+#define BIT3 (1U << 3)
+#endif
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+typedef uint32_t EventBits_t;
+typedef struct native_event_group *EventGroupHandle_t;
+
+EventGroupHandle_t xEventGroupCreate(void);
+
+static inline EventGroupHandle_t xEventGroupCreateStatic(StaticEventGroup_t *buf)
+{
+    (void)buf;
+    return xEventGroupCreate();
+}
+EventBits_t xEventGroupSetBits(EventGroupHandle_t g, EventBits_t bits);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t g, EventBits_t bits);
+EventBits_t xEventGroupGetBits(EventGroupHandle_t g);
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t g, EventBits_t bits, BaseType_t clear_on_exit, BaseType_t wait_all,
+                                TickType_t timeout);
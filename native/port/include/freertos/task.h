@@ -0,0 +1,58 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct native_task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *param,
+                                   UBaseType_t priority, TaskHandle_t *out_handle, BaseType_t core_id);
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *param,
+                       UBaseType_t priority, TaskHandle_t *out_handle);
+
+static inline TaskHandle_t xTaskCreateStaticPinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth,
+                                                         void *param, UBaseType_t priority, StackType_t *stack,
+                                                         StaticTask_t *tcb, BaseType_t core_id)
+{
+    (void)stack;
+    (void)tcb;
+    TaskHandle_t task = NULL;
+    return xTaskCreatePinnedToCore(fn, name, stack_depth, param, priority, &task, core_id) == pdPASS ? task : NULL;
+}
+
+/* Only a task deleting itself (NULL) is supported; nothing in the firmware
+ * deletes another task. */
+void vTaskDelete(TaskHandle_t task);
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+const char *pcTaskGetName(TaskHandle_t task);
+/* Least free stack the task has had, in bytes. */
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(TickType_t ticks);
+BaseType_t xTaskDelayUntil(TickType_t *last_wake, TickType_t increment);
+
+/* Run-time stats (CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS): each task's
+ * counter is its thread's CPU time and the total is wall time, both in µs, so
+ * a task's share comes out as a share of one host core. Tasks that deleted
+ * themselves are left out. There are no idle tasks: core load is unknown. */
+#define configRUN_TIME_COUNTER_TYPE uint32_t
+
+typedef struct {
+    TaskHandle_t xHandle;
+    const char *pcTaskName;
+    UBaseType_t uxCurrentPriority;
+    configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;
+    uint32_t usStackHighWaterMark;
+    BaseType_t xCoreID;
+} TaskStatus_t;
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status, UBaseType_t size, configRUN_TIME_COUNTER_TYPE *total_run_time);
+TaskHandle_t xTaskGetIdleTaskHandleForCore(BaseType_t core_id);
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t timeout);
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "esp_http_server.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* esp_http_server with no sockets (native/port/httpd_mem.c), linked in place
+ * of httpd_posix.c to drive the firmware's handlers in-process. httpd_start()
+ * only builds the handler table; requests and WebSocket sessions are injected
+ * with the calls below, and each handler runs on the caller's thread, so its
+ * CPU time and allocations can be attributed to it. Response bytes are
+ * counted rather than kept, apart from the start of the body. */
+
+#define HTTPD_MEM_BODY_KEEP 8192
+
+typedef struct {
+    int status;             /* 200 unless the handler set another */
+    const char *type;       /* Content-Type */
+    size_t body_len;        /* every byte the handler sent, all chunks */
+    size_t wire_len;        /* what httpd would put on the socket: head, body, chunk framing */
+    esp_err_t handler_ret;  /* ESP_FAIL closes the session on the device */
+    char body[HTTPD_MEM_BODY_KEEP + 1]; /* first bytes of the body, NUL-terminated */
+} httpd_mem_resp_t;
+
+/* Run one request through the handler table, as the server would after
+ * parsing it: unmatched URIs get the server's 404 or 405. `headers` is a block
+ * of CRLF-terminated "Field: value" lines (NULL for none) and `body` is what
+ * httpd_req_recv() hands out. */
+void httpd_mem_request(httpd_handle_t hd, httpd_method_t method, const char *uri, const char *headers,
+                       const char *body, size_t body_len, httpd_mem_resp_t *resp);
+
+/* Open a WebSocket session on `uri`: the upgrade GET reaches the route's
+ * handler as it does after the device's handshake. Returns the session's fd,
+ * or -1 if there is no WebSocket route or no free session. */
+int httpd_mem_ws_open(httpd_handle_t hd, const char *uri);
+
+/* Deliver one client frame to the WebSocket handler. Returns its result. */
+esp_err_t httpd_mem_ws_recv(httpd_handle_t hd, int fd, httpd_ws_type_t type, const void *payload, size_t len);
+
+void httpd_mem_ws_close(httpd_handle_t hd, int fd);
+
+typedef struct {
+    uint32_t frames;
+    size_t wire_len; /* frame headers included */
+} httpd_mem_ws_stats_t;
+
+/* What has been sent to a WebSocket session so far. False if `fd` is not one. */
+bool httpd_mem_ws_stats(httpd_handle_t hd, int fd, httpd_mem_ws_stats_t *out);
@@ -0,0 +1,23 @@
+#pragma once
+
+/* Force-included ahead of every firmware source in the native build
+ * (native/CMakeLists.txt) for what the ESP-IDF toolchain gives the firmware
+ * implicitly: sdkconfig, newlib's strlcpy, and the SPIFFS mount — fopen() and
+ * remove() of /www paths go through the VFS of native/port/vfs_dir.c. Port
+ * sources don't get it and call the C library directly. */
+
+#include "sdkconfig.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char *dst, const char *src, size_t size);
+#endif
+
+FILE *native_vfs_fopen(const char *path, const char *mode);
+int native_vfs_remove(const char *path);
+
+#define fopen(path, mode) native_vfs_fopen(path, mode)
+#define remove(path)      native_vfs_remove(path)
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "kiln_model.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Shared state of the native port (native/port/). native_main.c fills
+ * native_cfg from the command line before calling app_main(). */
+
+typedef struct {
+    const char *state_dir;   /* NVS file, SPIFFS contents, OTA slots; created if missing */
+    const char *www_dir;     /* web UI image, read when state_dir lacks a file (may be NULL) */
+    uint16_t http_port;      /* replaces httpd_config_t.server_port */
+    double speed;            /* twin seconds per wall-clock second */
+    const kiln_model_params_t *kiln;
+    float start_temp_c;
+    int log_level;           /* esp_log_level_t */
+    char **argv;             /* for esp_restart() */
+} native_config_t;
+
+extern native_config_t native_cfg;
+
+/* newlib has strlcpy and the firmware relies on it; glibc gained it in 2.38.
+ * native_port.c provides it for older hosts. */
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char *dst, const char *src, size_t size);
+#endif
+
+/* ── Clock ────────────────────────────────────────── */
+
+/* The twin's clock: microseconds since boot at native_cfg.speed times wall
+ * time. esp_timer_get_time() and the FreeRTOS tick both read it. */
+void native_clock_start(void);
+int64_t native_clock_us(void);
+
+/* Block on `cond` until signalled or the twin's clock reaches `deadline_us`
+ * (INT64_MAX = forever). Returns false on timeout. The condition variable must
+ * have been created with native_cond_init(). */
+void native_cond_init(pthread_cond_t *cond);
+bool native_cond_wait_until(pthread_cond_t *cond, pthread_mutex_t *mutex, int64_t deadline_us);
+void native_sleep_until(int64_t deadline_us);
+
+/* `name` under native_cfg.state_dir. */
+void native_state_path(char *out, size_t size, const char *name);
+
+/* ── Board ────────────────────────────────────────── */
+
+/* Start the kiln model; called by native_main.c before app_main(). */
+void native_board_init(void);
+
+/* Snapshot of the plant for the twin's own status line. */
+void native_board_kiln(kiln_model_t *out, bool *ssr_on);
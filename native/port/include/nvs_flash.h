@@ -0,0 +1,8 @@
+#pragma once
+
+#include "esp_err.h"
+
+/* Loads the NVS file in the state directory (native_port.h); a missing file
+ * is an empty partition. Erase deletes the file. */
+esp_err_t nvs_flash_init(void);
+esp_err_t nvs_flash_erase(void);
@@ -0,0 +1,60 @@
+#pragma once
+
+/* sdkconfig for the native build: the Kconfig defaults of main/, ota/ and
+ * firing_engine/ plus the ESP-IDF options the firmware reads. The station
+ * SSID is set so wifi_manager takes its STA path and the twin reports the
+ * loopback address instead of the 192.168.4.1 of the access point. */
+
+#define CONFIG_IDF_TARGET "linux"
+#define CONFIG_FREERTOS_HZ 1000
+#define CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ 240
+#define CONFIG_FREERTOS_QUEUE_REGISTRY_SIZE 8
+#define CONFIG_HTTPD_MAX_REQ_HDR_LEN 1024
+#define CONFIG_HTTPD_MAX_URI_LEN 512
+#define CONFIG_HTTPD_WS_SUPPORT 1
+
+#define CONFIG_KILN_WIFI_STA_SSID "bisque-twin"
+#define CONFIG_KILN_WIFI_STA_PASS ""
+#define CONFIG_KILN_WIFI_AP_SSID "Bisque"
+#define CONFIG_KILN_WIFI_AP_PASS "bisquesetup"
+
+#define CONFIG_KILN_PIN_SPI_MOSI 11
+#define CONFIG_KILN_PIN_SPI_MISO 13
+#define CONFIG_KILN_PIN_SPI_SCLK 12
+#define CONFIG_KILN_PIN_TC_CS 10
+#define CONFIG_KILN_PIN_SSR 17
+#define CONFIG_KILN_PIN_LCD_CS 8
+#define CONFIG_KILN_PIN_LCD_DC 9
+#define CONFIG_KILN_PIN_LCD_RST 46
+#define CONFIG_KILN_PIN_LCD_BL 3
+#define CONFIG_KILN_PIN_STATUS_LED 48
+#define CONFIG_KILN_PIN_ALARM 7
+#define CONFIG_KILN_PIN_VENT -1
+#define CONFIG_KILN_PIN_LID_SWITCH -1
+#define CONFIG_KILN_PIN_BTN_UP 4
+#define CONFIG_KILN_PIN_BTN_DOWN 5
+#define CONFIG_KILN_PIN_BTN_SELECT 1
+#define CONFIG_KILN_PIN_BTN_LEFT 6
+#define CONFIG_KILN_PIN_BTN_RIGHT 2
+
+/* The manifest URL, firing record and tick profile come from the
+ * NATIVE_OTA_MANIFEST_URL, NATIVE_FIRING_RECORD and NATIVE_TICK_PROFILE cache
+ * variables (native/CMakeLists.txt), so a twin can be pointed at a local
+ * plain-HTTP release server. */
+#ifndef CONFIG_OTA_MANIFEST_URL
+#define CONFIG_OTA_MANIFEST_URL "https://github.com/BenSeverson/bisque/releases/latest/download/manifest.json"
+#endif
+#define CONFIG_OTA_CONFIRM_DELAY_SECONDS 60
+#define CONFIG_OTA_CONNECT_TIMEOUT_MS 15000
+
+#ifdef NATIVE_FIRING_RECORD
+#define CONFIG_FIRING_RECORD 1
+#endif
+#define CONFIG_FIRING_RECORD_MAX_KB 1024
+#ifdef NATIVE_TICK_PROFILE
+#define CONFIG_FIRING_TICK_PROFILE 1
+#endif
+
+/* The twin echoes every captured line; --log-level still filters. */
+#define CONFIG_LOG_RING_SIZE_KB 256
+#define CONFIG_LOG_RING_ECHO_LEVEL 5
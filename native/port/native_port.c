@@ -0,0 +1,308 @@
+#include "native_port.h"
+
+#include "driver/temperature_sensor.h"
+#include "esp_app_desc.h"
+#include "esp_crt_bundle.h"
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "esp_sntp.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "mdns.h"
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef NATIVE_PROJECT_VER
+#define NATIVE_PROJECT_VER "0.0.0-unknown"
+#endif
+
+native_config_t native_cfg = {
+    .state_dir = "twin-state",
+    .http_port = 8080,
+    .speed = 1.0,
+    .start_temp_c = 20.0f,
+    .log_level = ESP_LOG_INFO,
+};
+
+/* ── Clock ────────────────────────────────────────── */
+
+static struct timespec s_boot;
+
+static int64_t ts_ns(const struct timespec *ts)
+{
+    return (int64_t)ts->tv_sec * 1000000000LL + ts->tv_nsec;
+}
+
+void native_clock_start(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &s_boot);
+}
+
+int64_t native_clock_us(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double real_us = (double)(ts_ns(&now) - ts_ns(&s_boot)) / 1000.0;
+    return (int64_t)(real_us * native_cfg.speed);
+}
+
+/* Wall-clock CLOCK_MONOTONIC instant at which the twin's clock reads `us`. */
+static struct timespec real_deadline(int64_t us)
+{
+    int64_t ns = ts_ns(&s_boot) + (int64_t)((double)us * 1000.0 / native_cfg.speed);
+    struct timespec ts = {.tv_sec = ns / 1000000000LL, .tv_nsec = ns % 1000000000LL};
+    return ts;
+}
+
+void native_cond_init(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+bool native_cond_wait_until(pthread_cond_t *cond, pthread_mutex_t *mutex, int64_t deadline_us)
+{
+    if (deadline_us == INT64_MAX) {
+        pthread_cond_wait(cond, mutex);
+        return true;
+    }
+    struct timespec ts = real_deadline(deadline_us);
+    return pthread_cond_timedwait(cond, mutex, &ts) != ETIMEDOUT;
+}
+
+void native_sleep_until(int64_t deadline_us)
+{
+    struct timespec ts = real_deadline(deadline_us);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+}
+
+void native_state_path(char *out, size_t size, const char *name)
+{
+    snprintf(out, size, "%s/%s", native_cfg.state_dir, name);
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return native_clock_us();
+}
+
+/* ── Logging ──────────────────────────────────────── */
+
+void esp_log_level_set(const char *tag, esp_log_level_t level)
+{
+    (void)tag;
+    native_cfg.log_level = level;
+}
+
+uint32_t esp_log_timestamp(void)
+{
+    return (uint32_t)(native_clock_us() / 1000);
+}
+
+static int stderr_vprintf(const char *fmt, va_list ap)
+{
+    char line[512];
+    int n = vsnprintf(line, sizeof(line), fmt, ap);
+    /* One write per line so lines from different tasks don't interleave. */
+    fputs(line, stderr);
+    return n;
+}
+
+static vprintf_like_t s_log_vprintf = stderr_vprintf;
+
+vprintf_like_t esp_log_set_vprintf(vprintf_like_t func)
+{
+    vprintf_like_t prev = s_log_vprintf;
+    s_log_vprintf = func;
+    return prev;
+}
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *fmt, ...)
+{
+    (void)tag;
+    if ((int)level > native_cfg.log_level) {
+        return;
+    }
+    va_list ap;
+    va_start(ap, fmt);
+    s_log_vprintf(fmt, ap);
+    va_end(ap);
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+    case ESP_OK:
+        return "ESP_OK";
+    case ESP_FAIL:
+        return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:
+        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:
+        return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:
+        return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE:
+        return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND:
+        return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NOT_SUPPORTED:
+        return "ESP_ERR_NOT_SUPPORTED";
+    case ESP_ERR_TIMEOUT:
+        return "ESP_ERR_TIMEOUT";
+    case ESP_ERR_INVALID_RESPONSE:
+        return "ESP_ERR_INVALID_RESPONSE";
+    case ESP_ERR_INVALID_CRC:
+        return "ESP_ERR_INVALID_CRC";
+    case ESP_ERR_NVS_NOT_FOUND:
+        return "ESP_ERR_NVS_NOT_FOUND";
+    case ESP_ERR_NVS_INVALID_HANDLE:
+        return "ESP_ERR_NVS_INVALID_HANDLE";
+    case ESP_ERR_NVS_INVALID_LENGTH:
+        return "ESP_ERR_NVS_INVALID_LENGTH";
+    case ESP_ERR_OTA_VALIDATE_FAILED:
+        return "ESP_ERR_OTA_VALIDATE_FAILED";
+    case ESP_ERR_HTTPD_RESULT_TRUNC:
+        return "ESP_ERR_HTTPD_RESULT_TRUNC";
+    case ESP_ERR_HTTPD_HANDLERS_FULL:
+        return "ESP_ERR_HTTPD_HANDLERS_FULL";
+    case ESP_ERR_HTTPD_HANDLER_EXISTS:
+        return "ESP_ERR_HTTPD_HANDLER_EXISTS";
+    default:
+        return "UNKNOWN ERROR";
+    }
+}
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char *dst, const char *src, size_t size)
+{
+    size_t len = strlen(src);
+    if (size > 0) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+/* ── System ───────────────────────────────────────── */
+
+void esp_restart(void)
+{
+    ESP_LOGI("native", "esp_restart: re-executing %s", native_cfg.argv[0]);
+    fflush(NULL);
+    /* The listening socket and every open file close on exec (O_CLOEXEC /
+       SOCK_CLOEXEC), so the new image can bind the port again. */
+    execv("/proc/self/exe", native_cfg.argv);
+    ESP_LOGE("native", "re-exec failed (%s); exiting", strerror(errno));
+    _exit(1);
+}
+
+uint32_t esp_get_free_heap_size(void)
+{
+    return 200 * 1024;
+}
+
+size_t heap_caps_get_total_size(uint32_t caps)
+{
+    return (caps & MALLOC_CAP_SPIRAM) ? 8u * 1024 * 1024 : 320u * 1024;
+}
+
+size_t heap_caps_get_free_size(uint32_t caps)
+{
+    return (caps & MALLOC_CAP_SPIRAM) ? 8u * 1024 * 1024 - 64u * 1024 : esp_get_free_heap_size();
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps)
+{
+    return heap_caps_get_free_size(caps) / 2;
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps)
+{
+    return heap_caps_get_free_size(caps);
+}
+
+const esp_app_desc_t *esp_app_get_description(void)
+{
+    static const esp_app_desc_t desc = {
+        .version = NATIVE_PROJECT_VER,
+        .project_name = "bisque",
+        .time = __TIME__,
+        .date = __DATE__,
+        .idf_ver = "native",
+    };
+    return &desc;
+}
+
+/* ── Services the twin doesn't need ───────────────── */
+
+esp_err_t mdns_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t mdns_hostname_set(const char *hostname)
+{
+    return ESP_OK;
+}
+
+esp_err_t mdns_instance_name_set(const char *instance_name)
+{
+    return ESP_OK;
+}
+
+esp_err_t mdns_service_add(const char *instance_name, const char *service_type, const char *proto, uint16_t port,
+                           mdns_txt_item_t txt[], size_t num_items)
+{
+    return ESP_OK;
+}
+
+void esp_sntp_setoperatingmode(esp_sntp_operatingmode_t mode)
+{
+}
+
+void esp_sntp_setservername(unsigned char idx, const char *server)
+{
+}
+
+void esp_sntp_init(void)
+{
+}
+
+esp_err_t esp_crt_bundle_attach(void *conf)
+{
+    return ESP_OK;
+}
+
+static int s_die_sensor;
+
+esp_err_t temperature_sensor_install(const temperature_sensor_config_t *tsens_config,
+                                     temperature_sensor_handle_t *ret_tsens)
+{
+    *ret_tsens = (temperature_sensor_handle_t)&s_die_sensor;
+    return ESP_OK;
+}
+
+esp_err_t temperature_sensor_enable(temperature_sensor_handle_t tsens)
+{
+    return ESP_OK;
+}
+
+esp_err_t temperature_sensor_get_celsius(temperature_sensor_handle_t tsens, float *out_celsius)
+{
+    *out_celsius = 35.0f;
+    return ESP_OK;
+}
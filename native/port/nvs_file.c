@@ -0,0 +1,405 @@
+#include "nvs.h"
+#include "nvs_flash.h"
+
+#include "esp_log.h"
+#include "native_port.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The partition is a text file, one "namespace key hex-bytes" line per value,
+   so a twin's settings and profiles can be inspected, diffed or seeded by
+   hand. Like the host-test stub (tests/host/stubs/nvs.c), values are untyped
+   bytes and a getter of the wrong width fails with ESP_ERR_INVALID_SIZE. */
+
+static const char *TAG = "nvs";
+
+#define NVS_FILE      "nvs.txt"
+#define MAX_NS_LEN    16 /* NVS_KEY_NAME_MAX_SIZE, terminator included */
+#define MAX_HANDLES   32
+#define MAX_VALUE_LEN (64 * 1024)
+
+typedef struct entry {
+    char ns[MAX_NS_LEN];
+    char key[MAX_NS_LEN];
+    size_t length;
+    uint8_t *value;
+    struct entry *next;
+} entry_t;
+
+typedef struct {
+    bool open;
+    bool writable;
+    char ns[MAX_NS_LEN];
+} handle_slot_t;
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static entry_t *s_entries;
+static handle_slot_t s_handles[MAX_HANDLES];
+static bool s_initialized;
+
+static entry_t *find_entry(const char *ns, const char *key)
+{
+    for (entry_t *e = s_entries; e; e = e->next) {
+        if (strcmp(e->ns, ns) == 0 && strcmp(e->key, key) == 0) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+static void drop_entries(bool (*match)(const entry_t *e, const char *ns), const char *ns)
+{
+    entry_t **p = &s_entries;
+    while (*p) {
+        entry_t *e = *p;
+        if (match(e, ns)) {
+            *p = e->next;
+            free(e->value);
+            free(e);
+        } else {
+            p = &e->next;
+        }
+    }
+}
+
+static bool match_any(const entry_t *e, const char *ns)
+{
+    return true;
+}
+
+static bool match_ns(const entry_t *e, const char *ns)
+{
+    return strcmp(e->ns, ns) == 0;
+}
+
+static esp_err_t put_entry(const char *ns, const char *key, const void *value, size_t length)
+{
+    if (strlen(key) >= MAX_NS_LEN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (length > MAX_VALUE_LEN) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    uint8_t *copy = malloc(length ? length : 1);
+    if (!copy) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(copy, value, length);
+    entry_t *e = find_entry(ns, key);
+    if (!e) {
+        e = calloc(1, sizeof(*e));
+        if (!e) {
+            free(copy);
+            return ESP_ERR_NO_MEM;
+        }
+        strlcpy(e->ns, ns, sizeof(e->ns));
+        strlcpy(e->key, key, sizeof(e->key));
+        e->next = s_entries;
+        s_entries = e;
+    }
+    free(e->value);
+    e->value = copy;
+    e->length = length;
+    return ESP_OK;
+}
+
+/* ── File ─────────────────────────────────────────── */
+
+static void load_file(void)
+{
+    char path[512];
+    native_state_path(path, sizeof(path), NVS_FILE);
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        return; /* blank partition */
+    }
+    char *line = NULL;
+    size_t cap = 0;
+    int count = 0;
+    while (getline(&line, &cap, f) > 0) {
+        char *save = NULL;
+        char *ns = strtok_r(line, " \n", &save);
+        char *key = strtok_r(NULL, " \n", &save);
+        char *hex = strtok_r(NULL, " \n", &save);
+        if (!ns || !key || !hex || strlen(ns) >= MAX_NS_LEN) {
+            continue;
+        }
+        size_t n = strcmp(hex, "-") == 0 ? 0 : strlen(hex) / 2;
+        /* Decode in place: byte i overwrites hex digits 2i..2i+1, already read. */
+        uint8_t *bytes = (uint8_t *)hex;
+        for (size_t i = 0; i < n; i++) {
+            unsigned b = 0;
+            sscanf(hex + 2 * i, "%2x", &b);
+            bytes[i] = (uint8_t)b;
+        }
+        if (put_entry(ns, key, bytes, n) == ESP_OK) {
+            count++;
+        }
+    }
+    free(line);
+    fclose(f);
+    ESP_LOGI(TAG, "Loaded %d values from %s", count, path);
+}
+
+/* Write-then-rename so a twin killed mid-commit keeps the previous file. */
+static esp_err_t save_file(void)
+{
+    char path[512], tmp[520];
+    native_state_path(path, sizeof(path), NVS_FILE);
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE *f = fopen(tmp, "w");
+    if (!f) {
+        ESP_LOGE(TAG, "Cannot write %s", tmp);
+        return ESP_FAIL;
+    }
+    for (entry_t *e = s_entries; e; e = e->next) {
+        fprintf(f, "%s %s ", e->ns, e->key);
+        if (e->length == 0) {
+            fputc('-', f);
+        }
+        for (size_t i = 0; i < e->length; i++) {
+            fprintf(f, "%02x", e->value[i]);
+        }
+        fputc('\n', f);
+    }
+    if (fclose(f) != 0 || rename(tmp, path) != 0) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_init(void)
+{
+    pthread_mutex_lock(&s_lock);
+    if (!s_initialized) {
+        load_file();
+        s_initialized = true;
+    }
+    pthread_mutex_unlock(&s_lock);
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void)
+{
+    char path[512];
+    native_state_path(path, sizeof(path), NVS_FILE);
+    pthread_mutex_lock(&s_lock);
+    drop_entries(match_any, NULL);
+    s_initialized = false;
+    remove(path);
+    pthread_mutex_unlock(&s_lock);
+    return ESP_OK;
+}
+
+/* ── Handles ──────────────────────────────────────── */
+
+static bool namespace_has_entries(const char *ns)
+{
+    for (entry_t *e = s_entries; e; e = e->next) {
+        if (strcmp(e->ns, ns) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Caller holds s_lock. */
+static handle_slot_t *slot(nvs_handle_t handle)
+{
+    if (handle == 0 || handle > MAX_HANDLES || !s_handles[handle - 1].open) {
+        return NULL;
+    }
+    return &s_handles[handle - 1];
+}
+
+esp_err_t nvs_open(const char *name_space, nvs_open_mode_t mode, nvs_handle_t *out_handle)
+{
+    if (!name_space || !out_handle || strlen(name_space) >= MAX_NS_LEN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = ESP_FAIL;
+    pthread_mutex_lock(&s_lock);
+    /* As on the device, READONLY on a namespace never written is NOT_FOUND. */
+    if (mode == NVS_READONLY && !namespace_has_entries(name_space)) {
+        err = ESP_ERR_NVS_NOT_FOUND;
+    } else {
+        for (int i = 0; i < MAX_HANDLES; i++) {
+            if (!s_handles[i].open) {
+                s_handles[i].open = true;
+                s_handles[i].writable = mode == NVS_READWRITE;
+                strlcpy(s_handles[i].ns, name_space, sizeof(s_handles[i].ns));
+                *out_handle = (nvs_handle_t)(i + 1);
+                err = ESP_OK;
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock(&s_lock);
+    return err;
+}
+
+void nvs_close(nvs_handle_t handle)
+{
+    pthread_mutex_lock(&s_lock);
+    handle_slot_t *h = slot(handle);
+    if (h) {
+        h->open = false;
+    }
+    pthread_mutex_unlock(&s_lock);
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle)
+{
+    pthread_mutex_lock(&s_lock);
+    esp_err_t err = slot(handle) ? save_file() : ESP_ERR_NVS_INVALID_HANDLE;
+    pthread_mutex_unlock(&s_lock);
+    return err;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char *key)
+{
+    pthread_mutex_lock(&s_lock);
+    handle_slot_t *h = slot(handle);
+    esp_err_t err = ESP_ERR_NVS_INVALID_HANDLE;
+    if (h) {
+        entry_t *e = find_entry(h->ns, key);
+        err = ESP_ERR_NVS_NOT_FOUND;
+        for (entry_t **p = &s_entries; e && *p; p = &(*p)->next) {
+            if (*p == e) {
+                *p = e->next;
+                free(e->value);
+                free(e);
+                err = ESP_OK;
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock(&s_lock);
+    return err;
+}
+
+esp_err_t nvs_erase_all(nvs_handle_t handle)
+{
+    pthread_mutex_lock(&s_lock);
+    handle_slot_t *h = slot(handle);
+    if (h) {
+        drop_entries(match_ns, h->ns);
+    }
+    pthread_mutex_unlock(&s_lock);
+    return h ? ESP_OK : ESP_ERR_NVS_INVALID_HANDLE;
+}
+
+/* ── Values ───────────────────────────────────────── */
+
+static esp_err_t set_value(nvs_handle_t handle, const char *key, const void *value, size_t length)
+{
+    pthread_mutex_lock(&s_lock);
+    handle_slot_t *h = slot(handle);
+    esp_err_t err = ESP_ERR_NVS_INVALID_HANDLE;
+    if (h) {
+        err = h->writable ? put_entry(h->ns, key, value, length) : ESP_ERR_INVALID_STATE;
+    }
+    pthread_mutex_unlock(&s_lock);
+    return err;
+}
+
+static esp_err_t get_fixed(nvs_handle_t handle, const char *key, void *out, size_t expected)
+{
+    pthread_mutex_lock(&s_lock);
+    handle_slot_t *h = slot(handle);
+    esp_err_t err = ESP_ERR_NVS_INVALID_HANDLE;
+    if (h) {
+        entry_t *e = find_entry(h->ns, key);
+        if (!e) {
+            err = ESP_ERR_NVS_NOT_FOUND;
+        } else if (e->length != expected) {
+            err = ESP_ERR_INVALID_SIZE;
+        } else {
+            memcpy(out, e->value, expected);
+            err = ESP_OK;
+        }
+    }
+    pthread_mutex_unlock(&s_lock);
+    return err;
+}
+
+/* String and blob getters: NULL `out` asks for the length. */
+static esp_err_t get_variable(nvs_handle_t handle, const char *key, void *out, size_t *length)
+{
+    if (!length) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&s_lock);
+    handle_slot_t *h = slot(handle);
+    esp_err_t err = ESP_ERR_NVS_INVALID_HANDLE;
+    if (h) {
+        entry_t *e = find_entry(h->ns, key);
+        if (!e) {
+            err = ESP_ERR_NVS_NOT_FOUND;
+        } else if (out && *length < e->length) {
+            err = ESP_ERR_NVS_INVALID_LENGTH;
+        } else {
+            if (out) {
+                memcpy(out, e->value, e->length);
+            }
+            *length = e->length;
+            err = ESP_OK;
+        }
+    }
+    pthread_mutex_unlock(&s_lock);
+    return err;
+}
+
+esp_err_t nvs_set_u8(nvs_handle_t handle, const char *key, uint8_t value)
+{
+    return set_value(handle, key, &value, sizeof(value));
+}
+
+esp_err_t nvs_get_u8(nvs_handle_t handle, const char *key, uint8_t *out_value)
+{
+    return get_fixed(handle, key, out_value, sizeof(*out_value));
+}
+
+esp_err_t nvs_set_u32(nvs_handle_t handle, const char *key, uint32_t value)
+{
+    return set_value(handle, key, &value, sizeof(value));
+}
+
+esp_err_t nvs_get_u32(nvs_handle_t handle, const char *key, uint32_t *out_value)
+{
+    return get_fixed(handle, key, out_value, sizeof(*out_value));
+}
+
+esp_err_t nvs_set_i32(nvs_handle_t handle, const char *key, int32_t value)
+{
+    return set_value(handle, key, &value, sizeof(value));
+}
+
+esp_err_t nvs_get_i32(nvs_handle_t handle, const char *key, int32_t *out_value)
+{
+    return get_fixed(handle, key, out_value, sizeof(*out_value));
+}
+
+esp_err_t nvs_set_str(nvs_handle_t handle, const char *key, const char *value)
+{
+    return set_value(handle, key, value, strlen(value) + 1);
+}
+
+esp_err_t nvs_get_str(nvs_handle_t handle, const char *key, char *out_value, size_t *length)
+{
+    return get_variable(handle, key, out_value, length);
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length)
+{
+    return set_value(handle, key, value, length);
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length)
+{
+    return get_variable(handle, key, out_value, length);
+}
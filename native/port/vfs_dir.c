@@ -0,0 +1,143 @@
+#include "esp_spiffs.h"
+
+#include "esp_log.h"
+#include "native_port.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+/* The SPIFFS partition as two directories: writes and deletes land in
+   <state_dir>/spiffs, reads fall back to the web UI image (native_cfg.www_dir,
+   normally spiffs_data/www) for files the twin has never written — the same
+   view as a device flashed with that image. Paths outside the mount pass
+   through untouched. */
+
+static const char *TAG = "vfs";
+
+#define STORAGE_PARTITION_SIZE 0x7E0000 /* partitions.csv "storage" */
+
+static char s_base[32];
+static size_t s_base_len;
+
+/* Relative path under the mount, or NULL if `path` is outside it. SPIFFS
+   has no directories to climb out of; refuse ".." so a crafted URI can't
+   reach host files through the static file handler. */
+static const char *mount_relative(const char *path)
+{
+    if (!s_base_len || strncmp(path, s_base, s_base_len) != 0 || path[s_base_len] != '/') {
+        return NULL;
+    }
+    const char *rel = path + s_base_len + 1;
+    if (strstr(rel, "..")) {
+        return "";
+    }
+    return rel;
+}
+
+static void make_parents(char *path)
+{
+    for (char *p = strchr(path + 1, '/'); p; p = strchr(p + 1, '/')) {
+        *p = '\0';
+        mkdir(path, 0755);
+        *p = '/';
+    }
+}
+
+/* fopen() that, like SPIFFS, finds no file where the host has a directory. */
+static FILE *open_file(const char *host, const char *mode)
+{
+    struct stat st;
+    if (stat(host, &st) == 0 && S_ISDIR(st.st_mode)) {
+        errno = EISDIR;
+        return NULL;
+    }
+    return fopen(host, mode);
+}
+
+FILE *native_vfs_fopen(const char *path, const char *mode)
+{
+    const char *rel = mount_relative(path);
+    if (!rel) {
+        return fopen(path, mode);
+    }
+    if (!*rel) {
+        errno = ENOENT;
+        return NULL;
+    }
+    char host[512];
+    snprintf(host, sizeof(host), "%s/spiffs/%s", native_cfg.state_dir, rel);
+    bool reading = mode[0] == 'r' && !strchr(mode, '+');
+    if (!reading) {
+        make_parents(host);
+    }
+    FILE *f = open_file(host, mode);
+    if (!f && reading && native_cfg.www_dir) {
+        snprintf(host, sizeof(host), "%s/%s", native_cfg.www_dir, rel);
+        f = open_file(host, mode);
+    }
+    return f;
+}
+
+int native_vfs_remove(const char *path)
+{
+    const char *rel = mount_relative(path);
+    if (!rel) {
+        return remove(path);
+    }
+    char host[512];
+    snprintf(host, sizeof(host), "%s/spiffs/%s", native_cfg.state_dir, rel);
+    return *rel ? remove(host) : -1;
+}
+
+esp_err_t esp_vfs_spiffs_register(const esp_vfs_spiffs_conf_t *conf)
+{
+    if (!conf || !conf->base_path || strlen(conf->base_path) >= sizeof(s_base)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    char dir[512];
+    native_state_path(dir, sizeof(dir), "spiffs");
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+        ESP_LOGE(TAG, "Cannot create %s: %s", dir, strerror(errno));
+        return ESP_FAIL;
+    }
+    strlcpy(s_base, conf->base_path, sizeof(s_base));
+    s_base_len = strlen(s_base);
+    ESP_LOGI(TAG, "%s -> %s (image: %s)", s_base, dir, native_cfg.www_dir ? native_cfg.www_dir : "none");
+    return ESP_OK;
+}
+
+static size_t dir_bytes(const char *dir)
+{
+    DIR *d = opendir(dir);
+    if (!d) {
+        return 0;
+    }
+    size_t total = 0;
+    struct dirent *ent;
+    while ((ent = readdir(d)) != NULL) {
+        if (ent->d_name[0] == '.') {
+            continue;
+        }
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+        struct stat st;
+        if (stat(path, &st) == 0) {
+            total += S_ISDIR(st.st_mode) ? dir_bytes(path) : (size_t)st.st_size;
+        }
+    }
+    closedir(d);
+    return total;
+}
+
+esp_err_t esp_spiffs_info(const char *partition_label, size_t *total_bytes, size_t *used_bytes)
+{
+    char dir[512];
+    native_state_path(dir, sizeof(dir), "spiffs");
+    *total_bytes = STORAGE_PARTITION_SIZE;
+    *used_bytes = dir_bytes(dir) + (native_cfg.www_dir ? dir_bytes(native_cfg.www_dir) : 0);
+    return ESP_OK;
+}
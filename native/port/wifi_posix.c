@@ -0,0 +1,232 @@
+#include "esp_wifi.h"
+
+#include "esp_log.h"
+#include "native_port.h"
+
+#include <arpa/inet.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The default event loop and a Wi-Fi driver that is always in range. Events
+   are queued and delivered in order on the "sys_evt" thread, so handlers run
+   off the caller's stack exactly as on the device (wifi_manager calls
+   esp_wifi_connect() from inside its STA_START handler). */
+
+static const char *TAG = "wifi_native";
+
+const esp_event_base_t WIFI_EVENT = "WIFI_EVENT";
+const esp_event_base_t IP_EVENT = "IP_EVENT";
+
+#define MAX_HANDLERS 8
+#define MAX_EVENT_DATA 64
+
+typedef struct {
+    esp_event_base_t base;
+    int32_t id;
+    esp_event_handler_t fn;
+    void *arg;
+} handler_t;
+
+typedef struct event {
+    esp_event_base_t base;
+    int32_t id;
+    uint8_t data[MAX_EVENT_DATA];
+    struct event *next;
+} event_t;
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_posted;
+static handler_t s_handlers[MAX_HANDLERS];
+static int s_handler_count;
+static event_t *s_head;
+static event_t *s_tail;
+static bool s_loop_running;
+
+static wifi_mode_t s_mode;
+static bool s_started;
+static wifi_config_t s_sta_config;
+static wifi_config_t s_ap_config;
+
+static void *event_thread(void *arg)
+{
+    (void)arg;
+    pthread_setname_np(pthread_self(), "sys_evt");
+    pthread_mutex_lock(&s_lock);
+    for (;;) {
+        while (!s_head) {
+            native_cond_wait_until(&s_posted, &s_lock, INT64_MAX);
+        }
+        event_t *e = s_head;
+        s_head = e->next;
+        if (!s_head) {
+            s_tail = NULL;
+        }
+        handler_t matched[MAX_HANDLERS];
+        int n = 0;
+        for (int i = 0; i < s_handler_count; i++) {
+            if (s_handlers[i].base == e->base && (s_handlers[i].id == ESP_EVENT_ANY_ID || s_handlers[i].id == e->id)) {
+                matched[n++] = s_handlers[i];
+            }
+        }
+        pthread_mutex_unlock(&s_lock);
+        for (int i = 0; i < n; i++) {
+            matched[i].fn(matched[i].arg, e->base, e->id, e->data);
+        }
+        free(e);
+        pthread_mutex_lock(&s_lock);
+    }
+    return NULL;
+}
+
+esp_err_t esp_event_loop_create_default(void)
+{
+    pthread_mutex_lock(&s_lock);
+    if (s_loop_running) {
+        pthread_mutex_unlock(&s_lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+    native_cond_init(&s_posted);
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, event_thread, NULL) != 0) {
+        pthread_mutex_unlock(&s_lock);
+        return ESP_FAIL;
+    }
+    pthread_detach(thread);
+    s_loop_running = true;
+    pthread_mutex_unlock(&s_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_event_handler_instance_register(esp_event_base_t event_base, int32_t event_id,
+                                              esp_event_handler_t event_handler, void *event_handler_arg,
+                                              esp_event_handler_instance_t *instance)
+{
+    pthread_mutex_lock(&s_lock);
+    if (s_handler_count == MAX_HANDLERS) {
+        pthread_mutex_unlock(&s_lock);
+        return ESP_ERR_NO_MEM;
+    }
+    handler_t *h = &s_handlers[s_handler_count++];
+    *h = (handler_t){.base = event_base, .id = event_id, .fn = event_handler, .arg = event_handler_arg};
+    pthread_mutex_unlock(&s_lock);
+    if (instance) {
+        *instance = h;
+    }
+    return ESP_OK;
+}
+
+static void post(esp_event_base_t base, int32_t id, const void *data, size_t size)
+{
+    event_t *e = calloc(1, sizeof(*e));
+    if (!e) {
+        return;
+    }
+    e->base = base;
+    e->id = id;
+    if (data) {
+        memcpy(e->data, data, size < MAX_EVENT_DATA ? size : MAX_EVENT_DATA);
+    }
+    pthread_mutex_lock(&s_lock);
+    if (s_tail) {
+        s_tail->next = e;
+    } else {
+        s_head = e;
+    }
+    s_tail = e;
+    pthread_cond_signal(&s_posted);
+    pthread_mutex_unlock(&s_lock);
+}
+
+/* ── esp_netif ────────────────────────────────────── */
+
+struct esp_netif_obj {
+    int unused;
+};
+
+static esp_netif_t s_sta_netif;
+static esp_netif_t s_ap_netif;
+
+esp_err_t esp_netif_init(void)
+{
+    return ESP_OK;
+}
+
+esp_netif_t *esp_netif_create_default_wifi_sta(void)
+{
+    return &s_sta_netif;
+}
+
+esp_netif_t *esp_netif_create_default_wifi_ap(void)
+{
+    return &s_ap_netif;
+}
+
+/* ── esp_wifi ─────────────────────────────────────── */
+
+esp_err_t esp_wifi_init(const wifi_init_config_t *config)
+{
+    return config ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t esp_wifi_set_mode(wifi_mode_t mode)
+{
+    s_mode = mode;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t *conf)
+{
+    if (!conf) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (interface == WIFI_IF_STA) {
+        s_sta_config = *conf;
+    } else {
+        s_ap_config = *conf;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_start(void)
+{
+    s_started = true;
+    if (s_mode == WIFI_MODE_STA || s_mode == WIFI_MODE_APSTA) {
+        post(WIFI_EVENT, WIFI_EVENT_STA_START, NULL, 0);
+    }
+    if (s_mode == WIFI_MODE_AP || s_mode == WIFI_MODE_APSTA) {
+        ESP_LOGI(TAG, "AP \"%s\" up (nothing will join it)", (const char *)s_ap_config.ap.ssid);
+        post(WIFI_EVENT, WIFI_EVENT_AP_START, NULL, 0);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_stop(void)
+{
+    if (!s_started) {
+        return ESP_OK;
+    }
+    s_started = false;
+    if (s_mode == WIFI_MODE_STA || s_mode == WIFI_MODE_APSTA) {
+        post(WIFI_EVENT, WIFI_EVENT_STA_STOP, NULL, 0);
+    }
+    if (s_mode == WIFI_MODE_AP || s_mode == WIFI_MODE_APSTA) {
+        post(WIFI_EVENT, WIFI_EVENT_AP_STOP, NULL, 0);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_connect(void)
+{
+    if (!s_started || !(s_mode == WIFI_MODE_STA || s_mode == WIFI_MODE_APSTA)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    ESP_LOGI(TAG, "\"%s\" associated", (const char *)s_sta_config.sta.ssid);
+    post(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED, NULL, 0);
+    ip_event_got_ip_t got = {.esp_netif = &s_sta_netif};
+    got.ip_info.ip.addr = htonl(INADDR_LOOPBACK);
+    got.ip_info.netmask.addr = htonl(0xFF000000);
+    got.ip_info.gw.addr = htonl(INADDR_LOOPBACK);
+    post(IP_EVENT, IP_EVENT_STA_GOT_IP, &got, sizeof(got));
+    return ESP_OK;
+}
@@ -8,14 +8,33 @@
  * Interactive controls:
  *   Up / Down arrows     encoder rotation (UP/DOWN buttons on the kiln)
  *   Enter / Space        SELECT (open contextual modal, activate focused item)
- *   Left arrow           cancel current modal (no-op when no modal is open)
- *   Right arrow          reserved (matches firmware)
+ *   Left arrow           cancel current modal; otherwise zoom the firing chart out
+ *   Right arrow          zoom the firing chart in (whole firing → 1 h → 10 min)
  *   S                    cycle through state presets (IDLE → HEATING → ...)
  *   Q / Esc / close      quit
  *
  * Screenshot mode (--screenshot):
  *   Dumps the boot splash, every state preset and every modal to
  *   docs/screenshots/lcd-*.png then exits.
+ *
+ * Render-stats mode (--render-stats):
+ *   Plays a slow ramp, a hold and an idle kiln through dashboard_update at
+ *   the firmware's 500 ms cadence and reports what LVGL redrew and flushed per
+ *   second. Nothing on screen should change between most ticks, so the
+ *   numbers should be close to zero; exits 1 if the hold or the idle kiln
+ *   goes over the RENDER_STATS_* limits.
+ *
+ * Bench mode (--bench [--cycles N] [--out PATH] [--baseline FILE] [--write-baseline FILE]):
+ *   Runs every scene of --screenshot through N dashboard ticks (default 120,
+ *   one minute of firmware time) with the kiln moving the way it would in
+ *   that state, and writes JSON: CPU per dashboard_update and per
+ *   lv_timer_handler pass, invalidated area, flushed pixels and LVGL heap use
+ *   per scene. Run it before and after a UI change to see what it costs.
+ *   With --baseline it exits 1 when a scene's p99 dashboard_update or
+ *   lv_timer_handler CPU, or its flushed pixels per tick, goes past the
+ *   baseline by more than the file's threshold. CPU is compared in units of
+ *   a calibration loop timed in the same run, as bisque_bench does, so the
+ *   baseline holds across machines.
  */
 #include "lvgl.h"
 #include "app_config.h"
@@ -24,6 +43,7 @@
 #include "modal_profile_picker.h"
 #include "modal_action_menu.h"
 #include "splash.h"
+#include "render_stats.h"
 #include "thermocouple.h"
 #include "firing_types.h"
 #include "firing_engine.h"
@@ -31,10 +51,13 @@
 #include "mock_esp.h"
 
 #include <SDL2/SDL.h>
+#include <inttypes.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <time.h>
 #include <unistd.h>
 #include <stdbool.h>
 
@@ -143,7 +166,7 @@ static void apply_preset(int idx)
     }
 
     s_current_preset = idx;
-    printf("Preset: %s\n", p->name);
+    fprintf(stderr, "Preset: %s\n", p->name); /* stderr: --bench writes JSON to stdout */
 }
 
 /* ── Frame pump ──────────────────────────────────────────────────────────── */
@@ -467,14 +490,525 @@ static int run_diff_mode(lv_display_t *disp)
     return (s.failed > 0 || s.missing_baseline > 0) ? 1 : 0;
 }
 
+/* Ceilings for the steady scenarios, per second. A hold changes the elapsed
+ * and remaining labels once a minute each and an idle kiln at a constant
+ * temperature changes nothing, so a correct dashboard stays well under
+ * these. Rewriting every label on every tick comes to several invalidations
+ * and tens of thousands of pixels a second, which these catch. */
+#define RENDER_STATS_HOLD_MAX_INVAL 0.5
+#define RENDER_STATS_HOLD_MAX_PX    2000.0
+#define RENDER_STATS_IDLE_MAX_INVAL 0.1
+#define RENDER_STATS_IDLE_MAX_PX    200.0
+
+/* Replays `seconds` of firmware time: a 500 ms dashboard tick with the
+ * kiln following `ramp_c_per_h`, then a refresh, as display_task would run.
+ * False if invalidations or flushed pixels per second exceed `max_inval` or
+ * `max_px`; a negative limit is not checked. */
+static bool render_stats_scenario(lv_display_t *disp, const char *preset, float ramp_c_per_h, int seconds,
+                                  double max_inval, double max_px)
+{
+    for (int i = 0; i < (int)PRESET_COUNT; i++) {
+        if (strcmp(presets[i].name, preset) == 0) {
+            apply_preset(i);
+        }
+    }
+    pump_frames(8); /* settle the view switch so it isn't counted */
+
+    thermocouple_reading_t tc;
+    firing_progress_t prog;
+    thermocouple_get_latest(&tc);
+    firing_engine_get_progress(&prog);
+    uint32_t elapsed_ms = prog.elapsed_time * 1000u;
+    uint32_t remaining_ms = prog.estimated_remaining * 1000u;
+
+    render_stats_t before;
+    render_stats_get(&before);
+    for (int tick = 0; tick < seconds * 2; tick++) {
+        elapsed_ms += 500;
+        remaining_ms = remaining_ms > 500 ? remaining_ms - 500 : 0;
+        tc.temperature_c += ramp_c_per_h / 7200.0f;
+        prog.current_temp = tc.temperature_c;
+        if (prog.is_active) {
+            prog.elapsed_time = elapsed_ms / 1000u;
+            prog.estimated_remaining = remaining_ms / 1000u;
+        }
+        dashboard_update(&tc, &prog);
+        lv_refr_now(disp);
+    }
+    render_stats_t after;
+    render_stats_get(&after);
+
+    double n = (double)seconds;
+    double inval_per_s = (double)(after.invalidations - before.invalidations) / n;
+    double px_per_s = (double)(after.pixels - before.pixels) / n;
+    /* RGB565 on the 40 MHz SPI bus the MAX31855 shares. */
+    double bus_pct = px_per_s * 16.0 / 40e6 * 100.0;
+    printf("%-8s %6.2f inval/s %6.2f frames/s %6.2f flushes/s %9.0f px/s (%.2f%% of SPI)\n", preset, inval_per_s,
+           (double)(after.frames - before.frames) / n, (double)(after.flushes - before.flushes) / n, px_per_s,
+           bus_pct);
+
+    bool ok = true;
+    if (max_inval >= 0.0 && inval_per_s > max_inval) {
+        printf("         FAIL: %.2f inval/s over the %.2f limit\n", inval_per_s, max_inval);
+        ok = false;
+    }
+    if (max_px >= 0.0 && px_per_s > max_px) {
+        printf("         FAIL: %.0f px/s over the %.0f limit\n", px_per_s, max_px);
+        ok = false;
+    }
+    return ok;
+}
+
+static int run_render_stats(lv_display_t *disp)
+{
+    printf("Per second of dashboard time (500 ms ticks):\n");
+    bool ok = true;
+    render_stats_scenario(disp, "heating", 100.0f, 600, -1.0, -1.0);
+    ok &= render_stats_scenario(disp, "holding", 0.0f, 600, RENDER_STATS_HOLD_MAX_INVAL, RENDER_STATS_HOLD_MAX_PX);
+    ok &= render_stats_scenario(disp, "idle", 0.0f, 600, RENDER_STATS_IDLE_MAX_INVAL, RENDER_STATS_IDLE_MAX_PX);
+    return ok ? 0 : 1;
+}
+
+/* ── Bench ───────────────────────────────────────────────────────────────── */
+
+#define BENCH_DEFAULT_CYCLES 120
+#define BENCH_TICK_MS        500 /* dashboard_tick_cb period */
+#define BENCH_MAX_SCENES     32
+#define BENCH_CALIB_ROUNDS   31  /* calibration is the fastest of these */
+#define BENCH_CPU_THRESHOLD  2.0 /* p99 CPU vs baseline; p99 of 120 ticks is noisier than a minimum */
+#define BENCH_PX_THRESHOLD   1.1 /* flushed px per tick is deterministic, so kept tight */
+
+/* Virtual time on top of SDL's clock: each bench cycle jumps it by a
+ * dashboard period so every LVGL timer (refresh included) is due on the pass
+ * that follows, as it is on the device after the 500 ms tick. */
+static uint32_t s_tick_offset_ms;
+
+static uint32_t bench_tick_cb(void)
+{
+    return SDL_GetTicks() + s_tick_offset_ms;
+}
+
+typedef struct {
+    double p50, p99, max, mean;
+} bench_dist_t;
+
+typedef struct {
+    char name[32];
+    int cycles;
+    bench_dist_t update_us;  /* dashboard_update */
+    bench_dist_t handler_us; /* lv_timer_handler: layout, render, flush */
+    render_stats_t render;   /* totals over the cycles */
+    size_t heap_used_start;
+    size_t heap_used_max;
+    size_t heap_used_end;
+    uint32_t heap_blocks_end;
+} bench_scene_t;
+
+typedef struct {
+    int cycles;
+    int count;
+    double *update_buf;
+    double *handler_buf;
+    bench_scene_t scenes[BENCH_MAX_SCENES];
+} bench_run_t;
+
+static double thread_cpu_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+static volatile uint32_t s_bench_sink;
+
+/* The same fixed serial float/integer work bisque_bench calibrates with.
+ * Do not change it without re-recording ui_bench_baseline.json. */
+static double bench_calibration_us(void)
+{
+    double best = 0;
+    for (int r = 0; r < BENCH_CALIB_ROUNDS; r++) {
+        double t0 = thread_cpu_us();
+        uint32_t x = 1;
+        float f = 1.0f;
+        for (uint32_t i = 0; i < 4096; i++) {
+            for (int k = 0; k < 64; k++) {
+                x = x * 1664525u + 1013904223u;
+                f = f * 0.999f + (float)(x >> 24) * 1e-3f;
+            }
+        }
+        s_bench_sink = x + (uint32_t)f;
+        double us = thread_cpu_us() - t0;
+        if (r == 0 || us < best) {
+            best = us;
+        }
+    }
+    return best;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static bench_dist_t bench_dist(double *v, int n)
+{
+    bench_dist_t d = {0};
+    if (n <= 0) {
+        return d;
+    }
+    double sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += v[i];
+    }
+    qsort(v, (size_t)n, sizeof(v[0]), cmp_double);
+    d.p50 = v[n / 2];
+    d.p99 = v[(n * 99) / 100 < n ? (n * 99) / 100 : n - 1];
+    d.max = v[n - 1];
+    d.mean = sum / n;
+    return d;
+}
+
+/* One dashboard tick of kiln motion for the current state: MAX31855-quantised
+ * (0.25 °C) readings along a ramp, a hold or a cool-down, with a little
+ * deterministic noise so the temperature label changes now and then. */
+static void bench_advance(int cycle, thermocouple_reading_t *tc, firing_progress_t *prog, uint32_t *rng,
+                          float *exact_c)
+{
+    float rate_c_per_h;
+    switch (prog->status) {
+    case FIRING_STATUS_HEATING:
+        rate_c_per_h = 150.0f;
+        break;
+    case FIRING_STATUS_COOLING:
+    case FIRING_STATUS_COMPLETE:
+        rate_c_per_h = -100.0f;
+        break;
+    default:
+        rate_c_per_h = 0.0f;
+        break;
+    }
+    *exact_c += rate_c_per_h * (float)BENCH_TICK_MS / 3.6e6f;
+    *rng = *rng * 1664525u + 1013904223u;
+    float noise = (float)((int)(*rng >> 30) - 1) * 0.25f; /* -0.25, 0, +0.25, +0.5 */
+    tc->temperature_c = floorf((*exact_c + noise) * 4.0f) / 4.0f;
+    prog->current_temp = tc->temperature_c;
+    /* Progress counts whole seconds: every other 500 ms tick. */
+    if (prog->is_active && prog->status != FIRING_STATUS_PAUSED && cycle % 2 == 1) {
+        prog->elapsed_time++;
+        if (prog->estimated_remaining > 0) {
+            prog->estimated_remaining--;
+        }
+    }
+}
+
+static void bench_scene(lv_display_t *disp, const char *name, void *ctx)
+{
+    (void)disp;
+    bench_run_t *run = ctx;
+    if (run->count == BENCH_MAX_SCENES) {
+        fprintf(stderr, "bench: more than %d scenes, skipping %s\n", BENCH_MAX_SCENES, name);
+        return;
+    }
+    bench_scene_t *sc = &run->scenes[run->count++];
+    snprintf(sc->name, sizeof(sc->name), "%s", name);
+    sc->cycles = run->cycles;
+
+    thermocouple_reading_t tc;
+    firing_progress_t prog;
+    thermocouple_get_latest(&tc);
+    firing_engine_get_progress(&prog);
+    float exact_c = tc.temperature_c;
+    uint32_t rng = 1;
+
+    lv_mem_monitor_t mem;
+    lv_mem_monitor(&mem);
+    sc->heap_used_start = mem.total_size - mem.free_size;
+    sc->heap_used_max = sc->heap_used_start;
+
+    render_stats_t before;
+    render_stats_get(&before);
+    for (int i = 0; i < run->cycles; i++) {
+        bench_advance(i, &tc, &prog, &rng, &exact_c);
+        mock_set_thermocouple(&tc);
+        mock_set_progress(&prog);
+        s_tick_offset_ms += BENCH_TICK_MS;
+
+        /* dashboard_tick_cb's work, then the loop pass that renders it. */
+        double t0 = thread_cpu_us();
+        thermocouple_reading_t cur_tc;
+        firing_progress_t cur_prog;
+        thermocouple_get_latest(&cur_tc);
+        firing_engine_get_progress(&cur_prog);
+        dashboard_update(&cur_tc, &cur_prog);
+        double t1 = thread_cpu_us();
+        lv_timer_handler();
+        double t2 = thread_cpu_us();
+        run->update_buf[i] = t1 - t0;
+        run->handler_buf[i] = t2 - t1;
+
+        lv_mem_monitor(&mem);
+        size_t used = mem.total_size - mem.free_size;
+        if (used > sc->heap_used_max) {
+            sc->heap_used_max = used;
+        }
+    }
+    render_stats_t after;
+    render_stats_get(&after);
+    sc->render.invalidations = after.invalidations - before.invalidations;
+    sc->render.invalidated_pixels = after.invalidated_pixels - before.invalidated_pixels;
+    sc->render.frames = after.frames - before.frames;
+    sc->render.flushes = after.flushes - before.flushes;
+    sc->render.pixels = after.pixels - before.pixels;
+    sc->update_us = bench_dist(run->update_buf, run->cycles);
+    sc->handler_us = bench_dist(run->handler_buf, run->cycles);
+    lv_mem_monitor(&mem);
+    sc->heap_used_end = mem.total_size - mem.free_size;
+    sc->heap_blocks_end = mem.used_cnt;
+}
+
+static void bench_write_dist(FILE *out, const char *key, const bench_dist_t *d)
+{
+    fprintf(out, "\"%s\": {\"p50\": %.2f, \"p99\": %.2f, \"max\": %.2f, \"mean\": %.2f}", key, d->p50, d->p99,
+            d->max, d->mean);
+}
+
+static void bench_write_json(FILE *out, const bench_run_t *run, double calib_us)
+{
+    fprintf(out,
+            "{\n  \"lvgl\": \"%d.%d.%d\",\n  \"tick_ms\": %d,\n  \"cycles\": %d,\n  \"calibration_us\": %.2f,"
+            "\n  \"scenes\": [",
+            LVGL_VERSION_MAJOR, LVGL_VERSION_MINOR, LVGL_VERSION_PATCH, BENCH_TICK_MS, run->cycles, calib_us);
+    for (int i = 0; i < run->count; i++) {
+        const bench_scene_t *sc = &run->scenes[i];
+        double n = (double)sc->cycles;
+        fprintf(out, "%s\n    {\"name\": \"%s\",\n     ", i ? "," : "", sc->name);
+        bench_write_dist(out, "update_cpu_us", &sc->update_us);
+        fprintf(out, ",\n     ");
+        bench_write_dist(out, "handler_cpu_us", &sc->handler_us);
+        fprintf(out,
+                ",\n     \"frames\": %" PRIu32 ", \"invalidations\": %" PRIu32 ", \"flushes\": %" PRIu32
+                ",\n     \"invalidated_px_per_cycle\": %.1f, \"flushed_px_per_cycle\": %.1f,"
+                "\n     \"heap_used_bytes\": {\"start\": %zu, \"max\": %zu, \"end\": %zu},"
+                " \"heap_blocks_end\": %" PRIu32 "}",
+                sc->render.frames, sc->render.invalidations, sc->render.flushes,
+                (double)sc->render.invalidated_pixels / n, (double)sc->render.pixels / n, sc->heap_used_start,
+                sc->heap_used_max, sc->heap_used_end, sc->heap_blocks_end);
+    }
+    fprintf(out, "\n  ]\n}\n");
+}
+
+/* ── Bench baseline ──────────────────────────────────────────────────────── */
+
+/* ui_bench_baseline.json is written by --write-baseline and read back here
+ * with a few string searches rather than a JSON library, so it has to keep
+ * the shape bench_write_baseline gives it: one object per scene, keyed by
+ * name, with no nesting inside. */
+typedef struct {
+    double cpu_threshold;
+    double px_threshold;
+    char *text;
+} bench_baseline_t;
+
+typedef struct {
+    double update_p99_rel;
+    double handler_p99_rel;
+    double flushed_px_per_cycle;
+} bench_scene_base_t;
+
+static bool json_number_after(const char *from, const char *end, const char *key, double *out)
+{
+    char pattern[48];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char *at = strstr(from, pattern);
+    if (!at || (end && at >= end)) {
+        return false;
+    }
+    char *num_end;
+    double v = strtod(at + strlen(pattern), &num_end);
+    if (num_end == at + strlen(pattern)) {
+        return false;
+    }
+    *out = v;
+    return true;
+}
+
+static bool bench_read_baseline(const char *path, bench_baseline_t *b)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    b->text = len >= 0 ? malloc((size_t)len + 1) : NULL;
+    bool ok = b->text && fread(b->text, 1, (size_t)len, f) == (size_t)len;
+    fclose(f);
+    if (ok) {
+        b->text[len] = '\0';
+        ok = strstr(b->text, "\"scenes\":") != NULL;
+    }
+    if (!ok) {
+        free(b->text);
+        b->text = NULL;
+        return false;
+    }
+    b->cpu_threshold = BENCH_CPU_THRESHOLD;
+    b->px_threshold = BENCH_PX_THRESHOLD;
+    double v;
+    if (json_number_after(b->text, NULL, "cpu_threshold", &v) && v > 1.0) {
+        b->cpu_threshold = v;
+    }
+    if (json_number_after(b->text, NULL, "px_threshold", &v) && v >= 1.0) {
+        b->px_threshold = v;
+    }
+    return true;
+}
+
+static bool bench_baseline_scene(const bench_baseline_t *b, const char *name, bench_scene_base_t *out)
+{
+    char key[48];
+    snprintf(key, sizeof(key), "\"%s\": {", name);
+    const char *at = strstr(strstr(b->text, "\"scenes\":"), key);
+    if (!at) {
+        return false;
+    }
+    const char *end = strchr(at, '}');
+    return json_number_after(at, end, "update_p99_rel", &out->update_p99_rel) &&
+           json_number_after(at, end, "handler_p99_rel", &out->handler_p99_rel) &&
+           json_number_after(at, end, "flushed_px_per_cycle", &out->flushed_px_per_cycle);
+}
+
+static void bench_write_baseline(FILE *out, const bench_run_t *run, double calib_us, double cpu_threshold,
+                                 double px_threshold)
+{
+    fprintf(out, "{\n  \"lvgl\": \"%d.%d.%d\",\n  \"cycles\": %d,\n  \"cpu_threshold\": %.4g,\n"
+                 "  \"px_threshold\": %.4g,\n  \"scenes\": {",
+            LVGL_VERSION_MAJOR, LVGL_VERSION_MINOR, LVGL_VERSION_PATCH, run->cycles, cpu_threshold, px_threshold);
+    for (int i = 0; i < run->count; i++) {
+        const bench_scene_t *sc = &run->scenes[i];
+        /* Four significant figures keep baseline diffs readable. */
+        fprintf(out,
+                "%s\n    \"%s\": {\"update_p99_rel\": %.4g, \"handler_p99_rel\": %.4g, "
+                "\"flushed_px_per_cycle\": %.1f}",
+                i ? "," : "", sc->name, sc->update_us.p99 / calib_us, sc->handler_us.p99 / calib_us,
+                (double)sc->render.pixels / sc->cycles);
+    }
+    fprintf(out, "\n  }\n}\n");
+}
+
+/* Prints a verdict per scene; returns how many regressed. Scenes missing
+ * from the baseline are reported as new and do not fail the run. */
+static int bench_compare(const bench_run_t *run, const bench_baseline_t *b, double calib_us)
+{
+    int regressions = 0;
+    fprintf(stderr, "\n%-24s %10s %10s %12s  vs baseline (CPU x%.2f, px x%.2f)\n", "scene", "upd p99", "hdl p99",
+            "flush px/cy", b->cpu_threshold, b->px_threshold);
+    for (int i = 0; i < run->count; i++) {
+        const bench_scene_t *sc = &run->scenes[i];
+        double upd = sc->update_us.p99 / calib_us;
+        double hdl = sc->handler_us.p99 / calib_us;
+        double px = (double)sc->render.pixels / sc->cycles;
+        bench_scene_base_t base;
+        const char *verdict = "new";
+        if (bench_baseline_scene(b, sc->name, &base)) {
+            bool regressed = upd > base.update_p99_rel * b->cpu_threshold ||
+                             hdl > base.handler_p99_rel * b->cpu_threshold ||
+                             px > base.flushed_px_per_cycle * b->px_threshold;
+            regressions += regressed;
+            verdict = regressed ? "REGRESSED" : "ok";
+            fprintf(stderr, "%-24s %10.4f %10.4f %12.0f  %s (baseline %.4f %.4f %.0f)\n", sc->name, upd, hdl, px,
+                    verdict, base.update_p99_rel, base.handler_p99_rel, base.flushed_px_per_cycle);
+        } else {
+            fprintf(stderr, "%-24s %10.4f %10.4f %12.0f  %s\n", sc->name, upd, hdl, px, verdict);
+        }
+    }
+    return regressions;
+}
+
+static int run_bench(lv_display_t *disp, int cycles, const char *out_path, const char *baseline_path,
+                     const char *write_path)
+{
+    bench_baseline_t baseline = {0};
+    if (baseline_path && !bench_read_baseline(baseline_path, &baseline)) {
+        fprintf(stderr, "bench: cannot read baseline %s\n", baseline_path);
+        return 2;
+    }
+
+    bench_run_t run = {.cycles = cycles};
+    run.update_buf = calloc((size_t)cycles, sizeof(double));
+    run.handler_buf = calloc((size_t)cycles, sizeof(double));
+    if (!run.update_buf || !run.handler_buf) {
+        fprintf(stderr, "bench: out of memory\n");
+        free(run.update_buf);
+        free(run.handler_buf);
+        return 2;
+    }
+
+    double calib_us = bench_calibration_us();
+    lv_tick_set_cb(bench_tick_cb);
+    for_each_scene(disp, bench_scene, &run);
+
+    int rc = 0;
+    FILE *out = out_path ? fopen(out_path, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "bench: cannot write %s\n", out_path);
+        rc = 2;
+    } else {
+        bench_write_json(out, &run, calib_us);
+        if (out != stdout) {
+            fclose(out);
+            printf("Wrote %s\n", out_path);
+        }
+    }
+    if (write_path) {
+        FILE *bf = fopen(write_path, "w");
+        if (!bf) {
+            fprintf(stderr, "bench: cannot write %s\n", write_path);
+            rc = 2;
+        } else {
+            bench_write_baseline(bf, &run, calib_us, baseline.text ? baseline.cpu_threshold : BENCH_CPU_THRESHOLD,
+                                 baseline.text ? baseline.px_threshold : BENCH_PX_THRESHOLD);
+            fclose(bf);
+            printf("Wrote %s\n", write_path);
+        }
+    }
+
+    fprintf(stderr, "%-24s %10s %10s %12s %12s %10s\n", "scene", "upd p50us", "hdl p50us", "inval px/cy",
+            "flush px/cy", "heap max");
+    for (int i = 0; i < run.count; i++) {
+        const bench_scene_t *sc = &run.scenes[i];
+        fprintf(stderr, "%-24s %10.1f %10.1f %12.0f %12.0f %10zu\n", sc->name, sc->update_us.p50, sc->handler_us.p50,
+                (double)sc->render.invalidated_pixels / sc->cycles, (double)sc->render.pixels / sc->cycles,
+                sc->heap_used_max);
+    }
+
+    if (baseline.text) {
+        int regressions = bench_compare(&run, &baseline, calib_us);
+        if (regressions) {
+            fprintf(stderr, "bench: %d scene(s) past the baseline\n", regressions);
+            if (rc == 0) {
+                rc = 1;
+            }
+        }
+        free(baseline.text);
+    }
+
+    free(run.update_buf);
+    free(run.handler_buf);
+    return rc;
+}
+
 static int run_interactive(lv_display_t *disp)
 {
     (void)disp;
     printf("Bisque LCD Simulator (new dashboard)\n");
     printf("  Up / Down: encoder navigate (in modals)\n");
     printf("  Enter / Space: SELECT (open contextual modal / activate)\n");
-    printf("  Left: cancel current modal\n");
-    printf("  Right: reserved\n");
+    printf("  Left: cancel current modal / zoom chart out\n");
+    printf("  Right: zoom chart in\n");
     printf("  S: cycle through state presets\n");
     printf("  Q / Esc: quit\n");
 
@@ -505,10 +1039,14 @@ static int run_interactive(lv_display_t *disp)
                 case SDLK_LEFT:
                     if (dashboard_modal_active()) {
                         dashboard_modal_close();
+                    } else {
+                        dashboard_chart_zoom(-1);
                     }
                     break;
                 case SDLK_RIGHT:
-                    /* reserved (matches firmware) */
+                    if (!dashboard_modal_active()) {
+                        dashboard_chart_zoom(+1);
+                    }
                     break;
                 case SDLK_s:
                     apply_preset((s_current_preset + 1) % (int)PRESET_COUNT);
@@ -540,16 +1078,37 @@ static int run_interactive(lv_display_t *disp)
 
 int main(int argc, char *argv[])
 {
-    enum { MODE_INTERACTIVE, MODE_SCREENSHOT, MODE_DIFF } mode = MODE_INTERACTIVE;
+    enum { MODE_INTERACTIVE, MODE_SCREENSHOT, MODE_DIFF, MODE_RENDER_STATS, MODE_BENCH } mode = MODE_INTERACTIVE;
+    int bench_cycles = BENCH_DEFAULT_CYCLES;
+    const char *bench_out = NULL;
+    const char *bench_baseline = NULL;
+    const char *bench_write_baseline_path = NULL;
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--screenshot") == 0) {
             mode = MODE_SCREENSHOT;
         } else if (strcmp(argv[i], "--diff") == 0) {
             mode = MODE_DIFF;
+        } else if (strcmp(argv[i], "--render-stats") == 0) {
+            mode = MODE_RENDER_STATS;
+        } else if (strcmp(argv[i], "--bench") == 0) {
+            mode = MODE_BENCH;
+        } else if (strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) {
+            bench_cycles = atoi(argv[++i]);
+            if (bench_cycles <= 0) {
+                fprintf(stderr, "--cycles needs a positive count\n");
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            bench_out = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            bench_baseline = argv[++i];
+        } else if (strcmp(argv[i], "--write-baseline") == 0 && i + 1 < argc) {
+            bench_write_baseline_path = argv[++i];
         }
     }
 
     lv_display_t *disp = init_lvgl_sdl();
+    render_stats_attach(disp);
 
     /* Build the dashboard the same way the firmware does. */
     dashboard_create();
@@ -562,6 +1121,12 @@ int main(int argc, char *argv[])
     case MODE_DIFF:
         rc = run_diff_mode(disp);
         break;
+    case MODE_RENDER_STATS:
+        rc = run_render_stats(disp);
+        break;
+    case MODE_BENCH:
+        rc = run_bench(disp, bench_cycles, bench_out, bench_baseline, bench_write_baseline_path);
+        break;
     case MODE_INTERACTIVE:
     default:
         rc = run_interactive(disp);
@@ -64,9 +64,52 @@ char firing_engine_get_temp_unit(void)
     return 'F';
 }
 
+/* ── Mock temperature trace ──────────────────────────────────────────────── */
+
+/* Fed from mock_set_progress() the way firing_tick feeds the real one: one
+ * sample per progress update at its elapsed time, using the latest mock
+ * thermocouple reading. A jump of more than a minute (a preset landing hours
+ * into a firing) is backfilled from the planned curve so the zoom levels have
+ * something to show. */
+#define MOCK_TRACE_BACKFILL_STEP_S 5u
+
+static temp_trace_t s_mock_trace;
+static uint32_t s_mock_trace_s;
+static bool s_mock_trace_live = false;
+
+static void mock_trace_follow(const firing_progress_t *p)
+{
+    if (!p->is_active) {
+        s_mock_trace_live = false;
+        return;
+    }
+    if (!s_mock_trace_live || p->elapsed_time < s_mock_trace_s) {
+        temp_trace_reset(&s_mock_trace);
+        s_mock_trace_s = 0;
+        s_mock_trace_live = true;
+    }
+    if (p->elapsed_time - s_mock_trace_s > 60u) {
+        /* No profile, no planned curve: the trace then starts at the jump. */
+        firing_profile_t profile;
+        if (firing_engine_load_profile(p->profile_id, &profile) == ESP_OK) {
+            for (uint32_t t = s_mock_trace_s; t < p->elapsed_time; t += MOCK_TRACE_BACKFILL_STEP_S) {
+                temp_trace_add(&s_mock_trace, t * 1000u, firing_planned_temp_at(&profile, t, 20.0f));
+            }
+        }
+    }
+    temp_trace_add(&s_mock_trace, p->elapsed_time * 1000u, s_mock_tc.temperature_c);
+    s_mock_trace_s = p->elapsed_time;
+}
+
+void firing_engine_get_trace(temp_trace_zoom_t zoom, temp_trace_view_t *out)
+{
+    temp_trace_copy(&s_mock_trace, zoom, out);
+}
+
 void mock_set_progress(const firing_progress_t *p)
 {
     s_mock_progress = *p;
+    mock_trace_follow(p);
 }
 
 /* ── Mock command queue (sink) ───────────────────────────────────────────── */
@@ -0,0 +1,517 @@
+/**
+ * bisque_bench — microbenchmarks for the pure per-tick and per-request
+ * functions, with a stored baseline so cost changes show up at review time.
+ *
+ *   bisque_bench --baseline ../bench_baseline.json --out bench.json
+ *
+ * Each benchmark is warmed up, then timed in batches sized to run ~200 µs
+ * (long enough to swamp clock_gettime overhead), and the per-call cost of
+ * every batch becomes one sample. The JSON report carries min/p50/p90/p99/max
+ * ns per call.
+ *
+ * Absolute nanoseconds depend on the machine, so the baseline stores each
+ * benchmark's fastest sample relative to the fastest sample of a fixed
+ * calibration loop timed the same way in the same process ("rel"). The
+ * minimum is the sample least disturbed by other load on the machine, which
+ * keeps rel steady run to run. A benchmark regresses when its rel exceeds the
+ * baseline by more than --threshold (default: the baseline file's, else
+ * 1.5×). Refresh the baseline with --write-baseline after a deliberate
+ * change and commit it alongside.
+ *
+ * Exit status: 0 within threshold, 1 on any regression, 2 usage/IO.
+ */
+#include "api_json.h"
+#include "cJSON.h"
+#include "cone_table.h"
+#include "esp_timer.h"
+#include "firing_engine.h"
+#include "firing_engine_internal.h"
+#include "pid_control.h"
+#include "safety_host.h"
+#include "thermocouple_host.h"
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_MAX_SAMPLES  1001
+#define DEFAULT_THRESHOLD  1.5
+
+/* Results land here so the compiler cannot drop a call as dead. */
+static volatile float s_sink_f;
+static volatile uint32_t s_sink_u;
+
+/* Inputs shared by the benchmarks, built once in bench_setup(). */
+static firing_profile_t s_cone_profile; /* cone 6 medium, preheat + slow cool */
+static firing_profile_t s_long_profile; /* FIRING_MAX_SEGMENTS segments */
+static kiln_cap_t s_cap;                /* every bin learned, slower than the ramps near the top */
+static pid_controller_t s_pid;
+static firing_progress_t s_progress;
+static thermocouple_reading_t s_tc;
+static int64_t s_tick_now_us;
+
+/* ── Benchmarks ───────────────────────────────────── */
+
+/* A benchmark runs `n` calls, varying its inputs with the call index. */
+typedef void (*bench_fn)(uint32_t n);
+
+static void bench_calibration(uint32_t n)
+{
+    /* Fixed serial float/integer work: the yardstick the baseline is
+       expressed in. Do not change it without regenerating the baseline. */
+    uint32_t x = 1;
+    float f = 1.0f;
+    for (uint32_t i = 0; i < n; i++) {
+        for (int k = 0; k < 64; k++) {
+            x = x * 1664525u + 1013904223u;
+            f = f * 0.999f + (float)(x >> 24) * 1e-3f;
+        }
+    }
+    s_sink_u = x;
+    s_sink_f = f;
+}
+
+static void bench_compute_dynamic_setpoint(uint32_t n)
+{
+    const firing_segment_t *seg = &s_cone_profile.segments[2];
+    float acc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        acc += compute_dynamic_setpoint(seg, 600.0f, 0, (int64_t)(i & 0xFFFF) * 1000000LL, false);
+    }
+    s_sink_f = acc;
+}
+
+static void bench_at_target_predicate(uint32_t n)
+{
+    uint32_t hits = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        hits += at_target_predicate(1220.0f + (float)(i & 7) * 0.5f, 1222.0f, 1222.0f);
+    }
+    s_sink_u = hits;
+}
+
+static void bench_firing_remaining_s(uint32_t n)
+{
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        acc += firing_remaining_s(&s_long_profile, (int)(i & 3), 400.0f + (float)(i & 63), false, 0.0f, &s_cap, 0.9f);
+    }
+    s_sink_u = acc;
+}
+
+static void bench_firing_planned_temp_at(uint32_t n)
+{
+    float acc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        acc += firing_planned_temp_at(&s_cone_profile, (i * 97u) % 50000u, 25.0f);
+    }
+    s_sink_f = acc;
+}
+
+static void bench_pid_compute(uint32_t n)
+{
+    float acc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        acc += pid_compute(&s_pid, 1000.0f, 995.0f + (float)(i & 15) * 0.25f, 1.0f);
+    }
+    s_sink_f = acc;
+}
+
+static void bench_cone_fire_generate(uint32_t n)
+{
+    firing_profile_t p;
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        cone_fire_generate((cone_id_t)(i % CONE_COUNT), (cone_speed_t)(i % 3), i & 1, i & 2, &p);
+        acc += p.segment_count;
+    }
+    s_sink_u = acc;
+}
+
+/* The JSON benchmarks include printing and freeing: that is what a request
+   or a WebSocket push pays. */
+static void bench_json(uint32_t n, cJSON *(*build)(void))
+{
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        cJSON *root = build();
+        char *s = cJSON_PrintUnformatted(root);
+        acc += (uint32_t)strlen(s);
+        cJSON_free(s);
+        cJSON_Delete(root);
+    }
+    s_sink_u = acc;
+}
+
+static cJSON *build_status(void)
+{
+    return build_status_json(&s_progress, &s_tc, 1.5f);
+}
+
+static cJSON *build_profile(void)
+{
+    return build_profile_json(&s_cone_profile);
+}
+
+static void bench_build_status_json(uint32_t n)
+{
+    bench_json(n, build_status);
+}
+
+static void bench_build_profile_json(uint32_t n)
+{
+    bench_json(n, build_profile);
+}
+
+/* One whole engine tick holding at peak: the sum of the above as the device
+   runs it every second, plus the engine's own bookkeeping. */
+static void bench_firing_tick(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        s_tick_now_us += 1000000LL;
+        host_clock_set(s_tick_now_us);
+        firing_tick(s_tick_now_us);
+    }
+    s_sink_f = safety_test_last_duty();
+}
+
+typedef struct {
+    const char *name;
+    bench_fn fn;
+} bench_def_t;
+
+static const bench_def_t BENCHES[] = {
+    {"compute_dynamic_setpoint", bench_compute_dynamic_setpoint},
+    {"at_target_predicate", bench_at_target_predicate},
+    {"firing_remaining_s", bench_firing_remaining_s},
+    {"firing_planned_temp_at", bench_firing_planned_temp_at},
+    {"pid_compute", bench_pid_compute},
+    {"cone_fire_generate", bench_cone_fire_generate},
+    {"build_status_json", bench_build_status_json},
+    {"build_profile_json", bench_build_profile_json},
+    {"firing_tick", bench_firing_tick},
+};
+#define BENCH_COUNT (sizeof(BENCHES) / sizeof(BENCHES[0]))
+
+static void bench_setup(void)
+{
+    cone_fire_generate(CONE_6, CONE_SPEED_MEDIUM, true, true, &s_cone_profile);
+
+    memset(&s_long_profile, 0, sizeof(s_long_profile));
+    s_long_profile.segment_count = FIRING_MAX_SEGMENTS;
+    for (int i = 0; i < FIRING_MAX_SEGMENTS; i++) {
+        s_long_profile.segments[i].ramp_rate = (i % 2) ? -100.0f : 150.0f;
+        s_long_profile.segments[i].target_temp = (i % 2) ? 500.0f : 1000.0f;
+        s_long_profile.segments[i].hold_time = 10;
+    }
+    for (int b = 0; b < KILN_CAP_BINS; b++) {
+        s_cap.rate_ch[b] = (uint16_t)(500 - 18 * b);
+        s_cap.firings[b] = 3;
+    }
+
+    pid_init(&s_pid, 2.0f, 0.01f, 50.0f, 0.0f, 100.0f);
+
+    s_progress = (firing_progress_t){
+        .is_active = true,
+        .profile_id = "cone6-medium",
+        .current_temp = 1180.25f,
+        .target_temp = 1182.0f,
+        .current_segment = 2,
+        .total_segments = 4,
+        .elapsed_time = 31234,
+        .estimated_remaining = 4321,
+        .status = FIRING_STATUS_HEATING,
+    };
+    s_tc = (thermocouple_reading_t){.temperature_c = 1180.25f, .internal_temp_c = 31.5f};
+
+    /* Engine in an indefinite hold at 1000 °C, so any number of ticks stays
+       on the same path. */
+    firing_engine_init();
+    firing_engine_reset_for_test();
+    firing_cmd_t cmd = {.type = FIRING_CMD_START};
+    strcpy(cmd.start.profile.id, "bench");
+    cmd.start.profile.segment_count = 1;
+    cmd.start.profile.segments[0] = (firing_segment_t){.ramp_rate = 500.0f, .target_temp = 1000.0f,
+                                                       .hold_time = FIRING_HOLD_INDEFINITE};
+    cmd.start.profile.max_temp = 1000.0f;
+    s_tick_now_us = 1000000LL;
+    host_clock_set(s_tick_now_us);
+    thermocouple_test_set(1000.0f, 0);
+    firing_engine_dispatch_cmd_for_test(&cmd);
+    bench_firing_tick(3);
+
+    firing_progress_t prog;
+    firing_engine_get_progress(&prog);
+    if (prog.status != FIRING_STATUS_HOLDING) {
+        fprintf(stderr, "bisque_bench: engine did not reach hold (status %d)\n", (int)prog.status);
+        exit(2);
+    }
+}
+
+/* ── Timing ───────────────────────────────────────── */
+
+typedef struct {
+    uint32_t batch;   /* calls per sample */
+    uint32_t samples;
+    double min_ns, p50_ns, p90_ns, p99_ns, max_ns; /* per call */
+} bench_result_t;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double time_batch(bench_fn fn, uint32_t n)
+{
+    double t0 = now_ns();
+    fn(n);
+    return now_ns() - t0;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of a sorted array. */
+static double percentile(const double *sorted, uint32_t n, double p)
+{
+    uint32_t rank = (uint32_t)ceil(p / 100.0 * n);
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static void run_bench(bench_fn fn, uint32_t samples, double batch_ns, double warmup_ns, bench_result_t *out)
+{
+    /* Grow the batch until it takes batch_ns; the growth doubles as warmup
+       for caches, branch predictors and the allocator. */
+    uint32_t batch = 1;
+    double t;
+    while ((t = time_batch(fn, batch)) < batch_ns && batch < (1u << 30)) {
+        batch *= 2;
+    }
+    batch = (uint32_t)fmax(1.0, batch * batch_ns / fmax(t, 1.0));
+    for (double spent = 0; spent < warmup_ns;) {
+        spent += time_batch(fn, batch);
+    }
+
+    static double per_call[BENCH_MAX_SAMPLES];
+    for (uint32_t i = 0; i < samples; i++) {
+        per_call[i] = time_batch(fn, batch) / batch;
+    }
+    qsort(per_call, samples, sizeof(per_call[0]), cmp_double);
+
+    out->batch = batch;
+    out->samples = samples;
+    out->min_ns = per_call[0];
+    out->p50_ns = percentile(per_call, samples, 50);
+    out->p90_ns = percentile(per_call, samples, 90);
+    out->p99_ns = percentile(per_call, samples, 99);
+    out->max_ns = per_call[samples - 1];
+}
+
+/* ── Baseline ─────────────────────────────────────── */
+
+static cJSON *read_json(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *buf = len >= 0 ? malloc((size_t)len + 1) : NULL;
+    cJSON *root = NULL;
+    if (buf && fread(buf, 1, (size_t)len, f) == (size_t)len) {
+        buf[len] = '\0';
+        root = cJSON_Parse(buf);
+    }
+    free(buf);
+    fclose(f);
+    return root;
+}
+
+static bool write_json(const char *path, const cJSON *root)
+{
+    char *json = cJSON_Print(root);
+    FILE *f = json ? (path ? fopen(path, "w") : stdout) : NULL;
+    bool ok = f && fprintf(f, "%s\n", json) > 0;
+    if (f && f != stdout) {
+        ok = (fclose(f) == 0) && ok;
+    }
+    cJSON_free(json);
+    return ok;
+}
+
+static void usage(FILE *out)
+{
+    fprintf(out, "usage: bisque_bench [options]\n"
+                 "\n"
+                 "  -b, --baseline FILE        compare against this baseline; exit 1 on regression\n"
+                 "  -t, --threshold X          allowed slowdown vs baseline (default: baseline's, else 1.5)\n"
+                 "  -w, --write-baseline FILE  write this run's results as the new baseline\n"
+                 "  -o, --out FILE             write the report JSON here (default stdout)\n"
+                 "  -f, --filter STR           only run benchmarks whose name contains STR\n"
+                 "  -q, --quick                few short samples (smoke run; numbers are noisy)\n"
+                 "  -h, --help\n");
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option opts[] = {
+        {"baseline", required_argument, NULL, 'b'},
+        {"threshold", required_argument, NULL, 't'},
+        {"write-baseline", required_argument, NULL, 'w'},
+        {"out", required_argument, NULL, 'o'},
+        {"filter", required_argument, NULL, 'f'},
+        {"quick", no_argument, NULL, 'q'},
+        {"help", no_argument, NULL, 'h'},
+        {0},
+    };
+
+    const char *baseline_path = NULL;
+    const char *write_path = NULL;
+    const char *out_path = NULL;
+    const char *filter = NULL;
+    double threshold = 0;
+    bool quick = false;
+
+    int c;
+    while ((c = getopt_long(argc, argv, "b:t:w:o:f:qh", opts, NULL)) != -1) {
+        switch (c) {
+        case 'b':
+            baseline_path = optarg;
+            break;
+        case 't':
+            threshold = strtod(optarg, NULL);
+            break;
+        case 'w':
+            write_path = optarg;
+            break;
+        case 'o':
+            out_path = optarg;
+            break;
+        case 'f':
+            filter = optarg;
+            break;
+        case 'q':
+            quick = true;
+            break;
+        case 'h':
+            usage(stdout);
+            return 0;
+        default:
+            usage(stderr);
+            return 2;
+        }
+    }
+    if (optind != argc || (threshold != 0 && !(threshold > 1.0))) {
+        usage(stderr);
+        return 2;
+    }
+
+    cJSON *baseline = NULL;
+    const cJSON *base_rel = NULL;
+    if (baseline_path) {
+        baseline = read_json(baseline_path);
+        base_rel = cJSON_GetObjectItem(baseline, "benchmarks");
+        if (!cJSON_IsObject(base_rel)) {
+            fprintf(stderr, "bisque_bench: cannot read baseline %s\n", baseline_path);
+            cJSON_Delete(baseline);
+            return 2;
+        }
+        const cJSON *t = cJSON_GetObjectItem(baseline, "threshold");
+        if (threshold == 0 && cJSON_IsNumber(t) && t->valuedouble > 1.0) {
+            threshold = t->valuedouble;
+        }
+    }
+    if (threshold == 0) {
+        threshold = DEFAULT_THRESHOLD;
+    }
+
+    const uint32_t samples = quick ? 11 : 201;
+    const double batch_ns = quick ? 20e3 : 200e3;
+    const double warmup_ns = quick ? 2e6 : 50e6;
+
+    bench_setup();
+    bench_result_t calib;
+    run_bench(bench_calibration, samples, batch_ns, warmup_ns, &calib);
+
+    cJSON *report = cJSON_CreateObject();
+    cJSON_AddNumberToObject(report, "calibration_ns", calib.min_ns);
+    cJSON_AddNumberToObject(report, "threshold", threshold);
+    cJSON_AddBoolToObject(report, "quick", quick);
+    cJSON *arr = cJSON_AddArrayToObject(report, "benchmarks");
+    cJSON *new_base = cJSON_CreateObject();
+    int regressions = 0;
+
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+        const bench_def_t *b = &BENCHES[i];
+        if (filter && !strstr(b->name, filter)) {
+            continue;
+        }
+        bench_result_t r;
+        run_bench(b->fn, samples, batch_ns, warmup_ns, &r);
+        double rel = r.min_ns / calib.min_ns;
+
+        cJSON *o = cJSON_CreateObject();
+        cJSON_AddStringToObject(o, "name", b->name);
+        cJSON_AddNumberToObject(o, "batch", r.batch);
+        cJSON_AddNumberToObject(o, "samples", r.samples);
+        cJSON_AddNumberToObject(o, "min_ns", r.min_ns);
+        cJSON_AddNumberToObject(o, "p50_ns", r.p50_ns);
+        cJSON_AddNumberToObject(o, "p90_ns", r.p90_ns);
+        cJSON_AddNumberToObject(o, "p99_ns", r.p99_ns);
+        cJSON_AddNumberToObject(o, "max_ns", r.max_ns);
+        cJSON_AddNumberToObject(o, "rel", rel);
+        /* Four significant figures keep baseline diffs readable. */
+        char rounded[32];
+        snprintf(rounded, sizeof(rounded), "%.4g", rel);
+        cJSON_AddNumberToObject(new_base, b->name, strtod(rounded, NULL));
+
+        const cJSON *base = cJSON_GetObjectItem(base_rel, b->name);
+        const char *verdict = "new";
+        if (cJSON_IsNumber(base) && base->valuedouble > 0) {
+            double ratio = rel / base->valuedouble;
+            bool regressed = ratio > threshold;
+            cJSON_AddNumberToObject(o, "baseline_rel", base->valuedouble);
+            cJSON_AddNumberToObject(o, "ratio", ratio);
+            cJSON_AddBoolToObject(o, "regressed", regressed);
+            regressions += regressed;
+            verdict = regressed ? "REGRESSED" : "ok";
+        }
+        cJSON_AddItemToArray(arr, o);
+        fprintf(stderr, "%-26s p50 %9.1f ns  p99 %9.1f ns  rel %8.4f  %s\n", b->name, r.p50_ns, r.p99_ns, rel,
+                baseline ? verdict : "");
+    }
+    cJSON_AddNumberToObject(report, "regressions", regressions);
+
+    bool io_ok = write_json(out_path, report);
+    if (write_path) {
+        cJSON *root = cJSON_CreateObject();
+        cJSON_AddNumberToObject(root, "threshold", threshold);
+        cJSON_AddItemToObject(root, "benchmarks", new_base);
+        new_base = NULL;
+        io_ok = write_json(write_path, root) && io_ok;
+        cJSON_Delete(root);
+    }
+    cJSON_Delete(new_base);
+    cJSON_Delete(report);
+    cJSON_Delete(baseline);
+
+    if (!io_ok) {
+        fprintf(stderr, "bisque_bench: write failed\n");
+        return 2;
+    }
+    if (regressions) {
+        fprintf(stderr, "bisque_bench: %d benchmark(s) slower than %.2fx baseline\n", regressions, threshold);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,310 @@
+/**
+ * bisque_firesim — run a whole firing profile through the real firing engine
+ * and PID against the host kiln model, faster than real time.
+ *
+ *   bisque_firesim --profile docs/smoke-test-profile.json --plant large \
+ *                  --fault tc-open@3h+30s --trace trace.csv
+ *
+ * Writes a per-second CSV trace (optional) and a KPI summary as JSON: total
+ * time, energy, cost, overshoot and RMS tracking error, per-segment
+ * breakdown. The firesim_mc invariants are checked throughout, so a
+ * reproducer printed by bisque_firesim_mc fails here the same way.
+ *
+ * Exit status: 0 when the firing completed, 1 when it ended any other way
+ * (error, stop, timeout, rejected), 2 on a usage or I/O error, 3 when an
+ * invariant broke.
+ */
+#include "api_json.h"
+#include "cJSON.h"
+#include "firesim.h"
+#include "firesim_mc.h"
+#include "pid_control.h"
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    FILE *f;
+    uint32_t every_s;
+    firesim_mc_checker_t checker;
+} trace_ctx_t;
+
+static void usage(FILE *out)
+{
+    fprintf(out, "usage: bisque_firesim --profile FILE [options]\n"
+                 "\n"
+                 "  -p, --profile FILE     profile JSON (same shape as POST /api/v1/profiles)\n"
+                 "  -k, --plant NAME       kiln model: small | large (default small)\n"
+                 "  -s, --start-temp C     starting kiln temperature (default 25)\n"
+                 "  -d, --delay MIN        delayed start, minutes (default 0)\n"
+                 "  -m, --max-safe C       safety over-temperature limit (default 1300)\n"
+                 "  -H, --max-hours H      simulated-time cap (default 72)\n"
+                 "  -f, --fault SPEC       inject a fault, repeatable: kind@time[+dur][=value]\n"
+                 "                         kinds: tc-open tc-spike elements pause skip stop\n"
+                 "                         e.g. tc-open@3h+30s  elements@0=0.8  pause@2h+30m\n"
+                 "  -g, --pid KP,KI,KD     PID gains (default: firmware defaults)\n"
+                 "  -t, --trace FILE       write a CSV trace ('-' for stdout)\n"
+                 "  -e, --trace-every S    trace sample period in seconds (default 60)\n"
+                 "  -o, --kpi FILE         write the KPI JSON here (default stdout)\n"
+                 "  -c, --cost-kwh PRICE   electricity price per kWh (default 0.15)\n"
+                 "  -h, --help\n");
+}
+
+static char *read_file(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *buf = len >= 0 ? malloc((size_t)len + 1) : NULL;
+    if (buf && fread(buf, 1, (size_t)len, f) != (size_t)len) {
+        free(buf);
+        buf = NULL;
+    }
+    if (buf) {
+        buf[len] = '\0';
+    }
+    fclose(f);
+    return buf;
+}
+
+static bool load_profile(const char *path, firing_profile_t *out)
+{
+    char *text = read_file(path);
+    if (!text) {
+        fprintf(stderr, "bisque_firesim: cannot read %s\n", path);
+        return false;
+    }
+    cJSON *root = cJSON_Parse(text);
+    free(text);
+    bool ok = root && profile_from_json(root, out);
+    cJSON_Delete(root);
+    if (!ok) {
+        fprintf(stderr, "bisque_firesim: %s is not a profile (need at least an \"id\")\n", path);
+    }
+    return ok;
+}
+
+static void trace_row(const firesim_sample_t *s, void *arg)
+{
+    trace_ctx_t *ctx = arg;
+    firesim_mc_observe(s, &ctx->checker);
+    if (!ctx->f || s->t_s % ctx->every_s != 0) {
+        return;
+    }
+    fprintf(ctx->f, "%u,%s,%u,%.2f,%.2f,%.2f,%.2f,%.3f,%.4f\n", (unsigned)s->t_s, firing_status_to_string(s->status),
+            (unsigned)s->segment, s->setpoint_c, s->tc_c, s->wall_c, s->load_c, s->duty, s->energy_kwh);
+}
+
+static const char *outcome_str(const firesim_result_t *r, bool started)
+{
+    if (!started) {
+        return "rejected";
+    }
+    if (r->timed_out) {
+        return "timeout";
+    }
+    switch (r->final_status) {
+    case FIRING_STATUS_COMPLETE:
+        return "complete";
+    case FIRING_STATUS_ERROR:
+        return "error";
+    default:
+        return "aborted";
+    }
+}
+
+static cJSON *build_kpi_json(const firesim_config_t *cfg, const firesim_result_t *r, firesim_mc_violation_t v,
+                             uint32_t violation_t_s, double cost_per_kwh, double wall_ms)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddStringToObject(root, "profile", cfg->profile.id);
+    cJSON_AddStringToObject(root, "plant", cfg->plant->name);
+    cJSON_AddStringToObject(root, "outcome", outcome_str(r, r->ticks > 0));
+    cJSON_AddStringToObject(root, "status", firing_status_to_string(r->final_status));
+    cJSON_AddNumberToObject(root, "errorCode", r->error_code);
+    cJSON_AddStringToObject(root, "invariant", firesim_mc_violation_name(v));
+    if (v != FIRESIM_MC_OK) {
+        cJSON_AddNumberToObject(root, "invariantAtS", violation_t_s);
+    }
+    cJSON_AddNumberToObject(root, "totalS", r->total_s);
+    cJSON_AddNumberToObject(root, "totalHours", r->total_s / 3600.0);
+    cJSON_AddNumberToObject(root, "peakC", r->peak_c);
+    cJSON_AddNumberToObject(root, "maxOvershootC", r->max_overshoot_c);
+    cJSON_AddNumberToObject(root, "rmsErrorC", r->rms_error_c);
+    cJSON_AddNumberToObject(root, "energyKwh", r->energy_kwh);
+    cJSON_AddNumberToObject(root, "cost", r->energy_kwh * cost_per_kwh);
+    cJSON_AddNumberToObject(root, "simWallMs", wall_ms);
+    cJSON_AddNumberToObject(root, "speedup", wall_ms > 0.0 ? r->total_s * 1000.0 / wall_ms : 0.0);
+
+    cJSON *segs = cJSON_AddArrayToObject(root, "segments");
+    for (int i = 0; i < r->segment_count; i++) {
+        cJSON *s = cJSON_CreateObject();
+        cJSON_AddNumberToObject(s, "index", i);
+        cJSON_AddStringToObject(s, "name", cfg->profile.segments[i].name);
+        cJSON_AddNumberToObject(s, "timeS", r->segments[i].time_s);
+        cJSON_AddNumberToObject(s, "energyKwh", r->segments[i].energy_kwh);
+        cJSON_AddNumberToObject(s, "maxOvershootC", r->segments[i].max_overshoot_c);
+        cJSON_AddItemToArray(segs, s);
+    }
+    return root;
+}
+
+static double monotonic_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option opts[] = {
+        {"profile", required_argument, NULL, 'p'},
+        {"plant", required_argument, NULL, 'k'},
+        {"start-temp", required_argument, NULL, 's'},
+        {"delay", required_argument, NULL, 'd'},
+        {"max-safe", required_argument, NULL, 'm'},
+        {"max-hours", required_argument, NULL, 'H'},
+        {"fault", required_argument, NULL, 'f'},
+        {"pid", required_argument, NULL, 'g'},
+        {"trace", required_argument, NULL, 't'},
+        {"trace-every", required_argument, NULL, 'e'},
+        {"kpi", required_argument, NULL, 'o'},
+        {"cost-kwh", required_argument, NULL, 'c'},
+        {"help", no_argument, NULL, 'h'},
+        {0},
+    };
+
+    firesim_config_t cfg;
+    firesim_config_defaults(&cfg);
+    const char *profile_path = NULL;
+    const char *trace_path = NULL;
+    const char *kpi_path = NULL;
+    uint32_t trace_every = 60;
+    double cost_per_kwh = 0.15;
+    bool have_gains = false;
+    float kp = 0, ki = 0, kd = 0;
+
+    int c;
+    while ((c = getopt_long(argc, argv, "p:k:s:d:m:H:f:g:t:e:o:c:h", opts, NULL)) != -1) {
+        switch (c) {
+        case 'p':
+            profile_path = optarg;
+            break;
+        case 'k':
+            cfg.plant = kiln_model_preset(optarg);
+            if (!cfg.plant) {
+                fprintf(stderr, "bisque_firesim: unknown plant '%s' (small | large)\n", optarg);
+                return 2;
+            }
+            break;
+        case 's':
+            cfg.start_temp_c = strtof(optarg, NULL);
+            break;
+        case 'd':
+            cfg.delay_minutes = (uint32_t)strtoul(optarg, NULL, 10);
+            break;
+        case 'm':
+            cfg.max_safe_temp_c = strtof(optarg, NULL);
+            break;
+        case 'H':
+            cfg.max_s = (uint32_t)(strtod(optarg, NULL) * 3600.0);
+            break;
+        case 'f':
+            if (cfg.fault_count >= FIRESIM_MAX_FAULTS) {
+                fprintf(stderr, "bisque_firesim: at most %d faults\n", FIRESIM_MAX_FAULTS);
+                return 2;
+            }
+            if (!firesim_parse_fault(optarg, &cfg.faults[cfg.fault_count])) {
+                fprintf(stderr, "bisque_firesim: bad fault spec '%s'\n", optarg);
+                return 2;
+            }
+            cfg.fault_count++;
+            break;
+        case 'g':
+            if (sscanf(optarg, "%f,%f,%f", &kp, &ki, &kd) != 3) {
+                fprintf(stderr, "bisque_firesim: --pid wants KP,KI,KD\n");
+                return 2;
+            }
+            have_gains = true;
+            break;
+        case 't':
+            trace_path = optarg;
+            break;
+        case 'e':
+            trace_every = (uint32_t)strtoul(optarg, NULL, 10);
+            break;
+        case 'o':
+            kpi_path = optarg;
+            break;
+        case 'c':
+            cost_per_kwh = strtod(optarg, NULL);
+            break;
+        case 'h':
+            usage(stdout);
+            return 0;
+        default:
+            usage(stderr);
+            return 2;
+        }
+    }
+    if (!profile_path) {
+        usage(stderr);
+        return 2;
+    }
+    if (!load_profile(profile_path, &cfg.profile)) {
+        return 2;
+    }
+    /* firing_engine_init() loads gains from NVS, so they have to be there
+       before the first run. */
+    if (have_gains) {
+        pid_save_gains(kp, ki, kd);
+    }
+
+    trace_ctx_t tctx = {.f = NULL, .every_s = trace_every ? trace_every : 1};
+    firesim_mc_checker_init(&tctx.checker, &cfg);
+    if (trace_path) {
+        tctx.f = strcmp(trace_path, "-") == 0 ? stdout : fopen(trace_path, "w");
+        if (!tctx.f) {
+            fprintf(stderr, "bisque_firesim: cannot write %s\n", trace_path);
+            return 2;
+        }
+        fprintf(tctx.f, "t_s,status,segment,setpoint_c,tc_c,wall_c,load_c,duty,energy_kwh\n");
+    }
+
+    firesim_result_t result;
+    double t0 = monotonic_ms();
+    bool complete = firesim_run(&cfg, trace_row, &tctx, &result);
+    double wall_ms = monotonic_ms() - t0;
+    firesim_mc_violation_t violation = firesim_mc_finish(&tctx.checker, &result);
+
+    if (tctx.f && tctx.f != stdout) {
+        fclose(tctx.f);
+    }
+
+    cJSON *kpi = build_kpi_json(&cfg, &result, violation, tctx.checker.violation_t_s, cost_per_kwh, wall_ms);
+    char *json = cJSON_Print(kpi);
+    cJSON_Delete(kpi);
+    FILE *out = kpi_path ? fopen(kpi_path, "w") : stdout;
+    if (!out || !json) {
+        fprintf(stderr, "bisque_firesim: cannot write %s\n", kpi_path ? kpi_path : "KPIs");
+        free(json);
+        return 2;
+    }
+    fprintf(out, "%s\n", json);
+    free(json);
+    if (out != stdout) {
+        fclose(out);
+    }
+    if (violation != FIRESIM_MC_OK) {
+        return 3;
+    }
+    return complete ? 0 : 1;
+}
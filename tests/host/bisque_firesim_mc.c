@@ -0,0 +1,356 @@
+/**
+ * bisque_firesim_mc — Monte Carlo robustness runs of the firing engine.
+ *
+ *   bisque_firesim_mc --runs 10000 --seed 42 --repro-dir /tmp/mc
+ *
+ * Generates `runs` random scenarios (firesim_mc_generate), fans them out
+ * across worker processes — engine state is process-global, so processes
+ * rather than threads — and checks the firesim_mc invariants every simulated
+ * second. Prints outcome statistics as JSON. For each invariant that broke,
+ * the lowest-numbered failing scenario is shrunk to a minimal reproducer and
+ * reported as a bisque_firesim command line (profile written to
+ * --repro-dir). A worker that dies mid-run is reported with the scenario it
+ * was running.
+ *
+ * Exit status: 0 clean, 1 on any violation or crashed worker, 2 usage/IO.
+ */
+#include "api_json.h"
+#include "cJSON.h"
+#include "firesim_mc.h"
+
+#include <errno.h>
+#include <getopt.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/* One finished scenario, worker → parent. Well under PIPE_BUF, so workers
+ * can share one pipe without interleaving. */
+typedef struct {
+    uint32_t index;
+    uint32_t total_s;
+    uint32_t violation_t_s;
+    float energy_kwh;
+    uint8_t violation;
+    uint8_t status;
+    uint8_t error_code;
+    uint8_t timed_out;
+} mc_record_t;
+
+static void usage(FILE *out)
+{
+    fprintf(out, "usage: bisque_firesim_mc [options]\n"
+                 "\n"
+                 "  -n, --runs N          scenarios to run (default 1000)\n"
+                 "  -j, --jobs N          worker processes (default: online CPUs)\n"
+                 "  -s, --seed N          run seed (default 1)\n"
+                 "  -r, --repro-dir DIR   write reproducer profiles here (default: current dir)\n"
+                 "  -o, --out FILE        write the summary JSON here (default stdout)\n"
+                 "  -h, --help\n");
+}
+
+static double monotonic_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+/* ── Workers ─────────────────────────────────────────────────────────── */
+
+static bool write_all(int fd, const void *buf, size_t len)
+{
+    const char *p = buf;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static void worker(int fd, uint64_t seed, uint32_t first, uint32_t stride, uint32_t runs)
+{
+    for (uint32_t i = first; i < runs; i += stride) {
+        firesim_config_t cfg;
+        firesim_mc_generate(seed, i, &cfg);
+        firesim_result_t r;
+        mc_record_t rec = {.index = i};
+        rec.violation = (uint8_t)firesim_mc_run(&cfg, &r, &rec.violation_t_s);
+        rec.total_s = r.total_s;
+        rec.energy_kwh = (float)r.energy_kwh;
+        rec.status = (uint8_t)r.final_status;
+        rec.error_code = (uint8_t)r.error_code;
+        rec.timed_out = r.timed_out;
+        if (!write_all(fd, &rec, sizeof(rec))) {
+            _exit(2);
+        }
+    }
+    _exit(0);
+}
+
+/* ── Reproducers ─────────────────────────────────────────────────────── */
+
+static bool fails_same_way(const firesim_config_t *cfg, void *ctx)
+{
+    return firesim_mc_run(cfg, NULL, NULL) == *(firesim_mc_violation_t *)ctx;
+}
+
+static bool write_profile(const char *path, const firing_profile_t *p)
+{
+    cJSON *root = build_profile_json(p);
+    char *json = cJSON_Print(root);
+    cJSON_Delete(root);
+    FILE *f = json ? fopen(path, "w") : NULL;
+    if (f) {
+        fprintf(f, "%s\n", json);
+        fclose(f);
+    }
+    free(json);
+    return f != NULL;
+}
+
+/* Shrink scenario `index` and describe it as a bisque_firesim invocation. */
+static cJSON *build_reproducer(uint64_t seed, uint32_t index, firesim_mc_violation_t v, const char *dir)
+{
+    firesim_config_t cfg;
+    firesim_mc_generate(seed, index, &cfg);
+    int tries = firesim_mc_shrink(&cfg, fails_same_way, &v);
+    uint32_t at_s = 0;
+    firesim_mc_run(&cfg, NULL, &at_s);
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s.json", dir, cfg.profile.id);
+    if (!write_profile(path, &cfg.profile)) {
+        fprintf(stderr, "bisque_firesim_mc: cannot write %s\n", path);
+    }
+
+    char cmd[1024];
+    int n = snprintf(cmd, sizeof(cmd), "bisque_firesim --profile %s --plant %s --start-temp %g --max-safe %g", path,
+                     cfg.plant->name, cfg.start_temp_c, cfg.max_safe_temp_c);
+    if (cfg.delay_minutes) {
+        n += snprintf(cmd + n, sizeof(cmd) - (size_t)n, " --delay %u", (unsigned)cfg.delay_minutes);
+    }
+    n += snprintf(cmd + n, sizeof(cmd) - (size_t)n, " --max-hours %g", cfg.max_s / 3600.0);
+    for (int i = 0; i < cfg.fault_count && (size_t)n < sizeof(cmd); i++) {
+        char spec[64];
+        firesim_format_fault(&cfg.faults[i], spec, sizeof(spec));
+        n += snprintf(cmd + n, sizeof(cmd) - (size_t)n, " --fault %s", spec);
+    }
+
+    cJSON *item = cJSON_CreateObject();
+    cJSON_AddStringToObject(item, "violation", firesim_mc_violation_name(v));
+    cJSON_AddNumberToObject(item, "scenario", index);
+    cJSON_AddNumberToObject(item, "atS", at_s);
+    cJSON_AddNumberToObject(item, "segments", cfg.profile.segment_count);
+    cJSON_AddNumberToObject(item, "faults", cfg.fault_count);
+    cJSON_AddNumberToObject(item, "shrinkRuns", tries);
+    cJSON_AddStringToObject(item, "command", cmd);
+    return item;
+}
+
+/* ── Main ────────────────────────────────────────────────────────────── */
+
+static const char *const s_error_keys[] = {
+    [FIRING_ERR_NONE] = "none",
+    [FIRING_ERR_TC_FAULT] = "tcFault",
+    [FIRING_ERR_OVER_TEMP] = "overTemp",
+    [FIRING_ERR_NOT_RISING] = "notRising",
+    [FIRING_ERR_RUNAWAY] = "runaway",
+    [FIRING_ERR_EMERGENCY_STOP] = "emergencyStop",
+    [FIRING_ERR_INVALID_PROFILE] = "invalidProfile",
+};
+#define ERROR_KEY_COUNT (sizeof(s_error_keys) / sizeof(s_error_keys[0]))
+
+int main(int argc, char **argv)
+{
+    static const struct option opts[] = {
+        {"runs", required_argument, NULL, 'n'},
+        {"jobs", required_argument, NULL, 'j'},
+        {"seed", required_argument, NULL, 's'},
+        {"repro-dir", required_argument, NULL, 'r'},
+        {"out", required_argument, NULL, 'o'},
+        {"help", no_argument, NULL, 'h'},
+        {0},
+    };
+
+    uint32_t runs = 1000;
+    long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    uint64_t seed = 1;
+    const char *repro_dir = ".";
+    const char *out_path = NULL;
+
+    int c;
+    while ((c = getopt_long(argc, argv, "n:j:s:r:o:h", opts, NULL)) != -1) {
+        switch (c) {
+        case 'n':
+            runs = (uint32_t)strtoul(optarg, NULL, 10);
+            break;
+        case 'j':
+            jobs = strtol(optarg, NULL, 10);
+            break;
+        case 's':
+            seed = strtoull(optarg, NULL, 0);
+            break;
+        case 'r':
+            repro_dir = optarg;
+            break;
+        case 'o':
+            out_path = optarg;
+            break;
+        case 'h':
+            usage(stdout);
+            return 0;
+        default:
+            usage(stderr);
+            return 2;
+        }
+    }
+    if (jobs < 1) {
+        jobs = 1;
+    }
+    if (runs > 0 && (uint32_t)jobs > runs) {
+        jobs = (long)runs;
+    }
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        perror("bisque_firesim_mc: pipe");
+        return 2;
+    }
+    double t0 = monotonic_ms();
+    pid_t *pids = calloc((size_t)jobs, sizeof(pid_t));
+    for (long w = 0; w < jobs; w++) {
+        pids[w] = fork();
+        if (pids[w] < 0) {
+            perror("bisque_firesim_mc: fork");
+            return 2;
+        }
+        if (pids[w] == 0) {
+            close(fds[0]);
+            worker(fds[1], seed, (uint32_t)w, (uint32_t)jobs, runs);
+        }
+    }
+    close(fds[1]);
+
+    uint8_t *done = calloc(runs ? runs : 1, 1);
+    uint32_t completed = 0, finished = 0, timeouts = 0, rejected = 0, aborted = 0;
+    uint32_t errors[ERROR_KEY_COUNT] = {0};
+    uint32_t violations[FIRESIM_MC_VIOLATION_COUNT] = {0};
+    uint32_t first_bad[FIRESIM_MC_VIOLATION_COUNT];
+    for (int v = 0; v < FIRESIM_MC_VIOLATION_COUNT; v++) {
+        first_bad[v] = UINT32_MAX;
+    }
+    double sim_s = 0.0, energy_kwh = 0.0;
+
+    mc_record_t rec;
+    ssize_t got;
+    while ((got = read(fds[0], &rec, sizeof(rec))) == (ssize_t)sizeof(rec) || (got < 0 && errno == EINTR)) {
+        if (got < 0 || rec.index >= runs) {
+            continue;
+        }
+        done[rec.index] = 1;
+        finished++;
+        sim_s += rec.total_s;
+        energy_kwh += rec.energy_kwh;
+        if (rec.timed_out) {
+            timeouts++;
+        } else if (rec.total_s == 0) {
+            rejected++;
+        } else if (rec.status == FIRING_STATUS_COMPLETE) {
+            completed++;
+        } else if (rec.status == FIRING_STATUS_ERROR) {
+            errors[rec.error_code < ERROR_KEY_COUNT ? rec.error_code : 0]++;
+        } else {
+            aborted++;
+        }
+        if (rec.violation != FIRESIM_MC_OK && rec.violation < FIRESIM_MC_VIOLATION_COUNT) {
+            violations[rec.violation]++;
+            if (rec.index < first_bad[rec.violation]) {
+                first_bad[rec.violation] = rec.index;
+            }
+        }
+    }
+    close(fds[0]);
+
+    /* A worker that died left a gap at the scenario it was running: the
+       lowest unfinished index in its stride. */
+    cJSON *crashes = cJSON_CreateArray();
+    for (long w = 0; w < jobs; w++) {
+        int st = 0;
+        waitpid(pids[w], &st, 0);
+        if (WIFEXITED(st) && WEXITSTATUS(st) == 0) {
+            continue;
+        }
+        for (uint32_t i = (uint32_t)w; i < runs; i += (uint32_t)jobs) {
+            if (!done[i]) {
+                cJSON *item = cJSON_CreateObject();
+                cJSON_AddNumberToObject(item, "scenario", i);
+                cJSON_AddStringToObject(item, "exit", WIFSIGNALED(st) ? strsignal(WTERMSIG(st)) : "nonzero exit");
+                cJSON_AddItemToArray(crashes, item);
+                break;
+            }
+        }
+    }
+    double wall_ms = monotonic_ms() - t0;
+    free(pids);
+    free(done);
+
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "seed", (double)seed);
+    cJSON_AddNumberToObject(root, "runs", runs);
+    cJSON_AddNumberToObject(root, "finished", finished);
+    cJSON_AddNumberToObject(root, "jobs", (double)jobs);
+    cJSON_AddNumberToObject(root, "wallMs", wall_ms);
+    cJSON_AddNumberToObject(root, "simHours", sim_s / 3600.0);
+    cJSON_AddNumberToObject(root, "speedup", wall_ms > 0.0 ? sim_s * 1000.0 / wall_ms : 0.0);
+    cJSON_AddNumberToObject(root, "energyKwh", energy_kwh);
+
+    cJSON *outcomes = cJSON_AddObjectToObject(root, "outcomes");
+    cJSON_AddNumberToObject(outcomes, "complete", completed);
+    cJSON_AddNumberToObject(outcomes, "aborted", aborted);
+    cJSON_AddNumberToObject(outcomes, "rejected", rejected);
+    cJSON_AddNumberToObject(outcomes, "timeout", timeouts);
+    cJSON *errs = cJSON_AddObjectToObject(outcomes, "error");
+    for (size_t e = 1; e < ERROR_KEY_COUNT; e++) {
+        cJSON_AddNumberToObject(errs, s_error_keys[e], errors[e]);
+    }
+
+    bool dirty = cJSON_GetArraySize(crashes) > 0;
+    cJSON *viol = cJSON_AddObjectToObject(root, "violations");
+    cJSON *repros = cJSON_CreateArray();
+    for (int v = 1; v < FIRESIM_MC_VIOLATION_COUNT; v++) {
+        cJSON_AddNumberToObject(viol, firesim_mc_violation_name((firesim_mc_violation_t)v), violations[v]);
+        if (violations[v] > 0) {
+            dirty = true;
+            cJSON_AddItemToArray(repros, build_reproducer(seed, first_bad[v], (firesim_mc_violation_t)v, repro_dir));
+        }
+    }
+    cJSON_AddItemToObject(root, "reproducers", repros);
+    cJSON_AddItemToObject(root, "crashes", crashes);
+
+    char *json = cJSON_Print(root);
+    cJSON_Delete(root);
+    FILE *out = out_path ? fopen(out_path, "w") : stdout;
+    if (!out || !json) {
+        fprintf(stderr, "bisque_firesim_mc: cannot write %s\n", out_path ? out_path : "summary");
+        free(json);
+        return 2;
+    }
+    fprintf(out, "%s\n", json);
+    free(json);
+    if (out != stdout) {
+        fclose(out);
+    }
+    return dirty ? 1 : 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * bisque_replay — replay a firing record downloaded from a kiln
+ * (GET /api/v1/diagnostics/firing-record, firmware built with
+ * CONFIG_FIRING_RECORD) through the real firing engine and PID.
+ *
+ *   bisque_replay firing.rec > replay.csv
+ *
+ * Writes one CSV row per recorded tick — time since the recording began,
+ * status, segment, setpoint, measured temperature and the SSR duty the engine
+ * commanded — and a one-line summary on stderr. Set a breakpoint in
+ * firing_tick() to step through the firing as the kiln saw it.
+ *
+ * Exit status: 0 on a complete recording, 1 when it was cut short (power
+ * loss, size limit), 2 on a usage or I/O error.
+ */
+#include "api_json.h"
+#include "firing_engine.h"
+#include "firing_replay.h"
+
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    FILE *out;
+    int64_t base_us;
+    bool have_base;
+} replay_csv_t;
+
+static void csv_row(const firing_replay_tick_t *t, void *arg)
+{
+    replay_csv_t *csv = arg;
+    if (!csv->have_base) {
+        csv->base_us = t->time_us;
+        csv->have_base = true;
+    }
+    fprintf(csv->out, "%.3f,%s,%u,%.2f,%.2f,%.3f\n", (double)(t->time_us - csv->base_us) / 1e6,
+            firing_status_to_string(t->progress.status), (unsigned)t->progress.current_segment,
+            t->progress.target_temp, t->progress.current_temp, t->duty);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2 || strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--help") == 0) {
+        fprintf(argc == 2 ? stdout : stderr, "usage: bisque_replay FIRING_RECORD > trace.csv\n");
+        return argc == 2 ? 0 : 2;
+    }
+    FILE *f = fopen(argv[1], "rb");
+    if (!f) {
+        fprintf(stderr, "bisque_replay: cannot read %s\n", argv[1]);
+        return 2;
+    }
+
+    firing_engine_init();
+    replay_csv_t csv = {.out = stdout};
+    fprintf(csv.out, "t_s,status,segment,setpoint_c,tc_c,duty\n");
+    firing_replay_result_t res;
+    bool ok = firing_replay_run(f, csv_row, &csv, &res);
+    fclose(f);
+    if (!ok) {
+        fprintf(stderr, "bisque_replay: %s is not a firing record\n", argv[1]);
+        return 2;
+    }
+
+    fprintf(stderr, "%u ticks, %u commands, %u readings; ended %s (error code %d)%s\n", (unsigned)res.ticks,
+            (unsigned)res.commands, (unsigned)res.readings, firing_status_to_string(res.final_status),
+            (int)res.error_code, res.truncated ? "; recording truncated" : "");
+    return res.truncated ? 1 : 0;
+}
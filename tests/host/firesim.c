@@ -0,0 +1,338 @@
+#include "firesim.h"
+
+#include "app_config.h"
+#include "esp_timer.h"
+#include "firing_engine.h"
+#include "firing_engine_internal.h"
+#include "safety_host.h"
+#include "scenario_helpers.h"
+#include "thermocouple_host.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEMP_FAULT_TIMEOUT_US ((int64_t)APP_TEMP_FAULT_TIMEOUT_MS * 1000LL)
+
+/* firing_engine_init() creates the queues/mutexes and is one-shot per
+ * process; every later run resets state through scenario_setup instead. */
+static bool s_engine_ready;
+
+void firesim_config_defaults(firesim_config_t *cfg)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->plant = &KILN_MODEL_SMALL_TEST;
+    cfg->start_temp_c = 25.0f;
+    cfg->max_safe_temp_c = APP_DEFAULT_MAX_SAFE_TEMP;
+    cfg->max_s = 72u * 3600u;
+}
+
+/* ── Fault spec parsing ──────────────────────────────────────────────── */
+
+static const struct {
+    const char *name;
+    firesim_fault_kind_t kind;
+} s_fault_names[] = {
+    {"tc-open", FIRESIM_FAULT_TC_OPEN}, {"tc-spike", FIRESIM_FAULT_TC_SPIKE}, {"elements", FIRESIM_FAULT_ELEMENTS},
+    {"pause", FIRESIM_FAULT_PAUSE},     {"skip", FIRESIM_FAULT_SKIP},         {"stop", FIRESIM_FAULT_STOP},
+};
+
+/* "90", "90s", "15m", "2.5h" → seconds. Advances *p past what it consumed. */
+static bool parse_time_s(const char **p, uint32_t *out)
+{
+    char *end;
+    double v = strtod(*p, &end);
+    if (end == *p || !(v >= 0.0)) {
+        return false;
+    }
+    if (*end == 'h') {
+        v *= 3600.0;
+        end++;
+    } else if (*end == 'm') {
+        v *= 60.0;
+        end++;
+    } else if (*end == 's') {
+        end++;
+    }
+    if (v > (double)UINT32_MAX) {
+        return false;
+    }
+    *out = (uint32_t)lround(v);
+    *p = end;
+    return true;
+}
+
+bool firesim_parse_fault(const char *spec, firesim_fault_t *out)
+{
+    if (!spec || !out) {
+        return false;
+    }
+    const char *at = strchr(spec, '@');
+    if (!at) {
+        return false;
+    }
+    memset(out, 0, sizeof(*out));
+    size_t name_len = (size_t)(at - spec);
+    bool known = false;
+    for (size_t i = 0; i < sizeof(s_fault_names) / sizeof(s_fault_names[0]); i++) {
+        if (strlen(s_fault_names[i].name) == name_len && strncmp(spec, s_fault_names[i].name, name_len) == 0) {
+            out->kind = s_fault_names[i].kind;
+            known = true;
+            break;
+        }
+    }
+    if (!known) {
+        return false;
+    }
+
+    const char *p = at + 1;
+    if (!parse_time_s(&p, &out->at_s)) {
+        return false;
+    }
+    bool has_value = false;
+    if (*p == '+') {
+        p++;
+        if (!parse_time_s(&p, &out->duration_s)) {
+            return false;
+        }
+    }
+    if (*p == '=') {
+        char *end;
+        out->value = strtof(p + 1, &end);
+        if (end == p + 1 || !isfinite(out->value)) {
+            return false;
+        }
+        has_value = true;
+        p = end;
+    }
+    if (*p != '\0') {
+        return false;
+    }
+
+    switch (out->kind) {
+    case FIRESIM_FAULT_TC_SPIKE:
+        return has_value;
+    case FIRESIM_FAULT_ELEMENTS:
+        return has_value && out->value >= 0.0f && out->value <= 1.0f;
+    case FIRESIM_FAULT_PAUSE:
+        return out->duration_s > 0;
+    default:
+        return true;
+    }
+}
+
+int firesim_format_fault(const firesim_fault_t *f, char *buf, size_t len)
+{
+    const char *name = "?";
+    for (size_t i = 0; i < sizeof(s_fault_names) / sizeof(s_fault_names[0]); i++) {
+        if (s_fault_names[i].kind == f->kind) {
+            name = s_fault_names[i].name;
+            break;
+        }
+    }
+    switch (f->kind) {
+    case FIRESIM_FAULT_ELEMENTS:
+        return snprintf(buf, len, "%s@%u=%.9g", name, (unsigned)f->at_s, (double)f->value);
+    case FIRESIM_FAULT_TC_SPIKE:
+        return snprintf(buf, len, "%s@%u+%u=%.9g", name, (unsigned)f->at_s, (unsigned)f->duration_s,
+                        (double)f->value);
+    case FIRESIM_FAULT_TC_OPEN:
+    case FIRESIM_FAULT_PAUSE:
+        return snprintf(buf, len, "%s@%u+%u", name, (unsigned)f->at_s, (unsigned)f->duration_s);
+    default:
+        return snprintf(buf, len, "%s@%u", name, (unsigned)f->at_s);
+    }
+}
+
+/* ── Run ─────────────────────────────────────────────────────────────── */
+
+/* Is fault `f` (a windowed kind) in effect at simulated second t? */
+static bool fault_window_active(const firesim_fault_t *f, uint32_t t)
+{
+    uint32_t dur = f->duration_s ? f->duration_s : 1;
+    return t >= f->at_s && t - f->at_s < dur;
+}
+
+/* Operator commands land between ticks, exactly as the cmd queue delivers
+ * them on the device. */
+static void dispatch_commands(const firesim_config_t *cfg, uint32_t t)
+{
+    for (int i = 0; i < cfg->fault_count; i++) {
+        const firesim_fault_t *f = &cfg->faults[i];
+        switch (f->kind) {
+        case FIRESIM_FAULT_PAUSE:
+            if (t == f->at_s) {
+                scenario_pause();
+            } else if (t == f->at_s + f->duration_s) {
+                scenario_resume();
+            }
+            break;
+        case FIRESIM_FAULT_SKIP:
+            if (t == f->at_s) {
+                scenario_skip();
+            }
+            break;
+        case FIRESIM_FAULT_STOP:
+            if (t == f->at_s) {
+                scenario_stop();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/* The host safety stub has no safety_task; mirror its TC-fault timeout and
+ * over-temperature trips here so injected faults end the firing the way they
+ * would on the device. Evaluated once per tick rather than at 2 Hz, which is
+ * well inside the 5 s fault window. */
+static void safety_task_step(const thermocouple_reading_t *r, int64_t now_us, int64_t *last_valid_us)
+{
+    if (r->fault != 0) {
+        if (now_us - *last_valid_us > TEMP_FAULT_TIMEOUT_US) {
+            safety_emergency_stop_cause(SAFETY_TRIP_TC_FAULT);
+        }
+        return;
+    }
+    *last_valid_us = now_us;
+    kiln_settings_t st;
+    firing_engine_get_settings(&st);
+    float corrected = r->temperature_c + st.tc_offset_c;
+    if (corrected > safety_get_max_temp() || r->temperature_c > APP_HARDWARE_MAX_TEMP_C) {
+        safety_emergency_stop_cause(SAFETY_TRIP_OVER_TEMP);
+    }
+}
+
+static bool is_firing_status(firing_status_t s)
+{
+    return s == FIRING_STATUS_HEATING || s == FIRING_STATUS_HOLDING || s == FIRING_STATUS_COOLING;
+}
+
+bool firesim_run(const firesim_config_t *cfg, firesim_trace_fn trace, void *ctx, firesim_result_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    if (!s_engine_ready) {
+        firing_engine_init();
+        s_engine_ready = true;
+    }
+
+    kiln_model_t kiln;
+    scenario_setup_thermal(&kiln, cfg->plant, cfg->start_temp_c);
+    safety_set_max_temp(cfg->max_safe_temp_c);
+    out->segment_count = cfg->profile.segment_count;
+    out->peak_c = cfg->start_temp_c;
+
+    scenario_start(&cfg->profile, cfg->delay_minutes);
+    firing_progress_t prog;
+    firing_engine_get_progress(&prog);
+    if (!prog.is_active) {
+        /* START refused (malformed profile, wrong-sign ramp, ...). */
+        out->final_status = prog.status;
+        out->error_code = firing_engine_get_error_code();
+        return false;
+    }
+
+    int64_t last_valid_us = esp_timer_get_time();
+    uint8_t seen_fault = 0; /* fault flag on the reading this tick consumes */
+    double sq_err_sum = 0.0;
+    uint32_t firing_ticks = 0;
+    bool ended = false;
+
+    for (uint32_t t = 0; t < cfg->max_s; t++) {
+        dispatch_commands(cfg, t);
+        for (int i = 0; i < cfg->fault_count; i++) {
+            if (cfg->faults[i].kind == FIRESIM_FAULT_ELEMENTS && t == cfg->faults[i].at_s) {
+                kiln.element_health = cfg->faults[i].value;
+            }
+        }
+
+        host_clock_advance(HARNESS_TICK_US);
+        int64_t now_us = esp_timer_get_time();
+        firing_tick(now_us);
+        firing_engine_get_progress(&prog);
+
+        float duty = safety_test_last_duty();
+        double e_before = kiln.energy_j;
+        kiln_model_step(&kiln, duty, (float)HARNESS_TICK_US / 1000000.0f);
+        double tick_kwh = (kiln.energy_j - e_before) / 3.6e6;
+
+        /* Next reading, with any sensor faults in effect at t+1. A faulted
+           MAX31855 reports 0 °C (see thermocouple_read). */
+        float reading = kiln_model_tc_reading(&kiln);
+        uint8_t tc_fault = 0;
+        for (int i = 0; i < cfg->fault_count; i++) {
+            const firesim_fault_t *f = &cfg->faults[i];
+            if (f->kind == FIRESIM_FAULT_TC_SPIKE && fault_window_active(f, t + 1)) {
+                reading += f->value;
+            } else if (f->kind == FIRESIM_FAULT_TC_OPEN && fault_window_active(f, t + 1)) {
+                tc_fault = TC_FAULT_OPEN_CIRCUIT;
+            }
+        }
+        thermocouple_test_set(tc_fault ? 0.0f : reading, tc_fault);
+        thermocouple_reading_t r;
+        thermocouple_get_latest(&r);
+        safety_task_step(&r, now_us, &last_valid_us);
+
+        /* KPIs, attributed to the segment the engine reported for this tick. */
+        out->ticks++;
+        out->total_s = t + 1;
+        out->energy_kwh += tick_kwh;
+        int seg = prog.current_segment < FIRING_MAX_SEGMENTS ? prog.current_segment : FIRING_MAX_SEGMENTS - 1;
+        if (prog.is_active && prog.current_temp > out->peak_c) {
+            out->peak_c = prog.current_temp;
+        }
+        if (is_firing_status(prog.status) || prog.status == FIRING_STATUS_PAUSED) {
+            out->segments[seg].time_s++;
+            out->segments[seg].energy_kwh += tick_kwh;
+        }
+        if (prog.is_active && is_firing_status(prog.status)) {
+            float err = prog.current_temp - prog.target_temp;
+            sq_err_sum += (double)err * (double)err;
+            firing_ticks++;
+            /* Overshoot is past the setpoint in the direction of travel; a
+               cooling segment lagging above its setpoint is not overshoot. */
+            float over = cfg->profile.segments[seg].ramp_rate < 0.0f ? -err : err;
+            if (over > out->max_overshoot_c) {
+                out->max_overshoot_c = over;
+            }
+            if (over > out->segments[seg].max_overshoot_c) {
+                out->segments[seg].max_overshoot_c = over;
+            }
+        }
+
+        if (trace) {
+            firesim_sample_t s = {
+                .t_s = t + 1,
+                .status = prog.status,
+                .segment = prog.current_segment,
+                .setpoint_c = prog.target_temp,
+                .tc_c = prog.current_temp,
+                .tc_fault = seen_fault != 0,
+                .wall_c = kiln.wall_c,
+                .load_c = kiln.load_c,
+                .duty = duty,
+                .energy_kwh = kiln.energy_j / 3.6e6,
+            };
+            trace(&s, ctx);
+        }
+
+        seen_fault = tc_fault;
+        if (!prog.is_active) {
+            ended = true;
+            break;
+        }
+    }
+
+    out->rms_error_c = firing_ticks ? (float)sqrt(sq_err_sum / (double)firing_ticks) : 0.0f;
+    out->final_status = prog.status;
+    out->error_code = firing_engine_get_error_code();
+    if (!ended) {
+        /* Report where the firing was when the cap hit, then stop it so the
+           next run starts from a clean engine. */
+        out->timed_out = true;
+        scenario_stop();
+    }
+    return !out->timed_out && prog.status == FIRING_STATUS_COMPLETE;
+}
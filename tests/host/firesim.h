@@ -0,0 +1,99 @@
+#pragma once
+
+#include "firing_types.h"
+#include "kiln_model.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Accelerated whole-firing simulation: the real firing_engine.c + PID driving
+ * a kiln_model through the host stubs, one firing_tick per simulated second,
+ * with optional fault injection and KPI collection.
+ *
+ * This is the engine behind the bisque_firesim CLI and the scenario runners.
+ * Firing-engine state is process-global, so firesim_run() is not re-entrant:
+ * run simulations sequentially, or in separate processes. */
+
+#define FIRESIM_MAX_FAULTS 16
+
+typedef enum {
+    FIRESIM_FAULT_TC_OPEN,  /* TC reports an open-circuit fault for duration_s */
+    FIRESIM_FAULT_TC_SPIKE, /* TC reading offset by `value` °C for duration_s */
+    FIRESIM_FAULT_ELEMENTS, /* element health set to `value` (0..1) from at_s on */
+    FIRESIM_FAULT_PAUSE,    /* operator PAUSE at at_s, RESUME after duration_s */
+    FIRESIM_FAULT_SKIP,     /* operator SKIP_SEGMENT at at_s */
+    FIRESIM_FAULT_STOP,     /* operator STOP at at_s */
+} firesim_fault_kind_t;
+
+typedef struct {
+    firesim_fault_kind_t kind;
+    uint32_t at_s;       /* simulated seconds after START */
+    uint32_t duration_s; /* TC_OPEN / TC_SPIKE / PAUSE; 0 means one tick */
+    float value;         /* TC_SPIKE offset, ELEMENTS health */
+} firesim_fault_t;
+
+typedef struct {
+    const kiln_model_params_t *plant;
+    firing_profile_t profile;
+    float start_temp_c;
+    float max_safe_temp_c;
+    uint32_t delay_minutes;
+    uint32_t max_s; /* hard cap on simulated time; the run reports a timeout */
+    firesim_fault_t faults[FIRESIM_MAX_FAULTS];
+    int fault_count;
+} firesim_config_t;
+
+/* Defaults: small test kiln, 25 °C start, 1300 °C limit, no delay, 72 h cap,
+ * no faults. The profile is left zeroed. */
+void firesim_config_defaults(firesim_config_t *cfg);
+
+/* Parse one "kind@time[+duration][=value]" fault spec, e.g. "tc-open@3h+30s",
+ * "elements@0=0.8", "pause@2h+30m", "tc-spike@5000=40", "skip@90m". Times
+ * take an optional s/m/h suffix (default seconds). Returns false on a
+ * malformed spec. */
+bool firesim_parse_fault(const char *spec, firesim_fault_t *out);
+
+/* Inverse of firesim_parse_fault: write `f` as a spec string (plain seconds).
+ * Returns what snprintf returns. */
+int firesim_format_fault(const firesim_fault_t *f, char *buf, size_t len);
+
+/* One trace row, emitted once per simulated second. */
+typedef struct {
+    uint32_t t_s;
+    firing_status_t status;
+    uint8_t segment;
+    float setpoint_c;
+    float tc_c;    /* what the engine saw (offset/fault applied) */
+    bool tc_fault; /* ...and whether that reading was faulted */
+    float wall_c;
+    float load_c;
+    float duty;
+    double energy_kwh;
+} firesim_sample_t;
+
+typedef void (*firesim_trace_fn)(const firesim_sample_t *sample, void *ctx);
+
+typedef struct {
+    uint32_t time_s; /* simulated seconds spent in the segment (pauses included) */
+    double energy_kwh;
+    float max_overshoot_c;
+} firesim_segment_kpi_t;
+
+typedef struct {
+    firing_status_t final_status;
+    firing_error_code_t error_code;
+    bool timed_out;   /* hit max_s before the firing ended */
+    uint32_t total_s; /* START → end of firing (or the cap) */
+    uint32_t ticks;
+    float peak_c;
+    float max_overshoot_c; /* max overshoot past the setpoint, in the segment's direction */
+    float rms_error_c;     /* RMS (measured − setpoint) while firing */
+    double energy_kwh;
+    uint8_t segment_count;
+    firesim_segment_kpi_t segments[FIRING_MAX_SEGMENTS];
+} firesim_result_t;
+
+/* Run one firing from START to COMPLETE/ERROR/STOP (or the cap). `trace` may
+ * be NULL. Returns true when the firing reached COMPLETE. */
+bool firesim_run(const firesim_config_t *cfg, firesim_trace_fn trace, void *ctx, firesim_result_t *out);
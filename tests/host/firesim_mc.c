@@ -0,0 +1,343 @@
+#include "firesim_mc.h"
+
+#include "app_config.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Seconds of TC fault the safety path may take beyond its own timeout before
+ * a still-running firing counts as a missed trip (tick granularity + the
+ * engine reacting on the following tick). */
+#define TC_TRIP_SLACK_S   3
+#define OVER_TEMP_TICKS   3
+#define SETPOINT_MARGIN_C 1.0f
+
+static const char *const s_violation_names[FIRESIM_MC_VIOLATION_COUNT] = {
+    [FIRESIM_MC_OK] = "ok",
+    [FIRESIM_MC_SSR_WHILE_NOT_FIRING] = "ssr-while-not-firing",
+    [FIRESIM_MC_MISSED_TC_TRIP] = "missed-tc-trip",
+    [FIRESIM_MC_MISSED_OVERTEMP_TRIP] = "missed-overtemp-trip",
+    [FIRESIM_MC_SETPOINT_OUT_OF_RANGE] = "setpoint-out-of-range",
+    [FIRESIM_MC_SEGMENT_REGRESSED] = "segment-regressed",
+    [FIRESIM_MC_STALLED] = "stalled",
+};
+
+const char *firesim_mc_violation_name(firesim_mc_violation_t v)
+{
+    return (unsigned)v < FIRESIM_MC_VIOLATION_COUNT ? s_violation_names[v] : "?";
+}
+
+/* ── Generation ──────────────────────────────────────────────────────── */
+
+/* splitmix64: tiny, seedable from any 64-bit value, good enough here. */
+static uint64_t rng_next(uint64_t *s)
+{
+    uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static float rng_uniform(uint64_t *s, float lo, float hi)
+{
+    return lo + (hi - lo) * (float)((rng_next(s) >> 40) / (double)(1ULL << 24));
+}
+
+static uint32_t rng_below(uint64_t *s, uint32_t n)
+{
+    return n ? (uint32_t)(rng_next(s) % n) : 0;
+}
+
+static bool rng_chance(uint64_t *s, float p)
+{
+    return rng_uniform(s, 0.0f, 1.0f) < p;
+}
+
+/* Planned seconds for the profile from `start_c`, at the programmed rates. */
+static uint32_t planned_s(const firing_profile_t *p, float start_c)
+{
+    double s = 0.0;
+    float from = start_c;
+    for (int i = 0; i < p->segment_count; i++) {
+        const firing_segment_t *seg = &p->segments[i];
+        if (seg->ramp_rate != 0.0f) {
+            s += fabs(seg->target_temp - from) / fabs(seg->ramp_rate) * 3600.0;
+        }
+        s += seg->hold_time * 60.0;
+        from = seg->target_temp;
+    }
+    return (uint32_t)s;
+}
+
+static void recompute_max_temp(firing_profile_t *p)
+{
+    p->max_temp = 0.0f;
+    for (int i = 0; i < p->segment_count; i++) {
+        if (p->segments[i].target_temp > p->max_temp) {
+            p->max_temp = p->segments[i].target_temp;
+        }
+    }
+}
+
+static void generate_profile(uint64_t *rng, uint32_t index, float start_c, firing_profile_t *p)
+{
+    memset(p, 0, sizeof(*p));
+    snprintf(p->id, sizeof(p->id), "mc-%u", (unsigned)index);
+    snprintf(p->name, sizeof(p->name), "Monte Carlo %u", (unsigned)index);
+
+    float peak = rng_uniform(rng, fmaxf(start_c + 80.0f, 300.0f), 1240.0f);
+    int heat = 1 + (int)rng_below(rng, 5);
+    int cool = rng_chance(rng, 0.4f) ? 1 + (int)rng_below(rng, 2) : 0;
+
+    float from = start_c;
+    for (int i = 0; i < heat; i++) {
+        firing_segment_t *seg = &p->segments[p->segment_count++];
+        snprintf(seg->id, sizeof(seg->id), "h%d", i);
+        snprintf(seg->name, sizeof(seg->name), "Heat %d", i + 1);
+        /* Evenly spread steps with some jitter; the last one lands on peak. */
+        float frac = (float)(i + 1) / (float)heat;
+        float target = i == heat - 1 ? peak : from + (peak - from) * rng_uniform(rng, 0.5f, 1.0f) * frac;
+        seg->target_temp = roundf(fmaxf(target, from + 10.0f));
+        seg->ramp_rate = roundf(rng_uniform(rng, 30.0f, 400.0f));
+        seg->hold_time = rng_chance(rng, 0.5f) ? (uint16_t)rng_below(rng, 31) : 0;
+        from = seg->target_temp;
+    }
+    for (int i = 0; i < cool; i++) {
+        firing_segment_t *seg = &p->segments[p->segment_count++];
+        snprintf(seg->id, sizeof(seg->id), "c%d", i);
+        snprintf(seg->name, sizeof(seg->name), "Cool %d", i + 1);
+        seg->target_temp = roundf(fmaxf(from - rng_uniform(rng, 50.0f, 300.0f), 100.0f));
+        seg->ramp_rate = -roundf(rng_uniform(rng, 30.0f, 200.0f));
+        seg->hold_time = rng_chance(rng, 0.5f) ? (uint16_t)rng_below(rng, 31) : 0;
+        if (seg->target_temp >= from) {
+            p->segment_count--;
+            break;
+        }
+        from = seg->target_temp;
+    }
+    recompute_max_temp(p);
+    p->estimated_duration = planned_s(p, start_c) / 60;
+}
+
+void firesim_mc_generate(uint64_t seed, uint32_t index, firesim_config_t *cfg)
+{
+    uint64_t rng = seed ^ ((uint64_t)index * 0xD1B54A32D192ED03ULL);
+    rng_next(&rng);
+
+    firesim_config_defaults(cfg);
+    cfg->plant = rng_chance(&rng, 0.3f) ? &KILN_MODEL_LARGE_PRODUCTION : &KILN_MODEL_SMALL_TEST;
+    cfg->start_temp_c = rng_chance(&rng, 0.1f) ? roundf(rng_uniform(&rng, 100.0f, 400.0f))
+                                               : roundf(rng_uniform(&rng, 15.0f, 40.0f));
+    generate_profile(&rng, index, cfg->start_temp_c, &cfg->profile);
+
+    /* Mostly the default limit; sometimes one just above the peak, so
+       overshoot and spikes exercise the over-temperature trip. (Below the
+       peak START refuses the profile outright.) */
+    if (rng_chance(&rng, 0.1f)) {
+        cfg->max_safe_temp_c = ceilf(cfg->profile.max_temp + rng_uniform(&rng, 0.0f, 10.0f));
+    }
+    if (rng_chance(&rng, 0.1f)) {
+        cfg->delay_minutes = 1 + rng_below(&rng, 30);
+    }
+
+    uint32_t plan = planned_s(&cfg->profile, cfg->start_temp_c);
+    uint32_t window = plan + plan / 10 + cfg->delay_minutes * 60u + 60u;
+    uint32_t paused_s = 0;
+    int n = (int)rng_below(&rng, FIRESIM_MC_MAX_FAULTS + 1);
+    for (int i = 0; i < n; i++) {
+        firesim_fault_t *f = &cfg->faults[cfg->fault_count++];
+        memset(f, 0, sizeof(*f));
+        f->at_s = rng_below(&rng, window);
+        uint32_t pick = rng_below(&rng, 100);
+        if (pick < 25) {
+            f->kind = FIRESIM_FAULT_TC_SPIKE;
+            f->duration_s = 1 + rng_below(&rng, 10);
+            f->value = roundf(rng_uniform(&rng, 5.0f, 300.0f)) * (rng_chance(&rng, 0.5f) ? 1.0f : -1.0f);
+        } else if (pick < 50) {
+            /* Straddle the 5 s fault timeout: about half of these must trip. */
+            f->kind = FIRESIM_FAULT_TC_OPEN;
+            f->duration_s = 1 + rng_below(&rng, 2 * APP_TEMP_FAULT_TIMEOUT_MS / 1000);
+        } else if (pick < 70) {
+            f->kind = FIRESIM_FAULT_PAUSE;
+            f->duration_s = 60 + rng_below(&rng, 3600);
+            paused_s += f->duration_s;
+        } else if (pick < 82) {
+            f->kind = FIRESIM_FAULT_ELEMENTS;
+            f->at_s = rng_chance(&rng, 0.5f) ? 0 : f->at_s;
+            f->value = rng_uniform(&rng, 0.4f, 1.0f);
+        } else if (pick < 95) {
+            f->kind = FIRESIM_FAULT_SKIP;
+        } else {
+            f->kind = FIRESIM_FAULT_STOP;
+        }
+    }
+
+    /* Room for a slow plant (degraded elements, large kiln lagging its
+       ramps) to take several times the plan, but not for a hang. */
+    cfg->max_s = 3 * window + paused_s + 12u * 3600u;
+}
+
+/* ── Invariants ──────────────────────────────────────────────────────── */
+
+static bool is_firing(firing_status_t s)
+{
+    return s == FIRING_STATUS_HEATING || s == FIRING_STATUS_HOLDING || s == FIRING_STATUS_COOLING;
+}
+
+void firesim_mc_checker_init(firesim_mc_checker_t *c, const firesim_config_t *cfg)
+{
+    memset(c, 0, sizeof(*c));
+    c->setpoint_lo_c = cfg->start_temp_c;
+    c->setpoint_hi_c = cfg->start_temp_c;
+    for (int i = 0; i < cfg->profile.segment_count; i++) {
+        c->setpoint_lo_c = fminf(c->setpoint_lo_c, cfg->profile.segments[i].target_temp);
+        c->setpoint_hi_c = fmaxf(c->setpoint_hi_c, cfg->profile.segments[i].target_temp);
+    }
+    c->setpoint_lo_c -= SETPOINT_MARGIN_C;
+    c->setpoint_hi_c += SETPOINT_MARGIN_C;
+    c->max_safe_c = cfg->max_safe_temp_c;
+}
+
+static void flag(firesim_mc_checker_t *c, firesim_mc_violation_t v, uint32_t t_s)
+{
+    if (c->violation == FIRESIM_MC_OK) {
+        c->violation = v;
+        c->violation_t_s = t_s;
+    }
+}
+
+void firesim_mc_observe(const firesim_sample_t *s, void *checker)
+{
+    firesim_mc_checker_t *c = checker;
+    bool firing = is_firing(s->status);
+    bool running = firing || s->status == FIRING_STATUS_PAUSED;
+
+    if (!firing && s->duty > 0.0f) {
+        flag(c, FIRESIM_MC_SSR_WHILE_NOT_FIRING, s->t_s);
+    }
+
+    c->tc_fault_run_s = s->tc_fault ? c->tc_fault_run_s + 1 : 0;
+    if (running && c->tc_fault_run_s > APP_TEMP_FAULT_TIMEOUT_MS / 1000 + TC_TRIP_SLACK_S) {
+        flag(c, FIRESIM_MC_MISSED_TC_TRIP, s->t_s);
+    }
+
+    c->over_temp_run_s = (!s->tc_fault && s->tc_c > c->max_safe_c) ? c->over_temp_run_s + 1 : 0;
+    if (running && c->over_temp_run_s >= OVER_TEMP_TICKS) {
+        flag(c, FIRESIM_MC_MISSED_OVERTEMP_TRIP, s->t_s);
+    }
+
+    /* Ramps start from the measured temperature, which may have drifted
+       below every target (cooling through a delayed start or a pause). */
+    if (!s->tc_fault && s->tc_c - SETPOINT_MARGIN_C < c->setpoint_lo_c) {
+        c->setpoint_lo_c = s->tc_c - SETPOINT_MARGIN_C;
+    }
+    if (firing && (s->setpoint_c < c->setpoint_lo_c || s->setpoint_c > c->setpoint_hi_c)) {
+        flag(c, FIRESIM_MC_SETPOINT_OUT_OF_RANGE, s->t_s);
+    }
+
+    if (running) {
+        if (s->segment < c->last_segment) {
+            flag(c, FIRESIM_MC_SEGMENT_REGRESSED, s->t_s);
+        }
+        c->last_segment = s->segment;
+    }
+}
+
+firesim_mc_violation_t firesim_mc_finish(firesim_mc_checker_t *c, const firesim_result_t *r)
+{
+    if (r->timed_out) {
+        flag(c, FIRESIM_MC_STALLED, r->total_s);
+    }
+    return c->violation;
+}
+
+firesim_mc_violation_t firesim_mc_run(const firesim_config_t *cfg, firesim_result_t *r, uint32_t *violation_t_s)
+{
+    firesim_result_t local;
+    if (!r) {
+        r = &local;
+    }
+    firesim_mc_checker_t c;
+    firesim_mc_checker_init(&c, cfg);
+    firesim_run(cfg, firesim_mc_observe, &c, r);
+    firesim_mc_violation_t v = firesim_mc_finish(&c, r);
+    if (violation_t_s) {
+        *violation_t_s = c.violation_t_s;
+    }
+    return v;
+}
+
+/* ── Shrinking ───────────────────────────────────────────────────────── */
+
+/* Try `cand`; adopt it into *cfg if it still fails. */
+static bool try_candidate(firesim_config_t *cfg, const firesim_config_t *cand, firesim_mc_fails_fn fails, void *ctx,
+                          int *runs)
+{
+    (*runs)++;
+    if (!fails(cand, ctx)) {
+        return false;
+    }
+    *cfg = *cand;
+    return true;
+}
+
+int firesim_mc_shrink(firesim_config_t *cfg, firesim_mc_fails_fn fails, void *ctx)
+{
+    int runs = 0;
+    firesim_config_t cand;
+    firesim_config_t defaults;
+    firesim_config_defaults(&defaults);
+
+    bool progress = true;
+    while (progress) {
+        progress = false;
+
+        for (int i = cfg->fault_count - 1; i >= 0; i--) {
+            cand = *cfg;
+            memmove(&cand.faults[i], &cand.faults[i + 1], (size_t)(cand.fault_count - i - 1) * sizeof(cand.faults[0]));
+            cand.fault_count--;
+            progress |= try_candidate(cfg, &cand, fails, ctx, &runs);
+        }
+
+        for (int i = cfg->profile.segment_count - 1; i >= 0 && cfg->profile.segment_count > 1; i--) {
+            cand = *cfg;
+            firing_profile_t *p = &cand.profile;
+            memmove(&p->segments[i], &p->segments[i + 1], (size_t)(p->segment_count - i - 1) * sizeof(p->segments[0]));
+            p->segment_count--;
+            memset(&p->segments[p->segment_count], 0, sizeof(p->segments[0]));
+            recompute_max_temp(p);
+            progress |= try_candidate(cfg, &cand, fails, ctx, &runs);
+        }
+
+        for (int i = 0; i < cfg->profile.segment_count; i++) {
+            if (cfg->profile.segments[i].hold_time != 0) {
+                cand = *cfg;
+                cand.profile.segments[i].hold_time = 0;
+                progress |= try_candidate(cfg, &cand, fails, ctx, &runs);
+            }
+        }
+
+        if (cfg->delay_minutes != 0) {
+            cand = *cfg;
+            cand.delay_minutes = 0;
+            progress |= try_candidate(cfg, &cand, fails, ctx, &runs);
+        }
+        if (cfg->plant != defaults.plant) {
+            cand = *cfg;
+            cand.plant = defaults.plant;
+            progress |= try_candidate(cfg, &cand, fails, ctx, &runs);
+        }
+        if (cfg->start_temp_c != defaults.start_temp_c) {
+            cand = *cfg;
+            cand.start_temp_c = defaults.start_temp_c;
+            progress |= try_candidate(cfg, &cand, fails, ctx, &runs);
+        }
+        if (cfg->max_safe_temp_c != defaults.max_safe_temp_c) {
+            cand = *cfg;
+            cand.max_safe_temp_c = defaults.max_safe_temp_c;
+            progress |= try_candidate(cfg, &cand, fails, ctx, &runs);
+        }
+    }
+    return runs;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "firesim.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Randomized robustness runs on top of firesim: scenario generation,
+ * state-machine invariants checked every simulated second, and a shrinker
+ * that reduces a failing scenario to a minimal reproducer.
+ *
+ * Everything here is deterministic in (seed, index), so a scenario number
+ * printed by bisque_firesim_mc can be regenerated anywhere. The parallel
+ * driver lives in bisque_firesim_mc.c. */
+
+typedef enum {
+    FIRESIM_MC_OK = 0,
+    FIRESIM_MC_SSR_WHILE_NOT_FIRING,   /* duty > 0 while paused / idle / error / complete */
+    FIRESIM_MC_MISSED_TC_TRIP,         /* faulted TC for > timeout + slack, still firing */
+    FIRESIM_MC_MISSED_OVERTEMP_TRIP,   /* reading above max_safe for several ticks, still firing */
+    FIRESIM_MC_SETPOINT_OUT_OF_RANGE,  /* outside the profile's targets and the readings seen */
+    FIRESIM_MC_SEGMENT_REGRESSED,      /* current_segment went backwards */
+    FIRESIM_MC_STALLED,                /* never finished within the generous time cap */
+    FIRESIM_MC_VIOLATION_COUNT,
+} firesim_mc_violation_t;
+
+const char *firesim_mc_violation_name(firesim_mc_violation_t v);
+
+/* Build scenario `index` of the run seeded by `seed`: a random profile
+ * (heating ramps, holds, optional controlled cool), plant, start temperature,
+ * delay, safety limit and up to FIRESIM_MC_MAX_FAULTS random disturbances and
+ * operator commands, with max_s set well past the planned duration. */
+#define FIRESIM_MC_MAX_FAULTS 5
+void firesim_mc_generate(uint64_t seed, uint32_t index, firesim_config_t *cfg);
+
+/* Per-run invariant checker. Feed it every sample (firesim_mc_observe has the
+ * firesim_trace_fn signature), then call firesim_mc_finish with the result.
+ * Only the first violation is kept. */
+typedef struct {
+    float setpoint_lo_c;
+    float setpoint_hi_c;
+    float max_safe_c;
+    uint32_t tc_fault_run_s;
+    uint32_t over_temp_run_s;
+    int last_segment;
+    firesim_mc_violation_t violation;
+    uint32_t violation_t_s;
+} firesim_mc_checker_t;
+
+void firesim_mc_checker_init(firesim_mc_checker_t *c, const firesim_config_t *cfg);
+void firesim_mc_observe(const firesim_sample_t *s, void *checker);
+firesim_mc_violation_t firesim_mc_finish(firesim_mc_checker_t *c, const firesim_result_t *r);
+
+/* firesim_run + checker in one call. `r` may be NULL. */
+firesim_mc_violation_t firesim_mc_run(const firesim_config_t *cfg, firesim_result_t *r, uint32_t *violation_t_s);
+
+/* Greedy shrink: repeatedly drop faults and segments and reset incidental
+ * knobs (delay, plant, start temperature, safety limit) to defaults, keeping
+ * each change only while `fails` still returns true. `cfg` is updated in
+ * place. Returns the number of candidate runs made. */
+typedef bool (*firesim_mc_fails_fn)(const firesim_config_t *cfg, void *ctx);
+int firesim_mc_shrink(firesim_config_t *cfg, firesim_mc_fails_fn fails, void *ctx);
@@ -0,0 +1,87 @@
+#include "firing_replay.h"
+
+#include "esp_timer.h"
+#include "firing_engine.h"
+#include "firing_engine_internal.h"
+#include "firing_record.h"
+#include "history_host.h"
+#include "nvs.h"
+#include "safety_host.h"
+#include "thermocouple_host.h"
+
+#include <string.h>
+
+/* Put the engine and stubs into the state the recording started from. */
+static void replay_setup(const firing_record_header_t *hdr)
+{
+    host_clock_set(0);
+    nvs_reset_for_test();
+    safety_test_reset();
+    history_test_reset();
+    firing_engine_reset_for_test();
+    firing_engine_set_pid_gains_for_test(hdr->kp, hdr->ki, hdr->kd);
+
+    kiln_settings_t st;
+    firing_engine_get_settings(&st);
+    st.tc_offset_c = hdr->tc_offset_c;
+    firing_engine_set_settings(&st);
+    /* After set_settings, which clamps and would round a non-integral limit. */
+    safety_set_max_temp(hdr->max_safe_temp_c);
+
+    /* An idle tick at the recorded baseline gives the first real tick the
+       same dt it had on the device. */
+    host_clock_set(hdr->last_tick_us);
+    firing_tick(hdr->last_tick_us);
+}
+
+bool firing_replay_run(FILE *f, firing_replay_fn fn, void *ctx, firing_replay_result_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    firing_record_reader_t reader;
+    firing_record_header_t hdr;
+    if (!firing_record_read_header(&reader, f, &hdr)) {
+        return false;
+    }
+    replay_setup(&hdr);
+
+    firing_record_entry_t e;
+    while (firing_record_read_next(&reader, &e)) {
+        switch (e.kind) {
+        case FIRING_RECORD_READING:
+            thermocouple_test_set(e.temperature_c, e.fault);
+            out->readings++;
+            break;
+        case FIRING_RECORD_CMD:
+            host_clock_set(e.time_us);
+            firing_engine_dispatch_cmd_for_test(&e.cmd);
+            out->commands++;
+            break;
+        case FIRING_RECORD_TICK: {
+            /* Trips the engine raises itself (not-rising, runaway) are already
+               latched by the time the next tick is recorded; anything else came
+               from safety_task on the device. */
+            if (e.trip_cause != SAFETY_TRIP_NONE && !safety_is_emergency()) {
+                safety_emergency_stop_cause((safety_trip_cause_t)e.trip_cause);
+            }
+            host_clock_set(e.time_us);
+            firing_tick(e.time_us);
+            out->ticks++;
+            if (fn) {
+                firing_replay_tick_t t = {.time_us = e.time_us, .duty = safety_test_last_duty()};
+                firing_engine_get_progress(&t.progress);
+                fn(&t, ctx);
+            }
+            break;
+        }
+        case FIRING_RECORD_END:
+            break;
+        }
+    }
+
+    out->truncated = reader.truncated;
+    firing_progress_t prog;
+    firing_engine_get_progress(&prog);
+    out->final_status = prog.status;
+    out->error_code = firing_engine_get_error_code();
+    return true;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "firing_types.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Replay a firing record (components/firing_engine/firing_record.h) through
+ * the real firing_engine.c: every recorded reading is pushed into the
+ * thermocouple stub, every safety trip latched in the safety stub, every
+ * command dispatched and every tick run at its recorded time. The engine has
+ * no other inputs, so it retraces the recorded firing exactly — the same SSR
+ * duty, setpoint and status on every tick — and a bug seen on a kiln can be
+ * stepped through under a debugger.
+ *
+ * Engine state is process-global (see firesim.h): call firing_engine_init()
+ * once first, and do not interleave a replay with other scenarios. */
+
+/* Engine outputs after one replayed tick. */
+typedef struct {
+    int64_t time_us;
+    firing_progress_t progress;
+    float duty; /* SSR duty the tick commanded */
+} firing_replay_tick_t;
+
+typedef void (*firing_replay_fn)(const firing_replay_tick_t *tick, void *ctx);
+
+typedef struct {
+    uint32_t ticks;
+    uint32_t commands;
+    uint32_t readings;
+    bool truncated; /* recording ended without an END record (power loss, size cap) */
+    firing_status_t final_status;
+    firing_error_code_t error_code;
+} firing_replay_result_t;
+
+/* Replay the recording in `f`, calling `fn` (may be NULL) after every tick.
+ * Returns false if `f` is not a firing record this build can read. */
+bool firing_replay_run(FILE *f, firing_replay_fn fn, void *ctx, firing_replay_result_t *out);
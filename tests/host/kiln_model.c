@@ -0,0 +1,127 @@
+#include "kiln_model.h"
+
+#include <math.h>
+#include <string.h>
+
+#define KELVIN_OFFSET 273.15f
+
+/* Largest explicit-Euler step. The stiffest coupling in either preset is the
+ * small kiln's wall↔load radiation near peak (~100 W/K against a 3 kJ/K load,
+ * τ ≈ 30 s), so 0.5 s keeps every node well inside the stable region. */
+#define KILN_MODEL_MAX_SUBSTEP_S 0.5f
+
+const kiln_model_params_t KILN_MODEL_SMALL_TEST = {
+    .name = "small-test",
+    .wall_heat_cap_j_per_c = 10000.0f,
+    .load_heat_cap_j_per_c = 3000.0f,
+    .element_power_w = 1800.0f,
+    .element_tcr_per_c = 4.0e-5f,
+    .loss_cond_w_per_c = 0.5f,
+    .loss_rad_w_per_k4 = 1.45e-10f,
+    .couple_conv_w_per_c = 4.0f,
+    .couple_rad_w_per_k4 = 6.0e-9f,
+    .tc_tau_s = 8.0f,
+    .tc_quant_c = 0.25f,
+};
+
+const kiln_model_params_t KILN_MODEL_LARGE_PRODUCTION = {
+    .name = "large-production",
+    .wall_heat_cap_j_per_c = 90000.0f,
+    .load_heat_cap_j_per_c = 45000.0f,
+    .element_power_w = 11500.0f,
+    .element_tcr_per_c = 4.0e-5f,
+    .loss_cond_w_per_c = 3.0f,
+    .loss_rad_w_per_k4 = 8.5e-10f,
+    .couple_conv_w_per_c = 15.0f,
+    .couple_rad_w_per_k4 = 3.0e-8f,
+    .tc_tau_s = 20.0f,
+    .tc_quant_c = 0.25f,
+};
+
+const kiln_model_params_t *kiln_model_preset(const char *name)
+{
+    if (!name) {
+        return NULL;
+    }
+    if (strcmp(name, "small") == 0 || strcmp(name, KILN_MODEL_SMALL_TEST.name) == 0) {
+        return &KILN_MODEL_SMALL_TEST;
+    }
+    if (strcmp(name, "large") == 0 || strcmp(name, KILN_MODEL_LARGE_PRODUCTION.name) == 0) {
+        return &KILN_MODEL_LARGE_PRODUCTION;
+    }
+    return NULL;
+}
+
+void kiln_model_init(kiln_model_t *m, const kiln_model_params_t *params, float start_temp_c)
+{
+    memset(m, 0, sizeof(*m));
+    m->p = *params;
+    m->ambient_c = 20.0f;
+    m->wall_c = start_temp_c;
+    m->load_c = start_temp_c;
+    m->tc_c = start_temp_c;
+    m->element_health = 1.0f;
+}
+
+static float t4(float c)
+{
+    float k = c + KELVIN_OFFSET;
+    float k2 = k * k;
+    return k2 * k2;
+}
+
+float kiln_model_element_power_w(const kiln_model_t *m)
+{
+    float r_ratio = 1.0f + m->p.element_tcr_per_c * (m->wall_c - 20.0f);
+    if (r_ratio < 0.5f) {
+        r_ratio = 0.5f;
+    }
+    return m->p.element_power_w * m->element_health / r_ratio;
+}
+
+float kiln_model_loss_w(const kiln_model_t *m, float wall_c)
+{
+    return m->p.loss_cond_w_per_c * (wall_c - m->ambient_c) + m->p.loss_rad_w_per_k4 * (t4(wall_c) - t4(m->ambient_c));
+}
+
+void kiln_model_step(kiln_model_t *m, float duty, float dt_s)
+{
+    if (!(dt_s > 0.0f)) {
+        return;
+    }
+    if (!(duty > 0.0f)) {
+        duty = 0.0f; /* also catches NaN */
+    } else if (duty > 1.0f) {
+        duty = 1.0f;
+    }
+
+    int n = (int)ceilf(dt_s / KILN_MODEL_MAX_SUBSTEP_S);
+    float h = dt_s / (float)n;
+    for (int i = 0; i < n; i++) {
+        float p_in = duty * kiln_model_element_power_w(m);
+        float q_loss = kiln_model_loss_w(m, m->wall_c);
+        float q_load = m->p.couple_conv_w_per_c * (m->wall_c - m->load_c) +
+                       m->p.couple_rad_w_per_k4 * (t4(m->wall_c) - t4(m->load_c));
+        m->wall_c += (p_in - q_loss - q_load) * h / m->p.wall_heat_cap_j_per_c;
+        m->load_c += q_load * h / m->p.load_heat_cap_j_per_c;
+        m->energy_j += (double)(p_in * h);
+    }
+
+    /* Sheath lag, integrated exactly over the whole step against the end-of-
+       step wall temperature — the sensor is far slower than the sub-step. */
+    if (m->p.tc_tau_s > 0.0f) {
+        m->tc_c += (m->wall_c - m->tc_c) * (1.0f - expf(-dt_s / m->p.tc_tau_s));
+    } else {
+        m->tc_c = m->wall_c;
+    }
+    m->elapsed_s += dt_s;
+}
+
+float kiln_model_tc_reading(const kiln_model_t *m)
+{
+    float q = m->p.tc_quant_c;
+    if (q <= 0.0f) {
+        return m->tc_c;
+    }
+    return roundf(m->tc_c / q) * q;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stdint.h>
+
+/* Lumped-parameter thermal model of an electric kiln, for closed-loop host
+ * simulation.
+ *
+ * plant.c tracks the engine's setpoint and never sees the SSR, which is
+ * exactly right for state-machine tests and useless for judging control
+ * quality. This model is driven by the duty the engine actually commanded
+ * (safety_test_last_duty()), so PID, feed-forward and autotune changes can be
+ * scored on tracking error and energy without hardware.
+ *
+ * Two thermal nodes:
+ *
+ *  - wall — elements, inner brick face and chamber atmosphere. Element power
+ *    lands here; the thermocouple sees this node. Loses heat to ambient by
+ *    conduction/convection through the shell and by radiation.
+ *  - load — ware and kiln furniture. Exchanges heat with the wall only, by
+ *    convection at low temperature and radiation at high temperature.
+ *
+ * Element power follows the resistance rise of the heating wire:
+ * P(T) = P_rated * health / (1 + tcr * (T_wall - 20)). The thermocouple is a
+ * first-order lag on the wall temperature, reported with the MAX31855's
+ * 0.25 °C quantization.
+ *
+ * The SSR on the device is time-proportioned over a 2 s window; at the 1 Hz
+ * tick the window-averaged power is what the thermal mass integrates, so the
+ * model takes the duty as a continuous 0..1 power fraction. */
+
+typedef struct {
+    const char *name;
+    float wall_heat_cap_j_per_c; /* elements + inner brick + atmosphere */
+    float load_heat_cap_j_per_c; /* ware + shelves + posts */
+    float element_power_w;       /* rated element power at 20 °C */
+    float element_tcr_per_c;     /* fractional resistance rise per °C of wall temperature */
+    float loss_cond_w_per_c;     /* wall → ambient, linear (shell conduction + convection) */
+    float loss_rad_w_per_k4;     /* wall → ambient, radiative (ε·σ·A lumped), per K⁴ */
+    float couple_conv_w_per_c;   /* wall ↔ load, linear */
+    float couple_rad_w_per_k4;   /* wall ↔ load, radiative, per K⁴ */
+    float tc_tau_s;              /* thermocouple sheath time constant */
+    float tc_quant_c;            /* thermocouple reporting step */
+} kiln_model_params_t;
+
+/* Presets. Small: a 120 V, 1.8 kW bench test kiln with a few pieces of ware —
+ * lively, ~500 °C/hr from cold, ~110 °C/hr at 1222 °C, tops out ~1360 °C.
+ * Large: a 240 V, 11.5 kW production top-loader with a full shelf load —
+ * heavy, ~300 °C/hr from cold but only ~80 °C/hr at 1222 °C (it cannot follow
+ * a 150 °C/hr final ramp), tops out ~1400 °C. Both at full duty, new
+ * elements, load in equilibrium with the wall. */
+extern const kiln_model_params_t KILN_MODEL_SMALL_TEST;
+extern const kiln_model_params_t KILN_MODEL_LARGE_PRODUCTION;
+
+/* Look a preset up by name ("small" / "large", or its full `name`). Returns
+ * NULL for an unknown name. */
+const kiln_model_params_t *kiln_model_preset(const char *name);
+
+typedef struct {
+    kiln_model_params_t p;
+    float ambient_c;
+    float wall_c;
+    float load_c;
+    float tc_c;           /* lagged thermocouple junction temperature (unquantized) */
+    float element_health; /* 1.0 = new elements; <1 scales available power */
+    double energy_j;      /* electrical energy delivered to the elements */
+    double elapsed_s;
+} kiln_model_t;
+
+/* Start with every node (and the thermocouple) at `start_temp_c`, ambient at
+ * 20 °C, new elements, zero energy. */
+void kiln_model_init(kiln_model_t *m, const kiln_model_params_t *params, float start_temp_c);
+
+/* Advance `dt_s` seconds with the elements at `duty` (clamped to 0..1).
+ * Internally sub-steps so any dt is stable. */
+void kiln_model_step(kiln_model_t *m, float duty, float dt_s);
+
+/* What the MAX31855 would report now: lagged junction temperature rounded to
+ * the nearest tc_quant_c. */
+float kiln_model_tc_reading(const kiln_model_t *m);
+
+/* Element power (W) at full duty for the current wall temperature. */
+float kiln_model_element_power_w(const kiln_model_t *m);
+
+/* Net heat leaving the wall to ambient (W) at a given wall temperature. */
+float kiln_model_loss_w(const kiln_model_t *m, float wall_c);
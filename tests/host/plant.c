@@ -28,3 +28,10 @@ void plant_step(plant_t *p, float setpoint_c, float dt_s)
     float approach = 1.0f - expf(-dt_s / tau);
     p->temp_c += (target - p->temp_c) * approach;
 }
+
+bool plant_is_steady(const plant_t *p, float setpoint_c)
+{
+    plant_t next = *p;
+    plant_step(&next, setpoint_c, 1.0f);
+    return next.temp_c == p->temp_c;
+}
@@ -29,3 +29,8 @@ void plant_init(plant_t *p, float start_temp_c);
  * current target temperature (progress.target_temp, which firing_tick
  * writes at end-of-tick) and passes it as `setpoint_c`. */
 void plant_step(plant_t *p, float setpoint_c, float dt_s);
+
+/* True when plant_step(p, setpoint_c, 1 tick) would leave the temperature
+ * exactly where it is — stuck, or converged to where float rounding stops
+ * the lag moving it. Lets the skipping scenario runner jump idle stretches. */
+bool plant_is_steady(const plant_t *p, float setpoint_c);
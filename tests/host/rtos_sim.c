@@ -0,0 +1,956 @@
+#include "rtos_sim.h"
+
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+
+/* Host frames (libc printf, the engine's NVS paths) are far deeper than the
+   device's; stack sizes passed to xTaskCreate are ignored. */
+#define TASK_STACK_BYTES (256 * 1024)
+#define NEVER            INT64_MAX
+#define TICK_US          1000LL
+
+/* A runaway task that neither blocks nor spends CPU would spin the scheduler
+   at one instant forever. */
+#define MAX_RESUMES_PER_INSTANT 100000
+
+#define ESP_TIMER_TASK_PRIO 22
+
+typedef enum {
+    TASK_READY,
+    TASK_BLOCKED,
+    TASK_DELETED,
+} task_state_t;
+
+typedef enum {
+    WAIT_NONE,
+    WAIT_DELAY,
+    WAIT_MUTEX,
+    WAIT_QUEUE_RECV,
+    WAIT_QUEUE_SEND,
+    WAIT_NOTIFY,
+} wait_kind_t;
+
+typedef struct sim_obj sim_obj_t;
+typedef struct sim_task sim_task_t;
+
+#define MAX_HELD 4
+
+struct sim_task {
+    char name[16];
+    TaskFunction_t fn;
+    void *param;
+    int base_prio;
+    int prio; /* effective, after inheritance */
+    int core;
+    task_state_t state;
+
+    wait_kind_t wait;
+    sim_obj_t *wait_obj;
+    int64_t wake_us;
+    bool timed_out;
+    int64_t blocked_since_us;
+    uint64_t wait_seq; /* FIFO among equal-priority waiters */
+
+    int64_t cpu_due_us; /* CPU still to spend before the code resumes */
+    int64_t activation_us;
+    uint64_t ready_seq;
+    int64_t ready_at_us;
+    bool awaiting_cpu;
+
+    uint32_t notify;
+    sim_obj_t *held[MAX_HELD];
+    int n_held;
+    bool in_inversion;
+    int64_t inversion_start_us;
+
+    rtos_sim_task_stats_t stats;
+
+    ucontext_t ctx;
+    void *stack;
+    sim_task_t *next;
+};
+
+struct sim_obj {
+    bool is_mutex;
+    char name[24];
+    /* queue */
+    UBaseType_t capacity, item_size, count, head, tail;
+    uint8_t *buffer;
+    /* mutex */
+    sim_task_t *owner;
+    rtos_sim_mutex_stats_t stats;
+    char worst_waiter[16];
+    sim_obj_t *next;
+};
+
+typedef struct sim_group {
+    EventBits_t bits;
+    struct sim_group *next;
+} sim_group_t;
+
+struct esp_timer {
+    esp_timer_cb_t cb;
+    void *arg;
+    char name[24];
+    int64_t period_us; /* 0 = one-shot */
+    int64_t due_us;
+    bool armed;
+    struct esp_timer *next;
+};
+
+typedef struct {
+    char name[16];
+    int64_t activation_us;
+} cost_entry_t;
+
+#define MAX_COSTS 32
+
+static rtos_sim_config_t s_cfg = RTOS_SIM_CONFIG_DEFAULT;
+static int64_t s_now;
+static sim_task_t *s_tasks;
+static sim_task_t **s_tasks_tail = &s_tasks;
+static sim_obj_t *s_objs;
+static sim_group_t *s_groups;
+static struct esp_timer *s_timers;
+static sim_task_t *s_timer_task;
+static cost_entry_t s_costs[MAX_COSTS];
+static int s_n_costs;
+static uint64_t s_seq;
+static uint32_t s_n_mutexes;
+static int64_t s_busy_us[RTOS_SIM_CORES];
+static int64_t s_epoch_us; /* clock at the last reset */
+
+static ucontext_t s_sched_ctx;
+static sim_task_t *s_current;
+
+/* ── Scheduling primitives ────────────────────────── */
+
+static int64_t tick_deadline(TickType_t ticks)
+{
+    if (ticks == portMAX_DELAY) {
+        return NEVER;
+    }
+    return (s_now / TICK_US + (int64_t)ticks) * TICK_US;
+}
+
+static void yield_to_scheduler(void)
+{
+    sim_task_t *t = s_current;
+    swapcontext(&t->ctx, &s_sched_ctx);
+}
+
+static void make_ready(sim_task_t *t)
+{
+    t->state = TASK_READY;
+    t->ready_seq = ++s_seq;
+    t->ready_at_us = s_now;
+    t->awaiting_cpu = true;
+    t->cpu_due_us += t->activation_us;
+    t->stats.activations++;
+}
+
+static void end_inversion(sim_task_t *t)
+{
+    if (!t->in_inversion) {
+        return;
+    }
+    t->in_inversion = false;
+    int64_t len = s_now - t->inversion_start_us;
+    sim_obj_t *m = t->wait_obj;
+    if (m && len > m->stats.max_inversion_us) {
+        m->stats.max_inversion_us = len;
+        snprintf(m->worst_waiter, sizeof(m->worst_waiter), "%s", t->name);
+    }
+}
+
+static void wake(sim_task_t *t, bool timed_out)
+{
+    end_inversion(t);
+    t->timed_out = timed_out;
+    t->wait = WAIT_NONE;
+    t->wait_obj = NULL;
+    t->wake_us = NEVER;
+    make_ready(t);
+}
+
+/* Block the calling task; returns once it has been woken and has spent its
+   activation cost. Returns true if woken by an event, false on timeout. */
+static bool block_current(wait_kind_t kind, sim_obj_t *obj, int64_t wake_us)
+{
+    sim_task_t *t = s_current;
+    t->state = TASK_BLOCKED;
+    t->wait = kind;
+    t->wait_obj = obj;
+    t->wake_us = wake_us;
+    t->timed_out = false;
+    t->blocked_since_us = s_now;
+    t->wait_seq = ++s_seq;
+    yield_to_scheduler();
+    return !t->timed_out;
+}
+
+/* Highest-priority task blocked on `obj` for `kind` (FIFO among equals). */
+static sim_task_t *best_waiter(sim_obj_t *obj, wait_kind_t kind)
+{
+    sim_task_t *best = NULL;
+    for (sim_task_t *t = s_tasks; t; t = t->next) {
+        if (t->state == TASK_BLOCKED && t->wait == kind && t->wait_obj == obj &&
+            (!best || t->prio > best->prio || (t->prio == best->prio && t->wait_seq < best->wait_seq))) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+static void recompute_prio(sim_task_t *t)
+{
+    int p = t->base_prio;
+    if (s_cfg.priority_inheritance) {
+        for (int i = 0; i < t->n_held; i++) {
+            for (sim_task_t *w = s_tasks; w; w = w->next) {
+                if (w->state == TASK_BLOCKED && w->wait == WAIT_MUTEX && w->wait_obj == t->held[i] && w->prio > p) {
+                    p = w->prio;
+                }
+            }
+        }
+    }
+    t->prio = p;
+}
+
+/* Raise the holder chain of `m` to at least `prio`. */
+static void inherit(sim_obj_t *m, int prio)
+{
+    for (int depth = 0; m && m->owner && depth < 8; depth++) {
+        sim_task_t *o = m->owner;
+        if (o->prio >= prio) {
+            return;
+        }
+        o->prio = prio;
+        m = (o->state == TASK_BLOCKED && o->wait == WAIT_MUTEX) ? o->wait_obj : NULL;
+    }
+}
+
+static void hold(sim_task_t *t, sim_obj_t *m)
+{
+    m->owner = t;
+    m->stats.takes++;
+    if (t->n_held < MAX_HELD) {
+        t->held[t->n_held++] = m;
+    }
+}
+
+static void release(sim_task_t *t, sim_obj_t *m)
+{
+    for (int i = 0; i < t->n_held; i++) {
+        if (t->held[i] == m) {
+            t->held[i] = t->held[--t->n_held];
+            break;
+        }
+    }
+    m->owner = NULL;
+}
+
+/* ── Tasks ────────────────────────────────────────── */
+
+static int64_t cost_for(const char *name)
+{
+    for (int i = 0; i < s_n_costs; i++) {
+        if (strcmp(s_costs[i].name, name) == 0) {
+            return s_costs[i].activation_us;
+        }
+    }
+    return s_cfg.activation_us;
+}
+
+static void task_entry(void)
+{
+    sim_task_t *t = s_current;
+    t->fn(t->param);
+    /* Returning from a FreeRTOS task function is undefined on the device;
+       treat it as deleting itself. */
+    vTaskDelete(NULL);
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *param,
+                                   UBaseType_t priority, TaskHandle_t *out_handle, BaseType_t core_id)
+{
+    (void)stack_depth;
+    sim_task_t *t = calloc(1, sizeof(*t));
+    void *stack = malloc(TASK_STACK_BYTES);
+    if (!t || !stack) {
+        free(t);
+        free(stack);
+        return pdFAIL;
+    }
+    snprintf(t->name, sizeof(t->name), "%s", name ? name : "task");
+    t->fn = fn;
+    t->param = param;
+    t->base_prio = t->prio = (int)priority;
+    t->core = (core_id >= 0 && core_id < RTOS_SIM_CORES) ? (int)core_id : 0;
+    t->activation_us = cost_for(t->name);
+    t->wake_us = NEVER;
+    t->stack = stack;
+    t->stats.name = t->name;
+    t->stats.core = t->core;
+    t->stats.priority = t->base_prio;
+
+    getcontext(&t->ctx);
+    t->ctx.uc_stack.ss_sp = stack;
+    t->ctx.uc_stack.ss_size = TASK_STACK_BYTES;
+    t->ctx.uc_link = NULL;
+    makecontext(&t->ctx, task_entry, 0);
+
+    *s_tasks_tail = t;
+    s_tasks_tail = &t->next;
+    make_ready(t);
+    if (out_handle) {
+        *out_handle = t;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *param,
+                       UBaseType_t priority, TaskHandle_t *out_handle)
+{
+    return xTaskCreatePinnedToCore(fn, name, stack_depth, param, priority, out_handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    sim_task_t *t = task ? (sim_task_t *)task : s_current;
+    if (!t) {
+        return;
+    }
+    while (t->n_held > 0) {
+        release(t, t->held[0]);
+    }
+    t->state = TASK_DELETED;
+    if (t == s_current) {
+        yield_to_scheduler(); /* never resumed */
+    }
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return s_current;
+}
+
+const char *rtos_sim_current_task(void)
+{
+    return s_current ? s_current->name : NULL;
+}
+
+void rtos_sim_consume(int64_t cpu_us)
+{
+    if (!s_current || cpu_us <= 0) {
+        return;
+    }
+    s_current->cpu_due_us += cpu_us;
+    yield_to_scheduler();
+}
+
+void rtos_sim_block(int64_t us)
+{
+    if (s_current && us > 0) {
+        block_current(WAIT_DELAY, NULL, s_now + us);
+    }
+}
+
+/* ── Time ─────────────────────────────────────────── */
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(s_now / TICK_US);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    if (s_current && ticks > 0) {
+        block_current(WAIT_DELAY, NULL, tick_deadline(ticks));
+    }
+}
+
+BaseType_t xTaskDelayUntil(TickType_t *last_wake, TickType_t increment)
+{
+    TickType_t wake = *last_wake + increment;
+    *last_wake = wake;
+    int64_t wake_us = (int64_t)wake * TICK_US;
+    if (!s_current || wake_us <= s_now) {
+        return pdFALSE;
+    }
+    block_current(WAIT_DELAY, NULL, wake_us);
+    return pdTRUE;
+}
+
+void vTaskDelayUntil(TickType_t *last_wake, TickType_t increment)
+{
+    xTaskDelayUntil(last_wake, increment);
+}
+
+/* ── Notifications ────────────────────────────────── */
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    sim_task_t *t = task;
+    t->notify++;
+    if (t->state == TASK_BLOCKED && t->wait == WAIT_NOTIFY) {
+        wake(t, false);
+    }
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t timeout)
+{
+    sim_task_t *t = s_current;
+    if (!t) {
+        return 0;
+    }
+    int64_t deadline = tick_deadline(timeout);
+    while (t->notify == 0) {
+        if (timeout == 0 || !block_current(WAIT_NOTIFY, NULL, deadline)) {
+            return 0;
+        }
+    }
+    uint32_t v = t->notify;
+    t->notify = clear_on_exit ? 0 : v - 1;
+    return v;
+}
+
+/* ── Queues ───────────────────────────────────────── */
+
+static sim_obj_t *new_obj(bool is_mutex)
+{
+    sim_obj_t *o = calloc(1, sizeof(*o));
+    if (!o) {
+        return NULL;
+    }
+    o->is_mutex = is_mutex;
+    if (is_mutex) {
+        snprintf(o->name, sizeof(o->name), "mutex#%u", (unsigned)++s_n_mutexes);
+    }
+    o->stats.name = o->name;
+    o->stats.worst_waiter = o->worst_waiter;
+    o->next = s_objs;
+    s_objs = o;
+    return o;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    sim_obj_t *q = new_obj(false);
+    if (!q) {
+        return NULL;
+    }
+    q->buffer = calloc(length, item_size);
+    q->capacity = length;
+    q->item_size = item_size;
+    return q->buffer ? q : NULL;
+}
+
+void vQueueAddToRegistry(QueueHandle_t qh, const char *name)
+{
+    sim_obj_t *o = qh;
+    if (o && name) {
+        snprintf(o->name, sizeof(o->name), "%s", name);
+    }
+}
+
+BaseType_t xQueueSend(QueueHandle_t qh, const void *item, TickType_t timeout)
+{
+    sim_obj_t *q = qh;
+    if (!q) {
+        return pdFAIL;
+    }
+    int64_t deadline = tick_deadline(timeout);
+    while (q->count >= q->capacity) {
+        if (!s_current || timeout == 0 || !block_current(WAIT_QUEUE_SEND, q, deadline)) {
+            return pdFAIL;
+        }
+    }
+    memcpy(q->buffer + q->tail * q->item_size, item, q->item_size);
+    q->tail = (q->tail + 1) % q->capacity;
+    q->count++;
+    sim_task_t *w = best_waiter(q, WAIT_QUEUE_RECV);
+    if (w) {
+        wake(w, false);
+    }
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t qh, void *out, TickType_t timeout)
+{
+    sim_obj_t *q = qh;
+    if (!q) {
+        return pdFAIL;
+    }
+    int64_t deadline = tick_deadline(timeout);
+    while (q->count == 0) {
+        if (!s_current || timeout == 0 || !block_current(WAIT_QUEUE_RECV, q, deadline)) {
+            return pdFAIL;
+        }
+    }
+    memcpy(out, q->buffer + q->head * q->item_size, q->item_size);
+    q->head = (q->head + 1) % q->capacity;
+    q->count--;
+    sim_task_t *w = best_waiter(q, WAIT_QUEUE_SEND);
+    if (w) {
+        wake(w, false);
+    }
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t qh)
+{
+    sim_obj_t *q = qh;
+    return q ? q->count : 0;
+}
+
+/* ── Mutexes ──────────────────────────────────────── */
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return new_obj(true);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t timeout)
+{
+    sim_obj_t *m = sem;
+    sim_task_t *t = s_current;
+    if (!m) {
+        return pdFAIL;
+    }
+    if (!t) {
+        return pdTRUE; /* outside any task: see rtos_sim.h */
+    }
+    if (!m->owner) {
+        hold(t, m);
+        return pdTRUE;
+    }
+    if (m->owner == t || timeout == 0) {
+        return pdFAIL; /* not recursive: a real second take would deadlock */
+    }
+    m->stats.contended++;
+    if (s_cfg.priority_inheritance) {
+        inherit(m, t->prio);
+    }
+    int64_t since = s_now;
+    bool got = block_current(WAIT_MUTEX, m, tick_deadline(timeout));
+    int64_t waited = s_now - since;
+    if (waited > m->stats.max_wait_us) {
+        m->stats.max_wait_us = waited;
+    }
+    if (!got && m->owner) {
+        recompute_prio(m->owner); /* drop what this waiter lent */
+    }
+    return got ? pdTRUE : pdFAIL;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    sim_obj_t *m = sem;
+    sim_task_t *t = s_current;
+    if (!m || !t || m->owner != t) {
+        return pdFAIL;
+    }
+    rtos_sim_consume(s_cfg.mutex_hold_us);
+    release(t, m);
+    recompute_prio(t);
+    sim_task_t *w = best_waiter(m, WAIT_MUTEX);
+    if (w) {
+        hold(w, m);
+        wake(w, false);
+        recompute_prio(w);
+    }
+    return pdTRUE;
+}
+
+/* ── Event groups (never waited on by the firmware) ─ */
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    sim_group_t *g = calloc(1, sizeof(*g));
+    if (g) {
+        g->next = s_groups;
+        s_groups = g;
+    }
+    return g;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t gh, EventBits_t bits)
+{
+    sim_group_t *g = gh;
+    if (!g) {
+        return 0;
+    }
+    g->bits |= bits;
+    return g->bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t gh, EventBits_t bits)
+{
+    sim_group_t *g = gh;
+    if (!g) {
+        return 0;
+    }
+    EventBits_t old = g->bits;
+    g->bits &= ~bits;
+    return old;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t gh)
+{
+    sim_group_t *g = gh;
+    return g ? g->bits : 0;
+}
+
+/* ── esp_timer ────────────────────────────────────── */
+
+static struct esp_timer *next_due_timer(void)
+{
+    struct esp_timer *best = NULL;
+    for (struct esp_timer *tm = s_timers; tm; tm = tm->next) {
+        if (tm->armed && (!best || tm->due_us < best->due_us)) {
+            best = tm;
+        }
+    }
+    return best;
+}
+
+static void esp_timer_task(void *arg)
+{
+    (void)arg;
+    for (;;) {
+        struct esp_timer *tm = next_due_timer();
+        if (tm && tm->due_us <= s_now) {
+            if (tm->period_us > 0) {
+                tm->due_us += tm->period_us;
+            } else {
+                tm->armed = false;
+            }
+            tm->cb(tm->arg);
+            continue;
+        }
+        if (s_timer_task->notify == 0) {
+            block_current(WAIT_NOTIFY, NULL, tm ? tm->due_us : NEVER);
+        }
+        s_timer_task->notify = 0;
+    }
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out_handle)
+{
+    struct esp_timer *tm = calloc(1, sizeof(*tm));
+    if (!tm) {
+        return ESP_ERR_NO_MEM;
+    }
+    tm->cb = args->callback;
+    tm->arg = args->arg;
+    snprintf(tm->name, sizeof(tm->name), "%s", args->name ? args->name : "timer");
+    tm->next = s_timers;
+    s_timers = tm;
+    *out_handle = tm;
+    return ESP_OK;
+}
+
+static esp_err_t timer_arm(esp_timer_handle_t tm, uint64_t first_us, uint64_t period_us)
+{
+    if (!tm || tm->armed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    tm->due_us = s_now + (int64_t)first_us;
+    tm->period_us = (int64_t)period_us;
+    tm->armed = true;
+    xTaskNotifyGive(s_timer_task);
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t tm, uint64_t period_us)
+{
+    return timer_arm(tm, period_us, period_us);
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t tm, uint64_t timeout_us)
+{
+    return timer_arm(tm, timeout_us, 0);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t tm)
+{
+    if (!tm || !tm->armed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    tm->armed = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t tm)
+{
+    for (struct esp_timer **p = &s_timers; *p; p = &(*p)->next) {
+        if (*p == tm) {
+            *p = tm->next;
+            free(tm);
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
+/* ── Scheduler ────────────────────────────────────── */
+
+void rtos_sim_reset(const rtos_sim_config_t *cfg)
+{
+    static const rtos_sim_config_t defaults = RTOS_SIM_CONFIG_DEFAULT;
+    s_cfg = cfg ? *cfg : defaults;
+
+    while (s_tasks) {
+        sim_task_t *t = s_tasks;
+        s_tasks = t->next;
+        free(t->stack);
+        free(t);
+    }
+    s_tasks_tail = &s_tasks;
+    while (s_objs) {
+        sim_obj_t *o = s_objs;
+        s_objs = o->next;
+        free(o->buffer);
+        free(o);
+    }
+    while (s_groups) {
+        sim_group_t *g = s_groups;
+        s_groups = g->next;
+        free(g);
+    }
+    while (s_timers) {
+        struct esp_timer *tm = s_timers;
+        s_timers = tm->next;
+        free(tm);
+    }
+    s_current = NULL;
+    s_n_costs = 0;
+    s_epoch_us = s_now;
+    s_seq = 0;
+    s_n_mutexes = 0;
+    memset(s_busy_us, 0, sizeof(s_busy_us));
+
+    TaskHandle_t h;
+    xTaskCreatePinnedToCore(esp_timer_task, "esp_timer", 4096, NULL, ESP_TIMER_TASK_PRIO, &h, 0);
+    s_timer_task = h;
+}
+
+void rtos_sim_set_task_cost(const char *name, int64_t activation_us)
+{
+    int i = 0;
+    while (i < s_n_costs && strcmp(s_costs[i].name, name) != 0) {
+        i++;
+    }
+    if (i == s_n_costs) {
+        if (s_n_costs == MAX_COSTS) {
+            return;
+        }
+        s_n_costs++;
+        snprintf(s_costs[i].name, sizeof(s_costs[i].name), "%s", name);
+    }
+    s_costs[i].activation_us = activation_us;
+    for (sim_task_t *t = s_tasks; t; t = t->next) {
+        if (strcmp(t->name, name) == 0) {
+            t->activation_us = activation_us;
+        }
+    }
+}
+
+int64_t rtos_sim_now(void)
+{
+    return s_now;
+}
+
+static sim_task_t *pick(int core)
+{
+    sim_task_t *best = NULL;
+    for (sim_task_t *t = s_tasks; t; t = t->next) {
+        if (t->state == TASK_READY && t->core == core &&
+            (!best || t->prio > best->prio || (t->prio == best->prio && t->ready_seq < best->ready_seq))) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+static void note_running(sim_task_t *t)
+{
+    if (t->awaiting_cpu) {
+        t->awaiting_cpu = false;
+        int64_t lat = s_now - t->ready_at_us;
+        t->stats.total_latency_us += lat;
+        if (lat > t->stats.max_latency_us) {
+            t->stats.max_latency_us = lat;
+        }
+    }
+}
+
+static void expire_timeouts(void)
+{
+    for (sim_task_t *t = s_tasks; t; t = t->next) {
+        if (t->state == TASK_BLOCKED && t->wake_us <= s_now) {
+            wake(t, t->wait != WAIT_DELAY);
+        }
+    }
+}
+
+/* Run every task that can make progress at the current instant without
+   spending CPU, until all cores are idle or busy spending. */
+static void settle(sim_task_t *running[RTOS_SIM_CORES])
+{
+    for (int resumes = 0;; resumes++) {
+        if (resumes > MAX_RESUMES_PER_INSTANT) {
+            fprintf(stderr, "rtos_sim: task spinning at t=%lld us without blocking\n", (long long)s_now);
+            abort();
+        }
+        expire_timeouts();
+        bool resumed = false;
+        for (int c = 0; c < RTOS_SIM_CORES && !resumed; c++) {
+            sim_task_t *t = pick(c);
+            running[c] = t;
+            if (t) {
+                note_running(t);
+                if (t->cpu_due_us == 0) {
+                    s_current = t;
+                    swapcontext(&s_sched_ctx, &t->ctx);
+                    s_current = NULL;
+                    resumed = true;
+                }
+            }
+        }
+        if (!resumed) {
+            return;
+        }
+    }
+}
+
+/* A task waiting on a mutex is inverted while the holder is ready but kept
+   off its core by a task of lower priority than the waiter. */
+static void account_inversions(sim_task_t *running[RTOS_SIM_CORES], int64_t dt)
+{
+    for (sim_task_t *h = s_tasks; h; h = h->next) {
+        if (h->state != TASK_BLOCKED || h->wait != WAIT_MUTEX) {
+            continue;
+        }
+        sim_obj_t *m = h->wait_obj;
+        sim_task_t *l = m->owner;
+        sim_task_t *r = l ? running[l->core] : NULL;
+        bool inverted = l && l->state == TASK_READY && r && r != l && r->prio < h->prio;
+        if (inverted) {
+            if (!h->in_inversion) {
+                h->in_inversion = true;
+                h->inversion_start_us = s_now;
+                m->stats.inversions++;
+            }
+            m->stats.inversion_us += dt;
+        } else {
+            end_inversion(h);
+        }
+    }
+}
+
+int64_t rtos_sim_run(int64_t until_us, rtos_sim_pred_fn pred, void *ctx)
+{
+    sim_task_t *running[RTOS_SIM_CORES];
+    for (;;) {
+        host_clock_set(s_now);
+        settle(running);
+        if (pred && pred(ctx)) {
+            return s_now;
+        }
+        if (s_now >= until_us) {
+            return -1;
+        }
+
+        int64_t next = until_us;
+        for (sim_task_t *t = s_tasks; t; t = t->next) {
+            if (t->state == TASK_BLOCKED && t->wake_us < next) {
+                next = t->wake_us;
+            }
+        }
+        for (int c = 0; c < RTOS_SIM_CORES; c++) {
+            if (running[c] && s_now + running[c]->cpu_due_us < next) {
+                next = s_now + running[c]->cpu_due_us;
+            }
+        }
+
+        int64_t dt = next - s_now;
+        account_inversions(running, dt);
+        for (int c = 0; c < RTOS_SIM_CORES; c++) {
+            if (running[c]) {
+                running[c]->cpu_due_us -= dt;
+                running[c]->stats.cpu_us += dt;
+                s_busy_us[c] += dt;
+            }
+        }
+        s_now = next;
+    }
+}
+
+/* ── Statistics ───────────────────────────────────── */
+
+bool rtos_sim_task_stats(const char *name, rtos_sim_task_stats_t *out)
+{
+    for (sim_task_t *t = s_tasks; t; t = t->next) {
+        if (strcmp(t->name, name) == 0) {
+            *out = t->stats;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool rtos_sim_mutex_stats(const char *name, rtos_sim_mutex_stats_t *out)
+{
+    for (sim_obj_t *o = s_objs; o; o = o->next) {
+        if (o->is_mutex && strcmp(o->name, name) == 0) {
+            *out = o->stats;
+            return true;
+        }
+    }
+    return false;
+}
+
+float rtos_sim_core_load(int core)
+{
+    if (core < 0 || core >= RTOS_SIM_CORES || s_now == s_epoch_us) {
+        return 0.0f;
+    }
+    return (float)((double)s_busy_us[core] / (double)(s_now - s_epoch_us));
+}
+
+void rtos_sim_report(FILE *out)
+{
+    fprintf(out, "virtual time %.3f s; core load %.2f%% / %.2f%%\n", (double)(s_now - s_epoch_us) / 1e6,
+            100.0 * rtos_sim_core_load(0), 100.0 * rtos_sim_core_load(1));
+    fprintf(out, "%-14s %4s %4s %10s %12s %14s %14s\n", "task", "core", "prio", "wakes", "cpu_us",
+            "max_latency_us", "avg_latency_us");
+    for (sim_task_t *t = s_tasks; t; t = t->next) {
+        const rtos_sim_task_stats_t *s = &t->stats;
+        fprintf(out, "%-14s %4d %4d %10u %12lld %14lld %14.1f\n", s->name, s->core, s->priority,
+                (unsigned)s->activations, (long long)s->cpu_us, (long long)s->max_latency_us,
+                s->activations ? (double)s->total_latency_us / s->activations : 0.0);
+    }
+    fprintf(out, "%-14s %8s %9s %11s %10s %12s %16s\n", "mutex", "takes", "contended", "max_wait_us",
+            "inversions", "inversion_us", "max_inversion_us");
+    for (sim_obj_t *o = s_objs; o; o = o->next) {
+        if (!o->is_mutex) {
+            continue;
+        }
+        const rtos_sim_mutex_stats_t *s = &o->stats;
+        fprintf(out, "%-14s %8u %9u %11lld %10u %12lld %16lld%s%s\n", s->name, (unsigned)s->takes,
+                (unsigned)s->contended, (long long)s->max_wait_us, (unsigned)s->inversions,
+                (long long)s->inversion_us, (long long)s->max_inversion_us, s->inversions ? " worst: " : "",
+                s->inversions ? s->worst_waiter : "");
+    }
+}
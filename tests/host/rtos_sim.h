@@ -0,0 +1,106 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Deterministic discrete-event FreeRTOS for the host.
+ *
+ * Linking rtos_sim.c instead of stubs/freertos_stub.c gives the firmware a
+ * FreeRTOS whose tasks really block: xTaskCreatePinnedToCore() starts the
+ * task function on its own coroutine, and delays, queue waits, mutex waits and
+ * notifications suspend it in virtual time. The scheduler models the ESP32-S3's
+ * two cores: on each core the highest-priority ready task pinned there runs
+ * (equal priorities first-come, no time slicing; tskNO_AFFINITY runs on core
+ * 0). Mutexes inherit priority like FreeRTOS mutexes do. esp_timer callbacks
+ * run from a priority-22 "esp_timer" task on core 0, as on the device.
+ *
+ * Task code between two blocking calls executes in zero virtual time; CPU cost
+ * is modelled explicitly so preemption and lock contention happen where they
+ * would on the chip:
+ *   - each wake-up charges the task's activation cost before its code resumes
+ *     (rtos_sim_set_task_cost),
+ *   - each mutex-protected section holds the mutex for mutex_hold_us of CPU
+ *     before the give takes effect,
+ *   - task code (or a peripheral stub) may call rtos_sim_consume() for more.
+ * A task spending CPU can be preempted by a higher-priority task on its core.
+ *
+ * Everything is a pure function of the inputs — no host threads, no wall
+ * clock — so a run is exactly repeatable. esp_timer_get_time() and
+ * xTaskGetTickCount() (1 ms ticks) follow the scheduler's clock.
+ *
+ * Calls made from outside any task (test code, init before tasks start) never
+ * block: a mutex take succeeds without contending, a full queue send and an
+ * empty receive fail immediately. */
+
+#define RTOS_SIM_CORES 2
+
+typedef struct {
+    bool priority_inheritance; /* FreeRTOS mutexes inherit; false shows an unprotected lock */
+    int64_t mutex_hold_us;     /* CPU spent inside every mutex-protected section */
+    int64_t activation_us;     /* default per-wake cost for tasks without one set */
+} rtos_sim_config_t;
+
+#define RTOS_SIM_CONFIG_DEFAULT {.priority_inheritance = true, .mutex_hold_us = 2, .activation_us = 10}
+
+/* Drop every task, queue, mutex, event group, timer and statistic. Anything
+ * holding handles from before (e.g. firing_engine's queues) must be
+ * re-initialized. The clock keeps running: firmware statics outlive a reset
+ * within one process and must never see time go backwards.
+ * NULL = RTOS_SIM_CONFIG_DEFAULT. */
+void rtos_sim_reset(const rtos_sim_config_t *cfg);
+
+/* Per-wake CPU cost of the task called `name` (existing or created later). */
+void rtos_sim_set_task_cost(const char *name, int64_t activation_us);
+
+/* Spend `cpu_us` of CPU in the calling task. No-op outside a task. */
+void rtos_sim_consume(int64_t cpu_us);
+
+/* Block the calling task for `us` without spending CPU, as a driver waiting
+ * on its peripheral does. No-op outside a task. */
+void rtos_sim_block(int64_t us);
+
+int64_t rtos_sim_now(void);
+
+/* Name of the task currently executing, or NULL outside any task. */
+const char *rtos_sim_current_task(void);
+
+typedef bool (*rtos_sim_pred_fn)(void *ctx);
+
+/* Run until `until_us`, or until `pred` (may be NULL) returns true — it is
+ * evaluated whenever the scheduler has settled at an instant. Returns the time
+ * `pred` became true, or -1 if `until_us` was reached first (the clock is then
+ * at `until_us`). */
+int64_t rtos_sim_run(int64_t until_us, rtos_sim_pred_fn pred, void *ctx);
+
+/* ── Statistics ───────────────────────────────────── */
+
+typedef struct {
+    const char *name;
+    int core;
+    int priority;
+    uint32_t activations;    /* wake-ups */
+    int64_t cpu_us;          /* CPU consumed */
+    int64_t max_latency_us;  /* longest wait from ready to first CPU */
+    int64_t total_latency_us;
+} rtos_sim_task_stats_t;
+
+typedef struct {
+    const char *name;            /* vQueueAddToRegistry name, or "mutex#N" */
+    uint32_t takes;
+    uint32_t contended;          /* takes that had to wait */
+    int64_t max_wait_us;         /* longest wait for the mutex */
+    uint32_t inversions;         /* episodes of a waiter delayed by a lower-priority task */
+    int64_t inversion_us;        /* total time spent in those episodes */
+    int64_t max_inversion_us;
+    const char *worst_waiter;    /* task of the longest inversion episode */
+} rtos_sim_mutex_stats_t;
+
+bool rtos_sim_task_stats(const char *name, rtos_sim_task_stats_t *out);
+bool rtos_sim_mutex_stats(const char *name, rtos_sim_mutex_stats_t *out);
+
+/* Fraction of elapsed virtual time `core` spent running tasks. */
+float rtos_sim_core_load(int core);
+
+/* Per-task and per-mutex table, for humans. */
+void rtos_sim_report(FILE *out);
@@ -8,6 +8,7 @@
 #include "safety_host.h"
 #include "thermocouple_host.h"
 
+#include <math.h>
 #include <string.h>
 
 void scenario_setup(plant_t *plant, float start_temp_c)
@@ -28,7 +29,7 @@ void scenario_dispatch(const firing_cmd_t *cmd)
 
 void scenario_start(const firing_profile_t *profile, uint32_t delay_minutes)
 {
-    firing_cmd_t cmd = {.type = FIRING_CMD_START};
+    firing_cmd_t cmd = {.type = FIRING_CMD_START, .source = FIRING_SRC_API};
     cmd.start.profile = *profile;
     cmd.start.delay_minutes = delay_minutes;
     scenario_dispatch(&cmd);
@@ -36,25 +37,25 @@ void scenario_start(const firing_profile_t *profile, uint32_t delay_minutes)
 
 void scenario_stop(void)
 {
-    firing_cmd_t cmd = {.type = FIRING_CMD_STOP};
+    firing_cmd_t cmd = {.type = FIRING_CMD_STOP, .source = FIRING_SRC_API};
     scenario_dispatch(&cmd);
 }
 
 void scenario_pause(void)
 {
-    firing_cmd_t cmd = {.type = FIRING_CMD_PAUSE};
+    firing_cmd_t cmd = {.type = FIRING_CMD_PAUSE, .source = FIRING_SRC_API};
     scenario_dispatch(&cmd);
 }
 
 void scenario_resume(void)
 {
-    firing_cmd_t cmd = {.type = FIRING_CMD_RESUME};
+    firing_cmd_t cmd = {.type = FIRING_CMD_RESUME, .source = FIRING_SRC_API};
     scenario_dispatch(&cmd);
 }
 
 void scenario_skip(void)
 {
-    firing_cmd_t cmd = {.type = FIRING_CMD_SKIP_SEGMENT};
+    firing_cmd_t cmd = {.type = FIRING_CMD_SKIP_SEGMENT, .source = FIRING_SRC_API};
     scenario_dispatch(&cmd);
 }
 
@@ -65,7 +66,7 @@ bool scenario_relay_test(uint32_t duration_s)
 
 void scenario_autotune_start(float setpoint, float hysteresis)
 {
-    firing_cmd_t cmd = {.type = FIRING_CMD_AUTOTUNE_START};
+    firing_cmd_t cmd = {.type = FIRING_CMD_AUTOTUNE_START, .source = FIRING_SRC_API};
     cmd.autotune.setpoint = setpoint;
     cmd.autotune.hysteresis = hysteresis;
     scenario_dispatch(&cmd);
@@ -73,7 +74,7 @@ void scenario_autotune_start(float setpoint, float hysteresis)
 
 void scenario_autotune_stop(void)
 {
-    firing_cmd_t cmd = {.type = FIRING_CMD_AUTOTUNE_STOP};
+    firing_cmd_t cmd = {.type = FIRING_CMD_AUTOTUNE_STOP, .source = FIRING_SRC_API};
     scenario_dispatch(&cmd);
 }
 
@@ -101,6 +102,37 @@ firing_status_t scenario_run_ticks(plant_t *plant, int tick_count)
     return prog.status;
 }
 
+int scenario_run_ticks_skipping(plant_t *plant, int tick_count)
+{
+    int64_t end_us = esp_timer_get_time() + (int64_t)tick_count * HARNESS_TICK_US;
+    int ticks = 0;
+    while (esp_timer_get_time() < end_us) {
+        /* Only trust the engine's forecast after a tick of our own: a command
+           dispatched since the last one has already changed its state. While
+           the plant sits still, every skipped tick would have seen the same
+           reading, and the plant steps it would have taken are no-ops. */
+        int64_t now_us = esp_timer_get_time();
+        firing_progress_t prog;
+        firing_engine_get_progress(&prog);
+        if (ticks > 0 && plant_is_steady(plant, prog.target_temp)) {
+            int64_t event_us = firing_next_event_us(now_us);
+            if (event_us > end_us) {
+                event_us = end_us;
+            }
+            /* Land on the last tick of the 1 Hz grid before the event, so the
+               event tick itself runs with its usual dt and sees freshly
+               published progress. */
+            int64_t skipped = (event_us - now_us - 1) / HARNESS_TICK_US - 1;
+            if (skipped > 0) {
+                host_clock_advance(skipped * HARNESS_TICK_US);
+            }
+        }
+        harness_tick_once(plant);
+        ticks++;
+    }
+    return ticks;
+}
+
 bool scenario_run_until_status(plant_t *plant, firing_status_t target_status, int max_ticks)
 {
     firing_progress_t prog;
@@ -114,6 +146,71 @@ bool scenario_run_until_status(plant_t *plant, firing_status_t target_status, in
     return false;
 }
 
+void scenario_setup_thermal(kiln_model_t *kiln, const kiln_model_params_t *preset, float start_temp_c)
+{
+    plant_t unused;
+    scenario_setup(&unused, start_temp_c);
+    kiln_model_init(kiln, preset, start_temp_c);
+    thermocouple_test_set(kiln_model_tc_reading(kiln), 0);
+}
+
+float scenario_track_rms(const scenario_track_t *t)
+{
+    if (!t || t->firing_ticks == 0) {
+        return 0.0f;
+    }
+    return (float)sqrt(t->sq_err_sum / (double)t->firing_ticks);
+}
+
+static void harness_tick_thermal(kiln_model_t *kiln, scenario_track_t *track)
+{
+    /* The duty the engine set this tick is held until the next one — exactly
+       what the SSR does on hardware between firing_task iterations. */
+    host_clock_advance(HARNESS_TICK_US);
+    firing_tick(esp_timer_get_time());
+    kiln_model_step(kiln, safety_test_last_duty(), (float)HARNESS_TICK_US / 1000000.0f);
+    thermocouple_test_set(kiln_model_tc_reading(kiln), 0);
+
+    if (track) {
+        firing_progress_t prog;
+        firing_engine_get_progress(&prog);
+        track->ticks++;
+        if (prog.is_active && (prog.status == FIRING_STATUS_HEATING || prog.status == FIRING_STATUS_HOLDING ||
+                               prog.status == FIRING_STATUS_COOLING)) {
+            float err = prog.current_temp - prog.target_temp;
+            track->firing_ticks++;
+            track->sq_err_sum += (double)err * (double)err;
+            if (err > track->max_overshoot_c) {
+                track->max_overshoot_c = err;
+            }
+        }
+    }
+}
+
+firing_status_t scenario_run_ticks_thermal(kiln_model_t *kiln, int tick_count, scenario_track_t *track)
+{
+    for (int i = 0; i < tick_count; i++) {
+        harness_tick_thermal(kiln, track);
+    }
+    firing_progress_t prog;
+    firing_engine_get_progress(&prog);
+    return prog.status;
+}
+
+bool scenario_run_until_status_thermal(kiln_model_t *kiln, firing_status_t target_status, int max_ticks,
+                                       scenario_track_t *track)
+{
+    firing_progress_t prog;
+    for (int i = 0; i < max_ticks; i++) {
+        harness_tick_thermal(kiln, track);
+        firing_engine_get_progress(&prog);
+        if (prog.status == target_status) {
+            return true;
+        }
+    }
+    return false;
+}
+
 firing_profile_t scenario_short_profile(void)
 {
     /* Ramps are intentionally aggressive (6000°C/hr ≈ 100°C/min) so the
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "firing_types.h"
+#include "kiln_model.h"
 #include "plant.h"
 
 #include <stdbool.h>
@@ -41,10 +42,45 @@ void scenario_autotune_stop(void);
  * tick. */
 firing_status_t scenario_run_ticks(plant_t *plant, int tick_count);
 
+/* scenario_run_ticks(), but whenever the plant is steady it jumps straight to
+ * firing_next_event_us() instead of ticking once a second. Ends on the same
+ * simulated time and engine state as scenario_run_ticks(plant, tick_count);
+ * the last tick is always a real one, so a command dispatched afterwards sees
+ * the usual one-tick dt. Returns the number of firing_tick() calls made. */
+int scenario_run_ticks_skipping(plant_t *plant, int tick_count);
+
 /* Run ticks until status == target_status or N_ticks exhausted. Returns true
  * if status reached, false if the loop hit the cap. */
 bool scenario_run_until_status(plant_t *plant, firing_status_t target_status, int max_ticks);
 
+/* ── Closed-loop variants (kiln_model instead of plant) ─────────────────
+ * Same tick order as the plant loop, but the model is advanced on the duty
+ * the engine actually commanded (safety_test_last_duty()) and the TC stub is
+ * fed the model's lagged, quantized reading. */
+
+/* scenario_setup() plus kiln_model_init() with the given preset. */
+void scenario_setup_thermal(kiln_model_t *kiln, const kiln_model_params_t *preset, float start_temp_c);
+
+/* Running tracking/energy tally for a closed-loop run. Only ticks where the
+ * engine is actively firing (HEATING/HOLDING/COOLING) count toward the
+ * tracking error. */
+typedef struct {
+    uint32_t ticks;
+    uint32_t firing_ticks;
+    double sq_err_sum;     /* Σ (measured − target)² over firing ticks */
+    float max_overshoot_c; /* max (measured − target) over firing ticks */
+} scenario_track_t;
+
+/* RMS of (measured − target) over the firing ticks seen so far. */
+float scenario_track_rms(const scenario_track_t *t);
+
+/* Run N closed-loop ticks. `track` may be NULL. */
+firing_status_t scenario_run_ticks_thermal(kiln_model_t *kiln, int tick_count, scenario_track_t *track);
+
+/* Closed-loop analogue of scenario_run_until_status(). `track` may be NULL. */
+bool scenario_run_until_status_thermal(kiln_model_t *kiln, firing_status_t target_status, int max_ticks,
+                                       scenario_track_t *track);
+
 /* Build a synthetic profile with two segments suitable for fast end-to-end
  * tests. Both ramp rates use the bench-realistic 600 °C/hr; targets and
  * hold_time stay low so a full firing completes in a few simulated minutes. */
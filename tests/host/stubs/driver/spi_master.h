@@ -1,11 +1,43 @@
 #pragma once
 
 /* Minimal stand-in so thermocouple.h compiles on host without the ESP-IDF
- * SPI driver. The host harness never makes SPI calls — temperature comes
- * from thermocouple_test_set() instead. */
+ * SPI driver. The unit-test harness never makes SPI calls — temperature comes
+ * from thermocouple_test_set() instead; the task simulation
+ * (tests/host/task_sim.c) implements the device calls below and answers
+ * MAX31855 reads from the kiln model. */
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+#include <stddef.h>
+#include <stdint.h>
 
 typedef enum {
     SPI1_HOST = 1,
     SPI2_HOST = 2,
     SPI3_HOST = 3,
 } spi_host_device_t;
+
+typedef struct spi_device_t *spi_device_handle_t;
+
+typedef struct {
+    int clock_speed_hz;
+    uint8_t mode;
+    int spics_io_num;
+    int queue_size;
+    uint8_t command_bits;
+    uint8_t address_bits;
+} spi_device_interface_config_t;
+
+typedef struct {
+    size_t length; /* bits */
+    const void *tx_buffer;
+    void *rx_buffer;
+} spi_transaction_t;
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *cfg,
+                             spi_device_handle_t *out_handle);
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans);
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans);
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, TickType_t wait);
+void spi_device_release_bus(spi_device_handle_t dev);
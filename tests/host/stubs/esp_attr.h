@@ -0,0 +1,10 @@
+#pragma once
+
+/* Linker-section attributes are meaningless on the host. */
+
+#define EXT_RAM_BSS_ATTR
+#define EXT_RAM_NOINIT_ATTR
+#define DRAM_ATTR
+#define IRAM_ATTR
+#define WORD_ALIGNED_ATTR __attribute__((aligned(4)))
+#define DMA_ATTR          WORD_ALIGNED_ATTR
@@ -0,0 +1,19 @@
+#pragma once
+
+/* CPU cycle counter for the host: the monotonic clock scaled to
+ * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ (set by the targets that build with
+ * CONFIG_FIRING_TICK_PROFILE), wrapping like the 32-bit CCOUNT register. It
+ * runs in real time, not the virtual esp_timer clock. */
+
+#include <stdint.h>
+#include <time.h>
+
+typedef uint32_t esp_cpu_cycle_count_t;
+
+static inline esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t ns = (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+    return (esp_cpu_cycle_count_t)(ns * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ / 1000);
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "esp_err.h"
+
 #include <stdint.h>
 
 /* esp_timer monotonic clock — virtualized for tests so a 12-hour firing can
@@ -10,3 +12,21 @@ int64_t esp_timer_get_time(void);
  * to set or advance the virtual clock. */
 void host_clock_set(int64_t now_us);
 void host_clock_advance(int64_t delta_us);
+
+/* Callback timers. Implemented only by the discrete-event scheduler
+ * (tests/host/rtos_sim.c), which dispatches them from a simulated esp_timer
+ * task as ESP-IDF does. */
+typedef struct esp_timer *esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void *arg);
+
+typedef struct {
+    esp_timer_cb_t callback;
+    void *arg;
+    const char *name;
+} esp_timer_create_args_t;
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out_handle);
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us);
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us);
+esp_err_t esp_timer_stop(esp_timer_handle_t timer);
+esp_err_t esp_timer_delete(esp_timer_handle_t timer);
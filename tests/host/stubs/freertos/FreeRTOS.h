@@ -14,6 +14,14 @@ typedef uint32_t TickType_t;
 typedef int32_t BaseType_t;
 typedef uint32_t UBaseType_t;
 
+/* Buffers for the xxxCreateStatic() calls. The port keeps its own objects and
+ * ignores these, so they only need to exist; the firmware sizes stacks in
+ * bytes, as on ESP-IDF. */
+typedef uint8_t StackType_t;
+typedef struct {
+    void *unused[4];
+} StaticTask_t, StaticQueue_t, StaticSemaphore_t, StaticEventGroup_t;
+
 #define pdTRUE  1
 #define pdFALSE 0
 #define pdPASS  1
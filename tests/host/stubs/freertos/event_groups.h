@@ -6,6 +6,12 @@ typedef uint32_t EventBits_t;
 typedef void *EventGroupHandle_t;
 
 EventGroupHandle_t xEventGroupCreate(void);
+
+static inline EventGroupHandle_t xEventGroupCreateStatic(StaticEventGroup_t *buf)
+{
+    (void)buf;
+    return xEventGroupCreate();
+}
 EventBits_t xEventGroupSetBits(EventGroupHandle_t g, EventBits_t bits);
 EventBits_t xEventGroupClearBits(EventGroupHandle_t g, EventBits_t bits);
 EventBits_t xEventGroupGetBits(EventGroupHandle_t g);
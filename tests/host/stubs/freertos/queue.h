@@ -8,6 +8,18 @@
 typedef void *QueueHandle_t;
 
 QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+
+static inline QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t item_size, uint8_t *storage,
+                                               StaticQueue_t *buf)
+{
+    (void)storage;
+    (void)buf;
+    return xQueueCreate(length, item_size);
+}
 BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t timeout);
 BaseType_t xQueueReceive(QueueHandle_t q, void *out, TickType_t timeout);
 UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q);
+
+/* Names a queue or mutex for kernel-aware debuggers; rtos_sim reports per-name
+ * statistics from it. */
+void vQueueAddToRegistry(QueueHandle_t q, const char *name);
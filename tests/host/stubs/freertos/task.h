@@ -7,3 +7,31 @@
 TickType_t xTaskGetTickCount(void);
 void vTaskDelay(TickType_t ticks);
 void vTaskDelayUntil(TickType_t *last_wake, TickType_t increment);
+BaseType_t xTaskDelayUntil(TickType_t *last_wake, TickType_t increment);
+
+/* Tasks and notifications exist only under the discrete-event scheduler
+ * (tests/host/rtos_sim.c), which implements this whole header with real
+ * blocking in virtual time. The single-threaded stub does not define them. */
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *param,
+                                   UBaseType_t priority, TaskHandle_t *out_handle, BaseType_t core_id);
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *param,
+                       UBaseType_t priority, TaskHandle_t *out_handle);
+
+static inline TaskHandle_t xTaskCreateStaticPinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth,
+                                                         void *param, UBaseType_t priority, StackType_t *stack,
+                                                         StaticTask_t *tcb, BaseType_t core_id)
+{
+    (void)stack;
+    (void)tcb;
+    TaskHandle_t task = NULL;
+    return xTaskCreatePinnedToCore(fn, name, stack_depth, param, priority, &task, core_id) == pdPASS ? task : NULL;
+}
+void vTaskDelete(TaskHandle_t task);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t timeout);
@@ -28,6 +28,12 @@ void vTaskDelayUntil(TickType_t *last_wake, TickType_t increment)
     }
 }
 
+BaseType_t xTaskDelayUntil(TickType_t *last_wake, TickType_t increment)
+{
+    vTaskDelayUntil(last_wake, increment);
+    return pdTRUE;
+}
+
 /* ── mutex ─────────────────────────────────────────────────────────────── */
 
 SemaphoreHandle_t xSemaphoreCreateMutex(void)
@@ -109,6 +115,12 @@ UBaseType_t uxQueueMessagesWaiting(QueueHandle_t qh)
     return q ? q->count : 0;
 }
 
+void vQueueAddToRegistry(QueueHandle_t qh, const char *name)
+{
+    (void)qh;
+    (void)name;
+}
+
 /* ── event group ───────────────────────────────────────────────────────── */
 
 typedef struct {
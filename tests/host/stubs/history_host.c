@@ -3,6 +3,7 @@
 #include <string.h>
 
 static history_test_counts_t s_counts;
+static bool s_recording;
 
 esp_err_t history_init(void)
 {
@@ -15,14 +16,27 @@ void history_firing_start(const char *profile_id, const char *profile_name)
     (void)profile_id;
     (void)profile_name;
     s_counts.starts++;
+    s_recording = true;
 }
 
-void history_record_temp(float temp_c)
+void history_record_temp(uint32_t t_s, float temp_c)
 {
+    (void)t_s;
     (void)temp_c;
     s_counts.samples++;
 }
 
+void history_log_event(const history_event_t *evt)
+{
+    if (!s_recording) {
+        return;
+    }
+    if (s_counts.event_count < HISTORY_TEST_MAX_EVENTS) {
+        s_counts.events[s_counts.event_count] = *evt;
+    }
+    s_counts.event_count++;
+}
+
 void history_firing_end(history_outcome_t outcome, float peak_temp, uint32_t duration_s, int error_code)
 {
     s_counts.ends++;
@@ -30,6 +44,7 @@ void history_firing_end(history_outcome_t outcome, float peak_temp, uint32_t dur
     s_counts.last_peak_temp = peak_temp;
     s_counts.last_duration_s = duration_s;
     s_counts.last_error_code = error_code;
+    s_recording = false;
 }
 
 int history_get_records(history_record_t *out_records, int max_count)
@@ -45,6 +60,19 @@ FILE *history_open_trace(uint32_t record_id)
     return NULL;
 }
 
+FILE *history_open_events(uint32_t record_id)
+{
+    (void)record_id;
+    return NULL;
+}
+
+bool history_read_event(FILE *f, history_event_t *out)
+{
+    (void)f;
+    (void)out;
+    return false;
+}
+
 void history_clear(void)
 {
     history_test_reset();
@@ -67,6 +95,7 @@ const char *history_outcome_to_string(history_outcome_t outcome)
 void history_test_reset(void)
 {
     memset(&s_counts, 0, sizeof(s_counts));
+    s_recording = false;
 }
 
 history_test_counts_t history_test_counts(void)
@@ -4,6 +4,8 @@
 
 #include "firing_history.h"
 
+#define HISTORY_TEST_MAX_EVENTS 32
+
 typedef struct {
     int starts;
     int samples;
@@ -12,6 +14,8 @@ typedef struct {
     float last_peak_temp;
     uint32_t last_duration_s;
     int last_error_code;
+    int event_count; /* journal events logged during a firing; the first HISTORY_TEST_MAX_EVENTS are kept */
+    history_event_t events[HISTORY_TEST_MAX_EVENTS];
 } history_test_counts_t;
 
 void history_test_reset(void);
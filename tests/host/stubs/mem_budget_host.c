@@ -0,0 +1,30 @@
+#include "mem_budget.h"
+
+/* Host builds have no linker sections or heaps to report on; registrations
+ * are accepted and dropped. */
+
+void mem_budget_add(const char *component, const char *what, mem_region_t region, size_t bytes)
+{
+    (void)component;
+    (void)what;
+    (void)region;
+    (void)bytes;
+}
+
+void mem_budget_add_task(const char *component, TaskHandle_t task, mem_region_t region, size_t stack_bytes)
+{
+    (void)component;
+    (void)task;
+    (void)region;
+    (void)stack_bytes;
+}
+
+size_t mem_budget_task_stack(TaskHandle_t task)
+{
+    (void)task;
+    return 0;
+}
+
+void mem_budget_report(void)
+{
+}
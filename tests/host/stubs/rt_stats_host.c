@@ -0,0 +1,23 @@
+#include "rt_stats.h"
+
+#include <string.h>
+
+/* Host stub: firing_task brackets each tick with rt_stats_tick_begin/end.
+   There are no FreeRTOS run-time counters or cycle counter to sample on the
+   host, so nothing is recorded. */
+void rt_stats_init(void)
+{
+}
+
+void rt_stats_tick_begin(void)
+{
+}
+
+void rt_stats_tick_end(void)
+{
+}
+
+void rt_stats_snapshot(rt_stats_snapshot_t *out)
+{
+    memset(out, 0, sizeof(*out));
+}
@@ -35,3 +35,8 @@ void temp_read_task(void *param)
 {
     (void)param;
 }
+
+void thermocouple_get_timing(thermocouple_timing_t *out)
+{
+    *out = (thermocouple_timing_t){0};
+}
@@ -0,0 +1,447 @@
+#include "task_sim.h"
+
+#include "app_config.h"
+#include "driver/gpio.h"
+#include "driver/ledc.h"
+#include "driver/spi_master.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "firing_engine.h"
+#include "firing_engine_internal.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "history_host.h"
+#include "nvs.h"
+#include "safety.h"
+#include "thermocouple.h"
+
+#include <math.h>
+#include <string.h>
+
+/* Kconfig defaults (main/Kconfig.projbuild); app_config.h's APP_PIN_* are
+   CONFIG_ macros the host build doesn't define. */
+#define PIN_TC_CS 10
+#define PIN_SSR   17
+#define PIN_ALARM 7
+
+/* Modelled CPU per activation (µs). Rough ESP32-S3 @ 240 MHz figures: the
+   control tasks are arithmetic plus a few locks; the UI stand-ins are
+   dominated by LVGL rendering, cJSON and lwIP. */
+#define COST_SAFETY_US        20
+#define COST_TEMP_READ_US     15
+#define COST_SPI_TXN_US       40 /* 32 bits at 1 MHz plus driver overhead */
+#define COST_FIRING_US        300
+#define COST_ESP_TIMER_US     8
+#define COST_LVGL_LOOP_US     400
+#define COST_DASHBOARD_US     8000
+#define COST_WS_BROADCAST_US  3000
+#define COST_HTTPD_REQUEST_US 2500
+#define COST_NOTIFY_US        50
+
+#define DISPLAY_LOOP_MS      30
+#define DASHBOARD_PERIOD_MS  500
+#define WS_PERIOD_US         (1000LL * 1000LL)
+#define HTTPD_QUEUE_TIMEOUT  pdMS_TO_TICKS(100)
+#define KILN_MAX_STEP_US     (1000LL * 1000LL)
+
+/* The LCD's share of the SPI bus: each dashboard refresh is taken to repaint
+   the whole panel, which the DMA streams in APP_SPI_MAX_TRANSFER_SZ
+   transactions without the CPU. */
+#define LCD_CHUNK_US ((int64_t)APP_SPI_MAX_TRANSFER_SZ * 8 * 1000000 / APP_LCD_SPI_FREQ_HZ)
+#define LCD_FRAME_CHUNKS \
+    ((APP_LCD_H_RES * APP_LCD_V_RES * 2 + APP_SPI_MAX_TRANSFER_SZ - 1) / APP_SPI_MAX_TRANSFER_SZ)
+
+static kiln_model_t s_kiln;
+static int64_t s_kiln_us;
+static bool s_ssr_on;
+static int64_t s_ssr_changed_us;
+static uint32_t s_ssr_rising;
+static uint32_t s_alarm_tones;
+
+static bool s_tc_forced;
+static float s_tc_forced_c;
+static uint8_t s_tc_forced_fault;
+static int64_t s_last_sample_us;
+static int64_t s_lcd_flush_start_us; /* chunk boundaries fall every LCD_CHUNK_US from here */
+static int64_t s_lcd_flush_end_us;
+static int64_t s_bus_acquired_us;
+
+static TaskHandle_t s_httpd_task;
+static TaskHandle_t s_ws_task;
+static esp_timer_handle_t s_ws_timer;
+static bool s_mailbox_full;
+static firing_cmd_t s_mailbox;
+static int64_t s_cmd_queued_us;
+
+/* ── Board: kiln behind the SSR pin and the MAX31855 ─ */
+
+/* Bring the kiln up to the current instant on the SSR level it has had since
+   the last call. Called before anything reads or changes that level. */
+static void kiln_catch_up(void)
+{
+    int64_t now = rtos_sim_now();
+    while (s_kiln_us < now) {
+        int64_t step = now - s_kiln_us;
+        if (step > KILN_MAX_STEP_US) {
+            step = KILN_MAX_STEP_US;
+        }
+        kiln_model_step(&s_kiln, s_ssr_on ? 1.0f : 0.0f, (float)step / 1e6f);
+        s_kiln_us += step;
+    }
+}
+
+esp_err_t gpio_config(const gpio_config_t *cfg)
+{
+    return cfg ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    if (gpio_num == PIN_SSR) {
+        kiln_catch_up();
+        bool on = level != 0;
+        if (on != s_ssr_on) {
+            s_ssr_on = on;
+            s_ssr_changed_us = rtos_sim_now();
+            s_ssr_rising += on ? 1 : 0;
+        }
+    }
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    return (gpio_num == PIN_SSR && s_ssr_on) ? 1 : 0;
+}
+
+esp_err_t ledc_timer_config(const ledc_timer_config_t *cfg)
+{
+    return ESP_OK;
+}
+
+esp_err_t ledc_channel_config(const ledc_channel_config_t *cfg)
+{
+    return ESP_OK;
+}
+
+esp_err_t ledc_set_duty(ledc_mode_t mode, ledc_channel_t channel, uint32_t duty)
+{
+    s_alarm_tones += duty ? 1 : 0;
+    return ESP_OK;
+}
+
+esp_err_t ledc_update_duty(ledc_mode_t mode, ledc_channel_t channel)
+{
+    return ESP_OK;
+}
+
+static struct spi_device_t {
+    int cs;
+} s_tc_dev;
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *cfg,
+                             spi_device_handle_t *out_handle)
+{
+    s_tc_dev.cs = cfg->spics_io_num;
+    *out_handle = &s_tc_dev;
+    return ESP_OK;
+}
+
+/* MAX31855 frame: D31:18 thermocouple °C × 4, D16 fault, D15:4 cold junction
+   °C × 16, D2:0 SCV/SCG/OC — the same bit order as TC_FAULT_*. */
+static uint32_t max31855_frame(float tc_c, uint8_t fault)
+{
+    uint32_t cj = (uint32_t)(25 * 16) & 0x0FFF;
+    if (fault) {
+        return (1U << 16) | (cj << 4) | (fault & 0x7);
+    }
+    int32_t q = (int32_t)lroundf(tc_c * 4.0f);
+    return (((uint32_t)q & 0x3FFF) << 18) | (cj << 4);
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans)
+{
+    if (handle != &s_tc_dev || !trans || trans->length != 32 || !trans->rx_buffer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    rtos_sim_consume(COST_SPI_TXN_US);
+    kiln_catch_up();
+    uint32_t raw = s_tc_forced ? max31855_frame(s_tc_forced_c, s_tc_forced_fault)
+                               : max31855_frame(kiln_model_tc_reading(&s_kiln), 0);
+    uint8_t *rx = trans->rx_buffer;
+    rx[0] = (uint8_t)(raw >> 24);
+    rx[1] = (uint8_t)(raw >> 16);
+    rx[2] = (uint8_t)(raw >> 8);
+    rx[3] = (uint8_t)raw;
+    s_last_sample_us = rtos_sim_now();
+    return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans)
+{
+    return spi_device_transmit(handle, trans);
+}
+
+/* Acquiring holds off the LCD's queue at its next transaction boundary;
+   until then the reader blocks, as it does on the bus lock's semaphore. */
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, TickType_t wait)
+{
+    (void)wait;
+    if (device != &s_tc_dev) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    int64_t now = rtos_sim_now();
+    if (now >= s_lcd_flush_start_us && now < s_lcd_flush_end_us) {
+        int64_t into = (now - s_lcd_flush_start_us) % LCD_CHUNK_US;
+        if (into > 0) {
+            rtos_sim_block(LCD_CHUNK_US - into);
+        }
+    }
+    s_bus_acquired_us = rtos_sim_now();
+    return ESP_OK;
+}
+
+/* The LCD's remaining chunks resume after the read. */
+void spi_device_release_bus(spi_device_handle_t dev)
+{
+    (void)dev;
+    int64_t held = rtos_sim_now() - s_bus_acquired_us;
+    if (s_bus_acquired_us >= s_lcd_flush_start_us && s_bus_acquired_us < s_lcd_flush_end_us) {
+        s_lcd_flush_start_us += held;
+        s_lcd_flush_end_us += held;
+    }
+}
+
+static void lcd_flush_frame(void)
+{
+    int64_t now = rtos_sim_now();
+    int64_t start = now > s_lcd_flush_end_us ? now : s_lcd_flush_end_us;
+    s_lcd_flush_start_us = start;
+    s_lcd_flush_end_us = start + LCD_FRAME_CHUNKS * LCD_CHUNK_US;
+}
+
+/* ── Core-0 stand-ins ─────────────────────────────── */
+
+/* display_task: lv_timer_handler every ≤30 ms, dashboard_tick_cb every 500 ms
+   reading the latest sample and the firing progress, then a full-screen flush
+   on the shared SPI bus. */
+static void display_task(void *arg)
+{
+    (void)arg;
+    TickType_t last_dashboard = xTaskGetTickCount();
+    for (;;) {
+        rtos_sim_consume(COST_LVGL_LOOP_US);
+        if (xTaskGetTickCount() - last_dashboard >= pdMS_TO_TICKS(DASHBOARD_PERIOD_MS)) {
+            last_dashboard = xTaskGetTickCount();
+            thermocouple_reading_t tc;
+            firing_progress_t prog;
+            thermocouple_get_latest(&tc);
+            firing_engine_get_progress(&prog);
+            rtos_sim_consume(COST_DASHBOARD_US);
+            lcd_flush_frame();
+        }
+        vTaskDelay(pdMS_TO_TICKS(DISPLAY_LOOP_MS));
+    }
+}
+
+/* ws_broadcast_task: woken by the 1 s timer, snapshots the same state as
+   ws_broadcast_status() and pays for building and sending the frame. */
+static void ws_broadcast_task(void *arg)
+{
+    (void)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        firing_progress_t prog;
+        thermocouple_reading_t tc;
+        kiln_settings_t settings;
+        firing_engine_get_progress(&prog);
+        thermocouple_get_latest(&tc);
+        firing_engine_get_settings(&settings);
+        rtos_sim_consume(COST_WS_BROADCAST_US);
+    }
+}
+
+static void ws_timer_cb(void *arg)
+{
+    (void)arg;
+    xTaskNotifyGive(s_ws_task);
+}
+
+/* httpd: one REST command handler — parse, then queue to firing_task with the
+   same 100 ms timeout as api_handlers.c. */
+static void httpd_task(void *arg)
+{
+    (void)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!s_mailbox_full) {
+            continue;
+        }
+        rtos_sim_consume(COST_HTTPD_REQUEST_US);
+        firing_cmd_t cmd = s_mailbox;
+        s_mailbox_full = false;
+        if (xQueueSend(firing_engine_get_cmd_queue(), &cmd, HTTPD_QUEUE_TIMEOUT) == pdTRUE) {
+            s_cmd_queued_us = rtos_sim_now();
+        }
+    }
+}
+
+/* notification_task minus the webhook POST. */
+static void notify_task(void *arg)
+{
+    (void)arg;
+    QueueHandle_t q = firing_engine_get_event_queue();
+    for (;;) {
+        firing_event_t evt;
+        if (xQueueReceive(q, &evt, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        safety_trigger_alarm(evt.kind == FIRING_EVENT_COMPLETE ? 1 : 2);
+    }
+}
+
+/* ── Boot ─────────────────────────────────────────── */
+
+void task_sim_config_defaults(task_sim_config_t *cfg)
+{
+    static const rtos_sim_config_t rtos = RTOS_SIM_CONFIG_DEFAULT;
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->kiln = &KILN_MODEL_SMALL_TEST;
+    cfg->start_temp_c = 25.0f;
+    cfg->rtos = rtos;
+    cfg->ui_tasks = true;
+}
+
+void task_sim_boot(const task_sim_config_t *cfg)
+{
+    rtos_sim_reset(&cfg->rtos);
+    nvs_reset_for_test();
+    history_test_reset();
+
+    kiln_model_init(&s_kiln, cfg->kiln ? cfg->kiln : &KILN_MODEL_SMALL_TEST, cfg->start_temp_c);
+    s_kiln_us = rtos_sim_now();
+    s_ssr_on = false;
+    s_ssr_changed_us = -1;
+    s_ssr_rising = 0;
+    s_alarm_tones = 0;
+    s_tc_forced = false;
+    s_last_sample_us = -1;
+    s_lcd_flush_start_us = -1;
+    s_lcd_flush_end_us = -1;
+    s_mailbox_full = false;
+    s_cmd_queued_us = -1;
+    s_httpd_task = NULL;
+    s_ws_task = NULL;
+
+    /* app_main order. Module statics survive between boots in one process,
+       unlike on a power cycle, so clear the ones a fresh boot would. */
+    ESP_ERROR_CHECK(thermocouple_init(SPI2_HOST, PIN_TC_CS));
+    ESP_ERROR_CHECK(safety_init(PIN_SSR, APP_DEFAULT_MAX_SAFE_TEMP));
+    safety_init_io(PIN_ALARM, -1);
+    safety_clear_emergency();
+    safety_set_ssr(0.0f);
+    ESP_ERROR_CHECK(firing_engine_init());
+    firing_engine_reset_for_test();
+
+    kiln_settings_t settings;
+    firing_engine_get_settings(&settings);
+    safety_set_max_temp(settings.max_safe_temp);
+    safety_set_tc_offset(settings.tc_offset_c);
+
+    rtos_sim_set_task_cost("esp_timer", COST_ESP_TIMER_US);
+    rtos_sim_set_task_cost("safety", COST_SAFETY_US);
+    rtos_sim_set_task_cost("temp_read", COST_TEMP_READ_US);
+    rtos_sim_set_task_cost("firing", COST_FIRING_US);
+    rtos_sim_set_task_cost("notify", COST_NOTIFY_US);
+
+    if (cfg->ui_tasks) {
+        xTaskCreatePinnedToCore(display_task, "display", APP_TASK_DISPLAY_STACK, NULL, APP_TASK_DISPLAY_PRIO, NULL,
+                                0);
+        xTaskCreatePinnedToCore(notify_task, "notify", 6144, NULL, 1, NULL, 0);
+    }
+
+    xTaskCreatePinnedToCore(safety_task, "safety", APP_TASK_SAFETY_STACK, NULL, APP_TASK_SAFETY_PRIO, NULL, 1);
+    xTaskCreatePinnedToCore(temp_read_task, "temp_read", APP_TASK_TEMP_READ_STACK, NULL, APP_TASK_TEMP_READ_PRIO,
+                            NULL, 1);
+    xTaskCreatePinnedToCore(firing_task, "firing", APP_TASK_FIRING_STACK, NULL, APP_TASK_FIRING_PRIO, NULL, 1);
+
+    if (cfg->ui_tasks) {
+        xTaskCreatePinnedToCore(httpd_task, "httpd", 8192, NULL, APP_TASK_HTTPD_PRIO, &s_httpd_task, tskNO_AFFINITY);
+        xTaskCreatePinnedToCore(ws_broadcast_task, "ws_broadcast", 4096, NULL, 2, &s_ws_task, 0);
+        const esp_timer_create_args_t ws_timer_args = {
+            .callback = ws_timer_cb,
+            .name = "ws_broadcast",
+        };
+        ESP_ERROR_CHECK(esp_timer_create(&ws_timer_args, &s_ws_timer));
+        ESP_ERROR_CHECK(esp_timer_start_periodic(s_ws_timer, WS_PERIOD_US));
+    }
+}
+
+/* ── Test controls and probes ─────────────────────── */
+
+bool task_sim_post_cmd(const firing_cmd_t *cmd)
+{
+    if (!s_httpd_task) {
+        if (xQueueSend(firing_engine_get_cmd_queue(), cmd, 0) != pdTRUE) {
+            return false;
+        }
+        s_cmd_queued_us = rtos_sim_now();
+        return true;
+    }
+    if (s_mailbox_full) {
+        return false;
+    }
+    s_mailbox = *cmd;
+    s_mailbox_full = true;
+    xTaskNotifyGive(s_httpd_task);
+    return true;
+}
+
+int64_t task_sim_cmd_queued_us(void)
+{
+    return s_cmd_queued_us;
+}
+
+void task_sim_force_tc(float temp_c, uint8_t fault)
+{
+    s_tc_forced = true;
+    s_tc_forced_c = temp_c;
+    s_tc_forced_fault = fault;
+}
+
+void task_sim_release_tc(void)
+{
+    s_tc_forced = false;
+}
+
+int64_t task_sim_last_sample_us(void)
+{
+    return s_last_sample_us;
+}
+
+bool task_sim_ssr_on(void)
+{
+    return s_ssr_on;
+}
+
+int64_t task_sim_ssr_changed_us(void)
+{
+    return s_ssr_changed_us;
+}
+
+uint32_t task_sim_ssr_rising_edges(void)
+{
+    return s_ssr_rising;
+}
+
+uint32_t task_sim_alarm_tones(void)
+{
+    return s_alarm_tones;
+}
+
+const kiln_model_t *task_sim_kiln(void)
+{
+    kiln_catch_up();
+    return &s_kiln;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "firing_types.h"
+#include "kiln_model.h"
+#include "rtos_sim.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* The firmware's task set on rtos_sim: what app_main starts, in virtual time.
+ *
+ * The real safety_task, temp_read_task and firing_task run at their device
+ * priorities on core 1, reading the real MAX31855 decoder (thermocouple.c) and
+ * driving the real time-proportional SSR window (safety.c) through GPIO/SPI
+ * stand-ins wired to a kiln_model — the SSR pin level is the element duty.
+ * With `ui_tasks`, stand-ins for the core-0 tasks that contend for the same
+ * locks join them: display (LVGL loop + 500 ms dashboard refresh, each
+ * flushing a full screen over the SPI bus the MAX31855 shares),
+ * ws_broadcast (1 s status push), httpd (REST command handler) and notify
+ * (event queue → alarm). Their bodies call the same firing_engine /
+ * thermocouple getters as the device code and spend a modelled CPU cost in
+ * place of LVGL, cJSON and lwIP.
+ *
+ * Like firesim, this is process-global: one simulation at a time. */
+
+typedef struct {
+    const kiln_model_params_t *kiln; /* NULL = KILN_MODEL_SMALL_TEST */
+    float start_temp_c;
+    rtos_sim_config_t rtos;
+    bool ui_tasks;
+} task_sim_config_t;
+
+void task_sim_config_defaults(task_sim_config_t *cfg);
+
+/* Power-on: reset the scheduler, NVS and history, initialise the drivers and
+ * the engine the way app_main does, and create the tasks. Nothing runs until
+ * rtos_sim_run(). */
+void task_sim_boot(const task_sim_config_t *cfg);
+
+/* Hand `cmd` to the httpd stand-in, which queues it to firing_task as the
+ * REST handlers do (without `ui_tasks`, queue it directly). Returns false if a
+ * previous command is still waiting to be picked up. */
+bool task_sim_post_cmd(const firing_cmd_t *cmd);
+
+/* Virtual time at which the httpd stand-in last queued a command (-1 if it
+ * never has, or the queue stayed full for the whole 100 ms timeout). */
+int64_t task_sim_cmd_queued_us(void);
+
+/* Force every following MAX31855 frame to report `temp_c` (or, with a nonzero
+ * `fault`, the TC_FAULT_* bits) regardless of the kiln; release to go back to
+ * the model. */
+void task_sim_force_tc(float temp_c, uint8_t fault);
+void task_sim_release_tc(void);
+
+/* Virtual time of the most recent SPI thermocouple read (-1 before the first). */
+int64_t task_sim_last_sample_us(void);
+
+/* SSR pin level, time of its last edge and number of rising edges since boot. */
+bool task_sim_ssr_on(void);
+int64_t task_sim_ssr_changed_us(void);
+uint32_t task_sim_ssr_rising_edges(void);
+
+/* Alarm patterns started by safety_trigger_alarm (buzzer tone-on count). */
+uint32_t task_sim_alarm_tones(void);
+
+const kiln_model_t *task_sim_kiln(void);
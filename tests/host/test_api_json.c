@@ -10,8 +10,10 @@
  */
 #include "api_json.h"
 #include "cJSON.h"
+#include "cone_table.h"
 #include "firing_history.h"
 #include "firing_types.h"
+#include "heat_work.h"
 #include "thermocouple.h"
 #include "unity.h"
 
@@ -105,6 +107,8 @@ static void test_status_full_shape(void)
         .elapsed_time = 3600,
         .estimated_remaining = 7200,
         .status = FIRING_STATUS_HEATING,
+        .equiv_cone = CONE_018,
+        .kiln_load = 0.8333f,
     };
     strcpy(prog.profile_id, "bisque-cone-04");
 
@@ -133,8 +137,13 @@ static void test_status_full_shape(void)
     assert_number_field(root, "elapsedTime");
     assert_number_field(root, "estimatedTimeRemaining");
     assert_string_field(root, "status");
+    assert_number_field(root, "equivConeId");
+    assert_string_field(root, "equivCone");
+    assert_number_field(root, "kilnLoad");
 
+    TEST_ASSERT_EQUAL_FLOAT(0.83f, cJSON_GetObjectItem(root, "kilnLoad")->valuedouble);
     TEST_ASSERT_EQUAL_STRING("heating", cJSON_GetObjectItem(root, "status")->valuestring);
+    TEST_ASSERT_EQUAL_STRING("018", cJSON_GetObjectItem(root, "equivCone")->valuestring);
     TEST_ASSERT_EQUAL_STRING("bisque-cone-04", cJSON_GetObjectItem(root, "profileId")->valuestring);
 
     cJSON *tc_obj = cJSON_GetObjectItem(root, "thermocouple");
@@ -158,6 +167,7 @@ static void test_status_zeros_temp_when_fault(void)
         .fault = TC_FAULT_OPEN_CIRCUIT,
     };
     cJSON *root = build_status_json(&prog, &tc, 5.0f);
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(root, "equivCone")); /* only while a firing runs */
 
     /* Top-level currentTemp is zero-clamped on fault (UI shouldn't render the
      * stale last-read temp) — the offset is not applied through a fault. Inner
@@ -191,6 +201,7 @@ static firing_profile_t make_fixture_profile(void)
     p.segments[1].ramp_rate = 150.0f;
     p.segments[1].target_temp = 1060.0f;
     p.segments[1].hold_time = 10;
+    p.segments[1].end_cone = CONE_04 + 1;
     return p;
 }
 
@@ -218,11 +229,184 @@ static void test_profile_shape(void)
     assert_number_field(seg0, "holdTime");
     TEST_ASSERT_EQUAL_STRING("Water Smoke", cJSON_GetObjectItem(seg0, "name")->valuestring);
     TEST_ASSERT_EQUAL_FLOAT(80.0f, cJSON_GetObjectItem(seg0, "rampRate")->valuedouble);
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(seg0, "endConeId"));
+    TEST_ASSERT_EQUAL_INT(CONE_04, (int)cJSON_GetObjectItem(cJSON_GetArrayItem(segs, 1), "endConeId")->valuedouble);
 
     dump_fixture("profile", root);
     cJSON_Delete(root);
 }
 
+static void test_profile_from_json_roundtrips_builder_output(void)
+{
+    firing_profile_t p = make_fixture_profile();
+    cJSON *root = build_profile_json(&p);
+
+    firing_profile_t back;
+    TEST_ASSERT_TRUE(profile_from_json(root, &back));
+    cJSON_Delete(root);
+
+    TEST_ASSERT_EQUAL_STRING(p.id, back.id);
+    TEST_ASSERT_EQUAL_STRING(p.name, back.name);
+    TEST_ASSERT_EQUAL_UINT8(p.segment_count, back.segment_count);
+    TEST_ASSERT_EQUAL_UINT32(p.estimated_duration, back.estimated_duration);
+    for (int i = 0; i < p.segment_count; i++) {
+        TEST_ASSERT_EQUAL_STRING(p.segments[i].name, back.segments[i].name);
+        TEST_ASSERT_EQUAL_FLOAT(p.segments[i].ramp_rate, back.segments[i].ramp_rate);
+        TEST_ASSERT_EQUAL_FLOAT(p.segments[i].target_temp, back.segments[i].target_temp);
+        TEST_ASSERT_EQUAL_UINT16(p.segments[i].hold_time, back.segments[i].hold_time);
+        TEST_ASSERT_EQUAL_UINT8(p.segments[i].end_cone, back.segments[i].end_cone);
+    }
+}
+
+static void test_profile_from_json_flags_unknown_end_cone(void)
+{
+    cJSON *root = cJSON_Parse("{\"id\":\"x\",\"segments\":[{\"endConeId\":37},{\"endConeId\":-1},{}]}");
+    firing_profile_t back;
+    TEST_ASSERT_TRUE(profile_from_json(root, &back));
+    cJSON_Delete(root);
+    TEST_ASSERT_TRUE(back.segments[0].end_cone > CONE_COUNT);
+    TEST_ASSERT_TRUE(back.segments[1].end_cone > CONE_COUNT);
+    TEST_ASSERT_EQUAL_UINT8(0, back.segments[2].end_cone);
+}
+
+static void test_profile_from_json_requires_id(void)
+{
+    cJSON *root = cJSON_Parse("{\"name\":\"No Id\",\"segments\":[]}");
+    TEST_ASSERT_NOT_NULL(root);
+    firing_profile_t back;
+    TEST_ASSERT_FALSE(profile_from_json(root, &back));
+    cJSON_Delete(root);
+}
+
+/* ── Capability ──────────────────────────────────────────────────────────── */
+
+static void test_ramp_warnings_flag_ramps_past_the_curve(void)
+{
+    firing_profile_t p = make_fixture_profile();
+    kiln_cap_t cap = {0};
+    cJSON *none = build_ramp_warnings_json(&p, &cap);
+    TEST_ASSERT_TRUE(cJSON_IsArray(none));
+    TEST_ASSERT_EQUAL_INT(0, cJSON_GetArraySize(none));
+    cJSON_Delete(none);
+
+    /* 200 °C/h everywhere except 120 from 1000 °C: the 150 °C/h finish can't
+       be held over its last 60 °C; the 80 °C/h water smoke is fine. */
+    for (int b = 0; b < KILN_CAP_BINS; b++) {
+        cap.rate_ch[b] = b >= 1000 / KILN_CAP_BIN_C ? 120 : 200;
+    }
+    cJSON *arr = build_ramp_warnings_json(&p, &cap);
+    TEST_ASSERT_EQUAL_INT(1, cJSON_GetArraySize(arr));
+    cJSON *w = cJSON_GetArrayItem(arr, 0);
+    TEST_ASSERT_EQUAL_INT(1, (int)cJSON_GetObjectItem(w, "segment")->valuedouble);
+    TEST_ASSERT_EQUAL_FLOAT(1000.0f, cJSON_GetObjectItem(w, "aboveTemp")->valuedouble);
+    TEST_ASSERT_EQUAL_FLOAT(150.0f, cJSON_GetObjectItem(w, "rampRate")->valuedouble);
+    TEST_ASSERT_EQUAL_FLOAT(120.0f, cJSON_GetObjectItem(w, "maxRate")->valuedouble);
+    cJSON_Delete(arr);
+}
+
+static void test_capability_lists_learned_bins_only(void)
+{
+    kiln_cap_t cap = {0};
+    cap.rate_ch[2] = 480;
+    cap.firings[2] = 3;
+    cap.rate_ch[24] = 95;
+    cap.firings[24] = 1;
+    cJSON *arr = build_capability_json(&cap);
+    TEST_ASSERT_EQUAL_INT(2, cJSON_GetArraySize(arr));
+    cJSON *hot = cJSON_GetArrayItem(arr, 1);
+    assert_number_field(hot, "fromTemp");
+    assert_number_field(hot, "maxRate");
+    assert_number_field(hot, "firings");
+    TEST_ASSERT_EQUAL_FLOAT(24 * KILN_CAP_BIN_C, cJSON_GetObjectItem(hot, "fromTemp")->valuedouble);
+    TEST_ASSERT_EQUAL_FLOAT(95.0f, cJSON_GetObjectItem(hot, "maxRate")->valuedouble);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, cJSON_GetObjectItem(hot, "firings")->valuedouble);
+    cJSON_Delete(arr);
+}
+
+/* ── profile optimizer request / response ────────────────────────────────── */
+
+static void test_optimize_limits_overlay_the_defaults(void)
+{
+    profile_opt_limits_t lim = {.start_temp_c = 20.0f, .zone_count = 2};
+    cJSON *root = cJSON_Parse("{\"startTemp\":150,\"minHolds\":[{\"temp\":1222,\"minutes\":10}]}");
+    TEST_ASSERT_TRUE(profile_opt_limits_from_json(root, &lim));
+    TEST_ASSERT_EQUAL_FLOAT(150.0f, lim.start_temp_c);
+    TEST_ASSERT_EQUAL_INT(2, lim.zone_count); /* untouched without a zones key */
+    TEST_ASSERT_EQUAL_INT(1, lim.hold_count);
+    TEST_ASSERT_EQUAL_UINT16(10, lim.holds[0].minutes);
+    cJSON_Delete(root);
+
+    root = cJSON_Parse("{\"maxRate\":250,\"zones\":[{\"from\":540,\"to\":600,\"maxRate\":50}]}");
+    TEST_ASSERT_TRUE(profile_opt_limits_from_json(root, &lim));
+    TEST_ASSERT_EQUAL_FLOAT(250.0f, lim.max_rate_ch);
+    TEST_ASSERT_EQUAL_INT(1, lim.zone_count);
+    TEST_ASSERT_EQUAL_FLOAT(50.0f, lim.zones[0].max_rate_ch);
+    cJSON_Delete(root);
+
+    const char *bad[] = {
+        "{\"zones\":[{\"from\":600,\"to\":540,\"maxRate\":50}]}",
+        "{\"zones\":[{\"from\":540,\"to\":600,\"maxRate\":0}]}",
+        "{\"zones\":[{\"from\":540,\"to\":600}]}",
+        "{\"minHolds\":[{\"temp\":1222,\"minutes\":65535}]}",
+        "{\"maxRate\":-5}",
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        root = cJSON_Parse(bad[i]);
+        TEST_ASSERT_FALSE_MESSAGE(profile_opt_limits_from_json(root, &lim), bad[i]);
+        cJSON_Delete(root);
+    }
+}
+
+static void test_plan_reports_energy_only_with_element_power(void)
+{
+    profile_plan_t plan = {.duration_s = 36000, .on_s = 18000.0f};
+    cJSON *root = build_plan_json(&plan, 0.0f);
+    assert_number_field(root, "durationS");
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(root, "energyKwh"));
+    cJSON_Delete(root);
+
+    root = build_plan_json(&plan, 9600.0f);
+    TEST_ASSERT_EQUAL_FLOAT(48.0f, cJSON_GetObjectItem(root, "energyKwh")->valuedouble);
+    cJSON_Delete(root);
+}
+
+static void test_sim_reports_curve_pairs_and_cost_when_configured(void)
+{
+    static firing_sim_result_t sim;
+    memset(&sim, 0, sizeof(sim));
+    sim.outcome = FIRING_SIM_WAITS;
+    sim.segment = 2;
+    sim.duration_s = 600;
+    sim.on_s = 300.0f;
+    sim.peak_temp_c = 612.345f;
+    sim.equiv_cone = HEAT_WORK_NO_CONE;
+    sim.point_every_s = 300;
+    sim.points[sim.point_count++] = (firing_sim_point_t){.t_s = 0, .temp_c = 20.0f};
+    sim.points[sim.point_count++] = (firing_sim_point_t){.t_s = 300, .temp_c = 315.56f};
+    sim.points[sim.point_count++] = (firing_sim_point_t){.t_s = 600, .temp_c = 612.345f};
+
+    cJSON *root = build_sim_json(&sim, 0.0f, 0.2f);
+    TEST_ASSERT_EQUAL_STRING("waits", cJSON_GetObjectItem(root, "outcome")->valuestring);
+    TEST_ASSERT_EQUAL_FLOAT(612.3f, cJSON_GetObjectItem(root, "peakTemp")->valuedouble);
+    assert_number_field(root, "maxLag");
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(root, "equivCone"));
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(root, "energyKwh"));
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(root, "cost"));
+    cJSON *curve = cJSON_GetObjectItem(root, "curve");
+    TEST_ASSERT_EQUAL_INT(3, cJSON_GetArraySize(curve));
+    cJSON *pt = cJSON_GetArrayItem(curve, 1);
+    TEST_ASSERT_EQUAL_INT(300, cJSON_GetArrayItem(pt, 0)->valueint);
+    TEST_ASSERT_EQUAL_FLOAT(315.6f, cJSON_GetArrayItem(pt, 1)->valuedouble);
+    cJSON_Delete(root);
+
+    sim.equiv_cone = CONE_04;
+    root = build_sim_json(&sim, 9600.0f, 0.25f);
+    TEST_ASSERT_EQUAL_STRING("04", cJSON_GetObjectItem(root, "equivCone")->valuestring);
+    TEST_ASSERT_EQUAL_FLOAT(0.8f, cJSON_GetObjectItem(root, "energyKwh")->valuedouble);
+    TEST_ASSERT_EQUAL_FLOAT(0.2f, cJSON_GetObjectItem(root, "cost")->valuedouble);
+    cJSON_Delete(root);
+}
+
 /* ── build_settings_json ─────────────────────────────────────────────────── */
 
 static void test_settings_shape_redacts_token(void)
@@ -236,6 +420,8 @@ static void test_settings_shape_redacts_token(void)
         .tc_offset_c = -2.5f,
         .element_watts = 2400.0f,
         .electricity_cost_kwh = 0.18f,
+        .tariff_count = 2,
+        .tariff = {{.start_min = 7 * 60, .cost_kwh = 0.3f}, {.start_min = 22 * 60, .cost_kwh = 0.1f}},
     };
     strcpy(s.webhook_url, "https://example.test/kiln");
     strcpy(s.api_token, "super-secret-token");
@@ -260,6 +446,12 @@ static void test_settings_shape_redacts_token(void)
     TEST_ASSERT_EQUAL_STRING("C", cJSON_GetObjectItem(root, "tempUnit")->valuestring);
     TEST_ASSERT_EQUAL_FLOAT(-2.5f, cJSON_GetObjectItem(root, "tcOffsetC")->valuedouble);
 
+    const cJSON *tariff = cJSON_GetObjectItem(root, "tariff");
+    TEST_ASSERT_EQUAL_INT(2, cJSON_GetArraySize(tariff));
+    const cJSON *night = cJSON_GetArrayItem(tariff, 1);
+    TEST_ASSERT_EQUAL_INT(22 * 60, cJSON_GetObjectItem(night, "startMin")->valueint);
+    TEST_ASSERT_EQUAL_FLOAT(0.1f, cJSON_GetObjectItem(night, "costKwh")->valuedouble);
+
     dump_fixture("settings", root);
     cJSON_Delete(root);
 }
@@ -272,6 +464,55 @@ static void test_settings_apiTokenSet_false_when_empty(void)
     cJSON_Delete(root);
 }
 
+static void test_tariff_from_json_sorts_bands_and_rejects_clashes(void)
+{
+    kiln_settings_t s = {0};
+    cJSON *arr = cJSON_Parse("[{\"startMin\":1320,\"costKwh\":0.1},{\"startMin\":420,\"costKwh\":0.3}]");
+    TEST_ASSERT_TRUE(tariff_from_json(arr, &s));
+    TEST_ASSERT_EQUAL_UINT8(2, s.tariff_count);
+    TEST_ASSERT_EQUAL_UINT16(420, s.tariff[0].start_min);
+    TEST_ASSERT_EQUAL_FLOAT(0.1f, s.tariff[1].cost_kwh);
+    cJSON_Delete(arr);
+
+    const char *bad[] = {
+        "[{\"startMin\":420,\"costKwh\":0.3},{\"startMin\":420,\"costKwh\":0.1}]",
+        "[{\"startMin\":1440,\"costKwh\":0.3}]",
+        "[{\"startMin\":60.5,\"costKwh\":0.3}]",
+        "[{\"startMin\":60,\"costKwh\":-0.3}]",
+        "[{\"startMin\":60}]",
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        arr = cJSON_Parse(bad[i]);
+        TEST_ASSERT_FALSE_MESSAGE(tariff_from_json(arr, &s), bad[i]);
+        cJSON_Delete(arr);
+    }
+    TEST_ASSERT_EQUAL_UINT8(2, s.tariff_count); /* a rejected table leaves the old one */
+
+    arr = cJSON_CreateArray();
+    TEST_ASSERT_TRUE(tariff_from_json(arr, &s));
+    TEST_ASSERT_EQUAL_UINT8(0, s.tariff_count);
+    cJSON_Delete(arr);
+}
+
+/* ── build_schedule_json ─────────────────────────────────────────────────── */
+
+static void test_schedule_reports_savings_from_rounded_costs(void)
+{
+    firing_sim_result_t sim = {.duration_s = 36000, .on_s = 18000.0f};
+    tariff_plan_t plan = {.start_s = 1800000000, .cost = 1.004, .earliest_cost = 2.496};
+    cJSON *root = build_schedule_json(&plan, &sim, 4000.0f, 95, true);
+
+    TEST_ASSERT_EQUAL_INT64(1800000000, (int64_t)cJSON_GetObjectItem(root, "startAt")->valuedouble);
+    TEST_ASSERT_EQUAL_INT(95, cJSON_GetObjectItem(root, "delayMinutes")->valueint);
+    TEST_ASSERT_EQUAL_INT64(1800036000, (int64_t)cJSON_GetObjectItem(root, "finishAt")->valuedouble);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, cJSON_GetObjectItem(root, "energyKwh")->valuedouble);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, cJSON_GetObjectItem(root, "cost")->valuedouble);
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, cJSON_GetObjectItem(root, "earliestCost")->valuedouble);
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, cJSON_GetObjectItem(root, "savings")->valuedouble);
+    TEST_ASSERT_TRUE(cJSON_IsTrue(cJSON_GetObjectItem(root, "armed")));
+    cJSON_Delete(root);
+}
+
 /* ── build_history_record_json ───────────────────────────────────────────── */
 
 static void test_history_record_shape(void)
@@ -324,6 +565,60 @@ static void test_history_outcome_strings(void)
     }
 }
 
+/* ── build_history_event_json ────────────────────────────────────────────── */
+
+static void test_history_event_shape(void)
+{
+    history_event_t evt = {
+        .t_s = 5400,
+        .kind = HISTORY_EVT_SEGMENT,
+        .source = FIRING_SRC_LCD,
+        .arg = 2,
+        .temp_c = 612.0f,
+    };
+    cJSON *root = build_history_event_json(&evt);
+
+    assert_number_field(root, "t");
+    assert_string_field(root, "type");
+    assert_string_field(root, "source");
+    assert_number_field(root, "temp");
+    assert_number_field(root, "segment");
+    TEST_ASSERT_EQUAL_STRING("segment", cJSON_GetObjectItem(root, "type")->valuestring);
+    TEST_ASSERT_EQUAL_STRING("lcd", cJSON_GetObjectItem(root, "source")->valuestring);
+
+    dump_fixture("history_event", root);
+    cJSON_Delete(root);
+}
+
+static void test_history_event_arguments(void)
+{
+    history_event_t evt = {.kind = HISTORY_EVT_PAUSE, .arg = 7};
+    cJSON *root = build_history_event_json(&evt);
+    TEST_ASSERT_EQUAL_STRING("engine", cJSON_GetObjectItem(root, "source")->valuestring);
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(root, "segment"));
+    cJSON_Delete(root);
+
+    evt = (history_event_t){.kind = HISTORY_EVT_TRIP, .arg = 3};
+    root = build_history_event_json(&evt);
+    TEST_ASSERT_EQUAL_INT(3, (int)cJSON_GetObjectItem(root, "errorCode")->valuedouble);
+    cJSON_Delete(root);
+
+    evt = (history_event_t){.kind = HISTORY_EVT_SETTINGS, .arg = HISTORY_SETTING_MAX_TEMP | HISTORY_SETTING_OTHER};
+    root = build_history_event_json(&evt);
+    cJSON *changed = cJSON_GetObjectItem(root, "changed");
+    TEST_ASSERT_EQUAL_INT(2, cJSON_GetArraySize(changed));
+    TEST_ASSERT_EQUAL_STRING("maxTemp", cJSON_GetArrayItem(changed, 0)->valuestring);
+    TEST_ASSERT_EQUAL_STRING("other", cJSON_GetArrayItem(changed, 1)->valuestring);
+    cJSON_Delete(root);
+
+    evt = (history_event_t){.kind = HISTORY_EVT_CONE, .arg = CONE_6};
+    root = build_history_event_json(&evt);
+    TEST_ASSERT_EQUAL_STRING("cone", cJSON_GetObjectItem(root, "type")->valuestring);
+    TEST_ASSERT_EQUAL_INT(CONE_6, (int)cJSON_GetObjectItem(root, "coneId")->valuedouble);
+    TEST_ASSERT_EQUAL_STRING("6", cJSON_GetObjectItem(root, "cone")->valuestring);
+    cJSON_Delete(root);
+}
+
 /* ── build_cone_table_json ───────────────────────────────────────────────── */
 
 static void test_cone_table_shape(void)
@@ -401,7 +696,16 @@ static void test_thermocouple_diag_shape(void)
         .fault = TC_FAULT_SHORT_GND,
         .timestamp_us = 100,
     };
-    cJSON *root = build_thermocouple_diag_json(&tc, 250, -1.5f);
+    thermocouple_timing_t timing = {
+        .reads = 40,
+        .bus_waits = 3,
+        .max_bus_wait_us = 1800,
+        .max_read_us = 2100,
+        .intervals = 39,
+        .max_jitter_us = 4000,
+        .total_jitter_us = 39 * 1500 + 10,
+    };
+    cJSON *root = build_thermocouple_diag_json(&tc, 250, -1.5f, &timing);
 
     assert_number_field(root, "temperatureC");
     assert_number_field(root, "internalTempC");
@@ -418,6 +722,20 @@ static void test_thermocouple_diag_shape(void)
     TEST_ASSERT_EQUAL_FLOAT(498.5f, cJSON_GetObjectItem(root, "temperatureAdjustedC")->valuedouble);
     TEST_ASSERT_EQUAL_FLOAT(-1.5f, cJSON_GetObjectItem(root, "tcOffsetC")->valuedouble);
 
+    cJSON *t = cJSON_GetObjectItem(root, "timing");
+    TEST_ASSERT_TRUE(cJSON_IsObject(t));
+    assert_number_field(t, "reads");
+    assert_number_field(t, "busWaits");
+    assert_number_field(t, "maxBusWaitUs");
+    assert_number_field(t, "maxReadUs");
+    assert_number_field(t, "intervals");
+    assert_number_field(t, "maxJitterUs");
+    assert_number_field(t, "meanJitterUs");
+    TEST_ASSERT_EQUAL_INT(3, cJSON_GetObjectItem(t, "busWaits")->valueint);
+    TEST_ASSERT_EQUAL_INT(2100, cJSON_GetObjectItem(t, "maxReadUs")->valueint);
+    TEST_ASSERT_EQUAL_INT(4000, cJSON_GetObjectItem(t, "maxJitterUs")->valueint);
+    TEST_ASSERT_EQUAL_INT(1500, cJSON_GetObjectItem(t, "meanJitterUs")->valueint);
+
     dump_fixture("thermocouple_diag", root);
     cJSON_Delete(root);
 }
@@ -443,10 +761,22 @@ int main(void)
     RUN_TEST(test_status_full_shape);
     RUN_TEST(test_status_zeros_temp_when_fault);
     RUN_TEST(test_profile_shape);
+    RUN_TEST(test_profile_from_json_roundtrips_builder_output);
+    RUN_TEST(test_profile_from_json_flags_unknown_end_cone);
+    RUN_TEST(test_profile_from_json_requires_id);
+    RUN_TEST(test_ramp_warnings_flag_ramps_past_the_curve);
+    RUN_TEST(test_capability_lists_learned_bins_only);
+    RUN_TEST(test_optimize_limits_overlay_the_defaults);
+    RUN_TEST(test_plan_reports_energy_only_with_element_power);
+    RUN_TEST(test_sim_reports_curve_pairs_and_cost_when_configured);
     RUN_TEST(test_settings_shape_redacts_token);
     RUN_TEST(test_settings_apiTokenSet_false_when_empty);
+    RUN_TEST(test_tariff_from_json_sorts_bands_and_rejects_clashes);
+    RUN_TEST(test_schedule_reports_savings_from_rounded_costs);
     RUN_TEST(test_history_record_shape);
     RUN_TEST(test_history_outcome_strings);
+    RUN_TEST(test_history_event_shape);
+    RUN_TEST(test_history_event_arguments);
     RUN_TEST(test_cone_table_shape);
     RUN_TEST(test_autotune_status_idle);
     RUN_TEST(test_autotune_status_running_vs_stopped);
@@ -0,0 +1,217 @@
+#include "firesim.h"
+#include "firing_engine.h"
+#include "unity.h"
+
+#include <math.h>
+#include <string.h>
+
+static firesim_config_t g_cfg;
+
+/* 25 → 300 °C at 300 °C/hr, 10 min hold, then up to 500 °C: ~1.5 h on the
+ * small kiln, well inside what it can follow. */
+static firing_profile_t short_profile(void)
+{
+    firing_profile_t p = {0};
+    strncpy(p.id, "firesim", FIRING_ID_LEN - 1);
+    strncpy(p.name, "Firesim", FIRING_NAME_LEN - 1);
+    p.segment_count = 2;
+    p.max_temp = 500.0f;
+    p.segments[0].ramp_rate = 300.0f;
+    p.segments[0].target_temp = 300.0f;
+    p.segments[0].hold_time = 10;
+    p.segments[1].ramp_rate = 200.0f;
+    p.segments[1].target_temp = 500.0f;
+    p.segments[1].hold_time = 0;
+    return p;
+}
+
+void setUp(void)
+{
+    firesim_config_defaults(&g_cfg);
+    g_cfg.profile = short_profile();
+    g_cfg.max_s = 6 * 3600;
+}
+
+void tearDown(void)
+{
+}
+
+static void add_fault(const char *spec)
+{
+    TEST_ASSERT_TRUE_MESSAGE(firesim_parse_fault(spec, &g_cfg.faults[g_cfg.fault_count]), spec);
+    g_cfg.fault_count++;
+}
+
+/* ── Fault spec parsing ──────────────────────────────────────────────── */
+
+static void test_parse_fault_accepts_documented_forms(void)
+{
+    firesim_fault_t f;
+    TEST_ASSERT_TRUE(firesim_parse_fault("tc-open@3h+30s", &f));
+    TEST_ASSERT_EQUAL(FIRESIM_FAULT_TC_OPEN, f.kind);
+    TEST_ASSERT_EQUAL_UINT32(3 * 3600, f.at_s);
+    TEST_ASSERT_EQUAL_UINT32(30, f.duration_s);
+
+    TEST_ASSERT_TRUE(firesim_parse_fault("elements@0=0.8", &f));
+    TEST_ASSERT_EQUAL(FIRESIM_FAULT_ELEMENTS, f.kind);
+    TEST_ASSERT_EQUAL_FLOAT(0.8f, f.value);
+
+    TEST_ASSERT_TRUE(firesim_parse_fault("pause@2.5h+30m", &f));
+    TEST_ASSERT_EQUAL_UINT32(9000, f.at_s);
+    TEST_ASSERT_EQUAL_UINT32(1800, f.duration_s);
+
+    TEST_ASSERT_TRUE(firesim_parse_fault("tc-spike@5000+10=-40", &f));
+    TEST_ASSERT_EQUAL_FLOAT(-40.0f, f.value);
+    TEST_ASSERT_TRUE(firesim_parse_fault("skip@90m", &f));
+    TEST_ASSERT_TRUE(firesim_parse_fault("stop@120", &f));
+}
+
+static void test_parse_fault_rejects_malformed_specs(void)
+{
+    firesim_fault_t f;
+    TEST_ASSERT_FALSE(firesim_parse_fault("tc-open", &f));            /* no time */
+    TEST_ASSERT_FALSE(firesim_parse_fault("meltdown@10", &f));        /* unknown kind */
+    TEST_ASSERT_FALSE(firesim_parse_fault("tc-open@10x", &f));        /* trailing junk */
+    TEST_ASSERT_FALSE(firesim_parse_fault("tc-spike@10", &f));        /* spike needs a value */
+    TEST_ASSERT_FALSE(firesim_parse_fault("elements@0=1.5", &f));     /* health out of range */
+    TEST_ASSERT_FALSE(firesim_parse_fault("pause@10", &f));           /* pause needs a duration */
+    TEST_ASSERT_FALSE(firesim_parse_fault("tc-open@-5", &f));         /* negative time */
+    TEST_ASSERT_FALSE(firesim_parse_fault(NULL, &f));
+}
+
+/* ── Whole firings ───────────────────────────────────────────────────── */
+
+static void test_clean_run_completes_with_consistent_kpis(void)
+{
+    firesim_result_t r;
+    TEST_ASSERT_TRUE(firesim_run(&g_cfg, NULL, NULL, &r));
+    TEST_ASSERT_EQUAL(FIRING_STATUS_COMPLETE, r.final_status);
+    TEST_ASSERT_EQUAL(FIRING_ERR_NONE, r.error_code);
+    TEST_ASSERT_FALSE(r.timed_out);
+    TEST_ASSERT_TRUE(r.peak_c > 480.0f);
+    TEST_ASSERT_TRUE(r.energy_kwh > 0.0);
+    TEST_ASSERT_TRUE(isfinite(r.rms_error_c));
+
+    /* Every firing second is attributed to exactly one segment. */
+    uint32_t seg_s = 0;
+    double seg_kwh = 0.0;
+    for (int i = 0; i < r.segment_count; i++) {
+        seg_s += r.segments[i].time_s;
+        seg_kwh += r.segments[i].energy_kwh;
+    }
+    TEST_ASSERT_UINT32_WITHIN(2, r.total_s, seg_s);
+    TEST_ASSERT_TRUE(fabs(seg_kwh - r.energy_kwh) < 0.01);
+}
+
+static void test_long_tc_open_trips_tc_fault(void)
+{
+    add_fault("tc-open@30m+30s");
+    firesim_result_t r;
+    TEST_ASSERT_FALSE(firesim_run(&g_cfg, NULL, NULL, &r));
+    TEST_ASSERT_EQUAL(FIRING_STATUS_ERROR, r.final_status);
+    TEST_ASSERT_EQUAL(FIRING_ERR_TC_FAULT, r.error_code);
+    /* Tripped a few seconds past the 5 s window, not at the end of the fault. */
+    TEST_ASSERT_UINT32_WITHIN(10, 30 * 60 + 6, r.total_s);
+}
+
+static void test_brief_tc_glitch_rides_through(void)
+{
+    add_fault("tc-open@30m+3s");
+    firesim_result_t r;
+    TEST_ASSERT_TRUE(firesim_run(&g_cfg, NULL, NULL, &r));
+    TEST_ASSERT_EQUAL(FIRING_ERR_NONE, r.error_code);
+}
+
+/* Trace callback: counts paused seconds and any that drew power. */
+typedef struct {
+    uint32_t paused_s;
+    uint32_t paused_powered_s;
+} pause_watch_t;
+
+static void watch_pause(const firesim_sample_t *s, void *ctx)
+{
+    pause_watch_t *w = ctx;
+    if (s->status == FIRING_STATUS_PAUSED) {
+        w->paused_s++;
+        if (s->duty > 0.0f) {
+            w->paused_powered_s++;
+        }
+    }
+}
+
+static void test_pause_extends_firing_without_energy(void)
+{
+    firesim_result_t base;
+    TEST_ASSERT_TRUE(firesim_run(&g_cfg, NULL, NULL, &base));
+
+    add_fault("pause@20m+15m");
+    firesim_result_t r;
+    pause_watch_t w = {0};
+    TEST_ASSERT_TRUE(firesim_run(&g_cfg, watch_pause, &w, &r));
+    TEST_ASSERT_UINT32_WITHIN(1, 15 * 60, w.paused_s);
+    TEST_ASSERT_EQUAL_UINT32(0, w.paused_powered_s);
+    /* At least the pause itself, plus reheating what was lost during it. */
+    TEST_ASSERT_TRUE(r.total_s >= base.total_s + 15 * 60 - 60);
+}
+
+static void test_degraded_elements_slow_the_firing(void)
+{
+    firesim_result_t base;
+    TEST_ASSERT_TRUE(firesim_run(&g_cfg, NULL, NULL, &base));
+
+    /* 35% power cannot hold 300 °C/hr, so the engine waits at each target. */
+    add_fault("elements@0=0.35");
+    firesim_result_t r;
+    firesim_run(&g_cfg, NULL, NULL, &r);
+    TEST_ASSERT_TRUE(r.total_s > base.total_s);
+    TEST_ASSERT_TRUE(r.rms_error_c > base.rms_error_c);
+}
+
+static void test_stop_aborts(void)
+{
+    add_fault("stop@15m");
+    firesim_result_t r;
+    TEST_ASSERT_FALSE(firesim_run(&g_cfg, NULL, NULL, &r));
+    TEST_ASSERT_EQUAL(FIRING_STATUS_IDLE, r.final_status);
+    TEST_ASSERT_FALSE(r.timed_out);
+    TEST_ASSERT_UINT32_WITHIN(2, 15 * 60, r.total_s);
+}
+
+static void test_time_cap_reports_timeout(void)
+{
+    g_cfg.max_s = 600;
+    firesim_result_t r;
+    TEST_ASSERT_FALSE(firesim_run(&g_cfg, NULL, NULL, &r));
+    TEST_ASSERT_TRUE(r.timed_out);
+    TEST_ASSERT_EQUAL(FIRING_STATUS_HEATING, r.final_status);
+    TEST_ASSERT_EQUAL_UINT32(600, r.total_s);
+}
+
+static void count_samples(const firesim_sample_t *s, void *ctx)
+{
+    (*(uint32_t *)ctx)++;
+}
+
+static void test_trace_gets_one_sample_per_second(void)
+{
+    uint32_t n = 0;
+    firesim_result_t r;
+    firesim_run(&g_cfg, count_samples, &n, &r);
+    TEST_ASSERT_EQUAL_UINT32(r.total_s, n);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_parse_fault_accepts_documented_forms);
+    RUN_TEST(test_parse_fault_rejects_malformed_specs);
+    RUN_TEST(test_clean_run_completes_with_consistent_kpis);
+    RUN_TEST(test_long_tc_open_trips_tc_fault);
+    RUN_TEST(test_brief_tc_glitch_rides_through);
+    RUN_TEST(test_pause_extends_firing_without_energy);
+    RUN_TEST(test_degraded_elements_slow_the_firing);
+    RUN_TEST(test_stop_aborts);
+    RUN_TEST(test_time_cap_reports_timeout);
+    RUN_TEST(test_trace_gets_one_sample_per_second);
+    return UNITY_END();
+}
@@ -0,0 +1,234 @@
+#include "app_config.h"
+#include "firesim_mc.h"
+#include "unity.h"
+
+#include <string.h>
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/* ── Generation ──────────────────────────────────────────────────────── */
+
+static void test_generate_is_deterministic_per_seed_and_index(void)
+{
+    firesim_config_t a, b;
+    firesim_mc_generate(42, 7, &a);
+    firesim_mc_generate(42, 7, &b);
+    TEST_ASSERT_EQUAL_MEMORY(&a, &b, sizeof(a));
+
+    firesim_mc_generate(42, 8, &b);
+    TEST_ASSERT_FALSE(memcmp(&a, &b, sizeof(a)) == 0);
+    firesim_mc_generate(43, 7, &b);
+    TEST_ASSERT_FALSE(memcmp(&a, &b, sizeof(a)) == 0);
+}
+
+static void test_generated_scenarios_are_well_formed(void)
+{
+    int with_faults = 0;
+    for (uint32_t i = 0; i < 500; i++) {
+        firesim_config_t cfg;
+        firesim_mc_generate(1, i, &cfg);
+        const firing_profile_t *p = &cfg.profile;
+        TEST_ASSERT_TRUE(p->segment_count >= 1 && p->segment_count <= FIRING_MAX_SEGMENTS);
+        TEST_ASSERT_TRUE(p->id[0] != '\0');
+        TEST_ASSERT_TRUE(p->segments[0].ramp_rate > 0.0f);
+        TEST_ASSERT_TRUE(p->segments[0].target_temp > cfg.start_temp_c);
+        TEST_ASSERT_TRUE(p->max_temp <= APP_HARDWARE_MAX_TEMP_C);
+        TEST_ASSERT_TRUE(cfg.max_s > 3600);
+        TEST_ASSERT_TRUE(cfg.fault_count <= FIRESIM_MC_MAX_FAULTS);
+        with_faults += cfg.fault_count > 0;
+
+        /* Every generated fault survives a format/parse round trip, which is
+           what the printed reproducer commands rely on. */
+        for (int f = 0; f < cfg.fault_count; f++) {
+            char spec[64];
+            firesim_fault_t back;
+            firesim_format_fault(&cfg.faults[f], spec, sizeof(spec));
+            TEST_ASSERT_TRUE_MESSAGE(firesim_parse_fault(spec, &back), spec);
+            TEST_ASSERT_EQUAL(cfg.faults[f].kind, back.kind);
+            TEST_ASSERT_EQUAL_UINT32(cfg.faults[f].at_s, back.at_s);
+        }
+    }
+    TEST_ASSERT_TRUE(with_faults > 250);
+}
+
+/* ── Invariant checker, on synthetic samples ─────────────────────────── */
+
+static firesim_config_t g_cfg;
+static firesim_mc_checker_t g_chk;
+static uint32_t g_t;
+
+static void checker_reset(void)
+{
+    firesim_config_defaults(&g_cfg);
+    g_cfg.profile.segment_count = 2;
+    g_cfg.profile.segments[0].ramp_rate = 100.0f;
+    g_cfg.profile.segments[0].target_temp = 600.0f;
+    g_cfg.profile.segments[1].ramp_rate = 100.0f;
+    g_cfg.profile.segments[1].target_temp = 900.0f;
+    firesim_mc_checker_init(&g_chk, &g_cfg);
+    g_t = 0;
+}
+
+static void feed(firing_status_t status, uint8_t segment, float setpoint, float tc, bool tc_fault, float duty)
+{
+    firesim_sample_t s = {
+        .t_s = ++g_t,
+        .status = status,
+        .segment = segment,
+        .setpoint_c = setpoint,
+        .tc_c = tc,
+        .tc_fault = tc_fault,
+        .duty = duty,
+    };
+    firesim_mc_observe(&s, &g_chk);
+}
+
+static void test_checker_passes_a_normal_run(void)
+{
+    checker_reset();
+    for (int i = 0; i < 100; i++) {
+        feed(FIRING_STATUS_HEATING, i < 50 ? 0 : 1, 100.0f + i, 99.0f + i, false, 0.6f);
+    }
+    feed(FIRING_STATUS_COMPLETE, 1, 900.0f, 900.0f, false, 0.0f);
+    firesim_result_t r = {0};
+    TEST_ASSERT_EQUAL(FIRESIM_MC_OK, firesim_mc_finish(&g_chk, &r));
+}
+
+static void test_checker_flags_ssr_on_while_paused(void)
+{
+    checker_reset();
+    feed(FIRING_STATUS_HEATING, 0, 100.0f, 100.0f, false, 0.5f);
+    feed(FIRING_STATUS_PAUSED, 0, 100.0f, 100.0f, false, 0.5f);
+    TEST_ASSERT_EQUAL(FIRESIM_MC_SSR_WHILE_NOT_FIRING, g_chk.violation);
+    TEST_ASSERT_EQUAL_UINT32(2, g_chk.violation_t_s);
+}
+
+static void test_checker_allows_tc_timeout_then_flags_missed_trip(void)
+{
+    checker_reset();
+    int grace = APP_TEMP_FAULT_TIMEOUT_MS / 1000 + 3;
+    for (int i = 0; i < grace; i++) {
+        feed(FIRING_STATUS_HEATING, 0, 200.0f, 0.0f, true, 0.5f);
+    }
+    TEST_ASSERT_EQUAL(FIRESIM_MC_OK, g_chk.violation);
+    feed(FIRING_STATUS_HEATING, 0, 200.0f, 0.0f, true, 0.5f);
+    TEST_ASSERT_EQUAL(FIRESIM_MC_MISSED_TC_TRIP, g_chk.violation);
+}
+
+static void test_checker_flags_missed_over_temp_trip(void)
+{
+    checker_reset();
+    feed(FIRING_STATUS_HOLDING, 1, 900.0f, g_cfg.max_safe_temp_c + 5.0f, false, 0.1f);
+    feed(FIRING_STATUS_HOLDING, 1, 900.0f, g_cfg.max_safe_temp_c + 5.0f, false, 0.1f);
+    TEST_ASSERT_EQUAL(FIRESIM_MC_OK, g_chk.violation);
+    feed(FIRING_STATUS_HOLDING, 1, 900.0f, g_cfg.max_safe_temp_c + 5.0f, false, 0.1f);
+    TEST_ASSERT_EQUAL(FIRESIM_MC_MISSED_OVERTEMP_TRIP, g_chk.violation);
+}
+
+static void test_checker_flags_setpoint_and_segment_regressions(void)
+{
+    checker_reset();
+    feed(FIRING_STATUS_HEATING, 0, 950.0f, 500.0f, false, 1.0f);
+    TEST_ASSERT_EQUAL(FIRESIM_MC_SETPOINT_OUT_OF_RANGE, g_chk.violation);
+
+    checker_reset();
+    feed(FIRING_STATUS_HEATING, 1, 700.0f, 700.0f, false, 1.0f);
+    feed(FIRING_STATUS_HEATING, 0, 700.0f, 700.0f, false, 1.0f);
+    TEST_ASSERT_EQUAL(FIRESIM_MC_SEGMENT_REGRESSED, g_chk.violation);
+}
+
+static void test_checker_flags_timeout_as_stall(void)
+{
+    checker_reset();
+    firesim_result_t r = {.timed_out = true, .total_s = 1234};
+    TEST_ASSERT_EQUAL(FIRESIM_MC_STALLED, firesim_mc_finish(&g_chk, &r));
+    TEST_ASSERT_EQUAL_UINT32(1234, g_chk.violation_t_s);
+}
+
+/* ── Shrinker, against a synthetic failure predicate ─────────────────── */
+
+static int g_predicate_calls;
+
+/* "Fails" whenever a STOP fault is present and the profile still has at
+ * least two segments — everything else is noise the shrinker should drop. */
+static bool fails_with_stop_and_two_segments(const firesim_config_t *cfg, void *ctx)
+{
+    g_predicate_calls++;
+    if (cfg->profile.segment_count < 2) {
+        return false;
+    }
+    for (int i = 0; i < cfg->fault_count; i++) {
+        if (cfg->faults[i].kind == FIRESIM_FAULT_STOP) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void test_shrink_removes_everything_irrelevant(void)
+{
+    firesim_config_t cfg;
+    firesim_config_defaults(&cfg);
+    cfg.plant = &KILN_MODEL_LARGE_PRODUCTION;
+    cfg.start_temp_c = 200.0f;
+    cfg.delay_minutes = 15;
+    cfg.profile.segment_count = 5;
+    for (int i = 0; i < 5; i++) {
+        cfg.profile.segments[i].ramp_rate = 100.0f;
+        cfg.profile.segments[i].target_temp = 300.0f + 100.0f * i;
+        cfg.profile.segments[i].hold_time = 10;
+    }
+    TEST_ASSERT_TRUE(firesim_parse_fault("tc-spike@100+5=40", &cfg.faults[cfg.fault_count++]));
+    TEST_ASSERT_TRUE(firesim_parse_fault("pause@1h+10m", &cfg.faults[cfg.fault_count++]));
+    TEST_ASSERT_TRUE(firesim_parse_fault("stop@2h", &cfg.faults[cfg.fault_count++]));
+    TEST_ASSERT_TRUE(firesim_parse_fault("elements@0=0.7", &cfg.faults[cfg.fault_count++]));
+
+    g_predicate_calls = 0;
+    int runs = firesim_mc_shrink(&cfg, fails_with_stop_and_two_segments, NULL);
+    TEST_ASSERT_EQUAL(g_predicate_calls, runs);
+
+    TEST_ASSERT_EQUAL(1, cfg.fault_count);
+    TEST_ASSERT_EQUAL(FIRESIM_FAULT_STOP, cfg.faults[0].kind);
+    TEST_ASSERT_EQUAL(2, cfg.profile.segment_count);
+    TEST_ASSERT_EQUAL(0, cfg.profile.segments[0].hold_time);
+    TEST_ASSERT_EQUAL(0, cfg.profile.segments[1].hold_time);
+    TEST_ASSERT_EQUAL_FLOAT(cfg.profile.segments[1].target_temp, cfg.profile.max_temp);
+    TEST_ASSERT_EQUAL_UINT32(0, cfg.delay_minutes);
+    TEST_ASSERT_EQUAL_PTR(&KILN_MODEL_SMALL_TEST, cfg.plant);
+    TEST_ASSERT_EQUAL_FLOAT(25.0f, cfg.start_temp_c);
+}
+
+/* ── Real runs ───────────────────────────────────────────────────────── */
+
+static void test_small_batch_holds_every_invariant(void)
+{
+    for (uint32_t i = 0; i < 40; i++) {
+        firesim_config_t cfg;
+        firesim_mc_generate(7, i, &cfg);
+        uint32_t at = 0;
+        firesim_mc_violation_t v = firesim_mc_run(&cfg, NULL, &at);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE("ok", firesim_mc_violation_name(v), cfg.profile.id);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_generate_is_deterministic_per_seed_and_index);
+    RUN_TEST(test_generated_scenarios_are_well_formed);
+    RUN_TEST(test_checker_passes_a_normal_run);
+    RUN_TEST(test_checker_flags_ssr_on_while_paused);
+    RUN_TEST(test_checker_allows_tc_timeout_then_flags_missed_trip);
+    RUN_TEST(test_checker_flags_missed_over_temp_trip);
+    RUN_TEST(test_checker_flags_setpoint_and_segment_regressions);
+    RUN_TEST(test_checker_flags_timeout_as_stall);
+    RUN_TEST(test_shrink_removes_everything_irrelevant);
+    RUN_TEST(test_small_batch_holds_every_invariant);
+    return UNITY_END();
+}
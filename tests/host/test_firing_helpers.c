@@ -116,16 +116,16 @@ static void test_remaining_ramping_first_segment(void)
 {
     firing_profile_t p = two_seg_profile();
     /* Seg 0, at 0°C, ramping: 100s ramp + 60s hold + seg1 (100s ramp) = 260s. */
-    TEST_ASSERT_EQUAL_UINT32(260, firing_remaining_s(&p, 0, 0.0f, false, 0.0f));
+    TEST_ASSERT_EQUAL_UINT32(260, firing_remaining_s(&p, 0, 0.0f, false, 0.0f, NULL, 1.0f));
     /* Halfway up seg 0 (50°C): 50s ramp + 60 + 100 = 210s. */
-    TEST_ASSERT_EQUAL_UINT32(210, firing_remaining_s(&p, 0, 50.0f, false, 0.0f));
+    TEST_ASSERT_EQUAL_UINT32(210, firing_remaining_s(&p, 0, 50.0f, false, 0.0f, NULL, 1.0f));
 }
 
 static void test_remaining_holding_counts_only_hold_left(void)
 {
     firing_profile_t p = two_seg_profile();
     /* Seg 0 holding, 20s into the 60s hold: 40s hold left + seg1 100s = 140s. */
-    TEST_ASSERT_EQUAL_UINT32(140, firing_remaining_s(&p, 0, 100.0f, true, 20.0f));
+    TEST_ASSERT_EQUAL_UINT32(140, firing_remaining_s(&p, 0, 100.0f, true, 20.0f, NULL, 1.0f));
 }
 
 static void test_remaining_does_not_go_blank_past_estimate(void)
@@ -133,7 +133,7 @@ static void test_remaining_does_not_go_blank_past_estimate(void)
     firing_profile_t p = two_seg_profile();
     /* Last segment, still 50°C below its 200°C target: 50s ramp remains — the
        old estimate − elapsed scheme would have pinned this to 0. */
-    TEST_ASSERT_EQUAL_UINT32(50, firing_remaining_s(&p, 1, 150.0f, false, 0.0f));
+    TEST_ASSERT_EQUAL_UINT32(50, firing_remaining_s(&p, 1, 150.0f, false, 0.0f, NULL, 1.0f));
 }
 
 static void test_remaining_cooling_segment(void)
@@ -144,9 +144,9 @@ static void test_remaining_cooling_segment(void)
     p.segments[0].target_temp = 100.0f;
     p.segments[0].hold_time = 0;
     /* From 200°C cooling to 100°C: 100s. */
-    TEST_ASSERT_EQUAL_UINT32(100, firing_remaining_s(&p, 0, 200.0f, false, 0.0f));
+    TEST_ASSERT_EQUAL_UINT32(100, firing_remaining_s(&p, 0, 200.0f, false, 0.0f, NULL, 1.0f));
     /* Overshoot below target adds no negative time. */
-    TEST_ASSERT_EQUAL_UINT32(0, firing_remaining_s(&p, 0, 90.0f, false, 0.0f));
+    TEST_ASSERT_EQUAL_UINT32(0, firing_remaining_s(&p, 0, 90.0f, false, 0.0f, NULL, 1.0f));
 }
 
 static void test_remaining_indefinite_hold_contributes_zero(void)
@@ -155,15 +155,34 @@ static void test_remaining_indefinite_hold_contributes_zero(void)
     p.segments[0].hold_time = FIRING_HOLD_INDEFINITE;
     /* Seg 0 holding indefinitely: unknown duration → 0 for this segment, plus
        seg1's 100s ramp. */
-    TEST_ASSERT_EQUAL_UINT32(100, firing_remaining_s(&p, 0, 100.0f, true, 5.0f));
+    TEST_ASSERT_EQUAL_UINT32(100, firing_remaining_s(&p, 0, 100.0f, true, 5.0f, NULL, 1.0f));
 }
 
 static void test_remaining_handles_out_of_range_and_null(void)
 {
     firing_profile_t p = two_seg_profile();
-    TEST_ASSERT_EQUAL_UINT32(0, firing_remaining_s(NULL, 0, 0.0f, false, 0.0f));
-    TEST_ASSERT_EQUAL_UINT32(0, firing_remaining_s(&p, 2, 0.0f, false, 0.0f));
-    TEST_ASSERT_EQUAL_UINT32(0, firing_remaining_s(&p, -1, 0.0f, false, 0.0f));
+    TEST_ASSERT_EQUAL_UINT32(0, firing_remaining_s(NULL, 0, 0.0f, false, 0.0f, NULL, 1.0f));
+    TEST_ASSERT_EQUAL_UINT32(0, firing_remaining_s(&p, 2, 0.0f, false, 0.0f, NULL, 1.0f));
+    TEST_ASSERT_EQUAL_UINT32(0, firing_remaining_s(&p, -1, 0.0f, false, 0.0f, NULL, 1.0f));
+}
+
+static void test_remaining_slows_ramps_the_kiln_cannot_deliver(void)
+{
+    firing_profile_t p = {0};
+    p.segment_count = 2;
+    p.segments[0].ramp_rate = 100.0f;
+    p.segments[0].target_temp = 1200.0f;
+    p.segments[1].ramp_rate = -100.0f;
+    p.segments[1].target_temp = 1000.0f;
+    kiln_cap_t cap = {0};
+    for (int b = 1000 / KILN_CAP_BIN_C; b < 1200 / KILN_CAP_BIN_C; b++) {
+        cap.rate_ch[b] = 50;
+    }
+    /* 1000 → 1200 °C at the kiln's 50 °C/h is 4 h, not 2; the cool is 2 h
+       either way. A half-speed load doubles the climb again. */
+    TEST_ASSERT_EQUAL_UINT32(14400, firing_remaining_s(&p, 0, 1000.0f, false, 0.0f, NULL, 1.0f));
+    TEST_ASSERT_EQUAL_UINT32(21600, firing_remaining_s(&p, 0, 1000.0f, false, 0.0f, &cap, 1.0f));
+    TEST_ASSERT_EQUAL_UINT32(36000, firing_remaining_s(&p, 0, 1000.0f, false, 0.0f, &cap, 0.5f));
 }
 
 /* ── firing_first_bad_ramp_sign (#113) ─────────────────────────────────── */
@@ -268,6 +287,7 @@ int main(void)
     RUN_TEST(test_remaining_cooling_segment);
     RUN_TEST(test_remaining_indefinite_hold_contributes_zero);
     RUN_TEST(test_remaining_handles_out_of_range_and_null);
+    RUN_TEST(test_remaining_slows_ramps_the_kiln_cannot_deliver);
     RUN_TEST(test_bad_sign_all_consistent_returns_none);
     RUN_TEST(test_bad_sign_negative_ramp_toward_higher_target);
     RUN_TEST(test_bad_sign_positive_ramp_toward_lower_target);
@@ -0,0 +1,406 @@
+#include "esp_timer.h"
+#include "firing_engine.h"
+#include "firing_engine_internal.h"
+#include "firing_record.h"
+#include "firing_replay.h"
+#include "kiln_model.h"
+#include "safety_host.h"
+#include "scenario_helpers.h"
+#include "thermocouple_host.h"
+#include "unity.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Built with CONFIG_FIRING_RECORD and FIRING_RECORD_PATH pointing at
+ * RECORD_PATH (see CMakeLists.txt), so every firing here is recorded. */
+#define RECORD_PATH   "test_firing_record.rec"
+#define REPLAY_PATH   "test_firing_record_replay.rec"
+#define MAX_RUN_TICKS 12000
+
+typedef struct {
+    float duty;
+    firing_status_t status;
+    uint8_t segment;
+    float setpoint_c;
+    float temp_c;
+} observed_t;
+
+static observed_t s_live[MAX_RUN_TICKS];
+static observed_t s_replayed[MAX_RUN_TICKS];
+static int s_replayed_n;
+
+static kiln_model_t g_kiln;
+
+void setUp(void)
+{
+    scenario_setup_thermal(&g_kiln, &KILN_MODEL_SMALL_TEST, 25.0f);
+    firing_engine_set_record_path_for_test(RECORD_PATH);
+}
+
+void tearDown(void)
+{
+    scenario_stop();
+    remove(RECORD_PATH);
+    remove(REPLAY_PATH);
+}
+
+static observed_t observe(float duty, const firing_progress_t *p)
+{
+    observed_t o = {
+        .duty = duty,
+        .status = p->status,
+        .segment = p->current_segment,
+        .setpoint_c = p->target_temp,
+        .temp_c = p->current_temp,
+    };
+    return o;
+}
+
+static void collect_replayed(const firing_replay_tick_t *t, void *ctx)
+{
+    (void)ctx;
+    if (s_replayed_n < MAX_RUN_TICKS) {
+        s_replayed[s_replayed_n] = observe(t->duty, &t->progress);
+    }
+    s_replayed_n++;
+}
+
+/* Per-tick hook for the live run: operator commands and sensor faults. */
+typedef void (*script_fn)(int tick);
+
+/* Closed-loop firing against the kiln model with a jittery tick, the way
+   firing_task actually runs. Returns the number of ticks up to and including
+   the one that ended the firing, each observed into s_live. */
+static int run_live(script_fn script)
+{
+    int n = 0;
+    firing_progress_t prog;
+    for (int i = 0; i < MAX_RUN_TICKS; i++) {
+        if (script) {
+            script(i);
+        }
+        host_clock_advance(HARNESS_TICK_US + (i % 7 - 3) * 1500);
+        firing_tick(esp_timer_get_time());
+        firing_engine_get_progress(&prog);
+        s_live[n++] = observe(safety_test_last_duty(), &prog);
+        if (!prog.is_active) {
+            break;
+        }
+        kiln_model_step(&g_kiln, safety_test_last_duty(), 1.0f);
+        thermocouple_test_set(kiln_model_tc_reading(&g_kiln), 0);
+    }
+    /* The session closes on the next tick after the firing ends. */
+    host_clock_advance(HARNESS_TICK_US);
+    firing_tick(esp_timer_get_time());
+    return n;
+}
+
+/* Replay RECORD_PATH (re-recording it to REPLAY_PATH) into s_replayed. */
+static firing_replay_result_t replay(void)
+{
+    firing_engine_set_record_path_for_test(REPLAY_PATH);
+    FILE *f = fopen(RECORD_PATH, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    s_replayed_n = 0;
+    firing_replay_result_t res;
+    TEST_ASSERT_TRUE(firing_replay_run(f, collect_replayed, NULL, &res));
+    fclose(f);
+    /* Close the replay's own session, as the device would a tick later. */
+    host_clock_advance(HARNESS_TICK_US);
+    firing_tick(esp_timer_get_time());
+    return res;
+}
+
+static long read_file(const char *path, unsigned char *buf, long cap)
+{
+    FILE *f = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    long n = (long)fread(buf, 1, (size_t)cap, f);
+    fclose(f);
+    return n;
+}
+
+static void assert_replay_matches(int live_n, const firing_replay_result_t *res)
+{
+    TEST_ASSERT_FALSE(res->truncated);
+    TEST_ASSERT_EQUAL_INT(live_n, (int)res->ticks);
+    TEST_ASSERT_EQUAL_INT(live_n, s_replayed_n);
+    for (int i = 0; i < live_n; i++) {
+        char msg[32];
+        snprintf(msg, sizeof(msg), "tick %d", i);
+        /* Bit-for-bit, not within a tolerance: the replay runs the same code on
+           the same inputs. */
+        TEST_ASSERT_EQUAL_MESSAGE(s_live[i].status, s_replayed[i].status, msg);
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE(s_live[i].segment, s_replayed[i].segment, msg);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&s_live[i].duty, &s_replayed[i].duty, sizeof(float), msg);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&s_live[i].setpoint_c, &s_replayed[i].setpoint_c, sizeof(float), msg);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&s_live[i].temp_c, &s_replayed[i].temp_c, sizeof(float), msg);
+    }
+
+    /* Replaying is itself deterministic: the replay records the same bytes. */
+    static unsigned char a[1 << 16], b[1 << 16];
+    long an = read_file(RECORD_PATH, a, sizeof(a));
+    long bn = read_file(REPLAY_PATH, b, sizeof(b));
+    TEST_ASSERT_TRUE(an < (long)sizeof(a));
+    TEST_ASSERT_EQUAL_INT(an, bn);
+    TEST_ASSERT_EQUAL_MEMORY(a, b, (size_t)an);
+}
+
+static firing_profile_t bisque_profile(void)
+{
+    firing_profile_t p = {0};
+    strncpy(p.id, "rec", FIRING_ID_LEN - 1);
+    strncpy(p.name, "Record", FIRING_NAME_LEN - 1);
+    p.segment_count = 3;
+    p.segments[0] = (firing_segment_t){.ramp_rate = 400.0f, .target_temp = 200.0f, .hold_time = 0};
+    p.segments[1] = (firing_segment_t){.ramp_rate = 200.0f, .target_temp = 260.0f, .hold_time = 10};
+    p.segments[2] = (firing_segment_t){.ramp_rate = -300.0f, .target_temp = 250.0f, .hold_time = 0};
+    p.max_temp = 260.0f;
+    return p;
+}
+
+/* ── Codec ───────────────────────────────────────────────────────────── */
+
+static void test_codec_roundtrips_every_record_kind(void)
+{
+    FILE *f = tmpfile();
+    TEST_ASSERT_NOT_NULL(f);
+    firing_record_header_t hdr = {
+        .last_tick_us = 5000000, .tc_offset_c = -1.5f, .max_safe_temp_c = 1287.5f, .kp = 2.0f, .ki = 0.01f, .kd = 5.0f};
+    firing_record_writer_t w;
+    TEST_ASSERT_TRUE(firing_record_write_header(&w, f, &hdr));
+
+    firing_cmd_t start = {.type = FIRING_CMD_START};
+    start.start.profile = bisque_profile();
+    start.start.delay_minutes = 90;
+    firing_cmd_t tune = {.type = FIRING_CMD_AUTOTUNE_START};
+    tune.autotune.setpoint = 500.0f;
+    tune.autotune.hysteresis = 3.0f;
+    firing_cmd_t pause = {.type = FIRING_CMD_PAUSE};
+
+    firing_record_write_reading(&w, 20.25f, 0);
+    firing_record_write_cmd(&w, 5400000, &start);
+    firing_record_write_tick(&w, 6000000, SAFETY_TRIP_NONE);
+    firing_record_write_reading(&w, 20.25f, 0); /* unchanged: dropped */
+    firing_record_write_reading(&w, 0.0f, TC_FAULT_OPEN_CIRCUIT);
+    firing_record_write_reading(&w, 33.3f, 0); /* off the 0.25 °C grid */
+    firing_record_write_reading(&w, -0.0f, 0);
+    firing_record_write_tick(&w, 7003000, SAFETY_TRIP_TC_FAULT);
+    firing_record_write_cmd(&w, 7002000, &pause); /* earlier than the tick */
+    firing_record_write_cmd(&w, 9000000, &tune);
+    firing_record_write_end(&w);
+    TEST_ASSERT_FALSE(w.error);
+    rewind(f);
+
+    firing_record_reader_t r;
+    firing_record_header_t got_hdr;
+    TEST_ASSERT_TRUE(firing_record_read_header(&r, f, &got_hdr));
+    TEST_ASSERT_EQUAL_INT64(hdr.last_tick_us, got_hdr.last_tick_us);
+    TEST_ASSERT_EQUAL_FLOAT(hdr.tc_offset_c, got_hdr.tc_offset_c);
+    TEST_ASSERT_EQUAL_FLOAT(hdr.max_safe_temp_c, got_hdr.max_safe_temp_c);
+    TEST_ASSERT_EQUAL_FLOAT(hdr.kp, got_hdr.kp);
+    TEST_ASSERT_EQUAL_FLOAT(hdr.ki, got_hdr.ki);
+    TEST_ASSERT_EQUAL_FLOAT(hdr.kd, got_hdr.kd);
+
+    firing_record_entry_t e;
+    TEST_ASSERT_TRUE(firing_record_read_next(&r, &e));
+    TEST_ASSERT_EQUAL(FIRING_RECORD_READING, e.kind);
+    TEST_ASSERT_EQUAL_FLOAT(20.25f, e.temperature_c);
+    TEST_ASSERT_TRUE(firing_record_read_next(&r, &e));
+    TEST_ASSERT_EQUAL(FIRING_RECORD_CMD, e.kind);
+    TEST_ASSERT_EQUAL_INT64(5400000, e.time_us);
+    TEST_ASSERT_EQUAL_MEMORY(&start, &e.cmd, sizeof(start));
+    TEST_ASSERT_TRUE(firing_record_read_next(&r, &e));
+    TEST_ASSERT_EQUAL(FIRING_RECORD_TICK, e.kind);
+    TEST_ASSERT_EQUAL_INT64(6000000, e.time_us);
+    TEST_ASSERT_EQUAL_UINT8(SAFETY_TRIP_NONE, e.trip_cause);
+    TEST_ASSERT_TRUE(firing_record_read_next(&r, &e));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, e.temperature_c);
+    TEST_ASSERT_EQUAL_UINT8(TC_FAULT_OPEN_CIRCUIT, e.fault);
+    TEST_ASSERT_TRUE(firing_record_read_next(&r, &e));
+    TEST_ASSERT_EQUAL_FLOAT(33.3f, e.temperature_c);
+    TEST_ASSERT_EQUAL_UINT8(0, e.fault);
+    TEST_ASSERT_TRUE(firing_record_read_next(&r, &e));
+    TEST_ASSERT_TRUE(e.temperature_c == 0.0f && signbit(e.temperature_c));
+    TEST_ASSERT_TRUE(firing_record_read_next(&r, &e));
+    TEST_ASSERT_EQUAL_INT64(7003000, e.time_us);
+    TEST_ASSERT_EQUAL_UINT8(SAFETY_TRIP_TC_FAULT, e.trip_cause);
+    TEST_ASSERT_TRUE(firing_record_read_next(&r, &e));
+    TEST_ASSERT_EQUAL_INT64(7002000, e.time_us);
+    TEST_ASSERT_EQUAL(FIRING_CMD_PAUSE, e.cmd.type);
+    TEST_ASSERT_TRUE(firing_record_read_next(&r, &e));
+    TEST_ASSERT_EQUAL_INT64(9000000, e.time_us);
+    TEST_ASSERT_EQUAL_MEMORY(&tune, &e.cmd, sizeof(tune));
+    TEST_ASSERT_TRUE(firing_record_read_next(&r, &e));
+    TEST_ASSERT_EQUAL(FIRING_RECORD_END, e.kind);
+    TEST_ASSERT_FALSE(firing_record_read_next(&r, &e));
+    TEST_ASSERT_FALSE(r.truncated);
+    fclose(f);
+}
+
+static void test_steady_tick_and_quarter_step_cost_two_bytes_each(void)
+{
+    FILE *f = tmpfile();
+    firing_record_header_t hdr = {.last_tick_us = 0};
+    firing_record_writer_t w;
+    firing_record_write_header(&w, f, &hdr);
+    uint32_t before = w.bytes;
+    firing_record_write_tick(&w, 1000000, SAFETY_TRIP_NONE);
+    firing_record_write_tick(&w, 2000020, SAFETY_TRIP_NONE); /* 20 µs late */
+    TEST_ASSERT_EQUAL_UINT32(before + 4, w.bytes);
+    firing_record_write_reading(&w, 812.25f, 0); /* first reading: Δ from 0 */
+    before = w.bytes;
+    firing_record_write_reading(&w, 812.5f, 0);
+    TEST_ASSERT_EQUAL_UINT32(before + 2, w.bytes);
+    fclose(f);
+}
+
+static void test_truncated_recording_decodes_up_to_the_cut(void)
+{
+    FILE *f = tmpfile();
+    firing_record_header_t hdr = {.last_tick_us = 0};
+    firing_record_writer_t w;
+    firing_record_write_header(&w, f, &hdr);
+    for (int i = 1; i <= 10; i++) {
+        firing_record_write_tick(&w, (int64_t)i * 1000000 + 300000, SAFETY_TRIP_NONE);
+    }
+    long full = ftell(f);
+    rewind(f);
+    unsigned char buf[256];
+    TEST_ASSERT_EQUAL_INT(full, (long)fread(buf, 1, sizeof(buf), f));
+    fclose(f);
+
+    /* Power lost mid-way through the last tick's timestamp varint. */
+    FILE *cut = tmpfile();
+    fwrite(buf, 1, (size_t)full - 1, cut);
+    rewind(cut);
+    firing_record_reader_t r;
+    TEST_ASSERT_TRUE(firing_record_read_header(&r, cut, &hdr));
+    firing_record_entry_t e;
+    int n = 0;
+    while (firing_record_read_next(&r, &e)) {
+        TEST_ASSERT_EQUAL_INT64((int64_t)(n + 1) * 1000000 + 300000, e.time_us);
+        n++;
+    }
+    TEST_ASSERT_EQUAL_INT(9, n);
+    TEST_ASSERT_TRUE(r.truncated);
+    fclose(cut);
+}
+
+static void test_rejects_foreign_file(void)
+{
+    FILE *f = tmpfile();
+    fputs("t_s,temp\n0,20\n", f);
+    rewind(f);
+    firing_record_reader_t r;
+    firing_record_header_t hdr;
+    TEST_ASSERT_FALSE(firing_record_read_header(&r, f, &hdr));
+    fclose(f);
+}
+
+/* ── Record → replay ─────────────────────────────────────────────────── */
+
+static void operator_script(int tick)
+{
+    if (tick == 600) {
+        scenario_pause();
+    } else if (tick == 900) {
+        scenario_resume();
+    } else if (tick == 3300) {
+        scenario_skip(); /* cut the hold short */
+    }
+    /* A TC glitch: two faulted reads, then a 40 °C spike. */
+    if (tick == 1500 || tick == 1501) {
+        thermocouple_test_set(0.0f, TC_FAULT_OPEN_CIRCUIT);
+    } else if (tick == 1800) {
+        thermocouple_test_set(kiln_model_tc_reading(&g_kiln) + 40.0f, 0);
+    }
+}
+
+static void test_closed_loop_firing_replays_tick_for_tick(void)
+{
+    firing_profile_t p = bisque_profile();
+    scenario_start(&p, 0);
+    int n = run_live(operator_script);
+    TEST_ASSERT_EQUAL(FIRING_STATUS_COMPLETE, s_live[n - 1].status);
+    TEST_ASSERT_TRUE(n > 3300);
+
+    firing_replay_result_t res = replay();
+    TEST_ASSERT_EQUAL(FIRING_STATUS_COMPLETE, res.final_status);
+    TEST_ASSERT_EQUAL_UINT32(4, res.commands); /* START, PAUSE, RESUME, SKIP */
+    assert_replay_matches(n, &res);
+}
+
+static void tc_fault_script(int tick)
+{
+    /* Open thermocouple from tick 300 on; safety_task trips after 5 s. */
+    if (tick >= 300) {
+        thermocouple_test_set(0.0f, TC_FAULT_OPEN_CIRCUIT);
+    }
+    if (tick == 305) {
+        safety_emergency_stop_cause(SAFETY_TRIP_TC_FAULT);
+    }
+}
+
+static void test_safety_trip_replays_to_the_same_error(void)
+{
+    firing_profile_t p = bisque_profile();
+    scenario_start(&p, 2); /* through a delayed start, too */
+    int n = run_live(tc_fault_script);
+    TEST_ASSERT_EQUAL(FIRING_STATUS_ERROR, s_live[n - 1].status);
+    TEST_ASSERT_EQUAL(FIRING_ERR_TC_FAULT, firing_engine_get_error_code());
+
+    firing_replay_result_t res = replay();
+    TEST_ASSERT_EQUAL(FIRING_STATUS_ERROR, res.final_status);
+    TEST_ASSERT_EQUAL(FIRING_ERR_TC_FAULT, res.error_code);
+    assert_replay_matches(n, &res);
+}
+
+static void test_autotune_replays_tick_for_tick(void)
+{
+    scenario_autotune_start(150.0f, 2.0f);
+    int n = run_live(NULL);
+    TEST_ASSERT_TRUE(n < MAX_RUN_TICKS);
+
+    firing_replay_result_t res = replay();
+    assert_replay_matches(n, &res);
+}
+
+static void test_rejected_start_leaves_an_empty_recording(void)
+{
+    firing_profile_t p = bisque_profile();
+    p.segments[0].ramp_rate = -400.0f; /* wrong sign from 25 °C */
+    scenario_start(&p, 0);
+    firing_progress_t prog;
+    firing_engine_get_progress(&prog);
+    TEST_ASSERT_FALSE(prog.is_active);
+
+    FILE *f = firing_engine_open_record();
+    TEST_ASSERT_NOT_NULL(f);
+    firing_engine_set_record_path_for_test(REPLAY_PATH);
+    firing_replay_result_t res;
+    TEST_ASSERT_TRUE(firing_replay_run(f, NULL, NULL, &res));
+    fclose(f);
+    TEST_ASSERT_EQUAL_UINT32(1, res.commands);
+    TEST_ASSERT_EQUAL_UINT32(0, res.ticks);
+    TEST_ASSERT_FALSE(res.truncated);
+}
+
+int main(void)
+{
+    firing_engine_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_codec_roundtrips_every_record_kind);
+    RUN_TEST(test_steady_tick_and_quarter_step_cost_two_bytes_each);
+    RUN_TEST(test_truncated_recording_decodes_up_to_the_cut);
+    RUN_TEST(test_rejects_foreign_file);
+    RUN_TEST(test_closed_loop_firing_replays_tick_for_tick);
+    RUN_TEST(test_safety_trip_replays_to_the_same_error);
+    RUN_TEST(test_rejected_start_leaves_an_empty_recording);
+    /* Last: a completed auto-tune applies its gains to the engine. */
+    RUN_TEST(test_autotune_replays_tick_for_tick);
+    return UNITY_END();
+}
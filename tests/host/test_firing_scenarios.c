@@ -1,3 +1,4 @@
+#include "cone_table.h"
 #include "esp_timer.h"
 #include "firing_engine.h"
 #include "firing_engine_internal.h"
@@ -125,6 +126,72 @@ static void test_indefinite_hold_waits_for_skip(void)
     TEST_ASSERT_EQUAL(FIRING_STATUS_HEATING, prog.status);
 }
 
+/* ── End cone: a segment ends once the heat work reaches its cone ────── */
+
+static void test_hold_until_cone_advances_when_cone_bends(void)
+{
+    scenario_setup(&g_plant, 1100.0f);
+    firing_profile_t p = {0};
+    strncpy(p.id, "cone-hold", FIRING_ID_LEN - 1);
+    strncpy(p.name, "Cone Hold", FIRING_NAME_LEN - 1);
+    p.segment_count = 2;
+    p.max_temp = 1200.0f;
+    p.segments[0].ramp_rate = 300.0f;
+    p.segments[0].target_temp = 1200.0f; /* short of cone 6 at any speed */
+    p.segments[0].hold_time = FIRING_HOLD_INDEFINITE;
+    p.segments[0].end_cone = CONE_6 + 1;
+    p.segments[1].ramp_rate = -500.0f;
+    p.segments[1].target_temp = 1000.0f;
+    scenario_start(&p, 0);
+
+    TEST_ASSERT_TRUE(scenario_run_until_status(&g_plant, FIRING_STATUS_HOLDING, 30 * 60));
+    firing_progress_t prog;
+    firing_engine_get_progress(&prog);
+    TEST_ASSERT_TRUE(prog.equiv_cone < CONE_6);
+
+    TEST_ASSERT_TRUE_MESSAGE(scenario_run_until_status(&g_plant, FIRING_STATUS_COOLING, 2 * 3600),
+                             "indefinite hold never ended at cone 6");
+    firing_engine_get_progress(&prog);
+    TEST_ASSERT_EQUAL_UINT8(1, prog.current_segment);
+    TEST_ASSERT_EQUAL_INT8(CONE_6, prog.equiv_cone);
+
+    /* Each cone is journaled once, in order, ending with the one that ended the hold. */
+    history_test_counts_t h = history_test_counts();
+    int last_cone = -1, holds = 0;
+    for (int i = 0; i < h.event_count; i++) {
+        if (h.events[i].kind == HISTORY_EVT_CONE) {
+            TEST_ASSERT_TRUE(h.events[i].arg > last_cone);
+            last_cone = h.events[i].arg;
+        } else if (h.events[i].kind == HISTORY_EVT_HOLD) {
+            holds++;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(CONE_6, last_cone);
+    TEST_ASSERT_EQUAL_INT(1, holds);
+}
+
+static void test_end_cone_cuts_a_ramp_short(void)
+{
+    scenario_setup(&g_plant, 1000.0f);
+    firing_profile_t p = {0};
+    strncpy(p.id, "cone-ramp", FIRING_ID_LEN - 1);
+    strncpy(p.name, "Cone Ramp", FIRING_NAME_LEN - 1);
+    p.segment_count = 1;
+    p.max_temp = 1250.0f;
+    p.segments[0].ramp_rate = 150.0f;
+    p.segments[0].target_temp = 1250.0f;
+    p.segments[0].hold_time = 30;
+    p.segments[0].end_cone = CONE_04 + 1; /* 1060 °C at 150 °C/h */
+    scenario_start(&p, 0);
+
+    TEST_ASSERT_TRUE(scenario_run_until_status(&g_plant, FIRING_STATUS_COMPLETE, 3 * 3600));
+    history_test_counts_t h = history_test_counts();
+    TEST_ASSERT_FLOAT_WITHIN(25.0f, 1060.0f, h.last_peak_temp);
+    for (int i = 0; i < h.event_count; i++) {
+        TEST_ASSERT_NOT_EQUAL(HISTORY_EVT_HOLD, h.events[i].kind);
+    }
+}
+
 /* ── Pause: status becomes PAUSED, SSR forced to 0 ──────────────────── */
 
 static void test_pause_drives_ssr_off_and_resume_restores_heating(void)
@@ -196,6 +263,54 @@ static void test_stop_drops_to_idle(void)
     TEST_ASSERT_EQUAL(HISTORY_OUTCOME_ABORTED, h.last_outcome);
 }
 
+/* ── Event journal: operator actions and TC faults land in order ─────── */
+
+static void test_journal_records_actions_in_order(void)
+{
+    firing_profile_t p = scenario_short_profile();
+    scenario_start(&p, 0);
+    TEST_ASSERT_TRUE(scenario_run_until_status(&g_plant, FIRING_STATUS_HEATING, 30));
+    scenario_run_ticks(&g_plant, 10);
+
+    scenario_pause();
+    scenario_run_ticks(&g_plant, 3);
+    scenario_resume();
+    scenario_run_ticks(&g_plant, 2);
+    thermocouple_test_set(g_plant.temp_c, TC_FAULT_OPEN_CIRCUIT);
+    scenario_run_ticks(&g_plant, 1);
+    thermocouple_test_set(g_plant.temp_c, 0);
+    scenario_run_ticks(&g_plant, 1);
+    scenario_skip();
+    scenario_run_ticks(&g_plant, 1);
+    scenario_stop();
+    scenario_run_ticks(&g_plant, 1);
+
+    const struct {
+        history_event_kind_t kind;
+        firing_cmd_source_t source;
+        uint8_t arg;
+    } want[] = {
+        {HISTORY_EVT_SEGMENT, FIRING_SRC_API, 0},
+        {HISTORY_EVT_PAUSE, FIRING_SRC_API, 0},
+        {HISTORY_EVT_RESUME, FIRING_SRC_API, 0},
+        {HISTORY_EVT_TC_FAULT, FIRING_SRC_ENGINE, TC_FAULT_OPEN_CIRCUIT},
+        {HISTORY_EVT_TC_OK, FIRING_SRC_ENGINE, 0},
+        {HISTORY_EVT_SEGMENT, FIRING_SRC_API, 1},
+        {HISTORY_EVT_STOP, FIRING_SRC_API, 0},
+    };
+    history_test_counts_t h = history_test_counts();
+    TEST_ASSERT_EQUAL_INT(sizeof(want) / sizeof(want[0]), h.event_count);
+    for (int i = 0; i < h.event_count; i++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(want[i].kind, h.events[i].kind, "kind");
+        TEST_ASSERT_EQUAL_INT_MESSAGE(want[i].source, h.events[i].source, "source");
+        TEST_ASSERT_EQUAL_INT_MESSAGE(want[i].arg, h.events[i].arg, "arg");
+        TEST_ASSERT_TRUE(i == 0 || h.events[i].t_s >= h.events[i - 1].t_s);
+    }
+    /* Paused time isn't firing time: resume is stamped where pause was. */
+    TEST_ASSERT_EQUAL_UINT32(h.events[1].t_s, h.events[2].t_s);
+    TEST_ASSERT_TRUE(h.events[1].t_s >= 10);
+}
+
 /* ── Delayed start: stays IDLE during delay, transitions when it ends ── */
 
 static void test_delayed_start_transitions_after_delay(void)
@@ -1175,6 +1290,174 @@ static void test_emergency_during_delay_cancels_firing(void)
     TEST_ASSERT_EQUAL(FIRING_STATUS_ERROR, prog.status);
 }
 
+/* ── Next-event skipping: identical to ticking once a second ───────────── */
+
+/* Everything a tick can leave behind that a test (or the device) can see. */
+typedef struct {
+    int64_t now_us;
+    firing_progress_t prog;
+    history_test_counts_t hist;
+    uint32_t element_on_s;
+    float duty;
+    bool vent;
+    firing_error_code_t error_code;
+} engine_snapshot_t;
+
+static void take_snapshot(engine_snapshot_t *s)
+{
+    s->now_us = esp_timer_get_time();
+    firing_engine_get_progress(&s->prog);
+    s->hist = history_test_counts();
+    s->element_on_s = firing_engine_get_element_hours_s();
+    s->duty = safety_test_last_duty();
+    s->vent = safety_test_vent_active();
+    s->error_code = firing_engine_get_error_code();
+}
+
+static void assert_same_snapshot(const engine_snapshot_t *a, const engine_snapshot_t *b)
+{
+    TEST_ASSERT_EQUAL_INT64(a->now_us, b->now_us);
+    TEST_ASSERT_EQUAL(a->prog.is_active, b->prog.is_active);
+    TEST_ASSERT_EQUAL(a->prog.status, b->prog.status);
+    TEST_ASSERT_EQUAL_UINT8(a->prog.current_segment, b->prog.current_segment);
+    TEST_ASSERT_EQUAL_UINT32(a->prog.elapsed_time, b->prog.elapsed_time);
+    TEST_ASSERT_EQUAL_UINT32(a->prog.estimated_remaining, b->prog.estimated_remaining);
+    TEST_ASSERT_TRUE(a->prog.current_temp == b->prog.current_temp);
+    TEST_ASSERT_TRUE(a->prog.target_temp == b->prog.target_temp);
+    TEST_ASSERT_EQUAL_INT(a->hist.starts, b->hist.starts);
+    TEST_ASSERT_EQUAL_INT(a->hist.samples, b->hist.samples);
+    TEST_ASSERT_EQUAL_INT(a->hist.ends, b->hist.ends);
+    TEST_ASSERT_EQUAL(a->hist.last_outcome, b->hist.last_outcome);
+    TEST_ASSERT_EQUAL_UINT32(a->hist.last_duration_s, b->hist.last_duration_s);
+    TEST_ASSERT_TRUE(a->hist.last_peak_temp == b->hist.last_peak_temp);
+    TEST_ASSERT_EQUAL_UINT32(a->element_on_s, b->element_on_s);
+    TEST_ASSERT_TRUE(a->duty == b->duty);
+    TEST_ASSERT_EQUAL(a->vent, b->vent);
+    TEST_ASSERT_EQUAL(a->error_code, b->error_code);
+}
+
+static int run_ticks_mode(int tick_count, bool skipping)
+{
+    if (skipping) {
+        return scenario_run_ticks_skipping(&g_plant, tick_count);
+    }
+    scenario_run_ticks(&g_plant, tick_count);
+    return tick_count;
+}
+
+/* A kiln already sitting at its soak temperature: a 60-minute delayed start,
+ * then a 2 h and a 30 min hold. Nothing but the clock changes for 3.5 h. */
+static int run_flat_soak(bool skipping, engine_snapshot_t snaps[2])
+{
+    scenario_setup(&g_plant, 100.0f);
+    g_plant.stuck = true;
+
+    firing_profile_t p = {0};
+    strncpy(p.id, "flat-soak", FIRING_ID_LEN - 1);
+    strncpy(p.name, "Flat Soak", FIRING_NAME_LEN - 1);
+    p.segment_count = 2;
+    p.max_temp = 100.0f;
+    p.segments[0].ramp_rate = 100.0f;
+    p.segments[0].target_temp = 100.0f;
+    p.segments[0].hold_time = 120;
+    p.segments[1].ramp_rate = 100.0f;
+    p.segments[1].target_temp = 100.0f;
+    p.segments[1].hold_time = 30;
+    scenario_start(&p, 60);
+
+    int ticks = run_ticks_mode(90 * 60, skipping); /* mid first hold */
+    take_snapshot(&snaps[0]);
+    ticks += run_ticks_mode(3 * 3600, skipping);
+    take_snapshot(&snaps[1]);
+    return ticks;
+}
+
+static void test_skipping_delay_and_holds_matches_tick_by_tick(void)
+{
+    engine_snapshot_t ticked[2], skipped[2];
+    int ticked_n = run_flat_soak(false, ticked);
+    int skipped_n = run_flat_soak(true, skipped);
+
+    TEST_ASSERT_EQUAL(FIRING_STATUS_HOLDING, ticked[0].prog.status);
+    TEST_ASSERT_EQUAL(FIRING_STATUS_COMPLETE, ticked[1].prog.status);
+    assert_same_snapshot(&ticked[0], &skipped[0]);
+    assert_same_snapshot(&ticked[1], &skipped[1]);
+
+    /* Two real ticks per history sample (the one before it and the sample
+       itself) is all the holds need; the delay is a single jump. */
+    TEST_ASSERT_TRUE_MESSAGE(skipped_n * 25 < ticked_n, "skipping runner still ticked through the idle stretches");
+}
+
+/* Ramp on the tracking plant, then pin the kiln exactly on the hold target.
+ * The integral built up during the ramp keeps the elements on through the
+ * hold, so element-on time and its periodic NVS flush are exercised too. */
+static int run_powered_hold(bool skipping, engine_snapshot_t snaps[2])
+{
+    scenario_setup(&g_plant, 25.0f);
+    firing_profile_t p = {0};
+    strncpy(p.id, "powered-hold", FIRING_ID_LEN - 1);
+    strncpy(p.name, "Powered Hold", FIRING_NAME_LEN - 1);
+    p.segment_count = 1;
+    p.max_temp = 200.0f;
+    p.segments[0].ramp_rate = 6000.0f;
+    p.segments[0].target_temp = 200.0f;
+    p.segments[0].hold_time = 60;
+    scenario_start(&p, 0);
+    TEST_ASSERT_TRUE(scenario_run_until_status(&g_plant, FIRING_STATUS_HOLDING, 3 * 60));
+
+    g_plant.temp_c = 200.0f;
+    g_plant.stuck = true;
+    thermocouple_test_set(g_plant.temp_c, 0);
+    take_snapshot(&snaps[0]);
+
+    int ticks = run_ticks_mode(90 * 60, skipping);
+    take_snapshot(&snaps[1]);
+    return ticks;
+}
+
+static void test_skipping_powered_hold_matches_tick_by_tick(void)
+{
+    engine_snapshot_t ticked[2], skipped[2];
+    int ticked_n = run_powered_hold(false, ticked);
+    int skipped_n = run_powered_hold(true, skipped);
+
+    assert_same_snapshot(&ticked[0], &skipped[0]);
+    TEST_ASSERT_TRUE(ticked[1].element_on_s > ticked[0].element_on_s + 30 * 60);
+    TEST_ASSERT_EQUAL(FIRING_STATUS_COMPLETE, ticked[1].prog.status);
+    assert_same_snapshot(&ticked[1], &skipped[1]);
+
+    /* A few hundred ticks for the derivative filter to decay, then one per
+       history sample or element-hours flush. */
+    TEST_ASSERT_TRUE(skipped_n * 8 < ticked_n);
+}
+
+/* Ramping, paused, and finished states each get the right forecast. */
+static void test_next_event_forecasts(void)
+{
+    firing_profile_t p = scenario_short_profile();
+    scenario_start(&p, 0);
+    scenario_run_ticks(&g_plant, 5);
+    int64_t now_us = esp_timer_get_time();
+    TEST_ASSERT_EQUAL_INT64(now_us, firing_next_event_us(now_us)); /* still ramping */
+
+    scenario_pause();
+    scenario_run_ticks(&g_plant, 1);
+    TEST_ASSERT_EQUAL_INT64(INT64_MAX, firing_next_event_us(esp_timer_get_time()));
+    scenario_resume();
+
+    scenario_stop();
+    scenario_start(&p, 10);
+    scenario_run_ticks(&g_plant, 1);
+    TEST_ASSERT_EQUAL_INT64(now_us + HARNESS_TICK_US + 10LL * 60 * 1000000,
+                            firing_next_event_us(esp_timer_get_time()));
+
+    scenario_stop();
+    TEST_ASSERT_TRUE(scenario_relay_test(3));
+    scenario_run_ticks(&g_plant, 1);
+    TEST_ASSERT_EQUAL_INT64(now_us + 2 * HARNESS_TICK_US + 3 * HARNESS_TICK_US,
+                            firing_next_event_us(esp_timer_get_time()));
+}
+
 int main(void)
 {
     /* Init firing engine once for the whole binary — queues/mutexes are
@@ -1185,9 +1468,12 @@ int main(void)
     RUN_TEST(test_happy_path_short_profile_completes);
     RUN_TEST(test_hold_does_not_complete_before_hold_time_elapses);
     RUN_TEST(test_indefinite_hold_waits_for_skip);
+    RUN_TEST(test_hold_until_cone_advances_when_cone_bends);
+    RUN_TEST(test_end_cone_cuts_a_ramp_short);
     RUN_TEST(test_pause_drives_ssr_off_and_resume_restores_heating);
     RUN_TEST(test_skip_mid_ramp_advances_segment);
     RUN_TEST(test_stop_drops_to_idle);
+    RUN_TEST(test_journal_records_actions_in_order);
     RUN_TEST(test_delayed_start_transitions_after_delay);
     RUN_TEST(test_cooling_segment_reports_cooling_status);
     RUN_TEST(test_skip_while_paused_does_not_resume_heating);
@@ -1228,5 +1514,8 @@ int main(void)
     RUN_TEST(test_event_reports_true_peak_and_profile_name);
     RUN_TEST(test_skip_ignored_during_delay);
     RUN_TEST(test_emergency_during_delay_cancels_firing);
+    RUN_TEST(test_skipping_delay_and_holds_matches_tick_by_tick);
+    RUN_TEST(test_skipping_powered_hold_matches_tick_by_tick);
+    RUN_TEST(test_next_event_forecasts);
     return UNITY_END();
 }
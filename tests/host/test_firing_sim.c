@@ -0,0 +1,201 @@
+#include "firing_sim.h"
+#include "firing_engine_internal.h"
+#include "heat_work.h"
+#include "app_config.h"
+#include "cone_table.h"
+#include "unity.h"
+
+#include <math.h>
+#include <string.h>
+
+static firing_profile_t s_prof;
+static kiln_cap_t s_cap;
+static firing_sim_config_t s_cfg;
+static firing_sim_result_t s_res;
+
+void setUp(void)
+{
+    memset(&s_prof, 0, sizeof(s_prof));
+    memset(&s_cap, 0, sizeof(s_cap));
+    memset(&s_res, 0, sizeof(s_res));
+    s_cfg = (firing_sim_config_t){
+        .start_temp_c = 20.0f,
+        .kp = APP_PID_KP_DEFAULT,
+        .ki = APP_PID_KI_DEFAULT,
+        .kd = APP_PID_KD_DEFAULT,
+    };
+    strcpy(s_prof.id, "test");
+}
+void tearDown(void)
+{
+}
+
+static void add_seg(float ramp_rate, float target, uint16_t hold_min)
+{
+    firing_segment_t *s = &s_prof.segments[s_prof.segment_count++];
+    s->ramp_rate = ramp_rate;
+    s->target_temp = target;
+    s->hold_time = hold_min;
+}
+
+static void learn_everywhere(void)
+{
+    for (int b = 0; b < KILN_CAP_BINS; b++) {
+        s_cap.rate_ch[b] = (uint16_t)(480 - 15 * b); /* 330 °C/h at 500 °C, 180 at 1000 */
+    }
+}
+
+/* ── Following the program ─────────────────────────────────────────────── */
+
+static void test_a_firing_the_kiln_can_follow_runs_to_plan(void)
+{
+    add_seg(100.0f, 1000.0f, 10);
+    add_seg(-150.0f, 700.0f, 0);
+    firing_sim_run(&s_prof, NULL, &s_cfg, &s_res);
+
+    TEST_ASSERT_EQUAL(FIRING_SIM_COMPLETE, s_res.outcome);
+    TEST_ASSERT_EQUAL_UINT8(1, s_res.segment);
+    uint32_t plan = firing_remaining_s(&s_prof, 0, 20.0f, false, 0.0f, NULL, 1.0f);
+    TEST_ASSERT_UINT32_WITHIN(plan / 100, plan, s_res.duration_s);
+    TEST_ASSERT_FLOAT_WITHIN(3.0f, 1000.0f, s_res.peak_temp_c);
+    TEST_ASSERT_TRUE(s_res.max_lag_c < 5.0f);
+    TEST_ASSERT_TRUE(s_res.on_s > 0.0f && s_res.on_s < s_res.duration_s);
+}
+
+static void test_element_time_agrees_with_the_plan(void)
+{
+    learn_everywhere();
+    add_seg(120.0f, 1100.0f, 30);
+    add_seg(-100.0f, 900.0f, 0);
+    firing_sim_run(&s_prof, &s_cap, &s_cfg, &s_res);
+
+    TEST_ASSERT_EQUAL(FIRING_SIM_COMPLETE, s_res.outcome);
+    float planned = firing_planned_on_s(&s_prof, 20.0f, &s_cap);
+    TEST_ASSERT_FLOAT_WITHIN(planned * 0.05f, planned, s_res.on_s);
+}
+
+static void test_a_ramp_past_the_curve_runs_at_the_curve(void)
+{
+    learn_everywhere();
+    add_seg(500.0f, 1000.0f, 0);
+    firing_sim_run(&s_prof, &s_cap, &s_cfg, &s_res);
+
+    TEST_ASSERT_EQUAL(FIRING_SIM_COMPLETE, s_res.outcome);
+    float curve_s = kiln_cap_ramp_s(&s_cap, 1.0f, 20.0f, 1000.0f, 500.0f);
+    TEST_ASSERT_FLOAT_WITHIN(curve_s * 0.03f, curve_s, (float)s_res.duration_s);
+    TEST_ASSERT_TRUE(s_res.max_lag_c > 100.0f);
+}
+
+/* ── Where a run stops ─────────────────────────────────────────────────── */
+
+static void test_a_kiln_that_tops_out_stalls(void)
+{
+    for (int b = 0; b < KILN_CAP_BINS; b++) {
+        s_cap.rate_ch[b] = b < 20 ? 300 : 1; /* nothing left above 1000 °C */
+    }
+    add_seg(200.0f, 1200.0f, 0);
+    firing_sim_run(&s_prof, &s_cap, &s_cfg, &s_res);
+
+    TEST_ASSERT_EQUAL(FIRING_SIM_STALLED, s_res.outcome);
+    TEST_ASSERT_EQUAL_UINT8(0, s_res.segment);
+    TEST_ASSERT_FLOAT_WITHIN(5.0f, 1000.0f, s_res.peak_temp_c);
+}
+
+static void test_an_indefinite_hold_ends_the_run_where_it_starts(void)
+{
+    add_seg(200.0f, 600.0f, 0);
+    add_seg(100.0f, 700.0f, FIRING_HOLD_INDEFINITE);
+    add_seg(-100.0f, 500.0f, 0);
+    firing_sim_run(&s_prof, NULL, &s_cfg, &s_res);
+
+    TEST_ASSERT_EQUAL(FIRING_SIM_WAITS, s_res.outcome);
+    TEST_ASSERT_EQUAL_UINT8(1, s_res.segment);
+    TEST_ASSERT_UINT32_WITHIN(120, 580 * 18 + 3600, s_res.duration_s);
+}
+
+static void test_an_end_cone_cuts_the_ramp_short(void)
+{
+    add_seg(150.0f, 1300.0f, 30);
+    s_prof.segments[0].end_cone = CONE_04 + 1;
+    firing_sim_run(&s_prof, NULL, &s_cfg, &s_res);
+
+    TEST_ASSERT_EQUAL(FIRING_SIM_COMPLETE, s_res.outcome);
+    TEST_ASSERT_EQUAL_INT8(CONE_04, s_res.equiv_cone);
+    TEST_ASSERT_TRUE(s_res.peak_temp_c < 1100.0f);
+}
+
+static void test_a_hold_until_cone_holds_to_the_cone(void)
+{
+    add_seg(150.0f, 1200.0f, FIRING_HOLD_INDEFINITE);
+    s_prof.segments[0].end_cone = CONE_7 + 1;
+    add_seg(-150.0f, 900.0f, 0);
+    firing_sim_run(&s_prof, NULL, &s_cfg, &s_res);
+
+    TEST_ASSERT_EQUAL(FIRING_SIM_COMPLETE, s_res.outcome);
+    TEST_ASSERT_EQUAL_UINT8(1, s_res.segment);
+    TEST_ASSERT_EQUAL_INT8(CONE_7, s_res.equiv_cone);
+    TEST_ASSERT_TRUE(s_res.peak_temp_c < 1205.0f);
+    TEST_ASSERT_TRUE(s_res.duration_s > 1180 * 24 + 2 * 300);
+}
+
+static bool stop_now(void *ctx)
+{
+    (*(int *)ctx)++;
+    return false;
+}
+
+static void test_the_yield_hook_can_cancel(void)
+{
+    int calls = 0;
+    s_cfg.yield = stop_now;
+    s_cfg.ctx = &calls;
+    add_seg(50.0f, 1000.0f, 0);
+    firing_sim_run(&s_prof, NULL, &s_cfg, &s_res);
+
+    TEST_ASSERT_EQUAL(FIRING_SIM_CANCELLED, s_res.outcome);
+    TEST_ASSERT_EQUAL_INT(1, calls);
+    TEST_ASSERT_EQUAL_UINT32(FIRING_SIM_YIELD_S, s_res.duration_s);
+}
+
+/* ── The curve ─────────────────────────────────────────────────────────── */
+
+static void test_a_long_curve_is_decimated_evenly(void)
+{
+    add_seg(60.0f, 1000.0f, 120);
+    firing_sim_run(&s_prof, NULL, &s_cfg, &s_res);
+
+    TEST_ASSERT_EQUAL(FIRING_SIM_COMPLETE, s_res.outcome);
+    TEST_ASSERT_TRUE(s_res.point_count <= FIRING_SIM_MAX_POINTS);
+    TEST_ASSERT_TRUE(s_res.point_count > FIRING_SIM_MAX_POINTS / 2);
+    TEST_ASSERT_EQUAL_UINT32(480, s_res.point_every_s);
+    for (int i = 0; i + 1 < s_res.point_count; i++) {
+        TEST_ASSERT_EQUAL_UINT32((uint32_t)i * s_res.point_every_s, s_res.points[i].t_s);
+    }
+    const firing_sim_point_t *last = &s_res.points[s_res.point_count - 1];
+    TEST_ASSERT_EQUAL_UINT32(s_res.duration_s, last->t_s);
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 1000.0f, last->temp_c);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, s_res.points[0].temp_c);
+
+    /* The power curve survives decimation: element time only ever grows, and
+       the last point carries all of it. */
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, s_res.points[0].on_s);
+    for (int i = 0; i + 1 < s_res.point_count; i++) {
+        TEST_ASSERT_TRUE(s_res.points[i + 1].on_s >= s_res.points[i].on_s);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(s_res.on_s, last->on_s);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_a_firing_the_kiln_can_follow_runs_to_plan);
+    RUN_TEST(test_element_time_agrees_with_the_plan);
+    RUN_TEST(test_a_ramp_past_the_curve_runs_at_the_curve);
+    RUN_TEST(test_a_kiln_that_tops_out_stalls);
+    RUN_TEST(test_an_indefinite_hold_ends_the_run_where_it_starts);
+    RUN_TEST(test_an_end_cone_cuts_the_ramp_short);
+    RUN_TEST(test_a_hold_until_cone_holds_to_the_cone);
+    RUN_TEST(test_the_yield_hook_can_cancel);
+    RUN_TEST(test_a_long_curve_is_decimated_evenly);
+    return UNITY_END();
+}
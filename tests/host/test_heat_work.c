@@ -0,0 +1,119 @@
+#include "heat_work.h"
+#include "cone_table.h"
+#include "unity.h"
+
+#include <stdio.h>
+
+static heat_work_t s_hw;
+
+void setUp(void)
+{
+    heat_work_reset(&s_hw);
+}
+void tearDown(void)
+{
+}
+
+/* Ramp at `rate_c_h` from `from_c`, one engine tick a second, until `cone`
+ * bends; returns the temperature it bent at (or past `max_c` if it never did). */
+static float ramp_until_cone(float from_c, float rate_c_h, int cone, float max_c)
+{
+    float t = from_c;
+    while (t <= max_c && !heat_work_reached(&s_hw, cone)) {
+        heat_work_add(&s_hw, t, 1.0f);
+        t += rate_c_h / 3600.0f;
+    }
+    return t;
+}
+
+/* ── Calibration ───────────────────────────────────────────────────────── */
+
+static void test_constant_ramps_reproduce_the_orton_table(void)
+{
+    static const float rates[3] = {60.0f, 150.0f, 300.0f};
+    for (int cone = 0; cone < CONE_COUNT; cone++) {
+        for (int speed = 0; speed < 3; speed++) {
+            float want = cone_target_temp_c((cone_id_t)cone, (cone_speed_t)speed);
+            heat_work_reset(&s_hw);
+            /* The last few hundred degrees at the final rate are what count;
+               starting there keeps the test fast without changing the result. */
+            float got = ramp_until_cone(want - 300.0f, rates[speed], cone, 1500.0f);
+            char msg[48];
+            snprintf(msg, sizeof(msg), "cone %s at %.0f C/h", cone_name((cone_id_t)cone), rates[speed]);
+            TEST_ASSERT_FLOAT_WITHIN_MESSAGE(25.0f, want, got, msg);
+        }
+    }
+}
+
+static void test_faster_ramps_bend_a_cone_hotter(void)
+{
+    float slow = ramp_until_cone(900.0f, 60.0f, CONE_6, 1400.0f);
+    heat_work_reset(&s_hw);
+    float fast = ramp_until_cone(900.0f, 300.0f, CONE_6, 1400.0f);
+    TEST_ASSERT_TRUE(fast > slow + 15.0f);
+}
+
+/* ── Equivalent cone ───────────────────────────────────────────────────── */
+
+static void test_no_cone_before_any_work(void)
+{
+    TEST_ASSERT_EQUAL_INT(HEAT_WORK_NO_CONE, heat_work_cone(&s_hw));
+    TEST_ASSERT_FALSE(heat_work_reached(&s_hw, CONE_022));
+    heat_work_add(&s_hw, 20.0f, 24.0f * 3600.0f); /* a day at room temperature */
+    TEST_ASSERT_EQUAL_INT(HEAT_WORK_NO_CONE, heat_work_cone(&s_hw));
+}
+
+static void test_cone_climbs_in_order_during_a_firing(void)
+{
+    int last = HEAT_WORK_NO_CONE;
+    for (float t = 500.0f; t < 1310.0f; t += 150.0f / 3600.0f) {
+        heat_work_add(&s_hw, t, 1.0f);
+        int cone = heat_work_cone(&s_hw);
+        TEST_ASSERT_TRUE(cone >= last);
+        TEST_ASSERT_TRUE(cone <= last + 1); /* one second never skips a cone at 150 °C/h */
+        if (cone >= 0) {
+            TEST_ASSERT_TRUE(heat_work_reached(&s_hw, cone));
+        }
+        if (cone + 1 < HEAT_WORK_CONES) {
+            TEST_ASSERT_FALSE(heat_work_reached(&s_hw, cone + 1));
+        }
+        last = cone;
+    }
+    TEST_ASSERT_EQUAL_INT(CONE_10, last); /* 1305 °C at 150 °C/h */
+}
+
+static void test_hold_below_the_table_temperature_matures_the_ware(void)
+{
+    /* Cone 6 medium is 1222 °C. Stopping 20 °C short leaves it unbent, and a
+       soak there gets it over within the hour. */
+    float peak = cone_target_temp_c(CONE_6, CONE_SPEED_MEDIUM) - 20.0f;
+    ramp_until_cone(900.0f, 150.0f, CONE_6, peak);
+    TEST_ASSERT_FALSE(heat_work_reached(&s_hw, CONE_6));
+    int minutes = 0;
+    while (!heat_work_reached(&s_hw, CONE_6) && minutes < 240) {
+        heat_work_add(&s_hw, peak, 60.0f);
+        minutes++;
+    }
+    TEST_ASSERT_TRUE(minutes > 5);
+    TEST_ASSERT_TRUE(minutes < 60);
+}
+
+static void test_out_of_range_cone_is_never_reached(void)
+{
+    heat_work_add(&s_hw, 1500.0f, 10.0f * 3600.0f);
+    TEST_ASSERT_EQUAL_INT(CONE_14, heat_work_cone(&s_hw));
+    TEST_ASSERT_FALSE(heat_work_reached(&s_hw, HEAT_WORK_NO_CONE));
+    TEST_ASSERT_FALSE(heat_work_reached(&s_hw, HEAT_WORK_CONES));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_constant_ramps_reproduce_the_orton_table);
+    RUN_TEST(test_faster_ramps_bend_a_cone_hotter);
+    RUN_TEST(test_no_cone_before_any_work);
+    RUN_TEST(test_cone_climbs_in_order_during_a_firing);
+    RUN_TEST(test_hold_below_the_table_temperature_matures_the_ware);
+    RUN_TEST(test_out_of_range_cone_is_never_reached);
+    return UNITY_END();
+}
@@ -0,0 +1,159 @@
+#include "http_arena.h"
+#include "app_config.h"
+#include "cJSON.h"
+#include "freertos/task.h"
+#include "unity.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/* The host stubs have no tasks; stand in for the two the arena cares about. */
+static int s_httpd_task, s_other_task;
+static TaskHandle_t s_current = &s_httpd_task;
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return s_current;
+}
+
+static http_arena_stats_t s_stats;
+
+void setUp(void)
+{
+    http_arena_init();
+    s_current = &s_httpd_task;
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+void tearDown(void)
+{
+}
+
+/* ── Allocation ────────────────────────────────────────────────────────── */
+
+static void test_allocations_are_aligned_and_contiguous(void)
+{
+    http_arena_t *a = http_arena_begin();
+    TEST_ASSERT_NOT_NULL(a);
+    uint8_t *p = http_arena_malloc(3);
+    uint8_t *q = http_arena_malloc(16);
+    TEST_ASSERT_EQUAL_UINT32(0, (uintptr_t)p % sizeof(uint64_t));
+    TEST_ASSERT_EQUAL_PTR(p + sizeof(uint64_t), q);
+    http_arena_end(a, &s_stats);
+    TEST_ASSERT_EQUAL_UINT32(24, s_stats.high_water);
+}
+
+static void test_end_empties_the_arena(void)
+{
+    http_arena_t *a = http_arena_begin();
+    void *first = http_arena_malloc(100);
+    http_arena_end(a, &s_stats);
+
+    a = http_arena_begin();
+    TEST_ASSERT_EQUAL_PTR(first, http_arena_malloc(100));
+    http_arena_end(a, &s_stats);
+    TEST_ASSERT_EQUAL_UINT32(2, s_stats.requests);
+}
+
+static void test_freeing_newest_block_gives_it_back(void)
+{
+    http_arena_t *a = http_arena_begin();
+    void *keep = http_arena_malloc(40);
+    void *tmp = http_arena_malloc(400);
+    http_arena_free(tmp);
+    TEST_ASSERT_EQUAL_PTR(tmp, http_arena_malloc(8));
+    http_arena_free(keep); /* not the newest: stays until the reset */
+    TEST_ASSERT_NOT_EQUAL(keep, http_arena_malloc(8));
+    http_arena_end(a, &s_stats);
+    TEST_ASSERT_EQUAL_UINT32(440, s_stats.high_water);
+}
+
+/* ── Fallback to the heap ──────────────────────────────────────────────── */
+
+static void test_full_arena_spills_to_heap(void)
+{
+    http_arena_t *a = http_arena_begin();
+    uint8_t *big = http_arena_malloc(APP_HTTP_ARENA_SIZE - 8);
+    uint8_t *spill = http_arena_malloc(64);
+    TEST_ASSERT_NOT_NULL(spill);
+    TEST_ASSERT_TRUE(spill < big || spill >= big + APP_HTTP_ARENA_SIZE);
+    http_arena_free(spill); /* back to the heap, not the arena */
+    http_arena_end(a, &s_stats);
+    TEST_ASSERT_EQUAL_UINT32(1, s_stats.fallbacks);
+    TEST_ASSERT_EQUAL_UINT32(APP_HTTP_ARENA_SIZE - 8, s_stats.high_water);
+}
+
+static void test_other_task_uses_the_heap(void)
+{
+    http_arena_t *a = http_arena_begin();
+    uint8_t *mine = http_arena_malloc(32);
+
+    s_current = &s_other_task;
+    uint8_t *theirs = http_arena_malloc(32);
+    TEST_ASSERT_TRUE(theirs < mine || theirs >= mine + APP_HTTP_ARENA_SIZE);
+    http_arena_free(theirs);
+
+    s_current = &s_httpd_task;
+    http_arena_end(a, &s_stats);
+    TEST_ASSERT_EQUAL_UINT32(32, s_stats.high_water);
+    TEST_ASSERT_EQUAL_UINT32(0, s_stats.fallbacks);
+}
+
+static void test_exhausted_pool_runs_on_heap(void)
+{
+    http_arena_t *held[APP_HTTP_ARENA_COUNT];
+    for (int i = 0; i < APP_HTTP_ARENA_COUNT; i++) {
+        held[i] = http_arena_begin();
+        TEST_ASSERT_NOT_NULL(held[i]);
+    }
+    TEST_ASSERT_NULL(http_arena_begin());
+    http_arena_end(NULL, &s_stats);
+    TEST_ASSERT_EQUAL_UINT32(1, s_stats.no_arena);
+
+    for (int i = 0; i < APP_HTTP_ARENA_COUNT; i++) {
+        http_arena_end(held[i], NULL);
+    }
+    TEST_ASSERT_NOT_NULL(http_arena_begin());
+    http_arena_end(held[0], NULL);
+}
+
+/* ── cJSON through the hooks ───────────────────────────────────────────── */
+
+static void test_cjson_round_trip_in_arena(void)
+{
+    http_arena_t *a = http_arena_begin();
+    cJSON *root = cJSON_Parse("{\"name\":\"Cone 6\",\"segments\":[{\"rate\":100},{\"rate\":150}]}");
+    TEST_ASSERT_NOT_NULL(root);
+    cJSON_AddNumberToObject(root, "maxTemp", 1222);
+    char *json = http_arena_print(root);
+    cJSON_Delete(root);
+    TEST_ASSERT_EQUAL_STRING("{\"name\":\"Cone 6\",\"segments\":[{\"rate\":100},{\"rate\":150}],\"maxTemp\":1222}",
+                             json);
+    cJSON_free(json);
+    http_arena_end(a, &s_stats);
+    TEST_ASSERT_TRUE(s_stats.high_water > strlen("{\"name\":\"Cone 6\"}"));
+    TEST_ASSERT_EQUAL_UINT32(0, s_stats.fallbacks);
+}
+
+static void test_cjson_without_arena_uses_heap(void)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddStringToObject(root, "type", "temp_update");
+    char *json = http_arena_print(root);
+    cJSON_Delete(root);
+    TEST_ASSERT_EQUAL_STRING("{\"type\":\"temp_update\"}", json);
+    cJSON_free(json);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_allocations_are_aligned_and_contiguous);
+    RUN_TEST(test_end_empties_the_arena);
+    RUN_TEST(test_freeing_newest_block_gives_it_back);
+    RUN_TEST(test_full_arena_spills_to_heap);
+    RUN_TEST(test_other_task_uses_the_heap);
+    RUN_TEST(test_exhausted_pool_runs_on_heap);
+    RUN_TEST(test_cjson_round_trip_in_arena);
+    RUN_TEST(test_cjson_without_arena_uses_heap);
+    return UNITY_END();
+}
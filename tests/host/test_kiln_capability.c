@@ -0,0 +1,211 @@
+#include "kiln_capability.h"
+#include "unity.h"
+
+#include <math.h>
+#include <string.h>
+
+static kiln_cap_t s_cap;
+static kiln_cap_obs_t s_obs;
+
+void setUp(void)
+{
+    memset(&s_cap, 0, sizeof(s_cap));
+    kiln_cap_obs_reset(&s_obs);
+}
+void tearDown(void)
+{
+}
+
+/* `seconds` of 1 s ticks climbing at `rate_ch` from `from_c`. */
+static void climb(float from_c, float rate_ch, int seconds, bool full_power)
+{
+    float t = from_c;
+    for (int i = 0; i < seconds; i++) {
+        float rise = rate_ch / 3600.0f;
+        t += rise;
+        kiln_cap_observe(&s_obs, &s_cap, t, rise, 1.0f, full_power);
+    }
+}
+
+/* One completed firing that spent `seconds` at full power climbing at
+   `rate_ch` through 1100 °C. */
+static void fire_at(float rate_ch, int seconds)
+{
+    kiln_cap_obs_reset(&s_obs);
+    climb(1100.0f, rate_ch, seconds, true);
+    kiln_cap_learn(&s_cap, &s_obs);
+}
+
+#define BIN_1100 (1100 / KILN_CAP_BIN_C)
+
+/* ── Learning ──────────────────────────────────────────────────────────── */
+
+static void test_full_power_climb_teaches_its_bin(void)
+{
+    climb(1100.0f, 90.0f, 1200, true);
+    TEST_ASSERT_TRUE(kiln_cap_learn(&s_cap, &s_obs));
+    TEST_ASSERT_EQUAL_UINT16(90, s_cap.rate_ch[BIN_1100]);
+    TEST_ASSERT_EQUAL_UINT8(1, s_cap.firings[BIN_1100]);
+    TEST_ASSERT_EQUAL_FLOAT(90.0f, kiln_cap_rate(&s_cap, 1120.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, kiln_cap_rate(&s_cap, 1000.0f));
+}
+
+static void test_brief_or_flat_full_power_teaches_nothing(void)
+{
+    climb(1100.0f, 90.0f, (int)KILN_CAP_MIN_OBS_S - 10, true);
+    TEST_ASSERT_FALSE(kiln_cap_learn(&s_cap, &s_obs));
+
+    /* Pinned on and going nowhere: a fault, not the kiln's top speed. */
+    kiln_cap_obs_reset(&s_obs);
+    climb(1100.0f, 0.0f, 1200, true);
+    TEST_ASSERT_FALSE(kiln_cap_learn(&s_cap, &s_obs));
+    TEST_ASSERT_EQUAL_UINT16(0, s_cap.rate_ch[BIN_1100]);
+}
+
+static void test_firings_average_then_track(void)
+{
+    fire_at(90.0f, 1200);
+    fire_at(110.0f, 1200);
+    TEST_ASSERT_EQUAL_UINT16(100, s_cap.rate_ch[BIN_1100]);
+    fire_at(100.0f, 1200);
+    fire_at(100.0f, 1200);
+    TEST_ASSERT_EQUAL_UINT16(100, s_cap.rate_ch[BIN_1100]);
+
+    /* Past the first few, each new firing moves the curve a quarter of the
+       way: ageing elements show through within a handful of firings. */
+    fire_at(60.0f, 1200);
+    TEST_ASSERT_EQUAL_UINT16(90, s_cap.rate_ch[BIN_1100]);
+    TEST_ASSERT_EQUAL_UINT8(5, s_cap.firings[BIN_1100]);
+}
+
+static void test_keeping_up_raises_a_learned_bin_only(void)
+{
+    fire_at(80.0f, 1200);
+
+    /* New elements: the kiln now follows a 120 °C/h ramp at part power. */
+    kiln_cap_obs_reset(&s_obs);
+    climb(1100.0f, 120.0f, 1200, false);
+    climb(600.0f, 120.0f, 1200, false);
+    TEST_ASSERT_TRUE(kiln_cap_learn(&s_cap, &s_obs));
+    TEST_ASSERT_EQUAL_UINT16(120, s_cap.rate_ch[BIN_1100]);
+    TEST_ASSERT_EQUAL_UINT8(1, s_cap.firings[BIN_1100]);
+    TEST_ASSERT_EQUAL_UINT16(0, s_cap.rate_ch[600 / KILN_CAP_BIN_C]);
+
+    /* Keeping up with a slower ramp says nothing new. */
+    kiln_cap_obs_reset(&s_obs);
+    climb(1100.0f, 50.0f, 1200, false);
+    TEST_ASSERT_FALSE(kiln_cap_learn(&s_cap, &s_obs));
+}
+
+/* ── Load ──────────────────────────────────────────────────────────────── */
+
+static void test_load_compares_this_firing_with_the_curve(void)
+{
+    fire_at(100.0f, 1200);
+    kiln_cap_obs_reset(&s_obs);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, kiln_cap_load(&s_obs));
+
+    /* A packed kiln: 80 °C/h where the curve says 100. Needs some evidence
+       before it counts. */
+    climb(1100.0f, 80.0f, 60, true);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, kiln_cap_load(&s_obs));
+    climb(1101.5f, 80.0f, 1800, true);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.8f, kiln_cap_load(&s_obs));
+
+    /* Clamped either side. */
+    kiln_cap_obs_reset(&s_obs);
+    climb(1100.0f, 10.0f, 3600, true);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, kiln_cap_load(&s_obs));
+}
+
+static void test_unlearned_bins_do_not_count_towards_load(void)
+{
+    climb(500.0f, 300.0f, 3600, true);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, kiln_cap_load(&s_obs));
+}
+
+/* ── Planning ──────────────────────────────────────────────────────────── */
+
+static void test_ramp_time_takes_the_slower_of_program_and_kiln(void)
+{
+    /* Unknown kiln: the program at face value. */
+    TEST_ASSERT_EQUAL_FLOAT(7200.0f, kiln_cap_ramp_s(NULL, 1.0f, 1000.0f, 1200.0f, 100.0f));
+    TEST_ASSERT_EQUAL_FLOAT(7200.0f, kiln_cap_ramp_s(&s_cap, 1.0f, 1000.0f, 1200.0f, 100.0f));
+
+    /* 1100-1150 °C at 50 °C/h: that bin costs an hour instead of half. */
+    s_cap.rate_ch[BIN_1100] = 50;
+    s_cap.rate_ch[BIN_1100 - 1] = 400;
+    TEST_ASSERT_EQUAL_FLOAT(9000.0f, kiln_cap_ramp_s(&s_cap, 1.0f, 1000.0f, 1200.0f, 100.0f));
+    TEST_ASSERT_EQUAL_FLOAT(12600.0f, kiln_cap_ramp_s(&s_cap, 0.5f, 1000.0f, 1200.0f, 100.0f));
+
+    /* Part bins count pro rata; a cool is not the curve's business. */
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 1800.0f, kiln_cap_ramp_s(&s_cap, 1.0f, 1125.0f, 1150.0f, 100.0f));
+    TEST_ASSERT_EQUAL_FLOAT(7200.0f, kiln_cap_ramp_s(&s_cap, 1.0f, 1200.0f, 1000.0f, -100.0f));
+}
+
+static void test_shortfall_finds_where_the_ramp_outruns_the_kiln(void)
+{
+    float slowest = -1.0f;
+    TEST_ASSERT_TRUE(isnan(kiln_cap_shortfall(&s_cap, 20.0f, 1222.0f, 150.0f, &slowest)));
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, slowest);
+
+    for (int b = 0; b < KILN_CAP_BINS; b++) {
+        s_cap.rate_ch[b] = (uint16_t)(480 - 15 * b); /* 330 °C/h at 500 °C, 105 at 1250 */
+    }
+    /* 150 °C/h is over the curve by more than the margin from 1150 °C up. */
+    TEST_ASSERT_EQUAL_FLOAT(1150.0f, kiln_cap_shortfall(&s_cap, 20.0f, 1222.0f, 150.0f, &slowest));
+    TEST_ASSERT_EQUAL_FLOAT(120.0f, slowest);
+    TEST_ASSERT_TRUE(isnan(kiln_cap_shortfall(&s_cap, 20.0f, 1100.0f, 150.0f, NULL)));
+
+    /* The first offending point is the ramp's own start when it begins mid-bin. */
+    TEST_ASSERT_EQUAL_FLOAT(1180.0f, kiln_cap_shortfall(&s_cap, 1180.0f, 1222.0f, 150.0f, NULL));
+}
+
+/* ── Energy ────────────────────────────────────────────────────────────── */
+
+static void test_element_time_follows_losses_off_the_curve(void)
+{
+    /* Nothing learned: the flat 50% duty guess. */
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 1800.0f, kiln_cap_ramp_on_s(NULL, 1000.0f, 1100.0f, 100.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 300.0f, kiln_cap_hold_on_s(&s_cap, 1100.0f, 600.0f));
+
+    for (int b = 0; b < KILN_CAP_BINS; b++) {
+        s_cap.rate_ch[b] = (uint16_t)(400 - 10 * b); /* 200 °C/h at 1000 °C, 190 at 1050, 180 at 1100 */
+    }
+    /* Losses eat 200 and 210 °C/h of a 400 °C/h lossless rise: climbing 100
+       more needs 75% and 77.5% of the elements. */
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 2745.0f, kiln_cap_ramp_on_s(&s_cap, 1000.0f, 1100.0f, 100.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 330.0f, kiln_cap_hold_on_s(&s_cap, 1100.0f, 600.0f));
+
+    /* Asking past the curve runs flat out at the curve's pace. */
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 900.0f, kiln_cap_ramp_on_s(&s_cap, 1000.0f, 1050.0f, 500.0f));
+
+    /* A controlled cool tops up the losses; one faster than them is free. */
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 2790.0f, kiln_cap_ramp_on_s(&s_cap, 1100.0f, 1000.0f, -50.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, kiln_cap_ramp_on_s(&s_cap, 1100.0f, 1000.0f, -300.0f));
+}
+
+static void test_out_of_range_temperatures_use_the_end_bins(void)
+{
+    s_cap.rate_ch[0] = 500;
+    s_cap.rate_ch[KILN_CAP_BINS - 1] = 20;
+    TEST_ASSERT_EQUAL_FLOAT(500.0f, kiln_cap_rate(&s_cap, -15.0f));
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, kiln_cap_rate(&s_cap, 1600.0f));
+    TEST_ASSERT_EQUAL_FLOAT(36000.0f, kiln_cap_ramp_s(&s_cap, 1.0f, 1400.0f, 1600.0f, 100.0f));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_full_power_climb_teaches_its_bin);
+    RUN_TEST(test_brief_or_flat_full_power_teaches_nothing);
+    RUN_TEST(test_firings_average_then_track);
+    RUN_TEST(test_keeping_up_raises_a_learned_bin_only);
+    RUN_TEST(test_load_compares_this_firing_with_the_curve);
+    RUN_TEST(test_unlearned_bins_do_not_count_towards_load);
+    RUN_TEST(test_ramp_time_takes_the_slower_of_program_and_kiln);
+    RUN_TEST(test_shortfall_finds_where_the_ramp_outruns_the_kiln);
+    RUN_TEST(test_element_time_follows_losses_off_the_curve);
+    RUN_TEST(test_out_of_range_temperatures_use_the_end_bins);
+    return UNITY_END();
+}
@@ -0,0 +1,285 @@
+#include "app_config.h"
+#include "firing_engine.h"
+#include "firing_engine_internal.h"
+#include "kiln_model.h"
+#include "pid_control.h"
+#include "safety_host.h"
+#include "scenario_helpers.h"
+#include "unity.h"
+
+#include <math.h>
+#include <string.h>
+
+static kiln_model_t g_kiln;
+
+void setUp(void)
+{
+    scenario_setup_thermal(&g_kiln, &KILN_MODEL_SMALL_TEST, 25.0f);
+}
+
+void tearDown(void)
+{
+    scenario_stop();
+}
+
+/* Run the model open-loop at a fixed duty for `seconds`, in 1 s steps. */
+static void run_open_loop(kiln_model_t *m, float duty, int seconds)
+{
+    for (int i = 0; i < seconds; i++) {
+        kiln_model_step(m, duty, 1.0f);
+    }
+}
+
+/* ── Open-loop physics ───────────────────────────────────────────────── */
+
+static void test_presets_resolve_by_short_and_full_name(void)
+{
+    TEST_ASSERT_EQUAL_PTR(&KILN_MODEL_SMALL_TEST, kiln_model_preset("small"));
+    TEST_ASSERT_EQUAL_PTR(&KILN_MODEL_LARGE_PRODUCTION, kiln_model_preset("large"));
+    TEST_ASSERT_EQUAL_PTR(&KILN_MODEL_LARGE_PRODUCTION, kiln_model_preset("large-production"));
+    TEST_ASSERT_NULL(kiln_model_preset("medium"));
+    TEST_ASSERT_NULL(kiln_model_preset(NULL));
+}
+
+static void test_cold_full_power_rate_matches_total_heat_capacity(void)
+{
+    /* Cold, losses are negligible, so the first few minutes heat the combined
+       thermal mass at ~P/C. Measured on stored heat rather than the wall node
+       alone, since the wall leads the load. */
+    kiln_model_t m;
+    kiln_model_init(&m, &KILN_MODEL_SMALL_TEST, 20.0f);
+    run_open_loop(&m, 1.0f, 300);
+    float stored_j = (m.wall_c - 20.0f) * m.p.wall_heat_cap_j_per_c + (m.load_c - 20.0f) * m.p.load_heat_cap_j_per_c;
+    TEST_ASSERT_FLOAT_WITHIN(0.05f * 1800.0f * 300.0f, 1800.0f * 300.0f, stored_j);
+    TEST_ASSERT_TRUE(m.wall_c > m.load_c);
+}
+
+static void test_full_power_equilibrium_near_rated_max(void)
+{
+    const kiln_model_params_t *presets[] = {&KILN_MODEL_SMALL_TEST, &KILN_MODEL_LARGE_PRODUCTION};
+    for (int i = 0; i < 2; i++) {
+        kiln_model_t m;
+        kiln_model_init(&m, presets[i], 20.0f);
+        for (int s = 0; s < 72 * 360; s++) { /* 72 h in 10 s steps */
+            kiln_model_step(&m, 1.0f, 10.0f);
+        }
+        TEST_ASSERT_TRUE_MESSAGE(m.wall_c > 1300.0f && m.wall_c < 1450.0f, presets[i]->name);
+        /* At equilibrium the elements exactly cover the losses. */
+        TEST_ASSERT_FLOAT_WITHIN(0.01f * kiln_model_element_power_w(&m), kiln_model_element_power_w(&m),
+                                 kiln_model_loss_w(&m, m.wall_c));
+    }
+}
+
+static void test_large_kiln_cannot_follow_fast_ramp_near_peak(void)
+{
+    /* The whole point of the large preset: near cone 6 it heats far slower
+       than a typical 150 °C/hr final ramp asks for. */
+    kiln_model_t m;
+    kiln_model_init(&m, &KILN_MODEL_LARGE_PRODUCTION, 1200.0f);
+    run_open_loop(&m, 1.0f, 3600);
+    float rise = m.wall_c - 1200.0f;
+    TEST_ASSERT_TRUE(rise > 40.0f);
+    TEST_ASSERT_TRUE(rise < 150.0f);
+}
+
+static void test_zero_duty_cools_monotonically_toward_ambient(void)
+{
+    kiln_model_t m;
+    kiln_model_init(&m, &KILN_MODEL_SMALL_TEST, 1000.0f);
+    float prev = m.wall_c;
+    for (int i = 0; i < 48 * 60; i++) { /* 48 h in 60 s steps */
+        kiln_model_step(&m, 0.0f, 60.0f);
+        TEST_ASSERT_TRUE(m.wall_c <= prev + 1e-3f);
+        TEST_ASSERT_TRUE(m.wall_c >= m.ambient_c - 0.01f);
+        prev = m.wall_c;
+    }
+    TEST_ASSERT_TRUE(m.wall_c < 100.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, (float)m.energy_j);
+}
+
+static void test_energy_integrates_delivered_power(void)
+{
+    kiln_model_t m;
+    kiln_model_init(&m, &KILN_MODEL_SMALL_TEST, 20.0f);
+    run_open_loop(&m, 0.5f, 600);
+    /* Cold, the TCR derate is tiny — half duty for 10 min ≈ 0.15 kWh. */
+    TEST_ASSERT_FLOAT_WITHIN(0.01 * 540000.0, 540000.0, m.energy_j);
+}
+
+static void test_element_power_falls_with_temperature_and_health(void)
+{
+    kiln_model_t m;
+    kiln_model_init(&m, &KILN_MODEL_LARGE_PRODUCTION, 20.0f);
+    float p_cold = kiln_model_element_power_w(&m);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 11500.0f, p_cold);
+    m.wall_c = 1200.0f;
+    float p_hot = kiln_model_element_power_w(&m);
+    TEST_ASSERT_TRUE(p_hot < p_cold);
+    m.element_health = 0.8f;
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 0.8f * p_hot, kiln_model_element_power_w(&m));
+}
+
+static void test_duty_is_clamped_and_nan_is_off(void)
+{
+    kiln_model_t a, b;
+    kiln_model_init(&a, &KILN_MODEL_SMALL_TEST, 20.0f);
+    kiln_model_init(&b, &KILN_MODEL_SMALL_TEST, 20.0f);
+    kiln_model_step(&a, 5.0f, 1.0f);
+    kiln_model_step(&b, 1.0f, 1.0f);
+    TEST_ASSERT_EQUAL_FLOAT(b.wall_c, a.wall_c);
+    kiln_model_step(&a, NAN, 1.0f);
+    TEST_ASSERT_TRUE(isfinite(a.wall_c));
+    TEST_ASSERT_TRUE(a.energy_j == b.energy_j);
+}
+
+static void test_tc_reading_lags_and_is_quantized(void)
+{
+    kiln_model_t m;
+    kiln_model_init(&m, &KILN_MODEL_SMALL_TEST, 500.0f);
+    /* Step the wall up 40 °C instantly; after one sheath time constant the
+       junction has covered ~63% of it. */
+    m.wall_c = 540.0f;
+    m.load_c = 540.0f;
+    kiln_model_step(&m, 0.0f, m.p.tc_tau_s);
+    float covered = (m.tc_c - 500.0f) / (m.wall_c - 500.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.03f, 0.632f, covered);
+
+    float r = kiln_model_tc_reading(&m);
+    TEST_ASSERT_FLOAT_WITHIN(0.125f, m.tc_c, r);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, fmodf(r, 0.25f));
+}
+
+/* ── Closed loop through the real firing engine ──────────────────────── */
+
+static firing_profile_t moderate_profile(void)
+{
+    firing_profile_t p = {0};
+    strncpy(p.id, "thermal", FIRING_ID_LEN - 1);
+    strncpy(p.name, "Thermal", FIRING_NAME_LEN - 1);
+    p.segment_count = 2;
+    p.max_temp = 600.0f;
+    p.segments[0].ramp_rate = 200.0f;
+    p.segments[0].target_temp = 300.0f;
+    p.segments[0].hold_time = 10;
+    p.segments[1].ramp_rate = 150.0f;
+    p.segments[1].target_temp = 600.0f;
+    p.segments[1].hold_time = 10;
+    return p;
+}
+
+static void test_closed_loop_firing_completes_and_tracks_on_small_kiln(void)
+{
+    firing_profile_t p = moderate_profile();
+    scenario_start(&p, 0);
+
+    scenario_track_t track = {0};
+    /* ~1.4 h + 2 × 10 min holds planned; allow 4 h. */
+    bool done = scenario_run_until_status_thermal(&g_kiln, FIRING_STATUS_COMPLETE, 4 * 3600, &track);
+    TEST_ASSERT_TRUE_MESSAGE(done, "closed-loop firing did not complete");
+    TEST_ASSERT_EQUAL(FIRING_ERR_NONE, firing_engine_get_error_code());
+
+    /* Default gains are untuned, so only a loose bound — the point is that the
+       metric exists and is finite, not that it is small. */
+    float rms = scenario_track_rms(&track);
+    TEST_ASSERT_TRUE(isfinite(rms));
+    TEST_ASSERT_TRUE(rms < 15.0f);
+    TEST_ASSERT_TRUE(track.max_overshoot_c < 25.0f);
+    TEST_ASSERT_TRUE(g_kiln.energy_j > 0.0);
+    TEST_ASSERT_TRUE(g_kiln.wall_c > 550.0f);
+}
+
+static void test_closed_loop_duty_drops_to_zero_when_paused(void)
+{
+    firing_profile_t p = moderate_profile();
+    scenario_start(&p, 0);
+    scenario_run_ticks_thermal(&g_kiln, 600, NULL);
+    scenario_pause();
+    double e_before = g_kiln.energy_j;
+    scenario_run_ticks_thermal(&g_kiln, 300, NULL);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, safety_test_last_duty());
+    TEST_ASSERT_TRUE(g_kiln.energy_j == e_before);
+}
+
+static void test_closed_loop_learns_capability_and_eta_follows(void)
+{
+    /* A 150 °C/h finish the large kiln can't follow: the first firing pins
+       the elements from ~1100 °C up and teaches the curve what they manage. */
+    scenario_setup_thermal(&g_kiln, &KILN_MODEL_LARGE_PRODUCTION, 1000.0f);
+    firing_profile_t p = {0};
+    strncpy(p.id, "fast-finish", FIRING_ID_LEN - 1);
+    p.segment_count = 1;
+    p.max_temp = 1222.0f;
+    p.segments[0].ramp_rate = 150.0f;
+    p.segments[0].target_temp = 1222.0f;
+    scenario_start(&p, 0);
+    TEST_ASSERT_TRUE(scenario_run_until_status_thermal(&g_kiln, FIRING_STATUS_COMPLETE, 6 * 3600, NULL));
+
+    kiln_cap_t cap;
+    firing_engine_get_capability(&cap);
+    int bin = 1150 / KILN_CAP_BIN_C;
+    TEST_ASSERT_EQUAL_UINT8(1, cap.firings[bin]);
+
+    /* What the model really does there at full power. */
+    kiln_model_t m;
+    kiln_model_init(&m, &KILN_MODEL_LARGE_PRODUCTION, 1150.0f);
+    run_open_loop(&m, 1.0f, 1800);
+    float true_rate = (m.wall_c - 1150.0f) * 2.0f;
+    TEST_ASSERT_FLOAT_WITHIN(0.25f * true_rate, true_rate, (float)cap.rate_ch[bin]);
+
+    /* The next firing's ETA plans the finish at the kiln's pace, not 150:
+       about a quarter longer than the program alone says. */
+    kiln_model_init(&g_kiln, &KILN_MODEL_LARGE_PRODUCTION, 1000.0f);
+    scenario_start(&p, 0);
+    scenario_run_ticks_thermal(&g_kiln, 2, NULL);
+    firing_progress_t prog;
+    firing_engine_get_progress(&prog);
+    uint32_t naive = firing_remaining_s(&p, 0, prog.current_temp, false, 0.0f, NULL, 1.0f);
+    TEST_ASSERT_TRUE(prog.estimated_remaining > naive * 5 / 4);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, prog.kiln_load);
+}
+
+static void test_closed_loop_autotune_completes_in_virtual_time(void)
+{
+    /* Relay autotune through the engine: auto-tune runs on firing_tick's
+       now_us, so a whole heat-up + 5 relay cycles is simulated here in
+       milliseconds. Runs last — a completed tune installs its gains in the
+       engine's PID for the rest of the process. Start warm, as after a firing:
+       auto-tune's heat-up budget is shorter than a cold small kiln needs. */
+    scenario_setup_thermal(&g_kiln, &KILN_MODEL_SMALL_TEST, 420.0f);
+    scenario_autotune_start(500.0f, 5.0f);
+    TEST_ASSERT_EQUAL(FIRING_STATUS_AUTOTUNE, scenario_run_ticks_thermal(&g_kiln, 1, NULL));
+
+    bool done = scenario_run_until_status_thermal(&g_kiln, FIRING_STATUS_IDLE, 3 * 3600, NULL);
+    TEST_ASSERT_TRUE_MESSAGE(done, "autotune did not finish");
+    TEST_ASSERT_EQUAL(FIRING_ERR_NONE, firing_engine_get_error_code());
+
+    /* Gains were saved, and are the plant's rather than the defaults. */
+    float kp = 0, ki = 0, kd = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, pid_load_gains(&kp, &ki, &kd));
+    TEST_ASSERT_TRUE(kp > 0.0f && ki > 0.0f && kd > 0.0f);
+    TEST_ASSERT_TRUE(isfinite(kp) && isfinite(ki) && isfinite(kd));
+    TEST_ASSERT_FALSE(kp == APP_PID_KP_DEFAULT);
+    /* The relay held the kiln around the setpoint the whole time. */
+    TEST_ASSERT_FLOAT_WITHIN(60.0f, 500.0f, g_kiln.wall_c);
+}
+
+int main(void)
+{
+    firing_engine_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_presets_resolve_by_short_and_full_name);
+    RUN_TEST(test_cold_full_power_rate_matches_total_heat_capacity);
+    RUN_TEST(test_full_power_equilibrium_near_rated_max);
+    RUN_TEST(test_large_kiln_cannot_follow_fast_ramp_near_peak);
+    RUN_TEST(test_zero_duty_cools_monotonically_toward_ambient);
+    RUN_TEST(test_energy_integrates_delivered_power);
+    RUN_TEST(test_element_power_falls_with_temperature_and_health);
+    RUN_TEST(test_duty_is_clamped_and_nan_is_off);
+    RUN_TEST(test_tc_reading_lags_and_is_quantized);
+    RUN_TEST(test_closed_loop_firing_completes_and_tracks_on_small_kiln);
+    RUN_TEST(test_closed_loop_duty_drops_to_zero_when_paused);
+    RUN_TEST(test_closed_loop_learns_capability_and_eta_follows);
+    RUN_TEST(test_closed_loop_autotune_completes_in_virtual_time);
+    return UNITY_END();
+}
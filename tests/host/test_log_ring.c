@@ -0,0 +1,297 @@
+#include "log_ring.h"
+#include "unity.h"
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#define RING_BYTES 4096
+#define BUILD_ID   0x12345678u
+
+static const char s_anchor[] = "test anchor";
+static uint64_t s_mem[RING_BYTES / sizeof(uint64_t)];
+static log_ring_t s_ring;
+/* The test's literals sit in .rodata next to the anchor; a window around it
+   stands in for the linker's bounds. */
+static log_ring_strings_t s_strings;
+
+void setUp(void)
+{
+    s_strings = (log_ring_strings_t){
+        .anchor = s_anchor,
+        .lo = (const char *)((uintptr_t)s_anchor - (1u << 20)),
+        .hi = (const char *)((uintptr_t)s_anchor + (1u << 20)),
+    };
+    memset(s_mem, 0xA5, sizeof(s_mem)); /* what noinit memory holds after power-up */
+    log_ring_attach(&s_ring, s_mem, sizeof(s_mem), &s_strings, BUILD_ID);
+}
+void tearDown(void)
+{
+}
+
+/* Encode the way the esp_log hook would be handed the line. */
+static size_t encode(uint8_t *rec, uint32_t now_ms, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    size_t len = log_ring_encode(rec, &s_strings, now_ms, fmt, ap);
+    va_end(ap);
+    return len;
+}
+
+static void append(const char *fmt, int n)
+{
+    uint8_t rec[LOG_RING_REC_MAX];
+    encode(rec, 0, fmt, n);
+    log_ring_append(&s_ring, rec);
+}
+
+static log_ring_entry_t decode(const uint8_t *rec)
+{
+    log_ring_entry_t e;
+    log_ring_decode(rec, &s_strings, 0, &e);
+    return e;
+}
+
+/* ── Encoding ──────────────────────────────────────────────────────────── */
+
+#define CHECK_ROUND_TRIP(fmt, ...)                                                                 \
+    do {                                                                                           \
+        char want[LOG_RING_MSG_MAX];                                                               \
+        uint8_t rec_[LOG_RING_REC_MAX];                                                            \
+        snprintf(want, sizeof(want), fmt, __VA_ARGS__);                                            \
+        encode(rec_, 0, fmt, __VA_ARGS__);                                                         \
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(want, decode(rec_).msg, fmt);                             \
+    } while (0)
+
+static void test_arguments_round_trip(void)
+{
+    CHECK_ROUND_TRIP("plain %d", -42);
+    CHECK_ROUND_TRIP("%u %x %X %o %#x", 4000000000u, 0xbeefu, 0xbeefu, 8u, 255u);
+    CHECK_ROUND_TRIP("%ld %lu %lld %llu", -1L, 123456789UL, -9000000000LL, 18000000000000000000ULL);
+    CHECK_ROUND_TRIP("%hd %hhu %zu %jd %td", (short)-5, (unsigned char)200, (size_t)77, (intmax_t)-3, (ptrdiff_t)9);
+    CHECK_ROUND_TRIP("%" PRIu32 " %" PRId64 " %" PRIx16, (uint32_t)1234, (int64_t)-5, (uint16_t)0xabc);
+    CHECK_ROUND_TRIP("%.1f°C %e %g %8.3f|", 1222.25, 0.000123, 3.5, -2.0);
+    CHECK_ROUND_TRIP("%s=%-6s|%.3s %c", "key", "v", "truncate", 'Z');
+    CHECK_ROUND_TRIP("%*d|%-*.*f|%.*s", 5, 42, 8, 2, 3.14159, 2, "abc");
+    CHECK_ROUND_TRIP("100%% done, %d%%", 7);
+    CHECK_ROUND_TRIP("%p", (void *)0x1234);
+}
+
+static void test_null_string_prints_as_null(void)
+{
+    uint8_t rec[LOG_RING_REC_MAX];
+    encode(rec, 0, "name=%s", (const char *)NULL);
+    TEST_ASSERT_EQUAL_STRING("name=(null)", decode(rec).msg);
+}
+
+static void test_idf_prefix_becomes_level_time_and_tag(void)
+{
+    static const char tag[] = "firing";
+    uint8_t rec[LOG_RING_REC_MAX];
+    encode(rec, 999, "\033[0;33mW (%" PRIu32 ") %s: segment %d overshoot %.1f\033[0m\n", (uint32_t)51234, tag, 3,
+           4.5);
+    log_ring_entry_t e = decode(rec);
+    TEST_ASSERT_EQUAL_CHAR('W', e.level);
+    TEST_ASSERT_EQUAL_CHAR('W', log_ring_rec_level(rec));
+    TEST_ASSERT_EQUAL_UINT32(51234, e.t_ms);
+    TEST_ASSERT_EQUAL_STRING("firing", e.tag);
+    TEST_ASSERT_EQUAL_STRING("segment 3 overshoot 4.5", e.msg);
+    TEST_ASSERT_FALSE(e.truncated);
+}
+
+static void test_other_lines_are_info_at_now(void)
+{
+    uint8_t rec[LOG_RING_REC_MAX];
+    encode(rec, 777, "raw line %d\n", 5);
+    log_ring_entry_t e = decode(rec);
+    TEST_ASSERT_EQUAL_CHAR('I', e.level);
+    TEST_ASSERT_EQUAL_UINT32(777, e.t_ms);
+    TEST_ASSERT_EQUAL_STRING("", e.tag);
+    TEST_ASSERT_EQUAL_STRING("raw line 5", e.msg);
+}
+
+static void test_long_strings_are_clipped(void)
+{
+    char longer[LOG_RING_STR_MAX + 20];
+    memset(longer, 'x', sizeof(longer) - 1);
+    longer[sizeof(longer) - 1] = '\0';
+    uint8_t rec[LOG_RING_REC_MAX];
+    encode(rec, 0, "[%s]", longer);
+    log_ring_entry_t e = decode(rec);
+    TEST_ASSERT_EQUAL_size_t(LOG_RING_STR_MAX + 2, strlen(e.msg));
+    TEST_ASSERT_FALSE(e.truncated);
+}
+
+static void test_arguments_past_the_record_are_dropped(void)
+{
+    char s[LOG_RING_STR_MAX + 1];
+    memset(s, 'y', LOG_RING_STR_MAX);
+    s[LOG_RING_STR_MAX] = '\0';
+    uint8_t rec[LOG_RING_REC_MAX];
+    size_t len = encode(rec, 0, "%s %s %s %d", s, s, s, 9);
+    TEST_ASSERT_TRUE(len <= LOG_RING_REC_MAX);
+    log_ring_entry_t e = decode(rec);
+    TEST_ASSERT_TRUE(e.truncated);
+    TEST_ASSERT_NOT_NULL(strstr(e.msg, " [truncated]"));
+    TEST_ASSERT_NULL(strstr(e.msg, "9"));
+}
+
+/* ── String ids ────────────────────────────────────────────────────────── */
+
+#define REC_TAG 8  /* header offsets of the tag and format ids */
+#define REC_FMT 12
+
+static void test_a_format_built_at_run_time_reads_as_a_question_mark(void)
+{
+    char fmt[16];
+    snprintf(fmt, sizeof(fmt), "built %s", "%d");
+    uint8_t rec[LOG_RING_REC_MAX];
+    TEST_ASSERT_EQUAL(LOG_RING_HDR_SIZE, encode(rec, 0, fmt, 5));
+    TEST_ASSERT_EQUAL_STRING("?", decode(rec).msg);
+}
+
+static void test_an_id_outside_the_strings_reads_as_a_question_mark(void)
+{
+    static const char tag[] = "firing";
+    uint8_t rec[LOG_RING_REC_MAX];
+    encode(rec, 0, "I (%" PRIu32 ") %s: cone %d", (uint32_t)1, tag, 6);
+    int32_t far = 1 << 30;
+    memcpy(rec + REC_TAG, &far, sizeof(far));
+    memcpy(rec + REC_FMT, &far, sizeof(far));
+
+    log_ring_entry_t e = decode(rec);
+    TEST_ASSERT_EQUAL_STRING("?", e.tag);
+    TEST_ASSERT_EQUAL_STRING("?", e.msg);
+}
+
+static void test_a_string_must_end_inside_the_strings(void)
+{
+    uint8_t rec[LOG_RING_REC_MAX];
+    s_strings.lo = s_anchor;
+    s_strings.hi = s_anchor + sizeof(s_anchor);
+    encode(rec, 0, s_anchor);
+    TEST_ASSERT_EQUAL_STRING("test anchor", decode(rec).msg);
+
+    s_strings.hi--; /* the NUL is now past the end */
+    TEST_ASSERT_EQUAL_STRING("?", decode(rec).msg);
+}
+
+/* ── Ring ──────────────────────────────────────────────────────────────── */
+
+static void test_fetch_returns_lines_in_order(void)
+{
+    for (int i = 0; i < 5; i++) {
+        append("line %d", i);
+    }
+    uint64_t cursor = 0, at, prev = 0;
+    uint8_t rec[LOG_RING_REC_MAX];
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_NOT_EQUAL(0, log_ring_fetch(&s_ring, &cursor, rec, &at));
+        char want[16];
+        snprintf(want, sizeof(want), "line %d", i);
+        TEST_ASSERT_EQUAL_STRING(want, decode(rec).msg);
+        TEST_ASSERT_TRUE(i == 0 || at > prev);
+        prev = at;
+    }
+    TEST_ASSERT_EQUAL(0, log_ring_fetch(&s_ring, &cursor, rec, &at));
+    TEST_ASSERT_EQUAL_UINT64(s_ring.hdr->next, cursor);
+}
+
+static void test_wrapping_drops_oldest_and_keeps_the_rest(void)
+{
+    /* 20-36 byte records, so the end of the ring falls mid-record on some
+       laps and leaves too little for a header on others. */
+    static const char pad[] = "................";
+    const int total = 2000;
+    for (int i = 0; i < total; i++) {
+        uint8_t rec[LOG_RING_REC_MAX];
+        encode(rec, 0, "n=%d %s", i, pad + i % 17);
+        log_ring_append(&s_ring, rec);
+    }
+    TEST_ASSERT_TRUE(s_ring.hdr->next - s_ring.hdr->oldest <= s_ring.hdr->size);
+    TEST_ASSERT_TRUE(s_ring.hdr->oldest > 0);
+
+    /* A reader from the start was lapped: it resumes at the oldest line and
+       then sees every line up to the newest without a gap. */
+    uint64_t cursor = 0, at;
+    uint8_t rec[LOG_RING_REC_MAX];
+    int expect = -1, seen = 0;
+    while (log_ring_fetch(&s_ring, &cursor, rec, &at)) {
+        int n;
+        TEST_ASSERT_EQUAL(1, sscanf(decode(rec).msg, "n=%d ", &n));
+        TEST_ASSERT_TRUE(expect < 0 || n == expect);
+        expect = n + 1;
+        seen++;
+    }
+    TEST_ASSERT_EQUAL(total, expect);
+    TEST_ASSERT_TRUE(seen > 100);
+}
+
+static void test_cursor_from_before_a_reset_starts_over(void)
+{
+    append("only %d", 1);
+    uint64_t cursor = 1000000, at;
+    uint8_t rec[LOG_RING_REC_MAX];
+    TEST_ASSERT_NOT_EQUAL(0, log_ring_fetch(&s_ring, &cursor, rec, &at));
+    TEST_ASSERT_EQUAL_STRING("only 1", decode(rec).msg);
+}
+
+/* ── Attach ────────────────────────────────────────────────────────────── */
+
+static void test_reattach_keeps_lines_of_the_same_build(void)
+{
+    append("before reboot %d", 1);
+    uint64_t next = s_ring.hdr->next;
+
+    TEST_ASSERT_TRUE(log_ring_attach(&s_ring, s_mem, sizeof(s_mem), &s_strings, BUILD_ID));
+    TEST_ASSERT_EQUAL_UINT64(next, s_ring.hdr->next);
+    TEST_ASSERT_EQUAL_UINT32(1, s_ring.hdr->boots);
+
+    uint64_t cursor = 0, at;
+    uint8_t rec[LOG_RING_REC_MAX];
+    TEST_ASSERT_NOT_EQUAL(0, log_ring_fetch(&s_ring, &cursor, rec, &at));
+    TEST_ASSERT_EQUAL_STRING("before reboot 1", decode(rec).msg);
+}
+
+static void test_other_build_starts_empty(void)
+{
+    append("old image %d", 1);
+    TEST_ASSERT_FALSE(log_ring_attach(&s_ring, s_mem, sizeof(s_mem), &s_strings, BUILD_ID + 1));
+    TEST_ASSERT_EQUAL_UINT64(0, s_ring.hdr->next);
+    TEST_ASSERT_EQUAL_UINT32(0, s_ring.hdr->boots);
+}
+
+static void test_corrupt_record_cuts_the_ring_there(void)
+{
+    append("good %d", 1);
+    uint64_t good_end = s_ring.hdr->next;
+    append("bad %d", 2);
+    append("after %d", 3);
+    s_ring.data[good_end + LOG_RING_HDR_SIZE] ^= 0xFF; /* flip a byte of the second record */
+
+    TEST_ASSERT_TRUE(log_ring_attach(&s_ring, s_mem, sizeof(s_mem), &s_strings, BUILD_ID));
+    TEST_ASSERT_EQUAL_UINT64(good_end, s_ring.hdr->next);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_arguments_round_trip);
+    RUN_TEST(test_null_string_prints_as_null);
+    RUN_TEST(test_idf_prefix_becomes_level_time_and_tag);
+    RUN_TEST(test_other_lines_are_info_at_now);
+    RUN_TEST(test_long_strings_are_clipped);
+    RUN_TEST(test_arguments_past_the_record_are_dropped);
+    RUN_TEST(test_a_format_built_at_run_time_reads_as_a_question_mark);
+    RUN_TEST(test_an_id_outside_the_strings_reads_as_a_question_mark);
+    RUN_TEST(test_a_string_must_end_inside_the_strings);
+    RUN_TEST(test_fetch_returns_lines_in_order);
+    RUN_TEST(test_wrapping_drops_oldest_and_keeps_the_rest);
+    RUN_TEST(test_cursor_from_before_a_reset_starts_over);
+    RUN_TEST(test_reattach_keeps_lines_of_the_same_build);
+    RUN_TEST(test_other_build_starts_empty);
+    RUN_TEST(test_corrupt_record_cuts_the_ring_there);
+    return UNITY_END();
+}
@@ -144,6 +144,40 @@ static void test_pid_reset_clears_derivative_filter(void)
     TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, out);
 }
 
+static void test_pid_settles_only_once_derivative_has_decayed(void)
+{
+    pid_controller_t pid;
+    pid_init(&pid, 0.05f, 0.001f, 5.0f, 0.0f, 1.0f);
+    TEST_ASSERT_FALSE(pid_is_settled(&pid, 500.0f, 500.0f)); /* never computed */
+
+    /* Ramp in, then sit exactly on the setpoint. */
+    for (int i = 0; i < 60; i++) {
+        pid_compute(&pid, 440.0f + i, 440.0f + i, 1.0f);
+    }
+    pid_compute(&pid, 500.0f, 500.0f, 1.0f);
+    TEST_ASSERT_FALSE(pid_is_settled(&pid, 500.0f, 500.0f)); /* ramp rate still in the filter */
+    TEST_ASSERT_FALSE(pid_is_settled(&pid, 500.0f, 499.75f));
+
+    int ticks = 1;
+    while (!pid_is_settled(&pid, 500.0f, 500.0f) && ticks < 1000) {
+        pid_compute(&pid, 500.0f, 500.0f, 1.0f);
+        ticks++;
+    }
+    TEST_ASSERT_TRUE(ticks < 1000);
+
+    /* Settled: any dt — one tick or an hour — gives the same output. */
+    pid_controller_t a = pid, b = pid;
+    float out_1s = 0.0f;
+    for (int i = 0; i < 3600; i++) {
+        out_1s = pid_compute(&a, 500.0f, 500.0f, 1.0f);
+    }
+    float out_1h = pid_compute(&b, 500.0f, 500.0f, 3600.0f);
+    TEST_ASSERT_EQUAL_FLOAT(out_1s, out_1h);
+    TEST_ASSERT_TRUE(out_1s == out_1h);
+    TEST_ASSERT_TRUE(a.integral == b.integral);
+    TEST_ASSERT_FALSE(pid_is_settled(&a, 500.0f, 501.0f));
+}
+
 /* ── pid_load_gains defaults / save & reload roundtrip ──────────────────── */
 
 static void test_pid_load_returns_defaults_when_no_nvs(void)
@@ -173,44 +207,47 @@ static void test_pid_save_and_load_roundtrip(void)
 static void test_autotune_rejects_invalid_args(void)
 {
     pid_autotune_t at;
-    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, pid_autotune_start(&at, 0.0f, 1.0f));
-    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, pid_autotune_start(&at, 100.0f, 0.0f));
-    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, pid_autotune_start(&at, -10.0f, 5.0f));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, pid_autotune_start(&at, 0.0f, 1.0f, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, pid_autotune_start(&at, 100.0f, 0.0f, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, pid_autotune_start(&at, -10.0f, 5.0f, 0));
     /* NaN slips past a bare `<= 0` check (every comparison with NaN is false),
        so it must be rejected explicitly. */
-    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, pid_autotune_start(&at, NAN, 5.0f));
-    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, pid_autotune_start(&at, 500.0f, NAN));
-    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, pid_autotune_start(&at, INFINITY, 5.0f));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, pid_autotune_start(&at, NAN, 5.0f, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, pid_autotune_start(&at, 500.0f, NAN, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, pid_autotune_start(&at, INFINITY, 5.0f, 0));
 }
 
 static void test_autotune_starts_in_heating_state(void)
 {
     pid_autotune_t at;
-    TEST_ASSERT_EQUAL(ESP_OK, pid_autotune_start(&at, 100.0f, 5.0f));
+    int64_t now = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, pid_autotune_start(&at, 100.0f, 5.0f, now));
     TEST_ASSERT_EQUAL(AUTOTUNE_HEATING_TO_SETPOINT, at.state);
     TEST_ASSERT_FALSE(pid_autotune_is_complete(&at));
     /* Initial output is full-on while heating. */
     float out = 0.0f;
-    pid_autotune_update(&at, 20.0f, &out);
+    pid_autotune_update(&at, 20.0f, now, &out);
     TEST_ASSERT_EQUAL_FLOAT(1.0f, out);
 }
 
 static void test_autotune_transitions_to_relay_cycling_at_setpoint(void)
 {
     pid_autotune_t at;
-    pid_autotune_start(&at, 100.0f, 5.0f);
+    int64_t now = 0;
+    pid_autotune_start(&at, 100.0f, 5.0f, now);
     float out = 0.0f;
-    pid_autotune_update(&at, 96.0f, &out); /* reached setpoint - hysteresis */
+    pid_autotune_update(&at, 96.0f, now, &out); /* reached setpoint - hysteresis */
     TEST_ASSERT_EQUAL(AUTOTUNE_RELAY_CYCLING, at.state);
 }
 
 static void test_autotune_completes_with_sane_gains_under_synthetic_oscillation(void)
 {
     pid_autotune_t at;
-    pid_autotune_start(&at, 100.0f, 5.0f);
+    int64_t now = 0;
+    pid_autotune_start(&at, 100.0f, 5.0f, now);
     float out = 0.0f;
     /* Push state machine into RELAY_CYCLING. */
-    pid_autotune_update(&at, 96.0f, &out);
+    pid_autotune_update(&at, 96.0f, now, &out);
 
     /* Simulate symmetric oscillation around the setpoint at a fixed period.
        Each "half cycle" is 30 s of virtual time, peak amplitude 10°C. */
@@ -220,10 +257,10 @@ static void test_autotune_completes_with_sane_gains_under_synthetic_oscillation(
         float peak_temp = above ? 110.0f : 90.0f;
         /* Snap to the peak then walk back across the setpoint over 30 s. */
         for (int s = 0; s < 30 && at.state == AUTOTUNE_RELAY_CYCLING; s++) {
-            host_clock_advance(1000000); /* +1 s */
+            now += 1000000; /* +1 s */
             float t = above ? (110.0f - 0.667f * s) : (90.0f + 0.667f * s);
             (void)peak_temp;
-            pid_autotune_update(&at, t, &out);
+            pid_autotune_update(&at, t, now, &out);
         }
     }
 
@@ -240,16 +277,17 @@ static void test_autotune_completes_with_sane_gains_under_synthetic_oscillation(
 static void test_autotune_ku_uses_relay_half_amplitude(void)
 {
     pid_autotune_t at;
-    pid_autotune_start(&at, 100.0f, 5.0f);
+    int64_t now = 0;
+    pid_autotune_start(&at, 100.0f, 5.0f, now);
     float out = 0.0f;
-    pid_autotune_update(&at, 95.0f, &out); /* enter relay cycling */
+    pid_autotune_update(&at, 95.0f, now, &out); /* enter relay cycling */
 
     /* Drive a clean square oscillation: 110°C for 20 s, 90°C for 20 s, so every
        measured cycle has amplitude exactly 10°C. */
     for (int s = 1; s <= 400 && at.state == AUTOTUNE_RELAY_CYCLING; s++) {
-        host_clock_advance(1000000);
+        now += 1000000;
         float t = (((s - 1) / 20) % 2 == 0) ? 110.0f : 90.0f;
-        pid_autotune_update(&at, t, &out);
+        pid_autotune_update(&at, t, now, &out);
     }
 
     TEST_ASSERT_EQUAL(AUTOTUNE_COMPLETE, at.state);
@@ -262,22 +300,23 @@ static void test_autotune_ku_uses_relay_half_amplitude(void)
 static void test_autotune_timeout_resets_when_cycling_starts(void)
 {
     pid_autotune_t at;
-    pid_autotune_start(&at, 100.0f, 5.0f);
+    int64_t now = 0;
+    pid_autotune_start(&at, 100.0f, 5.0f, now);
     float out = 0.0f;
 
     /* Spend 50 min heating to setpoint (under the 60-min heat-up budget). */
-    host_clock_advance(50LL * 60 * 1000000);
-    pid_autotune_update(&at, 20.0f, &out);
+    now += 50LL * 60 * 1000000;
+    pid_autotune_update(&at, 20.0f, now, &out);
     TEST_ASSERT_EQUAL(AUTOTUNE_HEATING_TO_SETPOINT, at.state);
 
     /* Reach setpoint → cycling. The cycling timeout must start fresh; if it
        inherited the 50 min already elapsed, 30 more min would trip the 60-min
        cap and fail. */
-    pid_autotune_update(&at, 96.0f, &out);
+    pid_autotune_update(&at, 96.0f, now, &out);
     TEST_ASSERT_EQUAL(AUTOTUNE_RELAY_CYCLING, at.state);
 
-    host_clock_advance(30LL * 60 * 1000000);
-    bool done = pid_autotune_update(&at, 101.0f, &out);
+    now += 30LL * 60 * 1000000;
+    bool done = pid_autotune_update(&at, 101.0f, now, &out);
     TEST_ASSERT_FALSE(done);
     TEST_ASSERT_EQUAL(AUTOTUNE_RELAY_CYCLING, at.state);
 }
@@ -285,12 +324,13 @@ static void test_autotune_timeout_resets_when_cycling_starts(void)
 static void test_autotune_times_out_after_60_minutes(void)
 {
     pid_autotune_t at;
-    pid_autotune_start(&at, 100.0f, 5.0f);
+    int64_t now = 0;
+    pid_autotune_start(&at, 100.0f, 5.0f, now);
     float out = 0.0f;
     /* Advance virtual time past the timeout (60 min). Use a temp below the
        hysteresis band so we never leave HEATING_TO_SETPOINT on our own. */
-    host_clock_advance(61LL * 60 * 1000000);
-    bool done = pid_autotune_update(&at, 20.0f, &out);
+    now += 61LL * 60 * 1000000;
+    bool done = pid_autotune_update(&at, 20.0f, now, &out);
     TEST_ASSERT_TRUE(done);
     TEST_ASSERT_EQUAL(AUTOTUNE_FAILED, at.state);
 }
@@ -298,16 +338,128 @@ static void test_autotune_times_out_after_60_minutes(void)
 static void test_autotune_cancel_returns_to_idle(void)
 {
     pid_autotune_t at;
-    pid_autotune_start(&at, 100.0f, 5.0f);
+    int64_t now = 0;
+    pid_autotune_start(&at, 100.0f, 5.0f, now);
     pid_autotune_cancel(&at);
     TEST_ASSERT_EQUAL(AUTOTUNE_IDLE, at.state);
     /* Update on an idle controller returns done=true with output 0. */
     float out = 0.5f;
-    bool done = pid_autotune_update(&at, 50.0f, &out);
+    bool done = pid_autotune_update(&at, 50.0f, now, &out);
     TEST_ASSERT_TRUE(done);
     TEST_ASSERT_EQUAL_FLOAT(0.0f, out);
 }
 
+static void test_autotune_runs_on_caller_time_not_the_global_clock(void)
+{
+    /* The global clock stays at 0 throughout; only the caller's timestamps
+       move. A tune started at an arbitrary epoch must time out 60 min after
+       it, not relative to esp_timer. */
+    pid_autotune_t at;
+    int64_t now = 7LL * 24 * 3600 * 1000000; /* a week of uptime */
+    pid_autotune_start(&at, 100.0f, 5.0f, now);
+    float out = 0.0f;
+    TEST_ASSERT_FALSE(pid_autotune_update(&at, 20.0f, now + 59LL * 60 * 1000000, &out));
+    TEST_ASSERT_TRUE(pid_autotune_update(&at, 20.0f, now + 61LL * 60 * 1000000, &out));
+    TEST_ASSERT_EQUAL(AUTOTUNE_FAILED, at.state);
+}
+
+/* ── autotune against a plant with known dynamics ───────────────────────── */
+
+/* First-order-plus-dead-time plant, the textbook model relay autotuning is
+ * analysed against: y' = (K·u(t−θ) − (y − ambient)) / τ, stepped exactly under
+ * a zero-order hold at 1 Hz. K is chosen so the setpoint sits at 50% duty,
+ * which makes the 0/1 relay symmetric about it (d = 0.5). */
+#define FOPDT_K_C       960.0f /* °C per unit duty at steady state */
+#define FOPDT_TAU_S     600.0f
+#define FOPDT_THETA_S   60
+#define FOPDT_AMBIENT_C 20.0f
+#define TUNE_SETPOINT_C (FOPDT_AMBIENT_C + 0.5f * FOPDT_K_C)
+#define TUNE_HYST_C     5.0f
+
+/* Run a full relay autotune against the FOPDT plant in virtual time. */
+static void run_fopdt_autotune(pid_autotune_t *at, int *seconds)
+{
+    float y = FOPDT_AMBIENT_C;
+    float delay_line[FOPDT_THETA_S] = {0};
+    float decay = expf(-1.0f / FOPDT_TAU_S);
+    int64_t now = 0;
+    float out = 0.0f;
+
+    TEST_ASSERT_EQUAL(ESP_OK, pid_autotune_start(at, TUNE_SETPOINT_C, TUNE_HYST_C, now));
+    int t;
+    for (t = 0; t < 4 * 3600; t++) {
+        if (pid_autotune_update(at, y, now, &out)) {
+            break;
+        }
+        float u_delayed = delay_line[t % FOPDT_THETA_S];
+        delay_line[t % FOPDT_THETA_S] = out;
+        y = FOPDT_AMBIENT_C + (y - FOPDT_AMBIENT_C) * decay + FOPDT_K_C * u_delayed * (1.0f - decay);
+        now += 1000000;
+    }
+    *seconds = t;
+}
+
+static void test_autotune_fopdt_gains_match_exact_relay_limit_cycle(void)
+{
+    pid_autotune_t at;
+    int seconds = 0;
+    run_fopdt_autotune(&at, &seconds);
+    TEST_ASSERT_EQUAL(AUTOTUNE_COMPLETE, at.state);
+
+    /* Exact steady limit cycle of a relay (half-swing d, hysteresis ε) on an
+       FOPDT plant, in deviation from the setpoint: the relay flips at +ε, the
+       output keeps rising for θ toward +Kd, so
+         a   = Kd − (Kd − ε)·e^(−θ/τ)
+         T/2 = θ + τ·ln((a + Kd) / (Kd − ε))
+       Auto-tune reports Ku = 4d/(πa), Pu = T and classic Z-N gains. */
+    double kd_c = 0.5 * FOPDT_K_C, eps = TUNE_HYST_C, theta = FOPDT_THETA_S, tau = FOPDT_TAU_S;
+    double a = kd_c - (kd_c - eps) * exp(-theta / tau);
+    double pu = 2.0 * (theta + tau * log((a + kd_c) / (kd_c - eps)));
+    double ku = 2.0 / (M_PI * a);
+
+    /* 1 Hz sampling adds up to a tick of switching lag per half-cycle, and the
+       first measured cycle starts from the heat-up rather than a crossing —
+       a few percent all told. */
+    TEST_ASSERT_FLOAT_WITHIN(0.05 * 0.6 * ku, 0.6 * ku, at.kp_result);
+    TEST_ASSERT_FLOAT_WITHIN(0.08 * 1.2 * ku / pu, 1.2 * ku / pu, at.ki_result);
+    TEST_ASSERT_FLOAT_WITHIN(0.08 * 0.075 * ku * pu, 0.075 * ku * pu, at.kd_result);
+
+    /* Whole tune (heat-up + 5 cycles) fits in the firmware's budget. */
+    TEST_ASSERT_TRUE(seconds < 60 * 60);
+}
+
+static void test_autotune_fopdt_brackets_true_ultimate_point(void)
+{
+    /* The describing-function estimate is biased for a lag-dominant plant
+       (the square-wave harmonics are not filtered away), so only bracket the
+       plant's true phase-crossover: Ku within 35%, Pu within 15%. A gross
+       error (wrong relay amplitude, period of a half-cycle) lands far
+       outside. */
+    pid_autotune_t at;
+    int seconds = 0;
+    run_fopdt_autotune(&at, &seconds);
+    TEST_ASSERT_EQUAL(AUTOTUNE_COMPLETE, at.state);
+
+    /* Solve θω + atan(τω) = π by bisection. */
+    double lo = 1e-4, hi = 1.0;
+    for (int i = 0; i < 100; i++) {
+        double w = 0.5 * (lo + hi);
+        if (FOPDT_THETA_S * w + atan(FOPDT_TAU_S * w) < M_PI) {
+            lo = w;
+        } else {
+            hi = w;
+        }
+    }
+    double w180 = 0.5 * (lo + hi);
+    double ku_true = sqrt(1.0 + pow(FOPDT_TAU_S * w180, 2)) / FOPDT_K_C;
+    double pu_true = 2.0 * M_PI / w180;
+
+    double ku_est = at.kp_result / 0.6;
+    double pu_est = 2.0 * at.kd_result / at.kp_result / 0.25; /* kd/kp = 0.125·Pu */
+    TEST_ASSERT_FLOAT_WITHIN(0.35 * ku_true, ku_true, ku_est);
+    TEST_ASSERT_FLOAT_WITHIN(0.15 * pu_true, pu_true, pu_est);
+}
+
 int main(void)
 {
     UNITY_BEGIN();
@@ -322,6 +474,7 @@ int main(void)
     RUN_TEST(test_pid_derivative_ignores_setpoint_step);
     RUN_TEST(test_pid_derivative_filter_attenuates_sensor_lsb);
     RUN_TEST(test_pid_reset_clears_derivative_filter);
+    RUN_TEST(test_pid_settles_only_once_derivative_has_decayed);
     RUN_TEST(test_pid_load_returns_defaults_when_no_nvs);
     RUN_TEST(test_pid_save_and_load_roundtrip);
     RUN_TEST(test_autotune_rejects_invalid_args);
@@ -332,5 +485,8 @@ int main(void)
     RUN_TEST(test_autotune_timeout_resets_when_cycling_starts);
     RUN_TEST(test_autotune_times_out_after_60_minutes);
     RUN_TEST(test_autotune_cancel_returns_to_idle);
+    RUN_TEST(test_autotune_runs_on_caller_time_not_the_global_clock);
+    RUN_TEST(test_autotune_fopdt_gains_match_exact_relay_limit_cycle);
+    RUN_TEST(test_autotune_fopdt_brackets_true_ultimate_point);
     return UNITY_END();
 }
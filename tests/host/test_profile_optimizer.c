@@ -0,0 +1,180 @@
+#include "profile_optimizer.h"
+#include "firing_engine_internal.h"
+#include "unity.h"
+
+#include <math.h>
+#include <string.h>
+
+static firing_profile_t s_in;
+static firing_profile_t s_out;
+static profile_opt_limits_t s_lim;
+static kiln_cap_t s_cap;
+
+void setUp(void)
+{
+    memset(&s_in, 0, sizeof(s_in));
+    memset(&s_out, 0, sizeof(s_out));
+    memset(&s_cap, 0, sizeof(s_cap));
+    profile_opt_default_limits(&s_lim);
+    strcpy(s_in.id, "bisque");
+    strcpy(s_in.name, "Bisque 04");
+}
+void tearDown(void)
+{
+}
+
+static void add_seg(const char *id, float ramp_rate, float target, uint16_t hold_min)
+{
+    firing_segment_t *s = &s_in.segments[s_in.segment_count++];
+    strcpy(s->id, id);
+    strcpy(s->name, id);
+    s->ramp_rate = ramp_rate;
+    s->target_temp = target;
+    s->hold_time = hold_min;
+}
+
+static void assert_seg(int i, const char *id, float ramp_rate, float target, uint16_t hold_min)
+{
+    const firing_segment_t *s = &s_out.segments[i];
+    TEST_ASSERT_EQUAL_STRING(id, s->id);
+    TEST_ASSERT_EQUAL_FLOAT(ramp_rate, s->ramp_rate);
+    TEST_ASSERT_EQUAL_FLOAT(target, s->target_temp);
+    TEST_ASSERT_EQUAL_UINT16(hold_min, s->hold_time);
+}
+
+/* ── Zones and soaks ───────────────────────────────────────────────────── */
+
+static void test_zones_set_the_pace_inside_them(void)
+{
+    add_seg("smoke", 60.0f, 600.0f, 0);
+    add_seg("top", 150.0f, 1060.0f, 10);
+    TEST_ASSERT_TRUE(profile_optimize(&s_in, &s_lim, NULL, &s_out));
+
+    /* Water smoke and quartz at their limits; nothing is known about the
+       kiln in between, so that stretch keeps its programmed rate. */
+    TEST_ASSERT_EQUAL_UINT8(4, s_out.segment_count);
+    assert_seg(0, "smoke-1", 80.0f, 200.0f, 0);
+    assert_seg(1, "smoke-2", 60.0f, 540.0f, 0);
+    assert_seg(2, "smoke", 100.0f, 600.0f, 0);
+    assert_seg(3, "top", 150.0f, 1060.0f, 10);
+    TEST_ASSERT_EQUAL_STRING("smoke", s_out.segments[0].name);
+    TEST_ASSERT_EQUAL_STRING("bisque", s_out.id);
+
+    float hours = 180.0f / 80 + 340.0f / 60 + 60.0f / 100 + 460.0f / 150 + 10.0f / 60;
+    TEST_ASSERT_UINT32_WITHIN(1, (uint32_t)lroundf(hours * 60.0f), s_out.estimated_duration);
+}
+
+static void test_zones_also_bound_a_cool(void)
+{
+    add_seg("up", 100.0f, 1000.0f, 0);
+    add_seg("down", -200.0f, 400.0f, 0);
+    TEST_ASSERT_TRUE(profile_optimize(&s_in, &s_lim, NULL, &s_out));
+
+    TEST_ASSERT_EQUAL_UINT8(5, s_out.segment_count);
+    assert_seg(1, "up", 100.0f, 1000.0f, 0);
+    assert_seg(2, "down-1", -200.0f, 600.0f, 0);
+    assert_seg(3, "down-2", -100.0f, 540.0f, 0);
+    assert_seg(4, "down", -200.0f, 400.0f, 0);
+
+    /* A cool already slower than the zone keeps its rate: quartz allows
+       100 °C/h, the programmed 30 °C/h goes through it unchanged. */
+    s_in.segments[1].ramp_rate = -30.0f;
+    TEST_ASSERT_TRUE(profile_optimize(&s_in, &s_lim, NULL, &s_out));
+
+    TEST_ASSERT_EQUAL_UINT8(3, s_out.segment_count);
+    assert_seg(2, "down", -30.0f, 400.0f, 0);
+}
+
+static void test_listed_soaks_take_their_minimum(void)
+{
+    add_seg("a", 80.0f, 200.0f, 60);
+    add_seg("b", 150.0f, 1222.0f, 30);
+    add_seg("c", -150.0f, 1000.0f, FIRING_HOLD_INDEFINITE);
+    s_lim.holds[s_lim.hold_count++] = (profile_opt_hold_t){.temp_c = 1222.0f, .minutes = 10};
+    s_lim.holds[s_lim.hold_count++] = (profile_opt_hold_t){.temp_c = 1000.0f, .minutes = 5};
+    TEST_ASSERT_TRUE(profile_optimize(&s_in, &s_lim, NULL, &s_out));
+
+    TEST_ASSERT_EQUAL_UINT16(60, s_out.segments[0].hold_time);
+    TEST_ASSERT_EQUAL_UINT16(10, s_out.segments[s_out.segment_count - 2].hold_time);
+    TEST_ASSERT_EQUAL_UINT16(FIRING_HOLD_INDEFINITE, s_out.segments[s_out.segment_count - 1].hold_time);
+}
+
+static void test_a_cone_ending_ramp_stays_whole(void)
+{
+    add_seg("cone", 120.0f, 1000.0f, FIRING_HOLD_INDEFINITE);
+    s_in.segments[0].end_cone = 7;
+    TEST_ASSERT_TRUE(profile_optimize(&s_in, &s_lim, NULL, &s_out));
+
+    TEST_ASSERT_EQUAL_UINT8(1, s_out.segment_count);
+    assert_seg(0, "cone", 80.0f, 1000.0f, FIRING_HOLD_INDEFINITE);
+    TEST_ASSERT_EQUAL_UINT8(7, s_out.segments[0].end_cone);
+}
+
+/* ── Capability ────────────────────────────────────────────────────────── */
+
+static void test_the_curve_and_ceiling_bound_heating(void)
+{
+    for (int b = 0; b < KILN_CAP_BINS; b++) {
+        s_cap.rate_ch[b] = (uint16_t)(480 - 15 * b); /* 200 °C/h just under 950 °C, 195 above */
+    }
+    s_lim.zone_count = 0;
+    s_lim.max_rate_ch = 200.0f;
+    add_seg("all", 100.0f, 1000.0f, 0);
+    TEST_ASSERT_TRUE(profile_optimize(&s_in, &s_lim, &s_cap, &s_out));
+
+    TEST_ASSERT_EQUAL_UINT8(2, s_out.segment_count);
+    assert_seg(0, "all-1", 200.0f, 950.0f, 0);
+    assert_seg(1, "all", 195.0f, 1000.0f, 0);
+}
+
+static void test_a_long_curve_merges_down_to_the_segment_limit(void)
+{
+    for (int b = 0; b < KILN_CAP_BINS; b++) {
+        s_cap.rate_ch[b] = (uint16_t)(480 - 15 * b);
+    }
+    s_lim.zone_count = 0;
+    add_seg("up", 1000.0f, 1300.0f, 15);
+    add_seg("down", -300.0f, 700.0f, 0);
+    TEST_ASSERT_TRUE(profile_optimize(&s_in, &s_lim, &s_cap, &s_out));
+
+    TEST_ASSERT_EQUAL_UINT8(FIRING_MAX_SEGMENTS, s_out.segment_count);
+    float from = s_lim.start_temp_c;
+    for (int i = 0; i < s_out.segment_count - 1; i++) {
+        const firing_segment_t *s = &s_out.segments[i];
+        /* Every merged piece still only asks what the kiln can do throughout. */
+        for (float t = from; t < s->target_temp; t += 1.0f) {
+            TEST_ASSERT_TRUE(s->ramp_rate <= kiln_cap_rate(&s_cap, t));
+        }
+        from = s->target_temp;
+    }
+    assert_seg(FIRING_MAX_SEGMENTS - 2, "up", 105.0f, 1300.0f, 15);
+    assert_seg(FIRING_MAX_SEGMENTS - 1, "down", -300.0f, 700.0f, 0);
+}
+
+/* ── Planning ──────────────────────────────────────────────────────────── */
+
+static void test_plan_is_the_engine_eta_plus_element_time(void)
+{
+    add_seg("a", 100.0f, 1000.0f, 30);
+    add_seg("b", -100.0f, 500.0f, 0);
+    profile_plan_t plan;
+    profile_plan(&s_in, 20.0f, NULL, &plan);
+
+    TEST_ASSERT_EQUAL_UINT32(firing_remaining_s(&s_in, 0, 20.0f, false, 0.0f, NULL, 1.0f), plan.duration_s);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, plan.duration_s * 0.5f, plan.on_s);
+
+    TEST_ASSERT_FALSE(profile_optimize(&s_out, &s_lim, NULL, &s_in));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_zones_set_the_pace_inside_them);
+    RUN_TEST(test_zones_also_bound_a_cool);
+    RUN_TEST(test_listed_soaks_take_their_minimum);
+    RUN_TEST(test_a_cone_ending_ramp_stays_whole);
+    RUN_TEST(test_the_curve_and_ceiling_bound_heating);
+    RUN_TEST(test_a_long_curve_merges_down_to_the_segment_limit);
+    RUN_TEST(test_plan_is_the_engine_eta_plus_element_time);
+    return UNITY_END();
+}
@@ -0,0 +1,104 @@
+#include "rt_hist.h"
+#include "unity.h"
+
+#include <stdlib.h>
+
+static rt_hist_t s_h;
+
+void setUp(void)
+{
+    rt_hist_reset(&s_h);
+}
+void tearDown(void)
+{
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* The exact pct-th percentile of `v` (nearest rank), for comparison. */
+static uint32_t exact_percentile(uint32_t *v, int n, uint32_t pct)
+{
+    qsort(v, (size_t)n, sizeof(v[0]), cmp_u32);
+    int rank = (int)(((uint64_t)n * pct + 99) / 100);
+    return v[rank > 0 ? rank - 1 : 0];
+}
+
+static void test_empty_reports_zero(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(0, s_h.count);
+    TEST_ASSERT_EQUAL_UINT32(0, rt_hist_percentile(&s_h, 50));
+    TEST_ASSERT_EQUAL_UINT32(0, rt_hist_percentile(&s_h, 100));
+}
+
+static void test_min_max_and_sum(void)
+{
+    rt_hist_add(&s_h, 700);
+    rt_hist_add(&s_h, 20);
+    rt_hist_add(&s_h, 5000);
+    TEST_ASSERT_EQUAL_UINT32(3, s_h.count);
+    TEST_ASSERT_EQUAL_UINT32(20, s_h.min);
+    TEST_ASSERT_EQUAL_UINT32(5000, s_h.max);
+    TEST_ASSERT_EQUAL_UINT64(5720, s_h.sum);
+}
+
+static void test_small_values_are_exact(void)
+{
+    for (uint32_t v = 0; v < 8; v++) {
+        rt_hist_reset(&s_h);
+        rt_hist_add(&s_h, v);
+        rt_hist_add(&s_h, 1000);
+        TEST_ASSERT_EQUAL_UINT32(v, rt_hist_percentile(&s_h, 50));
+    }
+}
+
+static void test_single_value_reads_back_exactly(void)
+{
+    /* Clamped to max, so a lone sample is never rounded up to its bucket edge. */
+    rt_hist_add(&s_h, 123457);
+    TEST_ASSERT_EQUAL_UINT32(123457, rt_hist_percentile(&s_h, 1));
+    TEST_ASSERT_EQUAL_UINT32(123457, rt_hist_percentile(&s_h, 99));
+}
+
+static void test_full_range_fits(void)
+{
+    rt_hist_add(&s_h, 0);
+    rt_hist_add(&s_h, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT32(0, rt_hist_percentile(&s_h, 50));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, rt_hist_percentile(&s_h, 100));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, rt_hist_percentile(&s_h, 250)); /* clamped to 100 */
+}
+
+static void test_percentiles_within_a_bucket_above_exact(void)
+{
+    enum { N = 5000 };
+    static uint32_t v[N];
+    srand(7);
+    for (int i = 0; i < N; i++) {
+        /* Spread over several octaves, like tick times with the odd slow one. */
+        v[i] = (uint32_t)(rand() % 2000) << (rand() % 8);
+        rt_hist_add(&s_h, v[i]);
+    }
+    static const uint32_t pcts[] = {1, 10, 50, 90, 99, 100};
+    for (size_t i = 0; i < sizeof(pcts) / sizeof(pcts[0]); i++) {
+        uint32_t exact = exact_percentile(v, N, pcts[i]);
+        uint32_t got = rt_hist_percentile(&s_h, pcts[i]);
+        TEST_ASSERT_TRUE_MESSAGE(got >= exact, "under-reported");
+        TEST_ASSERT_TRUE_MESSAGE((uint64_t)got * 4 <= (uint64_t)exact * 5 + 4, "more than a bucket above");
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_reports_zero);
+    RUN_TEST(test_min_max_and_sum);
+    RUN_TEST(test_small_values_are_exact);
+    RUN_TEST(test_single_value_reads_back_exactly);
+    RUN_TEST(test_full_range_fits);
+    RUN_TEST(test_percentiles_within_a_bucket_above_exact);
+    return UNITY_END();
+}
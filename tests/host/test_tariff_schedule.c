@@ -0,0 +1,228 @@
+#include "tariff_schedule.h"
+#include "app_config.h"
+#include "cone_table.h"
+#include "unity.h"
+
+#include <string.h>
+
+#define H 3600
+#define DAY (24 * H)
+
+static kiln_settings_t s_set;
+static firing_sim_result_t s_sim;
+
+void setUp(void)
+{
+    memset(&s_set, 0, sizeof(s_set));
+    memset(&s_sim, 0, sizeof(s_sim));
+    s_set.element_watts = 1000.0f;
+    s_set.electricity_cost_kwh = 0.20f;
+}
+void tearDown(void)
+{
+}
+
+static void add_band(uint16_t start_min, float cost_kwh)
+{
+    s_set.tariff[s_set.tariff_count++] = (tariff_band_t){.start_min = start_min, .cost_kwh = cost_kwh};
+}
+
+/* Peak 07:00–22:00 at 0.30, off-peak overnight at 0.10. */
+static void peak_and_night(void)
+{
+    add_band(7 * 60, 0.30f);
+    add_band(22 * 60, 0.10f);
+}
+
+/* A predicted firing of `hours` at full power, 60 intervals long. */
+static void full_power_for(int hours)
+{
+    s_sim.outcome = FIRING_SIM_COMPLETE;
+    s_sim.point_every_s = (uint32_t)hours * 60;
+    s_sim.point_count = 61;
+    for (int i = 0; i < s_sim.point_count; i++) {
+        float t = (float)(i * hours * 60);
+        s_sim.points[i] = (firing_sim_point_t){.t_s = (uint32_t)t, .temp_c = 20.0f, .on_s = t};
+    }
+    s_sim.duration_s = (uint32_t)hours * H;
+    s_sim.on_s = hours * (float)H;
+}
+
+/* ── Prices ────────────────────────────────────────────────────────────── */
+
+static void test_no_bands_is_the_flat_rate(void)
+{
+    TEST_ASSERT_EQUAL_FLOAT(0.20f, tariff_price_at(&s_set, 0));
+    TEST_ASSERT_EQUAL_FLOAT(0.20f, tariff_price_at(&s_set, 1439));
+}
+
+static void test_a_band_runs_until_the_next_and_wraps_past_midnight(void)
+{
+    peak_and_night();
+    TEST_ASSERT_EQUAL_FLOAT(0.30f, tariff_price_at(&s_set, 7 * 60));
+    TEST_ASSERT_EQUAL_FLOAT(0.30f, tariff_price_at(&s_set, 22 * 60 - 1));
+    TEST_ASSERT_EQUAL_FLOAT(0.10f, tariff_price_at(&s_set, 22 * 60));
+    TEST_ASSERT_EQUAL_FLOAT(0.10f, tariff_price_at(&s_set, 3 * 60)); /* last night's band */
+}
+
+/* ── Cost of a run ─────────────────────────────────────────────────────── */
+
+static void test_a_flat_rate_prices_the_energy(void)
+{
+    full_power_for(10);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 10 * 1.0 * 0.20f, tariff_run_cost(&s_set, &s_sim, 12345, 0));
+}
+
+static void test_an_interval_is_split_at_a_band_edge(void)
+{
+    add_band(0, 0.10f);
+    add_band(30, 0.30f);
+    s_sim.point_count = 2;
+    s_sim.points[1] = (firing_sim_point_t){.t_s = H, .on_s = H}; /* one kWh over the hour */
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.5 * 0.10f + 0.5 * 0.30f, tariff_run_cost(&s_set, &s_sim, 0, 0));
+}
+
+static void test_only_element_time_is_paid_for(void)
+{
+    peak_and_night();
+    full_power_for(2);
+    /* Elements off for the first hour: all of the energy lands after 22:00. */
+    for (int i = 0; i < s_sim.point_count; i++) {
+        s_sim.points[i].on_s = s_sim.points[i].t_s > H ? (float)(s_sim.points[i].t_s - H) : 0.0f;
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 1.0 * 0.10f, tariff_run_cost(&s_set, &s_sim, 21 * H, 0));
+}
+
+/* ── Cheapest start ────────────────────────────────────────────────────── */
+
+static void test_waits_for_the_cheap_band(void)
+{
+    peak_and_night();
+    full_power_for(2);
+    tariff_plan_t plan;
+    tariff_cheapest_start(&s_set, &s_sim, 18 * H, 18 * H, 18 * H + TARIFF_HORIZON_S, 0, &plan);
+
+    TEST_ASSERT_EQUAL_INT64(22 * H, plan.start_s);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 2 * 0.10f, plan.cost);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 2 * 0.30f, plan.earliest_cost);
+}
+
+static void test_a_finish_by_limits_the_wait(void)
+{
+    peak_and_night();
+    full_power_for(2);
+    tariff_plan_t plan;
+    /* Done by 23:00: the latest start is 21:00, half in each band. */
+    tariff_cheapest_start(&s_set, &s_sim, 18 * H, 18 * H, 21 * H, 0, &plan);
+
+    TEST_ASSERT_EQUAL_INT64(21 * H, plan.start_s);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.30f + 0.10f, plan.cost);
+}
+
+static void test_starts_fall_on_local_quarter_hours(void)
+{
+    peak_and_night();
+    full_power_for(2);
+    tariff_plan_t plan;
+    /* UTC−5, opening at 18:07 local: the band edge is 22:00 local, 03:00 UTC. */
+    int32_t offset = -5 * H;
+    int64_t opening = DAY + 18 * H + 7 * 60 - offset;
+    tariff_cheapest_start(&s_set, &s_sim, opening, opening, opening + TARIFF_HORIZON_S, offset, &plan);
+
+    TEST_ASSERT_EQUAL_INT64(2 * DAY + 3 * H, plan.start_s);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 2 * 0.10f, plan.cost);
+}
+
+static void test_a_flat_rate_starts_at_the_opening(void)
+{
+    full_power_for(6);
+    tariff_plan_t plan;
+    tariff_cheapest_start(&s_set, &s_sim, 960, 1000, 1000 + TARIFF_HORIZON_S, 0, &plan);
+
+    TEST_ASSERT_EQUAL_INT64(1020, plan.start_s);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, plan.earliest_cost, plan.cost);
+}
+
+static void test_starts_are_whole_minutes_after_now(void)
+{
+    peak_and_night();
+    full_power_for(2);
+    tariff_plan_t plan;
+    /* Asked at 17:59:30: the 22:00 edge is taken at 22:00:30, and that start
+       is what gets priced. */
+    int64_t now = 18 * H - 30;
+    TEST_ASSERT_TRUE(tariff_cheapest_start(&s_set, &s_sim, now, now, now + TARIFF_HORIZON_S, 0, &plan));
+
+    TEST_ASSERT_EQUAL_INT64(22 * H + 30, plan.start_s);
+    TEST_ASSERT_EQUAL_INT64(0, (plan.start_s - now) % 60);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, tariff_run_cost(&s_set, &s_sim, plan.start_s, 0), plan.cost);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, tariff_run_cost(&s_set, &s_sim, now, 0), plan.earliest_cost);
+}
+
+static void test_a_finish_by_is_not_overrun_by_rounding(void)
+{
+    peak_and_night();
+    full_power_for(2);
+    tariff_plan_t plan;
+    /* Latest start 21:00 with now at 17:59:30: 21:00:30 would finish late, so
+       the last start tried is 20:59:30. */
+    int64_t now = 18 * H - 30;
+    TEST_ASSERT_TRUE(tariff_cheapest_start(&s_set, &s_sim, now, now, 21 * H, 0, &plan));
+
+    TEST_ASSERT_EQUAL_INT64(21 * H - 30, plan.start_s);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, tariff_run_cost(&s_set, &s_sim, 21 * H - 30, 0), plan.cost);
+}
+
+static void test_a_window_without_a_whole_minute_is_refused(void)
+{
+    peak_and_night();
+    full_power_for(2);
+    tariff_plan_t plan = {.start_s = -1};
+    TEST_ASSERT_FALSE(tariff_cheapest_start(&s_set, &s_sim, 18 * H, 18 * H, 17 * H, 0, &plan));
+    /* After 18:00:00 the next start is 18:01:00, past a 18:00:40 latest. */
+    TEST_ASSERT_FALSE(tariff_cheapest_start(&s_set, &s_sim, 18 * H, 18 * H + 20, 18 * H + 40, 0, &plan));
+    TEST_ASSERT_EQUAL_INT64(-1, plan.start_s);
+}
+
+static void test_a_firing_held_to_a_cone_is_priced_to_the_cone(void)
+{
+    /* Hold at 1200 °C until cone 7 bends, then a controlled cool: the end is
+       when the predicted heat work gets there, not a programmed soak. */
+    firing_profile_t prof = {.segment_count = 2};
+    prof.segments[0] = (firing_segment_t){.ramp_rate = 150.0f, .target_temp = 1200.0f,
+                                          .hold_time = FIRING_HOLD_INDEFINITE, .end_cone = CONE_7 + 1};
+    prof.segments[1] = (firing_segment_t){.ramp_rate = -150.0f, .target_temp = 900.0f};
+    firing_sim_config_t cfg = {
+        .start_temp_c = 20.0f, .kp = APP_PID_KP_DEFAULT, .ki = APP_PID_KI_DEFAULT, .kd = APP_PID_KD_DEFAULT};
+    firing_sim_run(&prof, NULL, &cfg, &s_sim);
+    TEST_ASSERT_EQUAL(FIRING_SIM_COMPLETE, s_sim.outcome);
+
+    peak_and_night();
+    tariff_plan_t plan;
+    TEST_ASSERT_TRUE(tariff_cheapest_start(&s_set, &s_sim, 18 * H, 18 * H, 18 * H + TARIFF_HORIZON_S, 0, &plan));
+
+    double kwh = s_sim.on_s / 3600.0;
+    TEST_ASSERT_TRUE(kwh > 1.0);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, tariff_run_cost(&s_set, &s_sim, plan.start_s, 0), plan.cost);
+    TEST_ASSERT_TRUE(plan.cost < plan.earliest_cost);
+    TEST_ASSERT_TRUE(plan.cost >= kwh * 0.10 - 1e-6 && plan.cost <= kwh * 0.30 + 1e-6);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_no_bands_is_the_flat_rate);
+    RUN_TEST(test_a_band_runs_until_the_next_and_wraps_past_midnight);
+    RUN_TEST(test_a_flat_rate_prices_the_energy);
+    RUN_TEST(test_an_interval_is_split_at_a_band_edge);
+    RUN_TEST(test_only_element_time_is_paid_for);
+    RUN_TEST(test_waits_for_the_cheap_band);
+    RUN_TEST(test_a_finish_by_limits_the_wait);
+    RUN_TEST(test_starts_fall_on_local_quarter_hours);
+    RUN_TEST(test_a_flat_rate_starts_at_the_opening);
+    RUN_TEST(test_starts_are_whole_minutes_after_now);
+    RUN_TEST(test_a_finish_by_is_not_overrun_by_rounding);
+    RUN_TEST(test_a_window_without_a_whole_minute_is_refused);
+    RUN_TEST(test_a_firing_held_to_a_cone_is_priced_to_the_cone);
+    return UNITY_END();
+}
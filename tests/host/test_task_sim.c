@@ -0,0 +1,432 @@
+#include "app_config.h"
+#include "firing_engine.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "rtos_sim.h"
+#include "safety.h"
+#include "task_sim.h"
+#include "thermocouple.h"
+#include "unity.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define MS(x) ((int64_t)(x) * 1000LL)
+#define S(x)  ((int64_t)(x) * 1000000LL)
+
+/* Cost-free scheduler for the rtos_sim unit cases: the only CPU spent is what
+   the test tasks ask for. */
+static const rtos_sim_config_t k_bare = {.priority_inheritance = true, .mutex_hold_us = 0, .activation_us = 0};
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/* ── rtos_sim ─────────────────────────────────────── */
+
+typedef struct {
+    int delay_ticks;
+    int64_t spend_us;
+    int64_t started_us;
+    int64_t done_us;
+} spender_t;
+
+static void spender(void *arg)
+{
+    spender_t *s = arg;
+    vTaskDelay(s->delay_ticks);
+    s->started_us = rtos_sim_now();
+    rtos_sim_consume(s->spend_us);
+    s->done_us = rtos_sim_now();
+    vTaskDelete(NULL);
+}
+
+static void test_higher_priority_preempts_on_its_core(void)
+{
+    rtos_sim_reset(&k_bare);
+    int64_t t0 = rtos_sim_now();
+    spender_t low = {.delay_ticks = 0, .spend_us = 5000};
+    spender_t high = {.delay_ticks = 1, .spend_us = 100};
+    xTaskCreatePinnedToCore(spender, "low", 2048, &low, 1, NULL, 0);
+    xTaskCreatePinnedToCore(spender, "high", 2048, &high, 2, NULL, 0);
+
+    rtos_sim_run(t0 + MS(20), NULL, NULL);
+
+    TEST_ASSERT_EQUAL_INT64(t0 + 1000, high.started_us);
+    TEST_ASSERT_EQUAL_INT64(t0 + 1100, high.done_us);
+    TEST_ASSERT_EQUAL_INT64(t0 + 5100, low.done_us); /* lost 100 µs to high */
+}
+
+static void test_cores_run_in_parallel(void)
+{
+    rtos_sim_reset(&k_bare);
+    int64_t t0 = rtos_sim_now();
+    spender_t a = {.spend_us = 3000};
+    spender_t b = {.spend_us = 3000};
+    xTaskCreatePinnedToCore(spender, "a", 2048, &a, 1, NULL, 0);
+    xTaskCreatePinnedToCore(spender, "b", 2048, &b, 1, NULL, 1);
+
+    rtos_sim_run(t0 + MS(10), NULL, NULL);
+
+    TEST_ASSERT_EQUAL_INT64(t0 + 3000, a.done_us);
+    TEST_ASSERT_EQUAL_INT64(t0 + 3000, b.done_us);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.3f, rtos_sim_core_load(0));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.3f, rtos_sim_core_load(1));
+}
+
+typedef struct {
+    int64_t wakes[8];
+    int n;
+} periodic_t;
+
+static void periodic(void *arg)
+{
+    periodic_t *p = arg;
+    TickType_t last_wake = xTaskGetTickCount();
+    for (;;) {
+        if (p->n < 8) {
+            p->wakes[p->n++] = rtos_sim_now();
+        }
+        rtos_sim_consume(3000);
+        xTaskDelayUntil(&last_wake, pdMS_TO_TICKS(10));
+    }
+}
+
+static void test_delay_until_holds_period_under_load(void)
+{
+    rtos_sim_reset(&k_bare);
+    int64_t t0 = rtos_sim_now();
+    periodic_t p = {0};
+    spender_t hog = {.delay_ticks = 9, .spend_us = 4000};
+    xTaskCreatePinnedToCore(periodic, "periodic", 2048, &p, 1, NULL, 1);
+    xTaskCreatePinnedToCore(spender, "hog", 2048, &hog, 2, NULL, 1);
+
+    rtos_sim_run(t0 + MS(75), NULL, NULL);
+
+    TEST_ASSERT_EQUAL_INT(8, p.n);
+    TEST_ASSERT_EQUAL_INT64(t0 + MS(13), p.wakes[1]); /* the hog (9..13 ms) delays this run... */
+    for (int i = 2; i < p.n; i++) {
+        TEST_ASSERT_EQUAL_INT64(t0 + MS(10) * i, p.wakes[i]); /* ...but not the next wake */
+    }
+}
+
+/* The textbook inversion: low holds the lock, high blocks on it, medium
+   (unrelated to the lock) keeps low off the core. */
+typedef struct {
+    SemaphoreHandle_t lock;
+    int64_t high_got_us;
+} inversion_t;
+
+static inversion_t g_inv;
+
+static void inv_low(void *arg)
+{
+    xSemaphoreTake(g_inv.lock, portMAX_DELAY);
+    rtos_sim_consume(5000);
+    xSemaphoreGive(g_inv.lock);
+    vTaskDelete(NULL);
+}
+
+static void inv_medium(void *arg)
+{
+    vTaskDelay(2);
+    rtos_sim_consume(20000);
+    vTaskDelete(NULL);
+}
+
+static void inv_high(void *arg)
+{
+    vTaskDelay(1);
+    xSemaphoreTake(g_inv.lock, portMAX_DELAY);
+    g_inv.high_got_us = rtos_sim_now();
+    xSemaphoreGive(g_inv.lock);
+    vTaskDelete(NULL);
+}
+
+static int64_t run_inversion(bool inheritance, rtos_sim_mutex_stats_t *stats)
+{
+    rtos_sim_config_t cfg = k_bare;
+    cfg.priority_inheritance = inheritance;
+    rtos_sim_reset(&cfg);
+    int64_t t0 = rtos_sim_now();
+    memset(&g_inv, 0, sizeof(g_inv));
+    g_inv.lock = xSemaphoreCreateMutex();
+    vQueueAddToRegistry(g_inv.lock, "lock");
+    xTaskCreatePinnedToCore(inv_low, "low", 2048, NULL, 1, NULL, 0);
+    xTaskCreatePinnedToCore(inv_medium, "medium", 2048, NULL, 2, NULL, 0);
+    xTaskCreatePinnedToCore(inv_high, "high", 2048, NULL, 3, NULL, 0);
+
+    rtos_sim_run(t0 + MS(50), NULL, NULL);
+
+    TEST_ASSERT_TRUE(rtos_sim_mutex_stats("lock", stats));
+    return g_inv.high_got_us - t0;
+}
+
+static void test_inheritance_bounds_the_wait_for_a_lock(void)
+{
+    rtos_sim_mutex_stats_t st;
+    int64_t got = run_inversion(true, &st);
+
+    TEST_ASSERT_EQUAL_INT64(5000, got); /* low boosted past medium, finishes its 5 ms */
+    TEST_ASSERT_EQUAL_UINT32(1, st.contended);
+    TEST_ASSERT_EQUAL_UINT32(0, st.inversions);
+    TEST_ASSERT_EQUAL_INT64(4000, st.max_wait_us);
+}
+
+static void test_inversion_detected_without_inheritance(void)
+{
+    rtos_sim_mutex_stats_t st;
+    int64_t got = run_inversion(false, &st);
+
+    TEST_ASSERT_EQUAL_INT64(25000, got); /* medium's 20 ms lands on high's wait */
+    TEST_ASSERT_EQUAL_UINT32(1, st.inversions);
+    TEST_ASSERT_EQUAL_INT64(20000, st.inversion_us);
+    TEST_ASSERT_EQUAL_STRING("high", st.worst_waiter);
+}
+
+/* ── Firmware task set ────────────────────────────── */
+
+/* Straight up at a rate no kiln can follow, so the PID stays saturated and the
+   SSR is on continuously. */
+static firing_profile_t full_power_profile(void)
+{
+    firing_profile_t p = {0};
+    strncpy(p.id, "tasksim", FIRING_ID_LEN - 1);
+    strncpy(p.name, "Task sim", FIRING_NAME_LEN - 1);
+    p.segment_count = 1;
+    p.max_temp = 1000.0f;
+    p.segments[0].ramp_rate = 9999.0f;
+    p.segments[0].target_temp = 1000.0f;
+    p.segments[0].hold_time = 0;
+    return p;
+}
+
+static void boot(bool ui_tasks)
+{
+    task_sim_config_t cfg;
+    task_sim_config_defaults(&cfg);
+    cfg.ui_tasks = ui_tasks;
+    task_sim_boot(&cfg);
+}
+
+static bool status_is(void *ctx)
+{
+    firing_progress_t prog;
+    firing_engine_get_progress(&prog);
+    return prog.status == *(firing_status_t *)ctx;
+}
+
+static bool ssr_is(void *ctx)
+{
+    return task_sim_ssr_on() == *(bool *)ctx;
+}
+
+static bool sampled_since(void *ctx)
+{
+    return task_sim_last_sample_us() >= *(int64_t *)ctx;
+}
+
+static bool emergency(void *ctx)
+{
+    return safety_is_emergency();
+}
+
+/* Post START and run until the element is on. */
+static void start_firing(void)
+{
+    firing_cmd_t cmd = {.type = FIRING_CMD_START};
+    cmd.start.profile = full_power_profile();
+    TEST_ASSERT_TRUE(task_sim_post_cmd(&cmd));
+    bool on = true;
+    TEST_ASSERT_NOT_EQUAL(-1, rtos_sim_run(rtos_sim_now() + S(2), ssr_is, &on));
+}
+
+static void test_idle_boot_runs_every_task_at_its_period(void)
+{
+    boot(true);
+    int64_t t0 = rtos_sim_now();
+    rtos_sim_run(t0 + S(10), NULL, NULL);
+
+    rtos_sim_task_stats_t st;
+    thermocouple_timing_t tc;
+    thermocouple_get_timing(&tc);
+    TEST_ASSERT_TRUE(rtos_sim_task_stats("temp_read", &st));
+    TEST_ASSERT_UINT32_WITHIN(1, 40 + tc.bus_waits, st.activations); /* 250 ms, plus a wake after each bus wait */
+    TEST_ASSERT_TRUE(rtos_sim_task_stats("safety", &st));
+    TEST_ASSERT_UINT32_WITHIN(1, 20, st.activations); /* 500 ms */
+    TEST_ASSERT_TRUE(rtos_sim_task_stats("firing", &st));
+    TEST_ASSERT_UINT32_WITHIN(1, 10, st.activations); /* 1 Hz */
+    TEST_ASSERT_TRUE(rtos_sim_task_stats("ws_broadcast", &st));
+    TEST_ASSERT_UINT32_WITHIN(1, 10, st.activations);
+
+    TEST_ASSERT_EQUAL_UINT32(0, task_sim_ssr_rising_edges());
+    TEST_ASSERT_FALSE(safety_is_emergency());
+    TEST_ASSERT_TRUE(task_sim_last_sample_us() > t0 + S(9));
+}
+
+/* Every dashboard refresh streams a full screen over the bus (~60 ms); the
+   thermocouple read lands inside some of them and must only wait for the
+   chunk in flight. */
+static void test_lcd_flush_delays_tc_read_by_at_most_one_chunk(void)
+{
+    boot(true);
+    rtos_sim_run(rtos_sim_now() + S(60), NULL, NULL);
+
+    const int64_t chunk_us = (int64_t)APP_SPI_MAX_TRANSFER_SZ * 8 * 1000000 / APP_LCD_SPI_FREQ_HZ;
+    thermocouple_timing_t t;
+    thermocouple_get_timing(&t);
+    TEST_ASSERT_UINT32_WITHIN(1, 240, t.reads); /* since boot: nothing dropped or delayed past a period */
+    TEST_ASSERT_TRUE(t.bus_waits > 0);
+    TEST_ASSERT_TRUE(t.max_bus_wait_us > 0);
+    TEST_ASSERT_TRUE(t.max_bus_wait_us <= chunk_us);
+    TEST_ASSERT_TRUE(t.max_read_us <= chunk_us + MS(1));
+    TEST_ASSERT_EQUAL_UINT32(t.reads - 1, t.intervals);
+    TEST_ASSERT_TRUE(t.max_jitter_us <= chunk_us + MS(1));
+    printf("tc reads: %u, %u waited for the LCD (max %lld us, chunk %lld us); jitter max %lld us mean %lld us\n",
+           (unsigned)t.reads, (unsigned)t.bus_waits, (long long)t.max_bus_wait_us, (long long)chunk_us,
+           (long long)t.max_jitter_us, (long long)(t.total_jitter_us / t.intervals));
+}
+
+static void test_start_command_takes_effect_within_a_tick(void)
+{
+    boot(true);
+    firing_cmd_t cmd = {.type = FIRING_CMD_START};
+    cmd.start.profile = full_power_profile();
+    TEST_ASSERT_TRUE(task_sim_post_cmd(&cmd));
+
+    firing_status_t heating = FIRING_STATUS_HEATING;
+    int64_t t_state = rtos_sim_run(rtos_sim_now() + S(2), status_is, &heating);
+    TEST_ASSERT_NOT_EQUAL(-1, t_state);
+    int64_t t_queued = task_sim_cmd_queued_us();
+    TEST_ASSERT_NOT_EQUAL(-1, t_queued);
+    /* firing_task blocks on the cmd queue between ticks: no waiting for the
+       next 1 Hz deadline, just its own activation on core 1. */
+    TEST_ASSERT_TRUE(t_state - t_queued < MS(1));
+
+    bool on = true;
+    int64_t t_on = rtos_sim_run(rtos_sim_now() + S(2), ssr_is, &on);
+    TEST_ASSERT_NOT_EQUAL(-1, t_on);
+    TEST_ASSERT_TRUE(t_on - t_queued <= S(1) + MS(1)); /* first control tick */
+}
+
+static void test_stop_command_turns_the_element_off(void)
+{
+    boot(true);
+    start_firing();
+    rtos_sim_run(rtos_sim_now() + S(30), NULL, NULL);
+    TEST_ASSERT_TRUE(task_sim_ssr_on());
+
+    firing_cmd_t cmd = {.type = FIRING_CMD_STOP};
+    TEST_ASSERT_TRUE(task_sim_post_cmd(&cmd));
+    bool off = false;
+    int64_t t_off = rtos_sim_run(rtos_sim_now() + S(2), ssr_is, &off);
+    TEST_ASSERT_NOT_EQUAL(-1, t_off);
+    TEST_ASSERT_TRUE(t_off - task_sim_cmd_queued_us() < MS(1));
+
+    uint32_t edges = task_sim_ssr_rising_edges();
+    rtos_sim_run(rtos_sim_now() + S(10), NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT32(edges, task_sim_ssr_rising_edges());
+}
+
+static void test_over_temp_sample_to_ssr_off_is_bounded(void)
+{
+    boot(true);
+    start_firing();
+    rtos_sim_run(rtos_sim_now() + S(60), NULL, NULL);
+    TEST_ASSERT_TRUE(task_sim_ssr_on());
+
+    int64_t t_force = rtos_sim_now() + 1;
+    task_sim_force_tc(1350.0f, 0);
+    int64_t t_sample = rtos_sim_run(rtos_sim_now() + S(1), sampled_since, &t_force);
+    TEST_ASSERT_NOT_EQUAL(-1, t_sample);
+    bool off = false;
+    int64_t t_off = rtos_sim_run(rtos_sim_now() + S(2), ssr_is, &off);
+    TEST_ASSERT_NOT_EQUAL(-1, t_off);
+
+    /* safety_task polls every 500 ms; the trip and the GPIO write cost a few
+       tens of µs on top. Anything more means a task is in the way. */
+    TEST_ASSERT_TRUE(t_off - t_sample <= MS(500) + MS(1));
+    TEST_ASSERT_TRUE(safety_is_emergency());
+    TEST_ASSERT_EQUAL_INT(SAFETY_TRIP_OVER_TEMP, safety_get_trip_cause());
+
+    uint32_t edges = task_sim_ssr_rising_edges();
+    rtos_sim_run(rtos_sim_now() + S(10), NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT32(edges, task_sim_ssr_rising_edges());
+
+    firing_progress_t prog;
+    firing_engine_get_progress(&prog);
+    TEST_ASSERT_EQUAL_INT(FIRING_STATUS_ERROR, prog.status);
+    TEST_ASSERT_TRUE(task_sim_alarm_tones() > 0); /* notify task beeped */
+}
+
+static void test_tc_fault_cuts_the_element_then_trips(void)
+{
+    boot(false);
+    start_firing();
+    rtos_sim_run(rtos_sim_now() + S(30), NULL, NULL);
+
+    int64_t t_force = rtos_sim_now() + 1;
+    task_sim_force_tc(0.0f, TC_FAULT_OPEN_CIRCUIT);
+    int64_t t_sample = rtos_sim_run(rtos_sim_now() + S(1), sampled_since, &t_force);
+    TEST_ASSERT_NOT_EQUAL(-1, t_sample);
+
+    /* The engine holds the element off from its next tick... */
+    bool off = false;
+    int64_t t_off = rtos_sim_run(rtos_sim_now() + S(2), ssr_is, &off);
+    TEST_ASSERT_NOT_EQUAL(-1, t_off);
+    TEST_ASSERT_TRUE(t_off - t_sample <= S(1) + MS(1));
+    TEST_ASSERT_FALSE(safety_is_emergency());
+
+    /* ...and safety escalates once the fault outlives the 5 s timeout,
+       measured from the last good sample. */
+    int64_t t_trip = rtos_sim_run(rtos_sim_now() + S(10), emergency, NULL);
+    TEST_ASSERT_NOT_EQUAL(-1, t_trip);
+    TEST_ASSERT_TRUE(t_trip - t_sample <= S(5) + MS(500) + MS(1));
+    TEST_ASSERT_EQUAL_INT(SAFETY_TRIP_TC_FAULT, safety_get_trip_cause());
+}
+
+static void test_firing_with_ui_load_has_no_progress_inversions(void)
+{
+    boot(true);
+    start_firing();
+    rtos_sim_run(rtos_sim_now() + S(600), NULL, NULL);
+
+    rtos_sim_mutex_stats_t mx;
+    TEST_ASSERT_TRUE(rtos_sim_mutex_stats("progress", &mx));
+    TEST_ASSERT_TRUE(mx.takes > 1000);
+    TEST_ASSERT_EQUAL_UINT32(0, mx.inversions);
+
+    /* Core 1 carries only the control tasks: the UI never delays them. */
+    rtos_sim_task_stats_t st;
+    TEST_ASSERT_TRUE(rtos_sim_task_stats("safety", &st));
+    TEST_ASSERT_TRUE(st.max_latency_us < MS(1));
+    TEST_ASSERT_TRUE(rtos_sim_task_stats("firing", &st));
+    TEST_ASSERT_TRUE(st.max_latency_us < MS(1));
+    TEST_ASSERT_TRUE(rtos_sim_core_load(0) < 0.5f);
+    TEST_ASSERT_FALSE(safety_is_emergency());
+
+    rtos_sim_report(stdout);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_higher_priority_preempts_on_its_core);
+    RUN_TEST(test_cores_run_in_parallel);
+    RUN_TEST(test_delay_until_holds_period_under_load);
+    RUN_TEST(test_inheritance_bounds_the_wait_for_a_lock);
+    RUN_TEST(test_inversion_detected_without_inheritance);
+    RUN_TEST(test_idle_boot_runs_every_task_at_its_period);
+    RUN_TEST(test_lcd_flush_delays_tc_read_by_at_most_one_chunk);
+    RUN_TEST(test_start_command_takes_effect_within_a_tick);
+    RUN_TEST(test_stop_command_turns_the_element_off);
+    RUN_TEST(test_over_temp_sample_to_ssr_off_is_bounded);
+    RUN_TEST(test_tc_fault_cuts_the_element_then_trips);
+    RUN_TEST(test_firing_with_ui_load_has_no_progress_inversions);
+    return UNITY_END();
+}
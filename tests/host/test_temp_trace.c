@@ -0,0 +1,189 @@
+#include "temp_trace.h"
+#include "unity.h"
+
+static temp_trace_t s_trace;
+static temp_trace_view_t s_view;
+
+void setUp(void)
+{
+    temp_trace_reset(&s_trace);
+}
+void tearDown(void)
+{
+}
+
+/* One sample a second, as the engine's 1 Hz tick delivers them. */
+static void feed_seconds(uint32_t from_s, uint32_t to_s, float (*temp_at)(uint32_t))
+{
+    for (uint32_t t = from_s; t < to_s; t++) {
+        temp_trace_add(&s_trace, t * 1000u, temp_at(t));
+    }
+}
+
+static float ramp_1c_per_s(uint32_t t_s)
+{
+    return (float)t_s;
+}
+
+/* Whole degrees per minute, so a 12-hour firing stays well inside int16. */
+static float ramp_1c_per_min(uint32_t t_s)
+{
+    return (float)(t_s / 60);
+}
+
+/* ── Empty / reset ─────────────────────────────────────────────────────── */
+
+static void test_empty_trace_has_no_points(void)
+{
+    temp_trace_copy(&s_trace, TEMP_TRACE_ZOOM_FIRING, &s_view);
+    TEST_ASSERT_EQUAL_UINT32(0, s_view.count);
+
+    temp_trace_copy(&s_trace, TEMP_TRACE_ZOOM_TEN_MIN, &s_view);
+    TEST_ASSERT_EQUAL_UINT32(TEMP_TRACE_POINTS, s_view.count);
+    for (int i = 0; i < TEMP_TRACE_POINTS; i++) {
+        TEST_ASSERT_EQUAL_INT16(TEMP_TRACE_NONE, s_view.pts[i].lo);
+    }
+}
+
+static void test_reset_clears_previous_firing(void)
+{
+    feed_seconds(0, 600, ramp_1c_per_s);
+    temp_trace_reset(&s_trace);
+    temp_trace_add(&s_trace, 0, 20.0f);
+
+    temp_trace_copy(&s_trace, TEMP_TRACE_ZOOM_HOUR, &s_view);
+    TEST_ASSERT_EQUAL_INT16(20, s_view.pts[TEMP_TRACE_POINTS - 1].hi);
+    TEST_ASSERT_EQUAL_INT16(TEMP_TRACE_NONE, s_view.pts[TEMP_TRACE_POINTS - 2].hi);
+}
+
+/* ── Ring levels ───────────────────────────────────────────────────────── */
+
+static void test_bucket_keeps_min_and_max(void)
+{
+    temp_trace_add(&s_trace, 0, 100.0f);
+    temp_trace_add(&s_trace, 1000, 94.6f);
+    temp_trace_add(&s_trace, 3000, 103.4f);
+
+    temp_trace_copy(&s_trace, TEMP_TRACE_ZOOM_TEN_MIN, &s_view); /* 2.5 s buckets: 0 and 1 s share one */
+    TEST_ASSERT_EQUAL_INT16(95, s_view.pts[TEMP_TRACE_POINTS - 2].lo);
+    TEST_ASSERT_EQUAL_INT16(100, s_view.pts[TEMP_TRACE_POINTS - 2].hi);
+    TEST_ASSERT_EQUAL_INT16(103, s_view.pts[TEMP_TRACE_POINTS - 1].lo);
+
+    temp_trace_copy(&s_trace, TEMP_TRACE_ZOOM_HOUR, &s_view); /* one 15 s bucket holds all three */
+    TEST_ASSERT_EQUAL_INT16(95, s_view.pts[TEMP_TRACE_POINTS - 1].lo);
+    TEST_ASSERT_EQUAL_INT16(103, s_view.pts[TEMP_TRACE_POINTS - 1].hi);
+}
+
+static void test_ten_minute_ring_covers_last_ten_minutes(void)
+{
+    feed_seconds(0, 3 * 3600, ramp_1c_per_s);
+
+    temp_trace_copy(&s_trace, TEMP_TRACE_ZOOM_TEN_MIN, &s_view);
+    TEST_ASSERT_EQUAL_UINT32(2500, s_view.bucket_ms);
+    /* Newest bucket is [10797.5, 10800) s: only the 10798 and 10799 s samples. */
+    TEST_ASSERT_EQUAL_INT16(10798, s_view.pts[TEMP_TRACE_POINTS - 1].lo);
+    TEST_ASSERT_EQUAL_INT16(10799, s_view.pts[TEMP_TRACE_POINTS - 1].hi);
+    /* Oldest bucket starts ten minutes earlier. */
+    TEST_ASSERT_EQUAL_INT16(10200, s_view.pts[0].lo);
+    for (int i = 1; i < TEMP_TRACE_POINTS; i++) {
+        TEST_ASSERT_TRUE(s_view.pts[i].lo >= s_view.pts[i - 1].hi);
+    }
+}
+
+static void test_hour_ring_covers_last_hour(void)
+{
+    feed_seconds(0, 5 * 3600, ramp_1c_per_s);
+
+    temp_trace_copy(&s_trace, TEMP_TRACE_ZOOM_HOUR, &s_view);
+    TEST_ASSERT_EQUAL_UINT32(15000, s_view.bucket_ms);
+    TEST_ASSERT_EQUAL_INT16(4 * 3600, s_view.pts[0].lo);
+    TEST_ASSERT_EQUAL_INT16(4 * 3600 + 14, s_view.pts[0].hi);
+    TEST_ASSERT_EQUAL_INT16(5 * 3600 - 1, s_view.pts[TEMP_TRACE_POINTS - 1].hi);
+}
+
+static void test_gap_leaves_empty_buckets(void)
+{
+    temp_trace_add(&s_trace, 0, 500.0f);
+    temp_trace_add(&s_trace, 10000, 510.0f); /* 10 s later: three 2.5 s buckets skipped */
+
+    temp_trace_copy(&s_trace, TEMP_TRACE_ZOOM_TEN_MIN, &s_view);
+    TEST_ASSERT_EQUAL_INT16(510, s_view.pts[TEMP_TRACE_POINTS - 1].lo);
+    TEST_ASSERT_EQUAL_INT16(TEMP_TRACE_NONE, s_view.pts[TEMP_TRACE_POINTS - 2].lo);
+    TEST_ASSERT_EQUAL_INT16(TEMP_TRACE_NONE, s_view.pts[TEMP_TRACE_POINTS - 4].lo);
+    TEST_ASSERT_EQUAL_INT16(500, s_view.pts[TEMP_TRACE_POINTS - 5].lo);
+}
+
+static void test_gap_longer_than_ring_drops_stale_lap(void)
+{
+    feed_seconds(0, 600, ramp_1c_per_s);
+    temp_trace_add(&s_trace, 3600 * 1000u, 900.0f); /* ring's whole span went by without samples */
+
+    temp_trace_copy(&s_trace, TEMP_TRACE_ZOOM_TEN_MIN, &s_view);
+    TEST_ASSERT_EQUAL_INT16(900, s_view.pts[TEMP_TRACE_POINTS - 1].hi);
+    for (int i = 0; i < TEMP_TRACE_POINTS - 1; i++) {
+        TEST_ASSERT_EQUAL_INT16(TEMP_TRACE_NONE, s_view.pts[i].hi);
+    }
+}
+
+/* ── Whole-firing level ────────────────────────────────────────────────── */
+
+static void test_firing_level_starts_at_fifteen_seconds(void)
+{
+    feed_seconds(0, 1800, ramp_1c_per_s);
+
+    temp_trace_copy(&s_trace, TEMP_TRACE_ZOOM_FIRING, &s_view);
+    TEST_ASSERT_EQUAL_UINT32(15000, s_view.bucket_ms);
+    TEST_ASSERT_EQUAL_UINT32(120, s_view.count);
+    TEST_ASSERT_EQUAL_INT16(0, s_view.pts[0].lo);
+    TEST_ASSERT_EQUAL_INT16(1799, s_view.pts[119].hi);
+}
+
+static void test_firing_level_coarsens_to_fit(void)
+{
+    feed_seconds(0, 12 * 3600, ramp_1c_per_min);
+
+    temp_trace_copy(&s_trace, TEMP_TRACE_ZOOM_FIRING, &s_view);
+    /* 12 h needs 180 s buckets; doubling from 15 s lands on 240 s. */
+    TEST_ASSERT_EQUAL_UINT32(240000, s_view.bucket_ms);
+    TEST_ASSERT_EQUAL_UINT32(180, s_view.count);
+    TEST_ASSERT_EQUAL_INT16(0, s_view.pts[0].lo);
+    TEST_ASSERT_EQUAL_INT16(3, s_view.pts[0].hi);
+    TEST_ASSERT_EQUAL_INT16(12 * 60 - 1, s_view.pts[179].hi);
+    for (uint32_t i = 0; i < s_view.count; i++) {
+        TEST_ASSERT_EQUAL_INT16((int16_t)(i * 4), s_view.pts[i].lo);
+    }
+    TEST_ASSERT_EQUAL_INT16(TEMP_TRACE_NONE, s_view.pts[180].lo);
+}
+
+static void test_coarsening_keeps_extremes(void)
+{
+    for (uint32_t t = 0; t < 4 * 3600; t++) {
+        float temp = (t == 1234) ? 1300.0f : (t == 2345) ? 5.0f : 600.0f;
+        temp_trace_add(&s_trace, t * 1000u, temp);
+    }
+
+    temp_trace_copy(&s_trace, TEMP_TRACE_ZOOM_FIRING, &s_view);
+    int16_t lo = INT16_MAX, hi = INT16_MIN;
+    for (uint32_t i = 0; i < s_view.count; i++) {
+        lo = s_view.pts[i].lo < lo ? s_view.pts[i].lo : lo;
+        hi = s_view.pts[i].hi > hi ? s_view.pts[i].hi : hi;
+    }
+    TEST_ASSERT_EQUAL_INT16(5, lo);
+    TEST_ASSERT_EQUAL_INT16(1300, hi);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_trace_has_no_points);
+    RUN_TEST(test_reset_clears_previous_firing);
+    RUN_TEST(test_bucket_keeps_min_and_max);
+    RUN_TEST(test_ten_minute_ring_covers_last_ten_minutes);
+    RUN_TEST(test_hour_ring_covers_last_hour);
+    RUN_TEST(test_gap_leaves_empty_buckets);
+    RUN_TEST(test_gap_longer_than_ring_drops_stale_lap);
+    RUN_TEST(test_firing_level_starts_at_fifteen_seconds);
+    RUN_TEST(test_firing_level_coarsens_to_fit);
+    RUN_TEST(test_coarsening_keeps_extremes);
+    return UNITY_END();
+}
@@ -0,0 +1,112 @@
+#include "firing_engine.h"
+#include "firing_engine_internal.h"
+#include "scenario_helpers.h"
+#include "unity.h"
+
+#include <string.h>
+
+/* Built with CONFIG_FIRING_TICK_PROFILE (see CMakeLists.txt). Cycle counts
+ * come from the host's real clock, so the checks are on which phases ran how
+ * often, not on what they cost. */
+
+static plant_t g_plant;
+
+void setUp(void)
+{
+    scenario_setup(&g_plant, 25.0f);
+}
+
+void tearDown(void)
+{
+    scenario_stop();
+}
+
+static firing_tick_profile_t profile(void)
+{
+    firing_tick_profile_t p;
+    TEST_ASSERT_TRUE(firing_engine_get_tick_profile(&p));
+    return p;
+}
+
+static void test_idle_ticks_stop_after_the_run_state(void)
+{
+    scenario_run_ticks(&g_plant, 30);
+    firing_tick_profile_t p = profile();
+    TEST_ASSERT_EQUAL_UINT32(30, p.cycles[FIRING_PHASE_RELAY_TEST].count);
+    TEST_ASSERT_EQUAL_UINT32(30, p.cycles[FIRING_PHASE_TC_READ].count);
+    TEST_ASSERT_EQUAL_UINT32(30, p.cycles[FIRING_PHASE_EMERGENCY].count);
+    TEST_ASSERT_EQUAL_UINT32(0, p.cycles[FIRING_PHASE_PID].count);
+    TEST_ASSERT_EQUAL_UINT32(0, p.cycles[FIRING_PHASE_ETA].count);
+    TEST_ASSERT_EQUAL_UINT32(0, p.cycles[FIRING_PHASE_RECORD].count); /* built without CONFIG_FIRING_RECORD */
+}
+
+static void test_firing_ticks_run_every_control_phase(void)
+{
+    firing_profile_t fp = scenario_short_profile();
+    scenario_start(&fp, 0);
+    scenario_run_ticks(&g_plant, 60);
+
+    firing_tick_profile_t p = profile();
+    uint32_t ticks = p.cycles[FIRING_PHASE_TC_READ].count;
+    TEST_ASSERT_EQUAL_UINT32(60, ticks);
+    static const firing_tick_phase_t control[] = {
+        FIRING_PHASE_WATCHDOGS, FIRING_PHASE_PID,     FIRING_PHASE_ELEMENT_HOURS,
+        FIRING_PHASE_HISTORY,   FIRING_PHASE_SEGMENT, FIRING_PHASE_ETA,
+    };
+    for (size_t i = 0; i < sizeof(control) / sizeof(control[0]); i++) {
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(ticks, p.cycles[control[i]].count, firing_tick_phase_name(control[i]));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, p.cycles[FIRING_PHASE_AUTOTUNE].count);
+}
+
+static void test_early_return_charges_the_phase_it_left_from(void)
+{
+    TEST_ASSERT_TRUE(scenario_relay_test(5));
+    scenario_run_ticks(&g_plant, 3);
+    firing_tick_profile_t p = profile();
+    TEST_ASSERT_EQUAL_UINT32(3, p.cycles[FIRING_PHASE_RELAY_TEST].count);
+    TEST_ASSERT_EQUAL_UINT32(0, p.cycles[FIRING_PHASE_DELAY].count);
+}
+
+static void test_percentiles_are_ordered(void)
+{
+    firing_profile_t fp = scenario_short_profile();
+    scenario_start(&fp, 0);
+    scenario_run_ticks(&g_plant, 120);
+    firing_tick_profile_t p = profile();
+    for (int i = 0; i < FIRING_PHASE_COUNT; i++) {
+        const rt_hist_t *h = &p.cycles[i];
+        if (h->count == 0) {
+            continue;
+        }
+        TEST_ASSERT_TRUE(h->min <= rt_hist_percentile(h, 50));
+        TEST_ASSERT_TRUE(rt_hist_percentile(h, 50) <= rt_hist_percentile(h, 99));
+        TEST_ASSERT_TRUE(rt_hist_percentile(h, 99) <= h->max);
+    }
+}
+
+static void test_phase_names_and_io(void)
+{
+    for (int i = 0; i < FIRING_PHASE_COUNT; i++) {
+        const char *name = firing_tick_phase_name((firing_tick_phase_t)i);
+        TEST_ASSERT_NOT_NULL(name);
+        for (int j = 0; j < i; j++) {
+            TEST_ASSERT_FALSE(strcmp(name, firing_tick_phase_name((firing_tick_phase_t)j)) == 0);
+        }
+    }
+    TEST_ASSERT_EQUAL_STRING("spiffs", firing_tick_phase_io(FIRING_PHASE_HISTORY));
+    TEST_ASSERT_EQUAL_STRING("nvs", firing_tick_phase_io(FIRING_PHASE_ELEMENT_HOURS));
+    TEST_ASSERT_NULL(firing_tick_phase_io(FIRING_PHASE_PID));
+}
+
+int main(void)
+{
+    firing_engine_init();
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_ticks_stop_after_the_run_state);
+    RUN_TEST(test_firing_ticks_run_every_control_phase);
+    RUN_TEST(test_early_return_charges_the_phase_it_left_from);
+    RUN_TEST(test_percentiles_are_ordered);
+    RUN_TEST(test_phase_names_and_io);
+    return UNITY_END();
+}
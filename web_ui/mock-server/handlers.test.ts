@@ -12,8 +12,10 @@ import { handleRequest } from "./handlers";
 import { firingProfileSchema, settingsSchema } from "../src/app/schemas/kiln";
 import {
   autotuneStatusSchema,
+  capabilityBinSchema,
   coneEntrySchema,
   firingProgressResponseSchema,
+  historyEventSchema,
   historyRecordSchema,
   systemInfoSchema,
   thermocoupleDiagSchema,
@@ -106,6 +108,11 @@ describe("mock-server GET endpoints", () => {
     expect(autotuneStatusSchema.safeParse(await get("/autotune/status")).success).toBe(true);
   });
 
+  it("GET /diagnostics/capability returns CapabilityBin[]", async () => {
+    const body = await get("/diagnostics/capability");
+    expect(z.array(capabilityBinSchema).safeParse(body).success).toBe(true);
+  });
+
   it("GET /diagnostics/thermocouple returns full reading", async () => {
     expect(thermocoupleDiagSchema.safeParse(await get("/diagnostics/thermocouple")).success).toBe(
       true,
@@ -123,6 +130,12 @@ describe("mock-server GET endpoints", () => {
     const r = await fetch(`${baseUrl}/history/9999/trace`);
     expect(r.status).toBe(404);
   });
+
+  it("GET /history/:id/events returns HistoryEvent[]", async () => {
+    const body = await get("/history/3/events");
+    expect(z.array(historyEventSchema).safeParse(body).success).toBe(true);
+    expect(body.length).toBeGreaterThan(0);
+  });
 });
 
 // --- POST endpoints ----------------------------------------------------------
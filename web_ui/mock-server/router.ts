@@ -10,6 +10,7 @@
  * Vite dev server, the iOS standalone mock, and the static GitHub Pages demo.
  */
 import type { FiringProfile, FiringSegment, KilnSettings } from '../src/app/types/kiln';
+import { HOLD_UNTIL_SKIP } from '../src/app/types/kiln';
 import { state } from './state';
 import { startFiring, stopFiring, pauseFiring, getStatusResponse } from './simulator';
 
@@ -114,6 +115,21 @@ function generateTraceCsv(record: typeof mockHistory[0]): string {
   return lines.join('\n');
 }
 
+// A plausible journal for a mock record: each segment start and hold, plus a
+// stop for aborted firings. Times follow the shape generateTraceCsv draws.
+function generateEvents(record: typeof mockHistory[0]) {
+  const at = (frac: number) => Math.round(record.durationS * frac);
+  const events: Record<string, unknown>[] = [
+    { t: 0, type: 'segment', source: 'api', temp: 20, segment: 0 },
+    { t: at(0.45), type: 'segment', source: 'engine', temp: Math.round(record.peakTemp * 0.6), segment: 1 },
+    { t: at(0.8), type: 'hold', source: 'engine', temp: record.peakTemp, segment: 1 },
+  ];
+  if (record.outcome === 'aborted') {
+    events.push({ t: record.durationS, type: 'stop', source: 'lcd', temp: record.peakTemp });
+  }
+  return events;
+}
+
 interface ConeFireParams {
   coneId: number;
   speed: number;
@@ -233,7 +249,7 @@ export function dispatch(method: string, apiPath: string, body: unknown): Dispat
     } else {
       state.profiles.push(profile);
     }
-    return { status: 200, json: { ok: true, id: profile.id } };
+    return { status: 200, json: { ok: true, id: profile.id, rampWarnings: [] } };
   }
 
   // POST /profiles/cone-fire
@@ -247,10 +263,45 @@ export function dispatch(method: string, apiPath: string, body: unknown): Dispat
     return { status: 200, json: profile };
   }
 
+  // POST /profiles/optimize — the mock has no planner; echo the profile back
+  if (method === 'POST' && apiPath === '/profiles/optimize') {
+    const req = body as { profile?: FiringProfile; profileId?: string };
+    const profile = req.profile ?? state.profiles.find((p) => p.id === req.profileId);
+    if (!profile) return { status: 404, json: { error: 'Not found' } };
+    const plan = { durationS: profile.estimatedDuration * 60 };
+    return { status: 200, json: { profile, original: plan, optimized: plan, savedS: 0 } };
+  }
+
   // Match /profiles/:id or /profiles/:id/export
   const profileExportMatch = apiPath.match(/^\/profiles\/(.+)\/export$/);
   const profileMatch = apiPath.match(/^\/profiles\/([^/]+)$/);
 
+  // POST /profiles/:id/simulate — the mock has no kiln model; the profile's
+  // own ramps and holds at face value, from room temperature
+  const profileSimulateMatch = apiPath.match(/^\/profiles\/(.+)\/simulate$/);
+  if (method === 'POST' && profileSimulateMatch) {
+    const profile = state.profiles.find((p) => p.id === profileSimulateMatch[1]);
+    if (!profile) return { status: 404, json: { error: 'Not found' } };
+    const run = { segment: 0, peakTemp: profile.maxTemp, maxLag: 0, pointEveryS: 60 };
+    let t = 0;
+    let temp = 20;
+    const curve: [number, number][] = [[0, temp]];
+    for (const [i, seg] of profile.segments.entries()) {
+      if (seg.rampRate !== 0) {
+        t += Math.round((Math.abs(seg.targetTemp - temp) / Math.abs(seg.rampRate)) * 3600);
+      }
+      temp = seg.targetTemp;
+      curve.push([t, temp]);
+      run.segment = i;
+      if (seg.holdTime === HOLD_UNTIL_SKIP) {
+        return { status: 200, json: { ...run, outcome: 'waits', durationS: t, curve } };
+      }
+      t += seg.holdTime * 60;
+      curve.push([t, temp]);
+    }
+    return { status: 200, json: { ...run, outcome: 'complete', durationS: t, curve } };
+  }
+
   // GET /profiles/:id/export
   if (method === 'GET' && profileExportMatch) {
     const profile = state.profiles.find((p) => p.id === profileExportMatch[1]);
@@ -279,7 +330,7 @@ export function dispatch(method: string, apiPath: string, body: unknown): Dispat
     } else {
       state.profiles.push(profile);
     }
-    return { status: 200, json: { ok: true, id: profile.id } };
+    return { status: 200, json: { ok: true, id: profile.id, rampWarnings: [] } };
   }
 
   // DELETE /profiles/:id
@@ -295,6 +346,33 @@ export function dispatch(method: string, apiPath: string, body: unknown): Dispat
     return { status: 200, json: { ok: true } };
   }
 
+  // POST /firing/schedule — the mock has no power curve or tariff: every start
+  // costs the same, so it starts now at the flat rate, half power throughout
+  if (method === 'POST' && apiPath === '/firing/schedule') {
+    const { profileId, arm } = body as { profileId: string; arm?: boolean };
+    const profile = state.profiles.find((p) => p.id === profileId);
+    if (!profile) return { status: 404, json: { error: 'Profile not found' } };
+    const startAt = Math.floor(Date.now() / 1000);
+    const durationS = profile.estimatedDuration * 60;
+    const energyKwh = ((state.settings.elementWatts ?? 0) / 1000) * 0.5 * (durationS / 3600);
+    const cost = Math.round(energyKwh * (state.settings.electricityCostKwh ?? 0) * 100) / 100;
+    if (arm !== false) startFiring(profileId);
+    return {
+      status: 200,
+      json: {
+        startAt,
+        delayMinutes: 0,
+        finishAt: startAt + durationS,
+        durationS,
+        energyKwh: Math.round(energyKwh * 100) / 100,
+        cost,
+        earliestCost: cost,
+        savings: 0,
+        armed: arm !== false,
+      },
+    };
+  }
+
   // POST /firing/stop
   if (method === 'POST' && apiPath === '/firing/stop') {
     stopFiring();
@@ -338,6 +416,15 @@ export function dispatch(method: string, apiPath: string, body: unknown): Dispat
     return { status: 200, text: generateTraceCsv(record), contentType: 'text/csv' };
   }
 
+  // GET /history/:id/events
+  const historyEventsMatch = apiPath.match(/^\/history\/(\d+)\/events$/);
+  if (method === 'GET' && historyEventsMatch) {
+    const id = parseInt(historyEventsMatch[1], 10);
+    const record = mockHistory.find((r) => r.id === id);
+    if (!record) return { status: 404, json: { error: 'Not found' } };
+    return { status: 200, json: generateEvents(record) };
+  }
+
   // GET /settings
   if (method === 'GET' && apiPath === '/settings') {
     return {
@@ -349,6 +436,7 @@ export function dispatch(method: string, apiPath: string, body: unknown): Dispat
         apiTokenSet: false,
         elementWatts: state.settings.elementWatts ?? 0,
         electricityCostKwh: state.settings.electricityCostKwh ?? 0,
+        tariff: state.settings.tariff ?? [],
       },
     };
   }
@@ -458,6 +546,11 @@ export function dispatch(method: string, apiPath: string, body: unknown): Dispat
     return { status: 200, json: { ok: true, durationSeconds } };
   }
 
+  // GET /diagnostics/capability — nothing learned on a fresh mock kiln
+  if (method === 'GET' && apiPath === '/diagnostics/capability') {
+    return { status: 200, json: [] };
+  }
+
   // GET /diagnostics/thermocouple
   if (method === 'GET' && apiPath === '/diagnostics/thermocouple') {
     const temp = state.firing.currentTemp;
@@ -473,6 +566,15 @@ export function dispatch(method: string, apiPath: string, body: unknown): Dispat
         readingAgeMs: Math.round(Math.random() * 250),
         tcOffsetC: state.settings.tcOffsetC ?? 0,
         temperatureAdjustedC: temp + (state.settings.tcOffsetC ?? 0),
+        timing: {
+          reads: 0,
+          busWaits: 0,
+          maxBusWaitUs: 0,
+          maxReadUs: 0,
+          intervals: 0,
+          maxJitterUs: 0,
+          meanJitterUs: 0,
+        },
       },
     };
   }
@@ -25,6 +25,7 @@ import {
   Clock,
   SkipForward,
   Timer,
+  PiggyBank,
 } from "lucide-react";
 import {
   TemperatureDataPoint,
@@ -36,7 +37,7 @@ import { api } from "../services/api";
 import { toast } from "sonner";
 import { formatDuration } from "../utils/time";
 import { toErrorMessage } from "../utils/error";
-import { computeSegmentDurationMinutes } from "../utils/profile";
+import { coneName, computeSegmentDurationMinutes } from "../utils/profile";
 import { useKilnStore } from "../stores/kilnStore";
 import { ConnectionBanner } from "./ConnectionBanner";
 import {
@@ -50,10 +51,12 @@ import {
 import {
   useProfiles,
   useStartFiring,
+  useScheduleFiring,
   useStopFiring,
   usePauseFiring,
   useSkipSegment,
   useTempUnit,
+  useConeTable,
 } from "../hooks/queries";
 import { formatTemp, formatRate, toDisplayTemp, unitLabel } from "../utils/temperature";
 
@@ -74,17 +77,21 @@ export function FiringDashboard() {
   } = useKilnStore();
   const { data: profiles = [] } = useProfiles();
   const unit = useTempUnit();
+  const { data: cones = [] } = useConeTable();
   const selectedProfile = useMemo(
     () => profiles.find((p) => p.id === selectedProfileId) ?? null,
     [profiles, selectedProfileId],
   );
 
   const startFiring = useStartFiring();
+  const scheduleFiring = useScheduleFiring();
   const stopFiring = useStopFiring();
   const pauseFiring = usePauseFiring();
   const skipSegment = useSkipSegment();
 
   const [delayMinutes, setDelayMinutes] = useState<number>(0);
+  // Optional deadline for the cheapest-start scheduler, as a datetime-local value.
+  const [finishBy, setFinishBy] = useState("");
   // Stopping mid-firing ruins the load, so it is confirmed here the way the
   // on-device LCD confirms it (modal_action_menu.c). An accidental tap is far
   // more likely on the web surface than on the physical 5-way switch.
@@ -112,6 +119,8 @@ export function FiringDashboard() {
             elapsedTime: s.elapsedTime,
             estimatedTimeRemaining: s.estimatedTimeRemaining,
             status: coerceFiringStatus(s.status),
+            equivCone: s.equivCone,
+            kilnLoad: s.kilnLoad,
           },
           currentTempData: [
             {
@@ -191,6 +200,32 @@ export function FiringDashboard() {
     }
   }, [selectedProfile, delayMinutes, startFiring, resetTempData]);
 
+  // Let the controller pick the start the time-of-use tariff makes cheapest and
+  // arm it as a delayed start. The tariff's clock is taken to be this browser's.
+  const handleScheduleCheapest = useCallback(async () => {
+    if (!selectedProfile) return;
+    try {
+      const plan = await scheduleFiring.mutateAsync({
+        profileId: selectedProfile.id,
+        finishBy: finishBy ? Math.floor(new Date(finishBy).getTime() / 1000) : undefined,
+        utcOffsetMin: -new Date().getTimezoneOffset(),
+      });
+      resetTempData();
+      const at = new Date(plan.startAt * 1000).toLocaleString([], {
+        weekday: "short",
+        hour: "2-digit",
+        minute: "2-digit",
+      });
+      toast.success(
+        plan.savings > 0
+          ? `Firing scheduled for ${at}: $${plan.cost.toFixed(2)}, saving $${plan.savings.toFixed(2)}`
+          : `Firing scheduled for ${at}: $${plan.cost.toFixed(2)}, already the cheapest time`,
+      );
+    } catch (e) {
+      toast.error(`Failed to schedule: ${toErrorMessage(e)}`);
+    }
+  }, [selectedProfile, finishBy, scheduleFiring, resetTempData]);
+
   const handleSkipSegment = useCallback(async () => {
     try {
       await skipSegment.mutateAsync();
@@ -352,6 +387,18 @@ export function FiringDashboard() {
                   Kiln will start in {delayMinutes} min
                 </p>
               )}
+              <div className="space-y-2 w-56">
+                <Label htmlFor="finish-by" className="flex items-center gap-1">
+                  <PiggyBank className="h-3 w-3" />
+                  Finish By (cheapest start)
+                </Label>
+                <Input
+                  id="finish-by"
+                  type="datetime-local"
+                  value={finishBy}
+                  onChange={(e) => setFinishBy(e.target.value)}
+                />
+              </div>
             </div>
           )}
 
@@ -391,6 +438,19 @@ export function FiringDashboard() {
                 Estimated time remaining: {formatDuration(firingProgress.estimatedTimeRemaining)}
               </p>
             )}
+            {firingProgress.isActive && firingProgress.equivCone && (
+              <p className="text-sm text-muted-foreground">
+                Heat work so far: cone {firingProgress.equivCone}
+              </p>
+            )}
+            {firingProgress.isActive &&
+              firingProgress.kilnLoad !== undefined &&
+              Math.abs(firingProgress.kilnLoad - 1) >= 0.1 && (
+                <p className="text-sm text-muted-foreground">
+                  Heating {Math.round(Math.abs(firingProgress.kilnLoad - 1) * 100)}%{" "}
+                  {firingProgress.kilnLoad < 1 ? "slower" : "faster"} than usual at full power
+                </p>
+              )}
           </div>
 
           <div className="flex gap-2">
@@ -411,6 +471,18 @@ export function FiringDashboard() {
               </Button>
             )}
 
+            {!firingProgress.isActive && firingProgress.status !== "paused" && (
+              <Button
+                onClick={handleScheduleCheapest}
+                disabled={!selectedProfile || scheduleFiring.isPending}
+                variant="outline"
+                className="gap-2"
+              >
+                <PiggyBank className="h-4 w-4" />
+                Cheapest Start
+              </Button>
+            )}
+
             <Button
               onClick={() => setStopConfirmOpen(true)}
               variant="destructive"
@@ -465,6 +537,8 @@ export function FiringDashboard() {
                     {segment.holdTime > 0 &&
                       segment.holdTime !== HOLD_UNTIL_SKIP &&
                       `, hold ${segment.holdTime} min`}
+                    {segment.endConeId !== undefined &&
+                      `, until cone ${coneName(cones, segment.endConeId)}`}
                   </div>
                 </div>
               ))}
@@ -10,8 +10,9 @@ import {
   CartesianGrid,
   Tooltip,
   ResponsiveContainer,
+  ReferenceLine,
 } from "recharts";
-import { HistoryRecord } from "../types/kiln";
+import { HistoryEvent, HistoryRecord } from "../types/kiln";
 import { api } from "../services/api";
 import { Download, Flame, Clock, Thermometer } from "lucide-react";
 import { toast } from "sonner";
@@ -21,15 +22,56 @@ import { toErrorMessage } from "../utils/error";
 import { useHistory, useTempUnit } from "../hooks/queries";
 import { formatTemp, toDisplayTemp, unitLabel } from "../utils/temperature";
 
+// Short marker text for a journal event on the trace chart.
+function eventLabel(e: HistoryEvent): string {
+  const by = e.source === "engine" ? "" : ` (${e.source === "lcd" ? "LCD" : "API"})`;
+  switch (e.type) {
+    case "segment":
+      return e.source === "engine" || e.t === 0
+        ? `Seg ${(e.segment ?? 0) + 1}`
+        : `Skip → ${(e.segment ?? 0) + 1}${by}`;
+    case "hold":
+      return `Hold ${(e.segment ?? 0) + 1}`;
+    case "pause":
+      return `Pause${by}`;
+    case "resume":
+      return `Resume${by}`;
+    case "tcFault":
+      return "TC fault";
+    case "tcOk":
+      return "TC OK";
+    case "trip":
+      return `Trip #${e.errorCode ?? 0}`;
+    case "settings":
+      return "Settings";
+    case "stop":
+      return `Stop${by}`;
+    case "cone":
+      return `Cone ${e.cone ?? "?"}`;
+  }
+}
+
+const EVENT_COLORS: Partial<Record<HistoryEvent["type"], string>> = {
+  pause: "var(--chart-4)",
+  resume: "var(--chart-4)",
+  tcFault: "var(--destructive)",
+  trip: "var(--destructive)",
+  stop: "var(--destructive)",
+};
+
 export function FiringHistory() {
   const { data: records = [], isLoading } = useHistory();
   const unit = useTempUnit();
   const [selectedRecord, setSelectedRecord] = useState<HistoryRecord | null>(null);
   const [traceData, setTraceData] = useState<{ time_s: number; temp_c: number }[]>([]);
+  const [events, setEvents] = useState<HistoryEvent[]>([]);
 
   const handleSelectRecord = useCallback(async (record: HistoryRecord) => {
     setSelectedRecord(record);
     setTraceData([]);
+    setEvents([]);
+    // Older records have no journal; the chart just goes without markers.
+    api.getHistoryEvents(record.id).then(setEvents, () => {});
     try {
       const csv = await api.getHistoryTrace(record.id);
       const lines = csv.trim().split("\n").slice(1);
@@ -81,7 +123,8 @@ export function FiringHistory() {
       <div>
         <h2 className="text-2xl font-semibold mb-2">Firing History</h2>
         <p className="text-muted-foreground">
-          Records of past firings. Click a record to view the temperature trace.
+          Records of past firings. Click a record to view the temperature trace and what happened
+          during the firing.
         </p>
       </div>
 
@@ -190,6 +233,8 @@ export function FiringHistory() {
                         <CartesianGrid strokeDasharray="3 3" />
                         <XAxis
                           dataKey="time_s"
+                          type="number"
+                          domain={["dataMin", "dataMax"]}
                           tickFormatter={(v) => `${Math.round(v / 60)}m`}
                           label={{ value: "Time", position: "insideBottom", offset: -5 }}
                         />
@@ -212,6 +257,20 @@ export function FiringHistory() {
                           dot={false}
                           name="Temperature"
                         />
+                        {events.map((e, i) => (
+                          <ReferenceLine
+                            key={i}
+                            x={e.t}
+                            stroke={EVENT_COLORS[e.type] ?? "var(--muted-foreground)"}
+                            strokeDasharray="4 2"
+                            label={{
+                              value: eventLabel(e),
+                              position: "insideTopLeft",
+                              fontSize: 10,
+                              angle: -90,
+                            }}
+                          />
+                        ))}
                       </LineChart>
                     </ResponsiveContainer>
                   ) : (
@@ -1,22 +1,31 @@
-import { useRef, useMemo } from "react";
+import { useRef, useMemo, useState } from "react";
 import { Card, CardContent, CardDescription, CardHeader, CardTitle } from "./ui/card";
 import { Button } from "./ui/button";
 import { Badge } from "./ui/badge";
 import { FiringProfile, HOLD_UNTIL_SKIP } from "../types/kiln";
 import { firingProfileSchema } from "../schemas/kiln";
-import { Flame, Clock, TrendingUp, Copy, Download, Upload } from "lucide-react";
-import { api } from "../services/api";
+import { Flame, Clock, TrendingUp, Copy, Download, Upload, PlayCircle } from "lucide-react";
+import { api, SimulationResult } from "../services/api";
 import { toast } from "sonner";
-import { formatDurationFromMinutes } from "../utils/time";
+import { formatDuration, formatDurationFromMinutes } from "../utils/time";
 import { downloadBlob } from "../utils/download";
 import { toErrorMessage } from "../utils/error";
 import { useKilnStore } from "../stores/kilnStore";
-import { useProfiles, useDuplicateProfile, useImportProfile, useTempUnit } from "../hooks/queries";
-import { formatTemp, formatRate } from "../utils/temperature";
+import {
+  useProfiles,
+  useDuplicateProfile,
+  useImportProfile,
+  useTempUnit,
+  useConeTable,
+  useSimulateProfile,
+} from "../hooks/queries";
+import { formatTemp, formatRate, toDisplayRate, unitLabel, TempUnit } from "../utils/temperature";
+import { coneName } from "../utils/profile";
 
 export function FiringProfiles() {
   const { selectedProfileId, setSelectedProfileId } = useKilnStore();
   const unit = useTempUnit();
+  const { data: cones = [] } = useConeTable();
   const { data: profiles = [] } = useProfiles();
   const selectedProfile = useMemo(
     () => profiles.find((p) => p.id === selectedProfileId) ?? null,
@@ -25,6 +34,8 @@ export function FiringProfiles() {
 
   const duplicateProfile = useDuplicateProfile();
   const importProfile = useImportProfile();
+  const simulateProfile = useSimulateProfile();
+  const [dryRuns, setDryRuns] = useState<Record<string, SimulationResult>>({});
 
   const importInputRef = useRef<HTMLInputElement>(null);
 
@@ -49,6 +60,16 @@ export function FiringProfiles() {
     }
   };
 
+  const handleDryRun = async (e: React.MouseEvent, profile: FiringProfile) => {
+    e.stopPropagation();
+    try {
+      const result = await simulateProfile.mutateAsync({ id: profile.id });
+      setDryRuns((runs) => ({ ...runs, [profile.id]: result }));
+    } catch (err) {
+      toast.error(`Dry run failed: ${toErrorMessage(err)}`);
+    }
+  };
+
   const handleImportClick = () => {
     importInputRef.current?.click();
   };
@@ -144,13 +165,27 @@ export function FiringProfiles() {
                         {segment.holdTime > 0 &&
                           segment.holdTime !== HOLD_UNTIL_SKIP &&
                           `, hold ${segment.holdTime} min`}
+                        {segment.endConeId !== undefined &&
+                          `, until cone ${coneName(cones, segment.endConeId)}`}
                       </div>
                     </div>
                   ))}
                 </div>
               </div>
 
+              {dryRuns[profile.id] && <DryRunSummary result={dryRuns[profile.id]} unit={unit} />}
+
               <div className="flex gap-2 pt-1">
+                <Button
+                  variant="outline"
+                  size="sm"
+                  className="flex-1 gap-1"
+                  disabled={simulateProfile.isPending}
+                  onClick={(e) => handleDryRun(e, profile)}
+                >
+                  <PlayCircle className="h-3 w-3" />
+                  Dry Run
+                </Button>
                 <Button
                   variant="outline"
                   size="sm"
@@ -188,3 +223,37 @@ export function FiringProfiles() {
     </div>
   );
 }
+
+const DRY_RUN_ENDINGS: Record<SimulationResult["outcome"], string> = {
+  complete: "Finishes",
+  waits: "Reaches its hold-until-skip",
+  stalled: "Stalls — the kiln can't reach the next target",
+  timeout: "Still firing after 72 h",
+  cancelled: "Dry run cut short",
+};
+
+/** Prediction from the on-device kiln model, shown under a profile card. */
+function DryRunSummary({ result, unit }: { result: SimulationResult; unit: TempUnit }) {
+  return (
+    <div className="text-xs bg-muted/50 p-2 rounded space-y-1">
+      <p className="font-semibold text-muted-foreground">DRY RUN</p>
+      <p>
+        {DRY_RUN_ENDINGS[result.outcome]} after {formatDuration(result.durationS)}, peak{" "}
+        {formatTemp(result.peakTemp, unit)}
+        {result.equivCone && `, cone ${result.equivCone}`}
+      </p>
+      {result.energyKwh !== undefined && (
+        <p>
+          {result.energyKwh.toFixed(1)} kWh
+          {result.cost !== undefined && ` ≈ $${result.cost.toFixed(2)}`}
+        </p>
+      )}
+      {result.maxLag >= 10 && (
+        <p className="text-amber-600">
+          Falls up to {toDisplayRate(result.maxLag, unit).toFixed(0)}
+          {unitLabel(unit)} behind the programmed ramp
+        </p>
+      )}
+    </div>
+  );
+}
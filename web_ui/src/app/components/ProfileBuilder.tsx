@@ -1,5 +1,5 @@
 import { useState, useMemo } from "react";
-import { useForm, useFieldArray, useWatch } from "react-hook-form";
+import { Controller, useForm, useFieldArray, useWatch } from "react-hook-form";
 import { zodResolver } from "@hookform/resolvers/zod";
 import { Card, CardContent, CardDescription, CardHeader, CardTitle } from "./ui/card";
 import { Button } from "./ui/button";
@@ -9,7 +9,7 @@ import { Textarea } from "./ui/textarea";
 import { Switch } from "./ui/switch";
 import { Select, SelectContent, SelectItem, SelectTrigger, SelectValue } from "./ui/select";
 import { FiringProfile } from "../types/kiln";
-import { Plus, Trash2, Save, MoveUp, MoveDown, Flame } from "lucide-react";
+import { Plus, Trash2, Save, MoveUp, MoveDown, Flame, Gauge } from "lucide-react";
 import { toast } from "sonner";
 import { toErrorMessage } from "../utils/error";
 import { computeSegmentDurationMinutes } from "../utils/profile";
@@ -20,8 +20,10 @@ import {
   useDeleteProfile,
   useConeTable,
   useGenerateConeFire,
+  useOptimizeProfile,
   useTempUnit,
 } from "../hooks/queries";
+import { formatDuration } from "../utils/time";
 import { formatTemp, formatRate, unitLabel, rateLabel } from "../utils/temperature";
 import { TemperatureField } from "./TemperatureField";
 
@@ -43,6 +45,7 @@ export function ProfileBuilder() {
   const deleteProfile = useDeleteProfile();
   const { data: coneEntries = [] } = useConeTable();
   const generateConeFire = useGenerateConeFire();
+  const optimizeProfile = useOptimizeProfile();
 
   const [mode, setMode] = useState<"manual" | "cone">("manual");
   const [editingProfileId, setEditingProfileId] = useState<string | null>(null);
@@ -58,6 +61,7 @@ export function ProfileBuilder() {
     handleSubmit,
     control,
     reset,
+    getValues,
     formState: { errors },
   } = useForm<ProfileFormValues>({
     resolver: zodResolver(profileFormSchema),
@@ -178,8 +182,13 @@ export function ProfileBuilder() {
       estimatedDuration,
     };
     try {
-      await saveProfile.mutateAsync(profile);
+      const saved = await saveProfile.mutateAsync(profile);
       toast.success(`Profile "${data.name}" saved successfully`);
+      for (const w of saved.rampWarnings ?? []) {
+        toast.warning(
+          `Segment ${w.segment + 1} asks ${w.rampRate}°C/h but this kiln manages ~${w.maxRate}°C/h above ${w.aboveTemp}°C`,
+        );
+      }
       setEditingProfileId(null);
       reset({ name: "", description: "", segments: [] });
     } catch (err) {
@@ -187,6 +196,40 @@ export function ProfileBuilder() {
     }
   };
 
+  // Replace the segments with the fastest schedule the kiln and the default
+  // water-smoke / quartz limits allow; nothing is saved until the user saves.
+  const handleOptimize = async () => {
+    const values = getValues();
+    try {
+      const result = await optimizeProfile.mutateAsync({
+        profile: {
+          id: editingProfileId || generateId(),
+          name: values.name,
+          description: values.description,
+          segments: values.segments,
+          maxTemp: calculateMaxTemp(),
+          estimatedDuration,
+        },
+      });
+      reset({
+        name: values.name,
+        description: values.description,
+        segments: result.profile.segments.map((s) => ({ ...s })),
+      });
+      if (result.savedS > 0) {
+        const energy =
+          result.original.energyKwh !== undefined && result.optimized.energyKwh !== undefined
+            ? `, ${(result.original.energyKwh - result.optimized.energyKwh).toFixed(1)} kWh`
+            : "";
+        toast.success(`Optimized: ${formatDuration(result.savedS)} faster${energy} — review and save`);
+      } else {
+        toast.info("Already as fast as the limits allow — segments adjusted to fit them");
+      }
+    } catch (err) {
+      toast.error(`Failed to optimize: ${toErrorMessage(err)}`);
+    }
+  };
+
   const handleDelete = async () => {
     if (!editingProfileId) return;
     if (!window.confirm(`Delete profile "${profileName}"?`)) return;
@@ -471,7 +514,7 @@ export function ProfileBuilder() {
                       </div>
                     </div>
 
-                    <div className="grid grid-cols-3 gap-4">
+                    <div className="grid grid-cols-2 md:grid-cols-4 gap-4">
                       <div className="space-y-2">
                         <Label>Ramp Rate ({rateLabel(unit)})</Label>
                         <TemperatureField
@@ -523,6 +566,37 @@ export function ProfileBuilder() {
                           </p>
                         )}
                       </div>
+
+                      <div className="space-y-2">
+                        <Label>End at Cone</Label>
+                        <Controller
+                          control={control}
+                          name={`segments.${index}.endConeId`}
+                          render={({ field }) => (
+                            <Select
+                              value={field.value !== undefined ? String(field.value) : "none"}
+                              onValueChange={(v) =>
+                                field.onChange(v === "none" ? undefined : Number(v))
+                              }
+                            >
+                              <SelectTrigger>
+                                <SelectValue />
+                              </SelectTrigger>
+                              <SelectContent>
+                                <SelectItem value="none">None</SelectItem>
+                                {coneEntries.map((c) => (
+                                  <SelectItem key={c.id} value={String(c.id)}>
+                                    Cone {c.name}
+                                  </SelectItem>
+                                ))}
+                              </SelectContent>
+                            </Select>
+                          )}
+                        />
+                        <p className="text-xs text-muted-foreground">
+                          Advance once the ware has matured to this cone
+                        </p>
+                      </div>
                     </div>
                   </div>
                 ))}
@@ -536,6 +610,16 @@ export function ProfileBuilder() {
                   Delete Profile
                 </Button>
               )}
+              <Button
+                type="button"
+                variant="outline"
+                className="gap-2"
+                onClick={handleOptimize}
+                disabled={fields.length === 0 || optimizeProfile.isPending}
+              >
+                <Gauge className="h-4 w-4" />
+                Optimize
+              </Button>
               <Button type="submit" className="gap-2">
                 <Save className="h-4 w-4" />
                 Save Profile
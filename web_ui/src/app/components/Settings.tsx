@@ -1,7 +1,14 @@
 import { useState, useCallback, useRef, useEffect } from "react";
-import { useForm, useWatch, type Path, type PathValue } from "react-hook-form";
+import {
+  Controller,
+  useFieldArray,
+  useForm,
+  useWatch,
+  type Path,
+  type PathValue,
+} from "react-hook-form";
 import { zodResolver } from "@hookform/resolvers/zod";
-import { formatUptime } from "../utils/time";
+import { formatUptime, minutesToClock, clockToMinutes } from "../utils/time";
 import { toErrorMessage } from "../utils/error";
 import { commitApiTokenChange, API_TOKEN_MAX_LENGTH } from "../utils/apiToken";
 import { Card, CardContent, CardDescription, CardHeader, CardTitle } from "./ui/card";
@@ -14,7 +21,16 @@ import { Badge } from "./ui/badge";
 import { Progress } from "./ui/progress";
 import { setApiToken } from "../services/api";
 import { toast } from "sonner";
-import { Upload, Zap, Thermometer, AlertTriangle, RefreshCw, Download } from "lucide-react";
+import {
+  Upload,
+  Zap,
+  Thermometer,
+  AlertTriangle,
+  RefreshCw,
+  Download,
+  Plus,
+  Trash2,
+} from "lucide-react";
 import { settingsSchema, SettingsFormValues } from "../schemas/kiln";
 import { TemperatureField } from "./TemperatureField";
 import {
@@ -28,6 +44,7 @@ import {
   useSettings,
   useSaveSettings,
   useSystemInfo,
+  useCapability,
   useAutotuneStatus,
   useStartAutotune,
   useStopAutotune,
@@ -44,6 +61,7 @@ export function Settings() {
   const { data: settings } = useSettings();
   const saveSettings = useSaveSettings();
   const { data: systemInfo } = useSystemInfo();
+  const { data: capability } = useCapability();
 
   const [autotuneRunning, setAutotuneRunning] = useState(false);
   const { data: autotuneStatus } = useAutotuneStatus(autotuneRunning);
@@ -91,6 +109,12 @@ export function Settings() {
       defaultValues: settings,
     });
 
+  const {
+    fields: tariffBands,
+    append: appendBand,
+    remove: removeBand,
+  } = useFieldArray({ control, name: "tariff" });
+
   // Sync form when server data arrives. keepDirtyValues prevents a refetch (e.g.
   // on window focus) from stomping unsaved edits the user is in the middle of.
   useEffect(() => {
@@ -434,6 +458,69 @@ export function Settings() {
                   {watchedSettings.electricityCostKwh!.toFixed(2)}/kWh
                 </p>
               )}
+
+            <div className="space-y-2">
+              <Label>Time-of-Use Tariff</Label>
+              {tariffBands.map((band, index) => (
+                <div key={band.id} className="flex items-center gap-2">
+                  <Controller
+                    control={control}
+                    name={`tariff.${index}.startMin`}
+                    render={({ field }) => (
+                      <Input
+                        type="time"
+                        className="w-32"
+                        aria-label={`Band ${index + 1} start`}
+                        value={minutesToClock(field.value)}
+                        onChange={(e) => {
+                          const minutes = clockToMinutes(e.target.value);
+                          if (!Number.isNaN(minutes)) field.onChange(minutes);
+                        }}
+                      />
+                    )}
+                  />
+                  <Input
+                    type="number"
+                    min="0"
+                    step="0.01"
+                    className="w-32"
+                    aria-label={`Band ${index + 1} $/kWh`}
+                    {...register(`tariff.${index}.costKwh`, { valueAsNumber: true })}
+                  />
+                  <span className="text-sm text-muted-foreground">$/kWh</span>
+                  <Button
+                    type="button"
+                    variant="ghost"
+                    size="sm"
+                    onClick={() => removeBand(index)}
+                    aria-label={`Remove band ${index + 1}`}
+                  >
+                    <Trash2 className="h-4 w-4 text-destructive" />
+                  </Button>
+                </div>
+              ))}
+              {tariffBands.length < 8 && (
+                <Button
+                  type="button"
+                  variant="outline"
+                  size="sm"
+                  onClick={() =>
+                    appendBand({
+                      startMin: 0,
+                      costKwh: watchedSettings.electricityCostKwh ?? 0,
+                    })
+                  }
+                >
+                  <Plus className="h-4 w-4 mr-2" />
+                  Add Band
+                </Button>
+              )}
+              <p className="text-sm text-muted-foreground">
+                Each price holds from its start time until the next band&apos;s, wrapping past
+                midnight. With no bands the flat rate above applies all day. Used to pick the
+                cheapest start when scheduling a firing.
+              </p>
+            </div>
           </CardContent>
         </Card>
 
@@ -612,6 +699,19 @@ export function Settings() {
                 <span className="text-muted-foreground">Reading Age</span>
                 <span className="font-mono">{tcDiag.readingAgeMs} ms</span>
               </div>
+              <div className="flex justify-between">
+                <span className="text-muted-foreground">Sample Jitter (mean / max)</span>
+                <span className="font-mono">
+                  {(tcDiag.timing.meanJitterUs / 1000).toFixed(1)} /{" "}
+                  {(tcDiag.timing.maxJitterUs / 1000).toFixed(1)} ms
+                </span>
+              </div>
+              <div className="flex justify-between">
+                <span className="text-muted-foreground">Worst Read (bus waits)</span>
+                <span className="font-mono">
+                  {(tcDiag.timing.maxReadUs / 1000).toFixed(1)} ms ({tcDiag.timing.busWaits})
+                </span>
+              </div>
               {tcDiag.fault && (
                 <div className="flex items-center gap-2 text-destructive mt-1">
                   <AlertTriangle className="h-4 w-4" />
@@ -805,6 +905,17 @@ export function Settings() {
               {systemInfo ? formatHours(systemInfo.elementHoursS) : "--"}
             </span>
           </div>
+          <div className="flex justify-between py-2 border-b">
+            <span className="text-sm font-medium">Full-Power Rise</span>
+            <span className="text-sm text-muted-foreground text-right">
+              {capability?.length
+                ? capability
+                    .filter((_, i, bins) => i === 0 || i === bins.length - 1 || i % 4 === 0)
+                    .map((b) => `${b.maxRate}°C/h @ ${b.fromTemp}°C`)
+                    .join(", ")
+                : "not learned yet"}
+            </span>
+          </div>
           <div className="flex justify-between py-2 border-b">
             <span className="text-sm font-medium">SPIFFS Usage</span>
             <span className="text-sm text-muted-foreground">
@@ -1,5 +1,5 @@
 import { useQuery, useMutation, useQueryClient } from "@tanstack/react-query";
-import { api } from "../services/api";
+import { api, OptimizeLimits, ScheduleRequest } from "../services/api";
 import { FiringProfile, KilnSettings } from "../types/kiln";
 import { useKilnStore } from "../stores/kilnStore";
 import { mockProfiles } from "../data/mockProfiles";
@@ -16,6 +16,7 @@ export const DEFAULT_SETTINGS: KilnSettings = {
   apiTokenSet: false,
   elementWatts: 0,
   electricityCostKwh: 0,
+  tariff: [],
 };
 
 // Query keys
@@ -23,6 +24,7 @@ export const queryKeys = {
   profiles: ["profiles"] as const,
   settings: ["settings"] as const,
   systemInfo: ["systemInfo"] as const,
+  capability: ["capability"] as const,
   autotuneStatus: ["autotuneStatus"] as const,
   history: ["history"] as const,
   coneTable: ["coneTable"] as const,
@@ -72,6 +74,14 @@ export function useSystemInfo() {
   });
 }
 
+export function useCapability() {
+  return useQuery({
+    queryKey: queryKeys.capability,
+    queryFn: () => api.getCapability(),
+    retry: false,
+  });
+}
+
 export function useAutotuneStatus(enabled: boolean) {
   return useQuery({
     queryKey: queryKeys.autotuneStatus,
@@ -163,6 +173,20 @@ export function useGenerateConeFire() {
   });
 }
 
+export function useOptimizeProfile() {
+  return useMutation({
+    mutationFn: (params: { profile: FiringProfile; limits?: OptimizeLimits }) =>
+      api.optimizeProfile(params.profile, params.limits),
+  });
+}
+
+export function useSimulateProfile() {
+  return useMutation({
+    mutationFn: (params: { id: string; startTemp?: number }) =>
+      api.simulateProfile(params.id, params.startTemp),
+  });
+}
+
 export function useSaveSettings() {
   const queryClient = useQueryClient();
   return useMutation({
@@ -215,6 +239,12 @@ export function useStartFiring() {
   });
 }
 
+export function useScheduleFiring() {
+  return useMutation({
+    mutationFn: (params: ScheduleRequest) => api.scheduleFiring(params),
+  });
+}
+
 export function useStopFiring() {
   return useMutation({
     mutationFn: () => api.stopFiring(),
@@ -162,6 +162,17 @@ describe("settingsSchema", () => {
     expect(settingsSchema.safeParse(minimal).success).toBe(true);
   });
 
+  it("accepts a tariff table and rejects clashing or out-of-day bands", () => {
+    const peak = { startMin: 420, costKwh: 0.3 };
+    const night = { startMin: 1320, costKwh: 0.1 };
+    expect(settingsSchema.safeParse({ ...validSettings, tariff: [peak, night] }).success).toBe(true);
+    expect(settingsSchema.safeParse({ ...validSettings, tariff: [peak, peak] }).success).toBe(false);
+    expect(
+      settingsSchema.safeParse({ ...validSettings, tariff: [{ startMin: 1440, costKwh: 0.1 }] })
+        .success,
+    ).toBe(false);
+  });
+
   it("accepts non-zero tcOffsetC (positive or negative)", () => {
     expect(settingsSchema.safeParse({ ...validSettings, tcOffsetC: -5.5 }).success).toBe(true);
     expect(settingsSchema.safeParse({ ...validSettings, tcOffsetC: 12.3 }).success).toBe(true);
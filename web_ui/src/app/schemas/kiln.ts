@@ -13,6 +13,8 @@ export const firingSegmentSchema = z.object({
   }),
   targetTemp: finiteNumber("Target temp is required").gt(0).max(1400),
   holdTime: finiteNumber("Hold time is required").min(0).max(HOLD_UNTIL_SKIP),
+  // Index into the firmware's cone table: 0 = cone 022 … 36 = cone 14.
+  endConeId: z.number().int().min(0).max(36).optional(),
 });
 
 export const profileFormSchema = z.object({
@@ -45,6 +47,19 @@ export const settingsSchema = z.object({
   apiTokenSet: z.boolean().optional(),
   elementWatts: finiteNumber("Element watts is required").min(0),
   electricityCostKwh: finiteNumber("Electricity cost is required").min(0),
+  tariff: z
+    .array(
+      z.object({
+        startMin: z.number().int().min(0).max(1439),
+        costKwh: finiteNumber("Band price is required").min(0),
+      }),
+    )
+    .max(8, "At most 8 tariff bands")
+    .refine(
+      (bands) => new Set(bands.map((b) => b.startMin)).size === bands.length,
+      "Two bands start at the same time",
+    )
+    .optional(),
 });
 
 export type SettingsFormValues = z.infer<typeof settingsSchema>;
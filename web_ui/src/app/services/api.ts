@@ -1,4 +1,4 @@
-import { FiringProfile, KilnSettings, ConeEntry, HistoryRecord, WifiInfo } from "../types/kiln";
+import { FiringProfile, KilnSettings, ConeEntry, HistoryEvent, HistoryRecord, WifiInfo } from "../types/kiln";
 import { makeDuplicateProfileId } from "../utils/profile";
 import { kilnWS } from "./websocket";
 
@@ -77,6 +77,9 @@ export interface StatusResponse {
   elapsedTime: number;
   estimatedTimeRemaining: number;
   status: string;
+  equivConeId?: number;
+  equivCone?: string;
+  kilnLoad?: number;
   thermocouple: {
     temperature: number;
     internalTemp: number;
@@ -87,6 +90,83 @@ export interface StatusResponse {
   };
 }
 
+/** Learned full-power rise from `fromTemp` up to the next 50 °C. */
+export interface CapabilityBin {
+  fromTemp: number;
+  maxRate: number; // °C/h
+  firings: number;
+}
+
+/** A heating segment asking for more than the kiln has managed above `aboveTemp`. */
+export interface RampWarning {
+  segment: number;
+  aboveTemp: number;
+  rampRate: number;
+  maxRate: number;
+}
+
+export interface ProfileSaveResponse {
+  ok: boolean;
+  id: string;
+  rampWarnings: RampWarning[];
+}
+
+/** Limits for POST /profiles/optimize; omitted fields keep the firmware defaults. */
+export interface OptimizeLimits {
+  startTemp?: number;
+  maxRate?: number; // heating ceiling everywhere, °C/h; 0 = none
+  zones?: { from: number; to: number; maxRate: number }[];
+  minHolds?: { temp: number; minutes: number }[];
+}
+
+export interface PlanSummary {
+  durationS: number;
+  energyKwh?: number; // present once element power is set
+}
+
+export interface OptimizeResponse {
+  profile: FiringProfile;
+  original: PlanSummary;
+  optimized: PlanSummary;
+  savedS: number;
+}
+
+/** POST /profiles/:id/simulate — the profile fired against the on-device kiln model. */
+export interface SimulationResult {
+  outcome: "complete" | "waits" | "stalled" | "timeout" | "cancelled";
+  segment: number; // where the run ended
+  durationS: number;
+  peakTemp: number;
+  maxLag: number; // furthest behind a heating setpoint, °C
+  equivConeId?: number;
+  equivCone?: string;
+  energyKwh?: number; // present once element power is set
+  cost?: number; // present once the electricity price is set too
+  pointEveryS: number;
+  curve: [number, number][]; // [seconds, °C]
+}
+
+/** Cheapest start under the time-of-use tariff, from POST /api/v1/firing/schedule. */
+export interface ScheduleRequest {
+  profileId: string;
+  startAfter?: number; // Unix seconds
+  finishBy?: number; // Unix seconds
+  utcOffsetMin?: number; // the tariff's local time ahead of UTC
+  arm?: boolean; // false: quote only, don't queue the start
+}
+
+export interface ScheduleResult {
+  startAt: number; // Unix seconds
+  delayMinutes: number;
+  finishAt: number;
+  durationS: number;
+  energyKwh: number;
+  cost: number;
+  earliestCost: number; // starting as soon as the window opens
+  savings: number;
+  armed: boolean;
+}
+
 export interface SystemInfo {
   firmware: string;
   model: string;
@@ -136,6 +216,16 @@ export interface DiagThermocouple {
   readingAgeMs: number;
   temperatureAdjustedC: number;
   tcOffsetC: number;
+  /** SPI read timing since boot; jitter is against the 250 ms sample period. */
+  timing: {
+    reads: number;
+    busWaits: number;
+    maxBusWaitUs: number;
+    maxReadUs: number;
+    intervals: number;
+    maxJitterUs: number;
+    meanJitterUs: number;
+  };
 }
 
 export const api = {
@@ -146,7 +236,7 @@ export const api = {
   getProfiles: () => request<FiringProfile[]>("/profiles"),
   getProfile: (id: string) => request<FiringProfile>(`/profiles/${id}`),
   saveProfile: (profile: FiringProfile) =>
-    request<{ ok: boolean; id: string }>("/profiles", {
+    request<ProfileSaveResponse>("/profiles", {
       method: "POST",
       body: JSON.stringify(profile),
     }),
@@ -157,14 +247,14 @@ export const api = {
       id: makeDuplicateProfileId(profile.id),
       name: `${profile.name} (Copy)`,
     };
-    return request<{ ok: boolean; id: string }>("/profiles", {
+    return request<ProfileSaveResponse>("/profiles", {
       method: "POST",
       body: JSON.stringify(copy),
     });
   },
   exportProfile: (id: string) => fetchBlob(`/profiles/${id}/export`),
   importProfile: (profile: FiringProfile) =>
-    request<{ ok: boolean; id: string }>("/profiles/import", {
+    request<ProfileSaveResponse>("/profiles/import", {
       method: "POST",
       body: JSON.stringify(profile),
     }),
@@ -183,12 +273,28 @@ export const api = {
       body: JSON.stringify(params),
     }),
 
+  optimizeProfile: (profile: FiringProfile, limits: OptimizeLimits = {}) =>
+    request<OptimizeResponse>("/profiles/optimize", {
+      method: "POST",
+      body: JSON.stringify({ profile, ...limits }),
+    }),
+  simulateProfile: (id: string, startTemp?: number) =>
+    request<SimulationResult>(`/profiles/${id}/simulate`, {
+      method: "POST",
+      body: JSON.stringify(startTemp === undefined ? {} : { startTemp }),
+    }),
+
   // Firing control
   startFiring: (profileId: string, delayMinutes = 0) =>
     request<{ ok: boolean }>("/firing/start", {
       method: "POST",
       body: JSON.stringify({ profileId, delayMinutes }),
     }),
+  scheduleFiring: (params: ScheduleRequest) =>
+    request<ScheduleResult>("/firing/schedule", {
+      method: "POST",
+      body: JSON.stringify(params),
+    }),
   stopFiring: () => request<{ ok: boolean }>("/firing/stop", { method: "POST" }),
   pauseFiring: () => request<{ ok: boolean; action: string }>("/firing/pause", { method: "POST" }),
   skipSegment: () => request<{ ok: boolean }>("/firing/skip-segment", { method: "POST" }),
@@ -217,6 +323,7 @@ export const api = {
   getHistory: () => request<HistoryRecord[]>("/history"),
   getHistoryTrace: (recordId: number) => fetchText(`/history/${recordId}/trace`),
   getHistoryTraceBlob: (recordId: number) => fetchBlob(`/history/${recordId}/trace`),
+  getHistoryEvents: (recordId: number) => request<HistoryEvent[]>(`/history/${recordId}/events`),
 
   // OTA
   uploadOta: async (file: File, onProgress?: (pct: number) => void): Promise<{ ok: boolean }> => {
@@ -263,4 +370,5 @@ export const api = {
       body: JSON.stringify({ durationSeconds }),
     }),
   getThermocoupleDiag: () => request<DiagThermocouple>("/diagnostics/thermocouple"),
+  getCapability: () => request<CapabilityBin[]>("/diagnostics/capability"),
 };
@@ -7,6 +7,9 @@ export interface TempUpdateData {
   elapsedTime: number;
   estimatedTimeRemaining: number;
   isActive: boolean;
+  equivConeId?: number;
+  equivCone?: string;
+  kilnLoad?: number;
 }
 
 export interface OtaProgressData {
@@ -93,6 +93,8 @@ export const useKilnStore = create<KilnState>((set) => ({
               elapsedTime: d.elapsedTime,
               estimatedTimeRemaining: d.estimatedTimeRemaining,
               status: coerceFiringStatus(d.status),
+              equivCone: d.equivCone,
+              kilnLoad: d.kilnLoad,
             },
             currentTempData: newData,
           };
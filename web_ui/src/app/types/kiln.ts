@@ -8,6 +8,7 @@ export interface FiringSegment {
   rampRate: number; // degrees per hour
   targetTemp: number; // degrees
   holdTime: number; // minutes (0 = no hold; HOLD_UNTIL_SKIP = hold until skip)
+  endConeId?: number; // cone-table id: also end the segment once the firing's heat work reaches it
 }
 
 export interface FiringProfile {
@@ -49,6 +50,8 @@ export interface FiringProgress {
   elapsedTime: number; // seconds
   estimatedTimeRemaining: number; // seconds
   status: FiringStatus;
+  equivCone?: string; // cone the heat work so far has reached, absent below cone 022
+  kilnLoad?: number; // full-power rise vs the learned curve this firing (1 = typical)
 }
 
 export interface KilnSettings {
@@ -63,6 +66,13 @@ export interface KilnSettings {
   apiTokenSet?: boolean; // read: whether a token is currently set
   elementWatts: number;
   electricityCostKwh: number;
+  tariff?: TariffBand[]; // time-of-use bands; empty = electricityCostKwh all day
+}
+
+/** One time-of-use band: its price holds from startMin (past local midnight) to the next band's. */
+export interface TariffBand {
+  startMin: number;
+  costKwh: number;
 }
 
 /** Wi-Fi connection state, mirrors GET /api/v1/wifi (api_handlers.c handle_get_wifi). */
@@ -98,3 +108,27 @@ export interface HistoryRecord {
   outcome: "complete" | "error" | "aborted";
   errorCode: number;
 }
+
+// One entry of a firing's event journal (GET /history/:id/events).
+export interface HistoryEvent {
+  t: number; // firing seconds, same axis as the trace's time_s
+  type:
+    | "segment"
+    | "hold"
+    | "pause"
+    | "resume"
+    | "tcFault"
+    | "tcOk"
+    | "trip"
+    | "settings"
+    | "stop"
+    | "cone";
+  source: "engine" | "api" | "lcd";
+  temp: number;
+  segment?: number;
+  fault?: number;
+  errorCode?: number;
+  coneId?: number;
+  cone?: string;
+  changed?: ("maxTemp" | "tcOffset" | "other")[];
+}
@@ -1,3 +1,5 @@
+import { ConeEntry } from "../types/kiln";
+
 export function computeSegmentDurationMinutes(
   segment: { targetTemp: number; rampRate: number; holdMinutes: number },
   fromTemp: number,
@@ -25,3 +27,8 @@ export function makeDuplicateProfileId(sourceId: string): string {
   const token = Date.now().toString(36) + Math.random().toString(36).slice(2, 6);
   return `c${token}-${sourceId}`.slice(0, 39);
 }
+
+/** Display name for a cone-table id ("6", "04"), or "#id" until the table has loaded. */
+export function coneName(cones: ConeEntry[], id: number): string {
+  return cones.find((c) => c.id === id)?.name ?? `#${id}`;
+}
@@ -1,5 +1,11 @@
 import { describe, it, expect } from "vitest";
-import { formatDuration, formatDurationFromMinutes, formatUptime } from "./time";
+import {
+  formatDuration,
+  formatDurationFromMinutes,
+  formatUptime,
+  minutesToClock,
+  clockToMinutes,
+} from "./time";
 
 describe("formatDuration (seconds → Xh Ym)", () => {
   it("formats whole hours and minutes", () => {
@@ -37,3 +43,18 @@ describe("formatUptime (seconds → Xh Ym Zs)", () => {
     expect(formatUptime(45)).toBe("0h 0m 45s");
   });
 });
+
+describe("minutesToClock / clockToMinutes (time of day)", () => {
+  it("round-trips minutes past midnight", () => {
+    expect(minutesToClock(0)).toBe("00:00");
+    expect(minutesToClock(22 * 60 + 5)).toBe("22:05");
+    expect(clockToMinutes("07:30")).toBe(450);
+    expect(clockToMinutes(minutesToClock(1439))).toBe(1439);
+  });
+
+  it("rejects anything that isn't a time of day", () => {
+    expect(clockToMinutes("")).toBeNaN();
+    expect(clockToMinutes("24:00")).toBeNaN();
+    expect(clockToMinutes("7:60")).toBeNaN();
+  });
+});
@@ -19,3 +19,19 @@ export function formatUptime(seconds: number): string {
   const s = Math.floor(seconds % 60);
   return `${h}h ${m}m ${s}s`;
 }
+
+/** Minutes past midnight as "HH:MM" (the value of an <input type="time">) */
+export function minutesToClock(minutes: number): string {
+  const h = Math.floor(minutes / 60);
+  const m = minutes % 60;
+  return `${String(h).padStart(2, "0")}:${String(m).padStart(2, "0")}`;
+}
+
+/** "HH:MM" as minutes past midnight; NaN if it isn't a time of day */
+export function clockToMinutes(clock: string): number {
+  const match = /^(\d{1,2}):(\d{2})$/.exec(clock);
+  if (!match) return NaN;
+  const h = Number(match[1]);
+  const m = Number(match[2]);
+  return h < 24 && m < 60 ? h * 60 + m : NaN;
+}
@@ -25,6 +25,7 @@ import {
   autotuneStatusSchema,
   coneEntrySchema,
   firingProgressResponseSchema,
+  historyEventSchema,
   historyRecordSchema,
   thermocoupleDiagSchema,
 } from "./responseSchemas";
@@ -55,6 +56,10 @@ describe.skipIf(!fixturesPresent)("firmware → frontend API contract", () => {
     expect(historyRecordSchema.parse(load("history_record"))).toBeDefined();
   });
 
+  it("/api/v1/history/:id/events element parses against historyEventSchema", () => {
+    expect(historyEventSchema.parse(load("history_event"))).toBeDefined();
+  });
+
   it("/api/v1/cone-table payload parses against coneEntrySchema[]", () => {
     expect(z.array(coneEntrySchema).parse(load("cone_table"))).toBeDefined();
   });
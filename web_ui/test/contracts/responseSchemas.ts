@@ -26,6 +26,9 @@ export const firingProgressResponseSchema = z.object({
   elapsedTime: z.number(),
   estimatedTimeRemaining: z.number(),
   status: z.string(),
+  equivConeId: z.number().optional(),
+  equivCone: z.string().optional(),
+  kilnLoad: z.number().optional(),
   thermocouple: z.object({
     temperature: z.number(),
     internalTemp: z.number(),
@@ -55,6 +58,30 @@ export const historyRecordSchema = z.object({
   errorCode: z.number(),
 });
 
+export const historyEventSchema = z.object({
+  t: z.number(),
+  type: z.enum([
+    "segment",
+    "hold",
+    "pause",
+    "resume",
+    "tcFault",
+    "tcOk",
+    "trip",
+    "settings",
+    "stop",
+    "cone",
+  ]),
+  source: z.enum(["engine", "api", "lcd"]),
+  temp: z.number(),
+  segment: z.number().optional(),
+  fault: z.number().optional(),
+  errorCode: z.number().optional(),
+  coneId: z.number().optional(),
+  cone: z.string().optional(),
+  changed: z.array(z.enum(["maxTemp", "tcOffset", "other"])).optional(),
+});
+
 export const systemInfoSchema = z.object({
   firmware: z.string(),
   model: z.string(),
@@ -68,6 +95,12 @@ export const systemInfoSchema = z.object({
   boardTempC: z.number(),
 });
 
+export const capabilityBinSchema = z.object({
+  fromTemp: z.number(),
+  maxRate: z.number(),
+  firings: z.number(),
+});
+
 export const autotuneStatusSchema = z.object({
   state: z.enum(["idle", "running", "stopped", "complete"]),
   elapsedTime: z.number(),
@@ -90,4 +123,13 @@ export const thermocoupleDiagSchema = z.object({
   readingAgeMs: z.number(),
   tcOffsetC: z.number(),
   temperatureAdjustedC: z.number(),
+  timing: z.object({
+    reads: z.number(),
+    busWaits: z.number(),
+    maxBusWaitUs: z.number(),
+    maxReadUs: z.number(),
+    intervals: z.number(),
+    maxJitterUs: z.number(),
+    meanJitterUs: z.number(),
+  }),
 });